@@ -0,0 +1,68 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Minimal timing helpers shared by the bench_*.c programs.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#ifndef ESE_BENCH_H
+#define ESE_BENCH_H
+
+#include "platform/time.h"
+#include <stdint.h>
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+/**
+ * @brief Accumulated timing for one benchmarked section.
+ */
+typedef struct EseBenchTimer {
+    const char *name;  /** Section name printed in the report */
+    uint64_t start;    /** Start time of the running sample (ns) */
+    uint64_t total;    /** Sum of all samples (ns) */
+    uint64_t min;      /** Fastest sample (ns) */
+    uint64_t max;      /** Slowest sample (ns) */
+    uint64_t samples;  /** Number of samples taken */
+} EseBenchTimer;
+
+#define BENCH_TIMER(label) {.name = (label), .min = UINT64_MAX}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+/**
+ * @brief Start a new sample for the timer.
+ */
+static inline void bench_start(EseBenchTimer *timer) { timer->start = time_now(); }
+
+/**
+ * @brief Stop the running sample and fold it into the totals.
+ */
+static inline void bench_stop(EseBenchTimer *timer) {
+    uint64_t elapsed = time_now() - timer->start;
+    timer->total += elapsed;
+    timer->samples++;
+    if (elapsed < timer->min) {
+        timer->min = elapsed;
+    }
+    if (elapsed > timer->max) {
+        timer->max = elapsed;
+    }
+}
+
+/**
+ * @brief Print avg/min/max in milliseconds for the timer.
+ */
+static inline void bench_report(const EseBenchTimer *timer) {
+    double avg = timer->samples ? (double)timer->total / (double)timer->samples : 0.0;
+    printf("  %-40s avg %9.3f ms  min %9.3f ms  max %9.3f ms  (%llu samples)\n", timer->name,
+           avg / 1e6, (timer->samples ? (double)timer->min : 0.0) / 1e6, (double)timer->max / 1e6,
+           (unsigned long long)timer->samples);
+}
+
+#endif // ESE_BENCH_H
@@ -0,0 +1,115 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for the collider narrow-phase test on multi-rect colliders: pairs of tile-chunk
+ * style colliders (a grid of small rects each) whose only touching rects are the last ones
+ * tested, so every rect pair is visited. Half of the pairs are rotated by a few degrees to
+ * exercise the oriented path. Times entity_component_collider_test_collider.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/components/collider.h"
+#include "entity/components/entity_component.h"
+#include "entity/entity.h"
+#include "types/rect.h"
+#include "utility/log.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_FRAMES 200
+#define BENCH_PAIRS 256
+#define BENCH_CHUNK 4 /* BENCH_CHUNK x BENCH_CHUNK rects per collider */
+#define BENCH_RECT_SIZE 8.0f
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+/**
+ * @brief Create a collider made of a grid of rects; it is not added to the engine.
+ */
+static EseEntityComponentCollider *_bench_make_chunk(EseLuaEngine *lua, float x, float y,
+                                                     float rotation) {
+    EseEntity *entity = entity_create(lua);
+    EseEntityComponent *collider = entity_component_collider_create(lua);
+    entity_component_add(entity, collider);
+    EseEntityComponentCollider *data =
+        (EseEntityComponentCollider *)entity_component_get_data(collider);
+
+    for (int row = 0; row < BENCH_CHUNK; row++) {
+        for (int col = 0; col < BENCH_CHUNK; col++) {
+            EseRect *rect = ese_rect_create(lua);
+            ese_rect_set_x(rect, (float)col * BENCH_RECT_SIZE);
+            ese_rect_set_y(rect, (float)row * BENCH_RECT_SIZE);
+            ese_rect_set_width(rect, BENCH_RECT_SIZE - 1.0f);
+            ese_rect_set_height(rect, BENCH_RECT_SIZE - 1.0f);
+            ese_rect_set_rotation(rect, rotation);
+            entity_component_collider_rects_add(data, rect);
+        }
+    }
+
+    entity_set_position(entity, x, y);
+    return data;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    EseEngine *engine = engine_create(NULL);
+    EseLuaEngine *lua = engine->lua_engine;
+
+    // The partner sits diagonally so only its first rect touches the anchor's last one
+    const float span = BENCH_CHUNK * BENCH_RECT_SIZE - 2.0f;
+    EseEntityComponentCollider *anchors[BENCH_PAIRS];
+    EseEntityComponentCollider *partners[BENCH_PAIRS];
+    for (int i = 0; i < BENCH_PAIRS; i++) {
+        float x = (float)(i % 16) * 100.0f;
+        float y = (float)(i / 16) * 100.0f;
+        float rotation = (i & 1) ? 0.05f : 0.0f;
+        anchors[i] = _bench_make_chunk(lua, x, y, rotation);
+        partners[i] = _bench_make_chunk(lua, x + span, y + span, rotation);
+    }
+
+    EseBenchTimer t_test = BENCH_TIMER("collider test");
+    size_t hit_count = 0;
+
+    for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+        hit_count = 0;
+        bench_start(&t_test);
+        for (int i = 0; i < BENCH_PAIRS; i++) {
+            size_t rect_b = 0;
+            if (entity_component_collider_test_collider(anchors[i], partners[i], &rect_b)) {
+                hit_count++;
+            }
+        }
+        bench_stop(&t_test);
+    }
+
+    printf("\nCollider shape benchmark: %d pairs of %dx%d-rect colliders, %d frames\n",
+           BENCH_PAIRS, BENCH_CHUNK, BENCH_CHUNK, BENCH_FRAMES);
+    bench_report(&t_test);
+    printf("  rect pair throughput: %.2f Mtests/s\n",
+           (double)BENCH_PAIRS * BENCH_FRAMES * BENCH_CHUNK * BENCH_CHUNK * BENCH_CHUNK *
+               BENCH_CHUNK / ((double)t_test.total / 1e9) / 1e6);
+    printf("  hits last frame: %zu\n", hit_count);
+
+    for (int i = 0; i < BENCH_PAIRS; i++) {
+        entity_destroy(anchors[i]->base.entity);
+        entity_destroy(partners[i]->base.entity);
+    }
+    engine_destroy(engine);
+    memory_manager.destroy(true);
+    return 0;
+}
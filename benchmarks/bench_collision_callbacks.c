@@ -0,0 +1,144 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for collision callback dispatch to Lua: a few hundred scripted hub entities each
+ * overlapping a ring of unscripted sensors, about 2k contacts per frame. Runs once with per-hit
+ * entity_collision_stay callbacks and once with a batched entity_collisions callback, timing
+ * collision_dispatch_run.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/collision_dispatch.h"
+#include "core/collision_resolver.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/components/collider.h"
+#include "entity/components/entity_component.h"
+#include "entity/components/entity_component_lua.h"
+#include "entity/entity.h"
+#include "scripting/lua_engine.h"
+#include "types/input_state.h"
+#include "types/rect.h"
+#include "utility/array.h"
+#include "utility/job_queue.h"
+#include "utility/log.h"
+#include "utility/spatial_index.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_FRAMES 200
+#define BENCH_HUBS 200
+#define BENCH_SENSORS_PER_HUB 10 /* BENCH_HUBS * BENCH_SENSORS_PER_HUB contacts */
+#define BENCH_SPACING 200.0f
+#define BENCH_HUB_SIZE 64.0f
+#define BENCH_SENSOR_SIZE 8.0f
+
+static const char *PER_HIT_SCRIPT = "function ENTITY:entity_collision_stay(other)\n"
+                                    "    self.data.hits = (self.data.hits or 0) + 1\n"
+                                    "end\n";
+
+static const char *BATCHED_SCRIPT = "function ENTITY:entity_collisions(hits)\n"
+                                    "    local n = 0\n"
+                                    "    for i = 1, #hits do\n"
+                                    "        if hits[i].state == 2 then n = n + 1 end\n"
+                                    "    end\n"
+                                    "    self.data.hits = (self.data.hits or 0) + n\n"
+                                    "end\n";
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+/**
+ * @brief Create a collider entity with a single square rect at the given position.
+ */
+static EseEntity *_bench_make_collider(EseEngine *engine, float x, float y, float size) {
+    EseLuaEngine *lua = engine->lua_engine;
+    EseEntity *entity = entity_create(lua);
+
+    EseEntityComponent *collider = entity_component_collider_create(lua);
+    entity_component_add(entity, collider);
+
+    EseRect *rect = ese_rect_create(lua);
+    ese_rect_set_width(rect, size);
+    ese_rect_set_height(rect, size);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+
+    entity_set_position(entity, x, y);
+    engine_add_entity(engine, entity);
+    return entity;
+}
+
+/**
+ * @brief Build a scene whose hubs run @p script and time the callback dispatch.
+ */
+static void _bench_run(const char *label, const char *script) {
+    EseEngine *engine = engine_create(NULL);
+    EseLuaEngine *lua = engine->lua_engine;
+    lua_engine_load_script_from_string(lua, script, "bench_script", "ENTITY");
+
+    // Sensors sit inside their hub, spread so they do not overlap each other
+    for (int h = 0; h < BENCH_HUBS; h++) {
+        float x = (float)(h % 20) * BENCH_SPACING;
+        float y = (float)(h / 20) * BENCH_SPACING;
+        EseEntity *hub = _bench_make_collider(engine, x, y, BENCH_HUB_SIZE);
+        entity_component_add(hub, entity_component_lua_create(lua, "bench_script"));
+        for (int s = 0; s < BENCH_SENSORS_PER_HUB; s++) {
+            _bench_make_collider(engine, x + (float)(s % 5) * 12.0f, y + (float)(s / 5) * 12.0f,
+                                 BENCH_SENSOR_SIZE);
+        }
+    }
+
+    // One full update creates the script instances and produces the ENTER hits
+    EseInputState *input_state = ese_input_state_create(lua);
+    engine_update(engine, 0.016f, input_state);
+
+    EseBenchTimer t_dispatch = BENCH_TIMER(label);
+    size_t hit_count = 0;
+
+    for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+        spatial_index_update(engine->spatial_index);
+        const SpatialPair *pairs = NULL;
+        size_t pair_count = spatial_index_get_pairs(engine->spatial_index, &pairs);
+        EseArray *hits = collision_resolver_solve(engine->collision_resolver, pairs, pair_count,
+                                                  engine->lua_engine);
+        hit_count = array_size(hits);
+
+        bench_start(&t_dispatch);
+        collision_dispatch_run(engine->collision_dispatch, hits);
+        bench_stop(&t_dispatch);
+
+        // engine_update normally reaps finished narrow-phase jobs
+        ese_job_queue_process(engine->job_queue);
+    }
+
+    bench_report(&t_dispatch);
+    printf("  hits per frame: %zu, %.1f ns/hit\n", hit_count,
+           (double)t_dispatch.total / BENCH_FRAMES / (double)(hit_count ? hit_count : 1));
+
+    ese_input_state_destroy(input_state);
+    engine_destroy(engine);
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    printf("\nCollision callback benchmark: %d hubs x %d sensors, %d frames\n", BENCH_HUBS,
+           BENCH_SENSORS_PER_HUB, BENCH_FRAMES);
+    _bench_run("per-hit callbacks", PER_HIT_SCRIPT);
+    _bench_run("batched entity_collisions", BATCHED_SCRIPT);
+
+    memory_manager.destroy(true);
+    return 0;
+}
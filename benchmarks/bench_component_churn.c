@@ -0,0 +1,104 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for component registration: waves of bullets gain and lose a sprite component
+ * while the world around them holds more and more sprites. Adding and removing notify the
+ * sprite systems, so with O(1) registration the cost per wave stays flat as the world grows.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/components/entity_component.h"
+#include "entity/components/entity_component_sprite.h"
+#include "entity/entity.h"
+#include "entity/entity_private.h"
+#include "scripting/lua_engine_private.h"
+#include "types/input_state.h"
+#include "utility/log.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_STAGES 3
+#define BENCH_BULLETS 2000
+#define BENCH_WAVES 5
+#define BENCH_LUA_MEMORY (256u * 1024u * 1024u)
+
+static const int BENCH_WORLD_SIZES[BENCH_STAGES] = {1000, 10000, 40000};
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    EseEngine *engine = engine_create(NULL);
+    // Every entity owns Lua userdata; 40k of them do not fit the default 10MB
+    engine->lua_engine->internal->memory_limit = BENCH_LUA_MEMORY;
+    EseLuaEngine *lua = engine->lua_engine;
+    EseInputState *input_state = ese_input_state_create(lua);
+
+    static EseEntity *bullets[BENCH_BULLETS];
+    static const char *sprite_ids[BENCH_BULLETS];
+    EseBenchTimer t_add[BENCH_STAGES];
+    EseBenchTimer t_rem[BENCH_STAGES];
+    int world = 0;
+
+    for (int stage = 0; stage < BENCH_STAGES; stage++) {
+        for (; world < BENCH_WORLD_SIZES[stage]; world++) {
+            EseEntity *entity = entity_create(lua);
+            entity_component_add(entity, entity_component_sprite_create(lua, NULL));
+            engine_add_entity(engine, entity);
+        }
+
+        t_add[stage] = (EseBenchTimer)BENCH_TIMER("add sprite to wave");
+        t_rem[stage] = (EseBenchTimer)BENCH_TIMER("remove sprite from wave");
+        for (int wave = 0; wave < BENCH_WAVES; wave++) {
+            for (int i = 0; i < BENCH_BULLETS; i++) {
+                bullets[i] = entity_create(lua);
+                engine_add_entity(engine, bullets[i]);
+            }
+
+            bench_start(&t_add[stage]);
+            for (int i = 0; i < BENCH_BULLETS; i++) {
+                sprite_ids[i] =
+                    entity_component_add(bullets[i], entity_component_sprite_create(lua, NULL));
+            }
+            bench_stop(&t_add[stage]);
+
+            bench_start(&t_rem[stage]);
+            for (int i = 0; i < BENCH_BULLETS; i++) {
+                entity_component_remove(bullets[i], sprite_ids[i]);
+            }
+            bench_stop(&t_rem[stage]);
+
+            // Drop the removed components and the bullets outside the timers
+            for (int i = 0; i < BENCH_BULLETS; i++) {
+                engine_remove_entity(engine, bullets[i]);
+            }
+            engine_update(engine, 0.016f, input_state);
+        }
+    }
+
+    printf("\nComponent churn benchmark: %d waves of %d bullets per world size\n", BENCH_WAVES,
+           BENCH_BULLETS);
+    for (int stage = 0; stage < BENCH_STAGES; stage++) {
+        printf("  world of %d sprites:\n", BENCH_WORLD_SIZES[stage]);
+        bench_report(&t_add[stage]);
+        bench_report(&t_rem[stage]);
+    }
+    printf("  remove cost, largest vs smallest world: %.1fx\n",
+           (double)t_rem[BENCH_STAGES - 1].total / (double)t_rem[0].total);
+
+    ese_input_state_destroy(input_state);
+    engine_destroy(engine);
+    memory_manager.destroy(true);
+    return 0;
+}
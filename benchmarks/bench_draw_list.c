@@ -0,0 +1,109 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for the per-frame draw path: draw_list_request_object for every sprite, followed by
+ * render_list_fill. Simulates a scene of 20k sprites plus a handful of rects and polylines.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/memory_manager.h"
+#include "graphics/draw_list.h"
+#include "graphics/render_list.h"
+#include "utility/log.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_FRAMES 120
+#define BENCH_SPRITES 20000
+#define BENCH_RECTS 500
+#define BENCH_POLYLINES 200
+#define BENCH_POLYLINE_POINTS 64
+
+static const char *g_textures[] = {"atlas_a", "atlas_b", "atlas_c", "atlas_d"};
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+/**
+ * @brief Emit one frame worth of draw objects.
+ */
+static void _bench_fill_draw_list(EseDrawList *draw_list, const float *points) {
+    for (size_t i = 0; i < BENCH_SPRITES; i++) {
+        EseDrawListObject *obj = draw_list_request_object(draw_list);
+        draw_list_object_set_texture(obj, g_textures[(i / 256) % 4], 0.0f, 0.0f, 0.25f, 0.25f);
+        draw_list_object_set_bounds(obj, (float)(i % 640), (float)(i % 480), 32, 32);
+        draw_list_object_set_z_index(obj, i / 256);
+    }
+
+    for (size_t i = 0; i < BENCH_RECTS; i++) {
+        EseDrawListObject *obj = draw_list_request_object(draw_list);
+        draw_list_object_set_rect_color(obj, 255, 0, 0, 255, (i & 1) == 0);
+        draw_list_object_set_bounds(obj, (float)(i % 640), (float)(i % 480), 16, 16);
+        draw_list_object_set_z_index(obj, 1000);
+    }
+
+    for (size_t i = 0; i < BENCH_POLYLINES; i++) {
+        EseDrawListObject *obj = draw_list_request_object(draw_list);
+        draw_list_object_set_polyline(obj, points, BENCH_POLYLINE_POINTS, 2.0f);
+        draw_list_object_set_polyline_color(obj, 0, 255, 0, 255);
+        draw_list_object_set_polyline_stroke_color(obj, 0, 0, 255, 255);
+        draw_list_object_set_bounds(obj, (float)(i % 640), (float)(i % 480), 0, 0);
+        draw_list_object_set_z_index(obj, 2000);
+    }
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    float points[BENCH_POLYLINE_POINTS * 2];
+    for (size_t i = 0; i < BENCH_POLYLINE_POINTS; i++) {
+        points[i * 2] = (float)(i * 3);
+        points[i * 2 + 1] = (float)((i * 7) % 50);
+    }
+
+    EseDrawList *draw_list = draw_list_create();
+    EseRenderList *render_list = render_list_create();
+    render_list_set_size(render_list, 640, 480);
+
+    EseBenchTimer t_request = BENCH_TIMER("draw_list_request_object (+setters)");
+    EseBenchTimer t_fill = BENCH_TIMER("render_list_fill");
+    EseBenchTimer t_frame = BENCH_TIMER("frame total");
+
+    for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+        bench_start(&t_frame);
+
+        draw_list_clear(draw_list);
+        bench_start(&t_request);
+        _bench_fill_draw_list(draw_list, points);
+        bench_stop(&t_request);
+
+        render_list_clear(render_list);
+        bench_start(&t_fill);
+        render_list_fill(render_list, draw_list);
+        bench_stop(&t_fill);
+
+        bench_stop(&t_frame);
+    }
+
+    printf("\nDraw list benchmark: %d sprites, %d rects, %d polylines x %d points, %d frames\n",
+           BENCH_SPRITES, BENCH_RECTS, BENCH_POLYLINES, BENCH_POLYLINE_POINTS, BENCH_FRAMES);
+    bench_report(&t_request);
+    bench_report(&t_fill);
+    bench_report(&t_frame);
+    printf("  render batches last frame: %zu\n", render_list_get_batch_count(render_list));
+
+    render_list_destroy(render_list);
+    draw_list_destroy(draw_list);
+    memory_manager.destroy(true);
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for entity storage: a world of long-lived entities plus waves of bullets that are
+ * all despawned in the same frame. Times the engine_update that deletes a wave, a full walk
+ * over the entity storage and resolving entity handles.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/entity.h"
+#include "entity/entity_private.h"
+#include "types/input_state.h"
+#include "utility/log.h"
+#include "utility/slot_map.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_WORLD_ENTITIES 5000
+#define BENCH_BULLETS 5000
+#define BENCH_WAVES 10
+#define BENCH_WALKS 1000
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    EseEngine *engine = engine_create(NULL);
+    EseLuaEngine *lua = engine->lua_engine;
+    EseInputState *input_state = ese_input_state_create(lua);
+
+    for (int i = 0; i < BENCH_WORLD_ENTITIES; i++) {
+        engine_add_entity(engine, entity_create(lua));
+    }
+
+    static EseEntity *bullets[BENCH_BULLETS];
+    static EseSlotHandle handles[BENCH_BULLETS];
+    EseBenchTimer t_despawn = BENCH_TIMER("despawn wave (engine_update)");
+    EseBenchTimer t_idle = BENCH_TIMER("idle frame (engine_update)");
+    size_t stale = 0;
+
+    for (int wave = 0; wave < BENCH_WAVES; wave++) {
+        for (int i = 0; i < BENCH_BULLETS; i++) {
+            bullets[i] = entity_create(lua);
+            engine_add_entity(engine, bullets[i]);
+            handles[i] = entity_get_handle(bullets[i]);
+        }
+
+        bench_start(&t_idle);
+        engine_update(engine, 0.016f, input_state);
+        bench_stop(&t_idle);
+
+        for (int i = 0; i < BENCH_BULLETS; i++) {
+            engine_remove_entity(engine, bullets[i]);
+        }
+        bench_start(&t_despawn);
+        engine_update(engine, 0.016f, input_state);
+        bench_stop(&t_despawn);
+
+        for (int i = 0; i < BENCH_BULLETS; i++) {
+            stale += engine_get_entity(engine, handles[i]) == NULL ? 1 : 0;
+        }
+    }
+
+    EseBenchTimer t_walk = BENCH_TIMER("walk all entities");
+    size_t visible = 0;
+    for (int w = 0; w < BENCH_WALKS; w++) {
+        bench_start(&t_walk);
+        EseEntity **entities = (EseEntity **)slot_map_values(engine->entities);
+        size_t count = slot_map_size(engine->entities);
+        for (size_t i = 0; i < count; i++) {
+            visible += entities[i]->visible ? 1 : 0;
+        }
+        bench_stop(&t_walk);
+    }
+
+    EseBenchTimer t_lookup = BENCH_TIMER("resolve handle");
+    size_t resolved = 0;
+    for (int w = 0; w < BENCH_WALKS; w++) {
+        size_t count = slot_map_size(engine->entities);
+        bench_start(&t_lookup);
+        for (size_t i = 0; i < count; i++) {
+            resolved += engine_get_entity(engine, slot_map_handle_at(engine->entities, i)) ? 1 : 0;
+        }
+        bench_stop(&t_lookup);
+    }
+
+    printf("\nEntity despawn benchmark: %d world entities, %d waves of %d bullets\n",
+           BENCH_WORLD_ENTITIES, BENCH_WAVES, BENCH_BULLETS);
+    bench_report(&t_idle);
+    bench_report(&t_despawn);
+    bench_report(&t_walk);
+    bench_report(&t_lookup);
+    printf("  stale handles after despawn: %zu of %d, visible %zu, resolved %zu\n", stale,
+           BENCH_WAVES * BENCH_BULLETS, visible, resolved);
+    printf("  resolve: %.1f ns per handle\n",
+           (double)t_lookup.total / (double)(BENCH_WALKS * BENCH_WORLD_ENTITIES));
+
+    ese_input_state_destroy(input_state);
+    engine_destroy(engine);
+    memory_manager.destroy(true);
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for looking entities up by UUID string in a world of 50k entities: the engine's
+ * hashed id index (engine_find_by_id) against a walk over every entity comparing id strings,
+ * which is how the lookup worked before the index.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/entity.h"
+#include "entity/entity_private.h"
+#include "scripting/lua_engine_private.h"
+#include "types/uuid.h"
+#include "utility/log.h"
+#include "utility/slot_map.h"
+#include <stdio.h>
+#include <string.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_ENTITIES 50000
+#define BENCH_LOOKUPS 10000
+#define BENCH_WALK_LOOKUPS 200 /* the walk takes up to milliseconds per lookup */
+#define BENCH_LUA_MEMORY (256u * 1024u * 1024u)
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+/**
+ * @brief The lookup as it was before the index: every id is compared.
+ */
+static EseEntity *_bench_walk_find(EseEngine *engine, const char *uuid_string) {
+    EseEntity **entities = (EseEntity **)slot_map_values(engine->entities);
+    size_t count = slot_map_size(engine->entities);
+    for (size_t i = 0; i < count; i++) {
+        if (entities[i]->active && strcmp(ese_uuid_get_value(entities[i]->id), uuid_string) == 0) {
+            return entities[i];
+        }
+    }
+    return NULL;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    EseEngine *engine = engine_create(NULL);
+    // Every entity owns Lua userdata; 50k of them do not fit the default 10MB
+    engine->lua_engine->internal->memory_limit = BENCH_LUA_MEMORY;
+
+    static EseEntity *entities[BENCH_ENTITIES];
+    for (int i = 0; i < BENCH_ENTITIES; i++) {
+        entities[i] = entity_create(engine->lua_engine);
+        engine_add_entity(engine, entities[i]);
+    }
+
+    // Deterministic spread of targets over the whole world
+    static const char *targets[BENCH_LOOKUPS];
+    uint32_t state = 12345u;
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        state = state * 1664525u + 1013904223u;
+        targets[i] = ese_uuid_get_value(entities[(state >> 8) % BENCH_ENTITIES]->id);
+    }
+
+    EseBenchTimer t_walk = BENCH_TIMER("find_by_id, entity walk");
+    size_t walk_found = 0;
+    for (int i = 0; i < BENCH_WALK_LOOKUPS; i++) {
+        bench_start(&t_walk);
+        walk_found += _bench_walk_find(engine, targets[i]) ? 1 : 0;
+        bench_stop(&t_walk);
+    }
+
+    EseBenchTimer t_index = BENCH_TIMER("find_by_id, hashed index");
+    size_t index_found = 0;
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        bench_start(&t_index);
+        index_found += engine_find_by_id(engine, targets[i]) ? 1 : 0;
+        bench_stop(&t_index);
+    }
+
+    EseBenchTimer t_miss = BENCH_TIMER("find_by_id, unknown id");
+    size_t miss_found = 0;
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        bench_start(&t_miss);
+        miss_found += engine_find_by_id(engine, "00000000-0000-4000-8000-000000000000") ? 1 : 0;
+        bench_stop(&t_miss);
+    }
+
+    printf("\nEntity find_by_id benchmark: %d entities, %d lookups\n", BENCH_ENTITIES,
+           BENCH_LOOKUPS);
+    bench_report(&t_walk);
+    bench_report(&t_index);
+    bench_report(&t_miss);
+    printf("  found: walk %zu of %d, index %zu of %d, unknown %zu\n", walk_found,
+           BENCH_WALK_LOOKUPS, index_found, BENCH_LOOKUPS, miss_found);
+    printf("  speedup per lookup: %.1fx\n", ((double)t_walk.total / (double)t_walk.samples) /
+                                                ((double)t_index.total / (double)t_index.samples));
+
+    engine_destroy(engine);
+    memory_manager.destroy(true);
+    return 0;
+}
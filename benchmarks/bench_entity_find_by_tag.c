@@ -0,0 +1,110 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for finding entities by tag in a world of 50k entities where a rare tag is carried
+ * by 50 of them: the engine's per-tag sets (engine_find_by_tag, engine_find_first_by_tag)
+ * against a walk over every entity comparing tags, which is how the lookup worked before.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/entity.h"
+#include "entity/entity_private.h"
+#include "scripting/lua_engine_private.h"
+#include "utility/log.h"
+#include "utility/slot_map.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_ENTITIES 50000
+#define BENCH_RARE_EVERY 1000 /* 50 entities carry the rare tag */
+#define BENCH_LOOKUPS 1000
+#define BENCH_LUA_MEMORY (256u * 1024u * 1024u)
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+/**
+ * @brief The lookup as it was before the tag sets: every entity's tags are compared.
+ */
+static size_t _bench_walk_find(EseEngine *engine, const char *tag, EseEntity **result) {
+    EseEntity **entities = (EseEntity **)slot_map_values(engine->entities);
+    size_t count = slot_map_size(engine->entities);
+    size_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (entities[i]->active && entity_has_tag(entities[i], tag)) {
+            result[found++] = entities[i];
+        }
+    }
+    return found;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    EseEngine *engine = engine_create(NULL);
+    // Every entity owns Lua userdata; 50k of them do not fit the default 10MB
+    engine->lua_engine->internal->memory_limit = BENCH_LUA_MEMORY;
+
+    for (int i = 0; i < BENCH_ENTITIES; i++) {
+        EseEntity *entity = entity_create(engine->lua_engine);
+        engine_add_entity(engine, entity);
+        entity_add_tag(entity, (i % 2) ? "enemy" : "prop");
+        if (i % BENCH_RARE_EVERY == 0) {
+            entity_add_tag(entity, "boss");
+        }
+    }
+
+    static EseEntity *walk_result[BENCH_ENTITIES];
+    EseBenchTimer t_walk = BENCH_TIMER("find_by_tag, entity walk");
+    size_t walk_found = 0;
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        bench_start(&t_walk);
+        walk_found += _bench_walk_find(engine, "boss", walk_result);
+        bench_stop(&t_walk);
+    }
+
+    EseBenchTimer t_set = BENCH_TIMER("find_by_tag, tag set");
+    size_t set_found = 0;
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        bench_start(&t_set);
+        EseEntity **found = engine_find_by_tag(engine, "boss", 1000);
+        bench_stop(&t_set);
+        for (size_t j = 0; found && found[j]; j++) {
+            set_found++;
+        }
+        memory_manager.free(found);
+    }
+
+    EseBenchTimer t_first = BENCH_TIMER("find_first_by_tag, tag set");
+    size_t first_found = 0;
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        bench_start(&t_first);
+        first_found += engine_find_first_by_tag(engine, "boss") ? 1 : 0;
+        bench_stop(&t_first);
+    }
+
+    printf("\nEntity find_by_tag benchmark: %d entities, %d with the tag, %d lookups\n",
+           BENCH_ENTITIES, BENCH_ENTITIES / BENCH_RARE_EVERY, BENCH_LOOKUPS);
+    bench_report(&t_walk);
+    bench_report(&t_set);
+    bench_report(&t_first);
+    printf("  found: walk %zu, set %zu, first %zu\n", walk_found, set_found, first_found);
+    printf("  speedup per lookup: %.1fx\n", (double)t_walk.total / (double)t_set.total);
+
+    engine_destroy(engine);
+    memory_manager.destroy(true);
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for entity transforms with 50k collider entities: moving every entity the way a
+ * script does (x, then y, through entity.position) and reading every position back, against the
+ * engine's transform pool and against the layout it replaced, where each position was its own
+ * EsePoint and each write refreshed the entity's colliders through a watcher. Detached entities
+ * still refresh on every write, so they stand in for the old path.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/components/collider.h"
+#include "entity/components/entity_component.h"
+#include "entity/entity.h"
+#include "entity/entity_private.h"
+#include "entity/transform_pool.h"
+#include "scripting/lua_engine_private.h"
+#include "types/point.h"
+#include "types/rect.h"
+#include "utility/log.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_ENTITIES 50000
+#define BENCH_FRAMES 50
+#define BENCH_LUA_MEMORY (256u * 1024u * 1024u)
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+static EseEntity *_bench_collider_entity(EseLuaEngine *lua, int i) {
+    EseEntity *entity = entity_create(lua);
+    EseEntityComponent *collider = entity_component_collider_create(lua);
+    entity_component_add(entity, collider);
+
+    EseRect *rect = ese_rect_create(lua);
+    ese_rect_set_width(rect, 8.0f);
+    ese_rect_set_height(rect, 8.0f);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+
+    entity_set_position(entity, (float)(i % 500) * 10.0f, (float)(i / 500) * 10.0f);
+    return entity;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    EseEngine *engine = engine_create(NULL);
+    // Every entity owns Lua userdata; 50k of them do not fit the default 10MB
+    engine->lua_engine->internal->memory_limit = BENCH_LUA_MEMORY;
+
+    static EseEntity *added[BENCH_ENTITIES];
+    static EseEntity *detached[BENCH_ENTITIES];
+    static EsePoint *points[BENCH_ENTITIES];
+    for (int i = 0; i < BENCH_ENTITIES; i++) {
+        added[i] = _bench_collider_entity(engine->lua_engine, i);
+        engine_add_entity(engine, added[i]);
+        detached[i] = _bench_collider_entity(engine->lua_engine, i);
+        points[i] = ese_point_create(engine->lua_engine);
+        ese_point_set_x(points[i], entity_get_x(detached[i]));
+        ese_point_set_y(points[i], entity_get_y(detached[i]));
+    }
+    engine_sync_transforms(engine);
+
+    EseBenchTimer t_eager = BENCH_TIMER("move all, eager collider refresh");
+    EseBenchTimer t_pool = BENCH_TIMER("move all, transform pool");
+    EseBenchTimer t_sync = BENCH_TIMER("sync dirty transforms");
+    EseBenchTimer t_points = BENCH_TIMER("read all, EsePoint per entity");
+    EseBenchTimer t_columns = BENCH_TIMER("read all, pool columns");
+    double point_sum = 0.0;
+    double column_sum = 0.0;
+
+    for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+        float step = (float)(frame & 1 ? -1 : 1);
+
+        bench_start(&t_eager);
+        for (int i = 0; i < BENCH_ENTITIES; i++) {
+            EsePoint *position = detached[i]->position;
+            ese_point_set_x(position, ese_point_get_x(position) + step);
+            ese_point_set_y(position, ese_point_get_y(position) - step);
+        }
+        bench_stop(&t_eager);
+
+        bench_start(&t_pool);
+        for (int i = 0; i < BENCH_ENTITIES; i++) {
+            EsePoint *position = added[i]->position;
+            ese_point_set_x(position, ese_point_get_x(position) + step);
+            ese_point_set_y(position, ese_point_get_y(position) - step);
+        }
+        bench_stop(&t_pool);
+
+        bench_start(&t_sync);
+        engine_sync_transforms(engine);
+        bench_stop(&t_sync);
+
+        bench_start(&t_points);
+        for (int i = 0; i < BENCH_ENTITIES; i++) {
+            point_sum += ese_point_get_x(points[i]) + ese_point_get_y(points[i]);
+        }
+        bench_stop(&t_points);
+
+        const EseTransformPool *pool = engine->transforms;
+        bench_start(&t_columns);
+        for (uint32_t i = 0; i < pool->capacity; i++) {
+            if (pool->entities[i]) {
+                column_sum += pool->x[i] + pool->y[i];
+            }
+        }
+        bench_stop(&t_columns);
+    }
+
+    printf("\nEntity transform benchmark: %d collider entities, %d frames\n", BENCH_ENTITIES,
+           BENCH_FRAMES);
+    bench_report(&t_eager);
+    bench_report(&t_pool);
+    bench_report(&t_sync);
+    bench_report(&t_points);
+    bench_report(&t_columns);
+    printf("  sums: points %.0f, columns %.0f\n", point_sum, column_sum);
+    printf("  write speedup (pool + sync vs eager): %.1fx\n",
+           (double)t_eager.total / (double)(t_pool.total + t_sync.total));
+    printf("  read speedup: %.1fx\n", (double)t_points.total / (double)t_columns.total);
+
+    for (int i = 0; i < BENCH_ENTITIES; i++) {
+        entity_destroy(detached[i]);
+        ese_point_destroy(points[i]);
+    }
+    engine_destroy(engine);
+    memory_manager.destroy(true);
+    return 0;
+}
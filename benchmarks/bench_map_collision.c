@@ -0,0 +1,133 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for collider vs tile map collision: a handful of small colliders wandering over a
+ * large grid map with a checkerboard of solid cells. Times the map component's collides hook,
+ * whose cost should follow the collider footprint rather than the map size.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/components/collider.h"
+#include "entity/components/entity_component.h"
+#include "entity/components/entity_component_map.h"
+#include "entity/entity.h"
+#include "entity/entity_private.h"
+#include "types/collision_hit.h"
+#include "types/map.h"
+#include "types/map_cell.h"
+#include "types/rect.h"
+#include "utility/array.h"
+#include "utility/log.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_FRAMES 50
+#define BENCH_MAP_SIZE 128
+#define BENCH_TILE_SIZE 16
+#define BENCH_COLLIDERS 32
+#define BENCH_COLLIDER_SIZE 24.0f
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+/**
+ * @brief Create a collider entity with a single rect; it is not added to the engine.
+ */
+static EseEntity *_bench_make_collider(EseLuaEngine *lua) {
+    EseEntity *entity = entity_create(lua);
+
+    EseEntityComponent *collider = entity_component_collider_create(lua);
+    entity_component_add(entity, collider);
+
+    EseRect *rect = ese_rect_create(lua);
+    ese_rect_set_width(rect, BENCH_COLLIDER_SIZE);
+    ese_rect_set_height(rect, BENCH_COLLIDER_SIZE);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+    return entity;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    EseEngine *engine = engine_create(NULL);
+    EseLuaEngine *lua = engine->lua_engine;
+
+    // Checkerboard of solid cells over a grid map at the origin
+    EseMap *map = ese_map_create(lua, BENCH_MAP_SIZE, BENCH_MAP_SIZE, MAP_TYPE_GRID, true);
+    for (int y = 0; y < BENCH_MAP_SIZE; y++) {
+        for (int x = 0; x < BENCH_MAP_SIZE; x++) {
+            if ((x + y) & 1) {
+                ese_map_cell_set_flag(ese_map_get_cell(map, x, y), MAP_CELL_FLAG_SOLID);
+            }
+        }
+    }
+
+    EseEntity *map_entity = entity_create(lua);
+    EseEntityComponent *map_comp = entity_component_map_create(lua);
+    entity_component_add(map_entity, map_comp);
+    EseEntityComponentMap *map_data = (EseEntityComponentMap *)entity_component_get_data(map_comp);
+    map_data->map = map;
+    map_data->size = BENCH_TILE_SIZE;
+
+    // The map system is not running, so give the map entity bounds covering the whole map
+    map_entity->collision_world_bounds = ese_rect_create(lua);
+    ese_rect_set_width(map_entity->collision_world_bounds, BENCH_MAP_SIZE * BENCH_TILE_SIZE);
+    ese_rect_set_height(map_entity->collision_world_bounds, BENCH_MAP_SIZE * BENCH_TILE_SIZE);
+
+    EseEntity *colliders[BENCH_COLLIDERS];
+    for (int i = 0; i < BENCH_COLLIDERS; i++) {
+        colliders[i] = _bench_make_collider(lua);
+    }
+
+    EseBenchTimer t_collide = BENCH_TIMER("map collides");
+    EseArray *hits = array_create(64, (ArrayFreeFn)ese_collision_hit_destroy);
+    size_t hit_count = 0;
+
+    for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+        for (int i = 0; i < BENCH_COLLIDERS; i++) {
+            float x = (float)((frame * 13 + i * 97) % (BENCH_MAP_SIZE * BENCH_TILE_SIZE));
+            float y = (float)((frame * 7 + i * 61) % (BENCH_MAP_SIZE * BENCH_TILE_SIZE));
+            entity_set_position(colliders[i], x, y);
+        }
+
+        hit_count = 0;
+        bench_start(&t_collide);
+        for (int i = 0; i < BENCH_COLLIDERS; i++) {
+            EseEntityComponent *collider = colliders[i]->components[0];
+            map_comp->vtable->collides(map_comp, collider, hits);
+            hit_count += array_size(hits);
+            array_clear(hits);
+        }
+        bench_stop(&t_collide);
+    }
+
+    printf("\nMap collision benchmark: %dx%d grid, %d colliders, %d frames\n", BENCH_MAP_SIZE,
+           BENCH_MAP_SIZE, BENCH_COLLIDERS, BENCH_FRAMES);
+    bench_report(&t_collide);
+    printf("  hits last frame: %zu\n", hit_count);
+
+    array_destroy(hits);
+    for (int i = 0; i < BENCH_COLLIDERS; i++) {
+        entity_destroy(colliders[i]);
+    }
+    map_data->map = NULL;
+    entity_destroy(map_entity);
+    ese_map_destroy(map);
+    engine_destroy(engine);
+    memory_manager.destroy(true);
+    return 0;
+}
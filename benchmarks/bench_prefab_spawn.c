@@ -0,0 +1,108 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for spawning waves of identical entities: each wave is built once the way scripts do
+ * it today (entity_create, one entity_component_add per component, engine_add_entity) and once
+ * from a prefab with ese_prefab_spawn, which copies template components and notifies each system
+ * once per component type for the whole wave. Waves are cleared between runs.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/components/collider.h"
+#include "entity/components/entity_component.h"
+#include "entity/components/entity_component_sprite.h"
+#include "entity/entity.h"
+#include "scripting/lua_engine_private.h"
+#include "types/prefab.h"
+#include "types/rect.h"
+#include "utility/log.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_WAVE 500
+#define BENCH_WAVES 40
+#define BENCH_LUA_MEMORY (256u * 1024u * 1024u)
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+static EseEntity *_bench_entity(EseEngine *engine) {
+    EseEntity *entity = entity_create(engine->lua_engine);
+    entity_component_add(entity, entity_component_sprite_create(engine->lua_engine, "bench:walk"));
+
+    EseEntityComponent *collider = entity_component_collider_create(engine->lua_engine);
+    entity_component_add(entity, collider);
+    EseRect *rect = ese_rect_create(engine->lua_engine);
+    ese_rect_set_width(rect, 16.0f);
+    ese_rect_set_height(rect, 16.0f);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+
+    entity_add_tag(entity, "ENEMY");
+    return entity;
+}
+
+static void _bench_clear(EseEngine *engine) {
+    engine_clear_entities(engine, false);
+    engine_update(engine, 0.0f, engine->input_state);
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    EseEngine *engine = engine_create(NULL);
+    engine->lua_engine->internal->memory_limit = BENCH_LUA_MEMORY;
+
+    EseEntity *source = _bench_entity(engine);
+    EsePrefab *prefab = ese_prefab_create_from_entity(engine, source);
+
+    static float xs[BENCH_WAVE];
+    static float ys[BENCH_WAVE];
+    for (int i = 0; i < BENCH_WAVE; i++) {
+        xs[i] = (float)(i % 25) * 20.0f;
+        ys[i] = (float)(i / 25) * 20.0f;
+    }
+
+    EseBenchTimer t_manual = BENCH_TIMER("wave, entity_component_add");
+    EseBenchTimer t_prefab = BENCH_TIMER("wave, prefab spawn");
+
+    for (int wave = 0; wave < BENCH_WAVES; wave++) {
+        bench_start(&t_manual);
+        for (int i = 0; i < BENCH_WAVE; i++) {
+            EseEntity *entity = _bench_entity(engine);
+            engine_add_entity(engine, entity);
+            entity_set_position(entity, xs[i], ys[i]);
+        }
+        bench_stop(&t_manual);
+        _bench_clear(engine);
+
+        bench_start(&t_prefab);
+        ese_prefab_spawn(prefab, engine, BENCH_WAVE, xs, ys, NULL);
+        bench_stop(&t_prefab);
+        _bench_clear(engine);
+    }
+
+    printf("\nPrefab spawn benchmark: %d entities per wave, %d waves\n", BENCH_WAVE, BENCH_WAVES);
+    bench_report(&t_manual);
+    bench_report(&t_prefab);
+    printf("  speedup: %.1fx\n", (double)t_manual.total / (double)t_prefab.total);
+
+    ese_prefab_destroy(prefab);
+    entity_destroy(source);
+    engine_destroy(engine);
+    memory_manager.destroy(true);
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for the collision broadphase: 10k colliders of which only a small fraction move
+ * each frame. Times the per-frame spatial index sync plus pair generation.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/components/collider.h"
+#include "entity/components/entity_component.h"
+#include "entity/entity.h"
+#include "types/rect.h"
+#include "utility/log.h"
+#include "utility/spatial_index.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_FRAMES 300
+#define BENCH_COLLIDERS 10000
+#define BENCH_GRID_WIDTH 100
+#define BENCH_SPACING 20.0f
+#define BENCH_COLLIDER_SIZE 16.0f
+#define BENCH_MOVING_EVERY 50 /* 2% of the colliders move */
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+/**
+ * @brief Create a collider entity with a single rect at the given position.
+ */
+static EseEntity *_bench_make_collider(EseEngine *engine, float x, float y) {
+    EseLuaEngine *lua = engine->lua_engine;
+    EseEntity *entity = entity_create(lua);
+
+    EseEntityComponent *collider = entity_component_collider_create(lua);
+    entity_component_add(entity, collider);
+
+    EseRect *rect = ese_rect_create(lua);
+    ese_rect_set_width(rect, BENCH_COLLIDER_SIZE);
+    ese_rect_set_height(rect, BENCH_COLLIDER_SIZE);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+
+    entity_set_position(entity, x, y);
+    engine_add_entity(engine, entity);
+    return entity;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    EseEngine *engine = engine_create(NULL);
+    EseEntity **entities = memory_manager.malloc(sizeof(EseEntity *) * BENCH_COLLIDERS, MMTAG_TEMP);
+    float *home = memory_manager.malloc(sizeof(float) * BENCH_COLLIDERS * 2, MMTAG_TEMP);
+
+    for (size_t i = 0; i < BENCH_COLLIDERS; i++) {
+        home[i * 2] = (float)(i % BENCH_GRID_WIDTH) * BENCH_SPACING;
+        home[i * 2 + 1] = (float)(i / BENCH_GRID_WIDTH) * BENCH_SPACING;
+        entities[i] = _bench_make_collider(engine, home[i * 2], home[i * 2 + 1]);
+    }
+
+    EseBenchTimer t_sync = BENCH_TIMER("spatial index sync");
+    EseBenchTimer t_pairs = BENCH_TIMER("spatial_index_get_pairs");
+    EseBenchTimer t_total = BENCH_TIMER("broadphase total");
+    size_t pair_count = 0;
+
+    for (int frame = 0; frame < BENCH_FRAMES; frame++) {
+        // Movers wander a few pixels around their home position
+        for (size_t i = 0; i < BENCH_COLLIDERS; i += BENCH_MOVING_EVERY) {
+            float dx = (float)((frame + (int)i) % 13) - 6.0f;
+            float dy = (float)((frame * 3 + (int)i) % 13) - 6.0f;
+            entity_set_position(entities[i], home[i * 2] + dx, home[i * 2 + 1] + dy);
+        }
+
+        bench_start(&t_total);
+        bench_start(&t_sync);
+        spatial_index_update(engine->spatial_index);
+        bench_stop(&t_sync);
+
+        bench_start(&t_pairs);
+        const SpatialPair *pairs = NULL;
+        pair_count = spatial_index_get_pairs(engine->spatial_index, &pairs);
+        bench_stop(&t_pairs);
+        bench_stop(&t_total);
+    }
+
+    printf("\nSpatial index benchmark: %d colliders, 1 in %d moving, %d frames\n", BENCH_COLLIDERS,
+           BENCH_MOVING_EVERY, BENCH_FRAMES);
+    bench_report(&t_sync);
+    bench_report(&t_pairs);
+    bench_report(&t_total);
+    printf("  pairs last frame: %zu\n", pair_count);
+
+    memory_manager.free(home);
+    memory_manager.free(entities);
+    engine_destroy(engine);
+    memory_manager.destroy(true);
+    return 0;
+}
@@ -0,0 +1,188 @@
+/*
+ * Project: Entity Sprite Engine
+ *
+ * Benchmark for spatial queries over a world of scattered colliders: small rect queries served
+ * by the spatial index against the previous walk over every entity with
+ * entity_detect_collision_rect, then circle, ray and k-nearest queries from the index. Each
+ * query is one timer sample, so the averages are per query.
+ *
+ * Copyright (c) 2025-2026 Entity Sprite Engine
+ * See LICENSE.md for details.
+ */
+#include "bench.h"
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "entity/components/collider.h"
+#include "entity/components/entity_component.h"
+#include "entity/entity.h"
+#include "entity/entity_private.h"
+#include "types/rect.h"
+#include "utility/collision_shape.h"
+#include "utility/log.h"
+#include "utility/slot_map.h"
+#include "utility/spatial_index.h"
+#include <stdio.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define BENCH_ENTITIES 5000
+#define BENCH_QUERIES 1000
+#define BENCH_WALK_QUERIES 50 /* the walk takes milliseconds per query */
+#define BENCH_WORLD 8000.0f
+#define BENCH_ENTITY_SIZE 24.0f
+#define BENCH_QUERY_SIZE 96.0f
+#define BENCH_MAX_RESULTS 32
+#define BENCH_NEAREST 8
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+/**
+ * @brief Deterministic pseudo-random coordinate in [0, BENCH_WORLD).
+ */
+static float _bench_coord(uint32_t *state) {
+    *state = *state * 1664525u + 1013904223u;
+    return (float)(*state >> 8) / (float)(1u << 24) * BENCH_WORLD;
+}
+
+static void _bench_make_collider(EseEngine *engine, float x, float y) {
+    EseLuaEngine *lua = engine->lua_engine;
+    EseEntity *entity = entity_create(lua);
+
+    EseEntityComponent *collider = entity_component_collider_create(lua);
+    entity_component_add(entity, collider);
+
+    EseRect *rect = ese_rect_create(lua);
+    ese_rect_set_width(rect, BENCH_ENTITY_SIZE);
+    ese_rect_set_height(rect, BENCH_ENTITY_SIZE);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+
+    entity_set_position(entity, x, y);
+    engine_add_entity(engine, entity);
+}
+
+/**
+ * @brief The rect query as it was before the index: every entity is tested.
+ */
+static size_t _bench_walk_rect(EseEngine *engine, EseRect *rect, EseEntity **out, size_t max) {
+    size_t count = 0;
+    EseEntity **all = (EseEntity **)slot_map_values(engine->entities);
+    size_t total = slot_map_size(engine->entities);
+    for (size_t i = 0; i < total && count < max; i++) {
+        EseEntity *entity = all[i];
+        if (entity->active && entity_detect_collision_rect(entity, rect)) {
+            out[count++] = entity;
+        }
+    }
+    return count;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+int main(void) {
+    log_init();
+
+    EseEngine *engine = engine_create(NULL);
+    uint32_t seed = 12345u;
+    for (int i = 0; i < BENCH_ENTITIES; i++) {
+        float x = _bench_coord(&seed);
+        float y = _bench_coord(&seed);
+        _bench_make_collider(engine, x, y);
+    }
+    spatial_index_update(engine->spatial_index);
+
+    float points[BENCH_QUERIES][2];
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        points[i][0] = _bench_coord(&seed);
+        points[i][1] = _bench_coord(&seed);
+    }
+
+    EseRect *rect = ese_rect_create(engine->lua_engine);
+    ese_rect_set_width(rect, BENCH_QUERY_SIZE);
+    ese_rect_set_height(rect, BENCH_QUERY_SIZE);
+    EseEntity *entities[BENCH_MAX_RESULTS];
+    SpatialQueryHit hits[BENCH_MAX_RESULTS];
+    size_t walk_found = 0, rect_found = 0, circle_found = 0, ray_found = 0, nearest_found = 0;
+
+    EseBenchTimer t_walk = BENCH_TIMER("rect, entity walk");
+    for (int i = 0; i < BENCH_WALK_QUERIES; i++) {
+        ese_rect_set_x(rect, points[i][0]);
+        ese_rect_set_y(rect, points[i][1]);
+        bench_start(&t_walk);
+        walk_found += _bench_walk_rect(engine, rect, entities, BENCH_MAX_RESULTS);
+        bench_stop(&t_walk);
+    }
+
+    EseBenchTimer t_rect = BENCH_TIMER("rect, spatial index");
+    size_t rect_found_walked = 0;
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        ese_rect_set_x(rect, points[i][0]);
+        ese_rect_set_y(rect, points[i][1]);
+        bench_start(&t_rect);
+        EseCollisionShape area;
+        collision_shape_from_rect(&area, rect, 0.0f, 0.0f);
+        size_t found = spatial_index_query_rect(engine->spatial_index, &area, COLLIDER_MASK_ALL,
+                                                entities, BENCH_MAX_RESULTS);
+        bench_stop(&t_rect);
+        rect_found += found;
+        if (i < BENCH_WALK_QUERIES) {
+            rect_found_walked += found;
+        }
+    }
+
+    EseBenchTimer t_circle = BENCH_TIMER("circle");
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        bench_start(&t_circle);
+        circle_found += spatial_index_query_circle(engine->spatial_index, points[i][0],
+                                                   points[i][1], BENCH_QUERY_SIZE * 0.5f,
+                                                   COLLIDER_MASK_ALL, entities, BENCH_MAX_RESULTS);
+        bench_stop(&t_circle);
+    }
+
+    EseBenchTimer t_ray = BENCH_TIMER("ray, first hit");
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        float dx = points[(i + 1) % BENCH_QUERIES][0] - points[i][0];
+        float dy = points[(i + 1) % BENCH_QUERIES][1] - points[i][1];
+        bench_start(&t_ray);
+        ray_found += spatial_index_raycast(engine->spatial_index, points[i][0], points[i][1], dx,
+                                           dy, BENCH_WORLD, COLLIDER_MASK_ALL, hits)
+                         ? 1
+                         : 0;
+        bench_stop(&t_ray);
+    }
+
+    EseBenchTimer t_nearest = BENCH_TIMER("nearest 8");
+    for (int i = 0; i < BENCH_QUERIES; i++) {
+        bench_start(&t_nearest);
+        nearest_found += spatial_index_query_nearest(engine->spatial_index, points[i][0],
+                                                     points[i][1], COLLIDER_MASK_ALL, hits,
+                                                     BENCH_NEAREST);
+        bench_stop(&t_nearest);
+    }
+
+    printf("\nSpatial query benchmark: %d entities, %d queries per kind\n", BENCH_ENTITIES,
+           BENCH_QUERIES);
+    bench_report(&t_walk);
+    bench_report(&t_rect);
+    bench_report(&t_circle);
+    bench_report(&t_ray);
+    bench_report(&t_nearest);
+    printf("  found: walk %zu (index %zu on the same queries), rect %zu, circle %zu, ray %zu, "
+           "nearest %zu\n",
+           walk_found, rect_found_walked, rect_found, circle_found, ray_found, nearest_found);
+    printf("  rect speedup per query: %.1fx\n",
+           ((double)t_walk.total / (double)t_walk.samples) /
+               ((double)t_rect.total / (double)t_rect.samples));
+
+    ese_rect_destroy(rect);
+    engine_destroy(engine);
+    memory_manager.destroy(true);
+    return 0;
+}
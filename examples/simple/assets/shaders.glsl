@@ -3,12 +3,15 @@
 #ifdef VERTEX_SHADER
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec4 aColor;
 
 layout(location = 0) out vec2 TexCoord;
+layout(location = 1) out vec4 Color;
 
 void main() {
     gl_Position = vec4(aPos, 1.0);
     TexCoord = aTexCoord;
+    Color = aColor;
 }
 #endif
 
@@ -16,20 +19,20 @@ void main() {
 precision mediump float;
 
 layout(location = 0) in vec2 TexCoord;
+layout(location = 1) in vec4 Color;
 layout(location = 0) out vec4 FragColor;
 
 layout(binding = 0) uniform sampler2D ourTexture;
 
 layout(binding = 1) uniform UniformBufferObject {
     bool useTexture;
-    vec4 rectColor;
 } ubo;
 
 void main() {
     if (ubo.useTexture) {
-        FragColor = texture(ourTexture, TexCoord);
+        FragColor = texture(ourTexture, TexCoord) * Color;
     } else {
-        FragColor = ubo.rectColor;
+        FragColor = Color;
     }
 }
 #endif
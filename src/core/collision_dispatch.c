@@ -0,0 +1,293 @@
+/**
+ * COLLISION DISPATCH IMPLEMENTATION
+ * =================================
+ *
+ * Turns the hits produced by the collision resolver into Lua callbacks.
+ *
+ * Each hit is split into one record per receiving entity: collider hits are
+ * reported to both entities, map hits only to the collider. The first time an
+ * entity is seen in a frame it gets a receiver slot, stored on the entity, and
+ * the dispatch checks once whether its script defines entity_collisions.
+ *
+ * - Entities without entity_collisions get the per-hit callbacks straight
+ *   away, exactly as before.
+ * - Records for batched entities are queued with their slot, grouped by slot
+ *   with a counting pass (hit order is kept inside each group) and handed to
+ *   entity_process_collision_batch, one Lua call per entity.
+ *
+ * Slots are cleared again at the end of the run. All buffers belong to the
+ * dispatch and only grow, so steady frames do not allocate per hit.
+ *
+ * Every Lua allocation goes through the tracked allocator, so fresh tables per
+ * record would cost more than the per-hit calls they replace. The hits array
+ * and its record tables are therefore kept in the registry and reused by every
+ * batch call: records are refilled in place, and once the callback returns the
+ * array is emptied and each record's `other` cleared so no entity proxy
+ * outlives the call. Scripts must copy what they need instead of keeping
+ * `hits` or its records.
+ *
+ * Thread Safety:
+ * - Not thread-safe; runs on the thread that owns the Lua state.
+ */
+
+#include "collision_dispatch.h"
+#include "core/memory_manager.h"
+#include "entity/entity.h"
+#include "entity/entity_lua.h"
+#include "entity/entity_private.h"
+#include "scripting/lua_engine.h"
+#include "scripting/lua_value.h"
+#include "types/collision_hit.h"
+#include "utility/array.h"
+#include "utility/log.h"
+#include "vendor/lua/src/lauxlib.h"
+#include "vendor/lua/src/lua.h"
+#include <stdbool.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+/**
+ * @brief An entity that received at least one record this frame.
+ */
+typedef struct CollisionReceiver {
+    EseEntity *entity; /** Receiving entity */
+    bool batched;      /** Entity takes entity_collisions instead of per-hit calls */
+    size_t start;      /** First record of the entity in the grouped buffer */
+    size_t count;      /** Number of queued records */
+} CollisionReceiver;
+
+struct CollisionDispatch {
+    EseLuaEngine *lua;       /** Lua engine the batch tables live in (not owned) */
+    int hits_ref;            /** Registry ref of the reused hits array */
+    int record_pool_ref;     /** Registry ref of the array of reusable record tables */
+    EseLuaValue *hits_value; /** Argument wrapping hits_ref */
+
+    CollisionReceiver *receivers; /** Receivers in order of first appearance */
+    size_t receiver_count;        /** Receivers used this frame */
+    size_t receiver_capacity;     /** Allocated receivers */
+
+    EseCollisionRecord *records; /** Queued records for batched entities, in hit order */
+    uint32_t *record_slots;      /** Receiver slot of each queued record */
+    EseCollisionRecord *grouped; /** Queued records grouped by receiver */
+    size_t record_count;         /** Records queued this frame */
+    size_t record_capacity;      /** Allocated records */
+};
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+static uint32_t _receiver_slot(CollisionDispatch *dispatch, EseEntity *entity) {
+    if (entity->collision_dispatch_slot != COLLISION_DISPATCH_NO_SLOT) {
+        return entity->collision_dispatch_slot;
+    }
+
+    if (dispatch->receiver_count == dispatch->receiver_capacity) {
+        size_t capacity = dispatch->receiver_capacity ? dispatch->receiver_capacity * 2 : 64;
+        dispatch->receivers = memory_manager.realloc(
+            dispatch->receivers, sizeof(CollisionReceiver) * capacity, MMTAG_COLLISION_INDEX);
+        dispatch->receiver_capacity = capacity;
+    }
+
+    uint32_t slot = (uint32_t)dispatch->receiver_count++;
+    CollisionReceiver *receiver = &dispatch->receivers[slot];
+    receiver->entity = entity;
+    receiver->batched = entity_wants_collision_batch(entity);
+    receiver->start = 0;
+    receiver->count = 0;
+    entity->collision_dispatch_slot = slot;
+    return slot;
+}
+
+static void _queue_record(CollisionDispatch *dispatch, uint32_t slot,
+                          const EseCollisionRecord *record) {
+    if (dispatch->record_count == dispatch->record_capacity) {
+        size_t capacity = dispatch->record_capacity ? dispatch->record_capacity * 2 : 128;
+        dispatch->records = memory_manager.realloc(
+            dispatch->records, sizeof(EseCollisionRecord) * capacity, MMTAG_COLLISION_INDEX);
+        dispatch->record_slots = memory_manager.realloc(
+            dispatch->record_slots, sizeof(uint32_t) * capacity, MMTAG_COLLISION_INDEX);
+        dispatch->grouped = memory_manager.realloc(
+            dispatch->grouped, sizeof(EseCollisionRecord) * capacity, MMTAG_COLLISION_INDEX);
+        dispatch->record_capacity = capacity;
+    }
+
+    dispatch->records[dispatch->record_count] = *record;
+    dispatch->record_slots[dispatch->record_count] = slot;
+    dispatch->record_count++;
+    dispatch->receivers[slot].count++;
+}
+
+/**
+ * @brief Runs the per-hit callback now, or queues the record for a batch.
+ */
+static void _deliver(CollisionDispatch *dispatch, EseEntity *entity,
+                     const EseCollisionRecord *record) {
+    uint32_t slot = _receiver_slot(dispatch, entity);
+    if (dispatch->receivers[slot].batched) {
+        _queue_record(dispatch, slot, record);
+    } else {
+        entity_process_collision_record(entity, record);
+    }
+}
+
+/**
+ * @brief Fills the shared hits array with @p records and calls entity_collisions.
+ */
+static void _run_batch(CollisionDispatch *dispatch, EseEntity *entity,
+                       const EseCollisionRecord *records, size_t count) {
+    lua_State *L = dispatch->lua->runtime;
+
+    // Stack: hits, pool
+    lua_rawgeti(L, LUA_REGISTRYINDEX, dispatch->hits_ref);
+    lua_rawgeti(L, LUA_REGISTRYINDEX, dispatch->record_pool_ref);
+    for (size_t i = 0; i < count; i++) {
+        const EseCollisionRecord *record = &records[i];
+        int index = (int)i + 1;
+
+        lua_rawgeti(L, -1, index);
+        if (lua_isnil(L, -1)) {
+            lua_pop(L, 1);
+            lua_createtable(L, 0, 5);
+            lua_pushvalue(L, -1);
+            lua_rawseti(L, -3, index);
+        }
+
+        entity_lua_push(record->other);
+        lua_setfield(L, -2, "other");
+        lua_pushinteger(L, record->state);
+        lua_setfield(L, -2, "state");
+        lua_pushinteger(L, record->kind);
+        lua_setfield(L, -2, "kind");
+        if (record->kind == COLLISION_KIND_MAP) {
+            lua_pushinteger(L, record->cell_x);
+            lua_setfield(L, -2, "cell_x");
+            lua_pushinteger(L, record->cell_y);
+            lua_setfield(L, -2, "cell_y");
+        } else {
+            lua_pushnil(L);
+            lua_setfield(L, -2, "cell_x");
+            lua_pushnil(L);
+            lua_setfield(L, -2, "cell_y");
+        }
+        lua_rawseti(L, -3, index);
+    }
+    lua_pop(L, 2);
+
+    EseLuaValue *args[] = {dispatch->hits_value};
+    entity_run_function_with_args(entity, "entity_collisions", 1, args);
+
+    // Empty the array and drop the entity references again
+    lua_rawgeti(L, LUA_REGISTRYINDEX, dispatch->hits_ref);
+    for (size_t i = 0; i < count; i++) {
+        int index = (int)i + 1;
+        lua_rawgeti(L, -1, index);
+        if (lua_istable(L, -1)) {
+            lua_pushnil(L);
+            lua_setfield(L, -2, "other");
+        }
+        lua_pop(L, 1);
+        lua_pushnil(L);
+        lua_rawseti(L, -2, index);
+    }
+    lua_pop(L, 1);
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+CollisionDispatch *collision_dispatch_create(EseLuaEngine *lua) {
+    log_assert("COLLISION_DISPATCH", lua, "collision_dispatch_create called with NULL lua");
+
+    CollisionDispatch *dispatch =
+        memory_manager.calloc(1, sizeof(CollisionDispatch), MMTAG_COLLISION_INDEX);
+    dispatch->lua = lua;
+
+    lua_State *L = lua->runtime;
+    lua_newtable(L);
+    dispatch->hits_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    lua_newtable(L);
+    dispatch->record_pool_ref = luaL_ref(L, LUA_REGISTRYINDEX);
+    dispatch->hits_value = lua_value_create_ref("hits", dispatch->hits_ref);
+    return dispatch;
+}
+
+void collision_dispatch_destroy(CollisionDispatch *dispatch) {
+    if (!dispatch)
+        return;
+    lua_value_destroy(dispatch->hits_value);
+    luaL_unref(dispatch->lua->runtime, LUA_REGISTRYINDEX, dispatch->hits_ref);
+    luaL_unref(dispatch->lua->runtime, LUA_REGISTRYINDEX, dispatch->record_pool_ref);
+    memory_manager.free(dispatch->receivers);
+    memory_manager.free(dispatch->records);
+    memory_manager.free(dispatch->record_slots);
+    memory_manager.free(dispatch->grouped);
+    memory_manager.free(dispatch);
+}
+
+void collision_dispatch_run(CollisionDispatch *dispatch, EseArray *hits) {
+    log_assert("COLLISION_DISPATCH", dispatch, "collision_dispatch_run called with NULL dispatch");
+    log_assert("COLLISION_DISPATCH", hits, "collision_dispatch_run called with NULL hits");
+
+    dispatch->receiver_count = 0;
+    dispatch->record_count = 0;
+
+    size_t hit_count = array_size(hits);
+    for (size_t i = 0; i < hit_count; i++) {
+        EseCollisionHit *hit = (EseCollisionHit *)array_get(hits, i);
+        if (!hit)
+            continue;
+
+        EseCollisionKind kind = ese_collision_hit_get_kind(hit);
+        EseCollisionState state = ese_collision_hit_get_state(hit);
+        if (kind != COLLISION_KIND_COLLIDER && kind != COLLISION_KIND_MAP) {
+            log_error("COLLISION_DISPATCH", "collision_dispatch_run: unknown collision kind");
+            continue;
+        }
+        if (state == COLLISION_STATE_NONE) {
+            continue;
+        }
+
+        EseEntity *entity = ese_collision_hit_get_entity(hit);
+        EseEntity *target = ese_collision_hit_get_target(hit);
+        EseCollisionRecord record = {.other = target, .kind = kind, .state = state};
+        if (kind == COLLISION_KIND_MAP) {
+            record.cell_x = ese_collision_hit_get_cell_x(hit);
+            record.cell_y = ese_collision_hit_get_cell_y(hit);
+        }
+        _deliver(dispatch, entity, &record);
+
+        // Collider hits are reported to both entities, map hits only to the collider
+        if (kind == COLLISION_KIND_COLLIDER) {
+            record.other = entity;
+            _deliver(dispatch, target, &record);
+        }
+    }
+
+    // Group queued records by receiver; hit order is kept inside each group
+    size_t offset = 0;
+    for (size_t r = 0; r < dispatch->receiver_count; r++) {
+        dispatch->receivers[r].start = offset;
+        offset += dispatch->receivers[r].count;
+        dispatch->receivers[r].count = 0;
+    }
+    for (size_t i = 0; i < dispatch->record_count; i++) {
+        CollisionReceiver *receiver = &dispatch->receivers[dispatch->record_slots[i]];
+        dispatch->grouped[receiver->start + receiver->count++] = dispatch->records[i];
+    }
+
+    for (size_t r = 0; r < dispatch->receiver_count; r++) {
+        CollisionReceiver *receiver = &dispatch->receivers[r];
+        if (receiver->batched && receiver->count > 0) {
+            _run_batch(dispatch, receiver->entity, dispatch->grouped + receiver->start,
+                       receiver->count);
+        }
+    }
+
+    for (size_t r = 0; r < dispatch->receiver_count; r++) {
+        dispatch->receivers[r].entity->collision_dispatch_slot = COLLISION_DISPATCH_NO_SLOT;
+    }
+}
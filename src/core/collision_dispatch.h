@@ -0,0 +1,33 @@
+#ifndef ESE_COLLISION_DISPATCH_H
+#define ESE_COLLISION_DISPATCH_H
+
+#include "utility/array.h"
+#include <stdint.h>
+
+// Value of EseEntity::collision_dispatch_slot outside of a dispatch
+#define COLLISION_DISPATCH_NO_SLOT UINT32_MAX
+
+// Forward declarations (avoid heavy includes)
+typedef struct EseEntity EseEntity;
+typedef struct EseLuaEngine EseLuaEngine;
+
+// Delivers a frame's collision hits to entity scripts.
+// Entities whose script defines entity_collisions(self, hits) get a single call
+// with all of their hits for the frame; every other entity keeps the per-hit
+// entity_collision_* / map_collision_* callbacks. Buffers, including the Lua
+// hits array and its record tables, are reused between frames, so a steady
+// frame does not allocate per hit.
+typedef struct CollisionDispatch CollisionDispatch;
+
+// The dispatch keeps its Lua tables in @p lua's registry; destroy it before
+// the Lua engine.
+CollisionDispatch *collision_dispatch_create(EseLuaEngine *lua);
+void collision_dispatch_destroy(CollisionDispatch *dispatch);
+
+// Runs the callbacks for an EseArray of EseCollisionHit* as returned by
+// collision_resolver_solve. Per-hit callbacks run first, in hit order; batched
+// entities are then called in the order they first appear, each with its hits
+// in hit order.
+void collision_dispatch_run(CollisionDispatch *dispatch, EseArray *hits);
+
+#endif // ESE_COLLISION_DISPATCH_H
@@ -27,7 +27,7 @@
  *
  * 1. PAIR PROCESSING:
  *    - Process each spatial pair from the spatial index
- *    - Generate canonical collision key for state tracking
+ *    - Use the pair's packed proxy-id key for state tracking
  *    - Check previous collision state for transitions
  *
  * 2. BROAD-PHASE FILTERING:
@@ -55,14 +55,14 @@
  * Given: Two entities A and B with collider components
  *        Previous state: Not colliding
  *
- * Step 1: Generate collision key
- *   - Entity A ID: "entity-123"
- *   - Entity B ID: "entity-456"
- *   - Canonical key: "entity-123|entity-456" (sorted alphabetically)
+ * Step 1: Take the pair key
+ *   - Entity A proxy: 12
+ *   - Entity B proxy: 45
+ *   - Canonical key: (12 << 32) | 45 (packed by the spatial index)
  *
  * Step 2: Check previous state
- *   - Look up key in previous_collisions hashmap
- *   - Result: NULL (not colliding in previous frame)
+ *   - Look up key in the previous contact table
+ *   - Result: no contact (not colliding in previous frame)
  *
  * Step 3: AABB overlap test
  *   - Entity A bounds: (100, 50, 64, 32)
@@ -158,7 +158,7 @@
  * Time Complexity:
  * - Per pair: O(1) for AABB test + O(k) for component testing
  * - Total: O(n + k) where n=pairs, k=detailed collision tests
- * - State lookup: O(1) average case with hashmap
+ * - State lookup: O(1) average case with an open-addressing contact table
  *
  * Space Complexity:
  * - Hit storage: O(k) where k=active collision pairs
@@ -166,17 +166,19 @@
  * - Temporary arrays: O(1) per pair (reused)
  *
  * Memory Layout:
- * - CollisionResolver: 24 bytes + hashmap overhead
+ * - CollisionResolver: hit arrays + two persistent contact tables
  * - EseCollisionHit: Variable based on collision type
- * - State tracking: ~16 bytes per unique pair
+ * - State tracking: 32-byte contact + 4-byte stamp per slot, load <= 1/2
  *
  * OPTIMIZATION FEATURES
  * =====================
  *
  * 1. AABB prefiltering: Skip expensive component tests for non-overlapping
  * pairs
- * 2. State caching: Track collision history to avoid redundant testing
- * 3. Canonical keys: Prevent duplicate collision pairs using sorted entity IDs
+ * 2. State caching: Contacts live in two tables that swap roles each solve.
+ *    The table being refilled is emptied by bumping its generation counter,
+ *    so no per-frame map or key allocation is made
+ * 3. Canonical keys: Pairs carry packed (lower << 32 | higher) proxy ids
  * 4. Component dispatch: Route to appropriate collision testing based on
  * component types
  * 5. Hit reuse: Transfer ownership of detailed hits to avoid copying
@@ -217,6 +219,11 @@
  * - Resolver maintains collision state between frames
  * - State transitions are automatically detected
  * - Previous collision state is updated after each solve
+ * - collision_resolver_forget_entity() drops the contacts of an entity that
+ *   left the spatial index, so a reused proxy id never inherits its state
+ * - The spatial index does not pair two resting (static or sleeping)
+ *   entities. Their remembered contacts are carried into the next solve and
+ *   keep reporting STAY instead of turning into LEAVE
  *
  * Thread Safety:
  * - Not thread-safe by design
@@ -233,12 +240,12 @@
 #include "entity/entity_private.h"
 #include "types/rect.h"
 #include "utility/array.h"
-#include "utility/hashmap.h"
+#include "utility/job_queue.h"
 #include "utility/log.h"
 #include "utility/profile.h"
 #include "utility/spatial_index.h"
 #include <math.h>
-#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 // Forward declarations to avoid pulling component headers into the public API
@@ -247,9 +254,100 @@ typedef struct EseMap EseMap;
 
 // CollisionKind and EseCollisionHit are now declared in the public header
 
+#define COLLISION_RESOLVER_INITIAL_CONTACT_BITS 8
+
+// Below this many pairs the narrow phase stays on the calling thread
+#define COLLISION_RESOLVER_PARALLEL_MIN_PAIRS 512
+// Pairs handed to one job
+#define COLLISION_RESOLVER_CHUNK_PAIRS 256
+
+/**
+ * @brief Outcome of the narrow phase for one pair.
+ */
+typedef enum CollisionNarrowStatus {
+    COLLISION_NARROW_MISS = 0, // Nothing touches
+    COLLISION_NARROW_HIT,      // Exactly one collider-vs-collider hit
+    COLLISION_NARROW_DEFER,    // Maps or several hits: rerun on the main thread
+} CollisionNarrowStatus;
+
+/**
+ * @brief Plain-data narrow phase result, written by whichever thread ran the
+ *        pair's chunk. Hits are only materialised on the main thread because
+ *        they allocate and are bound to Lua.
+ */
+typedef struct CollisionNarrowResult {
+    EseEntityComponentCollider *collider_a;
+    EseEntityComponentCollider *collider_b;
+    uint32_t rect_b;
+    uint8_t status; // CollisionNarrowStatus
+    bool aabb_overlap;
+} CollisionNarrowResult;
+
+/**
+ * @brief A contiguous range of pairs and the result slots it fills.
+ */
+typedef struct CollisionNarrowJob {
+    const SpatialPair *pairs;
+    CollisionNarrowResult *results;
+    size_t begin;
+    size_t end;
+} CollisionNarrowJob;
+
+/**
+ * @brief Sort record used to merge results in pair-key order.
+ */
+typedef struct CollisionPairOrder {
+    uint64_t key;
+    uint32_t index;
+} CollisionPairOrder;
+
+/**
+ * @brief One colliding pair remembered between solves.
+ *
+ * @details Keyed by the packed proxy ids from SpatialPair::key. A contact whose
+ *          entities were forgotten keeps its slot (so probe chains stay intact)
+ *          with `a` set to NULL. The collider pointers in `narrow` stay valid
+ *          while both entities rest: removing a component wakes the entity.
+ */
+typedef struct CollisionContact {
+    uint64_t key;
+    EseEntity *a;
+    EseEntity *b;
+    CollisionNarrowResult narrow; // Result that made the pair collide, reused when carried
+    bool visited;                 // Seen in the pair list of the current solve
+} CollisionContact;
+
+/**
+ * @brief Open-addressing contact table cleared by bumping its generation.
+ *
+ * @details A slot is occupied only when its stamp equals the table
+ *          generation, so clearing never touches the slots.
+ */
+typedef struct CollisionContactTable {
+    CollisionContact *contacts;
+    uint32_t *stamps;
+    uint32_t bits; // capacity == 1 << bits
+    uint32_t count;
+    uint32_t generation;
+} CollisionContactTable;
+
 struct CollisionResolver {
-    EseArray *hits;                  // EseCollisionHit*
-    EseHashMap *previous_collisions; // canonical keys seen colliding in previous solve
+    EseArray *hits;      // EseCollisionHit*
+    EseArray *pair_hits; // Scratch for one pair's detailed hits, reused across solves
+    // Contacts colliding in the previous solve and the ones being built by the
+    // current solve. The tables swap roles at the end of every solve.
+    CollisionContactTable tables[2];
+    CollisionContactTable *previous;
+    CollisionContactTable *current;
+
+    // Narrow phase buffers, grown on demand and reused across solves
+    EseJobQueue *job_queue; // Optional, not owned
+    CollisionNarrowResult *results;
+    CollisionPairOrder *order;
+    size_t pair_capacity;
+    CollisionNarrowJob *jobs;
+    ese_job_id_t *job_ids;
+    size_t job_capacity;
 };
 
 static bool _pair_involves_map_collision(EseEntity *a, EseEntity *b) {
@@ -344,104 +442,419 @@ static bool _get_map_pair_entities(EseEntity *a, EseEntity *b, EseEntity **out_c
     return false;
 }
 
-const char *_get_collision_key(EseUUID *a, EseUUID *b) {
-    const char *ida = ese_uuid_get_value(a);
-    const char *idb = ese_uuid_get_value(b);
-    const char *first = ida;
-    const char *second = idb;
-    if (strcmp(ida, idb) > 0) {
-        first = idb;
-        second = ida;
+static void _contact_table_init(CollisionContactTable *table, uint32_t bits) {
+    size_t capacity = (size_t)1 << bits;
+    table->contacts =
+        memory_manager.malloc(sizeof(CollisionContact) * capacity, MMTAG_COLLISION_INDEX);
+    table->stamps = memory_manager.calloc(capacity, sizeof(uint32_t), MMTAG_COLLISION_INDEX);
+    table->bits = bits;
+    table->count = 0;
+    table->generation = 1;
+}
+
+static void _contact_table_free(CollisionContactTable *table) {
+    memory_manager.free(table->contacts);
+    memory_manager.free(table->stamps);
+}
+
+static void _contact_table_clear(CollisionContactTable *table) {
+    table->count = 0;
+    if (++table->generation == 0) {
+        memset(table->stamps, 0, sizeof(uint32_t) * ((size_t)1 << table->bits));
+        table->generation = 1;
+    }
+}
+
+static size_t _contact_table_slot(const CollisionContactTable *table, uint64_t key) {
+    return (size_t)((key * 0x9E3779B97F4A7C15ull) >> (64 - table->bits));
+}
+
+static CollisionContact *_contact_table_find(CollisionContactTable *table, uint64_t key) {
+    size_t mask = ((size_t)1 << table->bits) - 1;
+    size_t slot = _contact_table_slot(table, key);
+    while (table->stamps[slot] == table->generation) {
+        CollisionContact *contact = &table->contacts[slot];
+        if (contact->key == key)
+            return contact->a ? contact : NULL;
+        slot = (slot + 1) & mask;
+    }
+    return NULL;
+}
+
+static void _contact_table_put(CollisionContactTable *table, const CollisionContact *contact) {
+    size_t mask = ((size_t)1 << table->bits) - 1;
+    size_t slot = _contact_table_slot(table, contact->key);
+    while (table->stamps[slot] == table->generation)
+        slot = (slot + 1) & mask;
+    table->contacts[slot] = *contact;
+    table->stamps[slot] = table->generation;
+    table->count++;
+}
+
+static void _contact_table_grow(CollisionContactTable *table) {
+    CollisionContactTable old = *table;
+    _contact_table_init(table, old.bits + 1);
+    size_t old_capacity = (size_t)1 << old.bits;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old.stamps[i] == old.generation && old.contacts[i].a)
+            _contact_table_put(table, &old.contacts[i]);
+    }
+    _contact_table_free(&old);
+}
+
+/**
+ * @brief Records a colliding pair. Each key is inserted at most once per solve
+ *        because the spatial index deduplicates its pairs.
+ */
+static void _contact_table_insert(CollisionContactTable *table, uint64_t key, EseEntity *a,
+                                  EseEntity *b, const CollisionNarrowResult *narrow) {
+    // Keep the load factor at or below 1/2
+    if ((table->count + 1) * 2 > ((uint32_t)1 << table->bits)) {
+        _contact_table_grow(table);
+    }
+    CollisionContact contact = {.key = key, .a = a, .b = b, .narrow = *narrow, .visited = false};
+    _contact_table_put(table, &contact);
+}
+
+/**
+ * @brief Runs the narrow phase for one pair without allocating.
+ *
+ * @details Mirrors entity_test_collision() for entities that only carry
+ *          colliders. Anything the plain-data result cannot describe (map
+ *          components, more than one hit) is deferred to the main thread.
+ */
+static void _narrow_pair(const SpatialPair *pair, CollisionNarrowResult *out) {
+    EseEntity *a = pair->a;
+    EseEntity *b = pair->b;
+    out->collider_a = NULL;
+    out->collider_b = NULL;
+    out->rect_b = 0;
+    out->status = COLLISION_NARROW_MISS;
+
+    // Cheap broadphase overlap using entity world AABBs
+    bool has_bounds = a->collision_world_bounds && b->collision_world_bounds;
+    out->aabb_overlap =
+        has_bounds ? ese_rect_intersects(a->collision_world_bounds, b->collision_world_bounds)
+                   : false;
+    if (!out->aabb_overlap || !a->active || !b->active)
+        return;
+
+    for (size_t i = 0; i < a->component_count; i++) {
+        EseEntityComponent *comp = a->components[i];
+        if (comp->active && comp->type == ENTITY_COMPONENT_MAP) {
+            out->status = COLLISION_NARROW_DEFER;
+            return;
+        }
     }
-    size_t keylen = strlen(first) + 1 + strlen(second) + 1;
-    char *key = memory_manager.malloc(keylen, MMTAG_ENGINE);
-    snprintf(key, keylen, "%s|%s", first, second);
-    return key; // NOTE: caller (hashmap_set) MUST take ownership and free later
+    for (size_t j = 0; j < b->component_count; j++) {
+        EseEntityComponent *comp = b->components[j];
+        if (comp->active && comp->type == ENTITY_COMPONENT_MAP) {
+            out->status = COLLISION_NARROW_DEFER;
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < a->component_count; i++) {
+        EseEntityComponent *comp_a = a->components[i];
+        if (!comp_a->active || comp_a->type != ENTITY_COMPONENT_COLLIDER)
+            continue;
+        for (size_t j = 0; j < b->component_count; j++) {
+            EseEntityComponent *comp_b = b->components[j];
+            if (!comp_b->active || comp_b->type != ENTITY_COMPONENT_COLLIDER)
+                continue;
+            size_t rect_b = 0;
+            if (!entity_component_collider_test_collider(comp_a->data, comp_b->data, &rect_b))
+                continue;
+            if (out->status == COLLISION_NARROW_HIT) {
+                out->status = COLLISION_NARROW_DEFER;
+                return;
+            }
+            out->status = COLLISION_NARROW_HIT;
+            out->collider_a = (EseEntityComponentCollider *)comp_a->data;
+            out->collider_b = (EseEntityComponentCollider *)comp_b->data;
+            out->rect_b = (uint32_t)rect_b;
+        }
+    }
+}
+
+static void _narrow_range(const CollisionNarrowJob *job) {
+    for (size_t i = job->begin; i < job->end; i++) {
+        _narrow_pair(&job->pairs[i], &job->results[i]);
+    }
+}
+
+static JobResult _narrow_job_worker(void *thread_data, const void *user_data,
+                                    volatile bool *canceled) {
+    (void)thread_data;
+    (void)canceled;
+
+    _narrow_range((const CollisionNarrowJob *)user_data);
+
+    JobResult res = {.result = NULL, .size = 0, .copy_fn = NULL, .free_fn = NULL};
+    return res;
 }
 
-CollisionResolver *collision_resolver_create(void) {
+static void _narrow_job_cleanup(ese_job_id_t job_id, void *user_data, void *result) {
+    // Job slots belong to the resolver and are reused every solve
+    (void)job_id;
+    (void)user_data;
+    (void)result;
+}
+
+static void _reserve_pairs(CollisionResolver *resolver, size_t pair_count) {
+    if (pair_count <= resolver->pair_capacity)
+        return;
+    size_t capacity = resolver->pair_capacity ? resolver->pair_capacity : 128;
+    while (capacity < pair_count)
+        capacity *= 2;
+    resolver->results = memory_manager.realloc(
+        resolver->results, sizeof(CollisionNarrowResult) * capacity, MMTAG_COLLISION_INDEX);
+    resolver->order = memory_manager.realloc(resolver->order, sizeof(CollisionPairOrder) * capacity,
+                                             MMTAG_COLLISION_INDEX);
+    resolver->pair_capacity = capacity;
+}
+
+static void _reserve_jobs(CollisionResolver *resolver, size_t job_count) {
+    if (job_count <= resolver->job_capacity)
+        return;
+    size_t capacity = resolver->job_capacity ? resolver->job_capacity : 8;
+    while (capacity < job_count)
+        capacity *= 2;
+    resolver->jobs = memory_manager.realloc(resolver->jobs, sizeof(CollisionNarrowJob) * capacity,
+                                            MMTAG_COLLISION_INDEX);
+    resolver->job_ids = memory_manager.realloc(resolver->job_ids, sizeof(ese_job_id_t) * capacity,
+                                               MMTAG_COLLISION_INDEX);
+    resolver->job_capacity = capacity;
+}
+
+/**
+ * @brief Fills resolver->results for every pair, spreading chunks over the job
+ *        queue when there are enough pairs. The calling thread runs the first
+ *        chunk itself and reruns any chunk the queue did not complete.
+ */
+static void _narrow_phase(CollisionResolver *resolver, const SpatialPair *pairs,
+                          size_t pair_count) {
+    size_t job_count = (pair_count + COLLISION_RESOLVER_CHUNK_PAIRS - 1) /
+                       COLLISION_RESOLVER_CHUNK_PAIRS;
+    if (!resolver->job_queue || pair_count < COLLISION_RESOLVER_PARALLEL_MIN_PAIRS) {
+        CollisionNarrowJob all = {
+            .pairs = pairs, .results = resolver->results, .begin = 0, .end = pair_count};
+        _narrow_range(&all);
+        return;
+    }
+
+    _reserve_jobs(resolver, job_count);
+    for (size_t j = 0; j < job_count; j++) {
+        CollisionNarrowJob *job = &resolver->jobs[j];
+        job->pairs = pairs;
+        job->results = resolver->results;
+        job->begin = j * COLLISION_RESOLVER_CHUNK_PAIRS;
+        job->end = job->begin + COLLISION_RESOLVER_CHUNK_PAIRS;
+        if (job->end > pair_count)
+            job->end = pair_count;
+        resolver->job_ids[j] = ESE_JOB_NOT_QUEUED;
+        if (j > 0) {
+            resolver->job_ids[j] = ese_job_queue_push(resolver->job_queue, _narrow_job_worker,
+                                                      NULL, _narrow_job_cleanup, job);
+        }
+    }
+
+    _narrow_range(&resolver->jobs[0]);
+    for (size_t j = 1; j < job_count; j++) {
+        ese_job_id_t id = resolver->job_ids[j];
+        if (id == ESE_JOB_NOT_QUEUED ||
+            ese_job_queue_wait_for_completion(resolver->job_queue, id, 0) != ESE_JOB_COMPLETED) {
+            _narrow_range(&resolver->jobs[j]);
+        }
+    }
+    profile_count_add("resolver_narrow_parallel_solves");
+}
+
+static int _pair_order_compare(const void *lhs, const void *rhs) {
+    uint64_t a = ((const CollisionPairOrder *)lhs)->key;
+    uint64_t b = ((const CollisionPairOrder *)rhs)->key;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Appends a minimal LEAVE hit for a pair that stopped colliding.
+ */
+static void _emit_leave_hit(CollisionResolver *resolver, EseLuaEngine *engine, EseEntity *a,
+                            EseEntity *b) {
+    EseCollisionHit *exit_hit = ese_collision_hit_create(engine);
+    EseCollisionKind kind =
+        _pair_involves_map_collision(a, b) ? COLLISION_KIND_MAP : COLLISION_KIND_COLLIDER;
+    ese_collision_hit_set_kind(exit_hit, kind);
+    if (kind == COLLISION_KIND_MAP) {
+        EseEntity *collider_entity = a, *map_entity = b;
+        if (_get_map_pair_entities(a, b, &collider_entity, &map_entity)) {
+            ese_collision_hit_set_entity(exit_hit, collider_entity);
+            ese_collision_hit_set_target(exit_hit, map_entity);
+        } else {
+            ese_collision_hit_set_entity(exit_hit, a);
+            ese_collision_hit_set_target(exit_hit, b);
+        }
+    } else {
+        ese_collision_hit_set_entity(exit_hit, a);
+        ese_collision_hit_set_target(exit_hit, b);
+        ese_collision_hit_set_rect(exit_hit, NULL);
+    }
+    ese_collision_hit_set_state(exit_hit, COLLISION_STATE_LEAVE);
+    if (!array_push(resolver->hits, exit_hit)) {
+        memory_manager.free(exit_hit);
+    }
+}
+
+/**
+ * @brief Keeps a contact between two resting entities, which the spatial
+ *        index no longer pairs.
+ *
+ * @details Neither entity changed since the contact was found, so a single
+ *          collider hit is rebuilt from the remembered result. Other contacts
+ *          (maps, several hits) rerun entity_test_collision for this pair only.
+ */
+static void _carry_contact(CollisionResolver *resolver, EseLuaEngine *engine,
+                           CollisionContactTable *current, const CollisionContact *contact) {
+    EseArray *tmp_hits = resolver->pair_hits;
+    const CollisionNarrowResult *narrow = &contact->narrow;
+    bool colliding;
+    array_clear(tmp_hits);
+    if (narrow->status == COLLISION_NARROW_HIT && narrow->collider_a->base.active &&
+        narrow->collider_b->base.active) {
+        array_push(tmp_hits, entity_component_collider_make_hit(
+                                 narrow->collider_a, narrow->collider_b, narrow->rect_b));
+        colliding = true;
+    } else {
+        colliding = entity_test_collision(contact->a, contact->b, tmp_hits);
+    }
+
+    size_t count_hits = array_size(tmp_hits);
+    if (!colliding) {
+        for (size_t hi = 0; hi < count_hits; hi++) {
+            memory_manager.free(array_get(tmp_hits, hi));
+        }
+        array_clear(tmp_hits);
+        _emit_leave_hit(resolver, engine, contact->a, contact->b);
+        return;
+    }
+
+    _contact_table_insert(current, contact->key, contact->a, contact->b, narrow);
+    for (size_t hi = 0; hi < count_hits; hi++) {
+        EseCollisionHit *hit = (EseCollisionHit *)array_get(tmp_hits, hi);
+        ese_collision_hit_set_state(hit, COLLISION_STATE_STAY);
+        if (!array_push(resolver->hits, hit)) {
+            memory_manager.free(hit);
+        }
+    }
+    array_clear(tmp_hits);
+    profile_count_add("resolver_contacts_carried");
+}
+
+CollisionResolver *collision_resolver_create(EseJobQueue *job_queue) {
     CollisionResolver *resolver =
         memory_manager.malloc(sizeof(CollisionResolver), MMTAG_COLLISION_INDEX);
     resolver->hits = array_create(128, (void (*)(void *))ese_collision_hit_destroy);
-    resolver->previous_collisions = hashmap_create((void (*)(void *))memory_manager.free);
+    resolver->pair_hits = array_create(4, NULL); // hits are handed over or freed per pair
+    _contact_table_init(&resolver->tables[0], COLLISION_RESOLVER_INITIAL_CONTACT_BITS);
+    _contact_table_init(&resolver->tables[1], COLLISION_RESOLVER_INITIAL_CONTACT_BITS);
+    resolver->previous = &resolver->tables[0];
+    resolver->current = &resolver->tables[1];
+    resolver->job_queue = job_queue;
+    resolver->results = NULL;
+    resolver->order = NULL;
+    resolver->pair_capacity = 0;
+    resolver->jobs = NULL;
+    resolver->job_ids = NULL;
+    resolver->job_capacity = 0;
     return resolver;
 }
 
 void collision_resolver_destroy(CollisionResolver *resolver) {
     log_assert("COLLISION_RESOLVER", resolver, "destroy called with NULL resolver");
     array_destroy(resolver->hits);
-    hashmap_destroy(resolver->previous_collisions);
+    array_destroy(resolver->pair_hits);
+    _contact_table_free(&resolver->tables[0]);
+    _contact_table_free(&resolver->tables[1]);
+    memory_manager.free(resolver->results);
+    memory_manager.free(resolver->order);
+    memory_manager.free(resolver->jobs);
+    memory_manager.free(resolver->job_ids);
     memory_manager.free(resolver);
 }
 
 void collision_resolver_clear(CollisionResolver *resolver) {
     log_assert("COLLISION_RESOLVER", resolver, "clear called with NULL resolver");
     array_clear(resolver->hits);
-    hashmap_clear(resolver->previous_collisions);
+    _contact_table_clear(resolver->previous);
+    _contact_table_clear(resolver->current);
 }
 
-EseArray *collision_resolver_solve(CollisionResolver *resolver, EseArray *pairs,
-                                   EseLuaEngine *engine) {
+void collision_resolver_forget_entity(CollisionResolver *resolver, EseEntity *entity) {
+    log_assert("COLLISION_RESOLVER", resolver, "forget_entity called with NULL resolver");
+    log_assert("COLLISION_RESOLVER", entity, "forget_entity called with NULL entity");
+
+    CollisionContactTable *table = resolver->previous;
+    if (table->count == 0)
+        return;
+    size_t capacity = (size_t)1 << table->bits;
+    for (size_t i = 0; i < capacity; i++) {
+        CollisionContact *contact = &table->contacts[i];
+        if (table->stamps[i] != table->generation)
+            continue;
+        if (contact->a == entity || contact->b == entity) {
+            contact->a = NULL;
+            contact->b = NULL;
+        }
+    }
+}
+
+EseArray *collision_resolver_solve(CollisionResolver *resolver, const SpatialPair *pairs,
+                                   size_t pair_count, EseLuaEngine *engine) {
     log_assert("COLLISION_RESOLVER", resolver, "solve called with NULL resolver");
-    log_assert("COLLISION_RESOLVER", pairs, "solve called with NULL pairs array");
+    log_assert("COLLISION_RESOLVER", pairs || pair_count == 0,
+               "solve called with NULL pairs array");
     log_assert("COLLISION_RESOLVER", engine, "solve called with NULL engine");
 
     profile_start(PROFILE_COLLISION_RESOLVER_SECTION);
     array_clear(resolver->hits);
-    EseHashMap *current_collisions = hashmap_create((void (*)(void *))memory_manager.free);
-    for (size_t i = 0; i < array_size(pairs); i++) {
-        SpatialPair *pair = (SpatialPair *)array_get(pairs, i);
+    CollisionContactTable *previous = resolver->previous;
+    CollisionContactTable *current = resolver->current;
+    _contact_table_clear(current);
+
+    // Narrow phase into plain-data results (possibly on worker threads), then
+    // merge in pair-key order so hits and callbacks do not depend on the
+    // spatial index's pair order or on how chunks were scheduled
+    _reserve_pairs(resolver, pair_count);
+    profile_start(PROFILE_ENTITY_COMPONENT_DISPATCH);
+    _narrow_phase(resolver, pairs, pair_count);
+    profile_stop(PROFILE_ENTITY_COMPONENT_DISPATCH, "collision_resolver_narrow_phase");
+    for (size_t i = 0; i < pair_count; i++) {
+        resolver->order[i].key = pairs[i].key;
+        resolver->order[i].index = (uint32_t)i;
+    }
+    qsort(resolver->order, pair_count, sizeof(CollisionPairOrder), _pair_order_compare);
+
+    EseArray *tmp_hits = resolver->pair_hits;
+    for (size_t k = 0; k < pair_count; k++) {
+        size_t i = resolver->order[k].index;
+        const SpatialPair *pair = &pairs[i];
+        const CollisionNarrowResult *narrow = &resolver->results[i];
         EseEntity *a = pair->a;
         EseEntity *b = pair->b;
         profile_start(PROFILE_ENTITY_COLLISION_DETECT);
-        const char *canonical_key = _get_collision_key(a->id, b->id);
-        bool was_colliding = hashmap_get(resolver->previous_collisions, canonical_key) != NULL;
+        CollisionContact *previous_contact = _contact_table_find(previous, pair->key);
+        bool was_colliding = previous_contact != NULL;
+        if (previous_contact)
+            previous_contact->visited = true;
 
-        // Cheap broadphase overlap using entity world AABBs
-        bool has_bounds = a->collision_world_bounds && b->collision_world_bounds;
-        bool aabb_overlap =
-            has_bounds ? ese_rect_intersects(a->collision_world_bounds, b->collision_world_bounds)
-                       : false;
-
-        // Prepare detailed hits only when we might need them
-        EseArray *tmp_hits = NULL;
         bool currently_colliding = false;
         EseCollisionState state = COLLISION_STATE_NONE;
+        array_clear(tmp_hits);
 
-        if (!aabb_overlap) {
+        if (!narrow->aabb_overlap) {
             // No overlap -> either NONE or LEAVE
             state = was_colliding ? COLLISION_STATE_LEAVE : COLLISION_STATE_NONE;
-
-            // If it's a LEAVE state, we still need to create a hit for the exit
-            // callback
-            if (state == COLLISION_STATE_LEAVE) {
-                EseCollisionHit *exit_hit = ese_collision_hit_create(engine);
-                EseCollisionKind kind = _pair_involves_map_collision(a, b)
-                                            ? COLLISION_KIND_MAP
-                                            : COLLISION_KIND_COLLIDER;
-                ese_collision_hit_set_kind(exit_hit, kind);
-                if (kind == COLLISION_KIND_MAP) {
-                    EseEntity *collider_entity = a, *map_entity = b;
-                    if (_get_map_pair_entities(a, b, &collider_entity, &map_entity)) {
-                        ese_collision_hit_set_entity(exit_hit, collider_entity);
-                        ese_collision_hit_set_target(exit_hit, map_entity);
-                    } else {
-                        ese_collision_hit_set_entity(exit_hit, a);
-                        ese_collision_hit_set_target(exit_hit, b);
-                    }
-                } else {
-                    ese_collision_hit_set_entity(exit_hit, a);
-                    ese_collision_hit_set_target(exit_hit, b);
-                    ese_collision_hit_set_rect(exit_hit, NULL);
-                }
-                ese_collision_hit_set_state(exit_hit, COLLISION_STATE_LEAVE);
-                if (!array_push(resolver->hits, exit_hit)) {
-                    memory_manager.free(exit_hit);
-                }
-            }
         } else {
-            // Only do expensive component-level test when AABBs overlap
-            tmp_hits = array_create(4, NULL); // take ownership of hits transferred
             // Classify the pair to count map vs collider paths
             if (_pair_involves_map_collision(a, b)) {
                 profile_count_add("resolver_pair_map_candidate");
@@ -449,9 +862,15 @@ EseArray *collision_resolver_solve(CollisionResolver *resolver, EseArray *pairs,
                 profile_count_add("resolver_pair_collider_candidate");
             }
 
-            profile_start(PROFILE_ENTITY_COMPONENT_DISPATCH);
-            currently_colliding = entity_test_collision(a, b, tmp_hits);
-            profile_stop(PROFILE_ENTITY_COMPONENT_DISPATCH, "entity_component_pair_dispatch");
+            if (narrow->status == COLLISION_NARROW_HIT) {
+                array_push(tmp_hits, entity_component_collider_make_hit(
+                                         narrow->collider_a, narrow->collider_b, narrow->rect_b));
+                currently_colliding = true;
+            } else if (narrow->status == COLLISION_NARROW_DEFER) {
+                profile_start(PROFILE_ENTITY_COMPONENT_DISPATCH);
+                currently_colliding = entity_test_collision(a, b, tmp_hits);
+                profile_stop(PROFILE_ENTITY_COMPONENT_DISPATCH, "entity_component_pair_dispatch");
+            }
 
             if (currently_colliding && !was_colliding) {
                 state = COLLISION_STATE_ENTER;
@@ -466,17 +885,13 @@ EseArray *collision_resolver_solve(CollisionResolver *resolver, EseArray *pairs,
         profile_stop(PROFILE_ENTITY_COLLISION_DETECT, "collision_resolver_detect");
 
         if (currently_colliding) {
-            // Track for next frame - store entity pointers
-            SpatialPair *pair_data =
-                memory_manager.malloc(sizeof(SpatialPair), MMTAG_COLLISION_INDEX);
-            pair_data->a = a;
-            pair_data->b = b;
-            hashmap_set(current_collisions, canonical_key, pair_data);
+            // Track for next frame
+            _contact_table_insert(current, pair->key, a, b, narrow);
         }
 
         // Emit collision hits with computed state
+        size_t count_hits = array_size(tmp_hits);
         if (state != COLLISION_STATE_NONE) {
-            size_t count_hits = tmp_hits ? array_size(tmp_hits) : 0;
             if (count_hits > 0) {
                 // Propagate state to all detailed hits
                 for (size_t hi = 0; hi < count_hits; hi++) {
@@ -493,89 +908,35 @@ EseArray *collision_resolver_solve(CollisionResolver *resolver, EseArray *pairs,
                 }
             } else if (state == COLLISION_STATE_LEAVE) {
                 // EXIT with no detailed hits still requires a callback
-                EseCollisionHit *exit_hit = ese_collision_hit_create(engine);
-                EseCollisionKind kind = _pair_involves_map_collision(a, b)
-                                            ? COLLISION_KIND_MAP
-                                            : COLLISION_KIND_COLLIDER;
-                ese_collision_hit_set_kind(exit_hit, kind);
-                if (kind == COLLISION_KIND_MAP) {
-                    EseEntity *collider_entity = a, *map_entity = b;
-                    if (_get_map_pair_entities(a, b, &collider_entity, &map_entity)) {
-                        ese_collision_hit_set_entity(exit_hit, collider_entity);
-                        ese_collision_hit_set_target(exit_hit, map_entity);
-                    } else {
-                        ese_collision_hit_set_entity(exit_hit, a);
-                        ese_collision_hit_set_target(exit_hit, b);
-                    }
-                } else {
-                    ese_collision_hit_set_entity(exit_hit, a);
-                    ese_collision_hit_set_target(exit_hit, b);
-                    ese_collision_hit_set_rect(exit_hit, NULL);
-                }
-                ese_collision_hit_set_state(exit_hit, COLLISION_STATE_LEAVE);
-                if (!array_push(resolver->hits, exit_hit)) {
-                    memory_manager.free(exit_hit);
-                }
+                _emit_leave_hit(resolver, engine, a, b);
             }
         } else {
             // No collision state -> free collected hits we won't return
-            if (tmp_hits) {
-                for (size_t hi = 0; hi < array_size(tmp_hits); hi++) {
-                    EseCollisionHit *hit = (EseCollisionHit *)array_get(tmp_hits, hi);
-                    memory_manager.free(hit);
-                }
+            for (size_t hi = 0; hi < count_hits; hi++) {
+                EseCollisionHit *hit = (EseCollisionHit *)array_get(tmp_hits, hi);
+                memory_manager.free(hit);
             }
         }
-
-        // Destroy temporary container (elements already transferred or freed)
-        if (tmp_hits)
-            array_destroy(tmp_hits);
-        memory_manager.free((void *)canonical_key);
     }
+    array_clear(tmp_hits);
 
-    // Process exit collisions for entities that were colliding but are no
-    // longer in pairs
-    EseHashMapIter *prev_iter = hashmap_iter_create(resolver->previous_collisions);
-    const char *key;
-    void *value;
-    while (hashmap_iter_next(prev_iter, &key, &value)) {
-        if (hashmap_get(current_collisions, key) == NULL) {
-            // This pair was colliding before but is not in current pairs ->
-            // EXIT
-            SpatialPair *pair_data = (SpatialPair *)value;
-            EseEntity *a = pair_data->a;
-            EseEntity *b = pair_data->b;
-
-            EseCollisionKind kind =
-                _pair_involves_map_collision(a, b) ? COLLISION_KIND_MAP : COLLISION_KIND_COLLIDER;
-            EseCollisionHit *exit_hit = ese_collision_hit_create(engine);
-            ese_collision_hit_set_kind(exit_hit, kind);
-            if (kind == COLLISION_KIND_MAP) {
-                EseEntity *collider_entity = a, *map_entity = b;
-                if (_get_map_pair_entities(a, b, &collider_entity, &map_entity)) {
-                    ese_collision_hit_set_entity(exit_hit, collider_entity);
-                    ese_collision_hit_set_target(exit_hit, map_entity);
-                } else {
-                    ese_collision_hit_set_entity(exit_hit, a);
-                    ese_collision_hit_set_target(exit_hit, b);
-                }
-            } else {
-                ese_collision_hit_set_entity(exit_hit, a);
-                ese_collision_hit_set_target(exit_hit, b);
-                ese_collision_hit_set_rect(exit_hit, NULL);
-            }
-            ese_collision_hit_set_state(exit_hit, COLLISION_STATE_LEAVE);
-            if (!array_push(resolver->hits, exit_hit)) {
-                memory_manager.free(exit_hit);
-            }
+    // Pairs that were colliding but are no longer produced by the spatial
+    // phase -> STAY if both entities rest (the pair was not retested), else EXIT
+    size_t previous_capacity = (size_t)1 << previous->bits;
+    for (size_t i = 0; i < previous_capacity; i++) {
+        CollisionContact *contact = &previous->contacts[i];
+        if (previous->stamps[i] != previous->generation || !contact->a || contact->visited)
+            continue;
+        if (contact->a->collision_resting && contact->b->collision_resting) {
+            _carry_contact(resolver, engine, current, contact);
+            continue;
         }
+        _emit_leave_hit(resolver, engine, contact->a, contact->b);
     }
-    hashmap_iter_free(prev_iter);
 
     // Roll current into previous for next call
-    EseHashMap *old_prev = resolver->previous_collisions;
-    resolver->previous_collisions = current_collisions;
-    hashmap_destroy(old_prev);
+    resolver->previous = current;
+    resolver->current = previous;
     profile_stop(PROFILE_COLLISION_RESOLVER_SECTION, "collision_resolver_solve");
     return resolver->hits;
 }
@@ -10,6 +10,7 @@ typedef struct EseEntity EseEntity;
 typedef struct EseRect EseRect;
 typedef struct EseMap EseMap;
 typedef struct EseLuaEngine EseLuaEngine;
+typedef struct EseJobQueue EseJobQueue;
 
 // Pair produced by spatial_index
 typedef struct SpatialPair SpatialPair;
@@ -20,12 +21,19 @@ typedef struct SpatialPair SpatialPair;
 // or its elements.
 typedef struct CollisionResolver CollisionResolver;
 
-CollisionResolver *collision_resolver_create(void);
+// When job_queue is non-NULL, large solves split the narrow phase into chunks
+// run on its workers. Hits are still built and returned on the calling thread,
+// ordered by pair key whichever way the work was split.
+CollisionResolver *collision_resolver_create(EseJobQueue *job_queue);
 void collision_resolver_destroy(CollisionResolver *resolver);
 void collision_resolver_clear(CollisionResolver *resolver);
 
-// Input is an array of SpatialPair* (from spatial_index_get_pairs)
-EseArray *collision_resolver_solve(CollisionResolver *resolver, EseArray *pairs,
-                                   EseLuaEngine *engine);
+// Drop remembered contacts involving an entity that left the spatial index.
+// No LEAVE hit is produced for them.
+void collision_resolver_forget_entity(CollisionResolver *resolver, EseEntity *entity);
+
+// Input is the contiguous pair array from spatial_index_get_pairs
+EseArray *collision_resolver_solve(CollisionResolver *resolver, const SpatialPair *pairs,
+                                   size_t pair_count, EseLuaEngine *engine);
 
 #endif // ESE_COLLISION_RESOLVER_H
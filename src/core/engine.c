@@ -1,4 +1,5 @@
 #include "core/engine.h"
+#include "core/collision_dispatch.h"
 #include "core/collision_resolver.h"
 #include "core/console.h"
 #include "core/engine_lua.h"
@@ -6,11 +7,15 @@
 #include "core/memory_manager.h"
 #include "core/pubsub.h"
 #include "core/system_manager.h"
+#include "core/system_manager_private.h"
+#include "entity/components/collider.h"
 #include "entity/components/entity_component.h"
 #include "entity/components/entity_component_lua.h"
 #include "entity/components/entity_component_map.h"
 #include "entity/entity.h"
 #include "entity/entity_private.h"
+#include "entity/entity_tag.h"
+#include "entity/transform_pool.h"
 #include "entity/systems/cleanup_system.h"
 #include "entity/systems/collider_render_system.h"
 #include "entity/systems/collider_system.h"
@@ -32,14 +37,17 @@
 #include "types/http.h"
 #include "types/input_state.h"
 #include "types/input_state_private.h"
+#include "types/prefab.h"
 #include "types/scene.h"
 #include "types/types.h"
 #include "utility/array.h"
-#include "utility/double_linked_list.h"
+#include "utility/collision_shape.h"
 #include "utility/hashmap.h"
+#include "utility/int_hashmap.h"
 #include "utility/job_queue.h"
 #include "utility/log.h"
 #include "utility/profile.h"
+#include "utility/slot_map.h"
 #include "utility/spatial_index.h"
 #include "vendor/lua/src/lauxlib.h"
 #include <limits.h>
@@ -62,15 +70,23 @@ EseEngine *engine_create(const char *startup_script) {
     engine->render_list_a = render_list_create();
     engine->render_list_b = render_list_create();
 
-    engine->entities = dlist_create(NULL);
-    engine->del_entities = dlist_create(NULL);
+    engine->entities = slot_map_create(0);
+    engine->del_entities = array_create(64, NULL);
+    engine->entity_ids = int_hashmap_create(NULL);
+    engine->tag_sets = NULL;
+    engine->tag_set_count = 0;
+    engine->transforms = transform_pool_create(0);
+    engine->unindexed_ids = 0;
 
     engine->systems = NULL;
     engine->sys_count = 0;
     engine->sys_cap = 0;
+    memset(engine->type_sys_count, 0, sizeof(engine->type_sys_count));
+    engine->schedule = system_schedule_create();
+    engine->log_schedule = false;
+    engine->lua_update_budget = 0;
 
     engine->spatial_index = spatial_index_create();
-    engine->collision_resolver = collision_resolver_create();
 
     engine->lua_engine = lua_engine_create();
 
@@ -78,6 +94,8 @@ EseEngine *engine_create(const char *startup_script) {
     int cpu_cores = ese_thread_get_cpu_cores(); 
     int num_workers = cpu_cores > 8 ? 8 : cpu_cores;
     engine->job_queue = ese_job_queue_create(num_workers, NULL, NULL);
+    engine->collision_resolver = collision_resolver_create(engine->job_queue);
+    engine->collision_dispatch = collision_dispatch_create(engine->lua_engine);
 
     // Initialize GUI Lua functions after GUI is created
     engine->gui = ese_gui_create(engine->lua_engine);
@@ -110,6 +128,7 @@ EseEngine *engine_create(const char *startup_script) {
     ese_gui_style_lua_init(engine->lua_engine);
     ese_http_request_lua_init(engine->lua_engine);
     ese_scene_lua_init(engine->lua_engine);
+    ese_prefab_lua_init(engine->lua_engine);
 
     // Add functions
     lua_engine_add_function(engine->lua_engine, "print", _lua_print);
@@ -122,8 +141,16 @@ EseEngine *engine_create(const char *startup_script) {
     lua_engine_add_function(engine->lua_engine, "asset_get_map", _lua_asset_get_map);
     lua_engine_add_function(engine->lua_engine, "set_pipeline", _lua_set_pipeline);
     lua_engine_add_function(engine->lua_engine, "detect_collision", _lua_detect_collision);
+    lua_engine_add_function(engine->lua_engine, "detect_collision_circle",
+                            _lua_detect_collision_circle);
+    lua_engine_add_function(engine->lua_engine, "detect_collision_ray", _lua_detect_collision_ray);
+    lua_engine_add_function(engine->lua_engine, "detect_collision_ray_all",
+                            _lua_detect_collision_ray_all);
+    lua_engine_add_function(engine->lua_engine, "detect_collision_nearest",
+                            _lua_detect_collision_nearest);
     lua_engine_add_function(engine->lua_engine, "scene_clear", _lua_scene_clear);
     lua_engine_add_function(engine->lua_engine, "scene_reset", _lua_scene_reset);
+    lua_engine_add_function(engine->lua_engine, "set_update_budget", _lua_set_update_budget);
 
     // Add globals
     engine->input_state = ese_input_state_create(engine->lua_engine);
@@ -189,16 +216,27 @@ void engine_destroy(EseEngine *engine) {
     log_verbose("ENGINE", "Destroying render list b");
     render_list_destroy(engine->render_list_b);
 
-    // Now free the entity lists
-    void *v;
-    while ((v = dlist_pop_front(engine->entities)) != NULL) {
-        entity_destroy((EseEntity *)v);
+    // Now free the entities; queued ones that were never added are freed too
+    EseEntity *entity;
+    while ((entity = (EseEntity *)array_pop(engine->del_entities)) != NULL) {
+        if (entity->handle == SLOT_MAP_NULL_HANDLE) {
+            entity_destroy(entity);
+        }
+    }
+    EseEntity **entities = (EseEntity **)slot_map_values(engine->entities);
+    for (size_t i = 0; i < slot_map_size(engine->entities); i++) {
+        entities[i]->handle = SLOT_MAP_NULL_HANDLE;
+        _entity_detach_transform(entities[i]);
+        entity_destroy(entities[i]);
     }
-    while ((v = dlist_pop_front(engine->del_entities)) != NULL) {
-        entity_destroy((EseEntity *)v);
+    slot_map_destroy(engine->entities);
+    array_destroy(engine->del_entities);
+    int_hashmap_destroy(engine->entity_ids);
+    transform_pool_destroy(engine->transforms);
+    for (size_t i = 0; i < engine->tag_set_count; i++) {
+        memory_manager.free(engine->tag_sets[i].entities);
     }
-    dlist_free(engine->entities);
-    dlist_free(engine->del_entities);
+    memory_manager.free(engine->tag_sets);
 
     // Destroy all systems
     if (engine->systems) {
@@ -208,6 +246,7 @@ void engine_destroy(EseEngine *engine) {
         }
         memory_manager.free(engine->systems);
     }
+    system_schedule_destroy(engine->schedule);
 
     // Destroyt the pub-sub system
     if (engine->pub_sub) {
@@ -227,6 +266,9 @@ void engine_destroy(EseEngine *engine) {
     if (engine->collision_resolver) {
         collision_resolver_destroy(engine->collision_resolver);
     }
+    if (engine->collision_dispatch) {
+        collision_dispatch_destroy(engine->collision_dispatch);
+    }
     if (engine->spatial_index) {
         spatial_index_destroy(engine->spatial_index);
     }
@@ -245,37 +287,159 @@ EseGui *engine_get_gui(EseEngine *engine) {
     return engine->gui;
 }
 
+/**
+ * @brief Adds an entity to the id index; keeps the first entity on a hash clash.
+ */
+static void _engine_index_id(EseEngine *engine, EseEntity *entity) {
+    uint64_t key = ese_uuid_hash(entity->id);
+    if (int_hashmap_get(engine->entity_ids, key)) {
+        engine->unindexed_ids++;
+        return;
+    }
+    int_hashmap_set(engine->entity_ids, key, (void *)(uintptr_t)entity->handle);
+}
+
+static void _engine_unindex_id(EseEngine *engine, EseEntity *entity) {
+    uint64_t key = ese_uuid_hash(entity->id);
+    EseSlotHandle indexed = (EseSlotHandle)(uintptr_t)int_hashmap_get(engine->entity_ids, key);
+    if (indexed == entity->handle) {
+        int_hashmap_remove(engine->entity_ids, key);
+    } else {
+        engine->unindexed_ids--;
+    }
+}
+
+void engine_notify_tag_add(EseEngine *engine, EseEntity *entity, size_t tag_index) {
+    log_assert("ENGINE", engine, "engine_notify_tag_add called with NULL engine");
+    log_assert("ENGINE", entity, "engine_notify_tag_add called with NULL entity");
+
+    if (entity->handle == SLOT_MAP_NULL_HANDLE || entity->removal_queued) {
+        return;
+    }
+
+    EseEntityTag *tag = &entity->tags[tag_index];
+    if (tag->id >= engine->tag_set_count) {
+        size_t new_count = entity_tag_count();
+        EseTagSet *sets =
+            memory_manager.realloc(engine->tag_sets, sizeof(EseTagSet) * new_count, MMTAG_ENGINE);
+        if (!sets) {
+            log_error("ENGINE", "engine_notify_tag_add: failed to allocate tag sets");
+            return;
+        }
+        memset(sets + engine->tag_set_count, 0,
+               sizeof(EseTagSet) * (new_count - engine->tag_set_count));
+        engine->tag_sets = sets;
+        engine->tag_set_count = new_count;
+    }
+
+    EseTagSet *set = &engine->tag_sets[tag->id];
+    if (set->count == set->capacity) {
+        size_t new_capacity = set->capacity == 0 ? 16 : set->capacity * 2;
+        EseEntity **entities = memory_manager.realloc(
+            set->entities, sizeof(EseEntity *) * new_capacity, MMTAG_ENGINE);
+        if (!entities) {
+            log_error("ENGINE", "engine_notify_tag_add: failed to grow tag set");
+            return;
+        }
+        set->entities = entities;
+        set->capacity = new_capacity;
+    }
+    tag->set_index = (uint32_t)set->count;
+    set->entities[set->count++] = entity;
+}
+
+void engine_notify_tag_rem(EseEngine *engine, EseEntity *entity, size_t tag_index) {
+    log_assert("ENGINE", engine, "engine_notify_tag_rem called with NULL engine");
+    log_assert("ENGINE", entity, "engine_notify_tag_rem called with NULL entity");
+
+    EseEntityTag *tag = &entity->tags[tag_index];
+    if (tag->set_index == ENTITY_TAG_NO_SET) {
+        return;
+    }
+
+    // Swap-remove; the moved entity's tag entry learns its new position
+    EseTagSet *set = &engine->tag_sets[tag->id];
+    EseEntity *moved = set->entities[--set->count];
+    if (tag->set_index != set->count) {
+        set->entities[tag->set_index] = moved;
+        for (size_t i = 0; i < moved->tag_count; i++) {
+            if (moved->tags[i].id == tag->id) {
+                moved->tags[i].set_index = tag->set_index;
+                break;
+            }
+        }
+    }
+    tag->set_index = ENTITY_TAG_NO_SET;
+}
+
 void engine_add_entity(EseEngine *engine, EseEntity *entity) {
     log_assert("ENGINE", engine, "engine_add_entity called with NULL engine");
     log_assert("ENGINE", entity, "engine_add_entity called with NULL entity");
 
+    if (entity->handle != SLOT_MAP_NULL_HANDLE) {
+        return;
+    }
+
     log_verbose("ENGINE", "Added entity %s", ese_uuid_get_value(entity->id));
-    dlist_append(engine->entities, entity);
+    entity->handle = slot_map_insert(engine->entities, entity);
+    if (entity->handle != SLOT_MAP_NULL_HANDLE) {
+        _entity_attach_transform(entity, engine->transforms,
+                                 entity->handle & (SLOT_MAP_MAX_SLOTS - 1u));
+    }
+    if (!entity->removal_queued) {
+        _engine_index_id(engine, entity);
+        for (size_t i = 0; i < entity->tag_count; i++) {
+            engine_notify_tag_add(engine, entity, i);
+        }
+    }
 }
 
 void engine_remove_entity(EseEngine *engine, EseEntity *entity) {
     log_assert("ENGINE", engine, "engine_remove_entity called with NULL engine");
     log_assert("ENGINE", entity, "engine_remove_entity called with NULL entity");
 
+    if (entity->removal_queued) {
+        return;
+    }
+
     log_verbose("ENGINE", "Removed entity %s", ese_uuid_get_value(entity->id));
-    dlist_append(engine->del_entities, entity);
+    if (entity->handle != SLOT_MAP_NULL_HANDLE) {
+        _engine_unindex_id(engine, entity);
+        for (size_t i = 0; i < entity->tag_count; i++) {
+            engine_notify_tag_rem(engine, entity, i);
+        }
+    }
+    entity->removal_queued = true;
+    array_push(engine->del_entities, entity);
+}
+
+void engine_sync_transforms(EseEngine *engine) {
+    log_assert("ENGINE", engine, "engine_sync_transforms called with NULL engine");
+
+    EseTransformPool *pool = engine->transforms;
+    for (uint32_t i = transform_pool_next_dirty(pool, 0); i != TRANSFORM_POOL_NO_SLOT;
+         i = transform_pool_next_dirty(pool, i + 1)) {
+        _entity_sync_transform(pool->entities[i]);
+    }
+}
+
+EseEntity *engine_get_entity(EseEngine *engine, EseSlotHandle handle) {
+    log_assert("ENGINE", engine, "engine_get_entity called with NULL engine");
+    return (EseEntity *)slot_map_get(engine->entities, handle);
 }
 
 void engine_clear_entities(EseEngine *engine, bool include_persistent) {
     log_assert("ENGINE", engine, "engine_clear_entities called with NULL engine");
 
-    // We can't remove from engine->entities while iterating over it,
-    // so just add it to the delete list, we'll remvoe from the entites
-    // list later
-    void *value;
-    EseDListIter *iter = dlist_iter_create(engine->entities);
-    while (dlist_iter_next(iter, &value)) {
-        EseEntity *entity = (EseEntity *)value;
-        if (include_persistent || !entity_get_persistent(entity)) {
-            dlist_append(engine->del_entities, entity);
+    // Entities are only queued here; they leave engine->entities at the end
+    // of the next update
+    EseEntity **entities = (EseEntity **)slot_map_values(engine->entities);
+    size_t count = slot_map_size(engine->entities);
+    for (size_t i = 0; i < count; i++) {
+        if (include_persistent || !entity_get_persistent(entities[i])) {
+            engine_remove_entity(engine, entities[i]);
         }
     }
-    dlist_iter_free(iter);
 }
 
 void engine_start(EseEngine *engine) {
@@ -299,6 +463,16 @@ void engine_start(EseEngine *engine) {
     engine->isRunning = true;
 }
 
+void engine_set_lua_update_budget(EseEngine *engine, uint32_t budget) {
+    log_assert("ENGINE", engine, "engine_set_lua_update_budget called with NULL engine");
+    engine->lua_update_budget = budget;
+}
+
+void engine_set_schedule_logging(EseEngine *engine, bool enabled) {
+    log_assert("ENGINE", engine, "engine_set_schedule_logging called with NULL engine");
+    engine->log_schedule = enabled;
+}
+
 void engine_set_renderer(EseEngine *engine, EseRenderer *renderer) {
     log_assert("ENGINE", engine, "engine_set_renderer called with NULL engine");
 
@@ -371,39 +545,27 @@ void engine_update(EseEngine *engine, float delta_time, const EseInputState *sta
     }
 
     // Run ECS Systems in phases
-    
-    // Parallel systems before Lua
-    profile_start(PROFILE_ENG_UPDATE_SECTION);
-    engine_run_phase(engine, SYS_PHASE_EARLY, delta_time, true);
-    profile_stop(PROFILE_ENG_UPDATE_SECTION, "eng_update_systems_early");
 
-    // Run LUA phase systems (single-threaded for Lua scripts)
-    profile_start(PROFILE_ENG_UPDATE_SECTION);
-    engine_run_phase(engine, SYS_PHASE_LUA, delta_time, false);
-    profile_stop(PROFILE_ENG_UPDATE_SECTION, "eng_update_systems_lua");
+    // Catch up with moves made between frames before systems read colliders
+    engine_sync_transforms(engine);
 
-    // Entity PASS TWO Step 1: Collect spatial pairs using spatial index
+    // EARLY and LUA systems as one graph: Lua scripts run on this thread while
+    // EARLY systems that touch nothing they use are still running on workers
     profile_start(PROFILE_ENG_UPDATE_SECTION);
-    spatial_index_clear(engine->spatial_index);
-    profile_stop(PROFILE_ENG_UPDATE_SECTION, "eng_collision_spatial_clear");
+    engine_run_phases(engine, SYS_PHASE_EARLY, SYS_PHASE_LUA, delta_time);
+    profile_stop(PROFILE_ENG_UPDATE_SECTION, "eng_update_systems_early_lua");
 
-    // Insert active entities
+    // Entity PASS TWO Step 1: Sync the persistent spatial index with moved
+    // entities
     profile_start(PROFILE_ENG_UPDATE_SECTION);
-    void *entity_value;
-    EseDListIter *insert_iter = dlist_iter_create(engine->entities);
-    while (dlist_iter_next(insert_iter, &entity_value)) {
-        EseEntity *entity = (EseEntity *)entity_value;
-        if (!entity->active)
-            continue;
-        spatial_index_insert(engine->spatial_index, entity);
-    }
-    dlist_iter_free(insert_iter);
-    profile_stop(PROFILE_ENG_UPDATE_SECTION, "eng_collision_spatial_insert");
+    engine_sync_transforms(engine);
+    spatial_index_update(engine->spatial_index);
+    profile_stop(PROFILE_ENG_UPDATE_SECTION, "eng_collision_spatial_update");
 
     // Get spatial pairs from the spatial index (array is cleared internally)
     profile_start(PROFILE_ENG_UPDATE_SECTION);
-    EseArray *spatial_pairs = spatial_index_get_pairs(engine->spatial_index);
-    size_t spatial_pair_count = array_size(spatial_pairs);
+    const SpatialPair *spatial_pairs = NULL;
+    size_t spatial_pair_count = spatial_index_get_pairs(engine->spatial_index, &spatial_pairs);
     for (size_t spi = 0; spi < spatial_pair_count; spi++) {
         profile_count_add("eng_collision_spatial_pairs_count");
     }
@@ -412,7 +574,8 @@ void engine_update(EseEngine *engine, float delta_time, const EseInputState *sta
     // Resolve pairs into detailed collision hits
     profile_start(PROFILE_ENG_UPDATE_SECTION);
     EseArray *collision_hits =
-        collision_resolver_solve(engine->collision_resolver, spatial_pairs, engine->lua_engine);
+        collision_resolver_solve(engine->collision_resolver, spatial_pairs, spatial_pair_count,
+                                 engine->lua_engine);
     size_t resolved_hit_count = array_size(collision_hits);
     for (size_t rhi = 0; rhi < resolved_hit_count; rhi++) {
         profile_count_add("eng_collision_hits_count");
@@ -422,13 +585,7 @@ void engine_update(EseEngine *engine, float delta_time, const EseInputState *sta
 
     // Entity PASS TWO Step 2: Process collision callbacks for all pairs
     profile_start(PROFILE_ENG_UPDATE_SECTION);
-    size_t hit_count = array_size(collision_hits);
-    for (size_t i = 0; i < hit_count; i++) {
-        EseCollisionHit *hit = (EseCollisionHit *)array_get(collision_hits, i);
-        if (!hit)
-            continue;
-        entity_process_collision_callbacks(hit);
-    }
+    collision_dispatch_run(engine->collision_dispatch, collision_hits);
     profile_stop(PROFILE_ENG_UPDATE_SECTION, "eng_update_collision_callback");
 
     // Clear the draw list
@@ -436,7 +593,7 @@ void engine_update(EseEngine *engine, float delta_time, const EseInputState *sta
 
     // Run LATE phase systems
     profile_start(PROFILE_ENG_UPDATE_SECTION);
-    engine_run_phase(engine, SYS_PHASE_LATE, delta_time, true);
+    engine_run_phases(engine, SYS_PHASE_LATE, SYS_PHASE_LATE, delta_time);
     profile_stop(PROFILE_ENG_UPDATE_SECTION, "eng_update_systems_late");
 
     // draw the gui
@@ -485,6 +642,12 @@ void engine_update(EseEngine *engine, float delta_time, const EseInputState *sta
     engine_run_phase(engine, SYS_PHASE_CLEANUP, delta_time, false);
     profile_stop(PROFILE_ENG_UPDATE_SECTION, "eng_update_systems_cleanup");
 
+    if (engine->log_schedule) {
+        char schedule[4096];
+        engine_schedule_dump(engine, schedule, sizeof(schedule));
+        log_debug("SCHEDULE", "%s", schedule);
+    }
+
     // Process completed async job callbacks on the main thread
     profile_start(PROFILE_ENG_UPDATE_SECTION);
     if (engine->job_queue) {
@@ -494,15 +657,21 @@ void engine_update(EseEngine *engine, float delta_time, const EseInputState *sta
 
     // Delete entities
     profile_start(PROFILE_ENG_UPDATE_SECTION);
-    void *v;
-    while ((v = dlist_pop_front(engine->del_entities)) != NULL) {
-        EseEntity *entity = (EseEntity *)v;
-        // remove from entities list here
-        dlist_remove_by_value(engine->entities, entity);
+    size_t del_count = array_size(engine->del_entities);
+    for (size_t i = 0; i < del_count; i++) {
+        EseEntity *entity = (EseEntity *)array_get(engine->del_entities, i);
+        _entity_detach_transform(entity);
+        slot_map_remove(engine->entities, entity->handle);
+        entity->handle = SLOT_MAP_NULL_HANDLE;
+        entity->removal_queued = false;
         entity_destroy(entity);
     }
+    array_clear(engine->del_entities);
     profile_stop(PROFILE_ENG_UPDATE_SECTION, "eng_update_del_entities");
 
+    // Every system is done with this frame's scratch memory, on every thread
+    memory_manager.frame_reset();
+
     // Overall update time
     profile_stop(PROFILE_ENG_UPDATE_OVERALL, "eng_update_overall");
 }
@@ -522,42 +691,41 @@ EseDisplay *engine_get_display(EseEngine *engine) {
     return engine->display_state;
 }
 
+void engine_get_view_rect(EseEngine *engine, EseViewRect *view) {
+    log_assert("ENGINE", engine, "engine_get_view_rect called with NULL engine");
+    log_assert("ENGINE", view, "engine_get_view_rect called with NULL view");
+
+    float camera_x = ese_point_get_x(engine->camera_state->position);
+    float camera_y = ese_point_get_y(engine->camera_state->position);
+    float half_width = ese_display_get_viewport_width(engine->display_state) / 2.0f;
+    float half_height = ese_display_get_viewport_height(engine->display_state) / 2.0f;
+    view->left = camera_x - half_width;
+    view->top = camera_y - half_height;
+    view->right = camera_x + half_width;
+    view->bottom = camera_y + half_height;
+}
+
 EseDrawList *engine_get_draw_list(EseEngine *engine) {
     log_assert("ENGINE", engine, "engine_get_draw_list called with NULL engine");
     return engine->draw_list;
 }
 
 EseEntity **engine_detect_collision_rect(EseEngine *engine, EseRect *rect, int max_count) {
+    log_assert("ENGINE", engine, "engine_detect_collision_rect called with NULL engine");
+    log_assert("ENGINE", rect, "engine_detect_collision_rect called with NULL rect");
+
     // allocate array of pointers (+1 for NULL terminator)
+    size_t capacity = max_count > 0 ? (size_t)max_count : 0;
     EseEntity **results =
-        memory_manager.malloc(sizeof(EseEntity *) * (max_count + 1), MMTAG_ENGINE);
+        memory_manager.malloc(sizeof(EseEntity *) * (capacity + 1), MMTAG_ENGINE);
     if (!results) {
         return NULL; // allocation failed
     }
 
-    int count = 0;
-    void *entity_value;
-    EseDListIter *iter_a = dlist_iter_create(engine->entities);
-
-    while (dlist_iter_next(iter_a, &entity_value)) {
-        EseEntity *entity = (EseEntity *)entity_value;
-
-        // skip inactive
-        if (!entity->active) {
-            continue;
-        }
-
-        if (entity_detect_collision_rect(entity, rect)) {
-            results[count++] = entity;
-
-            // stop if we hit max_count
-            if (count >= max_count) {
-                break;
-            }
-        }
-    }
-
-    dlist_iter_free(iter_a);
+    EseCollisionShape area;
+    collision_shape_from_rect(&area, rect, 0.0f, 0.0f);
+    size_t count = spatial_index_query_rect(engine->spatial_index, &area, COLLIDER_MASK_ALL,
+                                            results, capacity);
 
     // null terminate
     results[count] = NULL;
@@ -596,52 +764,44 @@ EsePcm *engine_get_music(EseEngine *engine, const char *music_id) {
 // Tag system functions
 
 /**
- * @brief Helper function to capitalize a string and truncate to MAX_TAG_LENGTH
+ * @brief Returns the engine's set for @p tag, or NULL if no added entity ever had it.
  */
-static void _normalize_tag(char *dest, const char *src) {
-    size_t i = 0;
-    while (src[i] && i < MAX_TAG_LENGTH - 1) { // MAX_TAG_LENGTH is 16
-        if (src[i] >= 'a' && src[i] <= 'z') {
-            dest[i] = src[i] - 32; // Convert to uppercase
-        } else {
-            dest[i] = src[i];
-        }
-        i++;
+static EseTagSet *_engine_tag_set(EseEngine *engine, const char *tag) {
+    EseTagId id = entity_tag_find(tag);
+    if (id == ENTITY_TAG_NONE || id >= engine->tag_set_count) {
+        return NULL;
     }
-    dest[i] = '\0';
+    return &engine->tag_sets[id];
 }
 
 EseEntity **engine_find_by_tag(EseEngine *engine, const char *tag, int max_count) {
     log_assert("ENGINE", engine, "engine_find_by_tag called with NULL engine");
     log_assert("ENGINE", tag, "engine_find_by_tag called with NULL tag");
 
-    if (max_count == 0) {
+    if (max_count <= 0) {
         return NULL;
     }
 
-    char normalized_tag[MAX_TAG_LENGTH]; // MAX_TAG_LENGTH
-    _normalize_tag(normalized_tag, tag);
+    EseTagSet *set = _engine_tag_set(engine, tag);
+    if (!set || set->count == 0) {
+        return NULL;
+    }
 
-    // Allocate result array (max_count + 1 for NULL terminator)
-    EseEntity **result = memory_manager.malloc(sizeof(EseEntity *) * (max_count + 1), MMTAG_ENGINE);
+    // Allocate result array (+1 for NULL terminator); the set bounds the result
+    size_t limit = set->count < (size_t)max_count ? set->count : (size_t)max_count;
+    EseEntity **result = memory_manager.malloc(sizeof(EseEntity *) * (limit + 1), MMTAG_ENGINE);
     if (!result) {
         log_error("ENGINE", "engine_find_by_tag: failed to allocate result array");
         return NULL;
     }
 
-    int found_count = 0;
-    void *entity_value;
-    EseDListIter *iter = dlist_iter_create(engine->entities);
-
-    while (dlist_iter_next(iter, &entity_value) && found_count < max_count) {
-        EseEntity *entity = (EseEntity *)entity_value;
-        if (entity && entity->active && entity_has_tag(entity, normalized_tag)) {
-            result[found_count++] = entity;
+    size_t found_count = 0;
+    for (size_t i = 0; i < set->count && found_count < limit; i++) {
+        if (set->entities[i]->active) {
+            result[found_count++] = set->entities[i];
         }
     }
 
-    dlist_iter_free(iter);
-
     if (found_count == 0) {
         // No results; free and return NULL per API preference
         memory_manager.free(result);
@@ -654,6 +814,22 @@ EseEntity **engine_find_by_tag(EseEngine *engine, const char *tag, int max_count
     return result;
 }
 
+EseEntity *engine_find_first_by_tag(EseEngine *engine, const char *tag) {
+    log_assert("ENGINE", engine, "engine_find_first_by_tag called with NULL engine");
+    log_assert("ENGINE", tag, "engine_find_first_by_tag called with NULL tag");
+
+    EseTagSet *set = _engine_tag_set(engine, tag);
+    if (!set) {
+        return NULL;
+    }
+    for (size_t i = 0; i < set->count; i++) {
+        if (set->entities[i]->active) {
+            return set->entities[i];
+        }
+    }
+    return NULL;
+}
+
 void engine_add_to_console(EseEngine *engine, EseConsoleLineType type, const char *prefix,
                            const char *message) {
     log_assert("ENGINE", engine, "engine_add_to_console called with NULL engine");
@@ -673,22 +849,31 @@ EseEntity *engine_find_by_id(EseEngine *engine, const char *uuid_string) {
     log_assert("ENGINE", engine, "engine_find_by_id called with NULL engine");
     log_assert("ENGINE", uuid_string, "engine_find_by_id called with NULL uuid_string");
 
-    void *entity_value;
-    EseDListIter *iter = dlist_iter_create(engine->entities);
+    uint64_t key = ese_uuid_hash_string(uuid_string);
+    EseSlotHandle handle = (EseSlotHandle)(uintptr_t)int_hashmap_get(engine->entity_ids, key);
+    EseEntity *entity = engine_get_entity(engine, handle);
+    if (entity && strcmp(ese_uuid_get_value(entity->id), uuid_string) == 0) {
+        return entity->active ? entity : NULL;
+    }
 
-    while (dlist_iter_next(iter, &entity_value)) {
-        EseEntity *entity = (EseEntity *)entity_value;
-        if (entity && entity->active && strcmp(ese_uuid_get_value(entity->id), uuid_string) == 0) {
-            dlist_iter_free(iter);
+    // Entities that lost a hash clash are only reachable by walking
+    if (engine->unindexed_ids == 0) {
+        return NULL;
+    }
+    EseEntity **entities = (EseEntity **)slot_map_values(engine->entities);
+    size_t count = slot_map_size(engine->entities);
+    for (size_t i = 0; i < count; i++) {
+        entity = entities[i];
+        if (entity->active && !entity->removal_queued &&
+            strcmp(ese_uuid_get_value(entity->id), uuid_string) == 0) {
             return entity;
         }
     }
 
-    dlist_iter_free(iter);
     return NULL;
 }
 
-int engine_get_entity_count(EseEngine *engine) { return dlist_size(engine->entities); }
+int engine_get_entity_count(EseEngine *engine) { return (int)slot_map_size(engine->entities); }
 
 // Pub/Sub passthrough functions
 void engine_pubsub_pub(EseEngine *engine, const char *name, const EseLuaValue *data) {
@@ -14,7 +14,9 @@
 #include "types/camera.h"
 #include "types/display.h"
 #include "types/input_state.h"
+#include "utility/slot_map.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 typedef struct EseEntity EseEntity;
 typedef struct EseEngine EseEngine;
@@ -66,11 +68,39 @@ void engine_destroy(EseEngine *engine);
  */
 void engine_set_renderer(EseEngine *engine, EseRenderer *renderer);
 
+/**
+ * @brief Logs the system schedule of every frame.
+ *
+ * @details When enabled, each engine_update ends by logging
+ * engine_schedule_dump under the "SCHEDULE" group: which systems ran on
+ * which thread, how long each took, what each waited for and the critical
+ * path of the frame's system graph.
+ *
+ * @param engine A pointer to the EseEngine instance.
+ * @param enabled Whether to log the schedule.
+ */
+void engine_set_schedule_logging(EseEngine *engine, bool enabled);
+
+/**
+ * @brief Caps how many throttled Lua updates run per frame.
+ *
+ * @details Counts the entity_update calls of ENTITY_UPDATE_INTERVAL entities.
+ * An entity that is due when the budget is spent is updated first on a later
+ * frame, with the dt of every frame it missed, so a large population spreads
+ * over frames instead of piling up. Every-frame and near-camera entities are
+ * never deferred.
+ *
+ * @param engine A pointer to the EseEngine instance.
+ * @param budget Updates per frame, or 0 for no limit.
+ */
+void engine_set_lua_update_budget(EseEngine *engine, uint32_t budget);
+
 /**
  * @brief Adds an existing entity to the engine's management.
  *
- * @details This function appends an entity to the engine's internal list,
- * making it part of the game loop for updates and rendering.
+ * @details Stores the entity in the engine's slot map and gives it a handle
+ * (see entity_get_handle), making it part of the game loop for updates and
+ * rendering. Adding an entity that is already added does nothing. O(1).
  *
  * @param engine A pointer to the EseEngine instance.
  * @param entity A pointer to the EseEntity to add.
@@ -85,8 +115,9 @@ void engine_add_entity(EseEngine *engine, EseEntity *entity);
 /**
  * @brief Removes an existing entity from the engine's management.
  *
- * @details This function appends an entity to the engine's internal list,
- * making it part of the game loop for updates and rendering.
+ * @details Queues the entity for deletion; it is taken out of the engine and
+ * destroyed at the end of the next engine_update. Queuing the same entity
+ * again before then does nothing. Its handle stops resolving once it is gone.
  *
  * @param engine A pointer to the EseEngine instance.
  * @param entity A pointer to the EseEntity to remove.
@@ -98,6 +129,16 @@ void engine_add_entity(EseEngine *engine, EseEntity *entity);
  */
 void engine_remove_entity(EseEngine *engine, EseEntity *entity);
 
+/**
+ * @brief Resolves an entity handle in O(1).
+ *
+ * @param engine A pointer to the EseEngine instance.
+ * @param handle Handle from entity_get_handle.
+ * @return The entity, or NULL if it has since been removed or the handle is
+ * SLOT_MAP_NULL_HANDLE.
+ */
+EseEntity *engine_get_entity(EseEngine *engine, EseSlotHandle handle);
+
 /**
  * @brief Clears the engine's entities.
  *
@@ -138,8 +179,10 @@ void engine_update(EseEngine *engine, float delta_time, const EseInputState *sta
 /**
  * @brief Detects collisions between entities and a rectangular area.
  *
- * @details This function checks all active entities in the engine against the
- * specified rectangle and returns those that intersect with it.
+ * @details Served from the spatial index: only the grid cells under the
+ * rectangle are visited, and each candidate's collider shapes are tested
+ * against it. Entities are seen as of the last spatial index update, so one
+ * added this frame is not returned until the next update.
  *
  * @param engine A pointer to the EseEngine instance.
  * @param rect A pointer to the rectangle to test against.
@@ -187,6 +230,12 @@ EsePcm *engine_get_music(EseEngine *engine, const char *music_id);
 /**
  * @brief Finds all entities with a specific tag.
  *
+ * @details The engine keeps a set of added entities per interned tag, updated
+ * by entity_add_tag, entity_remove_tag, engine_add_entity and
+ * engine_remove_entity, so the cost is proportional to the number of entities
+ * carrying the tag. Inactive entities and entities queued for removal are not
+ * returned; the order is unspecified.
+ *
  * @param engine Pointer to the EseEngine
  * @param tag Tag string to search for
  * @param max_count Maximum number of entities to return
@@ -195,9 +244,23 @@ EsePcm *engine_get_music(EseEngine *engine, const char *music_id);
  */
 EseEntity **engine_find_by_tag(EseEngine *engine, const char *tag, int max_count);
 
+/**
+ * @brief Finds one active entity with a specific tag without allocating.
+ *
+ * @param engine Pointer to the EseEngine
+ * @param tag Tag string to search for
+ * @return Pointer to an entity carrying the tag, or NULL if none found
+ */
+EseEntity *engine_find_first_by_tag(EseEngine *engine, const char *tag);
+
 /**
  * @brief Finds an entity by its UUID.
  *
+ * @details O(1): the engine keeps an index from ese_uuid_hash of each added
+ * entity's id to its handle, updated by engine_add_entity and
+ * engine_remove_entity. Entities queued for removal and inactive entities are
+ * not returned.
+ *
  * @param engine Pointer to the EseEngine
  * @param uuid_string UUID string to search for
  * @return Pointer to the found entity, or NULL if not found
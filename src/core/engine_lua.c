@@ -1,9 +1,12 @@
 #include "core/engine.h"
 #include "core/engine_private.h"
 #include "core/memory_manager.h"
+#include "entity/components/collider.h"
 #include "platform/renderer.h"
 #include "types/types.h"
+#include "utility/collision_shape.h"
 #include "utility/log.h"
+#include "utility/spatial_index.h"
 #include "vendor/lua/src/lauxlib.h"
 #include "vendor/lua/src/lua.h"
 #include "vendor/lua/src/lualib.h"
@@ -282,10 +285,48 @@ int _lua_set_pipeline(lua_State *L) {
     return 1;
 }
 
+/**
+ * @brief Reads the optional collider layer mask at @p idx.
+ */
+static uint16_t _lua_query_mask(lua_State *L, int idx) {
+    if (lua_gettop(L) < idx || lua_isnil(L, idx)) {
+        return COLLIDER_MASK_ALL;
+    }
+    return (uint16_t)(lua_tointeger(L, idx) & COLLIDER_MASK_ALL);
+}
+
+/**
+ * @brief Pushes a table of entities.
+ */
+static void _lua_push_entities(lua_State *L, EseEntity **entities, size_t count) {
+    lua_createtable(L, (int)count, 0);
+    for (size_t i = 0; i < count; i++) {
+        entity_lua_push(entities[i]);
+        lua_rawseti(L, -2, (int)i + 1);
+    }
+}
+
+/**
+ * @brief Pushes two tables, the hit entities and their distances.
+ */
+static void _lua_push_query_hits(lua_State *L, const SpatialQueryHit *hits, size_t count) {
+    lua_createtable(L, (int)count, 0);
+    for (size_t i = 0; i < count; i++) {
+        entity_lua_push(hits[i].entity);
+        lua_rawseti(L, -2, (int)i + 1);
+    }
+    lua_createtable(L, (int)count, 0);
+    for (size_t i = 0; i < count; i++) {
+        lua_pushnumber(L, hits[i].distance);
+        lua_rawseti(L, -2, (int)i + 1);
+    }
+}
+
 int _lua_detect_collision(lua_State *L) {
     int n_args = lua_gettop(L);
-    if (n_args != 2) {
-        log_warn("ENGINE", "detect_collision(rect, number max_results) takes 2 argument");
+    if (n_args != 2 && n_args != 3) {
+        log_warn("ENGINE", "detect_collision(rect, number max_results[, number mask]) takes 2 or "
+                           "3 arguments");
         lua_newtable(L);
         return 1;
     }
@@ -297,49 +338,145 @@ int _lua_detect_collision(lua_State *L) {
         return 1;
     }
 
-    // 1st argument must be a table
-    if (!lua_getmetatable(L, 1)) {
+    EseRect *rect = ese_rect_lua_get(L, 1);
+    if (!rect) {
         log_warn("ENGINE", "detect_collision(rect) expected rect");
         lua_newtable(L);
         return 1;
     }
 
-    // table nust have a __name
-    lua_getfield(L, -1, "__name"); // get metatable.__name
-    const char *tname = lua_tostring(L, -1);
-    if (!tname) {
-        log_warn("ENGINE", "detect_collision(rect) expected rect");
+    EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(L, ENGINE_KEY);
+    int max_results = (int)lua_tointeger(L, 2);
+    if (max_results <= 0) {
         lua_newtable(L);
         return 1;
     }
 
-    EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(L, ENGINE_KEY);
-    int max_results = (int)lua_tointeger(L, 2);
+    EseCollisionShape area;
+    collision_shape_from_rect(&area, rect, 0.0f, 0.0f);
+    EseEntity **entities =
+        memory_manager.malloc(sizeof(EseEntity *) * (size_t)max_results, MMTAG_ENGINE);
+    size_t count = spatial_index_query_rect(engine->spatial_index, &area, _lua_query_mask(L, 3),
+                                            entities, (size_t)max_results);
+    _lua_push_entities(L, entities, count);
 
-    // If the table is a Rect
-    if (strcmp(tname, "RectProxyMeta") == 0) {
-        EseRect *rect = ese_rect_lua_get(L, 1);
-        EseEntity **entities = engine_detect_collision_rect(engine, rect, max_results);
+    // free the list, we dont own the entites.
+    memory_manager.free(entities);
+    return 1;
+}
 
-        // build Lua table
+int _lua_detect_collision_circle(lua_State *L) {
+    int n_args = lua_gettop(L);
+    EsePoint *center = n_args >= 1 ? ese_point_lua_get(L, 1) : NULL;
+    if ((n_args != 3 && n_args != 4) || !center || !lua_isnumber(L, 2) ||
+        !lua_isinteger_lj(L, 3)) {
+        log_warn("ENGINE", "detect_collision_circle(point, number radius, number "
+                           "max_results[, number mask]) takes 3 or 4 arguments");
         lua_newtable(L);
-        int idx = 1;
-        for (int i = 0; entities[i] != NULL; i++) {
-            lua_pushinteger(L, idx++);
-            entity_lua_push(entities[i]);
-            lua_settable(L, -3);
-        }
+        return 1;
+    }
 
-        // free the list, we dont own the entites.
-        memory_manager.free(entities);
+    EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(L, ENGINE_KEY);
+    int max_results = (int)lua_tointeger(L, 3);
+    if (max_results <= 0) {
+        lua_newtable(L);
         return 1;
     }
 
-    log_warn("ENGINE", "detect_collision(rect) expected rect");
-    lua_newtable(L);
+    EseEntity **entities =
+        memory_manager.malloc(sizeof(EseEntity *) * (size_t)max_results, MMTAG_ENGINE);
+    size_t count = spatial_index_query_circle(
+        engine->spatial_index, ese_point_get_x(center), ese_point_get_y(center),
+        (float)lua_tonumber(L, 2), _lua_query_mask(L, 4), entities, (size_t)max_results);
+    _lua_push_entities(L, entities, count);
+    memory_manager.free(entities);
     return 1;
 }
 
+int _lua_detect_collision_ray(lua_State *L) {
+    int n_args = lua_gettop(L);
+    EseRay *ray = n_args >= 1 ? ese_ray_lua_get(L, 1) : NULL;
+    if ((n_args != 2 && n_args != 3) || !ray || !lua_isnumber(L, 2)) {
+        log_warn("ENGINE", "detect_collision_ray(ray, number max_distance[, number mask]) "
+                           "takes 2 or 3 arguments");
+        lua_pushnil(L);
+        return 1;
+    }
+
+    EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(L, ENGINE_KEY);
+    SpatialQueryHit hit;
+    if (!spatial_index_raycast(engine->spatial_index, ese_ray_get_x(ray), ese_ray_get_y(ray),
+                               ese_ray_get_dx(ray), ese_ray_get_dy(ray),
+                               (float)lua_tonumber(L, 2), _lua_query_mask(L, 3), &hit)) {
+        lua_pushnil(L);
+        return 1;
+    }
+
+    entity_lua_push(hit.entity);
+    lua_pushnumber(L, hit.distance);
+    return 2;
+}
+
+int _lua_detect_collision_ray_all(lua_State *L) {
+    int n_args = lua_gettop(L);
+    EseRay *ray = n_args >= 1 ? ese_ray_lua_get(L, 1) : NULL;
+    if ((n_args != 3 && n_args != 4) || !ray || !lua_isnumber(L, 2) ||
+        !lua_isinteger_lj(L, 3)) {
+        log_warn("ENGINE", "detect_collision_ray_all(ray, number max_distance, number "
+                           "max_results[, number mask]) takes 3 or 4 arguments");
+        lua_newtable(L);
+        lua_newtable(L);
+        return 2;
+    }
+
+    EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(L, ENGINE_KEY);
+    int max_results = (int)lua_tointeger(L, 3);
+    if (max_results <= 0) {
+        lua_newtable(L);
+        lua_newtable(L);
+        return 2;
+    }
+
+    SpatialQueryHit *hits =
+        memory_manager.malloc(sizeof(SpatialQueryHit) * (size_t)max_results, MMTAG_ENGINE);
+    size_t count = spatial_index_raycast_all(
+        engine->spatial_index, ese_ray_get_x(ray), ese_ray_get_y(ray), ese_ray_get_dx(ray),
+        ese_ray_get_dy(ray), (float)lua_tonumber(L, 2), _lua_query_mask(L, 4), hits,
+        (size_t)max_results);
+    _lua_push_query_hits(L, hits, count);
+    memory_manager.free(hits);
+    return 2;
+}
+
+int _lua_detect_collision_nearest(lua_State *L) {
+    int n_args = lua_gettop(L);
+    EsePoint *point = n_args >= 1 ? ese_point_lua_get(L, 1) : NULL;
+    if ((n_args != 2 && n_args != 3) || !point || !lua_isinteger_lj(L, 2)) {
+        log_warn("ENGINE", "detect_collision_nearest(point, number count[, number mask]) takes "
+                           "2 or 3 arguments");
+        lua_newtable(L);
+        lua_newtable(L);
+        return 2;
+    }
+
+    EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(L, ENGINE_KEY);
+    int k = (int)lua_tointeger(L, 2);
+    if (k <= 0) {
+        lua_newtable(L);
+        lua_newtable(L);
+        return 2;
+    }
+
+    SpatialQueryHit *hits =
+        memory_manager.malloc(sizeof(SpatialQueryHit) * (size_t)k, MMTAG_ENGINE);
+    size_t count = spatial_index_query_nearest(engine->spatial_index, ese_point_get_x(point),
+                                               ese_point_get_y(point), _lua_query_mask(L, 3),
+                                               hits, (size_t)k);
+    _lua_push_query_hits(L, hits, count);
+    memory_manager.free(hits);
+    return 2;
+}
+
 int _lua_scene_clear(lua_State *L) {
     int n_args = lua_gettop(L);
     if (n_args != 0) {
@@ -369,3 +506,18 @@ int _lua_scene_reset(lua_State *L) {
     lua_pushboolean(L, true);
     return 1;
 }
+
+int _lua_set_update_budget(lua_State *L) {
+    int n_args = lua_gettop(L);
+    if (n_args != 1 || !lua_isnumber(L, 1) || lua_tonumber(L, 1) < 0) {
+        log_warn("ENGINE", "set_update_budget(count) takes 1 non-negative number");
+        lua_pushboolean(L, false);
+        return 1;
+    }
+
+    EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(L, ENGINE_KEY);
+    engine_set_lua_update_budget(engine, (uint32_t)lua_tonumber(L, 1));
+
+    lua_pushboolean(L, true);
+    return 1;
+}
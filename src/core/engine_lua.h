@@ -74,10 +74,55 @@ int _lua_asset_get_map(lua_State *L);
 
 int _lua_set_pipeline(lua_State *L);
 
+/**
+ * @brief Returns the entities whose colliders overlap a Rect.
+ *
+ * @details Lua: detect_collision(rect, max_results[, mask]). Served from the
+ * spatial index; `mask` selects collider layers.
+ */
 int _lua_detect_collision(lua_State *L);
 
+/**
+ * @brief Returns the entities whose colliders overlap a circle.
+ *
+ * @details Lua: detect_collision_circle(point, radius, max_results[, mask]).
+ */
+int _lua_detect_collision_circle(lua_State *L);
+
+/**
+ * @brief Returns the first entity hit by a Ray and the distance to it.
+ *
+ * @details Lua: detect_collision_ray(ray, max_distance[, mask]). Pushes nil
+ * when nothing is hit.
+ */
+int _lua_detect_collision_ray(lua_State *L);
+
+/**
+ * @brief Returns every entity hit by a Ray, nearest first.
+ *
+ * @details Lua: detect_collision_ray_all(ray, max_distance, max_results[, mask]).
+ * Pushes a table of entities and a table of their distances.
+ */
+int _lua_detect_collision_ray_all(lua_State *L);
+
+/**
+ * @brief Returns the entities nearest to a Point, nearest first.
+ *
+ * @details Lua: detect_collision_nearest(point, count[, mask]). Pushes a table
+ * of entities and a table of their distances.
+ */
+int _lua_detect_collision_nearest(lua_State *L);
+
 int _lua_scene_clear(lua_State *L);
 
 int _lua_scene_reset(lua_State *L);
 
+/**
+ * @brief Sets the engine's throttled Lua update budget.
+ *
+ * @details Lua: set_update_budget(count). 0 removes the limit; see
+ * engine_set_lua_update_budget.
+ */
+int _lua_set_update_budget(lua_State *L);
+
 #endif // ESE_ENGINE_LUA_H
@@ -5,6 +5,7 @@
 #include "graphics/render_list.h"
 #include "platform/renderer.h"
 #include "utility/log.h"
+#include "utility/slot_map.h"
 #include <stdint.h>
 #include <string.h>
 
@@ -91,19 +92,11 @@ EseRenderList *_engine_get_render_list(EseEngine *engine) {
     }
 }
 
-int _engine_entity_find(void *data, void *user_data) {
-    log_assert("ENGINE", data, "_engine_entity_find called with NULL data");
-    log_assert("ENGINE", user_data, "_engine_entity_find called with NULL user_data");
-
-    EseEntity *entity = (EseEntity *)data;
-    return strcmp(ese_uuid_get_value(entity->id), (const char *)user_data) == 0;
-}
-
 EseEntity *_engine_new_entity(EseEngine *engine, const char *id) {
     log_assert("ENGINE", engine, "_engine_new_entity called with NULL engine");
 
     EseEntity *entity = entity_create(engine->lua_engine);
-    dlist_append(engine->entities, (void *)entity);
+    engine_add_entity(engine, entity);
     // entity_add_to_lua_engine(entity, engine->lua_engine);
     return entity;
 }
@@ -112,10 +105,13 @@ EseEntity *_engine_find_entity(EseEngine *engine, const char *id) {
     log_assert("ENGINE", engine, "_engine_find_entity called with NULL engine");
     log_assert("ENGINE", id, "_engine_find_entity called with NULL id");
 
-    void *value = dlist_find(engine->entities, _engine_entity_find, (void *)id);
-    if (!value) {
-        return NULL;
+    EseEntity **entities = (EseEntity **)slot_map_values(engine->entities);
+    size_t count = slot_map_size(engine->entities);
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(ese_uuid_get_value(entities[i]->id), id) == 0) {
+            return entities[i];
+        }
     }
 
-    return (EseEntity *)value;
+    return NULL;
 }
\ No newline at end of file
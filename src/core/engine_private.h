@@ -12,11 +12,13 @@
 #define ESE_ENGINE_PRIVATE_H
 
 #include "core/asset_manager.h"
+#include "core/collision_dispatch.h"
 #include "core/collision_resolver.h"
 #include "core/console.h"
 #include "core/engine.h"
 #include "core/pubsub.h"
 #include "utility/spatial_index.h"
+#include "entity/components/entity_component_private.h"
 #include "entity/entity.h"
 #include "graphics/gui/gui.h"
 #include "scripting/lua_engine.h"
@@ -25,12 +27,24 @@
 typedef struct EseDrawList EseDrawList;
 typedef struct EseRenderList EseRenderList;
 typedef struct EseRenderer EseRenderer;
-typedef struct EseDoubleLinkedList EseDoubleLinkedList;
+typedef struct EseSlotMap EseSlotMap;
+typedef struct EseIntHashMap EseIntHashMap;
 typedef struct SpatialIndex SpatialIndex;
 typedef struct CollisionResolver CollisionResolver;
 typedef struct EseArray EseArray;
 typedef struct EseJobQueue EseJobQueue;
 typedef struct EseSystemManager EseSystemManager;
+typedef struct EseSystemSchedule EseSystemSchedule;
+typedef struct EseTransformPool EseTransformPool;
+
+/**
+ * @brief The added, not removed entities carrying one tag, in no particular order.
+ */
+typedef struct EseTagSet {
+    EseEntity **entities; /** Members; each knows its position via EseEntityTag::set_index */
+    size_t count;         /** Number of members */
+    size_t capacity;      /** Capacity of entities */
+} EseTagSet;
 
 struct EseEngine {
     EseRenderer *renderer;        /** Pointer to the engine's renderer */
@@ -40,14 +54,20 @@ struct EseEngine {
     bool active_render_list;      /** Flag to indicate which render list is currently
                                      active */
 
-    EseDoubleLinkedList *entities;     /** A doubly-linked list containing all active entities */
-    EseDoubleLinkedList *del_entities; /** A doubly-linked list containing to be
-                                          deleted entities */
+    EseSlotMap *entities;      /** Dense slot map of all added entities, keyed by entity handle */
+    EseArray *del_entities;    /** Array<EseEntity*> of entities to be deleted after the update */
+    EseIntHashMap *entity_ids; /** ese_uuid_hash of an entity id -> entity handle */
+    size_t unindexed_ids;      /** Indexable entities left out of entity_ids by a hash clash */
+    EseTagSet *tag_sets;       /** Entity set per interned tag id, grown on demand */
+    size_t tag_set_count;      /** Number of entries in tag_sets */
+    EseTransformPool *transforms; /** Positions of added entities, by handle slot */
 
     SpatialIndex *spatial_index;           /** Broad-phase spatial index for collision
                                               pair generation */
     CollisionResolver *collision_resolver; /** Narrow-phase resolver for
                                               detailed collision hits */
+    CollisionDispatch *collision_dispatch; /** Delivers collision hits to
+                                              entity scripts */
 
     EseInputState *input_state;     /** The current input state of the application */
     EseDisplay *display_state;      /** The current display state of the application */
@@ -72,8 +92,86 @@ struct EseEngine {
     EseSystemManager **systems; /** Array of registered systems */
     size_t sys_count;           /** Number of registered systems */
     size_t sys_cap;             /** Capacity of the systems array */
+
+    EseSystemSchedule *schedule; /** Dependency-graph scheduler state and last timings */
+    bool log_schedule;           /** Whether to log engine_schedule_dump every frame */
+    uint32_t lua_update_budget;  /** Throttled Lua updates per frame, 0 for no limit */
+
+    /** Systems notified about each component type, in registration order */
+    EseSystemManager *type_systems[ENTITY_COMPONENT_TYPE_COUNT][ENTITY_COMPONENT_MAX_SYSTEMS];
+    uint8_t type_sys_count[ENTITY_COMPONENT_TYPE_COUNT]; /** Systems per component type */
 };
 
+/**
+ * @brief World-space rectangle shown by the camera.
+ */
+typedef struct EseViewRect {
+    float left;   /** World x of the viewport's left edge */
+    float top;    /** World y of the viewport's top edge */
+    float right;  /** World x of the viewport's right edge */
+    float bottom; /** World y of the viewport's bottom edge */
+} EseViewRect;
+
+/**
+ * @brief Computes the world rectangle shown by the camera.
+ *
+ * @details The camera does not move while systems run, so systems compute the
+ * rectangle once per update and reuse it for every component.
+ *
+ * @param engine A pointer to the EseEngine instance.
+ * @param view Receives the camera's view.
+ */
+void engine_get_view_rect(EseEngine *engine, EseViewRect *view);
+
+/**
+ * @brief Tests whether a world-space box touches the view.
+ *
+ * @param view View from engine_get_view_rect.
+ * @param x World x of the box's left edge.
+ * @param y World y of the box's top edge.
+ * @param w Width of the box.
+ * @param h Height of the box.
+ * @return true if any part of the box can be on screen.
+ */
+static inline bool engine_view_rect_overlaps(const EseViewRect *view, float x, float y, float w,
+                                             float h) {
+    return x + w >= view->left && x <= view->right && y + h >= view->top && y <= view->bottom;
+}
+
+/**
+ * @brief Adds an entity to the engine's set for one of its tags.
+ *
+ * @details Called by entity_add_tag and engine_add_entity. Does nothing unless
+ * the entity is added to the engine and not queued for removal.
+ *
+ * @param engine A pointer to the EseEngine instance.
+ * @param entity The entity that carries the tag.
+ * @param tag_index Index of the tag in the entity's tag array.
+ */
+void engine_notify_tag_add(EseEngine *engine, EseEntity *entity, size_t tag_index);
+
+/**
+ * @brief Removes an entity from the engine's set for one of its tags.
+ *
+ * @details Called by entity_remove_tag, engine_remove_entity and entity
+ * cleanup. Does nothing if the entity is not in the set.
+ *
+ * @param engine A pointer to the EseEngine instance.
+ * @param entity The entity that carries the tag.
+ * @param tag_index Index of the tag in the entity's tag array.
+ */
+void engine_notify_tag_rem(EseEngine *engine, EseEntity *entity, size_t tag_index);
+
+/**
+ * @brief Refreshes position-derived data of every entity moved since the last sync.
+ *
+ * @details Walks the transform pool's dirty bits, so the cost follows the
+ * number of moved entities. Runs once per frame before the broadphase update.
+ *
+ * @param engine A pointer to the EseEngine instance.
+ */
+void engine_sync_transforms(EseEngine *engine);
+
 /**
  * @brief Clears the active render list.
  *
@@ -25,6 +25,11 @@
  * leaks with backtraces when enabled. destroy() can clean the current thread or
  * all threads; internal teardown is serialized to avoid concurrent mutation.
  *
+ * Each thread also owns a frame arena: a chain of MMTAG_FRAME blocks that
+ * frame_alloc bumps through without tracking individual allocations.
+ * frame_reset bumps a global epoch; an arena recycles when it sees a new epoch,
+ * folding a multi-block frame into one block sized for it.
+ *
  * Configuration is via MEMORY_TRACKING, and MEMORY_TRACK_FREE. Backtraces use
  * execinfo on supported platforms. All allocations must be freed on the
  * allocating thread by design.
@@ -58,6 +63,7 @@
 #define ALLOC_TABLE_SIZE 65536
 #define ALLOC_TABLE_MASK (ALLOC_TABLE_SIZE - 1)
 #define INITIAL_MM_THREADS_CAPACITY 4
+#define FRAME_BLOCK_SIZE (64 * 1024)
 
 typedef struct AllocEntry {
     void *ptr;
@@ -79,6 +85,21 @@ typedef struct {
     size_t largest_alloc;
 } MemStats;
 
+typedef struct FrameBlock {
+    struct FrameBlock *next;         /** Older block */
+    size_t size;                     /** Usable bytes in data */
+    size_t used;                     /** Bytes handed out from data */
+    alignas(16) unsigned char data[];
+} FrameBlock;
+
+typedef struct {
+    FrameBlock *blocks;   /** Newest block first */
+    size_t used;          /** Bytes handed out this frame, over all blocks */
+    size_t peak;          /** Most bytes used in any frame */
+    size_t total_allocs;  /** Frame allocations since the thread started */
+    size_t epoch;         /** Value of g_frame_epoch when last recycled */
+} FrameArena;
+
 typedef struct MemoryManagerThread {
     AllocEntry *alloc_table[ALLOC_TABLE_SIZE];
 #if MEMORY_TRACKING == 1 && MEMORY_TRACK_FREE == 1
@@ -86,6 +107,7 @@ typedef struct MemoryManagerThread {
 #endif
     MemStats global;
     MemStats tags[MMTAG_COUNT];
+    FrameArena frame;
     int32_t thread_number;
 } MemoryManagerThread;
 
@@ -98,6 +120,10 @@ typedef struct MemoryManager {
 static MemoryManager *g_memory_manager = NULL;
 static EseMutex *g_mm_mutex = NULL;
 
+// Bumped by frame_reset; arenas recycle when they see a new value. Atomic so
+// frame allocations can check it without taking g_mm_mutex.
+static EseAtomicSizeT *g_frame_epoch = NULL;
+
 // Shared memory manager
 static EseMutex *g_shared_mutex = NULL;
 static MemoryManagerThread *g_shared_thread = NULL;
@@ -123,6 +149,7 @@ static const char *mem_tag_names[MMTAG_COUNT] = {
     "ARRAY           ",
     "HASHMAP         ",
     "GROUP_HASHMAP   ",
+    "SLOT_MAP        ",
     "LINKED_LIST     ",
     "LINKED_LIST_ITER",
     "CONSOLE         ",
@@ -152,6 +179,7 @@ static const char *mem_tag_names[MMTAG_COUNT] = {
     "REN_SYS_COLLIDER",
     "REN_SYS_MAP     ",
     "SYS_MAP         ",
+    "FRAME           ",
     "TEMP            ",
 };
 
@@ -184,6 +212,11 @@ static MemoryManagerThread *_get_thread_manager(void) {
             fprintf(stderr, "FATAL: Out of memory (resize mutex)\n");
             abort();
         }
+        g_frame_epoch = ese_atomic_size_t_create(0);
+        if (!g_frame_epoch) {
+            fprintf(stderr, "FATAL: Out of memory (frame epoch)\n");
+            abort();
+        }
     }
 
     ese_mutex_lock(g_mm_mutex);
@@ -454,6 +487,10 @@ static void _mm_report(MemoryManagerThread *thread) {
     printf("Total frees:   %zu\n", thread->global.total_frees);
     printf("Largest alloc: %zu bytes\n", thread->global.largest_alloc);
     printf("Total allocated: %zu bytes\n", thread->global.total_bytes_alloced);
+    if (thread->frame.total_allocs > 0) {
+        printf("Frame arena:   %zu allocs, peak %zu bytes per frame\n",
+               thread->frame.total_allocs, thread->frame.peak);
+    }
 
     // Check for leaks
     size_t leak_count = 0;
@@ -764,6 +801,98 @@ static char *_mm_strdup(MemoryManagerThread *thread, const char *str, MemTag tag
     return copy;
 }
 
+// ========================================
+// FRAME ARENA FUNCTIONS
+// ========================================
+
+/**
+ * @brief Free every block of a thread's frame arena.
+ *
+ * @param thread The thread's memory manager
+ */
+static void _frame_release(MemoryManagerThread *thread) {
+    FrameBlock *block = thread->frame.blocks;
+    while (block) {
+        FrameBlock *next = block->next;
+        _mm_free(thread, block);
+        block = next;
+    }
+    thread->frame.blocks = NULL;
+    thread->frame.used = 0;
+}
+
+/**
+ * @brief Push a new block onto a thread's frame arena.
+ *
+ * @param thread The thread's memory manager
+ * @param size Minimum usable size of the block
+ */
+static FrameBlock *_frame_add_block(MemoryManagerThread *thread, size_t size) {
+    if (size < FRAME_BLOCK_SIZE) {
+        size = FRAME_BLOCK_SIZE;
+    }
+    FrameBlock *block = (FrameBlock *)_mm_malloc(thread, sizeof(FrameBlock) + size, MMTAG_FRAME);
+    block->next = thread->frame.blocks;
+    block->size = size;
+    block->used = 0;
+    thread->frame.blocks = block;
+    return block;
+}
+
+/**
+ * @brief Recycle a thread's frame arena.
+ *
+ * @details A frame that spilled into several blocks leaves one block big
+ * enough for all of it, so a steady workload settles on a single block and
+ * never reaches _mm_malloc.
+ *
+ * @param thread The thread's memory manager
+ */
+static void _frame_recycle(MemoryManagerThread *thread) {
+    FrameArena *arena = &thread->frame;
+    if (arena->blocks && arena->blocks->next) {
+        size_t used = arena->used;
+        _frame_release(thread);
+        _frame_add_block(thread, used);
+    } else if (arena->blocks) {
+        arena->blocks->used = 0;
+    }
+    arena->used = 0;
+}
+
+/**
+ * @brief Bump-allocate from the thread's frame arena.
+ *
+ * @param thread The thread's memory manager
+ * @param size The size to allocate
+ * @return void* 16-byte aligned pointer, valid until the next frame reset
+ */
+static void *_frame_alloc(MemoryManagerThread *thread, size_t size) {
+    log_assert("MEMORY_MANAGER", thread != NULL, "Thread is NULL");
+
+    FrameArena *arena = &thread->frame;
+    size_t epoch = ese_atomic_size_t_load(g_frame_epoch);
+    if (arena->epoch != epoch) {
+        _frame_recycle(thread);
+        arena->epoch = epoch;
+    }
+
+    size = _align_up(size ? size : 1, 16);
+    FrameBlock *block = arena->blocks;
+    if (!block || block->size - block->used < size) {
+        block = _frame_add_block(thread, size);
+    }
+
+    void *ptr = block->data + block->used;
+    block->used += size;
+    arena->used += size;
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+    arena->total_allocs++;
+    return ptr;
+}
+
 /**
  * @brief Destroy the memory manager and clean up resources.
  *
@@ -935,11 +1064,38 @@ static char *_mm_strdup_wrapper(const char *str, MemTag tag) {
     return _mm_strdup(thread, str, tag);
 }
 
+static void *_mm_frame_alloc_wrapper(size_t size) {
+    MemoryManagerThread *thread = _get_thread_manager();
+    return _frame_alloc(thread, size);
+}
+
+static void *_mm_frame_calloc_wrapper(size_t count, size_t size) {
+    MemoryManagerThread *thread = _get_thread_manager();
+    if (size != 0 && count > SIZE_MAX / size) {
+        _abort_with_report(thread, "Invalid frame_calloc parameters");
+        return NULL;
+    }
+    void *ptr = _frame_alloc(thread, count * size);
+    memset(ptr, 0, count * size);
+    return ptr;
+}
+
+static void _mm_frame_reset_wrapper(void) {
+    MemoryManagerThread *thread = _get_thread_manager();
+    size_t epoch = ese_atomic_size_t_fetch_add(g_frame_epoch, 1) + 1;
+    _frame_recycle(thread);
+    thread->frame.epoch = epoch;
+}
+
 static void _mm_destroy_wrapper(bool all_threads) {
     if (!all_threads) {
+        if (!g_memory_manager) {
+            return;
+        }
         int tid = ese_thread_get_number();
         MemoryManagerThread *thread = g_memory_manager->threads[tid];
         if (thread) {
+            _frame_release(thread);
             _mm_report(thread);
             ese_mutex_lock(g_mm_mutex);
             _mm_destroy(thread);
@@ -949,11 +1105,12 @@ static void _mm_destroy_wrapper(bool all_threads) {
         return;
     }
 
-    // Destroy all threads
+    // Destroy all threads; there are none if only shared allocations were made
     log_debug("MEMORY_MANAGER", "Destroying all threads");
-    for (size_t i = 0; i < g_memory_manager->capacity; i++) {
+    for (size_t i = 0; g_memory_manager && i < g_memory_manager->capacity; i++) {
         MemoryManagerThread *thread = g_memory_manager->threads[i];
         if (thread) {
+            _frame_release(thread);
             _mm_report(thread);
             ese_mutex_lock(g_mm_mutex);
             _mm_destroy(thread);
@@ -974,11 +1131,15 @@ static void _mm_destroy_wrapper(bool all_threads) {
     }
 
     // Destroy the memory manager
-    log_debug("MEMORY_MANAGER", "Destroying memory manager");
-    free(g_memory_manager->threads);
-    g_memory_manager->threads = NULL;
-    free(g_memory_manager);
-    g_memory_manager = NULL;
+    if (g_memory_manager) {
+        log_debug("MEMORY_MANAGER", "Destroying memory manager");
+        free(g_memory_manager->threads);
+        g_memory_manager->threads = NULL;
+        free(g_memory_manager);
+        g_memory_manager = NULL;
+        ese_atomic_size_t_destroy(g_frame_epoch);
+        g_frame_epoch = NULL;
+    }
 }
 
 static void _mm_report_wrapper(bool all_threads) {
@@ -1016,6 +1177,10 @@ const struct memory_manager_api memory_manager = {
     .report = _mm_report_wrapper,
     .destroy = _mm_destroy_wrapper,
 
+    .frame_alloc = _mm_frame_alloc_wrapper,
+    .frame_calloc = _mm_frame_calloc_wrapper,
+    .frame_reset = _mm_frame_reset_wrapper,
+
     .shared = {
         .malloc = _mm_malloc_shared,
         .calloc = _mm_calloc_shared,
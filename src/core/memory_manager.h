@@ -46,6 +46,7 @@ typedef enum {
     MMTAG_ARRAY,
     MMTAG_HASHMAP,
     MMTAG_GROUP_HASHMAP,
+    MMTAG_SLOT_MAP,
     MMTAG_LINKED_LIST,
     MMTAG_LINKED_LIST_ITER,
     MMTAG_CONSOLE,
@@ -75,6 +76,7 @@ typedef enum {
     MMTAG_RS_COLLIDER, /** Renderer System - Collider */
     MMTAG_RS_MAP,      /** Renderer System - Map */
     MMTAG_S_MAP,       /** System - Map */
+    MMTAG_FRAME,       /** Blocks backing the per-thread frame arenas */
     MMTAG_TEMP,        /** Temporary - Should only be used while actively debugging and testing. */
     MMTAG_COUNT
 } MemTag;
@@ -105,6 +107,14 @@ typedef enum {
  * enables the "memory_manager.malloc" style usage pattern throughout the
  * codebase. All functions are implemented by the memory manager and provide
  * consistent memory tracking and management capabilities.
+ *
+ * frame_alloc and frame_calloc bump-allocate from an arena owned by the calling
+ * thread. The memory is never freed individually and stays valid until the
+ * next frame_reset, which the engine calls at the end of engine_update; it must
+ * not be handed to anything that outlives the frame, such as job queue
+ * callbacks. frame_reset may only be called while no other thread is using
+ * frame memory: it recycles the calling thread's arena at once and every other
+ * thread's arena on that thread's next frame allocation.
  */
 struct memory_manager_api {
     void *(*malloc)(size_t size, MemTag tag);               /** Allocate memory */
@@ -115,6 +125,10 @@ struct memory_manager_api {
     void (*report)(bool all_threads);                       /** Print memory usage report */
     void (*destroy)(bool all_threads);                      /** Cleanup memory manager resources */
 
+    void *(*frame_alloc)(size_t size);                      /** Allocate until the frame ends */
+    void *(*frame_calloc)(size_t count, size_t size);       /** Allocate zeroed until frame ends */
+    void (*frame_reset)(void);                              /** End the frame for all threads */
+
     const struct memory_manager_shared_api shared;          /** Shared cross-thread API */
 };
 
@@ -8,9 +8,20 @@
  * Systems are organized into three phases: EARLY (parallel before Lua), LUA
  * (single-threaded), and LATE (parallel after Lua). Systems can be executed
  * sequentially or in parallel using the job queue. Component add/remove events
- * notify interested systems based on their acceptance filters. Each system has
- * optional callbacks for initialization, update, component tracking, and
- * shutdown.
+ * notify interested systems based on their component masks: registration files
+ * each system under the component types it tracks, so a notification only
+ * visits the systems for the component's type. Systems without a mask fall
+ * back to their acceptance filter. Each system has optional callbacks for
+ * initialization, update, component tracking, and shutdown.
+ *
+ * engine_run_phases replaces the barrier between phases with a dependency
+ * graph: a system depends on every earlier system (by phase, then
+ * registration) whose declared reads/writes conflict with its own. The graph
+ * is small (at most 64 nodes), so edges are bitmasks of predecessors. The
+ * calling thread hands ready worker systems to the job queue, runs ready
+ * main-thread systems itself and sleeps on the schedule's condition variable
+ * only when nothing it can run is ready. Each run records start/end times per
+ * system for engine_schedule_dump.
  *
  * Copyright (c) 2025-2026 Entity Sprite Engine
  * See LICENSE.md for details.
@@ -19,23 +30,66 @@
 #include "core/engine_private.h"
 #include "core/memory_manager.h"
 #include "core/system_manager_private.h"
+#include "platform/time.h"
 #include "utility/job_queue.h"
 #include "utility/log.h"
+#include "utility/thread.h"
+#include <stdarg.h>
+#include <stdio.h>
 #include <string.h>
 
 // ========================================
 // Defines and Structs
 // ========================================
 
+// Largest number of systems in one engine_run_phases call (one bit each)
+#define SYSTEM_SCHEDULE_MAX_NODES 64
+
 /**
- * @brief User data structure for system job execution.
+ * @brief One system in a recorded schedule.
  */
 typedef struct {
+    EseSystemManager *sys; /** System */
+    uint64_t preds;        /** Bits of the nodes it waits for */
+    uint64_t start_ns;     /** When its update started */
+    uint64_t end_ns;       /** When its update returned */
+    bool main_thread;      /** Whether it ran on the calling thread */
+} SystemScheduleNode;
+
+/**
+ * @brief The recorded schedule of one engine_run_phases call.
+ */
+typedef struct {
+    SystemScheduleNode nodes[SYSTEM_SCHEDULE_MAX_NODES]; /** Nodes in dependency order */
+    size_t count;                                        /** Number of nodes */
+    EseSystemPhase last;                                 /** Last phase of the range */
+    uint64_t start_ns;                                   /** Start of the run */
+    uint64_t end_ns;                                     /** End of the run */
+    uint64_t frame;                                      /** Frame the run belongs to */
+} SystemScheduleSpan;
+
+struct EseSystemSchedule {
+    EseMutex *mutex;                           /** Guards done */
+    EseCond *cond;                             /** Signaled when a worker node finishes */
+    uint64_t done;                             /** Bits of worker nodes that finished */
+    uint64_t frame;                            /** Incremented by every EARLY-first run */
+    SystemScheduleSpan spans[SYS_PHASE_COUNT]; /** Last run, by first phase */
+};
+
+/**
+ * @brief User data structure for system job execution.
+ */
+typedef struct SystemJobData {
     EseSystemManager *sys;
     EseEngine *eng;
     float dt;
+    EseSystemSchedule *schedule; /** Schedule to report to, or NULL */
+    SystemScheduleNode *node;    /** Node of this job in the schedule */
+    uint64_t bit;                /** Bit of the node */
 } SystemJobData;
 
+static const char *const g_phase_names[SYS_PHASE_COUNT] = {"EARLY", "LUA", "LATE", "CLEANUP"};
+
 // ========================================
 // PRIVATE FUNCTIONS
 // ========================================
@@ -54,17 +108,186 @@ static JobResult _system_job_worker(void *thread_data, const void *user_data,
     (void)canceled;
 
     SystemJobData *job_data = (SystemJobData *)user_data;
+    JobResult res = {.result = NULL, .size = 0, .copy_fn = NULL, .free_fn = NULL};
+    if (job_data && job_data->node) {
+        job_data->node->start_ns = time_now();
+    }
     if (job_data && job_data->sys && job_data->sys->vt && job_data->sys->vt->update) {
         // Delegate to the system's update callback, which returns a
         // JobResult-compatible payload. An all-zero result means
         // "no work to apply on the main thread".
-        return job_data->sys->vt->update(job_data->sys, job_data->eng, job_data->dt);
+        res = job_data->sys->vt->update(job_data->sys, job_data->eng, job_data->dt);
     }
 
-    JobResult res = {.result = NULL, .size = 0, .copy_fn = NULL, .free_fn = NULL};
+    // Tell a scheduler waiting on this node that its successors may start
+    if (job_data && job_data->schedule) {
+        job_data->node->end_ns = time_now();
+        ese_mutex_lock(job_data->schedule->mutex);
+        job_data->schedule->done |= job_data->bit;
+        ese_cond_broadcast(job_data->schedule->cond);
+        ese_mutex_unlock(job_data->schedule->mutex);
+    }
     return res;
 }
 
+/**
+ * @brief Runs a system update on the calling thread and applies its result.
+ *
+ * @param s System
+ * @param eng Engine pointer
+ * @param dt Delta time
+ */
+static void _system_run_inline(EseSystemManager *s, EseEngine *eng, float dt) {
+    if (!s->vt || !s->vt->update) {
+        return;
+    }
+
+    // Sequential execution: run the system update directly on this
+    // thread. If the system returns a non-empty JobResult and
+    // defines apply_result, invoke it here and then clean up the
+    // worker-result payload.
+    JobResult r = s->vt->update(s, eng, dt);
+
+    if (r.result) {
+        if (s->vt->apply_result) {
+            // In the sequential path we are already on the main
+            // thread, so we can treat the worker result as the
+            // main-thread payload and skip any extra copy step.
+            s->vt->apply_result(s, eng, r.result);
+        }
+
+        if (r.free_fn) {
+            r.free_fn(r.result);
+        } else {
+            memory_manager.free(r.result);
+        }
+    }
+}
+
+/**
+ * @brief Whether a system declared any reads or writes.
+ */
+static bool _system_declared(const EseSystemManager *s) {
+    const EseSystemManagerVTable *vt = s->vt;
+    return vt->reads.components || vt->reads.resources || vt->writes.components ||
+           vt->writes.resources;
+}
+
+/**
+ * @brief Whether two systems must not run at the same time.
+ *
+ * @details Undeclared systems keep the old phase barriers: they conflict with
+ *          every system of another phase and with none of their own.
+ */
+static bool _system_conflicts(const EseSystemManager *a, const EseSystemManager *b) {
+    if (!_system_declared(a) || !_system_declared(b)) {
+        return a->phase != b->phase;
+    }
+
+    const EseSystemManagerVTable *x = a->vt;
+    const EseSystemManagerVTable *y = b->vt;
+    uint32_t components = (x->writes.components & (y->reads.components | y->writes.components)) |
+                          (y->writes.components & x->reads.components);
+    uint32_t resources = (x->writes.resources & (y->reads.resources | y->writes.resources)) |
+                         (y->writes.resources & x->reads.resources);
+    return components || resources;
+}
+
+/**
+ * @brief Whether a system has to run on the thread driving the schedule.
+ */
+static bool _system_needs_main_thread(const EseSystemManager *s) {
+    if (s->phase == SYS_PHASE_LUA || s->phase == SYS_PHASE_CLEANUP) {
+        return true;
+    }
+    return (s->vt->writes.resources & SYS_RES_LUA) != 0;
+}
+
+/**
+ * @brief snprintf into the unused tail of a dump buffer, tracking the full length.
+ */
+static void _dump_append(char *buf, size_t size, size_t *len, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    char *dst = *len < size ? buf + *len : NULL;
+    size_t room = *len < size ? size - *len : 0;
+    int n = vsnprintf(dst, room, fmt, args);
+    va_end(args);
+    if (n > 0) {
+        *len += (size_t)n;
+    }
+}
+
+static const char *_system_name(const EseSystemManager *s) {
+    return s->vt->name ? s->vt->name : "system";
+}
+
+/**
+ * @brief Appends one recorded span and its critical path to a dump.
+ */
+static void _dump_span(const SystemScheduleSpan *span, EseSystemPhase first, char *buf,
+                       size_t size, size_t *len) {
+    // Longest chain ending at each node; nodes are already in dependency order
+    uint64_t chain[SYSTEM_SCHEDULE_MAX_NODES];
+    int via[SYSTEM_SCHEDULE_MAX_NODES];
+    size_t tail = 0;
+    for (size_t j = 0; j < span->count; j++) {
+        const SystemScheduleNode *n = &span->nodes[j];
+        chain[j] = 0;
+        via[j] = -1;
+        for (size_t i = 0; i < j; i++) {
+            if ((n->preds & (1ull << i)) && (via[j] < 0 || chain[i] > chain[j])) {
+                chain[j] = chain[i];
+                via[j] = (int)i;
+            }
+        }
+        chain[j] += n->end_ns - n->start_ns;
+        if (chain[j] >= chain[tail]) {
+            tail = j;
+        }
+    }
+
+    _dump_append(buf, size, len, "%s..%s: %zu systems, %.3f ms, critical path %.3f ms\n",
+                 g_phase_names[first], g_phase_names[span->last], span->count,
+                 (double)(span->end_ns - span->start_ns) / 1e6,
+                 span->count ? (double)chain[tail] / 1e6 : 0.0);
+
+    for (size_t j = 0; j < span->count; j++) {
+        const SystemScheduleNode *n = &span->nodes[j];
+        _dump_append(buf, size, len, "  %-16s %-6s %8.3f -> %8.3f ms  after:",
+                     _system_name(n->sys), n->main_thread ? "main" : "worker",
+                     (double)(n->start_ns - span->start_ns) / 1e6,
+                     (double)(n->end_ns - span->start_ns) / 1e6);
+        if (!n->preds) {
+            _dump_append(buf, size, len, " -");
+        }
+        for (size_t i = 0; i < j; i++) {
+            if (n->preds & (1ull << i)) {
+                _dump_append(buf, size, len, " %s", _system_name(span->nodes[i].sys));
+            }
+        }
+        _dump_append(buf, size, len, "\n");
+    }
+
+    if (span->count == 0) {
+        return;
+    }
+
+    // Walk the chain back from its tail, then print it front to back
+    int path[SYSTEM_SCHEDULE_MAX_NODES];
+    size_t path_len = 0;
+    for (int k = (int)tail; k >= 0; k = via[k]) {
+        path[path_len++] = k;
+    }
+    _dump_append(buf, size, len, "  critical path:");
+    while (path_len > 0) {
+        path_len--;
+        _dump_append(buf, size, len, " %s%s", _system_name(span->nodes[path[path_len]].sys),
+                     path_len ? " ->" : "");
+    }
+    _dump_append(buf, size, len, "\n");
+}
+
 /**
  * @brief Main-thread callback for system jobs.
  *
@@ -89,21 +312,37 @@ static void _system_job_callback(ese_job_id_t job_id, void *user_data, void *res
  * @brief Cleanup function for system jobs.
  *
  * @param job_id Job ID (unused)
- * @param user_data Pointer to SystemJobData to free
+ * @param user_data SystemJobData of the system (unused)
  * @param result Result pointer (main-thread copy)
  *
  * @note The lifetime of the result payload is managed by the system's
  *       apply_result callback (for parallel phases) or by engine_run_phase
- *       (for sequential phases). This function is only responsible for freeing
- *       the SystemJobData wrapper.
+ *       (for sequential phases), and the SystemJobData belongs to the system,
+ *       so there is nothing left to free.
  */
 static void _system_job_cleanup(ese_job_id_t job_id, void *user_data, void *result) {
     (void)job_id;
+    (void)user_data;
     (void)result;
+}
 
-    if (user_data) {
-        memory_manager.free(user_data);
-    }
+/**
+ * @brief Fill in a system's job payload for one run.
+ *
+ * @details A job of the previous frame may still wait for its callback, which
+ *          only reads sys and eng; those never change for a system.
+ */
+static SystemJobData *_system_job_data(EseSystemManager *s, EseEngine *eng, float dt,
+                                       EseSystemSchedule *schedule, SystemScheduleNode *node,
+                                       uint64_t bit) {
+    SystemJobData *job_data = s->job;
+    job_data->sys = s;
+    job_data->eng = eng;
+    job_data->dt = dt;
+    job_data->schedule = schedule;
+    job_data->node = node;
+    job_data->bit = bit;
+    return job_data;
 }
 
 // ========================================
@@ -123,6 +362,7 @@ EseSystemManager *system_manager_create(const EseSystemManagerVTable *vt, EseSys
     log_assert("SYSTEM_MANAGER", vt, "system_manager_create called with NULL vtable");
 
     EseSystemManager *s = memory_manager.calloc(1, sizeof(EseSystemManager), MMTAG_ENGINE);
+    s->job = memory_manager.calloc(1, sizeof(SystemJobData), MMTAG_ENGINE);
     s->vt = vt;
     s->phase = phase;
     s->data = user_data;
@@ -144,6 +384,7 @@ void system_manager_destroy(EseSystemManager *sys, EseEngine *eng) {
         sys->vt->shutdown(sys, eng);
     }
 
+    memory_manager.free(sys->job);
     memory_manager.free(sys);
 }
 
@@ -166,6 +407,22 @@ void engine_add_system(EseEngine *eng, EseSystemManager *sys) {
 
     eng->systems[eng->sys_count++] = sys;
 
+    // File the system under every type it may track; without a mask, accepts may pick any type
+    uint32_t mask = sys->vt->component_mask;
+    if (!mask && sys->vt->accepts) {
+        mask = ENTITY_COMPONENT_MASK_ALL;
+    }
+    for (int type = 0; type < ENTITY_COMPONENT_TYPE_COUNT; type++) {
+        if (!(mask & ENTITY_COMPONENT_BIT(type))) {
+            continue;
+        }
+        log_assert("SYSTEM_MANAGER", eng->type_sys_count[type] < ENTITY_COMPONENT_MAX_SYSTEMS,
+                   "engine_add_system: more than %d systems for component type %d",
+                   ENTITY_COMPONENT_MAX_SYSTEMS, type);
+        sys->slots[type] = eng->type_sys_count[type];
+        eng->type_systems[type][eng->type_sys_count[type]++] = sys;
+    }
+
     if (sys->vt && sys->vt->init) {
         sys->vt->init(sys, eng);
     }
@@ -187,8 +444,8 @@ void engine_run_phase(EseEngine *eng, EseSystemPhase phase, float dt, bool paral
     size_t job_count = 0;
 
     if (parallel && eng->job_queue) {
-        // Allocate space for job IDs (worst case: all systems in this phase)
-        job_ids = memory_manager.malloc(sizeof(ese_job_id_t) * eng->sys_count, MMTAG_ENGINE);
+        // Space for job IDs (worst case: all systems in this phase)
+        job_ids = memory_manager.frame_alloc(sizeof(ese_job_id_t) * eng->sys_count);
     }
 
     for (size_t i = 0; i < eng->sys_count; i++) {
@@ -198,11 +455,7 @@ void engine_run_phase(EseEngine *eng, EseSystemPhase phase, float dt, bool paral
         }
 
         if (parallel && eng->job_queue) {
-            // Allocate job data for this system
-            SystemJobData *job_data = memory_manager.malloc(sizeof(SystemJobData), MMTAG_ENGINE);
-            job_data->sys = s;
-            job_data->eng = eng;
-            job_data->dt = dt;
+            SystemJobData *job_data = _system_job_data(s, eng, dt, NULL, NULL, 0);
 
             // Push the job to any available worker
             ese_job_id_t job_id = ese_job_queue_push(eng->job_queue, _system_job_worker,
@@ -213,28 +466,7 @@ void engine_run_phase(EseEngine *eng, EseSystemPhase phase, float dt, bool paral
                 job_ids[job_count++] = job_id;
             }
         } else {
-            if (s->vt && s->vt->update) {
-                // Sequential execution: run the system update directly on this
-                // thread. If the system returns a non-empty JobResult and
-                // defines apply_result, invoke it here and then clean up the
-                // worker-result payload.
-                JobResult r = s->vt->update(s, eng, dt);
-
-                if (r.result) {
-                    if (s->vt->apply_result) {
-                        // In the sequential path we are already on the main
-                        // thread, so we can treat the worker result as the
-                        // main-thread payload and skip any extra copy step.
-                        s->vt->apply_result(s, eng, r.result);
-                    }
-
-                    if (r.free_fn) {
-                        r.free_fn(r.result);
-                    } else {
-                        memory_manager.free(r.result);
-                    }
-                }
-            }
+            _system_run_inline(s, eng, dt);
         }
     }
 
@@ -243,10 +475,193 @@ void engine_run_phase(EseEngine *eng, EseSystemPhase phase, float dt, bool paral
         for (size_t i = 0; i < job_count; i++) {
             ese_job_queue_wait_for_completion(eng->job_queue, job_ids[i], 0);
         }
-        memory_manager.free(job_ids);
     }
 }
 
+/**
+ * @brief Run the systems of a range of phases as a dependency graph.
+ *
+ * @param eng Engine pointer
+ * @param first First phase
+ * @param last Last phase (inclusive)
+ * @param dt Delta time
+ */
+void engine_run_phases(EseEngine *eng, EseSystemPhase first, EseSystemPhase last, float dt) {
+    log_assert("SYSTEM_MANAGER", eng, "engine_run_phases called with NULL engine");
+    log_assert("SYSTEM_MANAGER", first <= last && last < SYS_PHASE_COUNT,
+               "engine_run_phases called with a bad phase range");
+
+    EseSystemSchedule *schedule = eng->schedule;
+    if (first == SYS_PHASE_EARLY) {
+        schedule->frame++;
+    }
+
+    SystemScheduleSpan *span = &schedule->spans[first];
+    span->count = 0;
+    span->last = last;
+    span->frame = schedule->frame;
+    for (int phase = (int)first; phase <= (int)last; phase++) {
+        for (size_t i = 0; i < eng->sys_count; i++) {
+            EseSystemManager *s = eng->systems[i];
+            if (!s->active || s->phase != (EseSystemPhase)phase) {
+                continue;
+            }
+            log_assert("SYSTEM_MANAGER", span->count < SYSTEM_SCHEDULE_MAX_NODES,
+                       "engine_run_phases: more than %d systems", SYSTEM_SCHEDULE_MAX_NODES);
+
+            SystemScheduleNode *node = &span->nodes[span->count];
+            memset(node, 0, sizeof(*node));
+            node->sys = s;
+            node->main_thread = !eng->job_queue || _system_needs_main_thread(s);
+            for (size_t p = 0; p < span->count; p++) {
+                if (_system_conflicts(span->nodes[p].sys, s)) {
+                    node->preds |= 1ull << p;
+                }
+            }
+            span->count++;
+        }
+    }
+
+    uint64_t all = span->count == 64 ? ~0ull : (1ull << span->count) - 1;
+    uint64_t started = 0;
+    uint64_t finished = 0;
+    ese_mutex_lock(schedule->mutex);
+    schedule->done = 0;
+    ese_mutex_unlock(schedule->mutex);
+    span->start_ns = time_now();
+
+    while (finished != all) {
+        // Hand every ready worker node to the job queue
+        for (size_t j = 0; j < span->count; j++) {
+            SystemScheduleNode *node = &span->nodes[j];
+            uint64_t bit = 1ull << j;
+            if ((started & bit) || node->main_thread || (node->preds & ~finished)) {
+                continue;
+            }
+            started |= bit;
+
+            SystemJobData *job_data = _system_job_data(node->sys, eng, dt, schedule, node, bit);
+            ese_job_id_t job_id = ese_job_queue_push(eng->job_queue, _system_job_worker,
+                                                     _system_job_callback, _system_job_cleanup,
+                                                     job_data);
+            if (job_id == ESE_JOB_NOT_QUEUED) {
+                node->main_thread = true;
+                started &= ~bit;
+            }
+        }
+
+        // Run the first ready main-thread node while the workers get going
+        bool ran = false;
+        for (size_t j = 0; j < span->count; j++) {
+            SystemScheduleNode *node = &span->nodes[j];
+            uint64_t bit = 1ull << j;
+            if ((started & bit) || !node->main_thread || (node->preds & ~finished)) {
+                continue;
+            }
+            started |= bit;
+            node->start_ns = time_now();
+            _system_run_inline(node->sys, eng, dt);
+            node->end_ns = time_now();
+            finished |= bit;
+            ran = true;
+            break;
+        }
+
+        // Pick up finished workers, sleeping only if nothing else could run
+        ese_mutex_lock(schedule->mutex);
+        while (!ran && (schedule->done & ~finished) == 0) {
+            ese_cond_wait(schedule->cond, schedule->mutex);
+        }
+        finished |= schedule->done;
+        ese_mutex_unlock(schedule->mutex);
+    }
+
+    span->end_ns = time_now();
+}
+
+/**
+ * @brief Format the most recent schedules.
+ *
+ * @param eng Engine pointer
+ * @param buf Output buffer
+ * @param size Size of buf
+ * @return size_t Length of the full dump
+ */
+size_t engine_schedule_dump(EseEngine *eng, char *buf, size_t size) {
+    log_assert("SYSTEM_MANAGER", eng, "engine_schedule_dump called with NULL engine");
+    log_assert("SYSTEM_MANAGER", buf || size == 0, "engine_schedule_dump called with NULL buf");
+
+    size_t len = 0;
+    if (size > 0) {
+        buf[0] = '\0';
+    }
+    EseSystemSchedule *schedule = eng->schedule;
+    for (int first = 0; first < SYS_PHASE_COUNT; first++) {
+        const SystemScheduleSpan *span = &schedule->spans[first];
+        if (span->frame == 0 || span->frame != schedule->frame) {
+            continue;
+        }
+        _dump_span(span, (EseSystemPhase)first, buf, size, &len);
+    }
+    return len;
+}
+
+/**
+ * @brief Create the scheduler state for an engine.
+ *
+ * @return EseSystemSchedule* New scheduler state
+ */
+EseSystemSchedule *system_schedule_create(void) {
+    EseSystemSchedule *schedule = memory_manager.calloc(1, sizeof(EseSystemSchedule), MMTAG_ENGINE);
+    schedule->mutex = ese_mutex_create();
+    schedule->cond = ese_cond_create();
+    return schedule;
+}
+
+/**
+ * @brief Free an engine's scheduler state.
+ *
+ * @param schedule Scheduler state (may be NULL)
+ */
+void system_schedule_destroy(EseSystemSchedule *schedule) {
+    if (!schedule) {
+        return;
+    }
+    ese_cond_destroy(schedule->cond);
+    ese_mutex_destroy(schedule->mutex);
+    memory_manager.free(schedule);
+}
+
+/**
+ * @brief Record a component's index in a system's tracking array.
+ *
+ * @param sys System tracking the component
+ * @param comp Component
+ * @param index Index of the component in the system's array
+ */
+void system_manager_track(EseSystemManager *sys, EseEntityComponent *comp, size_t index) {
+    log_assert("SYSTEM_MANAGER", sys, "system_manager_track called with NULL system");
+    log_assert("SYSTEM_MANAGER", comp, "system_manager_track called with NULL component");
+
+    // Stored off by one so a cleared slot reads as untracked
+    comp->system_index[sys->slots[comp->type]] = (uint32_t)index + 1;
+}
+
+/**
+ * @brief Get the index recorded by system_manager_track.
+ *
+ * @param sys System
+ * @param comp Component
+ * @return size_t Recorded index or SYSTEM_MANAGER_UNTRACKED
+ */
+size_t system_manager_tracked_index(const EseSystemManager *sys, const EseEntityComponent *comp) {
+    log_assert("SYSTEM_MANAGER", sys, "system_manager_tracked_index called with NULL system");
+    log_assert("SYSTEM_MANAGER", comp, "system_manager_tracked_index called with NULL component");
+
+    uint32_t stored = comp->system_index[sys->slots[comp->type]];
+    return stored ? (size_t)stored - 1 : SYSTEM_MANAGER_UNTRACKED;
+}
+
 /**
  * @brief Notify all systems that a component has been added.
  *
@@ -259,13 +674,13 @@ void engine_notify_comp_add(EseEngine *eng, EseEntityComponent *c) {
 
     log_verbose("SYSTEM_MANAGER", "Notifying systems of component add");
 
-    for (size_t i = 0; i < eng->sys_count; i++) {
-        EseSystemManager *s = eng->systems[i];
+    for (size_t i = 0; i < eng->type_sys_count[c->type]; i++) {
+        EseSystemManager *s = eng->type_systems[c->type][i];
         if (!s->active) {
             continue;
         }
 
-        if (s->vt->accepts && s->vt->accepts(s, c)) {
+        if (s->vt->component_mask || (s->vt->accepts && s->vt->accepts(s, c))) {
             log_verbose("SYSTEM_MANAGER", "System %zu accepts component", i);
             if (s->vt->on_component_added) {
                 s->vt->on_component_added(s, eng, c);
@@ -274,6 +689,39 @@ void engine_notify_comp_add(EseEngine *eng, EseEntityComponent *c) {
     }
 }
 
+/**
+ * @brief Notify all systems that a batch of same-type components was added.
+ *
+ * @param eng Engine pointer
+ * @param comps Components that were added
+ * @param count Number of components
+ */
+void engine_notify_comp_add_batch(EseEngine *eng, EseEntityComponent **comps, size_t count) {
+    log_assert("SYSTEM_MANAGER", eng, "engine_notify_comp_add_batch called with NULL engine");
+    log_assert("SYSTEM_MANAGER", comps || count == 0,
+               "engine_notify_comp_add_batch called with NULL comps");
+
+    if (count == 0) {
+        return;
+    }
+
+    EntityComponentType type = comps[0]->type;
+    for (size_t i = 0; i < eng->type_sys_count[type]; i++) {
+        EseSystemManager *s = eng->type_systems[type][i];
+        if (!s->active || !s->vt->on_component_added) {
+            continue;
+        }
+
+        for (size_t c = 0; c < count; c++) {
+            log_assert("SYSTEM_MANAGER", comps[c]->type == type,
+                       "engine_notify_comp_add_batch: mixed component types");
+            if (s->vt->component_mask || (s->vt->accepts && s->vt->accepts(s, comps[c]))) {
+                s->vt->on_component_added(s, eng, comps[c]);
+            }
+        }
+    }
+}
+
 /**
  * @brief Notify all systems that a component is about to be removed.
  *
@@ -284,13 +732,13 @@ void engine_notify_comp_rem(EseEngine *eng, EseEntityComponent *c) {
     log_assert("SYSTEM_MANAGER", eng, "engine_notify_comp_rem called with NULL engine");
     log_assert("SYSTEM_MANAGER", c, "engine_notify_comp_rem called with NULL component");
 
-    for (size_t i = 0; i < eng->sys_count; i++) {
-        EseSystemManager *s = eng->systems[i];
+    for (size_t i = 0; i < eng->type_sys_count[c->type]; i++) {
+        EseSystemManager *s = eng->type_systems[c->type][i];
         if (!s->active) {
             continue;
         }
 
-        if (s->vt->accepts && s->vt->accepts(s, c)) {
+        if (s->vt->component_mask || (s->vt->accepts && s->vt->accepts(s, c))) {
             if (s->vt->on_component_removed) {
                 s->vt->on_component_removed(s, eng, c);
             }
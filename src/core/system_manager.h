@@ -14,6 +14,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "utility/job_queue.h"
 
@@ -21,6 +22,9 @@ typedef struct EseEngine EseEngine;
 typedef struct EseEntityComponent EseEntityComponent;
 typedef struct EseDrawList EseDrawList;
 
+// Returned by system_manager_tracked_index for a component the system is not tracking
+#define SYSTEM_MANAGER_UNTRACKED SIZE_MAX
+
 /**
  * @brief Phase bucket for coarse scheduling of system execution.
  *
@@ -33,9 +37,35 @@ typedef enum {
     SYS_PHASE_EARLY,   /** Parallel execution before Lua scripts */
     SYS_PHASE_LUA,     /** Single-threaded execution for Lua components */
     SYS_PHASE_LATE,    /** Parallel execution after Lua, before render */
-    SYS_PHASE_CLEANUP  /** Single-threaded cleanup after all systems complete */
+    SYS_PHASE_CLEANUP, /** Single-threaded cleanup after all systems complete */
+    SYS_PHASE_COUNT    /** Number of phases, not a phase */
 } EseSystemPhase;
 
+/**
+ * @brief Engine state, other than component data, that systems declare access to.
+ *
+ * @details Used in EseSystemAccess.resources. Two systems whose access sets
+ *          overlap with at least one write are ordered by the scheduler; all
+ *          others may run at the same time. Draw list appends are not a
+ *          resource: any number of systems may append concurrently and the
+ *          renderer's z-sort orders the result.
+ */
+typedef enum {
+    SYS_RES_TRANSFORMS = 1u << 0, /** Entity positions (the engine's transform pool) */
+    SYS_RES_ENTITIES = 1u << 1,   /** Entity flags and membership: active, visible, tags */
+    SYS_RES_COLLISION = 1u << 2,  /** Collider world bounds and the spatial index */
+    SYS_RES_CAMERA = 1u << 3,     /** Camera and display state */
+    SYS_RES_LUA = 1u << 4,        /** The Lua state; systems writing it run on the main thread */
+} EseSystemResource;
+
+/**
+ * @brief A set of component types and engine resources.
+ */
+typedef struct EseSystemAccess {
+    uint32_t components; /** ENTITY_COMPONENT_BIT flags */
+    uint32_t resources;  /** EseSystemResource flags */
+} EseSystemAccess;
+
 /**
  * @brief Opaque handle to a System instance.
  */
@@ -57,6 +87,30 @@ typedef JobResult EseSystemJobResult;
  *          Systems should implement only the callbacks they need.
  */
 typedef struct EseSystemManagerVTable {
+    /**
+     * @brief Short name used in schedule dumps (may be NULL).
+     */
+    const char *name;
+
+    /**
+     * @brief Component types and resources the update callback reads.
+     *
+     * @details Together with writes this places the system in the frame's
+     *          dependency graph. A system that declares neither set is
+     *          treated as touching everything outside its own phase: it
+     *          waits for every earlier phase and blocks every later one, the
+     *          same as the old phase barriers.
+     */
+    EseSystemAccess reads;
+
+    /**
+     * @brief Component types and resources the update callback writes.
+     *
+     * @details Writing a component type includes adding or removing
+     *          components of that type.
+     */
+    EseSystemAccess writes;
+
     /**
      * @brief Called once when the system is registered with the engine.
      *
@@ -80,9 +134,21 @@ typedef struct EseSystemManagerVTable {
      */
     EseSystemJobResult (*update)(EseSystemManager *self, EseEngine *eng, float dt);
 
+    /**
+     * @brief Component types this system tracks, as ENTITY_COMPONENT_BIT flags.
+     *
+     * @details When non-zero, the engine only notifies the system about
+     *          components of these types and never calls accepts. Systems
+     *          that filter on more than the type leave it 0 and implement
+     *          accepts, which is then asked about every component.
+     */
+    uint32_t component_mask;
+
     /**
      * @brief Determines whether this system is interested in a component.
      *
+     * @details Only used when component_mask is 0.
+     *
      * @param self Pointer to the system instance.
      * @param comp Pointer to the component to check.
      * @return true if the system wants to track this component, false
@@ -180,22 +246,98 @@ void engine_add_system(EseEngine *eng, EseSystemManager *sys);
  */
 void engine_run_phase(EseEngine *eng, EseSystemPhase phase, float dt, bool parallel);
 
+/**
+ * @brief Runs the systems of a range of phases as a dependency graph.
+ *
+ * @details Systems from first to last (in phase order, then registration
+ *          order) become nodes; a later system depends on an earlier one when
+ *          their declared access sets conflict. Systems of the LUA and
+ *          CLEANUP phases, and systems writing SYS_RES_LUA, run on the calling
+ *          thread; the others run as jobs as soon as their dependencies are
+ *          done, so independent EARLY systems overlap the LUA phase. Returns
+ *          once every system has run. Without a job queue everything runs on
+ *          the calling thread in dependency order. The run is recorded for
+ *          engine_schedule_dump.
+ *
+ * @param eng Pointer to the engine.
+ * @param first First phase to run.
+ * @param last Last phase to run (inclusive).
+ * @param dt Delta time in seconds.
+ */
+void engine_run_phases(EseEngine *eng, EseSystemPhase first, EseSystemPhase last, float dt);
+
+/**
+ * @brief Formats the most recent schedule of every phase range.
+ *
+ * @details For each range run by engine_run_phases this frame: every system
+ *          with the thread it ran on, start and end times relative to the
+ *          start of the range and the systems it waited for, followed by the
+ *          critical path, the longest chain of dependent systems by measured
+ *          duration.
+ *
+ * @param eng Pointer to the engine.
+ * @param buf Output buffer (always NUL terminated when size > 0).
+ * @param size Size of buf in bytes.
+ * @return Number of characters the full dump needs, excluding the NUL.
+ */
+size_t engine_schedule_dump(EseEngine *eng, char *buf, size_t size);
+
+/**
+ * @brief Records where a system keeps a component in its tracking array.
+ *
+ * @details Systems call this from on_component_added, and again for the
+ *          component they move when swap-removing, so removal can find a
+ *          component without scanning. The index is stored on the component
+ *          in the slot the engine gave this system for the component's type.
+ *
+ * @param sys Pointer to the system tracking the component.
+ * @param comp Pointer to the component.
+ * @param index Index of the component in the system's array.
+ */
+void system_manager_track(EseSystemManager *sys, EseEntityComponent *comp, size_t index);
+
+/**
+ * @brief Returns the index recorded by system_manager_track.
+ *
+ * @details The value is a hint: systems must check that their array holds
+ *          the component at the index, since a component that was never
+ *          added (for example one copied with its entity) carries no index.
+ *
+ * @param sys Pointer to the system.
+ * @param comp Pointer to the component.
+ * @return The recorded index, or SYSTEM_MANAGER_UNTRACKED.
+ */
+size_t system_manager_tracked_index(const EseSystemManager *sys, const EseEntityComponent *comp);
+
 /**
  * @brief Notifies all systems that a component has been added.
  *
- * @details Called internally by entity_component_add. Systems that accept the
- * component will have their on_component_added callback invoked.
+ * @details Called internally by entity_component_add. Only systems registered
+ * for the component's type are visited; those that track it (by mask, or by
+ * accepts when they have no mask) get their on_component_added callback.
  *
  * @param eng Pointer to the engine.
  * @param c Pointer to the component that was added.
  */
 void engine_notify_comp_add(EseEngine *eng, EseEntityComponent *c);
 
+/**
+ * @brief Notifies all systems that components of one type have been added.
+ *
+ * @details Same effect as calling engine_notify_comp_add for each component,
+ * but every interested system is looked up once and handed the whole batch.
+ *
+ * @param eng Pointer to the engine.
+ * @param comps Components that were added; all of the same type.
+ * @param count Number of components.
+ */
+void engine_notify_comp_add_batch(EseEngine *eng, EseEntityComponent **comps, size_t count);
+
 /**
  * @brief Notifies all systems that a component is about to be removed.
  *
- * @details Called internally by entity_component_remove. Systems that accept
- * the component will have their on_component_removed callback invoked.
+ * @details Called internally by entity_component_remove. Visits the same
+ * systems as engine_notify_comp_add, calling on_component_removed.
  *
  * @param eng Pointer to the engine.
  * @param c Pointer to the component that will be removed.
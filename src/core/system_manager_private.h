@@ -13,6 +13,7 @@
 #define ESE_SYSTEM_MANAGER_PRIVATE_H
 
 #include "core/system_manager.h"
+#include "entity/components/entity_component_private.h"
 
 /**
  * @brief Internal structure for a System instance.
@@ -22,6 +23,35 @@ struct EseSystemManager {
     EseSystemPhase phase;             /** Execution phase for this system */
     void *data;                       /** User-defined data for system-specific state */
     bool active;                      /** Whether this system is currently active */
+
+    /**
+     * Job payload reused by every job of this system; the job queue runs
+     * callbacks frames after the job, so it cannot live in frame memory
+     */
+    struct SystemJobData *job;
+
+    /** Slot in EseEntityComponent.system_index, per component type */
+    uint8_t slots[ENTITY_COMPONENT_TYPE_COUNT];
 };
 
+// Access declared by systems that run Lua callbacks: scripts reach any component and resource
+#define SYS_LUA_COMPONENTS ENTITY_COMPONENT_MASK_ALL
+#define SYS_LUA_RESOURCES                                                                          \
+    (SYS_RES_TRANSFORMS | SYS_RES_ENTITIES | SYS_RES_COLLISION | SYS_RES_CAMERA | SYS_RES_LUA)
+
+/**
+ * @brief Per-engine state of the dependency-graph scheduler (see engine_run_phases).
+ */
+typedef struct EseSystemSchedule EseSystemSchedule;
+
+/**
+ * @brief Creates the scheduler state owned by an engine.
+ */
+EseSystemSchedule *system_schedule_create(void);
+
+/**
+ * @brief Frees the scheduler state. No engine_run_phases call may be running.
+ */
+void system_schedule_destroy(EseSystemSchedule *schedule);
+
 #endif /* ESE_SYSTEM_MANAGER_PRIVATE_H */
@@ -123,7 +123,7 @@ static int _entity_component_collider_rects_shift(lua_State *L);
  * @brief Lua `__index` metamethod for `EntityComponentCollider` proxies.
  *
  * @details Provides access to properties such as `active`, `id`, `draw_debug`,
- * `map_interaction`, `offset`, `rects`, and the `toJSON` method.
+ * `map_interaction`, `layer`, `mask`, `static`, `offset`, `rects`, and the `toJSON` method.
  *
  * @param L Lua state pointer.
  * @return Number of Lua return values.
@@ -134,7 +134,7 @@ static int _entity_component_collider_index(lua_State *L);
  * @brief Lua `__newindex` metamethod for `EntityComponentCollider` proxies.
  *
  * @details Handles writes to mutable properties like `active`, `offset`,
- * `draw_debug`, and `map_interaction`.
+ * `draw_debug`, `map_interaction`, `layer`, `mask`, and `static`.
  *
  * @param L Lua state pointer.
  * @return Number of Lua return values.
@@ -472,6 +472,15 @@ static int _entity_component_collider_index(lua_State *L) {
     } else if (strcmp(key, "map_interaction") == 0) {
         lua_pushboolean(L, component->map_interaction);
         return 1;
+    } else if (strcmp(key, "layer") == 0) {
+        lua_pushinteger(L, component->layer);
+        return 1;
+    } else if (strcmp(key, "mask") == 0) {
+        lua_pushinteger(L, component->mask);
+        return 1;
+    } else if (strcmp(key, "static") == 0) {
+        lua_pushboolean(L, component->is_static);
+        return 1;
     } else if (strcmp(key, "toJSON") == 0) {
         lua_pushcfunction(L, _entity_component_collider_tojson_lua);
         return 1;
@@ -535,6 +544,26 @@ static int _entity_component_collider_newindex(lua_State *L) {
         component->map_interaction = lua_toboolean(L, 3);
         lua_pushboolean(L, component->map_interaction);
         return 1;
+    } else if (strcmp(key, "layer") == 0 || strcmp(key, "mask") == 0) {
+        if (!lua_isnumber(L, 3)) {
+            return luaL_error(L, "%s must be a number", key);
+        }
+        lua_Integer bits = lua_tointeger(L, 3);
+        if (bits < 0 || bits > COLLIDER_MASK_ALL) {
+            return luaL_error(L, "%s must be between 0 and 65535", key);
+        }
+        if (key[0] == 'l') {
+            entity_component_collider_set_layer(component, (uint16_t)bits);
+        } else {
+            entity_component_collider_set_mask(component, (uint16_t)bits);
+        }
+        return 0;
+    } else if (strcmp(key, "static") == 0) {
+        if (!lua_isboolean(L, 3)) {
+            return luaL_error(L, "static must be a boolean");
+        }
+        entity_component_collider_set_static(component, lua_toboolean(L, 3));
+        return 0;
     } else if (strcmp(key, "rects") == 0) {
         return luaL_error(L, "rects is not assignable");
     }
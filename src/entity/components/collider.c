@@ -21,6 +21,7 @@
 bool _entity_component_collider_collides_component(EseEntityComponentCollider *colliderA,
                                                    EseEntityComponentCollider *colliderB,
                                                    EseArray *out_hits);
+static void _entity_component_collider_offset_changed(EsePoint *point, void *userdata);
 
 // VTable wrapper functions
 static EseEntityComponent *_collider_vtable_copy(EseEntityComponent *component) {
@@ -76,64 +77,55 @@ bool _entity_component_collider_collides_component(EseEntityComponentCollider *c
 
     profile_start(PROFILE_ENTITY_COMP_COLLIDER_COLLIDES);
 
-    float pos_a_x = ese_point_get_x(colliderA->base.entity->position);
-    float pos_a_y = ese_point_get_y(colliderA->base.entity->position);
-    float pos_b_x = ese_point_get_x(colliderB->base.entity->position);
-    float pos_b_y = ese_point_get_y(colliderB->base.entity->position);
-
-    for (size_t i = 0; i < colliderA->rects_count; i++) {
-        EseRect *rect_a = colliderA->rects[i];
-
-        // Create world-space rect for A
-        EseRect *world_rect_a = ese_rect_create(colliderA->base.lua);
-        ese_rect_set_x(world_rect_a,
-                       ese_rect_get_x(rect_a) + ese_point_get_x(colliderA->offset) + pos_a_x);
-        ese_rect_set_y(world_rect_a,
-                       ese_rect_get_y(rect_a) + ese_point_get_y(colliderA->offset) + pos_a_y);
-        ese_rect_set_width(world_rect_a, ese_rect_get_width(rect_a));
-        ese_rect_set_height(world_rect_a, ese_rect_get_height(rect_a));
-        ese_rect_set_rotation(world_rect_a, ese_rect_get_rotation(rect_a));
-
-        for (size_t j = 0; j < colliderB->rects_count; j++) {
-            EseRect *rect_b = colliderB->rects[j];
-
-            // Create world-space rect for B
-            EseRect *world_rect_b = ese_rect_create(colliderB->base.lua);
-            ese_rect_set_x(world_rect_b,
-                           ese_rect_get_x(rect_b) + ese_point_get_x(colliderB->offset) + pos_b_x);
-            ese_rect_set_y(world_rect_b,
-                           ese_rect_get_y(rect_b) + ese_point_get_y(colliderB->offset) + pos_b_y);
-            ese_rect_set_width(world_rect_b, ese_rect_get_width(rect_b));
-            ese_rect_set_height(world_rect_b, ese_rect_get_height(rect_b));
-            ese_rect_set_rotation(world_rect_b, ese_rect_get_rotation(rect_b));
-
-            // Use proper rotated rectangle intersection test
-            if (ese_rect_intersects(world_rect_a, world_rect_b)) {
-                profile_count_add("collider_pair_rect_tests_hit");
-                EseCollisionHit *hit = ese_collision_hit_create(colliderA->base.entity->lua);
-                ese_collision_hit_set_kind(hit, COLLISION_KIND_COLLIDER);
-                ese_collision_hit_set_entity(hit, colliderA->base.entity);
-                ese_collision_hit_set_target(hit, colliderB->base.entity);
-                ese_collision_hit_set_state(hit, COLLISION_STATE_STAY);
-                ese_collision_hit_set_rect(hit, colliderB->rects[j]);
-                array_push(out_hits, hit);
-                ese_rect_destroy(world_rect_b);
-                ese_rect_destroy(world_rect_a);
-                profile_stop(PROFILE_ENTITY_COMP_COLLIDER_COLLIDES,
-                             "entity_comp_collider_collides_comp");
-                return true;
-            }
-            ese_rect_destroy(world_rect_b);
-            profile_count_add("collider_pair_rect_tests_miss");
-        }
-
-        ese_rect_destroy(world_rect_a);
+    size_t rect_b = 0;
+    if (entity_component_collider_test_collider(colliderA, colliderB, &rect_b)) {
+        profile_count_add("collider_pair_rect_tests_hit");
+        array_push(out_hits, entity_component_collider_make_hit(colliderA, colliderB, rect_b));
+        profile_stop(PROFILE_ENTITY_COMP_COLLIDER_COLLIDES, "entity_comp_collider_collides_comp");
+        return true;
     }
 
+    profile_count_add("collider_pair_rect_tests_miss");
     profile_stop(PROFILE_ENTITY_COMP_COLLIDER_COLLIDES, "entity_comp_collider_collides_comp");
     return false;
 }
 
+bool entity_component_collider_test_collider(const EseEntityComponentCollider *colliderA,
+                                             const EseEntityComponentCollider *colliderB,
+                                             size_t *out_rect_b) {
+    log_assert("ENTITY_COMP", colliderA,
+               "entity_component_collider_test_collider called with NULL collider");
+    log_assert("ENTITY_COMP", colliderB,
+               "entity_component_collider_test_collider called with NULL collider");
+
+    for (size_t i = 0; i < colliderA->shapes.count; i++) {
+        if (collision_shape_set_first_overlap(&colliderB->shapes, &colliderA->shapes.shapes[i],
+                                              out_rect_b)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+EseCollisionHit *entity_component_collider_make_hit(EseEntityComponentCollider *colliderA,
+                                                    EseEntityComponentCollider *colliderB,
+                                                    size_t rect_b) {
+    log_assert("ENTITY_COMP", colliderA,
+               "entity_component_collider_make_hit called with NULL collider");
+    log_assert("ENTITY_COMP", colliderB,
+               "entity_component_collider_make_hit called with NULL collider");
+    log_assert("ENTITY_COMP", rect_b < colliderB->rects_count,
+               "entity_component_collider_make_hit rect index out of range");
+
+    EseCollisionHit *hit = ese_collision_hit_create(colliderA->base.entity->lua);
+    ese_collision_hit_set_kind(hit, COLLISION_KIND_COLLIDER);
+    ese_collision_hit_set_entity(hit, colliderA->base.entity);
+    ese_collision_hit_set_target(hit, colliderB->base.entity);
+    ese_collision_hit_set_state(hit, COLLISION_STATE_STAY);
+    ese_collision_hit_set_rect(hit, colliderB->rects[rect_b]);
+    return hit;
+}
+
 EseEntityComponent *entity_component_collider_make(EseLuaEngine *engine) {
     EseEntityComponentCollider *component =
         memory_manager.malloc(sizeof(EseEntityComponentCollider), MMTAG_ENTITY);
@@ -154,6 +146,13 @@ EseEntityComponent *entity_component_collider_make(EseLuaEngine *engine) {
     component->rects_count = 0;
     component->draw_debug = false;
     component->map_interaction = false;
+    component->layer = COLLIDER_LAYER_DEFAULT;
+    component->mask = COLLIDER_MASK_ALL;
+    component->is_static = false;
+    collision_shape_set_init(&component->shapes);
+
+    // Offset changes move every shape
+    ese_point_add_watcher(component->offset, _entity_component_collider_offset_changed, component);
 
     return &component->base;
 }
@@ -186,6 +185,8 @@ EseEntityComponent *entity_component_collider_copy(const EseEntityComponentColli
 
     copy->offset = ese_point_copy(src->offset);
     ese_point_ref(copy->offset);
+    ese_point_add_watcher(copy->offset, _entity_component_collider_offset_changed, copy);
+    collision_shape_set_init(&copy->shapes);
 
     // Copy rects
     copy->rects = memory_manager.malloc(sizeof(EseRect *) * src->rects_capacity, MMTAG_ENTITY);
@@ -193,11 +194,17 @@ EseEntityComponent *entity_component_collider_copy(const EseEntityComponentColli
     copy->rects_count = src->rects_count;
     copy->draw_debug = src->draw_debug;
     copy->map_interaction = src->map_interaction;
+    copy->layer = src->layer;
+    copy->mask = src->mask;
+    copy->is_static = src->is_static;
 
     for (size_t i = 0; i < copy->rects_count; ++i) {
         EseRect *src_comp = src->rects[i];
         EseRect *dst_comp = ese_rect_copy(src_comp);
         copy->rects[i] = dst_comp;
+        // Same ownership and watcher as rects_add so the cached shapes follow edits
+        ese_rect_ref(dst_comp);
+        ese_rect_add_watcher(dst_comp, entity_component_collider_rect_changed, copy);
     }
 
     return &copy->base;
@@ -212,7 +219,10 @@ static void _entity_component_collider_cleanup(EseEntityComponentCollider *compo
         ese_rect_destroy(component->rects[i]);
     }
     memory_manager.free(component->rects);
+    collision_shape_set_free(&component->shapes);
 
+    ese_point_remove_watcher(component->offset, _entity_component_collider_offset_changed,
+                             component);
     ese_point_unref(component->offset);
     ese_point_destroy(component->offset);
 
@@ -295,7 +305,10 @@ cJSON *entity_component_collider_serialize(const EseEntityComponentCollider *com
     if (!cJSON_AddStringToObject(json, "type", "ENTITY_COMPONENT_COLLIDER") ||
         !cJSON_AddBoolToObject(json, "active", component->base.active) ||
         !cJSON_AddBoolToObject(json, "draw_debug", component->draw_debug) ||
-        !cJSON_AddBoolToObject(json, "map_interaction", component->map_interaction)) {
+        !cJSON_AddBoolToObject(json, "map_interaction", component->map_interaction) ||
+        !cJSON_AddNumberToObject(json, "layer", (double)component->layer) ||
+        !cJSON_AddNumberToObject(json, "mask", (double)component->mask) ||
+        !cJSON_AddBoolToObject(json, "static", component->is_static)) {
         log_error("ENTITY_COMP", "Collider serialize: failed to add fields");
         cJSON_Delete(json);
         return NULL;
@@ -344,6 +357,9 @@ EseEntityComponent *entity_component_collider_deserialize(EseLuaEngine *engine,
     const cJSON *active_item = cJSON_GetObjectItemCaseSensitive(data, "active");
     const cJSON *draw_item = cJSON_GetObjectItemCaseSensitive(data, "draw_debug");
     const cJSON *map_item = cJSON_GetObjectItemCaseSensitive(data, "map_interaction");
+    const cJSON *layer_item = cJSON_GetObjectItemCaseSensitive(data, "layer");
+    const cJSON *mask_item = cJSON_GetObjectItemCaseSensitive(data, "mask");
+    const cJSON *static_item = cJSON_GetObjectItemCaseSensitive(data, "static");
     const cJSON *offset_item = cJSON_GetObjectItemCaseSensitive(data, "offset");
     const cJSON *off_x = offset_item ? cJSON_GetObjectItemCaseSensitive(offset_item, "x") : NULL;
     const cJSON *off_y = offset_item ? cJSON_GetObjectItemCaseSensitive(offset_item, "y") : NULL;
@@ -364,6 +380,15 @@ EseEntityComponent *entity_component_collider_deserialize(EseLuaEngine *engine,
     if (cJSON_IsBool(map_item)) {
         coll->map_interaction = cJSON_IsTrue(map_item);
     }
+    if (cJSON_IsNumber(layer_item)) {
+        coll->layer = (uint16_t)layer_item->valuedouble;
+    }
+    if (cJSON_IsNumber(mask_item)) {
+        coll->mask = (uint16_t)mask_item->valuedouble;
+    }
+    if (cJSON_IsBool(static_item)) {
+        coll->is_static = cJSON_IsTrue(static_item);
+    }
     if (off_x && cJSON_IsNumber(off_x) && off_y && cJSON_IsNumber(off_y)) {
         ese_point_set_x(coll->offset, (float)off_x->valuedouble);
         ese_point_set_y(coll->offset, (float)off_y->valuedouble);
@@ -395,6 +420,14 @@ void entity_component_collider_rects_add(EseEntityComponentCollider *collider, E
     entity_component_collider_update_bounds(collider);
 }
 
+static void _entity_component_collider_offset_changed(EsePoint *point, void *userdata) {
+    (void)point;
+    EseEntityComponentCollider *collider = (EseEntityComponentCollider *)userdata;
+    if (collider) {
+        entity_component_collider_update_bounds(collider);
+    }
+}
+
 void entity_component_collider_rect_changed(EseRect *rect, void *userdata) {
     EseEntityComponentCollider *collider = (EseEntityComponentCollider *)userdata;
     if (collider) {
@@ -411,6 +444,8 @@ void entity_component_collider_update_bounds(EseEntityComponentCollider *collide
         return;
     }
 
+    collision_shape_set_clear(&collider->shapes);
+
     if (collider->rects_count == 0) {
         // No rects, clear both collision bounds
         if (collider->base.entity->collision_bounds) {
@@ -424,6 +459,10 @@ void entity_component_collider_update_bounds(EseEntityComponentCollider *collide
         return;
     }
 
+    // World offset of the rects; the rects themselves stay local
+    float dx = ese_point_get_x(collider->offset) + _entity_get_x(collider->base.entity);
+    float dy = ese_point_get_y(collider->offset) + _entity_get_y(collider->base.entity);
+
     // Compute bounds from all rects in this collider (relative to entity)
     float min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
 
@@ -432,6 +471,10 @@ void entity_component_collider_update_bounds(EseEntityComponentCollider *collide
         if (!r)
             continue;
 
+        EseCollisionShape shape;
+        collision_shape_from_rect(&shape, r, dx, dy);
+        collision_shape_set_push(&collider->shapes, &shape);
+
         // Get rect properties
         float rx = ese_rect_get_x(r) + ese_point_get_x(collider->offset);
         float ry = ese_rect_get_y(r) + ese_point_get_y(collider->offset);
@@ -505,8 +548,8 @@ void entity_component_collider_update_bounds(EseEntityComponentCollider *collide
     }
 
     EseRect *world_bounds = collider->base.entity->collision_world_bounds;
-    ese_rect_set_x(world_bounds, min_x + ese_point_get_x(collider->base.entity->position));
-    ese_rect_set_y(world_bounds, min_y + ese_point_get_y(collider->base.entity->position));
+    ese_rect_set_x(world_bounds, min_x + _entity_get_x(collider->base.entity));
+    ese_rect_set_y(world_bounds, min_y + _entity_get_y(collider->base.entity));
     ese_rect_set_width(world_bounds, max_x - min_x);
     ese_rect_set_height(world_bounds, max_y - min_y);
     ese_rect_set_rotation(world_bounds,
@@ -558,3 +601,61 @@ void entity_component_collider_set_map_interaction(EseEntityComponentCollider *c
                "collider");
     collider->map_interaction = enabled;
 }
+
+void entity_component_collider_sync_entity(EseEntity *entity,
+                                           const EseEntityComponentCollider *removed) {
+    log_assert("ENTITY_COMP", entity,
+               "entity_component_collider_sync_entity called with NULL entity");
+
+    uint16_t layer = 0;
+    uint16_t mask = 0;
+    bool is_static = true;
+    bool found = false;
+    for (size_t i = 0; i < entity->component_count; i++) {
+        EseEntityComponent *comp = entity->components[i];
+        if (comp->type != ENTITY_COMPONENT_COLLIDER || comp->data == removed) {
+            continue;
+        }
+        const EseEntityComponentCollider *collider = (const EseEntityComponentCollider *)comp->data;
+        layer |= collider->layer;
+        mask |= collider->mask;
+        is_static = is_static && collider->is_static;
+        found = true;
+    }
+
+    entity->collision_filter = found ? COLLISION_FILTER_PACK(layer, mask) : COLLISION_FILTER_ALL;
+    entity->collision_static = found && is_static;
+}
+
+static void _entity_component_collider_sync_filter(EseEntityComponentCollider *collider) {
+    if (collider->base.entity) {
+        entity_component_collider_sync_entity(collider->base.entity, NULL);
+    }
+}
+
+void entity_component_collider_set_layer(EseEntityComponentCollider *collider, uint16_t layer) {
+    log_assert("ENTITY_COMP", collider,
+               "entity_component_collider_set_layer called with NULL collider");
+    collider->layer = layer;
+    _entity_component_collider_sync_filter(collider);
+}
+
+void entity_component_collider_set_mask(EseEntityComponentCollider *collider, uint16_t mask) {
+    log_assert("ENTITY_COMP", collider,
+               "entity_component_collider_set_mask called with NULL collider");
+    collider->mask = mask;
+    _entity_component_collider_sync_filter(collider);
+}
+
+void entity_component_collider_set_static(EseEntityComponentCollider *collider, bool is_static) {
+    log_assert("ENTITY_COMP", collider,
+               "entity_component_collider_set_static called with NULL collider");
+    collider->is_static = is_static;
+    _entity_component_collider_sync_filter(collider);
+}
+
+bool entity_component_collider_get_static(const EseEntityComponentCollider *collider) {
+    log_assert("ENTITY_COMP", collider,
+               "entity_component_collider_get_static called with NULL collider");
+    return collider->is_static;
+}
@@ -10,18 +10,31 @@
 #define ESE_ENTITY_COMPONENT_COLLIDER_H
 
 #include "entity/components/entity_component_private.h" // EseEntityComponent
+#include "utility/collision_shape.h"
 #include "vendor/json/cJSON.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 #define ENTITY_COMPONENT_COLLIDER_PROXY_META "EntityComponentColliderProxyMeta"
 
+// Collision layers: a collider sits on the layers in `layer` and only collides
+// with colliders whose layer intersects its `mask`, and vice versa
+#define COLLIDER_LAYER_DEFAULT 0x0001u
+#define COLLIDER_MASK_ALL 0xFFFFu
+
+// Entity collision filter word, layer in the low 16 bits and mask in the high
+// 16 bits. Entities without a collider (maps) use COLLISION_FILTER_ALL.
+#define COLLISION_FILTER_ALL 0xFFFFFFFFu
+#define COLLISION_FILTER_PACK(layer, mask) ((((uint32_t)(mask)) << 16) | (uint32_t)(layer))
+
 // Forward declarations
 typedef struct EseSprite EseSprite;
 typedef struct EseEntity EseEntity;
 typedef struct EseLuaEngine EseLuaEngine;
 typedef struct EseRect EseRect;
 typedef struct EsePoint EsePoint;
+typedef struct EseCollisionHit EseCollisionHit;
 
 /**
  * @brief Component that provides collision detection capabilities to an entity.
@@ -29,6 +42,8 @@ typedef struct EsePoint EsePoint;
  * @details This component manages one or more collision rectangles for complex
  *          collision shapes. It stores an array of collision rectangles plus an
  *          offset, and maintains flags for debug drawing and map interaction.
+ *          World-space copies of the rects are cached in @c shapes and rebuilt
+ *          whenever the rects, the offset or the entity position change.
  */
 typedef struct EseEntityComponentCollider {
     EseEntityComponent base; /** Base component structure */
@@ -39,6 +54,11 @@ typedef struct EseEntityComponentCollider {
     size_t rects_capacity; /** Allocated capacity for rectangles array */
     bool draw_debug;       /** Whether to draw debug visualization of colliders */
     bool map_interaction;  /** Whether to interact with the map */
+    uint16_t layer;        /** Collision layers this collider is on */
+    uint16_t mask;         /** Collision layers this collider collides with */
+    bool is_static;        /** Never moves; pairs with other resting bodies are not retested */
+
+    EseCollisionShapeSet shapes; /** World-space rects, one per entry of rects */
 } EseEntityComponentCollider;
 
 /**
@@ -136,7 +156,8 @@ void entity_component_collider_rect_changed(EseRect *rect, void *userdata);
  * @brief Recompute entity-relative and world-space collision bounds.
  *
  * When there are no rects, this clears existing bounds. Otherwise, it computes
- * an axis-aligned bounding box that encloses all collider rects.
+ * an axis-aligned bounding box that encloses all collider rects and rebuilds
+ * the cached world-space shapes.
  *
  * @param collider Collider component whose bounds should be updated.
  */
@@ -194,4 +215,103 @@ bool entity_component_collider_get_map_interaction(EseEntityComponentCollider *c
 void entity_component_collider_set_map_interaction(EseEntityComponentCollider *collider,
                                                    bool enabled);
 
+/**
+ * @brief Recompute an entity's cached collision filter and static flag from its colliders.
+ *
+ * The filter is the union of every collider's layer and of every collider's
+ * mask, and the entity is static only while all of its colliders are. An
+ * entity without colliders gets COLLISION_FILTER_ALL and is not static.
+ *
+ * @param entity  Entity to refresh.
+ * @param removed Collider being removed that should be ignored, or NULL.
+ */
+void entity_component_collider_sync_entity(EseEntity *entity,
+                                           const EseEntityComponentCollider *removed);
+
+/**
+ * @brief Set the collision layers this collider is on.
+ *
+ * Also refreshes the owning entity's cached collision filter.
+ *
+ * @param collider Collider component to modify.
+ * @param layer    Layer bits.
+ */
+void entity_component_collider_set_layer(EseEntityComponentCollider *collider, uint16_t layer);
+
+/**
+ * @brief Set the collision layers this collider collides with.
+ *
+ * Also refreshes the owning entity's cached collision filter.
+ *
+ * @param collider Collider component to modify.
+ * @param mask     Mask bits.
+ */
+void entity_component_collider_set_mask(EseEntityComponentCollider *collider, uint16_t mask);
+
+/**
+ * @brief Mark the collider as static geometry.
+ *
+ * Static colliders rest as soon as a frame passes without them moving, instead
+ * of waiting out the sleep delay of dynamic ones, and the broadphase never
+ * pairs two resting bodies. A static collider that is moved anyway is simply
+ * retested for that frame. Also refreshes the owning entity's cached flag.
+ *
+ * @param collider  Collider component to modify.
+ * @param is_static Whether the collider is static.
+ */
+void entity_component_collider_set_static(EseEntityComponentCollider *collider, bool is_static);
+
+/**
+ * @brief Get whether the collider is static geometry.
+ *
+ * @param collider Collider component to query.
+ * @return true if the collider is static.
+ */
+bool entity_component_collider_get_static(const EseEntityComponentCollider *collider);
+
+/**
+ * @brief Check whether two entity collision filters allow a collision.
+ *
+ * Rotating one word by 16 bits lines each layer up with the other mask, so a
+ * single AND tests both directions.
+ *
+ * @return true if each side's layer intersects the other side's mask.
+ */
+static inline bool collision_filter_accepts(uint32_t a, uint32_t b) {
+    uint32_t both = a & ((b << 16) | (b >> 16));
+    return (both & 0xFFFFu) && (both >> 16);
+}
+
+/**
+ * @brief Test two colliders against each other without allocating.
+ *
+ * Every cached shape of @p colliderA is tested against the shapes of
+ * @p colliderB in world space. Only reads component state, so it may run on a
+ * worker thread while the entities are not being modified.
+ *
+ * @param colliderA  First collider.
+ * @param colliderB  Second collider.
+ * @param out_rect_b Optional, receives the index of the first rect of
+ *                   @p colliderB that was hit.
+ * @return true if any pair of rects intersects, false otherwise.
+ */
+bool entity_component_collider_test_collider(const EseEntityComponentCollider *colliderA,
+                                             const EseEntityComponentCollider *colliderB,
+                                             size_t *out_rect_b);
+
+/**
+ * @brief Build the collider-vs-collider hit reported for a positive test.
+ *
+ * Must be called on the main thread; the hit is allocated with the current
+ * thread's memory manager and bound to the Lua engine.
+ *
+ * @param colliderA Collider reported as the hit entity.
+ * @param colliderB Collider reported as the target.
+ * @param rect_b    Index of the @p colliderB rect that was hit.
+ * @return New EseCollisionHit in the STAY state, owned by the caller.
+ */
+EseCollisionHit *entity_component_collider_make_hit(EseEntityComponentCollider *colliderA,
+                                                    EseEntityComponentCollider *colliderB,
+                                                    size_t rect_b);
+
 #endif // ESE_ENTITY_COMPONENT_COLLIDER_H
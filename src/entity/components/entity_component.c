@@ -43,6 +43,10 @@ EseEntityComponent *entity_component_copy(EseEntityComponent *component) {
     profile_start(PROFILE_ENTITY_COMPONENT_COPY);
 
     EseEntityComponent *result = component->vtable->copy(component);
+    if (result) {
+        // The copy is tracked by no system until it is added
+        memset(result->system_index, 0, sizeof(result->system_index));
+    }
 
     profile_stop(PROFILE_ENTITY_COMPONENT_COPY, "entity_component_copy");
     profile_count_add("entity_comp_copy_count");
@@ -127,9 +131,9 @@ bool entity_component_detect_collision_rect(EseEntityComponent *component, EseRe
         EseRect *colliderRect = collider->rects[i];
         EseRect *worldRect = ese_rect_copy(colliderRect);
         ese_rect_set_x(worldRect,
-                       ese_rect_get_x(worldRect) + ese_point_get_x(component->entity->position));
+                       ese_rect_get_x(worldRect) + _entity_get_x(component->entity));
         ese_rect_set_y(worldRect,
-                       ese_rect_get_y(worldRect) + ese_point_get_y(component->entity->position));
+                       ese_rect_get_y(worldRect) + _entity_get_y(component->entity));
         if (ese_rect_intersects(worldRect, rect)) {
             ese_rect_destroy(worldRect);
             profile_stop(PROFILE_ENTITY_COLLISION_RECT_DETECT, "entity_component_detect_coll_rect");
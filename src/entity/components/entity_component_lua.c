@@ -13,8 +13,9 @@
 #include <string.h>
 
 // Standard entity function names
-static const char *STANDARD_FUNCTIONS[] = {"entity_init", "entity_update", "entity_collision_enter",
-                                           "entity_collision_stay", "entity_collision_exit"};
+static const char *STANDARD_FUNCTIONS[] = {"entity_init",           "entity_update",
+                                           "entity_collision_enter", "entity_collision_stay",
+                                           "entity_collision_exit",  "entity_collisions"};
 static const size_t STANDARD_FUNCTIONS_COUNT =
     sizeof(STANDARD_FUNCTIONS) / sizeof(STANDARD_FUNCTIONS[0]);
 
@@ -131,6 +132,9 @@ static EseEntityComponent *_entity_component_lua_make(EseLuaEngine *engine, cons
     component->arg = lua_value_create_number("argument count", 0);
     component->props = NULL;
     component->props_count = 0;
+    component->pending_dt = 0.0f;
+    component->update_seq = 0;
+    component->update_overdue = false;
 
     // No free function needed for CachedLuaFunction
     component->function_cache = hashmap_create(NULL);
@@ -456,6 +460,20 @@ void _entity_component_lua_clear_cache(EseEntityComponentLua *component) {
     hashmap_clear(component->function_cache);
 }
 
+bool entity_component_lua_has_function(EseEntityComponentLua *component, const char *func_name) {
+    log_assert("ENTITY_COMP", component,
+               "entity_component_lua_has_function called with NULL component");
+    log_assert("ENTITY_COMP", func_name,
+               "entity_component_lua_has_function called with NULL func_name");
+
+    if (!component->function_cache) {
+        return false;
+    }
+
+    CachedLuaFunction *cached = hashmap_get(component->function_cache, func_name);
+    return cached && cached->exists;
+}
+
 bool entity_component_lua_run(EseEntityComponentLua *component, EseEntity *entity,
                               const char *func_name, int argc, EseLuaValue *argv[]) {
     log_assert("ENTITY_COMP", component, "entity_component_lua_run called with NULL component");
@@ -34,6 +34,11 @@ typedef struct EseEntityComponentLua {
     size_t props_count;  /** Number of properties in the array */
 
     EseHashMap *function_cache; /** Cache of function references for performance */
+
+    // Lua system update throttling, see EseEntityUpdateMode
+    float pending_dt;    /** Delta time skipped since the last entity_update, capped at 1s */
+    uint32_t update_seq; /** Spreads ENTITY_UPDATE_INTERVAL updates over the interval */
+    bool update_overdue; /** Due but deferred by the engine update budget */
 } EseEntityComponentLua;
 
 EseEntityComponent *_entity_component_lua_copy(const EseEntityComponentLua *src);
@@ -73,12 +78,27 @@ EseEntityComponent *entity_component_lua_create(EseLuaEngine *engine, const char
 bool entity_component_lua_run(EseEntityComponentLua *component, EseEntity *entity,
                               const char *func_name, int argc, EseLuaValue *argv[]);
 
+/**
+ * @brief Checks whether the component's script defines a function.
+ *
+ * @details Only consults the function cache, so it never touches Lua. The
+ * standard functions are cached once the script instance exists; before that,
+ * and for functions never run, this returns false.
+ *
+ * @param component Pointer to the EntityComponentLua component.
+ * @param func_name Name of the function.
+ *
+ * @return true if the function is cached and exists.
+ */
+bool entity_component_lua_has_function(EseEntityComponentLua *component, const char *func_name);
+
 /**
  * @brief Populates the function cache with standard entity lifecycle functions.
  *
  * @details Caches the standard entity functions (entity_init, entity_update,
  *          entity_collision_enter, entity_collision_stay,
- * entity_collision_exit). Functions that don't exist are cached as LUA_NOREF.
+ * entity_collision_exit, entity_collisions). Functions that don't exist are
+ * cached as LUA_NOREF.
  *
  * @param component Pointer to the EntityComponentLua component.
  */
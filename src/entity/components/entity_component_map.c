@@ -117,6 +117,7 @@ static EseEntityComponent *_entity_component_map_make(EseLuaEngine *engine) {
     component->map = NULL;
     component->size = 128;
     component->seed = 1000;
+    component->collision_flags = MAP_CELL_FLAG_SOLID;
 
     // Lua Script
     component->script = NULL;
@@ -134,6 +135,7 @@ static EseEntityComponent *_entity_component_map_make(EseLuaEngine *engine) {
     component->sprite_frames = NULL;
     component->show_layer = NULL;
     component->show_layer_count = 0;
+    component->revision = 0;
 
     return &component->base;
 }
@@ -164,9 +166,13 @@ EseEntityComponent *_entity_component_map_copy(const EseEntityComponentMap *src)
     ese_point_set_y(copy->position, ese_point_get_y(src->position));
     copy->size = src->size;
     copy->seed = src->seed;
+    copy->collision_flags = src->collision_flags;
+
+    copy->revision = 0;
 
     if (copy->map) {
         ese_map_ref(copy->map);
+        ese_map_add_watcher(copy->map, _entity_component_map_changed, copy);
         size_t cells = ese_map_get_width(copy->map) * ese_map_get_height(copy->map);
         copy->sprite_frames = memory_manager.malloc(sizeof(int) * cells, MMTAG_COMP_MAP);
         memset(copy->sprite_frames, 0, sizeof(int) * cells);
@@ -289,6 +295,12 @@ cJSON *entity_component_map_serialize(const EseEntityComponentMap *component) {
         return NULL;
     }
 
+    if (!cJSON_AddNumberToObject(json, "collision_flags", (double)component->collision_flags)) {
+        log_error("ENTITY_COMP", "Map serialize: failed to add collision_flags");
+        cJSON_Delete(json);
+        return NULL;
+    }
+
     // Serialize position as embedded object { x, y }
     cJSON *pos = cJSON_CreateObject();
     if (!pos) {
@@ -372,6 +384,9 @@ EseEntityComponent *entity_component_map_deserialize(EseLuaEngine *engine,
         return NULL;
     }
 
+    // Optional; older data predates configurable collision flags
+    const cJSON *flags_item = cJSON_GetObjectItemCaseSensitive(data, "collision_flags");
+
     const cJSON *pos_item = cJSON_GetObjectItemCaseSensitive(data, "position");
     const cJSON *pos_x = pos_item ? cJSON_GetObjectItemCaseSensitive(pos_item, "x") : NULL;
     const cJSON *pos_y = pos_item ? cJSON_GetObjectItemCaseSensitive(pos_item, "y") : NULL;
@@ -398,6 +413,9 @@ EseEntityComponent *entity_component_map_deserialize(EseLuaEngine *engine,
 
     map->size = (int)size_item->valuedouble;
     map->seed = (uint32_t)seed_item->valuedouble;
+    if (cJSON_IsNumber(flags_item)) {
+        map->collision_flags = (uint32_t)flags_item->valuedouble;
+    }
 
     if (pos_x && cJSON_IsNumber(pos_x) && pos_y && cJSON_IsNumber(pos_y)) {
         ese_point_set_x(map->position, (float)pos_x->valuedouble);
@@ -617,6 +635,9 @@ static int _entity_component_map_index(lua_State *L) {
     } else if (strcmp(key, "seed") == 0) {
         lua_pushnumber(L, component->seed);
         return 1;
+    } else if (strcmp(key, "collision_flags") == 0) {
+        lua_pushnumber(L, component->collision_flags);
+        return 1;
     } else if (strcmp(key, "script") == 0) {
         lua_pushstring(L, component->script ? component->script : "");
         return 1;
@@ -756,6 +777,13 @@ static int _entity_component_map_newindex(lua_State *L) {
         }
         component->seed = new_seed;
         return 0;
+    } else if (strcmp(key, "collision_flags") == 0) {
+        if (!lua_isnumber(L, 3)) {
+            return luaL_error(L, "collision_flags must be a number");
+        }
+
+        component->collision_flags = (uint32_t)lua_tointeger(L, 3);
+        return 0;
     } else if (strcmp(key, "script") == 0) {
         if (!lua_isstring(L, 3) && !lua_isnil(L, 3)) {
             return luaL_error(L, "script must be a string or nil");
@@ -923,6 +951,97 @@ void _entity_component_map_init(EseLuaEngine *engine) {
     lua_engine_new_object(engine, "EntityComponentMap", 1, keys, functions);
 }
 
+/**
+ * @brief Conservative range of cell indices along one axis overlapping [lo, hi].
+ *
+ * @details Cell i starts at origin + i * step (plus a per-row stagger in [0, stagger]) and
+ *          spans extent. The range is widened by one cell on each side to absorb float
+ *          rounding; the exact test happens per cell afterwards.
+ *
+ * @return false if no cell in [0, count) can overlap.
+ */
+static bool _map_axis_range(float lo, float hi, float origin, float step, float extent,
+                            float stagger, int count, int *out_first, int *out_last) {
+    if (step <= 0.0f || count <= 0) {
+        return false;
+    }
+
+    float first = floorf((lo - extent - stagger - origin) / step) - 1.0f;
+    float last = floorf((hi - origin) / step) + 1.0f;
+    if (last < 0.0f || first > (float)(count - 1)) {
+        return false;
+    }
+
+    *out_first = first < 0.0f ? 0 : (int)first;
+    *out_last = last > (float)(count - 1) ? count - 1 : (int)last;
+    return true;
+}
+
+/**
+ * @brief Computes the block of map cells whose areas can overlap a world-space box.
+ *
+ * @details Mirrors the layouts in entity_component_map_get_cell_area. Iso cells are
+ *          bounded through their diagonal coordinates (x - y, x + y) and mapped back to
+ *          an x/y block.
+ *
+ * @return false if the box cannot touch any cell.
+ */
+static bool _map_cell_range(const EseEntityComponentMap *component, float x0, float y0, float x1,
+                            float y1, int *out_x0, int *out_y0, int *out_x1, int *out_y1) {
+    const int mw = (int)ese_map_get_width(component->map);
+    const int mh = (int)ese_map_get_height(component->map);
+    const int th = component->size;
+    const float cx = ese_point_get_x(component->position);
+    const float cy = ese_point_get_y(component->position);
+
+    switch (ese_map_get_type(component->map)) {
+    case MAP_TYPE_GRID: {
+        const float size = (float)component->size;
+        float px = _entity_get_x(component->base.entity);
+        float py = _entity_get_y(component->base.entity);
+        return _map_axis_range(x0, x1, px, size, size, 0.0f, mw, out_x0, out_x1) &&
+               _map_axis_range(y0, y1, py, size, size, 0.0f, mh, out_y0, out_y1);
+    }
+    case MAP_TYPE_HEX_POINT_UP: {
+        const float tw = (float)(int)(th * 0.866025f);
+        const float row = th * 0.75f;
+        return _map_axis_range(x0, x1, -cx * tw, tw, tw, tw / 2.0f, mw, out_x0, out_x1) &&
+               _map_axis_range(y0, y1, -cy * row, row, (float)th, 0.0f, mh, out_y0, out_y1);
+    }
+    case MAP_TYPE_HEX_FLAT_UP: {
+        const float tw = (float)(int)(th * 1.154701f);
+        const float col = tw * 0.75f;
+        return _map_axis_range(x0, x1, -cx * col, col, tw, 0.0f, mw, out_x0, out_x1) &&
+               _map_axis_range(y0, y1, -cy * th, (float)th, (float)th, th / 2.0f, mh, out_y0,
+                               out_y1);
+    }
+    case MAP_TYPE_ISO: {
+        if (th <= 0) {
+            return false;
+        }
+        const float tw = (float)(th * 2);
+        // Cell (u, v) relative to the centre starts at ((u - v) * tw/2, (u + v) * th/2)
+        float d_min = 2.0f * x0 / tw - 2.0f, d_max = 2.0f * x1 / tw;
+        float s_min = 2.0f * y0 / th - 2.0f, s_max = 2.0f * y1 / th;
+        float u_min = floorf((s_min + d_min) / 2.0f + cx) - 1.0f;
+        float u_max = floorf((s_max + d_max) / 2.0f + cx) + 1.0f;
+        float v_min = floorf((s_min - d_max) / 2.0f + cy) - 1.0f;
+        float v_max = floorf((s_max - d_min) / 2.0f + cy) + 1.0f;
+        if (u_max < 0.0f || v_max < 0.0f || u_min > (float)(mw - 1) ||
+            v_min > (float)(mh - 1)) {
+            return false;
+        }
+        *out_x0 = u_min < 0.0f ? 0 : (int)u_min;
+        *out_x1 = u_max > (float)(mw - 1) ? mw - 1 : (int)u_max;
+        *out_y0 = v_min < 0.0f ? 0 : (int)v_min;
+        *out_y1 = v_max > (float)(mh - 1) ? mh - 1 : (int)v_max;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
 bool _entity_component_map_collides_component(EseEntityComponentMap *component,
                                               EseEntityComponentCollider *collider,
                                               EseArray *out_hits) {
@@ -961,42 +1080,66 @@ bool _entity_component_map_collides_component(EseEntityComponentMap *component,
         return false;
     }
 
-    // map size
-    size_t mw = ese_map_get_width(component->map);
-    size_t mh = ese_map_get_height(component->map);
+    // Collider rects are placed in the world by the entity position only
+    float pos_x = _entity_get_x(collider->base.entity);
+    float pos_y = _entity_get_y(collider->base.entity);
 
-    EseRect **world_rects =
-        memory_manager.malloc(sizeof(EseRect *) * collider->rects_count, MMTAG_COMP_MAP);
+    // World box around every collider rect; rotated rects use their bounding circle
+    float min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
     for (size_t i = 0; i < collider->rects_count; i++) {
-        world_rects[i] = ese_rect_create(component->base.lua);
-        ese_rect_set_x(world_rects[i], ese_rect_get_x(collider->rects[i]) +
-                                           ese_point_get_x(collider->base.entity->position));
-        ese_rect_set_y(world_rects[i], ese_rect_get_y(collider->rects[i]) +
-                                           ese_point_get_y(collider->base.entity->position));
-        ese_rect_set_width(world_rects[i], ese_rect_get_width(collider->rects[i]));
-        ese_rect_set_height(world_rects[i], ese_rect_get_height(collider->rects[i]));
-        ese_rect_set_rotation(world_rects[i], ese_rect_get_rotation(collider->rects[i]));
+        const EseRect *r = collider->rects[i];
+        float w = ese_rect_get_width(r);
+        float h = ese_rect_get_height(r);
+        float rx = ese_rect_get_x(r) + pos_x;
+        float ry = ese_rect_get_y(r) + pos_y;
+        if (fabsf(ese_rect_get_rotation(r)) < 1e-6f) {
+            min_x = fminf(min_x, rx);
+            min_y = fminf(min_y, ry);
+            max_x = fmaxf(max_x, rx + w);
+            max_y = fmaxf(max_y, ry + h);
+        } else {
+            float radius = sqrtf(w * w + h * h) * 0.5f;
+            float mx = rx + w * 0.5f;
+            float my = ry + h * 0.5f;
+            min_x = fminf(min_x, mx - radius);
+            min_y = fminf(min_y, my - radius);
+            max_x = fmaxf(max_x, mx + radius);
+            max_y = fmaxf(max_y, my + radius);
+        }
+    }
+
+    int x0, y0, x1, y1;
+    if (!_map_cell_range(component, min_x, min_y, max_x, max_y, &x0, &y0, &x1, &y1)) {
+        profile_cancel(PROFILE_ENTITY_COMP_MAP_COLLIDES);
+        profile_count_add("map_collides_early_cell_range_miss");
+        return false;
     }
 
     bool did_hit = false;
-    for (size_t y = 0; y < mh; y++) {
-        for (size_t x = 0; x < mw; x++) {
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
             profile_count_add("map_collides_cell_checked");
             // We don't own the cell, so we don't need to destroy it
             EseMapCell *cell = ese_map_get_cell(component->map, x, y);
-            // cell_rect is in world coords
-            EseRect *cell_rect = entity_component_map_get_cell_rect(component, x, y);
+            if (!cell || !(ese_map_cell_get_flags(cell) & component->collision_flags)) {
+                continue;
+            }
+
+            // Cell area is in world coords
+            float cell_x, cell_y, cell_w, cell_h;
+            entity_component_map_get_cell_area(component, x, y, &cell_x, &cell_y, &cell_w,
+                                               &cell_h);
 
             bool intersect = false;
             for (size_t i = 0; i < collider->rects_count; i++) {
-                if (ese_rect_intersects(world_rects[i], cell_rect)) {
+                if (ese_rect_intersects_area(collider->rects[i], pos_x, pos_y, cell_x, cell_y,
+                                             cell_w, cell_h)) {
                     intersect = true;
                     break;
                 }
             }
-            ese_rect_destroy(cell_rect);
 
-            // Only count cells that are marked solid
+            // Only count cells whose flags match the component's collision flags
             if (intersect) {
                 profile_count_add("map_collides_solid_hits");
                 // hit is owned by the caller's array
@@ -1015,11 +1158,6 @@ bool _entity_component_map_collides_component(EseEntityComponentMap *component,
         }
     }
 
-    for (size_t i = 0; i < collider->rects_count; i++) {
-        ese_rect_destroy(world_rects[i]);
-    }
-    memory_manager.free(world_rects);
-
     profile_stop(PROFILE_ENTITY_COMP_MAP_COLLIDES, "entity_comp_map_collides_comp");
     return did_hit;
 }
@@ -1062,6 +1200,8 @@ static void _entity_component_map_changed(EseMap *map, void *userdata) {
     log_assert("ENTITY_COMP", component,
                "_entity_component_map_changed called with NULL component");
 
+    component->revision++;
+
     size_t new_count = ese_map_get_layer_count(map);
     if (component->show_layer_count != new_count) {
         size_t old_count = component->show_layer_count;
@@ -1080,26 +1220,23 @@ static void _entity_component_map_changed(EseMap *map, void *userdata) {
 // Public helpers
 // ========================================
 
-EseRect *entity_component_map_get_cell_rect(EseEntityComponentMap *component, int x, int y) {
+void entity_component_map_get_cell_area(const EseEntityComponentMap *component, int x, int y,
+                                        float *out_x, float *out_y, float *out_width,
+                                        float *out_height) {
     log_assert("ENTITY_COMP_MAP", component,
-               "entity_component_map_get_cell_rect called with NULL component");
+               "entity_component_map_get_cell_area called with NULL component");
     log_assert("ENTITY_COMP_MAP", component->map,
-               "entity_component_map_get_cell_rect called with NULL map");
-
-    EseLuaEngine *engine = component->base.lua;
-    EseRect *rect = ese_rect_create(engine);
+               "entity_component_map_get_cell_area called with NULL map");
 
+    float rx = 0.0f, ry = 0.0f, rw = 0.0f, rh = 0.0f;
     switch (ese_map_get_type(component->map)) {
     case MAP_TYPE_GRID: {
-        float map_x = ese_point_get_x(component->base.entity->position);
-        float map_y = ese_point_get_y(component->base.entity->position);
-        float rx = x * component->size + map_x;
-        float ry = y * component->size + map_y;
-        ese_rect_set_x(rect, rx);
-        ese_rect_set_y(rect, ry);
-        ese_rect_set_width(rect, (float)component->size);
-        ese_rect_set_height(rect, (float)component->size);
-        ese_rect_set_rotation(rect, 0.0f);
+        float map_x = _entity_get_x(component->base.entity);
+        float map_y = _entity_get_y(component->base.entity);
+        rx = x * component->size + map_x;
+        ry = y * component->size + map_y;
+        rw = (float)component->size;
+        rh = (float)component->size;
         break;
     }
     case MAP_TYPE_HEX_POINT_UP: {
@@ -1107,16 +1244,13 @@ EseRect *entity_component_map_get_cell_rect(EseEntityComponentMap *component, in
         const int tw = (int)(th * 0.866025f);
         float cx = ese_point_get_x(component->position);
         float cy = ese_point_get_y(component->position);
-        float rx = (x - cx) * tw;
-        float ry = (y - cy) * (th * 0.75f);
+        rx = (x - cx) * tw;
+        ry = (y - cy) * (th * 0.75f);
         if ((y % 2) == 1) {
             rx += tw / 2.0f;
         }
-        ese_rect_set_x(rect, rx);
-        ese_rect_set_y(rect, ry);
-        ese_rect_set_width(rect, (float)tw);
-        ese_rect_set_height(rect, (float)th);
-        ese_rect_set_rotation(rect, 0.0f);
+        rw = (float)tw;
+        rh = (float)th;
         break;
     }
     case MAP_TYPE_HEX_FLAT_UP: {
@@ -1124,16 +1258,13 @@ EseRect *entity_component_map_get_cell_rect(EseEntityComponentMap *component, in
         const int tw = (int)(th * 1.154701f);
         float cx = ese_point_get_x(component->position);
         float cy = ese_point_get_y(component->position);
-        float rx = (x - cx) * (tw * 0.75f);
-        float ry = (y - cy) * th;
+        rx = (x - cx) * (tw * 0.75f);
+        ry = (y - cy) * th;
         if ((x % 2) == 1) {
             ry += th / 2.0f;
         }
-        ese_rect_set_x(rect, rx);
-        ese_rect_set_y(rect, ry);
-        ese_rect_set_width(rect, (float)tw);
-        ese_rect_set_height(rect, (float)th);
-        ese_rect_set_rotation(rect, 0.0f);
+        rw = (float)tw;
+        rh = (float)th;
         break;
     }
     case MAP_TYPE_ISO: {
@@ -1141,25 +1272,37 @@ EseRect *entity_component_map_get_cell_rect(EseEntityComponentMap *component, in
         const int tw = th * 2;
         float cx = ese_point_get_x(component->position);
         float cy = ese_point_get_y(component->position);
-        float rx = (x - cx) * (tw / 2.0f) - (y - cy) * (tw / 2.0f);
-        float ry = (x - cx) * (th / 2.0f) + (y - cy) * (th / 2.0f);
-        ese_rect_set_x(rect, rx);
-        ese_rect_set_y(rect, ry);
-        ese_rect_set_width(rect, (float)tw);
-        ese_rect_set_height(rect, (float)th);
-        ese_rect_set_rotation(rect, 0.0f);
+        rx = (x - cx) * (tw / 2.0f) - (y - cy) * (tw / 2.0f);
+        ry = (x - cx) * (th / 2.0f) + (y - cy) * (th / 2.0f);
+        rw = (float)tw;
+        rh = (float)th;
         break;
     }
-    default: {
-        // Unknown type; return zero rect
-        ese_rect_set_x(rect, 0);
-        ese_rect_set_y(rect, 0);
-        ese_rect_set_width(rect, 0);
-        ese_rect_set_height(rect, 0);
-        ese_rect_set_rotation(rect, 0.0f);
+    default:
+        // Unknown type; zero area
         break;
     }
-    }
 
+    *out_x = rx;
+    *out_y = ry;
+    *out_width = rw;
+    *out_height = rh;
+}
+
+EseRect *entity_component_map_get_cell_rect(EseEntityComponentMap *component, int x, int y) {
+    log_assert("ENTITY_COMP_MAP", component,
+               "entity_component_map_get_cell_rect called with NULL component");
+    log_assert("ENTITY_COMP_MAP", component->map,
+               "entity_component_map_get_cell_rect called with NULL map");
+
+    float rx, ry, rw, rh;
+    entity_component_map_get_cell_area(component, x, y, &rx, &ry, &rw, &rh);
+
+    EseRect *rect = ese_rect_create(component->base.lua);
+    ese_rect_set_x(rect, rx);
+    ese_rect_set_y(rect, ry);
+    ese_rect_set_width(rect, rw);
+    ese_rect_set_height(rect, rh);
+    ese_rect_set_rotation(rect, 0.0f);
     return rect;
 }
@@ -26,10 +26,11 @@ typedef struct lua_State lua_State;
 typedef struct EseEntityComponentMap {
     EseEntityComponent base; /** Base component structure */
 
-    EseMap *map;        /** Reference to the map to render (not owned) */
-    EsePoint *position; /** Map cell position to center on */
-    int size;           /** Tile size in pixels */
-    uint32_t seed;      /** Random seed for procedural generation */
+    EseMap *map;              /** Reference to the map to render (not owned) */
+    EsePoint *position;       /** Map cell position to center on */
+    int size;                 /** Tile size in pixels */
+    uint32_t seed;            /** Random seed for procedural generation */
+    uint32_t collision_flags; /** Cell flags that make a cell collidable */
 
     char *script;         /** Filename of the Lua script to execute */
     EseLuaEngine *engine; /** Reference to Lua engine (not owned) */
@@ -43,6 +44,8 @@ typedef struct EseEntityComponentMap {
     bool *show_layer;        /** Array of boolean values to show/hide layers */
     size_t show_layer_count; /** Number of layers to show */
     int *sprite_frames;      /** Array of sprite frame indices for tiles */
+    uint32_t revision;       /** Bumped whenever the map's cells change; bump it after changing
+                                sprite_frames so cached chunk meshes are rebuilt */
 } EseEntityComponentMap;
 
 EseEntityComponent *_entity_component_map_copy(const EseEntityComponentMap *src);
@@ -67,4 +70,14 @@ EseEntityComponent *entity_component_map_create(EseLuaEngine *engine);
 
 EseRect *entity_component_map_get_cell_rect(EseEntityComponentMap *comp, int x, int y);
 
+/**
+ * @brief Gets the world-space area of a map cell without allocating.
+ *
+ * @details Same geometry as entity_component_map_get_cell_rect, returned as plain floats so
+ *          hot paths such as map collision can test cells without creating an EseRect.
+ */
+void entity_component_map_get_cell_area(const EseEntityComponentMap *comp, int x, int y,
+                                        float *out_x, float *out_y, float *out_width,
+                                        float *out_height);
+
 #endif // ESE_ENTITY_COMPONENT_MAP_H
@@ -5,6 +5,7 @@
 #include "utility/array.h"
 #include "vendor/json/cJSON.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 // Forward declarations
 typedef struct EseEntity EseEntity;
@@ -21,8 +22,16 @@ typedef enum {
     ENTITY_COMPONENT_SOUND,
     ENTITY_COMPONENT_MUSIC,
     ENTITY_COMPONENT_LISTENER,
+    ENTITY_COMPONENT_TYPE_COUNT, /** Number of component types, not a type */
 } EntityComponentType;
 
+// Bit of a component type in entity and system component masks
+#define ENTITY_COMPONENT_BIT(type) (1u << (type))
+#define ENTITY_COMPONENT_MASK_ALL (ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_TYPE_COUNT) - 1u)
+
+// Most systems that can track one component type at the same time
+#define ENTITY_COMPONENT_MAX_SYSTEMS 8
+
 /**
  * @brief Virtual function table for component operations.
  *
@@ -60,6 +69,9 @@ typedef struct EseEntityComponent {
     EseLuaEngine *lua; /** EseLuaEngine this component belongs to */
     int lua_ref;       /** Lua registry reference to its own userdata */
     int lua_ref_count; /** Reference count for Lua userdata */
+
+    /** Index in each tracking system's array, by the system's slot for this type */
+    uint32_t system_index[ENTITY_COMPONENT_MAX_SYSTEMS];
 } EseEntityComponent;
 
 #endif // ESE_ENTITY_COMPONENTS_PRIVATE_H
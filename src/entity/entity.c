@@ -6,9 +6,11 @@
 #include "core/pubsub.h"
 #include "core/system_manager.h"
 #include "entity/components/collider.h"
+#include "entity/components/entity_component_lua.h"
 #include "entity/components/entity_component_private.h"
 #include "entity/entity_lua.h"
 #include "entity/entity_private.h"
+#include "entity/entity_tag.h"
 #include "scripting/lua_engine.h"
 #include "vendor/json/cJSON.h"
 #include "scripting/lua_value.h"
@@ -48,15 +50,20 @@ EseEntity *entity_copy(EseEntity *entity) {
 
     // Copy all fields
     copy->active = entity->active;
-    ese_point_set_x(copy->position, ese_point_get_x(entity->position));
-    ese_point_set_y(copy->position, ese_point_get_y(entity->position));
+    entity_set_position(copy, _entity_get_x(entity), _entity_get_y(entity));
     copy->draw_order = entity->draw_order;
+    copy->update_mode = entity->update_mode;
+    copy->update_interval = entity->update_interval;
+    copy->update_distance = entity->update_distance;
+    copy->collision_filter = entity->collision_filter;
+    copy->collision_static = entity->collision_static;
 
     // Copy components
     copy->components = memory_manager.malloc(
         sizeof(EseEntityComponent *) * entity->component_capacity, MMTAG_ENTITY);
     copy->component_capacity = entity->component_capacity;
     copy->component_count = entity->component_count;
+    copy->component_mask = entity->component_mask;
 
     for (size_t i = 0; i < entity->component_count; ++i) {
         EseEntityComponent *src_comp = entity->components[i];
@@ -64,14 +71,16 @@ EseEntity *entity_copy(EseEntity *entity) {
         copy->components[i] = dst_comp;
     }
 
-    // Copy tags
+    // Copy tags; the copy is in no engine tag set yet
     if (entity->tag_count > 0) {
-        copy->tags = memory_manager.malloc(sizeof(char *) * entity->tag_capacity, MMTAG_ENTITY);
+        copy->tags =
+            memory_manager.malloc(sizeof(EseEntityTag) * entity->tag_capacity, MMTAG_ENTITY);
         copy->tag_capacity = entity->tag_capacity;
         copy->tag_count = entity->tag_count;
 
         for (size_t i = 0; i < entity->tag_count; ++i) {
-            copy->tags[i] = memory_manager.strdup(entity->tags[i], MMTAG_ENTITY);
+            copy->tags[i].id = entity->tags[i].id;
+            copy->tags[i].set_index = ENTITY_TAG_NO_SET;
         }
     } else {
         copy->tags = NULL;
@@ -88,13 +97,15 @@ EseEntity *entity_copy(EseEntity *entity) {
                               : NULL;
 
     // Apply copied default_props to the new entity's Lua __data table
-    EseDListIter *iter = dlist_iter_create(copy->default_props);
-    void *value_ptr;
-    while (dlist_iter_next(iter, &value_ptr)) {
-        EseLuaValue *value = (EseLuaValue *)value_ptr;
-        _entity_lua_to_data(copy, value);
+    if (copy->default_props) {
+        EseDListIter *iter = dlist_iter_create(copy->default_props);
+        void *value_ptr;
+        while (dlist_iter_next(iter, &value_ptr)) {
+            EseLuaValue *value = (EseLuaValue *)value_ptr;
+            _entity_lua_to_data(copy, value);
+        }
+        dlist_iter_free(iter);
     }
-    dlist_iter_free(iter);
 
     profile_stop(PROFILE_ENTITY_COPY, "entity_copy");
     profile_count_add("entity_copy_count");
@@ -103,6 +114,9 @@ EseEntity *entity_copy(EseEntity *entity) {
 
 static void _entity_cleanup(EseEntity *entity) {
     // Note: assumes Lua registry ref is already cleared or was never set
+
+    // An entity destroyed without engine_remove_entity still owns its slot
+    _entity_detach_transform(entity);
     ese_uuid_unref(entity->id);
     ese_uuid_destroy(entity->id);
     ese_point_unref(entity->position);
@@ -131,9 +145,12 @@ static void _entity_cleanup(EseEntity *entity) {
     }
     memory_manager.free(entity->components);
 
-    // Clean up tags
+    // Clean up tags; an entity destroyed without engine_remove_entity may
+    // still be in the engine's tag sets
     for (size_t i = 0; i < entity->tag_count; ++i) {
-        memory_manager.free(entity->tags[i]);
+        if (engine && entity->tags[i].set_index != ENTITY_TAG_NO_SET) {
+            engine_notify_tag_rem(engine, entity, i);
+        }
     }
     memory_manager.free(entity->tags);
 
@@ -175,7 +192,15 @@ void entity_destroy(EseEntity *entity) {
     if (entity->lua_ref != LUA_NOREF && entity->lua_ref_count > 0) {
         entity->lua_ref_count--;
         if (entity->lua_ref_count == 0) {
-            luaL_unref(entity->lua->runtime, LUA_REGISTRYINDEX, entity->lua_ref);
+            // Lua variables may outlive the entity; point the proxy at nothing
+            lua_State *L = entity->lua->runtime;
+            lua_rawgeti(L, LUA_REGISTRYINDEX, entity->lua_ref);
+            EseEntity **ud = (EseEntity **)luaL_testudata(L, -1, "EntityProxyMeta");
+            if (ud) {
+                *ud = NULL;
+            }
+            lua_pop(L, 1);
+            luaL_unref(L, LUA_REGISTRYINDEX, entity->lua_ref);
             entity->lua_ref = LUA_NOREF;
             _entity_cleanup(entity);
         } else {
@@ -189,13 +214,13 @@ void entity_destroy(EseEntity *entity) {
     }
 }
 
-void entity_set_position(EseEntity *entity, float x, float y) {
-    log_assert("ENTITY", entity, "entity_set_position called with NULL entity");
-
-    ese_point_set_x(entity->position, x);
-    ese_point_set_y(entity->position, y);
-
-    // Update collision bounds for all collider components
+/**
+ * @brief Updates collider bounds and shapes for the current position.
+ */
+static void _entity_refresh_colliders(EseEntity *entity) {
+    if (!(entity->component_mask & ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_COLLIDER))) {
+        return;
+    }
     for (size_t i = 0; i < entity->component_count; i++) {
         EseEntityComponent *comp = entity->components[i];
         if (comp->active && comp->type == ENTITY_COMPONENT_COLLIDER) {
@@ -204,8 +229,72 @@ void entity_set_position(EseEntity *entity, float x, float y) {
     }
 }
 
+void entity_set_position(EseEntity *entity, float x, float y) {
+    log_assert("ENTITY", entity, "entity_set_position called with NULL entity");
+
+    if (entity->transforms) {
+        // Colliders catch up on the next sync
+        transform_pool_set(entity->transforms, entity->transform_index, x, y);
+        return;
+    }
+
+    // Not in an engine; nothing syncs, so update collision bounds now
+    entity->detached_x = x;
+    entity->detached_y = y;
+    _entity_refresh_colliders(entity);
+}
+
+float entity_get_x(const EseEntity *entity) {
+    log_assert("ENTITY", entity, "entity_get_x called with NULL entity");
+    return _entity_get_x(entity);
+}
+
+float entity_get_y(const EseEntity *entity) {
+    log_assert("ENTITY", entity, "entity_get_y called with NULL entity");
+    return _entity_get_y(entity);
+}
+
+void _entity_attach_transform(EseEntity *entity, EseTransformPool *pool, uint32_t index) {
+    log_assert("ENTITY", entity, "_entity_attach_transform called with NULL entity");
+    log_assert("ENTITY", pool, "_entity_attach_transform called with NULL pool");
+
+    if (entity->transforms) {
+        return;
+    }
+    if (transform_pool_attach(pool, index, entity, entity->detached_x, entity->detached_y)) {
+        entity->transforms = pool;
+        entity->transform_index = index;
+    }
+}
+
+void _entity_detach_transform(EseEntity *entity) {
+    log_assert("ENTITY", entity, "_entity_detach_transform called with NULL entity");
+
+    if (!entity->transforms) {
+        return;
+    }
+
+    // Bring colliders up to date before writes go back to refreshing eagerly
+    _entity_sync_transform(entity);
+    entity->detached_x = entity->transforms->x[entity->transform_index];
+    entity->detached_y = entity->transforms->y[entity->transform_index];
+    transform_pool_detach(entity->transforms, entity->transform_index);
+    entity->transforms = NULL;
+}
+
+void _entity_sync_transform(EseEntity *entity) {
+    if (entity->transforms &&
+        transform_pool_clear_dirty(entity->transforms, entity->transform_index)) {
+        _entity_refresh_colliders(entity);
+    }
+}
+
 void entity_run_function_with_args(EseEntity *entity, const char *func_name, int argc,
                                    EseLuaValue *argv[]) {
+    if (!(entity->component_mask & ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_LUA))) {
+        return;
+    }
+
     profile_start(PROFILE_ENTITY_LUA_FUNCTION_CALL);
 
     for (size_t i = 0; i < entity->component_count; i++) {
@@ -247,100 +336,72 @@ bool entity_test_collision(EseEntity *a, EseEntity *b, EseArray *out_hits) {
     return hit;
 }
 
+// Lua callback names indexed by EseCollisionState, for collider and map hits
+static const char *const COLLIDER_CALLBACKS[] = {NULL, "entity_collision_enter",
+                                                 "entity_collision_stay", "entity_collision_exit"};
+static const char *const MAP_CALLBACKS[] = {NULL, "map_collision_enter", "map_collision_stay",
+                                            "map_collision_exit"};
+
 void entity_process_collision_callbacks(EseCollisionHit *hit) {
     log_assert("ENTITY", hit, "entity_process_collision_callbacks called with NULL hit");
 
     profile_start(PROFILE_ENTITY_COLLISION_CALLBACK);
 
-    EseCollisionState state = ese_collision_hit_get_state(hit);
-    if (ese_collision_hit_get_kind(hit) == COLLISION_KIND_COLLIDER) {
-        switch (state) {
-        case COLLISION_STATE_ENTER:
-            // Collision Enter
-            {
-                EseLuaValue *args[] = {ese_collision_hit_get_target(hit)->lua_val_ref};
-                entity_run_function_with_args(ese_collision_hit_get_entity(hit),
-                                              "entity_collision_enter", 1, args);
-            }
-            {
-                EseLuaValue *args[] = {ese_collision_hit_get_entity(hit)->lua_val_ref};
-                entity_run_function_with_args(ese_collision_hit_get_target(hit),
-                                              "entity_collision_enter", 1, args);
-            }
-            break;
-
-        case COLLISION_STATE_STAY:
-            // Collision Stay
-            {
-                EseLuaValue *args[] = {ese_collision_hit_get_target(hit)->lua_val_ref};
-                entity_run_function_with_args(ese_collision_hit_get_entity(hit),
-                                              "entity_collision_stay", 1, args);
-            }
-            {
-                EseLuaValue *args[] = {ese_collision_hit_get_entity(hit)->lua_val_ref};
-                entity_run_function_with_args(ese_collision_hit_get_target(hit),
-                                              "entity_collision_stay", 1, args);
-            }
-            break;
-
-        case COLLISION_STATE_LEAVE:
-            // Collision Exit
-            {
-                EseLuaValue *args[] = {ese_collision_hit_get_target(hit)->lua_val_ref};
-                entity_run_function_with_args(ese_collision_hit_get_entity(hit),
-                                              "entity_collision_exit", 1, args);
-            }
-            {
-                EseLuaValue *args[] = {ese_collision_hit_get_entity(hit)->lua_val_ref};
-                entity_run_function_with_args(ese_collision_hit_get_target(hit),
-                                              "entity_collision_exit", 1, args);
-            }
-            break;
-
-        case COLLISION_STATE_NONE:
-        default:
-            // No collision, nothing to do
-            break;
-        }
-    } else if (ese_collision_hit_get_kind(hit) == COLLISION_KIND_MAP) {
-        switch (state) {
-        case COLLISION_STATE_ENTER:
-            // Map collision enter
-            {
-                EseLuaValue *args[] = {ese_collision_hit_get_target(hit)->lua_val_ref};
-                entity_run_function_with_args(ese_collision_hit_get_entity(hit),
-                                              "map_collision_enter", 1, args);
-            }
-            break;
-        case COLLISION_STATE_STAY:
-            // Map collision stay
-            {
-                EseLuaValue *args[] = {ese_collision_hit_get_target(hit)->lua_val_ref};
-                entity_run_function_with_args(ese_collision_hit_get_entity(hit),
-                                              "map_collision_stay", 1, args);
-            }
-            break;
-        case COLLISION_STATE_LEAVE:
-            // Map collision exit
-            {
-                EseLuaValue *args[] = {ese_collision_hit_get_target(hit)->lua_val_ref};
-                entity_run_function_with_args(ese_collision_hit_get_entity(hit),
-                                              "map_collision_exit", 1, args);
-            }
-            break;
-        case COLLISION_STATE_NONE:
-        default:
-            // No collision, nothing to do
-            break;
-        }
-    } else {
+    EseCollisionKind kind = ese_collision_hit_get_kind(hit);
+    if (kind != COLLISION_KIND_COLLIDER && kind != COLLISION_KIND_MAP) {
         // Unknown collision kind
         log_error("ENTITY", "entity_process_collision_callbacks: unknown collision kind");
+        profile_stop(PROFILE_ENTITY_COLLISION_CALLBACK, "entity_process_collision_callbacks");
+        return;
+    }
+
+    EseCollisionRecord record = {.other = ese_collision_hit_get_target(hit),
+                                 .kind = kind,
+                                 .state = ese_collision_hit_get_state(hit)};
+    entity_process_collision_record(ese_collision_hit_get_entity(hit), &record);
+
+    // Collider hits are reported to both entities, map hits only to the collider
+    if (kind == COLLISION_KIND_COLLIDER) {
+        record.other = ese_collision_hit_get_entity(hit);
+        entity_process_collision_record(ese_collision_hit_get_target(hit), &record);
     }
 
     profile_stop(PROFILE_ENTITY_COLLISION_CALLBACK, "entity_process_collision_callbacks");
 }
 
+void entity_process_collision_record(EseEntity *entity, const EseCollisionRecord *record) {
+    log_assert("ENTITY", entity, "entity_process_collision_record called with NULL entity");
+    log_assert("ENTITY", record, "entity_process_collision_record called with NULL record");
+
+    if (record->state <= COLLISION_STATE_NONE || record->state > COLLISION_STATE_LEAVE) {
+        // No collision, nothing to do
+        return;
+    }
+
+    const char *func_name = record->kind == COLLISION_KIND_MAP ? MAP_CALLBACKS[record->state]
+                                                               : COLLIDER_CALLBACKS[record->state];
+    EseLuaValue *args[] = {record->other->lua_val_ref};
+    entity_run_function_with_args(entity, func_name, 1, args);
+}
+
+bool entity_wants_collision_batch(EseEntity *entity) {
+    log_assert("ENTITY", entity, "entity_wants_collision_batch called with NULL entity");
+
+    if (!(entity->component_mask & ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_LUA))) {
+        return false;
+    }
+
+    for (size_t i = 0; i < entity->component_count; i++) {
+        EseEntityComponent *comp = entity->components[i];
+        if (comp->active && comp->type == ENTITY_COMPONENT_LUA &&
+            entity_component_lua_has_function((EseEntityComponentLua *)comp->data,
+                                              "entity_collisions")) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool entity_detect_collision_rect(EseEntity *entity, EseRect *rect) {
     log_assert("ENTITY", entity, "entity_detect_collision_rect called with NULL entity");
     log_assert("ENTITY", rect, "entity_detect_collision_rect called with NULL rect");
@@ -363,12 +424,7 @@ bool entity_detect_collision_rect(EseEntity *entity, EseRect *rect) {
     return false;
 }
 
-const char *entity_component_add(EseEntity *entity, EseEntityComponent *comp) {
-    log_assert("ENTITY", entity, "entity_component_add called with NULL entity");
-    log_assert("ENTITY", comp, "entity_component_add called with NULL comp");
-
-    profile_start(PROFILE_ENTITY_COMPONENT_ADD);
-
+void _entity_component_attach(EseEntity *entity, EseEntityComponent *comp) {
     // Lazily allocate components array on first add
     if (entity->component_capacity == 0) {
         size_t initial_capacity = 10; // matches ENTITY_INITIAL_CAPACITY previously used
@@ -387,14 +443,27 @@ const char *entity_component_add(EseEntity *entity, EseEntityComponent *comp) {
     }
 
     entity->components[entity->component_count++] = comp;
+    entity->component_mask |= ENTITY_COMPONENT_BIT(comp->type);
     comp->entity = entity;
     comp->vtable->ref(comp);
+    memset(comp->system_index, 0, sizeof(comp->system_index));
 
     // If this is a collider, initialize bounds now that the entity pointer is
     // set
     if (comp->type == ENTITY_COMPONENT_COLLIDER) {
-        entity_component_collider_update_bounds((EseEntityComponentCollider *)comp->data);
+        EseEntityComponentCollider *collider = (EseEntityComponentCollider *)comp->data;
+        entity_component_collider_update_bounds(collider);
+        entity_component_collider_sync_entity(entity, NULL);
     }
+}
+
+const char *entity_component_add(EseEntity *entity, EseEntityComponent *comp) {
+    log_assert("ENTITY", entity, "entity_component_add called with NULL entity");
+    log_assert("ENTITY", comp, "entity_component_add called with NULL comp");
+
+    profile_start(PROFILE_ENTITY_COMPONENT_ADD);
+
+    _entity_component_attach(entity, comp);
 
     // Notify systems that a component was added
     EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(entity->lua->runtime, ENGINE_KEY);
@@ -428,10 +497,7 @@ bool entity_component_remove(EseEntity *entity, const char *id) {
         // Fallback: if no engine, remove immediately (shouldn't happen in normal flow)
         comp->vtable->unref(comp);
         entity_component_destroy(comp);
-
-        entity->components[idx] = entity->components[entity->component_count - 1];
-        entity->components[entity->component_count - 1] = NULL;
-        entity->component_count--;
+        _entity_component_remove_at(entity, (size_t)idx);
     }
 
     return true;
@@ -473,35 +539,36 @@ int entity_get_lua_ref(EseEntity *entity) {
 // Tag management functions
 
 /**
- * @brief Helper function to capitalize a string and truncate to MAX_TAG_LENGTH
+ * @brief Returns the index of @p id in the entity's tags, or -1.
  */
-static void _normalize_tag(char *dest, const char *src) {
-    size_t i = 0;
-    while (src[i] && i < MAX_TAG_LENGTH - 1) {
-        if (src[i] >= 'a' && src[i] <= 'z') {
-            dest[i] = src[i] - 32; // Convert to uppercase
-        } else {
-            dest[i] = src[i];
+static int _entity_tag_index(const EseEntity *entity, EseTagId id) {
+    for (size_t i = 0; i < entity->tag_count; i++) {
+        if (entity->tags[i].id == id) {
+            return (int)i;
         }
-        i++;
     }
-    dest[i] = '\0';
+    return -1;
 }
 
 bool entity_add_tag(EseEntity *entity, const char *tag) {
     log_assert("ENTITY", entity, "entity_add_tag called with NULL entity");
     log_assert("ENTITY", tag, "entity_add_tag called with NULL tag");
 
+    EseTagId id = entity_tag_intern(tag);
+    if (id == ENTITY_TAG_NONE) {
+        return false;
+    }
+
     // Check if tag already exists
-    if (entity_has_tag(entity, tag)) {
+    if (_entity_tag_index(entity, id) >= 0) {
         return false;
     }
 
     // Expand tag array if needed
     if (entity->tag_count == entity->tag_capacity) {
         size_t new_capacity = entity->tag_capacity == 0 ? 4 : entity->tag_capacity * 2;
-        char **new_tags =
-            memory_manager.realloc(entity->tags, sizeof(char *) * new_capacity, MMTAG_ENTITY);
+        EseEntityTag *new_tags = memory_manager.realloc(
+            entity->tags, sizeof(EseEntityTag) * new_capacity, MMTAG_ENTITY);
         if (!new_tags) {
             log_error("ENTITY", "entity_add_tag: failed to allocate memory for tags");
             return false;
@@ -510,15 +577,15 @@ bool entity_add_tag(EseEntity *entity, const char *tag) {
         entity->tag_capacity = new_capacity;
     }
 
-    // Allocate and normalize the tag
-    char *normalized_tag = memory_manager.malloc(MAX_TAG_LENGTH, MMTAG_ENTITY);
-    if (!normalized_tag) {
-        log_error("ENTITY", "entity_add_tag: failed to allocate memory for tag string");
-        return false;
-    }
+    size_t index = entity->tag_count++;
+    entity->tags[index].id = id;
+    entity->tags[index].set_index = ENTITY_TAG_NO_SET;
 
-    _normalize_tag(normalized_tag, tag);
-    entity->tags[entity->tag_count++] = normalized_tag;
+    // Keep the engine's per-tag set current
+    EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(entity->lua->runtime, ENGINE_KEY);
+    if (engine) {
+        engine_notify_tag_add(engine, entity, index);
+    }
 
     return true;
 }
@@ -527,44 +594,44 @@ bool entity_remove_tag(EseEntity *entity, const char *tag) {
     log_assert("ENTITY", entity, "entity_remove_tag called with NULL entity");
     log_assert("ENTITY", tag, "entity_remove_tag called with NULL tag");
 
-    char normalized_tag[MAX_TAG_LENGTH];
-    _normalize_tag(normalized_tag, tag);
-
-    for (size_t i = 0; i < entity->tag_count; i++) {
-        if (strcmp(entity->tags[i], normalized_tag) == 0) {
-            // Free the tag string
-            memory_manager.free(entity->tags[i]);
+    EseTagId id = entity_tag_find(tag);
+    int index = id == ENTITY_TAG_NONE ? -1 : _entity_tag_index(entity, id);
+    if (index < 0) {
+        return false;
+    }
 
-            // Shift remaining tags down
-            for (size_t j = i; j < entity->tag_count - 1; j++) {
-                entity->tags[j] = entity->tags[j + 1];
-            }
-            entity->tag_count--;
-            return true;
+    if (entity->tags[index].set_index != ENTITY_TAG_NO_SET) {
+        EseEngine *engine =
+            (EseEngine *)lua_engine_get_registry_key(entity->lua->runtime, ENGINE_KEY);
+        if (engine) {
+            engine_notify_tag_rem(engine, entity, (size_t)index);
         }
     }
 
-    return false;
+    // Shift remaining tags down
+    for (size_t j = (size_t)index; j < entity->tag_count - 1; j++) {
+        entity->tags[j] = entity->tags[j + 1];
+    }
+    entity->tag_count--;
+    return true;
 }
 
 bool entity_has_tag(EseEntity *entity, const char *tag) {
     log_assert("ENTITY", entity, "entity_has_tag called with NULL entity");
     log_assert("ENTITY", tag, "entity_has_tag called with NULL tag");
 
-    char normalized_tag[MAX_TAG_LENGTH];
-    _normalize_tag(normalized_tag, tag);
-
-    for (size_t i = 0; i < entity->tag_count; i++) {
-        if (strcmp(entity->tags[i], normalized_tag) == 0) {
-            return true;
-        }
-    }
+    EseTagId id = entity_tag_find(tag);
+    return id != ENTITY_TAG_NONE && _entity_tag_index(entity, id) >= 0;
+}
 
-    return false;
+bool entity_has_tag_id(const EseEntity *entity, EseTagId id) {
+    log_assert("ENTITY", entity, "entity_has_tag_id called with NULL entity");
+    return _entity_tag_index(entity, id) >= 0;
 }
 
 EseRect *entity_get_collision_bounds(EseEntity *entity, bool to_world_coords) {
     log_assert("ENTITY", entity, "entity_get_collision_bounds called with NULL entity");
+    _entity_sync_transform(entity);
 
     // If no collision bounds exist, return NULL
     if (!entity->collision_bounds) {
@@ -579,10 +646,8 @@ EseRect *entity_get_collision_bounds(EseEntity *entity, bool to_world_coords) {
             // Fallback: create a copy of the bounds in world coordinates
             EseRect *world_bounds = ese_rect_copy(entity->collision_bounds);
             if (world_bounds) {
-                ese_rect_set_x(world_bounds,
-                               ese_rect_get_x(world_bounds) + ese_point_get_x(entity->position));
-                ese_rect_set_y(world_bounds,
-                               ese_rect_get_y(world_bounds) + ese_point_get_y(entity->position));
+                ese_rect_set_x(world_bounds, ese_rect_get_x(world_bounds) + _entity_get_x(entity));
+                ese_rect_set_y(world_bounds, ese_rect_get_y(world_bounds) + _entity_get_y(entity));
             }
             return world_bounds;
         }
@@ -612,6 +677,41 @@ bool entity_get_persistent(EseEntity *entity) {
     return entity->persistent;
 }
 
+void entity_set_update_mode(EseEntity *entity, EseEntityUpdateMode mode) {
+    log_assert("ENTITY", entity, "entity_set_update_mode called with NULL entity");
+    entity->update_mode = mode;
+}
+
+EseEntityUpdateMode entity_get_update_mode(const EseEntity *entity) {
+    log_assert("ENTITY", entity, "entity_get_update_mode called with NULL entity");
+    return entity->update_mode;
+}
+
+void entity_set_update_interval(EseEntity *entity, uint32_t frames) {
+    log_assert("ENTITY", entity, "entity_set_update_interval called with NULL entity");
+    entity->update_interval = frames > 0 ? frames : 1;
+}
+
+uint32_t entity_get_update_interval(const EseEntity *entity) {
+    log_assert("ENTITY", entity, "entity_get_update_interval called with NULL entity");
+    return entity->update_interval;
+}
+
+void entity_set_update_distance(EseEntity *entity, float distance) {
+    log_assert("ENTITY", entity, "entity_set_update_distance called with NULL entity");
+    entity->update_distance = distance > 0.0f ? distance : 0.0f;
+}
+
+float entity_get_update_distance(const EseEntity *entity) {
+    log_assert("ENTITY", entity, "entity_get_update_distance called with NULL entity");
+    return entity->update_distance;
+}
+
+EseSlotHandle entity_get_handle(const EseEntity *entity) {
+    log_assert("ENTITY", entity, "entity_get_handle called with NULL entity");
+    return entity->handle;
+}
+
 cJSON *entity_serialize(EseEntity *entity) {
     log_assert("ENTITY", entity, "entity_serialize called with NULL entity");
 
@@ -679,10 +779,7 @@ cJSON *entity_serialize(EseEntity *entity) {
     }
 
     for (size_t i = 0; i < entity->tag_count; i++) {
-        if (!entity->tags[i]) {
-            continue;
-        }
-        cJSON *tag_item = cJSON_CreateString(entity->tags[i]);
+        cJSON *tag_item = cJSON_CreateString(entity_tag_name(entity->tags[i].id));
         if (!tag_item) {
             log_error("ENTITY", "entity_serialize: failed to create tag item");
             cJSON_Delete(tags_arr);
@@ -2,7 +2,9 @@
 #define ESE_ENTITY_H
 
 #include "entity/entity_lua.h"
+#include "entity/entity_tag.h"
 #include "scripting/lua_engine_private.h"
+#include "utility/slot_map.h"
 #include "vendor/json/cJSON.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -16,8 +18,21 @@ typedef struct EseEntity EseEntity;
 typedef struct EseEntityComponent EseEntityComponent;
 typedef struct EseRect EseRect;
 typedef struct EseCollisionHit EseCollisionHit;
+typedef struct EseCollisionRecord EseCollisionRecord;
 typedef struct EseArray EseArray;
 
+/**
+ * @brief When the Lua system runs an entity's entity_update.
+ *
+ * @details Skipped frames are not lost: their delta time is added to the dt of
+ * the next update the entity gets.
+ */
+typedef enum EseEntityUpdateMode {
+    ENTITY_UPDATE_EVERY_FRAME = 0, /** Every frame (default) */
+    ENTITY_UPDATE_INTERVAL,        /** Every update_interval frames, within the engine budget */
+    ENTITY_UPDATE_NEAR_CAMERA,     /** Only within update_distance pixels of the camera view */
+} EseEntityUpdateMode;
+
 /**
  * @brief Callback function type for entity drawing operations.
  *
@@ -134,12 +149,32 @@ void entity_destroy(EseEntity *entity);
 /**
  * @brief Sets the position of an entity.
  *
+ * @details While the entity is added to an engine the position lives in the
+ * engine's transform pool and the write only marks it dirty; collider bounds
+ * follow on the next sync (see engine_sync_transforms).
+ *
  * @param entity Pointer to the EseEntity
  * @param x X coordinate
  * @param y Y coordinate
  */
 void entity_set_position(EseEntity *entity, float x, float y);
 
+/**
+ * @brief Gets the x position of an entity.
+ *
+ * @param entity Pointer to the EseEntity
+ * @return X coordinate
+ */
+float entity_get_x(const EseEntity *entity);
+
+/**
+ * @brief Gets the y position of an entity.
+ *
+ * @param entity Pointer to the EseEntity
+ * @return Y coordinate
+ */
+float entity_get_y(const EseEntity *entity);
+
 void entity_run_function_with_args(EseEntity *entity, const char *func_name, int argc,
                                    EseLuaValue *argv[]);
 
@@ -150,6 +185,29 @@ void entity_run_function_with_args(EseEntity *entity, const char *func_name, int
  */
 void entity_process_collision_callbacks(EseCollisionHit *hit);
 
+/**
+ * @brief Runs the per-hit Lua callback for one side of a collision.
+ *
+ * @details Calls entity_collision_enter/stay/exit for collider hits and
+ *          map_collision_enter/stay/exit for map hits, passing the other entity.
+ *
+ * @param entity Entity receiving the callback
+ * @param record Collision as seen by @p entity
+ */
+void entity_process_collision_record(EseEntity *entity, const EseCollisionRecord *record);
+
+/**
+ * @brief Checks whether an entity takes its collisions as one batch per frame.
+ *
+ * @details True when an active Lua component defines entity_collisions. The
+ *          engine's collision dispatch then calls entity_collisions(self, hits)
+ *          once per frame for such entities instead of the per-hit callbacks.
+ *
+ * @param entity Pointer to the EseEntity
+ * @return true if the entity opted into batched collision callbacks
+ */
+bool entity_wants_collision_batch(EseEntity *entity);
+
 /**
  * @brief Check for a collision between entitiy and a rect.
  *
@@ -207,6 +265,9 @@ bool entity_add_prop(EseEntity *entity, EseLuaValue *value);
 /**
  * @brief Adds a tag to an entity.
  *
+ * @details The tag is interned (entity_tag_intern) and stored as its id. If
+ * the entity is in an engine, the engine's set for the tag is updated too.
+ *
  * @param entity Pointer to the EseEntity
  * @param tag Tag string to add (will be capitalized and truncated to 16
  * characters)
@@ -232,6 +293,15 @@ bool entity_remove_tag(EseEntity *entity, const char *tag);
  */
 bool entity_has_tag(EseEntity *entity, const char *tag);
 
+/**
+ * @brief Checks if an entity has an interned tag.
+ *
+ * @param entity Pointer to the EseEntity
+ * @param id Tag id from entity_tag_intern or entity_tag_find
+ * @return true if entity has the tag, false otherwise
+ */
+bool entity_has_tag_id(const EseEntity *entity, EseTagId id);
+
 /**
  * @brief Gets the entity's collision bounds.
  *
@@ -253,6 +323,53 @@ void entity_set_persistent(EseEntity *entity, bool persistent);
 
 bool entity_get_persistent(EseEntity *entity);
 
+/**
+ * @brief Sets when the Lua system runs the entity's entity_update.
+ *
+ * @details Throttled entities still run entity_init on their first frame. The
+ * update they do get carries the dt of every frame skipped since the last one,
+ * capped at one second so an entity returning after a long pause does not get a
+ * single huge step.
+ *
+ * @param entity Pointer to the EseEntity
+ * @param mode Update policy
+ */
+void entity_set_update_mode(EseEntity *entity, EseEntityUpdateMode mode);
+
+EseEntityUpdateMode entity_get_update_mode(const EseEntity *entity);
+
+/**
+ * @brief Sets how many frames apart ENTITY_UPDATE_INTERVAL updates are.
+ *
+ * @param entity Pointer to the EseEntity
+ * @param frames Frames between updates; values below 1 are treated as 1
+ */
+void entity_set_update_interval(EseEntity *entity, uint32_t frames);
+
+uint32_t entity_get_update_interval(const EseEntity *entity);
+
+/**
+ * @brief Sets how far outside the camera view an ENTITY_UPDATE_NEAR_CAMERA
+ * entity keeps updating.
+ *
+ * @param entity Pointer to the EseEntity
+ * @param distance Margin in pixels around the viewport; negative values are treated as 0
+ */
+void entity_set_update_distance(EseEntity *entity, float distance);
+
+float entity_get_update_distance(const EseEntity *entity);
+
+/**
+ * @brief Gets the handle the engine assigned when the entity was added.
+ *
+ * @details Resolve it with engine_get_entity(); once the entity is removed
+ *          the handle stops resolving and is never reused for another entity.
+ *
+ * @param entity Pointer to the EseEntity
+ * @return The entity handle, or SLOT_MAP_NULL_HANDLE if not added to an engine
+ */
+EseSlotHandle entity_get_handle(const EseEntity *entity);
+
 bool entity_test_collision(EseEntity *a, EseEntity *b, EseArray *out_hits);
 
 /**
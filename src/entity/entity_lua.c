@@ -601,16 +601,13 @@ static int _entity_lua_find_first_by_tag(lua_State *L) {
         return luaL_error(L, "Engine not found");
     }
 
-    // Find 1 entity with tag
-    EseEntity **found = engine_find_by_tag(engine, tag, 1);
+    EseEntity *found = engine_find_first_by_tag(engine, tag);
     if (!found) {
         lua_pushnil(L);
         return 1;
     }
 
-    // Push the found entity
-    entity_lua_push(found[0]);
-    memory_manager.free(found);
+    entity_lua_push(found);
     return 1;
 }
 
@@ -779,6 +776,9 @@ static int _entity_lua_components_index(lua_State *L) {
     return 0;
 }
 
+// Lua names of EseEntityUpdateMode values, indexed by the enum
+static const char *const ENTITY_UPDATE_MODE_NAMES[] = {"every_frame", "interval", "near_camera"};
+
 /**
  * @brief Lua __index metamethod for EseEntity objects (getter).
  */
@@ -816,6 +816,15 @@ static int _entity_lua_index(lua_State *L) {
     } else if (strcmp(key, "draw_order") == 0) {
         lua_pushinteger(L, (lua_Integer)(entity->draw_order >> DRAW_ORDER_SHIFT));
         return 1;
+    } else if (strcmp(key, "update_mode") == 0) {
+        lua_pushstring(L, ENTITY_UPDATE_MODE_NAMES[entity->update_mode]);
+        return 1;
+    } else if (strcmp(key, "update_interval") == 0) {
+        lua_pushinteger(L, (lua_Integer)entity->update_interval);
+        return 1;
+    } else if (strcmp(key, "update_distance") == 0) {
+        lua_pushnumber(L, entity->update_distance);
+        return 1;
     } else if (strcmp(key, "position") == 0) {
         if (entity->position != NULL && ese_point_get_lua_ref(entity->position) != LUA_NOREF) {
             lua_rawgeti(L, LUA_REGISTRYINDEX, ese_point_get_lua_ref(entity->position));
@@ -882,7 +891,7 @@ static int _entity_lua_index(lua_State *L) {
         // Return a table of all tags
         lua_newtable(L);
         for (size_t i = 0; i < entity->tag_count; i++) {
-            lua_pushstring(L, entity->tags[i]);
+            lua_pushstring(L, entity_tag_name(entity->tags[i].id));
             lua_rawseti(L, -2, i + 1); // Lua uses 1-based indexing
         }
         return 1;
@@ -955,6 +964,28 @@ static int _entity_lua_newindex(lua_State *L) {
 
         entity->draw_order = ((uint64_t)public_z << DRAW_ORDER_SHIFT);
         return 0;
+    } else if (strcmp(key, "update_mode") == 0) {
+        const char *mode = lua_isstring(L, 3) ? lua_tostring(L, 3) : NULL;
+        for (int i = 0; mode && i <= ENTITY_UPDATE_NEAR_CAMERA; i++) {
+            if (strcmp(mode, ENTITY_UPDATE_MODE_NAMES[i]) == 0) {
+                entity_set_update_mode(entity, (EseEntityUpdateMode)i);
+                return 0;
+            }
+        }
+        return luaL_error(L, "Entity update_mode must be \"every_frame\", \"interval\" or "
+                             "\"near_camera\"");
+    } else if (strcmp(key, "update_interval") == 0) {
+        if (!lua_isinteger_lj(L, 3) || lua_tointeger(L, 3) < 1) {
+            return luaL_error(L, "Entity update_interval must be an integer of at least 1");
+        }
+        entity_set_update_interval(entity, (uint32_t)lua_tointeger(L, 3));
+        return 0;
+    } else if (strcmp(key, "update_distance") == 0) {
+        if (!lua_isnumber(L, 3) || lua_tonumber(L, 3) < 0) {
+            return luaL_error(L, "Entity update_distance must be a non-negative number");
+        }
+        entity_set_update_distance(entity, (float)lua_tonumber(L, 3));
+        return 0;
     } else if (strcmp(key, "position") == 0) {
         EsePoint *new_position_point = ese_point_lua_get(L, 3);
         if (!new_position_point) {
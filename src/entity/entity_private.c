@@ -1,4 +1,5 @@
 #include "entity/entity_private.h"
+#include "core/collision_dispatch.h"
 #include "core/memory_manager.h"
 #include "entity/components/collider.h"
 #include "entity/components/entity_component_private.h"
@@ -9,6 +10,7 @@
 #include "utility/double_linked_list.h"
 #include "utility/log.h"
 #include "utility/profile.h"
+#include "utility/spatial_index.h"
 #include "vendor/lua/src/lauxlib.h"
 #include "vendor/lua/src/lua.h"
 #include "vendor/lua/src/lualib.h"
@@ -19,54 +21,65 @@
 
 #define ENTITY_INITIAL_CAPACITY 10
 
-/**
- * @brief Callback function called when entity position changes
- *
- * @param point The position point that changed
- * @param user_data The entity that owns the position point
- */
-static void _entity_position_changed(EsePoint *point, void *user_data) {
-    EseEntity *entity = (EseEntity *)user_data;
+static void _entity_position_view_get(const void *data, float *x, float *y) {
+    const EseEntity *entity = (const EseEntity *)data;
+    *x = _entity_get_x(entity);
+    *y = _entity_get_y(entity);
+}
 
-    // Update collision bounds for all collider components
-    for (size_t i = 0; i < entity->component_count; i++) {
-        EseEntityComponent *comp = entity->components[i];
-        if (comp->active && comp->type == ENTITY_COMPONENT_COLLIDER) {
-            entity_component_collider_position_changed((EseEntityComponentCollider *)comp->data);
-        }
-    }
+static void _entity_position_view_set(void *data, float x, float y) {
+    entity_set_position((EseEntity *)data, x, y);
 }
 
+// The entity's EsePoint reads and writes the entity transform
+static const EsePointView ENTITY_POSITION_VIEW = {
+    .get = _entity_position_view_get,
+    .set = _entity_position_view_set,
+};
+
 EseEntity *_entity_make(EseLuaEngine *engine) {
     profile_start(PROFILE_ENTITY_CREATE);
 
     EseEntity *entity = memory_manager.malloc(sizeof(EseEntity), MMTAG_ENTITY);
+    entity->transforms = NULL;
+    entity->transform_index = 0;
+    entity->detached_x = 0.0f;
+    entity->detached_y = 0.0f;
     entity->position = ese_point_create(engine);
     ese_point_ref(entity->position);
-
-    // Register a watcher to update collision bounds when position changes
-    ese_point_add_watcher(entity->position, _entity_position_changed, entity);
     entity->id = ese_uuid_create(engine);
     ese_uuid_ref(entity->id);
     entity->active = true;
     entity->visible = true;
     entity->persistent = false;
     entity->destroyed = false;
-    ese_point_set_x(entity->position, 0.0f);
-    ese_point_set_y(entity->position, 0.0f);
+    entity->removal_queued = false;
     entity->draw_order = 0;
+    entity->update_mode = ENTITY_UPDATE_EVERY_FRAME;
+    entity->update_interval = 1;
+    entity->update_distance = 0.0f;
 
     // Not storing any values, so no free function needed
     entity->current_collisions = hashmap_create(NULL);
     entity->previous_collisions = hashmap_create(NULL);
     entity->collision_bounds = NULL;
     entity->collision_world_bounds = NULL;
+    entity->spatial_proxy = SPATIAL_INDEX_NULL_PROXY;
+    entity->collision_filter = COLLISION_FILTER_ALL;
+    entity->collision_static = false;
+    entity->collision_resting = false;
+    entity->collision_dispatch_slot = COLLISION_DISPATCH_NO_SLOT;
+    entity->handle = SLOT_MAP_NULL_HANDLE;
 
     // Lazily allocate components array on first insert to reduce baseline
     // allocations
     entity->components = NULL;
     entity->component_capacity = 0;
     entity->component_count = 0;
+    entity->component_mask = 0;
+
+    // The position point is a view of the transform fields above
+    ese_point_set_view(entity->position, &ENTITY_POSITION_VIEW, entity);
 
     entity->lua = engine;
     entity->lua_ref = LUA_NOREF;
@@ -101,6 +114,25 @@ int _entity_component_find_index(EseEntity *entity, const char *id) {
     return -1;
 }
 
+void _entity_component_remove_at(EseEntity *entity, size_t index) {
+    log_assert("ENTITY", entity, "_entity_component_remove_at called with NULL entity");
+    log_assert("ENTITY", index < entity->component_count,
+               "_entity_component_remove_at: index %zu out of range", index);
+
+    EntityComponentType type = entity->components[index]->type;
+    entity->components[index] = entity->components[entity->component_count - 1];
+    entity->components[entity->component_count - 1] = NULL;
+    entity->component_count--;
+
+    // Keep the type's bit while another component of that type is attached
+    for (size_t i = 0; i < entity->component_count; i++) {
+        if (entity->components[i]->type == type) {
+            return;
+        }
+    }
+    entity->component_mask &= ~ENTITY_COMPONENT_BIT(type);
+}
+
 /**
  * @brief Free function for entity subscription tracking.
  */
@@ -3,10 +3,13 @@
 
 #include "entity.h"
 #include "entity/components/entity_component.h"
+#include "entity/entity_tag.h"
+#include "entity/transform_pool.h"
 #include "types/types.h"
 #include "utility/array.h"
 #include "utility/double_linked_list.h"
 #include "utility/hashmap.h"
+#include "utility/slot_map.h"
 #include <stdint.h>
 
 #define DRAW_ORDER_SHIFT 48
@@ -21,6 +24,17 @@ typedef struct {
     char *function_name; /** Name of the function to call */
 } EseEntitySubscription;
 
+// Value of EseEntityTag::set_index while the entity is in no engine tag set
+#define ENTITY_TAG_NO_SET UINT32_MAX
+
+/**
+ * @brief One tag of an entity.
+ */
+typedef struct EseEntityTag {
+    EseTagId id;        /** Interned tag id */
+    uint32_t set_index; /** Position in the engine's set for the tag, or ENTITY_TAG_NO_SET */
+} EseEntityTag;
+
 /**
  * @brief Internal entity structure.
  */
@@ -30,19 +44,38 @@ struct EseEntity {
     bool visible;                       /** Whether entity is visible */
     bool persistent;                    /** Whether entity is persistent */
     bool destroyed;                     /** Whether entity is destroyed */
+    bool removal_queued;                /** Whether entity waits in the engine's delete list */
     uint64_t draw_order;                /** Drawing order (z-index) */
+    EseEntityUpdateMode update_mode;    /** When the Lua system runs entity_update */
+    uint32_t update_interval;           /** Frames between ENTITY_UPDATE_INTERVAL updates */
+    float update_distance;              /** ENTITY_UPDATE_NEAR_CAMERA margin around the view */
 
-    EsePoint *position;                 /** EseEntity position */
+    EsePoint *position;                 /** Lua-facing view of the entity position */
+    EseTransformPool *transforms;       /** Engine pool holding the position while added,
+                                            else NULL */
+    uint32_t transform_index;           /** Slot of the entity in transforms */
+    float detached_x;                   /** X position while not in a transform pool */
+    float detached_y;                   /** Y position while not in a transform pool */
 
     EseEntityComponent **components;    /** Array of components */
     size_t component_count;             /** Number of components */
     size_t component_capacity;          /** Capacity of component array */
+    uint32_t component_mask;            /** ENTITY_COMPONENT_BIT of each attached type */
 
     EseHashMap *current_collisions;     /** Hashmap of current frame collisions */
     EseHashMap *previous_collisions;    /** Hashmap of previous frame collisions */
     EseRect *collision_bounds;          /** Bounds of the entity for collision detection */
     EseRect *collision_world_bounds;    /** Bounds of the entity for collision
                                             detection in world coordinates */
+    uint32_t spatial_proxy;             /** Spatial index proxy id, or SPATIAL_INDEX_NULL_PROXY */
+    uint32_t collision_filter;          /** Collider layer (low 16) and mask (high 16) bits */
+    bool collision_static;              /** Collider is static geometry */
+    bool collision_resting;             /** Static or asleep as of the last spatial index
+                                            update; pairs of resting entities are not retested */
+    uint32_t collision_dispatch_slot;   /** Receiver slot while collision callbacks are
+                                            dispatched, else COLLISION_DISPATCH_NO_SLOT */
+    EseSlotHandle handle;               /** Engine entity handle, or SLOT_MAP_NULL_HANDLE
+                                            while not added to an engine */
 
     EseLuaEngine *lua;                  /** Lua engine reference */
     EseDoubleLinkedList *default_props; /** Lua default props added to self.data */
@@ -51,7 +84,7 @@ struct EseEntity {
     int lua_ref_count;                  /** Lua registry reference count */
 
     // Tag system
-    char **tags;         /** Array of tag strings */
+    EseEntityTag *tags;  /** Array of interned tags */
     size_t tag_count;    /** Number of tags */
     size_t tag_capacity; /** Capacity of tag array */
 
@@ -67,6 +100,61 @@ struct EseEntity {
  */
 EseEntity *_entity_make(EseLuaEngine *engine);
 
+/**
+ * @brief Reads an entity's x position without a function call.
+ */
+static inline float _entity_get_x(const EseEntity *entity) {
+    return entity->transforms ? entity->transforms->x[entity->transform_index]
+                              : entity->detached_x;
+}
+
+/**
+ * @brief Reads an entity's y position without a function call.
+ */
+static inline float _entity_get_y(const EseEntity *entity) {
+    return entity->transforms ? entity->transforms->y[entity->transform_index]
+                              : entity->detached_y;
+}
+
+/**
+ * @brief Moves the entity's position into a transform pool slot.
+ *
+ * @param entity Pointer to EseEntity
+ * @param pool Pool to join
+ * @param index Slot in the pool, normally the slot of the entity's handle
+ */
+void _entity_attach_transform(EseEntity *entity, EseTransformPool *pool, uint32_t index);
+
+/**
+ * @brief Moves the entity's position out of its transform pool slot.
+ *
+ * @param entity Pointer to EseEntity
+ */
+void _entity_detach_transform(EseEntity *entity);
+
+/**
+ * @brief Refreshes data derived from the position if it changed since the last sync.
+ *
+ * @details Position writes only mark the transform dirty; collider bounds and
+ * shapes are brought up to date here, by the spatial index update and by
+ * engine_sync_transforms.
+ *
+ * @param entity Pointer to EseEntity
+ */
+void _entity_sync_transform(EseEntity *entity);
+
+/**
+ * @brief Appends a component to the entity without notifying systems.
+ *
+ * @details Does everything entity_component_add does except the system
+ * notification, for callers that notify many components in one
+ * engine_notify_comp_add_batch pass.
+ *
+ * @param entity Pointer to EseEntity
+ * @param comp Component to attach
+ */
+void _entity_component_attach(EseEntity *entity, EseEntityComponent *comp);
+
 /**
  * @brief Internal function to find component index.
  *
@@ -76,6 +164,17 @@ EseEntity *_entity_make(EseLuaEngine *engine);
  */
 int _entity_component_find_index(EseEntity *entity, const char *id);
 
+/**
+ * @brief Takes a component out of the entity's array and updates the mask.
+ *
+ * @details Swap-removes; the caller has already notified systems and
+ * destroyed or released the component.
+ *
+ * @param entity Pointer to EseEntity
+ * @param index Index of the component in entity->components
+ */
+void _entity_component_remove_at(EseEntity *entity, size_t index);
+
 void _entity_subscription_free(void *value);
 
 #endif // ESE_ENTITY_PRIVATE_H
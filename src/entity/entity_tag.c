@@ -0,0 +1,108 @@
+/**
+ * ENTITY TAG INTERNING
+ * ====================
+ *
+ * Maps normalized tag strings to small dense ids so entities and the engine
+ * can store and compare tags as integers.
+ *
+ * The table is process-wide and fixed-size: names live in a static array
+ * indexed by id, and an open-addressed hash table (linear probing, twice the
+ * id capacity) maps a name to its id. Ids are never released; a game's tag
+ * vocabulary is small and stable, so nothing is allocated and lookups cost one
+ * hash of at most MAX_TAG_LENGTH bytes plus a short probe.
+ *
+ * Thread Safety:
+ * - Interning is not thread-safe; tags are added on the main thread.
+ */
+
+#include "entity/entity_tag.h"
+#include "entity/entity.h"
+#include "utility/log.h"
+#include <string.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define ENTITY_TAG_TABLE_SIZE (ENTITY_TAG_MAX_IDS * 2)
+
+static char g_tag_names[ENTITY_TAG_MAX_IDS][MAX_TAG_LENGTH]; /** Names by id */
+static uint16_t g_tag_table[ENTITY_TAG_TABLE_SIZE];           /** id + 1, 0 when empty */
+static size_t g_tag_count = 0;                                /** Interned tags */
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+static uint32_t _tag_hash(const char *name) {
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Finds the table slot holding @p name, or the empty slot it belongs in.
+ */
+static size_t _tag_slot(const char *name) {
+    size_t slot = _tag_hash(name) & (ENTITY_TAG_TABLE_SIZE - 1);
+    while (g_tag_table[slot] != 0 && strcmp(g_tag_names[g_tag_table[slot] - 1], name) != 0) {
+        slot = (slot + 1) & (ENTITY_TAG_TABLE_SIZE - 1);
+    }
+    return slot;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+void entity_tag_normalize(char *dest, const char *src) {
+    size_t i = 0;
+    while (src[i] && i < MAX_TAG_LENGTH - 1) {
+        if (src[i] >= 'a' && src[i] <= 'z') {
+            dest[i] = src[i] - 32; // Convert to uppercase
+        } else {
+            dest[i] = src[i];
+        }
+        i++;
+    }
+    dest[i] = '\0';
+}
+
+EseTagId entity_tag_intern(const char *tag) {
+    log_assert("ENTITY_TAG", tag, "entity_tag_intern called with NULL tag");
+
+    char name[MAX_TAG_LENGTH];
+    entity_tag_normalize(name, tag);
+
+    size_t slot = _tag_slot(name);
+    if (g_tag_table[slot] != 0) {
+        return (EseTagId)(g_tag_table[slot] - 1);
+    }
+    if (g_tag_count == ENTITY_TAG_MAX_IDS) {
+        log_error("ENTITY_TAG", "entity_tag_intern: more than %d distinct tags", ENTITY_TAG_MAX_IDS);
+        return ENTITY_TAG_NONE;
+    }
+
+    EseTagId id = (EseTagId)g_tag_count++;
+    memcpy(g_tag_names[id], name, sizeof(name));
+    g_tag_table[slot] = (uint16_t)(id + 1);
+    return id;
+}
+
+EseTagId entity_tag_find(const char *tag) {
+    log_assert("ENTITY_TAG", tag, "entity_tag_find called with NULL tag");
+
+    char name[MAX_TAG_LENGTH];
+    entity_tag_normalize(name, tag);
+
+    size_t slot = _tag_slot(name);
+    return g_tag_table[slot] != 0 ? (EseTagId)(g_tag_table[slot] - 1) : ENTITY_TAG_NONE;
+}
+
+const char *entity_tag_name(EseTagId id) {
+    return id < g_tag_count ? g_tag_names[id] : NULL;
+}
+
+size_t entity_tag_count(void) { return g_tag_count; }
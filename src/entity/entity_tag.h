@@ -0,0 +1,55 @@
+#ifndef ESE_ENTITY_TAG_H
+#define ESE_ENTITY_TAG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Small integer id of an interned tag
+typedef uint16_t EseTagId;
+
+#define ENTITY_TAG_NONE UINT16_MAX
+#define ENTITY_TAG_MAX_IDS 1024
+
+/**
+ * @brief Normalizes a tag: upper-cased and truncated to MAX_TAG_LENGTH - 1.
+ *
+ * @param dest Buffer of at least MAX_TAG_LENGTH bytes
+ * @param src Tag string to normalize
+ */
+void entity_tag_normalize(char *dest, const char *src);
+
+/**
+ * @brief Returns the id of a tag, interning it on first use.
+ *
+ * @details Tags are normalized first, so "enemy" and "ENEMY" share an id. Ids
+ *          are process-wide, dense from 0 and never released, which keeps them
+ *          valid across engines and scenes. Not thread-safe; tags are added
+ *          from the main thread.
+ *
+ * @param tag Tag string
+ * @return The tag id, or ENTITY_TAG_NONE once ENTITY_TAG_MAX_IDS tags exist
+ */
+EseTagId entity_tag_intern(const char *tag);
+
+/**
+ * @brief Returns the id of a tag without interning it.
+ *
+ * @param tag Tag string (normalized before the lookup)
+ * @return The tag id, or ENTITY_TAG_NONE if no entity was ever given the tag
+ */
+EseTagId entity_tag_find(const char *tag);
+
+/**
+ * @brief Returns the normalized name of an interned tag.
+ *
+ * @param id Tag id from entity_tag_intern
+ * @return The tag name, or NULL for an unknown id
+ */
+const char *entity_tag_name(EseTagId id);
+
+/**
+ * @brief Returns the number of interned tags; every id is below it.
+ */
+size_t entity_tag_count(void);
+
+#endif // ESE_ENTITY_TAG_H
@@ -48,20 +48,6 @@ typedef struct {
 // PRIVATE FUNCTIONS
 // ========================================
 
-/**
- * @brief Checks if the system accepts this component type.
- *
- * @param self System manager instance
- * @param comp Component to check
- * @return true (accepts all component types)
- */
-static bool cleanup_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    (void)comp;
-    // Accept all component types
-    return true;
-}
-
 /**
  * @brief Called when a component is being removed.
  *
@@ -146,10 +132,7 @@ static EseSystemJobResult cleanup_sys_update(EseSystemManager *self, EseEngine *
             // Remove from entity's component array
             comp->vtable->unref(comp);
             entity_component_destroy(comp);
-
-            entity->components[idx] = entity->components[entity->component_count - 1];
-            entity->components[entity->component_count - 1] = NULL;
-            entity->component_count--;
+            _entity_component_remove_at(entity, (size_t)idx);
         }
 
         memory_manager.free(removal);
@@ -183,11 +166,13 @@ static void cleanup_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
  * @brief Virtual table for the cleanup system.
  */
 static const EseSystemManagerVTable CleanupSystemVTable = {
+    .name = "cleanup",
     .init = cleanup_sys_init,
     .update = cleanup_sys_update,
-    .accepts = cleanup_sys_accepts,
+    .component_mask = ENTITY_COMPONENT_MASK_ALL,
     .on_component_added = NULL,
     .on_component_removed = cleanup_sys_on_remove,
+    .writes = {.components = ENTITY_COMPONENT_MASK_ALL, .resources = SYS_RES_ENTITIES},
     .shutdown = cleanup_sys_shutdown};
 
 // ========================================
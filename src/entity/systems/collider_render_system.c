@@ -51,21 +51,6 @@ static void _collider_rect_callback(float screen_x, float screen_y, uint64_t z_i
 // PRIVATE FUNCTIONS
 // ========================================
 
-/**
- * @brief Checks if the system accepts this component type.
- *
- * @param self System manager instance
- * @param comp Component to check
- * @return true if component type is ENTITY_COMPONENT_COLLIDER
- */
-static bool collider_render_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    if (!comp) {
-        return false;
-    }
-    return comp->type == ENTITY_COMPONENT_COLLIDER;
-}
-
 /**
  * @brief Called when a collider component is added to an entity.
  *
@@ -86,6 +71,7 @@ static void collider_render_sys_on_add(EseSystemManager *self, EseEngine *eng,
     }
 
     // Add collider to tracking array
+    system_manager_track(self, comp, d->count);
     d->colliders[d->count++] = (EseEntityComponentCollider *)comp->data;
 }
 
@@ -102,12 +88,14 @@ static void collider_render_sys_on_remove(EseSystemManager *self, EseEngine *eng
     ColliderRenderSystemData *d = (ColliderRenderSystemData *)self->data;
     EseEntityComponentCollider *cc = (EseEntityComponentCollider *)comp->data;
 
-    // Find and remove collider from tracking array (swap with last element)
-    for (size_t i = 0; i < d->count; i++) {
-        if (d->colliders[i] == cc) {
-            d->colliders[i] = d->colliders[--d->count];
-            return;
-        }
+    // Remove collider from tracking array (swap with last element, found by its index)
+    size_t i = system_manager_tracked_index(self, comp);
+    if (i >= d->count || d->colliders[i] != cc) {
+        return;
+    }
+    d->colliders[i] = d->colliders[--d->count];
+    if (i < d->count) {
+        system_manager_track(self, &d->colliders[i]->base, i);
     }
 }
 
@@ -149,8 +137,8 @@ static EseSystemJobResult collider_render_sys_update(EseSystemManager *self, Ese
         }
 
         // Get entity world position
-        float entity_x = ese_point_get_x(cc->base.entity->position);
-        float entity_y = ese_point_get_y(cc->base.entity->position);
+        float entity_x = _entity_get_x(cc->base.entity);
+        float entity_y = _entity_get_y(cc->base.entity);
 
         // Convert world coordinates to screen coordinates using camera
         EseCamera *camera = engine_get_camera(eng);
@@ -231,11 +219,14 @@ static void _collider_rect_callback(float screen_x, float screen_y, uint64_t z_i
  * @brief Virtual table for the collider render system.
  */
 static const EseSystemManagerVTable ColliderRenderSystemVTable = {
+    .name = "collider_render",
     .init = collider_render_sys_init,
     .update = collider_render_sys_update,
-    .accepts = collider_render_sys_accepts,
+    .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_COLLIDER),
     .on_component_added = collider_render_sys_on_add,
     .on_component_removed = collider_render_sys_on_remove,
+    .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_COLLIDER),
+             .resources = SYS_RES_TRANSFORMS | SYS_RES_ENTITIES | SYS_RES_CAMERA},
     .shutdown = collider_render_sys_shutdown};
 
 // ========================================
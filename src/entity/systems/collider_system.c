@@ -7,6 +7,12 @@
  * that colliders themselves remain POD + Lua bindings and all behavior
  * lives in systems.
  *
+ * Bounds are written per collider, so the update runs as a parallel_for over
+ * the tracked array. The update only writes into existing world-bounds rects:
+ * the scheduler may run it on any worker, while the rects are allocated from
+ * the per-thread memory manager and freed on the main thread. Missing rects
+ * are therefore created in on_add, which runs on the main thread.
+ *
  * Copyright (c) 2025-2026 Entity Sprite Engine
  * See LICENSE.md for details.
  */
@@ -20,7 +26,9 @@
 #include "entity/components/entity_component_private.h"
 #include "entity/entity.h"
 #include "entity/entity_private.h"
+#include "utility/job_queue.h"
 #include "utility/log.h"
+#include "utility/spatial_index.h"
 
 // ========================================
 // Defines and Structs
@@ -38,25 +46,13 @@ typedef struct {
     size_t capacity;                        /** Allocated capacity of the array */
 } ColliderSystemData;
 
+// Smallest run of colliders a worker updates at once
+#define COLLIDER_SYSTEM_MIN_CHUNK 512
+
 // ========================================
 // PRIVATE FUNCTIONS
 // ========================================
 
-/**
- * @brief Checks if the system accepts this component type.
- *
- * @param self System manager instance
- * @param comp Component to check
- * @return true if component type is ENTITY_COMPONENT_COLLIDER
- */
-static bool collider_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    if (!comp) {
-        return false;
-    }
-    return comp->type == ENTITY_COMPONENT_COLLIDER;
-}
-
 /**
  * @brief Called when a collider component is added to an entity.
  *
@@ -65,13 +61,23 @@ static bool collider_sys_accepts(EseSystemManager *self, const EseEntityComponen
  * @param comp Component that was added
  */
 static void collider_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityComponent *comp) {
-    (void)eng;
     ColliderSystemData *d = (ColliderSystemData *)self->data;
 
     if (!comp || !comp->data) {
         return;
     }
 
+    // Register once with the persistent broadphase
+    if (comp->entity) {
+        spatial_index_register(eng->spatial_index, comp->entity);
+
+        // Create world bounds here, on the main thread, so update never allocates
+        if (comp->entity->collision_bounds && !comp->entity->collision_world_bounds) {
+            comp->entity->collision_world_bounds = ese_rect_create(comp->lua);
+            ese_rect_ref(comp->entity->collision_world_bounds);
+        }
+    }
+
     // Expand array if needed
     if (d->count == d->capacity) {
         d->capacity = d->capacity ? d->capacity * 2 : 64;
@@ -79,6 +85,7 @@ static void collider_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntit
             d->colliders, sizeof(EseEntityComponentCollider *) * d->capacity, MMTAG_ENGINE);
     }
 
+    system_manager_track(self, comp, d->count);
     d->colliders[d->count++] = (EseEntityComponentCollider *)comp->data;
 }
 
@@ -91,21 +98,36 @@ static void collider_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntit
  */
 static void collider_sys_on_remove(EseSystemManager *self, EseEngine *eng,
                                    EseEntityComponent *comp) {
-    (void)eng;
     ColliderSystemData *d = (ColliderSystemData *)self->data;
 
-    if (!comp || !comp->data || d->count == 0) {
+    if (!comp || !comp->data) {
+        return;
+    }
+
+    if (comp->entity) {
+        // Other colliders on the entity keep their layers, mask and static flag
+        entity_component_collider_sync_entity(comp->entity,
+                                              (EseEntityComponentCollider *)comp->data);
+        spatial_index_unregister(eng->spatial_index, comp->entity);
+        if (eng->collision_resolver && comp->entity->spatial_proxy == SPATIAL_INDEX_NULL_PROXY) {
+            collision_resolver_forget_entity(eng->collision_resolver, comp->entity);
+        }
+    }
+
+    if (d->count == 0) {
         return;
     }
 
     EseEntityComponentCollider *cc = (EseEntityComponentCollider *)comp->data;
 
-    // Find and remove collider from tracking array (swap with last element)
-    for (size_t i = 0; i < d->count; i++) {
-        if (d->colliders[i] == cc) {
-            d->colliders[i] = d->colliders[--d->count];
-            return;
-        }
+    // Remove collider from tracking array (swap with last element, found by its index)
+    size_t i = system_manager_tracked_index(self, comp);
+    if (i >= d->count || d->colliders[i] != cc) {
+        return;
+    }
+    d->colliders[i] = d->colliders[--d->count];
+    if (i < d->count) {
+        system_manager_track(self, &d->colliders[i]->base, i);
     }
 }
 
@@ -122,43 +144,55 @@ static void collider_sys_init(EseSystemManager *self, EseEngine *eng) {
 }
 
 /**
- * @brief Update all collider components' world bounds.
+ * @brief Update the world bounds of one chunk of the tracked colliders.
  *
- * @param self System manager instance
- * @param eng Engine pointer
- * @param dt Delta time (unused)
+ * @param user_data ColliderSystemData
+ * @param begin First collider index
+ * @param end One past the last collider index
  */
-static EseSystemJobResult collider_sys_update(EseSystemManager *self, EseEngine *eng, float dt) {
-    (void)eng;
-    (void)dt;
-    ColliderSystemData *d = (ColliderSystemData *)self->data;
+static void _collider_sys_chunk(void *user_data, size_t begin, size_t end) {
+    ColliderSystemData *d = (ColliderSystemData *)user_data;
 
-    for (size_t i = 0; i < d->count; i++) {
+    for (size_t i = begin; i < end; i++) {
         EseEntityComponentCollider *cc = d->colliders[i];
         if (!cc || !cc->base.entity || !cc->base.entity->active) {
             continue;
         }
 
-        if (!cc->base.entity->collision_bounds) {
-            continue;
-        }
-
         EseRect *entity_bounds = cc->base.entity->collision_bounds;
-
-        if (!cc->base.entity->collision_world_bounds) {
-            cc->base.entity->collision_world_bounds = ese_rect_create(cc->base.lua);
-        }
-
         EseRect *world_bounds = cc->base.entity->collision_world_bounds;
+        if (!entity_bounds || !world_bounds) {
+            continue;
+        }
 
         ese_rect_set_x(world_bounds,
-                       ese_rect_get_x(entity_bounds) + ese_point_get_x(cc->base.entity->position));
+                       ese_rect_get_x(entity_bounds) + _entity_get_x(cc->base.entity));
         ese_rect_set_y(world_bounds,
-                       ese_rect_get_y(entity_bounds) + ese_point_get_y(cc->base.entity->position));
+                       ese_rect_get_y(entity_bounds) + _entity_get_y(cc->base.entity));
         ese_rect_set_width(world_bounds, ese_rect_get_width(entity_bounds));
         ese_rect_set_height(world_bounds, ese_rect_get_height(entity_bounds));
         ese_rect_set_rotation(world_bounds, ese_rect_get_rotation(entity_bounds));
     }
+}
+
+/**
+ * @brief Update all collider components' world bounds.
+ *
+ * @param self System manager instance
+ * @param eng Engine pointer
+ * @param dt Delta time (unused)
+ */
+static EseSystemJobResult collider_sys_update(EseSystemManager *self, EseEngine *eng, float dt) {
+    (void)dt;
+    ColliderSystemData *d = (ColliderSystemData *)self->data;
+
+    EseJobQueue *queue = engine_get_job_queue(eng);
+    if (queue) {
+        ese_job_queue_parallel_for(queue, d->count, COLLIDER_SYSTEM_MIN_CHUNK, _collider_sys_chunk,
+                                   d);
+    } else {
+        _collider_sys_chunk(d, 0, d->count);
+    }
 
     EseSystemJobResult res = {0};
     return res;
@@ -185,11 +219,15 @@ static void collider_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
  * @brief Virtual table for the collider system.
  */
 static const EseSystemManagerVTable ColliderSystemVTable = {
+    .name = "collider",
     .init = collider_sys_init,
     .update = collider_sys_update,
-    .accepts = collider_sys_accepts,
+    .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_COLLIDER),
     .on_component_added = collider_sys_on_add,
     .on_component_removed = collider_sys_on_remove,
+    .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_COLLIDER),
+             .resources = SYS_RES_TRANSFORMS | SYS_RES_ENTITIES},
+    .writes = {.resources = SYS_RES_COLLISION},
     .shutdown = collider_sys_shutdown};
 
 // ========================================
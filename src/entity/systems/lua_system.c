@@ -1,10 +1,12 @@
 #include "entity/systems/lua_system.h"
+#include "core/engine.h"
 #include "core/engine_private.h"
 #include "core/memory_manager.h"
 #include "core/system_manager.h"
 #include "core/system_manager_private.h"
 #include "entity/components/entity_component_lua.h"
 #include "entity/components/entity_component_private.h"
+#include "entity/entity_private.h"
 #include "utility/log.h"
 #include "utility/profile.h"
 
@@ -12,24 +14,24 @@
 // Defines and Structs
 // ========================================
 
+// Most skipped time, in seconds, carried into a throttled entity's next entity_update; keeps
+// an entity that sat off-camera for minutes from receiving one huge step when it comes back
+#define LUA_SYS_MAX_PENDING_DT 1.0f
+
 typedef struct {
 	EseEntityComponentLua **components;
 	size_t count;
 	size_t capacity;
+
+	uint32_t frame;    /** Frames updated so far, drives ENTITY_UPDATE_INTERVAL */
+	uint32_t next_seq; /** update_seq of the next component to set up */
+	size_t cursor;     /** Where the next frame's walk starts, the first deferred component */
 } LuaSystemData;
 
 // ========================================
 // PRIVATE FUNCTIONS
 // ========================================
 
-static bool lua_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-	(void)self;
-	if (!comp) {
-		return false;
-	}
-	return comp->type == ENTITY_COMPONENT_LUA;
-}
-
 static void lua_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityComponent *comp) {
 	(void)eng;
 	LuaSystemData *d = (LuaSystemData *)self->data;
@@ -40,6 +42,7 @@ static void lua_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityComp
 		    d->components, sizeof(EseEntityComponentLua *) * d->capacity, MMTAG_ENGINE);
 	}
 
+	system_manager_track(self, comp, d->count);
 	d->components[d->count++] = (EseEntityComponentLua *)comp->data;
 }
 
@@ -48,11 +51,13 @@ static void lua_sys_on_remove(EseSystemManager *self, EseEngine *eng, EseEntityC
 	LuaSystemData *d = (LuaSystemData *)self->data;
 	EseEntityComponentLua *ptr = (EseEntityComponentLua *)comp->data;
 
-	for (size_t i = 0; i < d->count; i++) {
-		if (d->components[i] == ptr) {
-			d->components[i] = d->components[--d->count];
-			return;
-		}
+	size_t i = system_manager_tracked_index(self, comp);
+	if (i >= d->count || d->components[i] != ptr) {
+		return;
+	}
+	d->components[i] = d->components[--d->count];
+	if (i < d->count) {
+		system_manager_track(self, &d->components[i]->base, i);
 	}
 }
 
@@ -62,11 +67,59 @@ static void lua_sys_init(EseSystemManager *self, EseEngine *eng) {
 	self->data = d;
 }
 
+static bool _lua_sys_near_camera(const EseViewRect *view, const EseEntity *entity) {
+	float x = _entity_get_x(entity);
+	float y = _entity_get_y(entity);
+	float margin = entity->update_distance;
+	return x >= view->left - margin && x <= view->right + margin && y >= view->top - margin &&
+	       y <= view->bottom + margin;
+}
+
+/**
+ * @brief Decides whether a component runs entity_update this frame.
+ *
+ * @param spent Throttled updates run so far this frame; counts this one if it runs.
+ */
+static bool _lua_sys_due(LuaSystemData *d, const EseViewRect *view, uint32_t budget,
+                         uint32_t *spent, EseEntityComponentLua *component) {
+	const EseEntity *entity = component->base.entity;
+
+	switch (entity->update_mode) {
+	case ENTITY_UPDATE_INTERVAL:
+		if (!component->update_overdue &&
+		    (d->frame + component->update_seq) % entity->update_interval != 0) {
+			return false;
+		}
+		if (budget > 0 && *spent >= budget) {
+			component->update_overdue = true;
+			return false;
+		}
+		(*spent)++;
+		component->update_overdue = false;
+		return true;
+	case ENTITY_UPDATE_NEAR_CAMERA:
+		return _lua_sys_near_camera(view, entity);
+	case ENTITY_UPDATE_EVERY_FRAME:
+	default:
+		return true;
+	}
+}
+
 static EseSystemJobResult lua_sys_update(EseSystemManager *self, EseEngine *eng, float dt) {
-	(void)eng;
 	LuaSystemData *d = (LuaSystemData *)self->data;
 
-	for (size_t i = 0; i < d->count; i++) {
+	EseViewRect view;
+	engine_get_view_rect(eng, &view);
+
+	// Start at the first component the budget deferred last frame, so deferred
+	// updates are served first and no part of the array is starved
+	uint32_t budget = eng->lua_update_budget;
+	uint32_t spent = 0;
+	size_t start = d->cursor < d->count ? d->cursor : 0;
+	bool deferred = false;
+
+	for (size_t n = 0; n < d->count; n++) {
+		size_t i = (start + n) % d->count;
 		EseEntityComponentLua *component = d->components[i];
 
 		profile_start(PROFILE_ENTITY_COMP_LUA_UPDATE);
@@ -87,6 +140,8 @@ static EseSystemJobResult lua_sys_update(EseSystemManager *self, EseEngine *eng,
 				continue;
 			}
 
+			component->update_seq = d->next_seq++;
+
 			profile_start(PROFILE_ENTITY_COMP_LUA_FUNCTION_CACHE);
 			_entity_component_lua_cache_functions(component);
 			profile_stop(PROFILE_ENTITY_COMP_LUA_FUNCTION_CACHE, "entity_comp_lua_function_cache");
@@ -98,14 +153,33 @@ static EseSystemJobResult lua_sys_update(EseSystemManager *self, EseEngine *eng,
 			profile_count_add("entity_comp_lua_update_first_time_setup");
 		}
 
+		if (!_lua_sys_due(d, &view, budget, &spent, component)) {
+			if (component->update_overdue && !deferred) {
+				d->cursor = i;
+				deferred = true;
+			}
+			component->pending_dt += dt;
+			if (component->pending_dt > LUA_SYS_MAX_PENDING_DT) {
+				component->pending_dt = LUA_SYS_MAX_PENDING_DT;
+			}
+			profile_cancel(PROFILE_ENTITY_COMP_LUA_UPDATE);
+			profile_count_add("entity_comp_lua_update_skipped");
+			continue;
+		}
+
 		profile_start(PROFILE_ENTITY_COMP_LUA_FUNCTION_RUN);
-		lua_value_set_number(component->arg, dt);
+		lua_value_set_number(component->arg, dt + component->pending_dt);
+		component->pending_dt = 0.0f;
 		EseLuaValue *args[] = {component->arg};
 		entity_component_lua_run(component, component->base.entity, "entity_update", 1, args);
 		profile_stop(PROFILE_ENTITY_COMP_LUA_FUNCTION_RUN, "entity_comp_lua_update_function");
 
 		profile_stop(PROFILE_ENTITY_COMP_LUA_UPDATE, "lua_system_component_update");
 	}
+	if (!deferred) {
+		d->cursor = 0;
+	}
+	d->frame++;
 
 	EseSystemJobResult res = {0};
 	return res;
@@ -123,11 +197,14 @@ static void lua_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
 }
 
 static const EseSystemManagerVTable LuaSystemVTable = {
+	.name = "lua",
 	.init = lua_sys_init,
 	.update = lua_sys_update,
-	.accepts = lua_sys_accepts,
+	.component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_LUA),
 	.on_component_added = lua_sys_on_add,
 	.on_component_removed = lua_sys_on_remove,
+	.reads = {.components = SYS_LUA_COMPONENTS, .resources = SYS_LUA_RESOURCES},
+	.writes = {.components = SYS_LUA_COMPONENTS, .resources = SYS_LUA_RESOURCES},
 	.shutdown = lua_sys_shutdown};
 
 // ========================================
@@ -44,14 +44,6 @@ typedef struct {
 // entity_component_map.c.
 void _entity_component_map_cache_functions(EseEntityComponentMap *component);
 
-static bool map_lua_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    if (!comp) {
-        return false;
-    }
-    return comp->type == ENTITY_COMPONENT_MAP;
-}
-
 static void map_lua_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityComponent *comp) {
     (void)eng;
     MapLuaSystemData *d = (MapLuaSystemData *)self->data;
@@ -66,6 +58,7 @@ static void map_lua_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntity
                                          MMTAG_ENGINE);
     }
 
+    system_manager_track(self, comp, d->count);
     d->maps[d->count++] = (EseEntityComponentMap *)comp->data;
 }
 
@@ -80,11 +73,13 @@ static void map_lua_sys_on_remove(EseSystemManager *self, EseEngine *eng,
 
     EseEntityComponentMap *mc = (EseEntityComponentMap *)comp->data;
 
-    for (size_t i = 0; i < d->count; i++) {
-        if (d->maps[i] == mc) {
-            d->maps[i] = d->maps[--d->count];
-            return;
-        }
+    size_t i = system_manager_tracked_index(self, comp);
+    if (i >= d->count || d->maps[i] != mc) {
+        return;
+    }
+    d->maps[i] = d->maps[--d->count];
+    if (i < d->count) {
+        system_manager_track(self, &d->maps[i]->base, i);
     }
 }
 
@@ -168,11 +163,14 @@ static void map_lua_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
 }
 
 static const EseSystemManagerVTable MapLuaSystemVTable = {
+    .name = "map_lua",
     .init = map_lua_sys_init,
     .update = map_lua_sys_update,
-    .accepts = map_lua_sys_accepts,
+    .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_MAP),
     .on_component_added = map_lua_sys_on_add,
     .on_component_removed = map_lua_sys_on_remove,
+    .reads = {.components = SYS_LUA_COMPONENTS, .resources = SYS_LUA_RESOURCES},
+    .writes = {.components = SYS_LUA_COMPONENTS, .resources = SYS_LUA_RESOURCES},
     .shutdown = map_lua_sys_shutdown};
 
 // ========================================
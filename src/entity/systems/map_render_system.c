@@ -9,7 +9,13 @@
  * The system maintains a dynamic array of map component pointers for efficient
  * rendering. Components are added/removed via callbacks. During update, maps
  * are rendered with proper camera-relative positioning and map type handling
- * (grid, hex, isometric).
+ * (grid, hex, isometric). Only the cells inside the camera view are visited.
+ * Grid maps are baked into MAP_CHUNK_CELLS x MAP_CHUNK_CELLS chunk meshes that
+ * are rebuilt only after the component's revision changes, so a visible chunk
+ * costs one draw list object per layer and texture instead of one per tile.
+ * Chunks are baked and evicted during update, which the scheduler may run on
+ * any worker, so their memory comes from the shared allocator rather than the
+ * per-thread one.
  *
  * Copyright (c) 2025-2026 Entity Sprite Engine
  * See LICENSE.md for details.
@@ -31,66 +37,109 @@
 #include "types/rect.h"
 #include "utility/log.h"
 #include <math.h>
+#include <string.h>
  
 // ========================================
 // Defines and Structs
 // ========================================
 
+/** Width and height of a grid map chunk, in cells */
+#define MAP_CHUNK_CELLS 32
+
+/** Frames a baked chunk may stay out of view before its meshes are freed */
+#define MAP_CHUNK_EVICT_FRAMES 120
+
+/**
+* @brief Baked quads of one layer of a chunk that share a texture.
+*/
+typedef struct MapChunkBatch {
+    char *texture_id;         /** Texture of every quad in the batch (owned) */
+    size_t layer;             /** Map layer the quads come from */
+    EseDrawListVertex *verts; /** Four vertices per tile, relative to the chunk's top-left */
+    size_t vert_count;        /** Number of vertices in use */
+    size_t vert_capacity;     /** Allocated capacity of verts */
+} MapChunkBatch;
+
+/**
+* @brief Baked tiles of one MAP_CHUNK_CELLS x MAP_CHUNK_CELLS block of a grid map.
+*/
+typedef struct MapChunk {
+    MapChunkBatch *batches; /** One batch per layer and texture */
+    size_t batch_count;     /** Number of batches in use */
+    size_t batch_capacity;  /** Allocated capacity of batches */
+    uint32_t revision;      /** Component revision the chunk was baked at */
+    uint64_t last_frame;    /** Last frame the chunk was in view */
+    bool built;             /** Whether the batches hold a bake */
+    bool incomplete;        /** A sprite was not loaded during the bake, so bake again */
+} MapChunk;
+
+/**
+* @brief Chunk meshes cached for one map component.
+*
+* The chunks are dropped whenever the map, its size, the tile size or the seed
+* differ from what they were baked with.
+*/
+typedef struct MapChunkCache {
+    EseMap *map;     /** Map the chunks were baked from */
+    int size;        /** Tile size the chunks were baked with */
+    uint32_t seed;   /** Seed the chunks were baked with */
+    int map_width;   /** Map width in cells when the chunks were allocated */
+    int map_height;  /** Map height in cells when the chunks were allocated */
+    int chunks_w;    /** Chunks per row */
+    int chunks_h;    /** Chunks per column */
+    MapChunk *chunks; /** chunks_w * chunks_h chunks in row-major order */
+} MapChunkCache;
+
 /**
 * @brief Internal data for the map render system.
 *
 * Maintains a dynamically-sized array of map component pointers for efficient
-* rendering during the LATE phase.
+* rendering during the LATE phase, with each component's chunk cache at the
+* same index.
 */
 typedef struct {
     EseEntityComponentMap **maps; /** Array of map component pointers */
+    MapChunkCache *caches;        /** Chunk cache of each tracked map */
     size_t count;                 /** Current number of tracked maps */
-    size_t capacity;              /** Allocated capacity of the array */
+    size_t capacity;              /** Allocated capacity of the arrays */
+    uint32_t *quad_indices;       /** Triangle indices shared by every chunk batch */
+    uint64_t frame;               /** Number of updates run so far */
 } MapRenderSystemData;
 
 // ========================================
 // PRIVATE FORWARD DECLARATIONS
 // ========================================
  
-static bool map_render_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp);
 static void map_render_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityComponent *comp);
 static void map_render_sys_on_remove(EseSystemManager *self, EseEngine *eng,
                                     EseEntityComponent *comp);
 static void map_render_sys_init(EseSystemManager *self, EseEngine *eng);
 static EseSystemJobResult map_render_sys_update(EseSystemManager *self, EseEngine *eng, float dt);
 static void map_render_sys_shutdown(EseSystemManager *self, EseEngine *eng);
-static void _map_render_draw(EseEntityComponentMap *component, float screen_x, float screen_y,
-                            EntityDrawTextureCallback texCallback, void *callback_user_data);
-static void _map_render_draw_grid(EseEntityComponentMap *component, float screen_x, float screen_y,
-                                EntityDrawTextureCallback texCallback, void *callback_user_data);
-static void _map_render_draw_hex_point_up(EseEntityComponentMap *component, float screen_x,
-                                        float screen_y, EntityDrawTextureCallback texCallback,
+static void _map_render_draw(MapRenderSystemData *d, MapChunkCache *cache, EseEngine *engine,
+                            EseEntityComponentMap *component, float screen_x, float screen_y,
+                            float view_w, float view_h, EseDrawList *draw_list);
+static void _map_render_draw_grid(MapRenderSystemData *d, MapChunkCache *cache,
+                                EseEngine *engine, EseEntityComponentMap *component,
+                                float screen_x, float screen_y, float view_w, float view_h,
+                                EseDrawList *draw_list);
+static void _map_render_draw_hex_point_up(EseEngine *engine, EseEntityComponentMap *component,
+                                        float screen_x, float screen_y, float view_w,
+                                        float view_h, EntityDrawTextureCallback texCallback,
                                         void *callback_user_data);
-static void _map_render_draw_hex_flat_up(EseEntityComponentMap *component, float screen_x,
-                                        float screen_y, EntityDrawTextureCallback texCallback,
+static void _map_render_draw_hex_flat_up(EseEngine *engine, EseEntityComponentMap *component,
+                                        float screen_x, float screen_y, float view_w,
+                                        float view_h, EntityDrawTextureCallback texCallback,
                                         void *callback_user_data);
-static void _map_render_draw_iso(EseEntityComponentMap *component, float screen_x, float screen_y,
+static void _map_render_draw_iso(EseEngine *engine, EseEntityComponentMap *component,
+                                float screen_x, float screen_y, float view_w, float view_h,
                                 EntityDrawTextureCallback texCallback, void *callback_user_data);
+static void _map_render_cache_clear(MapChunkCache *cache);
 
 // ========================================
 // PRIVATE FUNCTIONS
 // ========================================
 
-/**
-* @brief Checks if the system accepts this component type.
-*
-* @param self System manager instance
-* @param comp Component to check
-* @return true if component type is ENTITY_COMPONENT_MAP
-*/
-static bool map_render_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    if (!comp) {
-        return false;
-    }
-    return comp->type == ENTITY_COMPONENT_MAP;
-}
-
 /**
 * @brief Called when a map component is added to an entity.
 *
@@ -103,14 +152,18 @@ static void map_render_sys_on_add(EseSystemManager *self, EseEngine *eng,
     (void)eng;
     MapRenderSystemData *d = (MapRenderSystemData *)self->data;
 
-    // Expand array if needed
+    // Expand arrays if needed
     if (d->count == d->capacity) {
         d->capacity = d->capacity ? d->capacity * 2 : 64;
         d->maps = memory_manager.realloc(d->maps, sizeof(EseEntityComponentMap *) * d->capacity,
                                         MMTAG_RS_MAP);
+        d->caches = memory_manager.realloc(d->caches, sizeof(MapChunkCache) * d->capacity,
+                                          MMTAG_RS_MAP);
     }
 
     // Add map to tracking array
+    system_manager_track(self, comp, d->count);
+    memset(&d->caches[d->count], 0, sizeof(MapChunkCache));
     d->maps[d->count++] = (EseEntityComponentMap *)comp->data;
 }
 
@@ -127,12 +180,16 @@ static void map_render_sys_on_remove(EseSystemManager *self, EseEngine *eng,
     MapRenderSystemData *d = (MapRenderSystemData *)self->data;
     EseEntityComponentMap *mc = (EseEntityComponentMap *)comp->data;
 
-    // Find and remove map from tracking array (swap with last element)
-    for (size_t i = 0; i < d->count; i++) {
-        if (d->maps[i] == mc) {
-            d->maps[i] = d->maps[--d->count];
-            return;
-        }
+    // Remove map from tracking array (swap with last element, found by its index)
+    size_t i = system_manager_tracked_index(self, comp);
+    if (i >= d->count || d->maps[i] != mc) {
+        return;
+    }
+    _map_render_cache_clear(&d->caches[i]);
+    d->maps[i] = d->maps[--d->count];
+    d->caches[i] = d->caches[d->count];
+    if (i < d->count) {
+        system_manager_track(self, &d->maps[i]->base, i);
     }
 }
 
@@ -145,6 +202,20 @@ static void map_render_sys_on_remove(EseSystemManager *self, EseEngine *eng,
 static void map_render_sys_init(EseSystemManager *self, EseEngine *eng) {
     (void)eng;
     MapRenderSystemData *d = memory_manager.calloc(1, sizeof(MapRenderSystemData), MMTAG_RS_MAP);
+
+    // Every chunk batch is a run of quads, so one index buffer serves them all
+    const size_t quads = MAP_CHUNK_CELLS * MAP_CHUNK_CELLS;
+    d->quad_indices = memory_manager.malloc(sizeof(uint32_t) * quads * 6, MMTAG_RS_MAP);
+    for (uint32_t q = 0; q < quads; q++) {
+        uint32_t *idx = &d->quad_indices[q * 6];
+        idx[0] = q * 4 + 0;
+        idx[1] = q * 4 + 1;
+        idx[2] = q * 4 + 2;
+        idx[3] = q * 4 + 0;
+        idx[4] = q * 4 + 2;
+        idx[5] = q * 4 + 3;
+    }
+
     self->data = d;
 }
 
@@ -167,6 +238,15 @@ static EseSystemJobResult map_render_sys_update(EseSystemManager *self, EseEngin
         return res;
     }
 
+    d->frame++;
+
+    // The camera does not move during the update, so the view is shared by all maps
+    EseViewRect view;
+    engine_get_view_rect(eng, &view);
+    float view_w = view.right - view.left;
+    float view_h = view.bottom - view.top;
+    EseDrawList *draw_list = engine_get_draw_list(eng);
+
     for (size_t i = 0; i < d->count; i++) {
         EseEntityComponentMap *map = d->maps[i];
         if (!map || !map->base.entity || !map->base.entity->active || !map->base.entity->visible ||
@@ -177,27 +257,13 @@ static EseSystemJobResult map_render_sys_update(EseSystemManager *self, EseEngin
             continue;
         }
 
-        // Get entity world position
-        float entity_x = ese_point_get_x(map->base.entity->position);
-        float entity_y = ese_point_get_y(map->base.entity->position);
-
-        // Convert world coordinates to screen coordinates using camera
-        EseCamera *camera = engine_get_camera(eng);
-        EseDisplay *display = engine_get_display(eng);
-        float camera_x = ese_point_get_x(camera->position);
-        float camera_y = ese_point_get_y(camera->position);
-        float view_width = ese_display_get_viewport_width(display);
-        float view_height = ese_display_get_viewport_height(display);
-
-        float view_left = camera_x - view_width / 2.0f;
-        float view_top = camera_y - view_height / 2.0f;
-
-        float screen_x = entity_x - view_left;
-        float screen_y = entity_y - view_top;
+        // Convert the entity's world position to screen coordinates
+        float screen_x = _entity_get_x(map->base.entity) - view.left;
+        float screen_y = _entity_get_y(map->base.entity) - view.top;
 
         // Render map to draw list
-        EseDrawList *draw_list = engine_get_draw_list(eng);
-        _map_render_draw(map, screen_x, screen_y, _engine_add_texture_to_draw_list, draw_list);
+        _map_render_draw(d, &d->caches[i], eng, map, screen_x, screen_y, view_w, view_h,
+                         draw_list);
     }
 
     EseSystemJobResult res = {0};
@@ -216,44 +282,346 @@ static void map_render_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
     (void)eng;
     MapRenderSystemData *d = (MapRenderSystemData *)self->data;
     if (d) {
+        for (size_t i = 0; i < d->count; i++) {
+            _map_render_cache_clear(&d->caches[i]);
+        }
         if (d->maps) {
             memory_manager.free(d->maps);
         }
+        if (d->caches) {
+            memory_manager.free(d->caches);
+        }
+        memory_manager.free(d->quad_indices);
         memory_manager.free(d);
         self->data = NULL;
     }
 }
 
+/**
+* @brief Clamps a range of cell indices to [0, count - 1].
+*
+* @param first Lowest index that may be visible
+* @param last Highest index that may be visible
+* @param count Number of cells along the axis
+* @param out_first Receives the first index to draw
+* @param out_last Receives the last index to draw
+* @return false if no index in the range exists
+*/
+static bool _map_render_clamp_range(float first, float last, int count, int *out_first,
+                                   int *out_last) {
+    first = floorf(first);
+    last = ceilf(last);
+    if (count <= 0 || last < 0.0f || first > (float)(count - 1) || first > last) {
+        return false;
+    }
+    *out_first = first < 0.0f ? 0 : (int)first;
+    *out_last = last > (float)(count - 1) ? count - 1 : (int)last;
+    return true;
+}
+
+/**
+* @brief Finds the cells along one axis whose span touches [0, limit] on screen.
+*
+* Cell i covers [origin + i * step, origin + i * step + extent]. The range is
+* rounded outwards, so it may include one hidden cell on each side.
+*
+* @param origin Screen coordinate of cell 0
+* @param step Distance between neighbouring cells
+* @param extent Screen size of one cell, including any row or column offset
+* @param limit Viewport size along the axis
+* @param count Number of cells along the axis
+* @param out_first Receives the first index to draw
+* @param out_last Receives the last index to draw
+* @return false if no cell is visible
+*/
+static bool _map_render_visible_span(float origin, float step, float extent, float limit,
+                                    int count, int *out_first, int *out_last) {
+    if (step <= 0.0f) {
+        return false;
+    }
+    return _map_render_clamp_range((-extent - origin) / step, (limit - origin) / step, count,
+                                   out_first, out_last);
+}
+
+/**
+* @brief Seeds the tileset for one cell.
+*
+* Each cell gets its own seed so weighted sprite variants do not depend on
+* which cells are visible or in what order they are drawn.
+*
+* @param tileset Tileset of the map
+* @param seed Component seed
+* @param cell_index Cell index, y * width + x
+*/
+static void _map_render_seed_cell(EseTileSet *tileset, uint32_t seed, uint32_t cell_index) {
+    uint32_t h = seed ^ (cell_index * 0x9E3779B9u);
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    // A seed of 0 makes the tileset reseed from the clock
+    ese_tileset_set_seed(tileset, h ? h : 1);
+}
+
+/**
+* @brief Whether a layer is shown by the component.
+*/
+static bool _map_render_layer_shown(const EseEntityComponentMap *component, size_t layer) {
+    return layer < component->show_layer_count && component->show_layer[layer];
+}
+
+/**
+* @brief Draws every shown layer of one cell as separate textures.
+*
+* Used by hex and isometric maps, whose tiles overlap and must be drawn in
+* cell order.
+*/
+static void _map_render_draw_cell(EseEngine *engine, EseEntityComponentMap *component,
+                                 EseTileSet *tileset, uint32_t x, uint32_t y, int mw, float dx,
+                                 float dy, int tw, int th, EntityDrawTextureCallback texCallback,
+                                 void *callback_user_data) {
+    EseMapCell *cell = ese_map_get_cell(component->map, x, y);
+    uint32_t cell_index = y * mw + x;
+    _map_render_seed_cell(tileset, component->seed, cell_index);
+
+    for (size_t i = 0; i < ese_map_cell_get_layer_count(cell); i++) {
+        int tid = ese_map_cell_get_layer(cell, i);
+        if (tid == -1 || !_map_render_layer_shown(component, i)) {
+            continue;
+        }
+
+        const char *sprite_id = ese_tileset_get_sprite(tileset, tid);
+        if (!sprite_id) {
+            continue;
+        }
+
+        EseSprite *sprite = engine_get_sprite(engine, sprite_id);
+        if (!sprite) {
+            continue;
+        }
+
+        uint64_t z_index = component->base.entity->draw_order;
+        z_index += cell_index;
+
+        const char *texture_id;
+        float x1, y1, x2, y2;
+        int w, h;
+        sprite_get_frame(sprite, component->sprite_frames[cell_index], &texture_id, &x1, &y1, &x2,
+                        &y2, &w, &h);
+
+        texCallback(dx, dy, tw, th, z_index, texture_id, x1, y1, x2, y2, w, h,
+                    callback_user_data);
+    }
+}
+
+/**
+* @brief Frees the meshes of a chunk so it is baked again when next visible.
+*/
+static void _map_render_chunk_clear(MapChunk *chunk) {
+    for (size_t i = 0; i < chunk->batch_count; i++) {
+        memory_manager.shared.free(chunk->batches[i].texture_id);
+        memory_manager.shared.free(chunk->batches[i].verts);
+    }
+    if (chunk->batches) {
+        memory_manager.shared.free(chunk->batches);
+    }
+    memset(chunk, 0, sizeof(MapChunk));
+}
+
+/**
+* @brief Frees every chunk of a cache.
+*/
+static void _map_render_cache_clear(MapChunkCache *cache) {
+    if (cache->chunks) {
+        for (int i = 0; i < cache->chunks_w * cache->chunks_h; i++) {
+            _map_render_chunk_clear(&cache->chunks[i]);
+        }
+        memory_manager.shared.free(cache->chunks);
+    }
+    memset(cache, 0, sizeof(MapChunkCache));
+}
+
+/**
+* @brief Makes sure the cache's chunks were baked for the component's current settings.
+*/
+static void _map_render_cache_prepare(MapChunkCache *cache, EseEntityComponentMap *component,
+                                     int mw, int mh) {
+    if (cache->chunks && cache->map == component->map && cache->size == component->size &&
+        cache->seed == component->seed && cache->map_width == mw && cache->map_height == mh) {
+        return;
+    }
+
+    _map_render_cache_clear(cache);
+    cache->map = component->map;
+    cache->size = component->size;
+    cache->seed = component->seed;
+    cache->map_width = mw;
+    cache->map_height = mh;
+    cache->chunks_w = (mw + MAP_CHUNK_CELLS - 1) / MAP_CHUNK_CELLS;
+    cache->chunks_h = (mh + MAP_CHUNK_CELLS - 1) / MAP_CHUNK_CELLS;
+    cache->chunks = memory_manager.shared.calloc((size_t)cache->chunks_w * cache->chunks_h,
+                                                 sizeof(MapChunk), MMTAG_RS_MAP);
+}
+
+/**
+* @brief Finds or adds the batch of a chunk for a layer and texture.
+*/
+static MapChunkBatch *_map_render_chunk_batch(MapChunk *chunk, size_t layer,
+                                             const char *texture_id) {
+    for (size_t i = 0; i < chunk->batch_count; i++) {
+        MapChunkBatch *batch = &chunk->batches[i];
+        if (batch->layer == layer && strcmp(batch->texture_id, texture_id) == 0) {
+            return batch;
+        }
+    }
+
+    if (chunk->batch_count == chunk->batch_capacity) {
+        chunk->batch_capacity = chunk->batch_capacity ? chunk->batch_capacity * 2 : 4;
+        chunk->batches = memory_manager.shared.realloc(
+            chunk->batches, sizeof(MapChunkBatch) * chunk->batch_capacity, MMTAG_RS_MAP);
+    }
+
+    MapChunkBatch *batch = &chunk->batches[chunk->batch_count++];
+    memset(batch, 0, sizeof(MapChunkBatch));
+    batch->texture_id = memory_manager.shared.strdup(texture_id, MMTAG_RS_MAP);
+    batch->layer = layer;
+    return batch;
+}
+
+/**
+* @brief Bakes the tiles of one chunk into per-layer, per-texture quad lists.
+*
+* Every layer is baked, hidden or not, so showing and hiding layers needs no
+* rebuild.
+*/
+static void _map_render_chunk_bake(MapChunk *chunk, EseEngine *engine,
+                                  EseEntityComponentMap *component, int chunk_x, int chunk_y,
+                                  int mw, int mh) {
+    // Keep the allocations of the previous bake
+    for (size_t i = 0; i < chunk->batch_count; i++) {
+        chunk->batches[i].vert_count = 0;
+    }
+    chunk->incomplete = false;
+
+    EseTileSet *tileset = ese_map_get_tileset(component->map);
+    const float tw = (float)component->size;
+    const float th = (float)component->size;
+    const int x0 = chunk_x * MAP_CHUNK_CELLS;
+    const int y0 = chunk_y * MAP_CHUNK_CELLS;
+    const int x1 = x0 + MAP_CHUNK_CELLS < mw ? x0 + MAP_CHUNK_CELLS : mw;
+    const int y1 = y0 + MAP_CHUNK_CELLS < mh ? y0 + MAP_CHUNK_CELLS : mh;
+
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            EseMapCell *cell = ese_map_get_cell(component->map, x, y);
+            uint32_t cell_index = (uint32_t)(y * mw + x);
+            _map_render_seed_cell(tileset, component->seed, cell_index);
+
+            float left = (x - x0) * tw;
+            float top = (y - y0) * th;
+
+            for (size_t i = 0; i < ese_map_cell_get_layer_count(cell); i++) {
+                int tid = ese_map_cell_get_layer(cell, i);
+                if (tid == -1) {
+                    continue;
+                }
+
+                const char *sprite_id = ese_tileset_get_sprite(tileset, tid);
+                if (!sprite_id) {
+                    continue;
+                }
+
+                EseSprite *sprite = engine_get_sprite(engine, sprite_id);
+                if (!sprite) {
+                    // The atlas may not be loaded yet
+                    chunk->incomplete = true;
+                    continue;
+                }
+
+                const char *texture_id;
+                float u0, v0, u1, v1;
+                int w, h;
+                sprite_get_frame(sprite, component->sprite_frames[cell_index], &texture_id, &u0,
+                                &v0, &u1, &v1, &w, &h);
+
+                MapChunkBatch *batch = _map_render_chunk_batch(chunk, i, texture_id);
+                if (batch->vert_count + 4 > batch->vert_capacity) {
+                    batch->vert_capacity = batch->vert_capacity ? batch->vert_capacity * 2 : 64;
+                    batch->verts = memory_manager.shared.realloc(
+                        batch->verts, sizeof(EseDrawListVertex) * batch->vert_capacity,
+                        MMTAG_RS_MAP);
+                }
+
+                // Top-left, bottom-left, bottom-right, top-right
+                EseDrawListVertex *v = &batch->verts[batch->vert_count];
+                v[0] = (EseDrawListVertex){left, top, u0, v0, 255, 255, 255, 255};
+                v[1] = (EseDrawListVertex){left, top + th, u0, v1, 255, 255, 255, 255};
+                v[2] = (EseDrawListVertex){left + tw, top + th, u1, v1, 255, 255, 255, 255};
+                v[3] = (EseDrawListVertex){left + tw, top, u1, v0, 255, 255, 255, 255};
+                batch->vert_count += 4;
+            }
+        }
+    }
+
+    // Drop batches whose texture is no longer used
+    size_t kept = 0;
+    for (size_t i = 0; i < chunk->batch_count; i++) {
+        if (chunk->batches[i].vert_count == 0) {
+            memory_manager.shared.free(chunk->batches[i].texture_id);
+            memory_manager.shared.free(chunk->batches[i].verts);
+            continue;
+        }
+        chunk->batches[kept++] = chunk->batches[i];
+    }
+    chunk->batch_count = kept;
+
+    chunk->revision = component->revision;
+    chunk->built = true;
+}
+
 /**
 * @brief Draw dispatcher for map components based on map type.
 *
+* @param d System data
+* @param cache Chunk cache of the component
+* @param engine Engine pointer
 * @param component Map component
 * @param screen_x Screen X offset
 * @param screen_y Screen Y offset
-* @param texCallback Texture draw callback
-* @param callback_user_data Draw list pointer
+* @param view_w Viewport width
+* @param view_h Viewport height
+* @param draw_list Draw list pointer
 */
-static void _map_render_draw(EseEntityComponentMap *component, float screen_x, float screen_y,
-                            EntityDrawTextureCallback texCallback, void *callback_user_data) {
+static void _map_render_draw(MapRenderSystemData *d, MapChunkCache *cache, EseEngine *engine,
+                            EseEntityComponentMap *component, float screen_x, float screen_y,
+                            float view_w, float view_h, EseDrawList *draw_list) {
     if (!component || !component->map) {
         log_debug("MAP_RENDER_SYS", "map not set or NULL component");
         return;
     }
 
-    switch (ese_map_get_type(component->map)) {
+    EseMapType type = ese_map_get_type(component->map);
+    if (type != MAP_TYPE_GRID && cache->chunks) {
+        _map_render_cache_clear(cache);
+    }
+
+    switch (type) {
     case MAP_TYPE_GRID:
-        _map_render_draw_grid(component, screen_x, screen_y, texCallback, callback_user_data);
+        _map_render_draw_grid(d, cache, engine, component, screen_x, screen_y, view_w, view_h,
+                              draw_list);
         break;
     case MAP_TYPE_HEX_POINT_UP:
-        _map_render_draw_hex_point_up(component, screen_x, screen_y, texCallback,
-                                    callback_user_data);
+        _map_render_draw_hex_point_up(engine, component, screen_x, screen_y, view_w, view_h,
+                                      _engine_add_texture_to_draw_list, draw_list);
         break;
     case MAP_TYPE_HEX_FLAT_UP:
-        _map_render_draw_hex_flat_up(component, screen_x, screen_y, texCallback,
-                                    callback_user_data);
+        _map_render_draw_hex_flat_up(engine, component, screen_x, screen_y, view_w, view_h,
+                                     _engine_add_texture_to_draw_list, draw_list);
         break;
     case MAP_TYPE_ISO:
-        _map_render_draw_iso(component, screen_x, screen_y, texCallback, callback_user_data);
+        _map_render_draw_iso(engine, component, screen_x, screen_y, view_w, view_h,
+                             _engine_add_texture_to_draw_list, draw_list);
         break;
     default:
         log_debug("MAP_RENDER_SYS", "unknown map type");
@@ -262,14 +630,16 @@ static void _map_render_draw(EseEntityComponentMap *component, float screen_x, f
 }
 
 /**
-* @brief Draws a standard grid map.
+* @brief Draws a standard grid map from cached chunk meshes.
+*
+* Only chunks in view are baked and drawn; a chunk is baked again when the
+* component's revision moves past the one it was baked at. Chunks out of view
+* for MAP_CHUNK_EVICT_FRAMES frames are freed.
 */
-static void _map_render_draw_grid(EseEntityComponentMap *component, float screen_x, float screen_y,
-                                EntityDrawTextureCallback texCallback, void *callback_user_data) {
-    EseEngine *engine =
-        (EseEngine *)lua_engine_get_registry_key(component->base.lua->runtime, ENGINE_KEY);
-    ese_tileset_set_seed(ese_map_get_tileset(component->map), component->seed);
-
+static void _map_render_draw_grid(MapRenderSystemData *d, MapChunkCache *cache,
+                                EseEngine *engine, EseEntityComponentMap *component,
+                                float screen_x, float screen_y, float view_w, float view_h,
+                                EseDrawList *draw_list) {
     const int tw = component->size;
     const int th = component->size;
     float cx = ese_point_get_x(component->position);
@@ -277,55 +647,70 @@ static void _map_render_draw_grid(EseEntityComponentMap *component, float screen
     int mw = ese_map_get_width(component->map);
     int mh = ese_map_get_height(component->map);
 
-    for (uint32_t y = 0; y < (uint32_t)mh; y++) {
-        for (uint32_t x = 0; x < (uint32_t)mw; x++) {
-            EseMapCell *cell = ese_map_get_cell(component->map, x, y);
-            float dx = screen_x + (x - cx) * tw;
-            float dy = screen_y + (y - cy) * th;
-
-            for (size_t i = 0; i < ese_map_cell_get_layer_count(cell); i++) {
-                int tid = ese_map_cell_get_layer(cell, i);
-                if (tid == -1 || !component->show_layer[i]) {
-                    continue;
+    _map_render_cache_prepare(cache, component, mw, mh);
+
+    const float chunk_w = (float)tw * MAP_CHUNK_CELLS;
+    const float chunk_h = (float)th * MAP_CHUNK_CELLS;
+    const float origin_x = screen_x - cx * tw;
+    const float origin_y = screen_y - cy * th;
+
+    int first_x, last_x, first_y, last_y;
+    if (_map_render_visible_span(origin_x, chunk_w, chunk_w, view_w, cache->chunks_w, &first_x,
+                                 &last_x) &&
+        _map_render_visible_span(origin_y, chunk_h, chunk_h, view_h, cache->chunks_h, &first_y,
+                                 &last_y)) {
+        uint64_t draw_order = component->base.entity->draw_order;
+
+        for (int chunk_y = first_y; chunk_y <= last_y; chunk_y++) {
+            for (int chunk_x = first_x; chunk_x <= last_x; chunk_x++) {
+                MapChunk *chunk = &cache->chunks[chunk_y * cache->chunks_w + chunk_x];
+                if (!chunk->built || chunk->incomplete || chunk->revision != component->revision) {
+                    _map_render_chunk_bake(chunk, engine, component, chunk_x, chunk_y, mw, mh);
                 }
-
-                const char *sprite_id =
-                    ese_tileset_get_sprite(ese_map_get_tileset(component->map), tid);
-                if (!sprite_id) {
-                    continue;
+                chunk->last_frame = d->frame;
+
+                float left = origin_x + chunk_x * chunk_w;
+                float top = origin_y + chunk_y * chunk_h;
+                uint64_t first_cell =
+                    (uint64_t)chunk_y * MAP_CHUNK_CELLS * mw + (uint64_t)chunk_x * MAP_CHUNK_CELLS;
+
+                for (size_t i = 0; i < chunk->batch_count; i++) {
+                    MapChunkBatch *batch = &chunk->batches[i];
+                    if (!_map_render_layer_shown(component, batch->layer)) {
+                        continue;
+                    }
+
+                    uint64_t z_index = draw_order;
+                    z_index += ((uint64_t)(batch->layer * 2) << DRAW_ORDER_SHIFT);
+                    z_index += first_cell;
+
+                    EseDrawListObject *obj = draw_list_request_object(draw_list);
+                    draw_list_object_set_mesh(obj, batch->verts, batch->vert_count,
+                                              d->quad_indices, batch->vert_count / 4 * 6,
+                                              batch->texture_id);
+                    draw_list_object_set_bounds(obj, left, top, (int)chunk_w, (int)chunk_h);
+                    draw_list_object_set_z_index(obj, z_index);
                 }
-
-                EseSprite *sprite = engine_get_sprite(engine, sprite_id);
-                if (!sprite) {
-                    continue;
-                }
-
-                uint64_t z_index = component->base.entity->draw_order;
-                z_index += ((uint64_t)(i * 2) << DRAW_ORDER_SHIFT);
-                z_index += y * mw + x;
-
-                const char *texture_id;
-                float x1, y1, x2, y2;
-                int w, h;
-                sprite_get_frame(sprite, component->sprite_frames[y * mw + x], &texture_id, &x1,
-                                &y1, &x2, &y2, &w, &h);
-
-                texCallback(dx, dy, tw, th, z_index, texture_id, x1, y1, x2, y2, w, h,
-                            callback_user_data);
             }
         }
     }
+
+    for (int i = 0; i < cache->chunks_w * cache->chunks_h; i++) {
+        MapChunk *chunk = &cache->chunks[i];
+        if (chunk->built && d->frame - chunk->last_frame > MAP_CHUNK_EVICT_FRAMES) {
+            _map_render_chunk_clear(chunk);
+        }
+    }
 }
 
 /**
-* @brief Draws a hex map (point-up orientation).
+* @brief Draws the visible cells of a hex map (point-up orientation).
 */
-static void _map_render_draw_hex_point_up(EseEntityComponentMap *component, float screen_x,
-                                        float screen_y, EntityDrawTextureCallback texCallback,
+static void _map_render_draw_hex_point_up(EseEngine *engine, EseEntityComponentMap *component,
+                                        float screen_x, float screen_y, float view_w,
+                                        float view_h, EntityDrawTextureCallback texCallback,
                                         void *callback_user_data) {
-    EseEngine *engine =
-        (EseEngine *)lua_engine_get_registry_key(component->base.lua->runtime, ENGINE_KEY);
-    ese_tileset_set_seed(ese_map_get_tileset(component->map), component->seed);
+    EseTileSet *tileset = ese_map_get_tileset(component->map);
 
     const int th = component->size;
     const int tw = (int)(th * 0.866025f);
@@ -334,57 +719,37 @@ static void _map_render_draw_hex_point_up(EseEntityComponentMap *component, floa
     int mw = ese_map_get_width(component->map);
     int mh = ese_map_get_height(component->map);
 
-    for (uint32_t y = 0; y < (uint32_t)mh; y++) {
-        for (uint32_t x = 0; x < (uint32_t)mw; x++) {
-            EseMapCell *cell = ese_map_get_cell(component->map, x, y);
+    // Odd rows are shifted right by half a tile
+    int first_x, last_x, first_y, last_y;
+    if (!_map_render_visible_span(screen_x - cx * tw, tw, tw * 1.5f, view_w, mw, &first_x,
+                                  &last_x) ||
+        !_map_render_visible_span(screen_y - cy * (th * 0.75f), th * 0.75f, th, view_h, mh,
+                                  &first_y, &last_y)) {
+        return;
+    }
+
+    for (uint32_t y = first_y; y <= (uint32_t)last_y; y++) {
+        for (uint32_t x = first_x; x <= (uint32_t)last_x; x++) {
             float dx = screen_x + (x - cx) * tw;
             float dy = screen_y + (y - cy) * (th * 0.75f);
             if (y % 2 == 1) {
                 dx += tw / 2.0f;
             }
 
-            for (size_t i = 0; i < ese_map_cell_get_layer_count(cell); i++) {
-                int tid = ese_map_cell_get_layer(cell, i);
-                if (tid == -1 || !component->show_layer[i]) {
-                    continue;
-                }
-
-                const char *sprite_id =
-                    ese_tileset_get_sprite(ese_map_get_tileset(component->map), tid);
-                if (!sprite_id) {
-                    continue;
-                }
-
-                EseSprite *sprite = engine_get_sprite(engine, sprite_id);
-                if (!sprite) {
-                    continue;
-                }
-
-                uint64_t z_index = component->base.entity->draw_order;
-                z_index += y * mw + x;
-
-                const char *texture_id;
-                float x1, y1, x2, y2;
-                int w, h;
-                sprite_get_frame(sprite, component->sprite_frames[y * mw + x], &texture_id, &x1,
-                                &y1, &x2, &y2, &w, &h);
-
-                texCallback(dx, dy, tw, th, z_index, texture_id, x1, y1, x2, y2, w, h,
-                            callback_user_data);
-            }
+            _map_render_draw_cell(engine, component, tileset, x, y, mw, dx, dy, tw, th,
+                                  texCallback, callback_user_data);
         }
     }
 }
 
 /**
-* @brief Draws a hex map (flat-up orientation).
+* @brief Draws the visible cells of a hex map (flat-up orientation).
 */
-static void _map_render_draw_hex_flat_up(EseEntityComponentMap *component, float screen_x,
-                                        float screen_y, EntityDrawTextureCallback texCallback,
+static void _map_render_draw_hex_flat_up(EseEngine *engine, EseEntityComponentMap *component,
+                                        float screen_x, float screen_y, float view_w,
+                                        float view_h, EntityDrawTextureCallback texCallback,
                                         void *callback_user_data) {
-    EseEngine *engine =
-        (EseEngine *)lua_engine_get_registry_key(component->base.lua->runtime, ENGINE_KEY);
-    ese_tileset_set_seed(ese_map_get_tileset(component->map), component->seed);
+    EseTileSet *tileset = ese_map_get_tileset(component->map);
 
     const int th = component->size;
     const int tw = (int)(th * 1.154701f);
@@ -393,56 +758,36 @@ static void _map_render_draw_hex_flat_up(EseEntityComponentMap *component, float
     int mw = ese_map_get_width(component->map);
     int mh = ese_map_get_height(component->map);
 
-    for (uint32_t y = 0; y < (uint32_t)mh; y++) {
-        for (uint32_t x = 0; x < (uint32_t)mw; x++) {
-            EseMapCell *cell = ese_map_get_cell(component->map, x, y);
+    // Odd columns are shifted down by half a tile
+    int first_x, last_x, first_y, last_y;
+    if (!_map_render_visible_span(screen_x - cx * (tw * 0.75f), tw * 0.75f, tw, view_w, mw,
+                                  &first_x, &last_x) ||
+        !_map_render_visible_span(screen_y - cy * th, th, th * 1.5f, view_h, mh, &first_y,
+                                  &last_y)) {
+        return;
+    }
+
+    for (uint32_t y = first_y; y <= (uint32_t)last_y; y++) {
+        for (uint32_t x = first_x; x <= (uint32_t)last_x; x++) {
             float dx = screen_x + (x - cx) * (tw * 0.75f);
             float dy = screen_y + (y - cy) * th;
             if (x % 2 == 1) {
                 dy += th / 2.0f;
             }
 
-            for (size_t i = 0; i < ese_map_cell_get_layer_count(cell); i++) {
-                int tid = ese_map_cell_get_layer(cell, i);
-                if (tid == -1 || !component->show_layer[i]) {
-                    continue;
-                }
-
-                const char *sprite_id =
-                    ese_tileset_get_sprite(ese_map_get_tileset(component->map), tid);
-                if (!sprite_id) {
-                    continue;
-                }
-
-                EseSprite *sprite = engine_get_sprite(engine, sprite_id);
-                if (!sprite) {
-                    continue;
-                }
-
-                uint64_t z_index = component->base.entity->draw_order;
-                z_index += y * mw + x;
-
-                const char *texture_id;
-                float x1, y1, x2, y2;
-                int w, h;
-                sprite_get_frame(sprite, component->sprite_frames[y * mw + x], &texture_id, &x1,
-                                &y1, &x2, &y2, &w, &h);
-
-                texCallback(dx, dy, tw, th, z_index, texture_id, x1, y1, x2, y2, w, h,
-                            callback_user_data);
-            }
+            _map_render_draw_cell(engine, component, tileset, x, y, mw, dx, dy, tw, th,
+                                  texCallback, callback_user_data);
         }
     }
 }
 
 /**
-* @brief Draws an isometric map (diamond layout).
+* @brief Draws the visible cells of an isometric map (diamond layout).
 */
-static void _map_render_draw_iso(EseEntityComponentMap *component, float screen_x, float screen_y,
+static void _map_render_draw_iso(EseEngine *engine, EseEntityComponentMap *component,
+                                float screen_x, float screen_y, float view_w, float view_h,
                                 EntityDrawTextureCallback texCallback, void *callback_user_data) {
-    EseEngine *engine =
-        (EseEngine *)lua_engine_get_registry_key(component->base.lua->runtime, ENGINE_KEY);
-    ese_tileset_set_seed(ese_map_get_tileset(component->map), component->seed);
+    EseTileSet *tileset = ese_map_get_tileset(component->map);
 
     const int th = component->size;
     const int tw = th * 2;
@@ -450,42 +795,39 @@ static void _map_render_draw_iso(EseEntityComponentMap *component, float screen_
     float cy = ese_point_get_y(component->position);
     int mw = ese_map_get_width(component->map);
     int mh = ese_map_get_height(component->map);
+    if (th <= 0) {
+        return;
+    }
 
-    for (uint32_t y = 0; y < (uint32_t)mh; y++) {
-        for (uint32_t x = 0; x < (uint32_t)mw; x++) {
-            EseMapCell *cell = ese_map_get_cell(component->map, x, y);
-            float dx = screen_x + (x - cx) * (tw / 2.0f) - (y - cy) * (tw / 2.0f);
-            float dy = screen_y + (x - cx) * (th / 2.0f) + (y - cy) * (th / 2.0f);
-
-            for (size_t i = 0; i < ese_map_cell_get_layer_count(cell); i++) {
-                int tid = ese_map_cell_get_layer(cell, i);
-                if (tid == -1 || !component->show_layer[i]) {
-                    continue;
-                }
-
-                const char *sprite_id =
-                    ese_tileset_get_sprite(ese_map_get_tileset(component->map), tid);
-                if (!sprite_id) {
-                    continue;
-                }
-
-                EseSprite *sprite = engine_get_sprite(engine, sprite_id);
-                if (!sprite) {
-                    continue;
-                }
+    // With u = x - cx and v = y - cy a tile is drawn a = u - v half widths right
+    // and b = u + v half heights down from the map origin
+    const float half_w = tw / 2.0f;
+    const float half_h = th / 2.0f;
+    const float a_min = (-tw - screen_x) / half_w;
+    const float a_max = (view_w - screen_x) / half_w;
+    const float b_min = (-th - screen_y) / half_h;
+    const float b_max = (view_h - screen_y) / half_h;
+
+    int first_y, last_y;
+    if (!_map_render_clamp_range(cy + (b_min - a_max) / 2.0f, cy + (b_max - a_min) / 2.0f, mh,
+                                 &first_y, &last_y)) {
+        return;
+    }
 
-                uint64_t z_index = component->base.entity->draw_order;
-                z_index += y * mw + x;
+    for (uint32_t y = first_y; y <= (uint32_t)last_y; y++) {
+        float v = y - cy;
+        int first_x, last_x;
+        if (!_map_render_clamp_range(cx + fmaxf(a_min + v, b_min - v),
+                                     cx + fminf(a_max + v, b_max - v), mw, &first_x, &last_x)) {
+            continue;
+        }
 
-                const char *texture_id;
-                float x1, y1, x2, y2;
-                int w, h;
-                sprite_get_frame(sprite, component->sprite_frames[y * mw + x], &texture_id, &x1,
-                                &y1, &x2, &y2, &w, &h);
+        for (uint32_t x = first_x; x <= (uint32_t)last_x; x++) {
+            float dx = screen_x + (x - cx) * half_w - (y - cy) * half_w;
+            float dy = screen_y + (x - cx) * half_h + (y - cy) * half_h;
 
-                texCallback(dx, dy, tw, th, z_index, texture_id, x1, y1, x2, y2, w, h,
-                            callback_user_data);
-            }
+            _map_render_draw_cell(engine, component, tileset, x, y, mw, dx, dy, tw, th,
+                                  texCallback, callback_user_data);
         }
     }
 }
@@ -495,11 +837,15 @@ static void _map_render_draw_iso(EseEntityComponentMap *component, float screen_
 // ========================================
 
 static const EseSystemManagerVTable MapRenderSystemVTable = {
+    .name = "map_render",
     .init = map_render_sys_init,
     .update = map_render_sys_update,
-    .accepts = map_render_sys_accepts,
+    .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_MAP),
     .on_component_added = map_render_sys_on_add,
     .on_component_removed = map_render_sys_on_remove,
+    .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_MAP),
+             .resources = SYS_RES_TRANSFORMS | SYS_RES_ENTITIES | SYS_RES_CAMERA |
+                          SYS_RES_LUA},
     .shutdown = map_render_sys_shutdown
 };
 
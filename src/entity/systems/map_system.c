@@ -22,24 +22,13 @@
 #include "entity/entity_private.h"
 #include "types/rect.h"
 #include "utility/log.h"
+#include "utility/spatial_index.h"
 #include <math.h>
 
 // ========================================
 // Defines and Structs
 // ========================================
 
-/**
- * @brief Internal data for the map system.
- *
- * Maintains a dynamically-sized array of map component pointers for
- * efficient per-frame updates.
- */
-typedef struct {
-    EseEntityComponentMap **maps; /** Array of map component pointers */
-    size_t count;                 /** Current number of tracked maps */
-    size_t capacity;              /** Allocated capacity of the array */
-} MapSystemData;
-
 /**
  * @brief Per-component world-bounds result.
  *
@@ -55,6 +44,19 @@ typedef struct {
     float max_x, max_y;               /** World-space maximum bounds */
 } MapBoundsResult;
 
+/**
+ * @brief Solid cell range of a map, reused until the map's cells change.
+ */
+typedef struct {
+    EseMap *map;          /** Map the range was scanned from */
+    uint32_t revision;    /** Component revision at the scan */
+    uint32_t flags;       /** Collision flags used for the scan */
+    bool valid;           /** Whether the range has been scanned */
+    bool has_solid_cells; /** Whether any cell matched flags */
+    int min_x, min_y;     /** First matching column and row */
+    int max_x, max_y;     /** Last matching column and row */
+} MapSolidCells;
+
 /**
  * @brief Batch payload of bounds results for all tracked map components.
  */
@@ -63,56 +65,44 @@ typedef struct {
     MapBoundsResult *items;
 } MapBoundsBatch;
 
+/**
+ * @brief Internal data for the map system.
+ *
+ * Maintains a dynamically-sized array of map component pointers for
+ * efficient per-frame updates, and a result slot per map that the update
+ * fills in place of allocating a batch every frame.
+ */
+typedef struct {
+    EseEntityComponentMap **maps; /** Array of map component pointers */
+    MapBoundsResult *results;     /** Result per map, same capacity as maps */
+    MapSolidCells *solid;         /** Cached solid cell range per map, same capacity as maps */
+    MapBoundsBatch batch;         /** Batch over results handed to apply_result */
+    size_t count;                 /** Current number of tracked maps */
+    size_t capacity;              /** Allocated capacity of the arrays */
+} MapSystemData;
+
 // ========================================
 // PRIVATE FUNCTIONS
 // ========================================
 
 /**
- * @brief Deep-copy function for MapBoundsBatch used by JobResult on main thread.
+ * @brief Copy function for MapBoundsBatch: hands the system's own batch over.
+ *
+ * @details The batch lives in MapSystemData and is only written by the next
+ * update, which never overlaps the main-thread callbacks, so no copy is made.
  */
-static void *_map_bounds_batch_copy(const void *worker_result, size_t worker_size,
-                                    size_t *out_size) {
-    (void)worker_size;
-    const MapBoundsBatch *src = (const MapBoundsBatch *)worker_result;
-    if (!src) {
-        return NULL;
-    }
-
-    MapBoundsBatch *dst = memory_manager.calloc(1, sizeof(MapBoundsBatch), MMTAG_S_MAP);
-    if (!dst) {
-        return NULL;
-    }
-
-    dst->count = src->count;
-    if (src->count > 0 && src->items) {
-        dst->items =
-            memory_manager.malloc(sizeof(MapBoundsResult) * src->count, MMTAG_S_MAP);
-        if (!dst->items) {
-            memory_manager.free(dst);
-            return NULL;
-        }
-        memcpy(dst->items, src->items, sizeof(MapBoundsResult) * src->count);
-    }
-
+static void *_map_bounds_batch_share(const void *worker_result, size_t worker_size,
+                                     size_t *out_size) {
     if (out_size) {
-        *out_size = sizeof(MapBoundsBatch);
+        *out_size = worker_size;
     }
-    return dst;
+    return (void *)worker_result;
 }
 
 /**
- * @brief Free function for MapBoundsBatch on the worker thread.
+ * @brief Free function for MapBoundsBatch: the batch belongs to the system.
  */
-static void _map_bounds_batch_free(void *worker_result) {
-    MapBoundsBatch *batch = (MapBoundsBatch *)worker_result;
-    if (!batch) {
-        return;
-    }
-    if (batch->items) {
-        memory_manager.free(batch->items);
-    }
-    memory_manager.free(batch);
-}
+static void _map_bounds_batch_keep(void *worker_result) { (void)worker_result; }
 
 /**
  * @brief Apply a MapBoundsBatch result on the main thread.
@@ -122,9 +112,6 @@ static void map_sys_apply_result(EseSystemManager *self, EseEngine *eng, void *r
     (void)eng;
     MapBoundsBatch *batch = (MapBoundsBatch *)result;
     if (!batch || !batch->items) {
-        if (batch) {
-            memory_manager.free(batch);
-        }
         return;
     }
 
@@ -165,44 +152,38 @@ static void map_sys_apply_result(EseSystemManager *self, EseEngine *eng, void *r
             ese_rect_set_rotation(world_bounds, 0.0f);
         }
     }
-
-    // Free the main-thread copy of the batch and its items now that we've
-    // applied the results. The worker-thread copy is freed separately via
-    // the JobResult.free_fn hook.
-    if (batch->items) {
-        memory_manager.free(batch->items);
-    }
-    memory_manager.free(batch);
-}
-
-/**
- * @brief Checks if the system accepts this component type.
- */
-static bool map_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    if (!comp) {
-        return false;
-    }
-    return comp->type == ENTITY_COMPONENT_MAP;
 }
 
 /**
  * @brief Called when a map component is added to an entity.
  */
 static void map_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityComponent *comp) {
-    (void)eng;
     MapSystemData *d = (MapSystemData *)self->data;
 
     if (!comp || !comp->data) {
         return;
     }
 
+    // Register once with the persistent broadphase
+    if (comp->entity) {
+        spatial_index_register(eng->spatial_index, comp->entity);
+    }
+
     if (d->count == d->capacity) {
         d->capacity = d->capacity ? d->capacity * 2 : 64;
         d->maps = memory_manager.realloc(d->maps, sizeof(EseEntityComponentMap *) * d->capacity,
                                          MMTAG_S_MAP);
+        // Grown here on the main thread; the update may run on any worker. A
+        // batch still waiting for its callback must follow the move.
+        d->results = memory_manager.realloc(d->results, sizeof(MapBoundsResult) * d->capacity,
+                                            MMTAG_S_MAP);
+        d->batch.items = d->results;
+        d->solid =
+            memory_manager.realloc(d->solid, sizeof(MapSolidCells) * d->capacity, MMTAG_S_MAP);
     }
 
+    system_manager_track(self, comp, d->count);
+    memset(&d->solid[d->count], 0, sizeof(MapSolidCells));
     d->maps[d->count++] = (EseEntityComponentMap *)comp->data;
 }
 
@@ -210,20 +191,33 @@ static void map_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityComp
  * @brief Called when a map component is removed from an entity.
  */
 static void map_sys_on_remove(EseSystemManager *self, EseEngine *eng, EseEntityComponent *comp) {
-    (void)eng;
     MapSystemData *d = (MapSystemData *)self->data;
 
-    if (!comp || !comp->data || d->count == 0) {
+    if (!comp || !comp->data) {
+        return;
+    }
+
+    if (comp->entity) {
+        spatial_index_unregister(eng->spatial_index, comp->entity);
+        if (eng->collision_resolver && comp->entity->spatial_proxy == SPATIAL_INDEX_NULL_PROXY) {
+            collision_resolver_forget_entity(eng->collision_resolver, comp->entity);
+        }
+    }
+
+    if (d->count == 0) {
         return;
     }
 
     EseEntityComponentMap *mc = (EseEntityComponentMap *)comp->data;
 
-    for (size_t i = 0; i < d->count; i++) {
-        if (d->maps[i] == mc) {
-            d->maps[i] = d->maps[--d->count];
-            return;
-        }
+    size_t i = system_manager_tracked_index(self, comp);
+    if (i >= d->count || d->maps[i] != mc) {
+        return;
+    }
+    d->maps[i] = d->maps[--d->count];
+    d->solid[i] = d->solid[d->count];
+    if (i < d->count) {
+        system_manager_track(self, &d->maps[i]->base, i);
     }
 }
 
@@ -236,12 +230,43 @@ static void map_sys_init(EseSystemManager *self, EseEngine *eng) {
     self->data = d;
 }
 
+/**
+ * @brief Finds the range of cells whose flags match the component's collision flags.
+ */
+static void _map_sys_scan_solid_cells(EseEntityComponentMap *component, MapSolidCells *solid) {
+    int mw = ese_map_get_width(component->map);
+    int mh = ese_map_get_height(component->map);
+
+    solid->map = component->map;
+    solid->revision = component->revision;
+    solid->flags = component->collision_flags;
+    solid->valid = true;
+    solid->has_solid_cells = false;
+    solid->min_x = mw;
+    solid->min_y = mh;
+    solid->max_x = -1;
+    solid->max_y = -1;
+
+    for (int y = 0; y < mh; y++) {
+        for (int x = 0; x < mw; x++) {
+            EseMapCell *cell = ese_map_get_cell(component->map, x, y);
+            if (cell && (ese_map_cell_get_flags(cell) & component->collision_flags)) {
+                solid->min_x = x < solid->min_x ? x : solid->min_x;
+                solid->min_y = y < solid->min_y ? y : solid->min_y;
+                solid->max_x = x > solid->max_x ? x : solid->max_x;
+                solid->max_y = y > solid->max_y ? y : solid->max_y;
+                solid->has_solid_cells = true;
+            }
+        }
+    }
+}
+
 /**
  * @brief Update all map components each frame.
  *
- * Computes world bounds for all tracked map components and returns a
- * MapBoundsBatch result so that rect updates happen only on the main thread
- * via the system's apply_result callback.
+ * Computes world bounds for all tracked map components into the system's
+ * result slots and returns them as a MapBoundsBatch so that rect updates
+ * happen only on the main thread via the system's apply_result callback.
  */
 static EseSystemJobResult map_sys_update(EseSystemManager *self, EseEngine *eng, float dt) {
     (void)dt;
@@ -254,20 +279,9 @@ static EseSystemJobResult map_sys_update(EseSystemManager *self, EseEngine *eng,
         return job_res;
     }
 
-    MapBoundsBatch *batch = memory_manager.calloc(1, sizeof(MapBoundsBatch), MMTAG_S_MAP);
-    if (!batch) {
-        return job_res;
-    }
-
+    MapBoundsBatch *batch = &d->batch;
     batch->count = d->count;
-    if (batch->count > 0) {
-        batch->items =
-            memory_manager.malloc(sizeof(MapBoundsResult) * batch->count, MMTAG_S_MAP);
-        if (!batch->items) {
-            memory_manager.free(batch);
-            return job_res;
-        }
-    }
+    batch->items = d->results;
 
     for (size_t i = 0; i < d->count; i++) {
         MapBoundsResult *out = &batch->items[i];
@@ -289,44 +303,33 @@ static EseSystemJobResult map_sys_update(EseSystemManager *self, EseEngine *eng,
 
         out->has_map = true;
 
-        int mw = ese_map_get_width(component->map);
-        int mh = ese_map_get_height(component->map);
-        float px = ese_point_get_x(entity->position);
-        float py = ese_point_get_y(entity->position);
+        float px = _entity_get_x(entity);
+        float py = _entity_get_y(entity);
         out->px = px;
         out->py = py;
 
-        float min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
-        bool has_solid_cells = false;
-
-        for (int y = 0; y < mh; y++) {
-            for (int x = 0; x < mw; x++) {
-                EseMapCell *cell = ese_map_get_cell(component->map, x, y);
-                if (cell && (ese_map_cell_get_flags(cell) & MAP_CELL_FLAG_SOLID)) {
-                    float cell_x = px + (float)x * (float)component->size;
-                    float cell_y = py + (float)y * (float)component->size;
-                    min_x = fminf(min_x, cell_x);
-                    min_y = fminf(min_y, cell_y);
-                    max_x = fmaxf(max_x, cell_x + (float)component->size);
-                    max_y = fmaxf(max_y, cell_y + (float)component->size);
-                    has_solid_cells = true;
-                }
-            }
+        // Rescan only after the cells or the flags change
+        MapSolidCells *solid = &d->solid[i];
+        if (!solid->valid || solid->map != component->map ||
+            solid->revision != component->revision ||
+            solid->flags != component->collision_flags) {
+            _map_sys_scan_solid_cells(component, solid);
         }
 
-        out->has_solid_cells = has_solid_cells;
-        if (has_solid_cells) {
-            out->min_x = min_x;
-            out->min_y = min_y;
-            out->max_x = max_x;
-            out->max_y = max_y;
+        out->has_solid_cells = solid->has_solid_cells;
+        if (solid->has_solid_cells) {
+            float size = (float)component->size;
+            out->min_x = px + (float)solid->min_x * size;
+            out->min_y = py + (float)solid->min_y * size;
+            out->max_x = px + (float)(solid->max_x + 1) * size;
+            out->max_y = py + (float)(solid->max_y + 1) * size;
         }
     }
 
     job_res.result = batch;
     job_res.size = sizeof(MapBoundsBatch);
-    job_res.copy_fn = _map_bounds_batch_copy;
-    job_res.free_fn = _map_bounds_batch_free;
+    job_res.copy_fn = _map_bounds_batch_share;
+    job_res.free_fn = _map_bounds_batch_keep;
     return job_res;
 }
 
@@ -340,16 +343,21 @@ static void map_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
         if (d->maps) {
             memory_manager.free(d->maps);
         }
+        memory_manager.free(d->results);
+        memory_manager.free(d->solid);
         memory_manager.free(d);
     }
 }
 
 static const EseSystemManagerVTable MapSystemVTable = {
+    .name = "map",
     .init = map_sys_init,
     .update = map_sys_update,
-    .accepts = map_sys_accepts,
+    .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_MAP),
     .on_component_added = map_sys_on_add,
     .on_component_removed = map_sys_on_remove,
+    .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_MAP),
+             .resources = SYS_RES_TRANSFORMS | SYS_RES_ENTITIES},
     .shutdown = map_sys_shutdown,
     .apply_result = map_sys_apply_result};
 
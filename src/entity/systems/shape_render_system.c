@@ -9,7 +9,8 @@
  * The system maintains a dynamic array of shape component pointers for
  * efficient rendering. Components are added/removed via callbacks. During
  * update, shapes are rendered with proper rotation, fill, and stroke support
- * based on polyline type.
+ * based on polyline type. Shapes whose rotated extent lies outside the
+ * camera's view are skipped.
  *
  * Copyright (c) 2025-2026 Entity Sprite Engine
  * See LICENSE.md for details.
@@ -25,7 +26,6 @@
 #include "entity/entity.h"
 #include "entity/entity_private.h"
 #include "types/color.h"
-#include "types/point.h"
 #include "types/poly_line.h"
 #include "utility/log.h"
 #include "utility/profile.h"
@@ -51,21 +51,6 @@ typedef struct {
 // PRIVATE FUNCTIONS
 // ========================================
 
-/**
- * @brief Checks if the system accepts this component type.
- *
- * @param self System manager instance
- * @param comp Component to check
- * @return true if component type is ENTITY_COMPONENT_SHAPE
- */
-static bool shape_render_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    if (!comp) {
-        return false;
-    }
-    return comp->type == ENTITY_COMPONENT_SHAPE;
-}
-
 /**
  * @brief Called when a shape component is added to an entity.
  *
@@ -86,6 +71,7 @@ static void shape_render_sys_on_add(EseSystemManager *self, EseEngine *eng,
     }
 
     // Add shape to tracking array
+    system_manager_track(self, comp, d->count);
     d->shapes[d->count++] = (EseEntityComponentShape *)comp->data;
 }
 
@@ -102,12 +88,14 @@ static void shape_render_sys_on_remove(EseSystemManager *self, EseEngine *eng,
     ShapeRenderSystemData *d = (ShapeRenderSystemData *)self->data;
     EseEntityComponentShape *sp = (EseEntityComponentShape *)comp->data;
 
-    // Find and remove shape from tracking array (swap with last element)
-    for (size_t i = 0; i < d->count; i++) {
-        if (d->shapes[i] == sp) {
-            d->shapes[i] = d->shapes[--d->count];
-            return;
-        }
+    // Remove shape from tracking array (swap with last element, found by its index)
+    size_t i = system_manager_tracked_index(self, comp);
+    if (i >= d->count || d->shapes[i] != sp) {
+        return;
+    }
+    d->shapes[i] = d->shapes[--d->count];
+    if (i < d->count) {
+        system_manager_track(self, &d->shapes[i]->base, i);
     }
 }
 
@@ -153,10 +141,44 @@ static void _rotate_point(float *x, float *y, float angle_radians) {
     *y = new_y;
 }
 
+/**
+ * @brief Distance from the entity origin to the farthest stroked point.
+ *
+ * Points rotate around the origin, so this bounds the shape at any rotation.
+ *
+ * @param shape Shape component
+ * @return Radius of a circle around the entity that contains the shape
+ */
+static float _shape_render_extent(const EseEntityComponentShape *shape) {
+    float extent = 0.0f;
+    for (size_t idx = 0; idx < shape->polylines_count; ++idx) {
+        EsePolyLine *polyline = shape->polylines[idx];
+        if (!polyline)
+            continue;
+
+        size_t point_count = ese_poly_line_get_point_count(polyline);
+        const float *points = ese_poly_line_get_points(polyline);
+        float max_sq = 0.0f;
+        for (size_t i = 0; i < point_count; i++) {
+            float x = points[i * 2];
+            float y = points[i * 2 + 1];
+            if (x * x + y * y > max_sq) {
+                max_sq = x * x + y * y;
+            }
+        }
+        float reach = sqrtf(max_sq) + ese_poly_line_get_stroke_width(polyline) / 2.0f;
+        if (reach > extent) {
+            extent = reach;
+        }
+    }
+    return extent;
+}
+
 /**
  * @brief Render all shapes.
  *
- * Iterates through all tracked shapes and submits them to the renderer.
+ * Iterates through all tracked shapes and submits the on-screen ones to the
+ * renderer.
  *
  * @param self System manager instance
  * @param eng Engine pointer
@@ -167,6 +189,10 @@ static EseSystemJobResult shape_render_sys_update(EseSystemManager *self, EseEng
     (void)dt;
     ShapeRenderSystemData *d = (ShapeRenderSystemData *)self->data;
 
+    EseViewRect view;
+    engine_get_view_rect(eng, &view);
+    EseDrawList *draw_list = engine_get_draw_list(eng);
+
     for (size_t i = 0; i < d->count; i++) {
         EseEntityComponentShape *shape = d->shapes[i];
 
@@ -177,25 +203,18 @@ static EseSystemJobResult shape_render_sys_update(EseSystemManager *self, EseEng
         }
 
         // Get entity world position
-        float entity_x = ese_point_get_x(shape->base.entity->position);
-        float entity_y = ese_point_get_y(shape->base.entity->position);
-
-        // Convert world coordinates to screen coordinates using camera
-        EseCamera *camera = engine_get_camera(eng);
-        EseDisplay *display = engine_get_display(eng);
-        float camera_x = ese_point_get_x(camera->position);
-        float camera_y = ese_point_get_y(camera->position);
-        float view_width = ese_display_get_viewport_width(display);
-        float view_height = ese_display_get_viewport_height(display);
-
-        float view_left = camera_x - view_width / 2.0f;
-        float view_top = camera_y - view_height / 2.0f;
+        float entity_x = _entity_get_x(shape->base.entity);
+        float entity_y = _entity_get_y(shape->base.entity);
 
-        float screen_x = entity_x - view_left;
-        float screen_y = entity_y - view_top;
+        float extent = _shape_render_extent(shape);
+        if (!engine_view_rect_overlaps(&view, entity_x - extent, entity_y - extent, extent * 2.0f,
+                                       extent * 2.0f)) {
+            continue;
+        }
 
-        // Get draw list for user data
-        EseDrawList *draw_list = engine_get_draw_list(eng);
+        // Convert world coordinates to screen coordinates using camera
+        float screen_x = entity_x - view.left;
+        float screen_y = entity_y - view.top;
 
         // Render the shape directly
         profile_start(PROFILE_ENTITY_COMP_SHAPE_DRAW);
@@ -215,71 +234,22 @@ static EseSystemJobResult shape_render_sys_update(EseSystemManager *self, EseEng
             EsePolyLineType polyline_type = ese_poly_line_get_type(polyline);
             float stroke_width = ese_poly_line_get_stroke_width(polyline);
 
-            float *points_to_use = NULL;
-            size_t point_count_to_use = point_count;
-            bool needs_cleanup = false;
-
-            if ((polyline_type == POLY_LINE_CLOSED || polyline_type == POLY_LINE_FILLED) &&
-                point_count >= 3) {
-                points_to_use =
-                    memory_manager.malloc(sizeof(float) * (point_count + 1) * 2, MMTAG_RS_SHAPE);
-                if (points_to_use) {
-                    const float *original_points = ese_poly_line_get_points(polyline);
-                    for (size_t i = 0; i < point_count; i++) {
-                        float x = original_points[i * 2];
-                        float y = original_points[i * 2 + 1];
-                        if (rotation_radians != 0.0f) {
-                            _rotate_point(&x, &y, rotation_radians);
-                        }
-                        points_to_use[i * 2] = x;
-                        points_to_use[i * 2 + 1] = y;
-                    }
-                    float x = original_points[0];
-                    float y = original_points[1];
-                    if (rotation_radians != 0.0f) {
-                        _rotate_point(&x, &y, rotation_radians);
-                    }
-                    points_to_use[point_count * 2] = x;
-                    points_to_use[point_count * 2 + 1] = y;
-                    point_count_to_use = point_count + 1;
-                    needs_cleanup = true;
-                } else {
-                    points_to_use =
-                        memory_manager.malloc(sizeof(float) * point_count * 2, MMTAG_RS_SHAPE);
-                    if (points_to_use) {
-                        const float *original_points = ese_poly_line_get_points(polyline);
-                        for (size_t i = 0; i < point_count; i++) {
-                            float x = original_points[i * 2];
-                            float y = original_points[i * 2 + 1];
-                            if (rotation_radians != 0.0f) {
-                                _rotate_point(&x, &y, rotation_radians);
-                            }
-                            points_to_use[i * 2] = x;
-                            points_to_use[i * 2 + 1] = y;
-                        }
-                        needs_cleanup = true;
-                    } else {
-                        points_to_use = (float *)ese_poly_line_get_points(polyline);
-                    }
-                }
-            } else {
-                points_to_use =
-                    memory_manager.malloc(sizeof(float) * point_count * 2, MMTAG_RS_SHAPE);
-                if (points_to_use) {
-                    const float *original_points = ese_poly_line_get_points(polyline);
-                    for (size_t i = 0; i < point_count; i++) {
-                        float x = original_points[i * 2];
-                        float y = original_points[i * 2 + 1];
-                        if (rotation_radians != 0.0f) {
-                            _rotate_point(&x, &y, rotation_radians);
-                        }
-                        points_to_use[i * 2] = x;
-                        points_to_use[i * 2 + 1] = y;
-                    }
-                    needs_cleanup = true;
-                } else {
-                    points_to_use = (float *)ese_poly_line_get_points(polyline);
+            // Closed and filled outlines repeat their first point at the end. The
+            // draw list copies the points, so the buffer only has to last the frame.
+            bool close = (polyline_type == POLY_LINE_CLOSED || polyline_type == POLY_LINE_FILLED) &&
+                         point_count >= 3;
+            size_t point_count_to_use = close ? point_count + 1 : point_count;
+            float *points_to_use =
+                memory_manager.frame_alloc(sizeof(float) * point_count_to_use * 2);
+            const float *original_points = ese_poly_line_get_points(polyline);
+            for (size_t i = 0; i < point_count_to_use; i++) {
+                float x = original_points[(i % point_count) * 2];
+                float y = original_points[(i % point_count) * 2 + 1];
+                if (rotation_radians != 0.0f) {
+                    _rotate_point(&x, &y, rotation_radians);
                 }
+                points_to_use[i * 2] = x;
+                points_to_use[i * 2 + 1] = y;
             }
 
             EseColor *fill_color = ese_poly_line_get_fill_color(polyline);
@@ -333,10 +303,6 @@ static EseSystemJobResult shape_render_sys_update(EseSystemManager *self, EseEng
             _engine_add_polyline_to_draw_list(
                 screen_x, screen_y, 0, points_to_use, point_count_to_use, stroke_width, fill_r,
                 fill_g, fill_b, fill_a, stroke_r, stroke_g, stroke_b, stroke_a, draw_list);
-
-            if (needs_cleanup) {
-                memory_manager.free(points_to_use);
-            }
         }
 
         profile_stop(PROFILE_ENTITY_COMP_SHAPE_DRAW, "entity_component_shape_draw");
@@ -367,11 +333,14 @@ static void shape_render_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
  * @brief Virtual table for the shape render system.
  */
 static const EseSystemManagerVTable ShapeRenderSystemVTable = {
+    .name = "shape_render",
     .init = shape_render_sys_init,
     .update = shape_render_sys_update,
-    .accepts = shape_render_sys_accepts,
+    .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SHAPE),
     .on_component_added = shape_render_sys_on_add,
     .on_component_removed = shape_render_sys_on_remove,
+    .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SHAPE),
+             .resources = SYS_RES_TRANSFORMS | SYS_RES_ENTITIES | SYS_RES_CAMERA},
     .shutdown = shape_render_sys_shutdown};
 
 // ========================================
@@ -27,6 +27,11 @@
 #include <math.h>
 #include <string.h>
 
+// Component types tracked (and declared read/written) by the sound system
+#define SOUND_SYSTEM_COMPONENTS                                                                    \
+    (ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SOUND) | ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_MUSIC) | \
+     ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_LISTENER))
+
 SoundSystemData *g_sound_system_data = NULL;
 
 // ========================================
@@ -137,8 +142,8 @@ static void sound_sys_data_callback(ma_device *device, void *output, const void
 
             listener_pos = ent->position;
             if (listener_pos) {
-                listener_x = ese_point_get_x(listener_pos);
-                listener_y = ese_point_get_y(listener_pos);
+                listener_x = _entity_get_x(ent);
+                listener_y = _entity_get_y(ent);
             }
 
             break; // Use the first active listener only.
@@ -201,8 +206,8 @@ static void sound_sys_data_callback(ma_device *device, void *output, const void
         //  - both entities have positions and max_distance > 0.
         if (sound->spatial && listener && listener_spatial && sound_pos && listener_pos &&
             listener_max_distance > 0.0f) {
-            float sx = ese_point_get_x(sound_pos);
-            float sy = ese_point_get_y(sound_pos);
+            float sx = _entity_get_x(sound_entity);
+            float sy = _entity_get_y(sound_entity);
 
             float dx = sx - listener_x;
             float dy = sy - listener_y;
@@ -423,8 +428,8 @@ static void sound_sys_data_callback(ma_device *device, void *output, const void
             //  - both entities have positions and max_distance > 0.
             if (music->spatial && listener && listener_spatial && music_pos && listener_pos &&
                 listener_max_distance > 0.0f) {
-                float sx = ese_point_get_x(music_pos);
-                float sy = ese_point_get_y(music_pos);
+                float sx = _entity_get_x(music_entity);
+                float sy = _entity_get_y(music_entity);
 
                 float dx = sx - listener_x;
                 float dy = sy - listener_y;
@@ -623,18 +628,6 @@ static void sound_sys_data_callback(ma_device *device, void *output, const void
     }
 }
 
-/**
- * @brief Checks if the system accepts this component type.
- */
-static bool sound_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    if (!comp) {
-        return false;
-    }
-    return comp->type == ENTITY_COMPONENT_SOUND || comp->type == ENTITY_COMPONENT_MUSIC ||
-           comp->type == ENTITY_COMPONENT_LISTENER;
-}
-
 /**
  * @brief Called when a sound component is added to an entity.
  */
@@ -661,6 +654,7 @@ static void sound_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityCo
                 MMTAG_S_SPRITE); // reuse sprite system tag for now
         }
 
+        system_manager_track(self, comp, g_sound_system_data->sound_count);
         g_sound_system_data->sounds[g_sound_system_data->sound_count++] =
             (EseEntityComponentSound *)comp->data;
     } else if (comp->type == ENTITY_COMPONENT_MUSIC) {
@@ -674,6 +668,7 @@ static void sound_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityCo
                 MMTAG_S_SPRITE); // reuse sprite system tag for now
         }
 
+        system_manager_track(self, comp, g_sound_system_data->music_count);
         g_sound_system_data->music[g_sound_system_data->music_count++] =
             (EseEntityComponentMusic *)comp->data;
     } else if (comp->type == ENTITY_COMPONENT_LISTENER) {
@@ -684,6 +679,7 @@ static void sound_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityCo
                 MMTAG_S_SPRITE); // reuse sprite system tag for now
         }
 
+        system_manager_track(self, comp, g_sound_system_data->listener_count);
         g_sound_system_data->listeners[g_sound_system_data->listener_count++] = (EseEntityComponentListener *)comp->data;
     }
 
@@ -707,63 +703,33 @@ static void sound_sys_on_remove(EseSystemManager *self, EseEngine *eng, EseEntit
         ese_mutex_lock(mtx);
     }
 
+    // Swap-remove from the array for the component's type, found by its index
+    size_t i = system_manager_tracked_index(self, comp);
     if (comp->type == ENTITY_COMPONENT_SOUND) {
-        if (g_sound_system_data->sound_count == 0) {
-            if (mtx) {
-                ese_mutex_unlock(mtx);
-            }
-            return;
-        }
-
-        EseEntityComponentSound *sc = (EseEntityComponentSound *)comp->data;
-
-        for (size_t i = 0; i < g_sound_system_data->sound_count; i++) {
-            if (g_sound_system_data->sounds[i] == sc) {
-                g_sound_system_data->sounds[i] =
-                    g_sound_system_data->sounds[--g_sound_system_data->sound_count];
-                if (mtx) {
-                    ese_mutex_unlock(mtx);
-                }
-                return;
+        EseEntityComponentSound **sounds = g_sound_system_data->sounds;
+        size_t *count = &g_sound_system_data->sound_count;
+        if (i < *count && sounds[i] == comp->data) {
+            sounds[i] = sounds[--*count];
+            if (i < *count) {
+                system_manager_track(self, &sounds[i]->base, i);
             }
         }
     } else if (comp->type == ENTITY_COMPONENT_MUSIC) {
-        if (g_sound_system_data->music_count == 0) {
-            if (mtx) {
-                ese_mutex_unlock(mtx);
-            }
-            return;
-        }
-
-        EseEntityComponentMusic *mc = (EseEntityComponentMusic *)comp->data;
-
-        for (size_t i = 0; i < g_sound_system_data->music_count; i++) {
-            if (g_sound_system_data->music[i] == mc) {
-                g_sound_system_data->music[i] =
-                    g_sound_system_data->music[--g_sound_system_data->music_count];
-                if (mtx) {
-                    ese_mutex_unlock(mtx);
-                }
-                return;
+        EseEntityComponentMusic **music = g_sound_system_data->music;
+        size_t *count = &g_sound_system_data->music_count;
+        if (i < *count && music[i] == comp->data) {
+            music[i] = music[--*count];
+            if (i < *count) {
+                system_manager_track(self, &music[i]->base, i);
             }
         }
     } else if (comp->type == ENTITY_COMPONENT_LISTENER) {
-        if (g_sound_system_data->listener_count == 0) {
-            if (mtx) {
-                ese_mutex_unlock(mtx);
-            }
-            return;
-        }
-
-        EseEntityComponentListener *lc = (EseEntityComponentListener *)comp->data;
-
-        for (size_t i = 0; i < g_sound_system_data->listener_count; i++) {
-            if (g_sound_system_data->listeners[i] == lc) {
-                g_sound_system_data->listeners[i] = g_sound_system_data->listeners[--g_sound_system_data->listener_count];
-                if (mtx) {
-                    ese_mutex_unlock(mtx);
-                }
-                return;
+        EseEntityComponentListener **listeners = g_sound_system_data->listeners;
+        size_t *count = &g_sound_system_data->listener_count;
+        if (i < *count && listeners[i] == comp->data) {
+            listeners[i] = listeners[--*count];
+            if (i < *count) {
+                system_manager_track(self, &listeners[i]->base, i);
             }
         }
     }
@@ -980,11 +946,15 @@ static void sound_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
  * @brief Virtual table for the sound system.
  */
 static const EseSystemManagerVTable SoundSystemVTable = {
+    .name = "sound",
     .init = sound_sys_init,
     .update = sound_sys_update,
-    .accepts = sound_sys_accepts,
+    .component_mask = SOUND_SYSTEM_COMPONENTS,
     .on_component_added = sound_sys_on_add,
     .on_component_removed = sound_sys_on_remove,
+    .reads = {.components = SOUND_SYSTEM_COMPONENTS,
+             .resources = SYS_RES_TRANSFORMS | SYS_RES_ENTITIES},
+    .writes = {.components = SOUND_SYSTEM_COMPONENTS},
     .shutdown = sound_sys_shutdown};
 
 // ========================================
@@ -11,6 +11,16 @@
  * update, sprites are rendered with proper frame lookup and camera-relative
  * positioning.
  *
+ * The sprite array is split into chunks with ese_job_queue_parallel_for. Each
+ * chunk collects its visible sprites into a small local batch and claims the
+ * draw list objects for the whole batch at once; that claim is the only time a
+ * worker takes the draw list's mutex. Filling the claimed objects is lock-free:
+ * draw_list_object_set_texture stores an interned texture id rather than
+ * copying it into the draw list's arena.
+ *
+ * The camera's view is computed once per update, and sprites whose frame lies
+ * entirely outside it are dropped before they claim a draw list object.
+ *
  * Copyright (c) 2025-2026 Entity Sprite Engine
  * See LICENSE.md for details.
  */
@@ -26,7 +36,7 @@
 #include "entity/entity_private.h"
 #include "graphics/draw_list.h"
 #include "graphics/sprite.h"
-#include "types/point.h"
+#include "utility/job_queue.h"
 #include "utility/log.h"
 
 // ========================================
@@ -45,24 +55,33 @@ typedef struct {
     size_t capacity;                    /** Allocated capacity of the array */
 } SpriteRenderSystemData;
 
-// ========================================
-// PRIVATE FUNCTIONS
-// ========================================
+// Sprites per parallel chunk, and per draw list claim within a chunk
+#define SPRITE_RENDER_MIN_CHUNK 256
+#define SPRITE_RENDER_BATCH 64
 
 /**
- * @brief Checks if the system accepts this component type.
- *
- * @param self System manager instance
- * @param comp Component to check
- * @return true if component type is ENTITY_COMPONENT_SPRITE
+ * @brief Per-frame state shared by every chunk of the render loop.
  */
-static bool sprite_render_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    if (!comp) {
-        return false;
-    }
-    return comp->type == ENTITY_COMPONENT_SPRITE;
-}
+typedef struct {
+    SpriteRenderSystemData *d; /** System data */
+    EseEngine *eng;            /** Engine pointer */
+    EseDrawList *draw_list;    /** Draw list being filled */
+    EseViewRect view;          /** World rect shown by the camera */
+} SpriteRenderFrame;
+
+/**
+ * @brief A sprite draw waiting for its draw list object.
+ */
+typedef struct {
+    EseEntityComponentSprite *sp; /** Sprite being drawn */
+    const char *texture_id;       /** Frame texture */
+    float x1, y1, x2, y2;         /** Frame UVs */
+    int w, h;                     /** Frame size */
+} SpriteRenderDraw;
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
 
 /**
  * @brief Called when a sprite component is added to an entity.
@@ -84,6 +103,7 @@ static void sprite_render_sys_on_add(EseSystemManager *self, EseEngine *eng,
     }
 
     // Add sprite to tracking array
+    system_manager_track(self, comp, d->count);
     d->sprites[d->count++] = (EseEntityComponentSprite *)comp->data;
 }
 
@@ -100,12 +120,14 @@ static void sprite_render_sys_on_remove(EseSystemManager *self, EseEngine *eng,
     SpriteRenderSystemData *d = (SpriteRenderSystemData *)self->data;
     EseEntityComponentSprite *sp = (EseEntityComponentSprite *)comp->data;
 
-    // Find and remove sprite from tracking array (swap with last element)
-    for (size_t i = 0; i < d->count; i++) {
-        if (d->sprites[i] == sp) {
-            d->sprites[i] = d->sprites[--d->count];
-            return;
-        }
+    // Remove sprite from tracking array (swap with last element, found by its index)
+    size_t i = system_manager_tracked_index(self, comp);
+    if (i >= d->count || d->sprites[i] != sp) {
+        return;
+    }
+    d->sprites[i] = d->sprites[--d->count];
+    if (i < d->count) {
+        system_manager_track(self, &d->sprites[i]->base, i);
     }
 }
 
@@ -123,21 +145,51 @@ static void sprite_render_sys_init(EseSystemManager *self, EseEngine *eng) {
 }
 
 /**
- * @brief Render all sprites.
+ * @brief Claims draw list objects for a batch of sprites and fills them.
  *
- * Iterates through all tracked sprites and submits them to the renderer.
+ * Takes the draw list mutex once for the claim; the setters below only write
+ * the claimed headers.
  *
- * @param self System manager instance
- * @param eng Engine pointer
- * @param dt Delta time (unused)
+ * @param frame Per-frame render state
+ * @param batch Pending draws
+ * @param n Number of pending draws
  */
-static EseSystemJobResult sprite_render_sys_update(EseSystemManager *self, EseEngine *eng,
-                                                     float dt) {
-    (void)dt;
-    SpriteRenderSystemData *d = (SpriteRenderSystemData *)self->data;
+static void _sprite_render_flush(const SpriteRenderFrame *frame, const SpriteRenderDraw *batch,
+                                 size_t n) {
+    EseDrawListObject *objs[SPRITE_RENDER_BATCH];
+    if (draw_list_request_objects(frame->draw_list, n, objs) != n) {
+        log_error("SPRITE_RENDER_SYS", "failed to claim %zu draw list objects", n);
+        return;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        const SpriteRenderDraw *dr = &batch[i];
+        EseEntity *entity = dr->sp->base.entity;
 
-    for (size_t i = 0; i < d->count; i++) {
-        EseEntityComponentSprite *sp = d->sprites[i];
+        // Convert world coordinates to screen coordinates using camera
+        float screen_x = _entity_get_x(entity) - frame->view.left;
+        float screen_y = _entity_get_y(entity) - frame->view.top;
+
+        draw_list_object_set_texture(objs[i], dr->texture_id, dr->x1, dr->y1, dr->x2, dr->y2);
+        draw_list_object_set_bounds(objs[i], screen_x, screen_y, dr->w, dr->h);
+        draw_list_object_set_z_index(objs[i], entity->draw_order);
+    }
+}
+
+/**
+ * @brief Render one chunk of the tracked sprites.
+ *
+ * @param user_data SpriteRenderFrame for this update
+ * @param begin First sprite index
+ * @param end One past the last sprite index
+ */
+static void _sprite_render_chunk(void *user_data, size_t begin, size_t end) {
+    const SpriteRenderFrame *frame = (const SpriteRenderFrame *)user_data;
+    SpriteRenderDraw batch[SPRITE_RENDER_BATCH];
+    size_t n = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        EseEntityComponentSprite *sp = frame->d->sprites[i];
 
         // Skip sprites without a sprite name or inactive entities
         if (!sp->sprite_name || !sp->base.entity || !sp->base.entity->active ||
@@ -146,42 +198,66 @@ static EseSystemJobResult sprite_render_sys_update(EseSystemManager *self, EseEn
         }
 
         // Look up sprite by name
-        EseSprite *sprite = engine_get_sprite(eng, sp->sprite_name);
+        EseSprite *sprite = engine_get_sprite(frame->eng, sp->sprite_name);
         if (!sprite) {
             continue; // Skip if sprite not found
         }
 
-        // Get sprite frame data
-        const char *texture_id;
-        float x1, y1, x2, y2;
-        int w, h;
-        sprite_get_frame(sprite, sp->current_frame, &texture_id, &x1, &y1, &x2, &y2, &w, &h);
+        // Get sprite frame data; the slot is only kept if the frame is on screen
+        SpriteRenderDraw *dr = &batch[n];
+        dr->sp = sp;
+        sprite_get_frame(sprite, sp->current_frame, &dr->texture_id, &dr->x1, &dr->y1, &dr->x2,
+                         &dr->y2, &dr->w, &dr->h);
+        if (!engine_view_rect_overlaps(&frame->view, _entity_get_x(sp->base.entity),
+                                       _entity_get_y(sp->base.entity), dr->w, dr->h)) {
+            continue;
+        }
+        n++;
 
-        // Get entity world position
-        float entity_x = ese_point_get_x(sp->base.entity->position);
-        float entity_y = ese_point_get_y(sp->base.entity->position);
+        if (n == SPRITE_RENDER_BATCH) {
+            _sprite_render_flush(frame, batch, n);
+            n = 0;
+        }
+    }
 
-        // Convert world coordinates to screen coordinates using camera
-        EseCamera *camera = engine_get_camera(eng);
-        EseDisplay *display = engine_get_display(eng);
-        float camera_x = ese_point_get_x(camera->position);
-        float camera_y = ese_point_get_y(camera->position);
-        float view_width = ese_display_get_viewport_width(display);
-        float view_height = ese_display_get_viewport_height(display);
-
-        float view_left = camera_x - view_width / 2.0f;
-        float view_top = camera_y - view_height / 2.0f;
-
-        float screen_x = entity_x - view_left;
-        float screen_y = entity_y - view_top;
-
-        // Submit to draw list using the public API
-        EseDrawList *draw_list = engine_get_draw_list(eng);
-        _engine_add_texture_to_draw_list(screen_x, screen_y, w, h, sp->base.entity->draw_order,
-                                         texture_id, x1, y1, x2, y2, w, h, draw_list);
+    if (n > 0) {
+        _sprite_render_flush(frame, batch, n);
     }
+}
 
+/**
+ * @brief Render all sprites.
+ *
+ * Splits the tracked sprites into chunks across the engine's job queue and
+ * submits each visible, on-screen sprite to the draw list.
+ *
+ * @param self System manager instance
+ * @param eng Engine pointer
+ * @param dt Delta time (unused)
+ */
+static EseSystemJobResult sprite_render_sys_update(EseSystemManager *self, EseEngine *eng,
+                                                     float dt) {
+    (void)dt;
+    SpriteRenderSystemData *d = (SpriteRenderSystemData *)self->data;
     EseSystemJobResult res = {0};
+    if (d->count == 0) {
+        return res;
+    }
+
+    SpriteRenderFrame frame = {
+        .d = d,
+        .eng = eng,
+        .draw_list = engine_get_draw_list(eng),
+    };
+    engine_get_view_rect(eng, &frame.view);
+
+    EseJobQueue *queue = engine_get_job_queue(eng);
+    if (queue) {
+        ese_job_queue_parallel_for(queue, d->count, SPRITE_RENDER_MIN_CHUNK, _sprite_render_chunk,
+                                   &frame);
+    } else {
+        _sprite_render_chunk(&frame, 0, d->count);
+    }
     return res;
 }
 
@@ -206,11 +282,14 @@ static void sprite_render_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
  * @brief Virtual table for the sprite render system.
  */
 static const EseSystemManagerVTable SpriteRenderSystemVTable = {
+    .name = "sprite_render",
     .init = sprite_render_sys_init,
     .update = sprite_render_sys_update,
-    .accepts = sprite_render_sys_accepts,
+    .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SPRITE),
     .on_component_added = sprite_render_sys_on_add,
     .on_component_removed = sprite_render_sys_on_remove,
+    .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SPRITE),
+             .resources = SYS_RES_TRANSFORMS | SYS_RES_ENTITIES | SYS_RES_CAMERA},
     .shutdown = sprite_render_sys_shutdown};
 
 // ========================================
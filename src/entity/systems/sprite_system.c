@@ -9,7 +9,8 @@
  * The system maintains a dynamic array of sprite component pointers for
  * efficient iteration during updates. Components are added/removed via
  * callbacks. During update, animation frames advance based on each sprite's
- * animation speed and elapsed time.
+ * animation speed and elapsed time. Each sprite only touches its own
+ * animation state, so the update runs as a parallel_for over the array.
  *
  * Copyright (c) 2025-2026 Entity Sprite Engine
  * See LICENSE.md for details.
@@ -23,6 +24,7 @@
 #include "entity/components/entity_component_sprite.h"
 #include "entity/entity_private.h"
 #include "graphics/sprite.h"
+#include "utility/job_queue.h"
 #include "utility/log.h"
 
 // ========================================
@@ -41,24 +43,21 @@ typedef struct {
     size_t capacity;                    /** Allocated capacity of the array */
 } SpriteSystemData;
 
-// ========================================
-// PRIVATE FUNCTIONS
-// ========================================
+// Smallest run of sprites a worker animates at once
+#define SPRITE_SYSTEM_MIN_CHUNK 512
 
 /**
- * @brief Checks if the system accepts this component type.
- *
- * @param self System manager instance
- * @param comp Component to check
- * @return true if component type is ENTITY_COMPONENT_SPRITE
+ * @brief Per-update state shared by every chunk.
  */
-static bool sprite_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    if (!comp) {
-        return false;
-    }
-    return comp->type == ENTITY_COMPONENT_SPRITE;
-}
+typedef struct {
+    SpriteSystemData *d; /** System data */
+    EseEngine *eng;      /** Engine pointer */
+    float dt;            /** Delta time in seconds */
+} SpriteSystemFrame;
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
 
 /**
  * @brief Called when a sprite component is added to an entity.
@@ -79,6 +78,7 @@ static void sprite_sys_on_add(EseSystemManager *self, EseEngine *eng, EseEntityC
     }
 
     // Add sprite to tracking array
+    system_manager_track(self, comp, d->count);
     d->sprites[d->count++] = (EseEntityComponentSprite *)comp->data;
 }
 
@@ -94,12 +94,14 @@ static void sprite_sys_on_remove(EseSystemManager *self, EseEngine *eng, EseEnti
     SpriteSystemData *d = (SpriteSystemData *)self->data;
     EseEntityComponentSprite *sp = (EseEntityComponentSprite *)comp->data;
 
-    // Find and remove sprite from tracking array (swap with last element)
-    for (size_t i = 0; i < d->count; i++) {
-        if (d->sprites[i] == sp) {
-            d->sprites[i] = d->sprites[--d->count];
-            return;
-        }
+    // Remove sprite from tracking array (swap with last element, found by its index)
+    size_t i = system_manager_tracked_index(self, comp);
+    if (i >= d->count || d->sprites[i] != sp) {
+        return;
+    }
+    d->sprites[i] = d->sprites[--d->count];
+    if (i < d->count) {
+        system_manager_track(self, &d->sprites[i]->base, i);
     }
 }
 
@@ -116,20 +118,17 @@ static void sprite_sys_init(EseSystemManager *self, EseEngine *eng) {
 }
 
 /**
- * @brief Update all sprite animations.
- *
- * Advances animation frames based on elapsed time for all tracked sprites.
+ * @brief Advance the animations of one chunk of the tracked sprites.
  *
- * @param self System manager instance
- * @param eng Engine pointer
- * @param dt Delta time in seconds
+ * @param user_data SpriteSystemFrame for this update
+ * @param begin First sprite index
+ * @param end One past the last sprite index
  */
-static EseSystemJobResult sprite_sys_update(EseSystemManager *self, EseEngine *eng, float dt) {
-    (void)eng;
-    SpriteSystemData *d = (SpriteSystemData *)self->data;
+static void _sprite_sys_chunk(void *user_data, size_t begin, size_t end) {
+    const SpriteSystemFrame *frame = (const SpriteSystemFrame *)user_data;
 
-    for (size_t i = 0; i < d->count; i++) {
-        EseEntityComponentSprite *sp = d->sprites[i];
+    for (size_t i = begin; i < end; i++) {
+        EseEntityComponentSprite *sp = frame->d->sprites[i];
 
         // Skip sprites without a sprite name or inactive entities
         if (!sp->base.entity || !sp->base.entity->active ||
@@ -144,7 +143,7 @@ static EseSystemJobResult sprite_sys_update(EseSystemManager *self, EseEngine *e
         }
 
         // Look up sprite by name
-        EseSprite *sprite = engine_get_sprite(eng, sp->sprite_name);
+        EseSprite *sprite = engine_get_sprite(frame->eng, sp->sprite_name);
         if (!sprite) {
             sp->current_frame = 0;
             sp->sprite_ellapse_time = 0;
@@ -152,7 +151,7 @@ static EseSystemJobResult sprite_sys_update(EseSystemManager *self, EseEngine *e
         }
 
         // Advance animation time
-        sp->sprite_ellapse_time += dt;
+        sp->sprite_ellapse_time += frame->dt;
         float speed = sprite_get_speed(sprite);
 
         // Check if it's time to advance the frame
@@ -164,6 +163,29 @@ static EseSystemJobResult sprite_sys_update(EseSystemManager *self, EseEngine *e
             }
         }
     }
+}
+
+/**
+ * @brief Update all sprite animations.
+ *
+ * Advances animation frames based on elapsed time for all tracked sprites,
+ * split into chunks across the engine's job queue.
+ *
+ * @param self System manager instance
+ * @param eng Engine pointer
+ * @param dt Delta time in seconds
+ */
+static EseSystemJobResult sprite_sys_update(EseSystemManager *self, EseEngine *eng, float dt) {
+    SpriteSystemData *d = (SpriteSystemData *)self->data;
+    SpriteSystemFrame frame = {.d = d, .eng = eng, .dt = dt};
+
+    EseJobQueue *queue = engine_get_job_queue(eng);
+    if (queue) {
+        ese_job_queue_parallel_for(queue, d->count, SPRITE_SYSTEM_MIN_CHUNK, _sprite_sys_chunk,
+                                   &frame);
+    } else {
+        _sprite_sys_chunk(&frame, 0, d->count);
+    }
 
     EseSystemJobResult res = {0};
     return res;
@@ -190,11 +212,15 @@ static void sprite_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
  * @brief Virtual table for the sprite system.
  */
 static const EseSystemManagerVTable SpriteSystemVTable = {
+    .name = "sprite",
     .init = sprite_sys_init,
     .update = sprite_sys_update,
-    .accepts = sprite_sys_accepts,
+    .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SPRITE),
     .on_component_added = sprite_sys_on_add,
     .on_component_removed = sprite_sys_on_remove,
+    .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SPRITE),
+              .resources = SYS_RES_ENTITIES},
+    .writes = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SPRITE)},
     .shutdown = sprite_sys_shutdown};
 
 // ========================================
@@ -9,7 +9,7 @@
  * The system maintains a dynamic array of text component pointers for efficient
  * rendering. Components are added/removed via callbacks. During update, text is
  * rendered with proper justification, alignment, and camera-relative
- * positioning.
+ * positioning. Text whose box lies outside the camera's view is skipped.
  *
  * Copyright (c) 2025-2026 Entity Sprite Engine
  * See LICENSE.md for details.
@@ -63,21 +63,6 @@ static void _text_font_texture_callback(float screen_x, float screen_y, float sc
 // PRIVATE FUNCTIONS
 // ========================================
 
-/**
- * @brief Checks if the system accepts this component type.
- *
- * @param self System manager instance
- * @param comp Component to check
- * @return true if component type is ENTITY_COMPONENT_TEXT
- */
-static bool text_render_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
-    (void)self;
-    if (!comp) {
-        return false;
-    }
-    return comp->type == ENTITY_COMPONENT_TEXT;
-}
-
 /**
  * @brief Called when a text component is added to an entity.
  *
@@ -98,6 +83,7 @@ static void text_render_sys_on_add(EseSystemManager *self, EseEngine *eng,
     }
 
     // Add text to tracking array
+    system_manager_track(self, comp, d->count);
     d->texts[d->count++] = (EseEntityComponentText *)comp->data;
 }
 
@@ -114,12 +100,14 @@ static void text_render_sys_on_remove(EseSystemManager *self, EseEngine *eng,
     TextRenderSystemData *d = (TextRenderSystemData *)self->data;
     EseEntityComponentText *tc = (EseEntityComponentText *)comp->data;
 
-    // Find and remove text from tracking array (swap with last element)
-    for (size_t i = 0; i < d->count; i++) {
-        if (d->texts[i] == tc) {
-            d->texts[i] = d->texts[--d->count];
-            return;
-        }
+    // Remove text from tracking array (swap with last element, found by its index)
+    size_t i = system_manager_tracked_index(self, comp);
+    if (i >= d->count || d->texts[i] != tc) {
+        return;
+    }
+    d->texts[i] = d->texts[--d->count];
+    if (i < d->count) {
+        system_manager_track(self, &d->texts[i]->base, i);
     }
 }
 
@@ -138,8 +126,8 @@ static void text_render_sys_init(EseSystemManager *self, EseEngine *eng) {
 /**
  * @brief Render all text components.
  *
- * Iterates through all tracked text components and submits them to the
- * renderer.
+ * Iterates through all tracked text components and submits the on-screen
+ * ones to the renderer.
  *
  * @param self System manager instance
  * @param eng Engine pointer
@@ -150,6 +138,10 @@ static EseSystemJobResult text_render_sys_update(EseSystemManager *self, EseEngi
     (void)dt;
     TextRenderSystemData *d = (TextRenderSystemData *)self->data;
 
+    EseViewRect view;
+    engine_get_view_rect(eng, &view);
+    EseDrawList *draw_list = engine_get_draw_list(eng);
+
     for (size_t i = 0; i < d->count; i++) {
         EseEntityComponentText *tc = d->texts[i];
 
@@ -164,8 +156,8 @@ static EseSystemJobResult text_render_sys_update(EseSystemManager *self, EseEngi
         int text_height = FONT_CHAR_HEIGHT;
 
         // Get entity world position
-        float entity_x = ese_point_get_x(tc->base.entity->position);
-        float entity_y = ese_point_get_y(tc->base.entity->position);
+        float entity_x = _entity_get_x(tc->base.entity);
+        float entity_y = _entity_get_y(tc->base.entity);
 
         // Apply offset
         float final_x = entity_x + ese_point_get_x(tc->offset);
@@ -197,22 +189,15 @@ static EseSystemJobResult text_render_sys_update(EseSystemManager *self, EseEngi
             break;
         }
 
-        // Convert world coordinates to screen coordinates using camera
-        EseCamera *camera = engine_get_camera(eng);
-        EseDisplay *display = engine_get_display(eng);
-        float camera_x = ese_point_get_x(camera->position);
-        float camera_y = ese_point_get_y(camera->position);
-        float view_width = ese_display_get_viewport_width(display);
-        float view_height = ese_display_get_viewport_height(display);
-
-        float view_left = camera_x - view_width / 2.0f;
-        float view_top = camera_y - view_height / 2.0f;
+        if (!engine_view_rect_overlaps(&view, final_x, final_y, text_width, text_height)) {
+            continue;
+        }
 
-        float screen_x = final_x - view_left;
-        float screen_y = final_y - view_top;
+        // Convert world coordinates to screen coordinates using camera
+        float screen_x = final_x - view.left;
+        float screen_y = final_y - view.top;
 
         // Use the font drawing function
-        EseDrawList *draw_list = engine_get_draw_list(eng);
         font_draw_text(eng, "console_font_10x20", tc->text, screen_x, screen_y,
                        tc->base.entity->draw_order, _text_font_texture_callback, draw_list);
     }
@@ -242,11 +227,14 @@ static void text_render_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
  * @brief Virtual table for the text render system.
  */
 static const EseSystemManagerVTable TextRenderSystemVTable = {
+    .name = "text_render",
     .init = text_render_sys_init,
     .update = text_render_sys_update,
-    .accepts = text_render_sys_accepts,
+    .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_TEXT),
     .on_component_added = text_render_sys_on_add,
     .on_component_removed = text_render_sys_on_remove,
+    .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_TEXT),
+             .resources = SYS_RES_TRANSFORMS | SYS_RES_ENTITIES | SYS_RES_CAMERA},
     .shutdown = text_render_sys_shutdown};
 
 /**
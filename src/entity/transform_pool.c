@@ -0,0 +1,162 @@
+/**
+ * TRANSFORM POOL IMPLEMENTATION
+ * =============================
+ *
+ * Entity transforms kept as parallel columns instead of one heap object per
+ * entity. A slot is addressed by the slot index of the entity's handle, so it
+ * does not move while the entity is added and systems can read positions as
+ * plain array loads.
+ *
+ * Writes set a bit in `dirty` instead of calling watchers; whoever owns data
+ * derived from a position (collider bounds, the broadphase) clears the bit
+ * when it catches up. Capacity is kept a multiple of 64 so every slot has a
+ * bit in a whole dirty word.
+ */
+
+#include "entity/transform_pool.h"
+#include "core/memory_manager.h"
+#include "utility/log.h"
+#include <string.h>
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define TRANSFORM_POOL_DEFAULT_CAPACITY 256
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+/**
+ * @brief Grows every column so @p index fits; new slots are free and clean.
+ */
+static bool _transform_pool_grow(EseTransformPool *pool, uint32_t index) {
+    uint32_t capacity = pool->capacity;
+    while (capacity <= index) {
+        capacity *= 2;
+    }
+
+    float *x = memory_manager.realloc(pool->x, sizeof(float) * capacity, MMTAG_ENTITY);
+    if (!x) {
+        return false;
+    }
+    pool->x = x;
+    float *y = memory_manager.realloc(pool->y, sizeof(float) * capacity, MMTAG_ENTITY);
+    if (!y) {
+        return false;
+    }
+    pool->y = y;
+    EseEntity **entities =
+        memory_manager.realloc(pool->entities, sizeof(EseEntity *) * capacity, MMTAG_ENTITY);
+    if (!entities) {
+        return false;
+    }
+    pool->entities = entities;
+    uint64_t *dirty =
+        memory_manager.realloc(pool->dirty, sizeof(uint64_t) * (capacity / 64), MMTAG_ENTITY);
+    if (!dirty) {
+        return false;
+    }
+    pool->dirty = dirty;
+
+    memset(pool->entities + pool->capacity, 0, sizeof(EseEntity *) * (capacity - pool->capacity));
+    memset(pool->dirty + pool->capacity / 64, 0,
+           sizeof(uint64_t) * ((capacity - pool->capacity) / 64));
+    pool->capacity = capacity;
+    return true;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+EseTransformPool *transform_pool_create(uint32_t initial_capacity) {
+    uint32_t capacity = TRANSFORM_POOL_DEFAULT_CAPACITY;
+    while (capacity < initial_capacity) {
+        capacity *= 2;
+    }
+
+    EseTransformPool *pool = memory_manager.malloc(sizeof(EseTransformPool), MMTAG_ENTITY);
+    pool->x = memory_manager.malloc(sizeof(float) * capacity, MMTAG_ENTITY);
+    pool->y = memory_manager.malloc(sizeof(float) * capacity, MMTAG_ENTITY);
+    pool->entities = memory_manager.calloc(capacity, sizeof(EseEntity *), MMTAG_ENTITY);
+    pool->dirty = memory_manager.calloc(capacity / 64, sizeof(uint64_t), MMTAG_ENTITY);
+    pool->capacity = capacity;
+    return pool;
+}
+
+void transform_pool_destroy(EseTransformPool *pool) {
+    if (!pool) {
+        return;
+    }
+    memory_manager.free(pool->x);
+    memory_manager.free(pool->y);
+    memory_manager.free(pool->entities);
+    memory_manager.free(pool->dirty);
+    memory_manager.free(pool);
+}
+
+bool transform_pool_attach(EseTransformPool *pool, uint32_t index, EseEntity *entity, float x,
+                           float y) {
+    log_assert("TRANSFORM_POOL", pool, "transform_pool_attach called with NULL pool");
+    log_assert("TRANSFORM_POOL", entity, "transform_pool_attach called with NULL entity");
+
+    if (index >= pool->capacity && !_transform_pool_grow(pool, index)) {
+        log_error("TRANSFORM_POOL", "transform_pool_attach: failed to grow the pool");
+        return false;
+    }
+
+    log_assert("TRANSFORM_POOL", pool->entities[index] == NULL,
+               "transform_pool_attach: slot %u is already attached", index);
+    pool->entities[index] = entity;
+    transform_pool_set(pool, index, x, y);
+    return true;
+}
+
+void transform_pool_detach(EseTransformPool *pool, uint32_t index) {
+    log_assert("TRANSFORM_POOL", pool, "transform_pool_detach called with NULL pool");
+    log_assert("TRANSFORM_POOL", index < pool->capacity, "transform_pool_detach: bad slot %u",
+               index);
+
+    pool->entities[index] = NULL;
+    transform_pool_clear_dirty(pool, index);
+}
+
+void transform_pool_set(EseTransformPool *pool, uint32_t index, float x, float y) {
+    pool->x[index] = x;
+    pool->y[index] = y;
+    pool->dirty[index >> 6] |= 1ull << (index & 63);
+}
+
+bool transform_pool_clear_dirty(EseTransformPool *pool, uint32_t index) {
+    uint64_t bit = 1ull << (index & 63);
+    bool was_dirty = (pool->dirty[index >> 6] & bit) != 0;
+    pool->dirty[index >> 6] &= ~bit;
+    return was_dirty;
+}
+
+uint32_t transform_pool_next_dirty(const EseTransformPool *pool, uint32_t start) {
+    log_assert("TRANSFORM_POOL", pool, "transform_pool_next_dirty called with NULL pool");
+
+    if (start >= pool->capacity) {
+        return TRANSFORM_POOL_NO_SLOT;
+    }
+
+    uint32_t word = start >> 6;
+    uint64_t bits = pool->dirty[word] & (~0ull << (start & 63));
+    uint32_t words = pool->capacity / 64;
+    while (bits == 0) {
+        if (++word == words) {
+            return TRANSFORM_POOL_NO_SLOT;
+        }
+        bits = pool->dirty[word];
+    }
+
+    uint32_t bit = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        bit++;
+    }
+    return (word << 6) + bit;
+}
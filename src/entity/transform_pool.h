@@ -0,0 +1,99 @@
+#ifndef ESE_TRANSFORM_POOL_H
+#define ESE_TRANSFORM_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Returned by transform_pool_next_dirty once no dirty slot is left
+#define TRANSFORM_POOL_NO_SLOT UINT32_MAX
+
+// Forward declarations
+typedef struct EseEntity EseEntity;
+
+/**
+ * @brief Structure-of-arrays storage for the transforms of an engine's entities.
+ *
+ * @details Indexed by the slot of the entity's handle (see slot_map.h), so a
+ *          slot keeps its index for as long as the entity is added. Columns
+ *          are public for systems that read many transforms in a row; writes
+ *          go through transform_pool_set so the slot is marked dirty.
+ */
+typedef struct EseTransformPool {
+    float *x;             /** Column of x positions */
+    float *y;             /** Column of y positions */
+    EseEntity **entities; /** Owner of each slot, NULL for free slots */
+    uint64_t *dirty;      /** One bit per slot, set by writes since the last sync */
+    uint32_t capacity;    /** Number of slots in every column */
+} EseTransformPool;
+
+/**
+ * @brief Create an empty pool.
+ *
+ * @param initial_capacity Number of slots to reserve (0 for a default).
+ * @return Pointer to a new EseTransformPool.
+ */
+EseTransformPool *transform_pool_create(uint32_t initial_capacity);
+
+/**
+ * @brief Free the pool. Owners are not touched.
+ *
+ * @param pool Pointer to the EseTransformPool to free (may be NULL).
+ */
+void transform_pool_destroy(EseTransformPool *pool);
+
+/**
+ * @brief Give a slot to an entity, growing the columns if needed.
+ *
+ * @details The slot starts dirty so derived data is refreshed on the next sync.
+ *
+ * @param pool Pointer to the EseTransformPool.
+ * @param index Slot index, normally the slot of the entity's handle.
+ * @param entity Owner of the slot.
+ * @param x Initial x position.
+ * @param y Initial y position.
+ * @return true on success, false if the columns could not grow.
+ */
+bool transform_pool_attach(EseTransformPool *pool, uint32_t index, EseEntity *entity, float x,
+                           float y);
+
+/**
+ * @brief Free a slot. Its values stay readable until the slot is reused.
+ *
+ * @param pool Pointer to the EseTransformPool.
+ * @param index Slot index given to transform_pool_attach.
+ */
+void transform_pool_detach(EseTransformPool *pool, uint32_t index);
+
+/**
+ * @brief Write a transform and mark its slot dirty.
+ *
+ * @param pool Pointer to the EseTransformPool.
+ * @param index Attached slot index.
+ * @param x New x position.
+ * @param y New y position.
+ */
+void transform_pool_set(EseTransformPool *pool, uint32_t index, float x, float y);
+
+/**
+ * @brief Clear a slot's dirty bit.
+ *
+ * @param pool Pointer to the EseTransformPool.
+ * @param index Slot index.
+ * @return true if the slot was dirty.
+ */
+bool transform_pool_clear_dirty(EseTransformPool *pool, uint32_t index);
+
+/**
+ * @brief Find the first dirty slot at or after @p start.
+ *
+ * @details Scans the dirty bits a word at a time, so clean stretches of 64
+ *          slots cost one load.
+ *
+ * @param pool Pointer to the EseTransformPool.
+ * @param start First slot index to consider.
+ * @return The slot index, or TRANSFORM_POOL_NO_SLOT.
+ */
+uint32_t transform_pool_next_dirty(const EseTransformPool *pool, uint32_t start);
+
+#endif // ESE_TRANSFORM_POOL_H
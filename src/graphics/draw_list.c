@@ -1,8 +1,25 @@
 /*
  * Project: Entity Sprite Engine
  *
- * Draw list implementation providing an object pool and utilities for
- * building frame render data (rects, textures, polylines, meshes).
+ * Draw list implementation: a packed command stream of small fixed-size object headers plus a
+ * per-frame linear arena for variable-length payloads (polyline points, mesh data).
+ *
+ * Details:
+ * Every requested object is a compact header (type, z-index, bounds, transform, scissor and a
+ * small type union). Headers live in blocks that are allocated once and reused every frame, so
+ * requesting an object only re-initializes a few dozen bytes instead of clearing inline
+ * polyline/mesh storage.
+ *
+ * Variable-length data is copied into a linear arena owned by the draw list. The arena is a
+ * chain of blocks that are never moved, so payload pointers stay valid while other threads keep
+ * appending. draw_list_clear() rewinds the arena; payloads therefore live until the next clear,
+ * which matches the lifetime of the object headers that reference them.
+ *
+ * Texture ids are interned into a per-draw-list table instead of being copied per object. Headers
+ * store the interned pointer, which never changes for a given id, so the setters neither
+ * allocate nor lock once an id has been seen and the render list can compare ids by pointer.
+ * The table is copy-on-write: inserting a new id takes texture_mutex and publishes a new table,
+ * so lookups only load the current one. Replaced tables are freed by draw_list_clear().
  *
  * Copyright (c) 2025-2026 Entity Sprite Engine
  * See LICENSE.md for details.
@@ -23,23 +40,11 @@
 // ========================================
 
 #define DRAW_LIST_INITIAL_CAPACITY 256
-#define TEXTURE_ID_MAX_LEN 256
-#define POLYLINE_MAX_POINTS 1024
-#define MESH_MAX_VERTS 4096
-#define MESH_MAX_INDICES 8192
+#define DRAW_LIST_ARENA_BLOCK_SIZE (64 * 1024)
+#define DRAW_LIST_ARENA_ALIGN 16
 
 #define EDL_OBJ_MAGIC 0xE5E5E5E5u
-
-// ========================================
-// FORWARD DECLARATIONS
-// ========================================
-
-static int _compare_draw_list_object_z(const void *a, const void *b);
-static void _init_new_object(EseDrawListObject *obj);
-
-// ========================================
-// PRIVATE FUNCTIONS
-// ========================================
+#define DRAW_LIST_TEXTURE_INITIAL_CAPACITY 64
 
 /**
  * @brief Color data for draw list objects.
@@ -66,15 +71,14 @@ typedef struct EseDrawListPoint {
 /**
  * @brief Polyline data for draw list objects.
  *
- * @details This structure stores point data and styling for rendering
- *          polyline objects.
+ * @details The points are a variable-length payload stored in the draw list's frame arena.
  */
 typedef struct EseDrawListPolyLine {
-    EseDrawListPoint points[POLYLINE_MAX_POINTS]; /** Array of points defining the polyline */
-    size_t point_count;                           /** Number of points in the polyline */
-    EseDrawListColor fill_color;                  /** Fill color for the polyline */
-    EseDrawListColor stroke_color;                /** Stroke color for the polyline */
-    float stroke_width;                           /** Width of the stroke in pixels */
+    EseDrawListPoint *points;     /** Points defining the polyline (frame arena) */
+    size_t point_count;           /** Number of points in the polyline */
+    EseDrawListColor fill_color;  /** Fill color for the polyline */
+    EseDrawListColor stroke_color; /** Stroke color for the polyline */
+    float stroke_width;           /** Width of the stroke in pixels */
 } EseDrawListPolyLine;
 
 /**
@@ -82,17 +86,18 @@ typedef struct EseDrawListPolyLine {
  *
  * @details This structure stores texture coordinates and ID for rendering
  *          textured objects. The texture coordinates are normalized values
- *          that define the region of the texture to sample.
+ *          that define the region of the texture to sample. The ID is
+ *          interned in the owning draw list (see draw_list_texture_intern).
  */
 typedef struct EseDrawListTexture {
-    // Texture to draw
-    char texture_id[TEXTURE_ID_MAX_LEN]; /** ID of the texture to render */
-    float texture_x1;                    /** Left texture coordinate (normalized) */
-    float texture_y1;                    /** Top texture coordinate (normalized) */
-    float texture_x2;                    /** Right texture coordinate (normalized) */
-    float texture_y2;                    /** Bottom texture coordinate (normalized) */
-    int w;                               /** Width of the texture in pixels */
-    int h;                               /** Height of the texture in pixels */
+    const char *texture_id; /** Interned ID of the texture to render */
+    float texture_x1;       /** Left texture coordinate (normalized) */
+    float texture_y1;       /** Top texture coordinate (normalized) */
+    float texture_x2;       /** Right texture coordinate (normalized) */
+    float texture_y2;       /** Bottom texture coordinate (normalized) */
+    int w;                  /** Width of the texture in pixels */
+    int h;                  /** Height of the texture in pixels */
+    EseDrawListColor tint;  /** Color multiplied into the texture, white by default */
 } EseDrawListTexture;
 
 /**
@@ -108,25 +113,32 @@ typedef struct EseDrawListRect {
     int h;                  /** Height of the rectangle in pixels */
 } EseDrawListRect;
 
+/**
+ * @brief Mesh data for draw list objects.
+ *
+ * @details Vertices and indices are copied into the frame arena; the texture ID
+ *          is interned.
+ */
 typedef struct EseDrawListMesh {
-    EseDrawListVertex verts[MESH_MAX_VERTS];
-    size_t vert_count;
-    uint32_t indices[MESH_MAX_INDICES];
-    size_t idx_count;
-    char texture_id[TEXTURE_ID_MAX_LEN];
+    EseDrawListVertex *verts; /** Vertex data (frame arena) */
+    size_t vert_count;        /** Number of vertices */
+    uint32_t *indices;        /** Index data (frame arena) */
+    size_t idx_count;         /** Number of indices */
+    const char *texture_id;   /** Interned ID of the texture to render */
 } EseDrawListMesh;
 
 /**
- * @brief Represents a drawable object in the render list.
+ * @brief Fixed-size header for one drawable command in the draw list.
  *
- * @details This structure contains all the information needed to render
- *          an object, including position, size, rotation, z-index, and
- *          type-specific data (texture or rectangle). It supports both
- *          textured sprites and colored rectangles.
+ * @details This structure contains all the information needed to sort and
+ *          batch an object: position, rotation, z-index, scissor and a small
+ *          type-specific union. Variable-length data is referenced by pointer
+ *          into the owning draw list's frame arena.
  */
 struct EseDrawListObject {
-    uint32_t magic;
-    EseDrawListObjectType type; /** Type of object (texture, rectangle, or polyline) */
+    uint32_t magic;             /** Corruption check, always EDL_OBJ_MAGIC */
+    EseDrawListObjectType type; /** Type of object (texture, rectangle, polyline or mesh) */
+    EseDrawList *owner;         /** Draw list whose arena holds this object's payloads */
     union {
         EseDrawListTexture texture;   /** Texture data for DL_TEXTURE type */
         EseDrawListRect rect;         /** Rectangle data for DL_RECT type */
@@ -150,39 +162,95 @@ struct EseDrawListObject {
 };
 
 /**
- * @brief Manages a collection of drawable objects for rendering.
+ * @brief One block of the per-frame payload arena.
+ *
+ * @details Blocks are chained and never reallocated, so pointers handed out
+ *          from a block remain valid until the arena is rewound.
+ */
+typedef struct EseDrawListArenaBlock {
+    struct EseDrawListArenaBlock *next; /** Next block in the chain */
+    size_t size;                        /** Usable bytes in data */
+    size_t used;                        /** Bytes handed out this frame */
+    unsigned char *data;                /** Block storage */
+} EseDrawListArenaBlock;
+
+/**
+ * @brief Open-addressed table of interned texture ids.
+ *
+ * @details Never modified once published; inserting builds a new table. Names
+ *          are owned by the draw list and shared by every table that lists them.
+ */
+typedef struct EseDrawListTextureTable {
+    struct EseDrawListTextureTable *retired_next; /** Next replaced table awaiting free */
+    size_t capacity;                              /** Slot count, a power of two */
+    size_t count;                                 /** Interned ids */
+    const char *slots[];                          /** Interned names, NULL when empty */
+} EseDrawListTextureTable;
+
+/**
+ * @brief Manages a packed stream of drawable objects for rendering.
  *
- * @details This structure implements an object pool for efficient rendering.
- *          It pre-allocates objects and reuses them across frames to avoid
- *          memory allocation overhead during rendering.
+ * @details Object headers are allocated in blocks and reused across frames;
+ *          `objects` indexes them in request order (and z order after
+ *          draw_list_sort). Variable-length payloads come from the arena.
  */
 struct EseDrawList {
-    EseDrawListObject **objects;   /** Pool of pre-allocated object pointers */
+    EseDrawListObject **objects;   /** Header pointers in request/sort order */
     EseAtomicSizeT *objects_count; /** Number of objects in use this frame (atomic) */
     size_t objects_capacity;       /** Total allocated capacity for objects */
-    EseMutex *mutex;               /** Mutex for thread safety */
+
+    EseDrawListObject **header_blocks; /** Header storage blocks (owned) */
+    size_t header_block_count;         /** Number of header storage blocks */
+
+    EseDrawListArenaBlock *arena_head;    /** First payload arena block */
+    EseDrawListArenaBlock *arena_current; /** Block currently being filled */
+
+    EseAtomicSizeT *textures;                  /** Current EseDrawListTextureTable (as size_t) */
+    EseDrawListTextureTable *textures_retired; /** Replaced tables, freed on clear */
+    EseMutex *texture_mutex;                   /** Serializes texture id inserts */
+
+    EseMutex *mutex; /** Mutex for thread safety */
 };
 
+// ========================================
+// FORWARD DECLARATIONS
+// ========================================
+
+static int _compare_draw_list_object_z(const void *a, const void *b);
+static void _init_new_object(EseDrawList *draw_list, EseDrawListObject *obj);
+static bool _draw_list_grow(EseDrawList *draw_list, size_t min_capacity);
+static EseDrawListArenaBlock *_draw_list_arena_block_create(size_t size);
+static void *_draw_list_arena_alloc(EseDrawList *draw_list, size_t size);
+static uint32_t _draw_list_texture_hash(const char *name);
+static EseDrawListTextureTable *_draw_list_texture_table_create(size_t capacity);
+static const char *_draw_list_texture_lookup(const EseDrawListTextureTable *table,
+                                             const char *texture_id, uint32_t hash);
+static void _draw_list_texture_free_retired(EseDrawList *draw_list);
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
 static int _compare_draw_list_object_z(const void *a, const void *b) {
     const EseDrawListObject *obj_a = *(const EseDrawListObject **)a;
     const EseDrawListObject *obj_b = *(const EseDrawListObject **)b;
-    uint64_t za = draw_list_object_get_z_index(obj_a);
-    uint64_t zb = draw_list_object_get_z_index(obj_b);
+    uint64_t za = obj_a->z_index;
+    uint64_t zb = obj_b->z_index;
     return (za > zb) - (za < zb);
 }
 
 /**
- * @brief Initialize a new draw list object.
+ * @brief Initialize a draw list object header.
  *
- * @details This function initializes a new draw list object with default values.
+ * @details Only the fixed-size header is touched; payloads are referenced by
+ *          pointer and never cleared.
  *
+ * @param draw_list Owning draw list.
  * @param obj Pointer to the object to initialize.
  */
-static void _init_new_object(EseDrawListObject *obj) {
-    if (!obj)
-        return;
-
+static void _init_new_object(EseDrawList *draw_list, EseDrawListObject *obj) {
     obj->magic = EDL_OBJ_MAGIC;
+    obj->owner = draw_list;
 
     obj->type = DL_RECT;
     obj->x = 0.0f;
@@ -203,21 +271,221 @@ static void _init_new_object(EseDrawListObject *obj) {
     memset(&obj->data, 0, sizeof(obj->data));
 }
 
+/**
+ * @brief Grow the header pool to at least `min_capacity` objects.
+ *
+ * @details Must be called with the draw list mutex held. New headers are
+ *          allocated as one block so existing header pointers stay valid.
+ *
+ * @param draw_list Target draw list.
+ * @param min_capacity Required capacity.
+ * @return true on success.
+ */
+static bool _draw_list_grow(EseDrawList *draw_list, size_t min_capacity) {
+    size_t new_capacity = draw_list->objects_capacity ? draw_list->objects_capacity * 2
+                                                      : DRAW_LIST_INITIAL_CAPACITY;
+    if (new_capacity < min_capacity) {
+        new_capacity = min_capacity;
+    }
+
+    EseDrawListObject **new_objs = memory_manager.shared.realloc(
+        draw_list->objects, sizeof(EseDrawListObject *) * new_capacity, MMTAG_DRAWLIST);
+    if (!new_objs) {
+        return false;
+    }
+    draw_list->objects = new_objs;
+
+    EseDrawListObject **new_blocks = memory_manager.shared.realloc(
+        draw_list->header_blocks,
+        sizeof(EseDrawListObject *) * (draw_list->header_block_count + 1), MMTAG_DRAWLIST);
+    if (!new_blocks) {
+        return false;
+    }
+    draw_list->header_blocks = new_blocks;
+
+    size_t added = new_capacity - draw_list->objects_capacity;
+    EseDrawListObject *block =
+        memory_manager.shared.calloc(added, sizeof(EseDrawListObject), MMTAG_DRAWLIST);
+    draw_list->header_blocks[draw_list->header_block_count++] = block;
+
+    for (size_t i = 0; i < added; ++i) {
+        _init_new_object(draw_list, &block[i]);
+        draw_list->objects[draw_list->objects_capacity + i] = &block[i];
+    }
+    draw_list->objects_capacity = new_capacity;
+    return true;
+}
+
+/**
+ * @brief Allocate a payload arena block with at least `size` usable bytes.
+ *
+ * @param size Requested usable size in bytes.
+ * @return New block.
+ */
+static EseDrawListArenaBlock *_draw_list_arena_block_create(size_t size) {
+    if (size < DRAW_LIST_ARENA_BLOCK_SIZE) {
+        size = DRAW_LIST_ARENA_BLOCK_SIZE;
+    }
+
+    EseDrawListArenaBlock *block =
+        memory_manager.shared.malloc(sizeof(EseDrawListArenaBlock), MMTAG_DRAWLIST);
+    block->data = memory_manager.shared.malloc(size, MMTAG_DRAWLIST);
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+/**
+ * @brief Bump-allocate `size` bytes from the frame arena.
+ *
+ * @details Walks forward through the block chain (blocks after the current
+ *          one were rewound by draw_list_clear) and appends a new block when
+ *          none has room. Thread-safe.
+ *
+ * @param draw_list Owning draw list.
+ * @param size Number of bytes.
+ * @return Pointer valid until the next draw_list_clear().
+ */
+static void *_draw_list_arena_alloc(EseDrawList *draw_list, size_t size) {
+    size = (size + (DRAW_LIST_ARENA_ALIGN - 1)) & ~(size_t)(DRAW_LIST_ARENA_ALIGN - 1);
+
+    ese_mutex_lock(draw_list->mutex);
+    EseDrawListArenaBlock *block = draw_list->arena_current;
+    while (block->used + size > block->size) {
+        if (!block->next) {
+            block->next = _draw_list_arena_block_create(size);
+        }
+        block = block->next;
+        block->used = 0;
+    }
+    draw_list->arena_current = block;
+
+    void *ptr = block->data + block->used;
+    block->used += size;
+    ese_mutex_unlock(draw_list->mutex);
+    return ptr;
+}
+
+static uint32_t _draw_list_texture_hash(const char *name) {
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Allocate an empty texture id table.
+ *
+ * @param capacity Slot count, a power of two.
+ * @return New table.
+ */
+static EseDrawListTextureTable *_draw_list_texture_table_create(size_t capacity) {
+    EseDrawListTextureTable *table = memory_manager.shared.calloc(
+        1, sizeof(EseDrawListTextureTable) + sizeof(const char *) * capacity, MMTAG_DRAWLIST);
+    table->capacity = capacity;
+    return table;
+}
+
+/**
+ * @brief Find an interned texture id in a table.
+ *
+ * @param table Table to probe.
+ * @param texture_id Texture id to look up.
+ * @param hash Hash of texture_id.
+ * @return Interned pointer, or NULL if the id is not in the table.
+ */
+static const char *_draw_list_texture_lookup(const EseDrawListTextureTable *table,
+                                             const char *texture_id, uint32_t hash) {
+    size_t slot = hash & (table->capacity - 1);
+    while (table->slots[slot] && strcmp(table->slots[slot], texture_id) != 0) {
+        slot = (slot + 1) & (table->capacity - 1);
+    }
+    return table->slots[slot];
+}
+
+/**
+ * @brief Free the texture tables replaced since the last clear.
+ *
+ * @details Must be called with texture_mutex held while no thread is looking
+ *          up texture ids.
+ *
+ * @param draw_list Owning draw list.
+ */
+static void _draw_list_texture_free_retired(EseDrawList *draw_list) {
+    EseDrawListTextureTable *table = draw_list->textures_retired;
+    while (table) {
+        EseDrawListTextureTable *next = table->retired_next;
+        memory_manager.shared.free(table);
+        table = next;
+    }
+    draw_list->textures_retired = NULL;
+}
+
 // ========================================
 // PUBLIC FUNCTIONS
 // ========================================
 
-EseDrawList *draw_list_create(void) {
-    EseDrawList *draw_list = memory_manager.shared.malloc(sizeof(EseDrawList), MMTAG_DRAWLIST);
-    draw_list->objects = memory_manager.shared.malloc(
-        sizeof(EseDrawListObject *) * DRAW_LIST_INITIAL_CAPACITY, MMTAG_DRAWLIST);
+const char *draw_list_texture_intern(EseDrawList *draw_list, const char *texture_id) {
+    log_assert("RENDER_LIST", draw_list, "draw_list_texture_intern called with NULL draw_list");
+    log_assert("RENDER_LIST", texture_id, "draw_list_texture_intern called with NULL texture_id");
+
+    uint32_t hash = _draw_list_texture_hash(texture_id);
+    const EseDrawListTextureTable *table =
+        (const EseDrawListTextureTable *)ese_atomic_size_t_load(draw_list->textures);
+    const char *interned = _draw_list_texture_lookup(table, texture_id, hash);
+    if (interned) {
+        return interned;
+    }
+
+    ese_mutex_lock(draw_list->texture_mutex);
+
+    // Another thread may have inserted it while we waited
+    EseDrawListTextureTable *current =
+        (EseDrawListTextureTable *)ese_atomic_size_t_load(draw_list->textures);
+    interned = _draw_list_texture_lookup(current, texture_id, hash);
+    if (!interned) {
+        // Readers may be probing the current table, so insert into a copy and publish it
+        size_t capacity = current->capacity;
+        if ((current->count + 1) * 2 > capacity) {
+            capacity *= 2;
+        }
+        EseDrawListTextureTable *next = _draw_list_texture_table_create(capacity);
+        for (size_t i = 0; i < current->capacity; i++) {
+            const char *name = current->slots[i];
+            if (name) {
+                size_t slot = _draw_list_texture_hash(name) & (capacity - 1);
+                while (next->slots[slot]) {
+                    slot = (slot + 1) & (capacity - 1);
+                }
+                next->slots[slot] = name;
+            }
+        }
+
+        interned = memory_manager.shared.strdup(texture_id, MMTAG_DRAWLIST);
+        size_t slot = hash & (capacity - 1);
+        while (next->slots[slot]) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        next->slots[slot] = interned;
+        next->count = current->count + 1;
 
-    draw_list->objects_capacity = DRAW_LIST_INITIAL_CAPACITY;
+        ese_atomic_size_t_store(draw_list->textures, (size_t)(uintptr_t)next);
+        current->retired_next = draw_list->textures_retired;
+        draw_list->textures_retired = current;
+    }
+
+    ese_mutex_unlock(draw_list->texture_mutex);
+    return interned;
+}
+
+EseDrawList *draw_list_create(void) {
+    EseDrawList *draw_list = memory_manager.shared.calloc(1, sizeof(EseDrawList), MMTAG_DRAWLIST);
 
     // Create atomic counter for thread safety
     draw_list->objects_count = ese_atomic_size_t_create(0);
     if (!draw_list->objects_count) {
-        memory_manager.shared.free(draw_list->objects);
         memory_manager.shared.free(draw_list);
         return NULL;
     }
@@ -225,11 +493,16 @@ EseDrawList *draw_list_create(void) {
     // Create mutex for thread safety
     draw_list->mutex = ese_mutex_create();
 
-    // Pre-allocate objects
-    for (size_t i = 0; i < draw_list->objects_capacity; ++i) {
-        draw_list->objects[i] = memory_manager.shared.calloc(1, sizeof(EseDrawListObject), MMTAG_DRAWLIST);
-        _init_new_object(draw_list->objects[i]);
-    }
+    // Pre-allocate object headers and the first payload block
+    _draw_list_grow(draw_list, DRAW_LIST_INITIAL_CAPACITY);
+    draw_list->arena_head = _draw_list_arena_block_create(DRAW_LIST_ARENA_BLOCK_SIZE);
+    draw_list->arena_current = draw_list->arena_head;
+
+    // Empty texture id table
+    EseDrawListTextureTable *textures =
+        _draw_list_texture_table_create(DRAW_LIST_TEXTURE_INITIAL_CAPACITY);
+    draw_list->textures = ese_atomic_size_t_create((size_t)(uintptr_t)textures);
+    draw_list->texture_mutex = ese_mutex_create();
     return draw_list;
 }
 
@@ -237,11 +510,31 @@ void draw_list_destroy(EseDrawList *draw_list) {
     log_assert("DRAW_LIST", draw_list, "draw_list_destroy called with NULL draw_list");
 
     log_verbose("DRAW_LIST", "draw_list_destroy destroying draw_list %p", draw_list);
-    for (size_t i = 0; i < draw_list->objects_capacity; ++i) {
-        log_verbose("DRAW_LIST", "draw_list_destroy freeing object %p", draw_list->objects[i]);
-        memory_manager.shared.free(draw_list->objects[i]);
+    for (size_t i = 0; i < draw_list->header_block_count; ++i) {
+        memory_manager.shared.free(draw_list->header_blocks[i]);
+    }
+    memory_manager.shared.free(draw_list->header_blocks);
+
+    EseDrawListArenaBlock *block = draw_list->arena_head;
+    while (block) {
+        EseDrawListArenaBlock *next = block->next;
+        memory_manager.shared.free(block->data);
+        memory_manager.shared.free(block);
+        block = next;
     }
 
+    EseDrawListTextureTable *textures =
+        (EseDrawListTextureTable *)ese_atomic_size_t_load(draw_list->textures);
+    for (size_t i = 0; i < textures->capacity; i++) {
+        if (textures->slots[i]) {
+            memory_manager.shared.free((char *)textures->slots[i]);
+        }
+    }
+    memory_manager.shared.free(textures);
+    _draw_list_texture_free_retired(draw_list);
+    ese_atomic_size_t_destroy(draw_list->textures);
+    ese_mutex_destroy(draw_list->texture_mutex);
+
     memory_manager.shared.free(draw_list->objects);
     ese_atomic_size_t_destroy(draw_list->objects_count);
     ese_mutex_destroy(draw_list->mutex);
@@ -253,7 +546,14 @@ void draw_list_clear(EseDrawList *draw_list) {
 
     ese_mutex_lock(draw_list->mutex);
     ese_atomic_size_t_store(draw_list->objects_count, 0);
+    draw_list->arena_head->used = 0;
+    draw_list->arena_current = draw_list->arena_head;
     ese_mutex_unlock(draw_list->mutex);
+
+    // Nothing is looking up texture ids between frames
+    ese_mutex_lock(draw_list->texture_mutex);
+    _draw_list_texture_free_retired(draw_list);
+    ese_mutex_unlock(draw_list->texture_mutex);
 }
 
 EseDrawListObject *draw_list_request_object(EseDrawList *draw_list) {
@@ -261,38 +561,62 @@ EseDrawListObject *draw_list_request_object(EseDrawList *draw_list) {
     ese_mutex_lock(draw_list->mutex);
     /* reserve */
     size_t index = ese_atomic_size_t_fetch_add(draw_list->objects_count, 1);
-    if (index >= draw_list->objects_capacity) {
-        size_t new_capacity = draw_list->objects_capacity ? draw_list->objects_capacity * 2
-                                                          : DRAW_LIST_INITIAL_CAPACITY;
-        if (new_capacity <= index)
-            new_capacity = index + 1;
-        EseDrawListObject **new_objs = memory_manager.shared.realloc(
-            draw_list->objects, sizeof(EseDrawListObject *) * new_capacity, MMTAG_DRAWLIST);
-        if (!new_objs) {
-            ese_atomic_size_t_fetch_sub_inplace(draw_list->objects_count, 1);
-            ese_mutex_unlock(draw_list->mutex);
-            return NULL;
-        }
-        draw_list->objects = new_objs;
-        for (size_t i = draw_list->objects_capacity; i < new_capacity; ++i) {
-            draw_list->objects[i] =
-                memory_manager.shared.calloc(1, sizeof(EseDrawListObject), MMTAG_DRAWLIST);
-            _init_new_object(draw_list->objects[i]);
-        }
-        draw_list->objects_capacity = new_capacity;
+    if (index >= draw_list->objects_capacity && !_draw_list_grow(draw_list, index + 1)) {
+        ese_atomic_size_t_fetch_sub_inplace(draw_list->objects_count, 1);
+        ese_mutex_unlock(draw_list->mutex);
+        return NULL;
     }
     EseDrawListObject *obj = draw_list->objects[index];
-    memset(obj, 0, sizeof(EseDrawListObject));
-    _init_new_object(obj);
     ese_mutex_unlock(draw_list->mutex);
 
     if (obj->magic != EDL_OBJ_MAGIC) {
         log_error("RENDER_LIST", "object magic corrupted idx=%zu magic=0x%x", index, obj->magic);
         abort();
     }
+    _init_new_object(draw_list, obj);
     return obj;
 }
 
+size_t draw_list_request_objects(EseDrawList *draw_list, size_t count, EseDrawListObject **out) {
+    log_assert("RENDER_LIST", draw_list, "draw_list_request_objects called with NULL draw_list");
+    log_assert("RENDER_LIST", out || count == 0, "draw_list_request_objects called with NULL out");
+
+    if (count == 0) {
+        return 0;
+    }
+
+    ese_mutex_lock(draw_list->mutex);
+    size_t start = ese_atomic_size_t_fetch_add(draw_list->objects_count, count);
+    if (start + count > draw_list->objects_capacity &&
+        !_draw_list_grow(draw_list, start + count)) {
+        ese_atomic_size_t_fetch_sub_inplace(draw_list->objects_count, count);
+        ese_mutex_unlock(draw_list->mutex);
+        return 0;
+    }
+    // Headers live in blocks that never move, so the pointers stay valid after unlocking
+    memcpy(out, draw_list->objects + start, sizeof(EseDrawListObject *) * count);
+    ese_mutex_unlock(draw_list->mutex);
+
+    for (size_t i = 0; i < count; i++) {
+        _init_new_object(draw_list, out[i]);
+    }
+    return count;
+}
+
+size_t draw_list_reserve_count(EseDrawList *draw_list, size_t count) {
+    log_assert("RENDER_LIST", draw_list, "draw_list_reserve_count called with NULL draw_list");
+
+    ese_mutex_lock(draw_list->mutex);
+    size_t start = ese_atomic_size_t_load(draw_list->objects_count);
+    if (start + count > draw_list->objects_capacity &&
+        !_draw_list_grow(draw_list, start + count)) {
+        ese_mutex_unlock(draw_list->mutex);
+        return (size_t)-1;
+    }
+    ese_mutex_unlock(draw_list->mutex);
+    return start;
+}
+
 void draw_list_sort(EseDrawList *draw_list) {
     log_assert("RENDER_LIST", draw_list, "draw_list_sort called with NULL draw_list");
     log_assert("RENDER_LIST", draw_list->objects,
@@ -351,13 +675,22 @@ void draw_list_object_set_texture(EseDrawListObject *object, const char *texture
     object->type = DL_TEXTURE;
     EseDrawListTexture *texture_data = &object->data.texture;
 
-    strncpy(texture_data->texture_id, texture_id, TEXTURE_ID_MAX_LEN - 1);
-    texture_data->texture_id[TEXTURE_ID_MAX_LEN - 1] = '\0';
+    texture_data->texture_id = draw_list_texture_intern(object->owner, texture_id);
 
     texture_data->texture_x1 = texture_x1;
     texture_data->texture_y1 = texture_y1;
     texture_data->texture_x2 = texture_x2;
     texture_data->texture_y2 = texture_y2;
+    texture_data->tint = (EseDrawListColor){255, 255, 255, 255};
+}
+
+void draw_list_object_set_texture_tint(EseDrawListObject *object, unsigned char r,
+                                       unsigned char g, unsigned char b, unsigned char a) {
+    log_assert("RENDER_LIST", object, "draw_list_object_set_texture_tint called with NULL object");
+    log_assert("RENDER_LIST", object->type == DL_TEXTURE,
+               "draw_list_object_set_texture_tint called with non-texture object");
+
+    object->data.texture.tint = (EseDrawListColor){r, g, b, a};
 }
 
 void draw_list_object_set_rect_color(EseDrawListObject *object, unsigned char r, unsigned char g,
@@ -497,6 +830,24 @@ void draw_list_object_get_texture(const EseDrawListObject *object, const char **
         *texture_y2 = texture_data->texture_y2;
 }
 
+void draw_list_object_get_texture_tint(const EseDrawListObject *object, unsigned char *r,
+                                       unsigned char *g, unsigned char *b, unsigned char *a) {
+    log_assert("RENDER_LIST", object, "draw_list_object_get_texture_tint called with NULL object");
+    log_assert("RENDER_LIST", object->type == DL_TEXTURE,
+               "draw_list_object_get_texture_tint called with non-texture object");
+
+    const EseDrawListColor *tint = &object->data.texture.tint;
+
+    if (r)
+        *r = tint->r;
+    if (g)
+        *g = tint->g;
+    if (b)
+        *b = tint->b;
+    if (a)
+        *a = tint->a;
+}
+
 void draw_list_object_get_rect_color(const EseDrawListObject *object, unsigned char *r,
                                      unsigned char *g, unsigned char *b, unsigned char *a,
                                      bool *filled) {
@@ -524,14 +875,13 @@ void draw_list_object_set_polyline(EseDrawListObject *object, const float *point
     log_assert("RENDER_LIST", points, "draw_list_object_set_polyline called with NULL points");
     log_assert("RENDER_LIST", point_count > 0,
                "draw_list_object_set_polyline called with point_count <= 0");
-    log_assert("RENDER_LIST", point_count <= POLYLINE_MAX_POINTS,
-               "draw_list_object_set_polyline called with point_count > "
-               "POLYLINE_MAX_POINTS");
 
     object->type = DL_POLYLINE;
     EseDrawListPolyLine *polyline_data = &object->data.polyline;
 
     // Copy points (points array is x1,y1,x2,y2,... format)
+    polyline_data->points =
+        _draw_list_arena_alloc(object->owner, sizeof(EseDrawListPoint) * point_count);
     for (size_t i = 0; i < point_count; i++) {
         polyline_data->points[i].x = points[i * 2];
         polyline_data->points[i].y = points[i * 2 + 1];
@@ -814,23 +1164,21 @@ void draw_list_object_set_mesh(EseDrawListObject *object, EseDrawListVertex *ver
     log_assert("RENDER_LIST", verts, "draw_list_object_set_mesh called with NULL verts");
     log_assert("RENDER_LIST", indices, "draw_list_object_set_mesh called with NULL indices");
     log_assert("RENDER_LIST", texture_id, "draw_list_object_set_mesh called with NULL texture_id");
-    log_assert("RENDER_LIST", vert_count <= MESH_MAX_VERTS,
-               "draw_list_object_set_mesh called with vert_count > MESH_MAX_VERTS");
-    log_assert("RENDER_LIST", idx_count <= MESH_MAX_INDICES,
-               "draw_list_object_set_mesh called with idx_count > MESH_MAX_INDICES");
 
     object->type = DL_MESH;
     EseDrawListMesh *mesh_data = &object->data.mesh;
 
     // Copy vertex data
+    mesh_data->verts =
+        _draw_list_arena_alloc(object->owner, sizeof(EseDrawListVertex) * vert_count);
     memcpy(mesh_data->verts, verts, sizeof(EseDrawListVertex) * vert_count);
     mesh_data->vert_count = vert_count;
 
     // Copy index data
+    mesh_data->indices = _draw_list_arena_alloc(object->owner, sizeof(uint32_t) * idx_count);
     memcpy(mesh_data->indices, indices, sizeof(uint32_t) * idx_count);
     mesh_data->idx_count = idx_count;
-    strncpy(mesh_data->texture_id, texture_id, TEXTURE_ID_MAX_LEN - 1);
-    mesh_data->texture_id[TEXTURE_ID_MAX_LEN - 1] = '\0';
+    mesh_data->texture_id = draw_list_texture_intern(object->owner, texture_id);
 }
 
 void draw_list_object_get_mesh(const EseDrawListObject *object, const EseDrawListVertex **verts,
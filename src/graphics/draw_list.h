@@ -1,8 +1,10 @@
 /*
  * Project: Entity Sprite Engine
  *
- * Public API for the draw list: an object pool of renderable items and
- * utilities to construct frame render data.
+ * Public API for the draw list: a packed stream of renderable items and
+ * utilities to construct frame render data. Payloads handed to the setters are
+ * copied and stay valid until the next draw_list_clear(); texture ids are
+ * interned and stay valid until the draw list is destroyed.
  *
  * Copyright (c) 2025-2026 Entity Sprite Engine
  * See LICENSE.md for details.
@@ -11,6 +13,7 @@
 #define ESE_DRAW_LIST_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 // ========================================
@@ -41,7 +44,7 @@ typedef enum EseDrawListObjectType {
  * @brief Vertex format for DL_MESH objects.
  */
 typedef struct EseDrawListVertex {
-    float x, y;               /** Position in pixels */
+    float x, y;               /** Position in pixels, relative to the object's x/y */
     float u, v;               /** Texture UV coordinates */
     unsigned char r, g, b, a; /** Vertex color (RGBA 0-255) */
 } EseDrawListVertex;
@@ -83,6 +86,21 @@ void draw_list_clear(EseDrawList *draw_list);
  */
 EseDrawListObject *draw_list_request_object(EseDrawList *draw_list);
 
+/**
+ * @brief Request `count` writable objects for the current frame in one step.
+ *
+ * Thread-safe. Claims a contiguous range of objects under a single lock, so a
+ * worker filling many objects (e.g. one chunk of a parallel render system)
+ * does not take the list's mutex per object. The objects can then be filled
+ * without further locking on their headers.
+ *
+ * @param draw_list Target draw list.
+ * @param count Number of objects to request.
+ * @param out Array of at least `count` pointers that receives the objects.
+ * @return `count` on success, or 0 if the list could not grow.
+ */
+size_t draw_list_request_objects(EseDrawList *draw_list, size_t count, EseDrawListObject **out);
+
 /**
  * @brief Sort objects by their z-index (ascending).
  *
@@ -119,6 +137,22 @@ EseDrawListObject *draw_list_get_object(const EseDrawList *draw_list, size_t ind
  */
 size_t draw_list_reserve_count(EseDrawList *draw_list, size_t count);
 
+/**
+ * @brief Intern a texture id in a draw list.
+ *
+ * @details Returns a pointer that is equal for equal ids and valid until the
+ *          draw list is destroyed. Texture setters intern their id, and the
+ *          getters return the interned pointer, so ids read back from the draw
+ *          list can be compared by pointer. Lookups of known ids are lock-free
+ *          and allocate nothing; a new id takes a mutex. Thread-safe, but not
+ *          concurrently with draw_list_clear().
+ *
+ * @param draw_list Target draw list.
+ * @param texture_id Texture identifier string.
+ * @return Interned id.
+ */
+const char *draw_list_texture_intern(EseDrawList *draw_list, const char *texture_id);
+
 /**
  * @brief Set texture properties on an object and switch its type to DL_TEXTURE.
  *
@@ -147,6 +181,33 @@ void draw_list_object_get_texture(const EseDrawListObject *object, const char **
                                   float *texture_x1, float *texture_y1, float *texture_x2,
                                   float *texture_y2);
 
+/**
+ * @brief Set the color multiplied into a DL_TEXTURE object's texels.
+ *
+ * draw_list_object_set_texture resets the tint to opaque white, so call this
+ * afterwards. Tinted sprites still batch with untinted ones of the same texture.
+ *
+ * @param object Target object (must be DL_TEXTURE).
+ * @param r Red [0-255].
+ * @param g Green [0-255].
+ * @param b Blue [0-255].
+ * @param a Alpha [0-255].
+ */
+void draw_list_object_set_texture_tint(EseDrawListObject *object, unsigned char r,
+                                       unsigned char g, unsigned char b, unsigned char a);
+
+/**
+ * @brief Get the tint of a DL_TEXTURE object.
+ *
+ * @param object Source object (must be DL_TEXTURE).
+ * @param r Out: red.
+ * @param g Out: green.
+ * @param b Out: blue.
+ * @param a Out: alpha.
+ */
+void draw_list_object_get_texture_tint(const EseDrawListObject *object, unsigned char *r,
+                                       unsigned char *g, unsigned char *b, unsigned char *a);
+
 /**
  * @brief Set rectangle color and fill; switches object type to DL_RECT.
  *
@@ -347,6 +408,10 @@ void draw_list_object_get_polyline_stroke_color(const EseDrawListObject *object,
 /**
  * @brief Set mesh data and switch type to DL_MESH.
  *
+ * @details The indices describe a triangle list. Vertex positions are offsets
+ *          from the object's x/y (see draw_list_object_set_bounds), so a cached
+ *          mesh can be moved without rewriting its vertices.
+ *
  * @param object Target object.
  * @param verts Vertex array.
  * @param vert_count Number of vertices.
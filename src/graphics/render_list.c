@@ -8,7 +8,8 @@
 #include <string.h>
 
 #define RENDER_LIST_INITIAL_CAPACITY 32
-#define BATCH_INITIAL_CAPACITY 256
+#define RENDER_LIST_INITIAL_VERTICES 1024
+#define RENDER_LIST_INITIAL_TEXTURES 8
 
 /**
  * @brief Iterator structure for traversing render batches.
@@ -28,48 +29,33 @@ typedef struct EseRenderBatchIterator {
  * @brief Manages a collection of render batches for GPU rendering.
  *
  * @details This structure organizes drawable objects into batches by type
- *          and shared state for efficient GPU rendering. It manages memory
- *          allocation for batches and provides iteration capabilities.
+ *          and shared state for efficient GPU rendering. The vertices of all
+ *          batches live back to back in one buffer, so a renderer uploads the
+ *          frame once and draws each batch as a range of it. Batch structs and
+ *          buffers are kept across clears and reused by the next frame.
  */
 typedef struct EseRenderList {
     EseRenderBatch **batches; /** Array of render batch pointers */
     size_t batch_count;       /** Number of batches in the list */
+    size_t batch_allocated;   /** Number of batch structs allocated, used or not */
     size_t batch_capacity;    /** Allocated capacity for batches array */
-    int width;                /** Viewport width for coordinate conversion */
-    int height;               /** Viewport height for coordinate conversion */
-} EseRenderList;
-
-// Helper to create a new batch
-static EseRenderBatch *_render_batch_create(void) {
-    EseRenderBatch *batch = memory_manager.malloc(sizeof(EseRenderBatch), MMTAG_RENDERLIST);
 
-    memset(batch, 0, sizeof(EseRenderBatch));
-    batch->vertex_buffer =
-        memory_manager.malloc(sizeof(EseVertex) * BATCH_INITIAL_CAPACITY * 4, MMTAG_RENDERLIST);
-    batch->vertex_capacity = BATCH_INITIAL_CAPACITY * 4;
+    EseVertex *vertices;    /** Vertices of every batch, in batch order */
+    size_t vertex_count;    /** Number of vertices currently stored */
+    size_t vertex_capacity; /** Allocated capacity of vertices */
 
-    // Initialize scissor to no clipping
-    batch->scissor_active = false;
-    batch->scissor_x = 0.0f;
-    batch->scissor_y = 0.0f;
-    batch->scissor_w = 0.0f;
-    batch->scissor_h = 0.0f;
+    const char **textures;   /** Distinct texture IDs used by this frame's batches */
+    size_t texture_count;    /** Number of entries in textures */
+    size_t texture_capacity; /** Allocated capacity of textures */
 
-    return batch;
-}
-
-// Helper to free a batch
-static void _render_batch_destroy(EseRenderBatch *batch) {
-    log_assert("RENDER_LIST", batch, "_render_batch_destroy called with NULL batch");
-
-    memory_manager.free(batch->vertex_buffer);
-    memory_manager.free(batch);
-}
+    int width;  /** Viewport width for coordinate conversion */
+    int height; /** Viewport height for coordinate conversion */
+} EseRenderList;
 
-// Helper to add a new batch to the draw list
-static void _render_list_add_batch(EseRenderList *render_list, EseRenderBatch *batch) {
-    log_assert("RENDER_LIST", render_list, "_render_list_add_batch called with NULL render_list");
-    log_assert("RENDER_LIST", batch, "_render_list_add_batch called with NULL batch");
+// Helper to start a new batch at the end of the vertex buffer, reusing a pooled struct
+static EseRenderBatch *_render_list_push_batch(EseRenderList *render_list,
+                                               EseRenderListBatchType type) {
+    log_assert("RENDER_LIST", render_list, "_render_list_push_batch called with NULL render_list");
 
     if (render_list->batch_count >= render_list->batch_capacity) {
         // Grow draw list
@@ -81,7 +67,65 @@ static void _render_list_add_batch(EseRenderList *render_list, EseRenderBatch *b
             render_list->batch_capacity = new_capacity;
         }
     }
-    render_list->batches[render_list->batch_count++] = batch;
+
+    if (render_list->batch_count == render_list->batch_allocated) {
+        render_list->batches[render_list->batch_allocated++] =
+            memory_manager.malloc(sizeof(EseRenderBatch), MMTAG_RENDERLIST);
+    }
+
+    EseRenderBatch *batch = render_list->batches[render_list->batch_count++];
+    memset(batch, 0, sizeof(EseRenderBatch));
+    batch->type = type;
+    batch->vertex_first = render_list->vertex_count;
+
+    return batch;
+}
+
+// Helper to make room for count more vertices, returning where they go
+static EseVertex *_render_list_reserve(EseRenderList *render_list, size_t count) {
+    if (render_list->vertex_count + count > render_list->vertex_capacity) {
+        size_t new_capacity = render_list->vertex_capacity * 2;
+        while (render_list->vertex_count + count > new_capacity)
+            new_capacity *= 2;
+        EseVertex *new_vertices = memory_manager.realloc(
+            render_list->vertices, sizeof(EseVertex) * new_capacity, MMTAG_RENDERLIST);
+        if (!new_vertices) {
+            return NULL;
+        }
+        render_list->vertices = new_vertices;
+        render_list->vertex_capacity = new_capacity;
+    }
+
+    return &render_list->vertices[render_list->vertex_count];
+}
+
+// Helper to append the count vertices written at the reserve point to a batch
+static inline void _render_list_commit(EseRenderList *render_list, EseRenderBatch *batch,
+                                       size_t count) {
+    render_list->vertex_count += count;
+    batch->vertex_count += count;
+}
+
+// Helper to find or add a texture ID in the frame's distinct texture table
+static size_t _render_list_intern_texture(EseRenderList *render_list, const char *texture_id) {
+    for (size_t i = 0; i < render_list->texture_count; ++i) {
+        if (render_list->textures[i] == texture_id ||
+            strcmp(render_list->textures[i], texture_id) == 0) {
+            return i;
+        }
+    }
+
+    if (render_list->texture_count >= render_list->texture_capacity) {
+        size_t new_capacity = render_list->texture_capacity * 2;
+        const char **new_textures = memory_manager.realloc(
+            render_list->textures, sizeof(const char *) * new_capacity, MMTAG_RENDERLIST);
+        if (new_textures) {
+            render_list->textures = new_textures;
+            render_list->texture_capacity = new_capacity;
+        }
+    }
+    render_list->textures[render_list->texture_count] = texture_id;
+    return render_list->texture_count++;
 }
 
 static void _rotate_point(float lx, float ly, float px, float py, float rot, float *ox, float *oy) {
@@ -99,6 +143,51 @@ static inline void _pixel_to_ndc(float px, float py, float view_w, float view_h,
     *ny = 1.0f - (py / view_h) * 2.0f;
 }
 
+// Helper to paint a run of vertices with one color
+static inline void _render_vertices_set_color(EseVertex *vertices, size_t count, unsigned char r,
+                                              unsigned char g, unsigned char b, unsigned char a) {
+    for (size_t i = 0; i < count; ++i) {
+        vertices[i].r = r;
+        vertices[i].g = g;
+        vertices[i].b = b;
+        vertices[i].a = a;
+    }
+}
+
+// Helper to tell whether an object can join a batch under its scissor state
+static bool _render_batch_scissor_matches(const EseRenderBatch *batch,
+                                          const EseDrawListObject *obj) {
+    bool obj_scissor_active;
+    float obj_scissor_x, obj_scissor_y, obj_scissor_w, obj_scissor_h;
+    draw_list_object_get_scissor(obj, &obj_scissor_active, &obj_scissor_x, &obj_scissor_y,
+                                 &obj_scissor_w, &obj_scissor_h);
+
+    if (obj_scissor_active != batch->scissor_active) {
+        return false;
+    }
+    if (!obj_scissor_active) {
+        return true;
+    }
+    return obj_scissor_x == batch->scissor_x && obj_scissor_y == batch->scissor_y &&
+           obj_scissor_w == batch->scissor_w && obj_scissor_h == batch->scissor_h;
+}
+
+// Helper to copy an object's scissor state onto a new batch
+static void _render_batch_set_scissor(EseRenderBatch *batch, const EseDrawListObject *obj) {
+    draw_list_object_get_scissor(obj, &batch->scissor_active, &batch->scissor_x,
+                                 &batch->scissor_y, &batch->scissor_w, &batch->scissor_h);
+}
+
+// Helper to count the triangles _tessellate_polyline_fill emits: the centroid fan
+// makes one per edge, and a duplicate closing point adds no edge
+static size_t _polyline_fill_triangle_count(const float *points, size_t point_count) {
+    if (point_count < 3)
+        return 0;
+    bool is_closed = (point_count > 3 && points[0] == points[(point_count - 1) * 2] &&
+                      points[1] == points[(point_count - 1) * 2 + 1]);
+    return is_closed ? point_count - 1 : point_count;
+}
+
 // Helper to tessellate a polyline into triangles for fill rendering
 static void _tessellate_polyline_fill(const EseDrawListObject *obj, EseVertex *vertices,
                                       size_t *vertex_count, int view_w, int view_h) {
@@ -242,9 +331,9 @@ static void _tessellate_polyline_stroke(const EseDrawListObject *obj, EseVertex
 }
 
 // Helper to add polyline fill vertices directly to a batch
-static void _render_batch_add_polyline_fill_vertices(EseRenderBatch *batch,
-                                                     const EseDrawListObject *obj, int view_w,
-                                                     int view_h) {
+static void _render_batch_add_polyline_fill_vertices(EseRenderList *render_list,
+                                                     EseRenderBatch *batch,
+                                                     const EseDrawListObject *obj) {
     log_assert("RENDER_LIST", batch,
                "_render_batch_add_polyline_fill_vertices called with NULL batch");
     log_assert("RENDER_LIST", obj, "_render_batch_add_polyline_fill_vertices called with NULL obj");
@@ -262,40 +351,28 @@ static void _render_batch_add_polyline_fill_vertices(EseRenderBatch *batch,
     int w, h;
     draw_list_object_get_bounds(obj, &screen_x, &screen_y, &w, &h);
 
-    // Calculate triangle count
-    size_t triangle_count = (point_count > 3 && points[0] == points[(point_count - 1) * 2] &&
-                             points[1] == points[(point_count - 1) * 2 + 1])
-                                ? point_count - 3  // Last point is duplicate of first
-                                : point_count - 2; // Normal case
-
-    size_t fill_vertices = triangle_count * 3;
-
-    // Ensure we have enough capacity
-    if (batch->vertex_count + fill_vertices > batch->vertex_capacity) {
-        size_t new_capacity = batch->vertex_capacity * 2;
-        while (batch->vertex_count + fill_vertices > new_capacity)
-            new_capacity *= 2;
-        EseVertex *new_buffer = memory_manager.realloc(
-            batch->vertex_buffer, sizeof(EseVertex) * new_capacity, MMTAG_RENDERLIST);
-        if (new_buffer) {
-            batch->vertex_buffer = new_buffer;
-            batch->vertex_capacity = new_capacity;
-        }
-    }
+    size_t fill_vertices = _polyline_fill_triangle_count(points, point_count) * 3;
 
-    EseVertex *v = &batch->vertex_buffer[batch->vertex_count];
+    EseVertex *v = _render_list_reserve(render_list, fill_vertices);
+    if (!v)
+        return;
     size_t vertex_offset = 0;
 
     // Tessellate fill vertices
-    _tessellate_polyline_fill(obj, &v[vertex_offset], &vertex_offset, view_w, view_h);
+    _tessellate_polyline_fill(obj, &v[vertex_offset], &vertex_offset, render_list->width,
+                              render_list->height);
 
-    batch->vertex_count += vertex_offset;
+    unsigned char r, g, b, a;
+    draw_list_object_get_polyline_color(obj, &r, &g, &b, &a);
+    _render_vertices_set_color(v, vertex_offset, r, g, b, a);
+
+    _render_list_commit(render_list, batch, vertex_offset);
 }
 
 // Helper to add polyline stroke vertices directly to a batch
-static void _render_batch_add_polyline_stroke_vertices(EseRenderBatch *batch,
-                                                       const EseDrawListObject *obj, int view_w,
-                                                       int view_h) {
+static void _render_batch_add_polyline_stroke_vertices(EseRenderList *render_list,
+                                                       EseRenderBatch *batch,
+                                                       const EseDrawListObject *obj) {
     log_assert("RENDER_LIST", batch,
                "_render_batch_add_polyline_stroke_vertices called with NULL batch");
     log_assert("RENDER_LIST", obj,
@@ -322,34 +399,69 @@ static void _render_batch_add_polyline_stroke_vertices(EseRenderBatch *batch,
 
     size_t stroke_vertices = line_count * 6;
 
-    // Ensure we have enough capacity
-    if (batch->vertex_count + stroke_vertices > batch->vertex_capacity) {
-        size_t new_capacity = batch->vertex_capacity * 2;
-        while (batch->vertex_count + stroke_vertices > new_capacity)
-            new_capacity *= 2;
-        EseVertex *new_buffer = memory_manager.realloc(
-            batch->vertex_buffer, sizeof(EseVertex) * new_capacity, MMTAG_RENDERLIST);
-        if (new_buffer) {
-            batch->vertex_buffer = new_buffer;
-            batch->vertex_capacity = new_capacity;
-        }
-    }
-
-    EseVertex *v = &batch->vertex_buffer[batch->vertex_count];
+    EseVertex *v = _render_list_reserve(render_list, stroke_vertices);
+    if (!v)
+        return;
     size_t vertex_offset = 0;
 
     // Tessellate stroke vertices
-    _tessellate_polyline_stroke(obj, &v[vertex_offset], &vertex_offset, view_w, view_h);
+    _tessellate_polyline_stroke(obj, &v[vertex_offset], &vertex_offset, render_list->width,
+                                render_list->height);
+
+    unsigned char r, g, b, a;
+    draw_list_object_get_polyline_stroke_color(obj, &r, &g, &b, &a);
+    _render_vertices_set_color(v, vertex_offset, r, g, b, a);
+
+    _render_list_commit(render_list, batch, vertex_offset);
+}
+
+// Helper to add mesh vertices to a batch, expanding the index buffer into a triangle list
+static void _render_batch_add_mesh_vertices(EseRenderList *render_list, EseRenderBatch *batch,
+                                            const EseDrawListObject *obj) {
+    log_assert("RENDER_LIST", batch, "_render_batch_add_mesh_vertices called with NULL batch");
+    log_assert("RENDER_LIST", obj, "_render_batch_add_mesh_vertices called with NULL obj");
+
+    const EseDrawListVertex *mesh_verts;
+    size_t vert_count;
+    const uint32_t *mesh_indices;
+    size_t idx_count;
+    draw_list_object_get_mesh(obj, &mesh_verts, &vert_count, &mesh_indices, &idx_count, NULL);
+
+    // Mesh vertices are relative to the object's position
+    float origin_x, origin_y;
+    int w, h;
+    draw_list_object_get_bounds(obj, &origin_x, &origin_y, &w, &h);
+
+    EseVertex *v = _render_list_reserve(render_list, idx_count);
+    if (!v)
+        return;
+    size_t vertex_offset = 0;
+    for (size_t i = 0; i < idx_count; ++i) {
+        uint32_t index = mesh_indices[i];
+        if (index >= vert_count) {
+            continue;
+        }
+
+        const EseDrawListVertex *mv = &mesh_verts[index];
+        float ndc_x, ndc_y;
+        _pixel_to_ndc(origin_x + mv->x, origin_y + mv->y, render_list->width,
+                      render_list->height, &ndc_x, &ndc_y);
+        v[vertex_offset++] =
+            (EseVertex){ndc_x, ndc_y, 0.0f, mv->u, mv->v, mv->r, mv->g, mv->b, mv->a};
+    }
 
-    batch->vertex_count += vertex_offset;
+    _render_list_commit(render_list, batch, vertex_offset);
 }
 
 // Helper to add vertices to a batch
-static void _render_batch_add_object_vertices(EseRenderBatch *batch, const EseDrawListObject *obj,
-                                              int view_w, int view_h) {
+static void _render_batch_add_object_vertices(EseRenderList *render_list, EseRenderBatch *batch,
+                                              const EseDrawListObject *obj) {
     log_assert("RENDER_LIST", batch, "_render_batch_add_object_vertices called with NULL batch");
     log_assert("RENDER_LIST", obj, "_render_batch_add_object_vertices called with NULL obj");
 
+    int view_w = render_list->width;
+    int view_h = render_list->height;
+
     float x, y;
     int w, h;
     draw_list_object_get_bounds(obj, &x, &y, &w, &h);
@@ -363,21 +475,12 @@ static void _render_batch_add_object_vertices(EseRenderBatch *batch, const EseDr
     float ndc_w = (2.0f * w / view_w);
     float ndc_h = (2.0f * h / view_h);
 
-    if (batch->vertex_count + 6 > batch->vertex_capacity) { // Each quad has 6 vertices
-        // Grow vertex buffer
-        size_t new_capacity = batch->vertex_capacity * 2;
-        EseVertex *new_buffer = memory_manager.realloc(
-            batch->vertex_buffer, sizeof(EseVertex) * new_capacity, MMTAG_RENDERLIST);
-        if (new_buffer) {
-            batch->vertex_buffer = new_buffer;
-            batch->vertex_capacity = new_capacity;
-        }
-    }
-
-    EseVertex *v = &batch->vertex_buffer[batch->vertex_count];
-    batch->vertex_count += 6;
-
     if (draw_list_object_get_type(obj) == DL_TEXTURE) {
+        // Each quad has 6 vertices
+        EseVertex *v = _render_list_reserve(render_list, 6);
+        if (!v)
+            return;
+
         const char *texture_id;
         float sx1, sy1, sx2, sy2;
         draw_list_object_get_texture(obj, &texture_id, &sx1, &sy1, &sx2, &sy2);
@@ -399,6 +502,11 @@ static void _render_batch_add_object_vertices(EseRenderBatch *batch, const EseDr
         v[4] = (EseVertex){ndc_x + ndc_w, ndc_y - ndc_h, 0.0f, u1, v1};
         v[5] = (EseVertex){ndc_x + ndc_w, ndc_y, 0.0f, u1, v0};
 
+        unsigned char tr, tg, tb, ta;
+        draw_list_object_get_texture_tint(obj, &tr, &tg, &tb, &ta);
+        _render_vertices_set_color(v, 6, tr, tg, tb, ta);
+        _render_list_commit(render_list, batch, 6);
+
     } else if (draw_list_object_get_type(obj) == DL_RECT) {
         unsigned char rc, gc, bc, ac;
         bool filled;
@@ -443,6 +551,12 @@ static void _render_batch_add_object_vertices(EseRenderBatch *batch, const EseDr
             }
         }
 
+        /* A hollow rect writes 4 border quads, a filled one a single quad */
+        EseVertex *v = _render_list_reserve(render_list, 24);
+        if (!v)
+            return;
+        size_t vertex_total = 6;
+
         if (filled) {
             /* Convert rotated pixel points -> NDC and write two triangles */
             float ndc_px[4], ndc_py[4];
@@ -507,20 +621,7 @@ static void _render_batch_add_object_vertices(EseRenderBatch *batch, const EseDr
                     }
                 }
 
-                /* ensure vertex capacity (we already reserved 6 earlier) */
-                if (batch->vertex_count - 6 + 24 > batch->vertex_capacity) {
-                    size_t new_capacity = batch->vertex_capacity * 2;
-                    while (batch->vertex_count - 6 + 24 > new_capacity)
-                        new_capacity *= 2;
-                    EseVertex *new_buffer = memory_manager.realloc(
-                        batch->vertex_buffer, sizeof(EseVertex) * new_capacity, MMTAG_RENDERLIST);
-                    if (new_buffer) {
-                        batch->vertex_buffer = new_buffer;
-                        batch->vertex_capacity = new_capacity;
-                    }
-                    v = &batch->vertex_buffer[batch->vertex_count - 6];
-                }
-                batch->vertex_count += 18; /* already reserved 6, add 18 more */
+                vertex_total = 24;
 
                 /* convert rotated pixel points to NDC arrays */
                 float odx[4], ody[4], idx[4], idy[4];
@@ -562,6 +663,9 @@ static void _render_batch_add_object_vertices(EseRenderBatch *batch, const EseDr
                 v[23] = (EseVertex){odx[1], ody[1], 0.0f, 0.0f, 0.0f};
             }
         }
+
+        _render_vertices_set_color(v, vertex_total, rc, gc, bc, ac);
+        _render_list_commit(render_list, batch, vertex_total);
     } else if (draw_list_object_get_type(obj) == DL_POLYLINE) {
         const float *points;
         size_t point_count;
@@ -578,16 +682,8 @@ static void _render_batch_add_object_vertices(EseRenderBatch *batch, const EseDr
         size_t fill_vertices = 0;
         size_t stroke_vertices = 0;
 
-        if (fill_a > 0 && point_count >= 3) {
-            // For closed polygons, if last point is duplicate of first, use
-            // (point_count - 3) triangles Otherwise use (point_count - 2)
-            // triangles
-            size_t triangle_count =
-                (point_count > 3 && points[0] == points[(point_count - 1) * 2] &&
-                 points[1] == points[(point_count - 1) * 2 + 1])
-                    ? point_count - 3           // Last point is duplicate of first
-                    : point_count - 2;          // Normal case
-            fill_vertices = triangle_count * 3; // Fan triangulation
+        if (fill_a > 0) {
+            fill_vertices = _polyline_fill_triangle_count(points, point_count) * 3;
         }
 
         if (stroke_a > 0 && point_count >= 2) {
@@ -605,71 +701,26 @@ static void _render_batch_add_object_vertices(EseRenderBatch *batch, const EseDr
         if (total_vertices == 0)
             return; // Nothing to render
 
-        // Ensure we have enough capacity
-        if (batch->vertex_count + total_vertices > batch->vertex_capacity) {
-            size_t new_capacity = batch->vertex_capacity * 2;
-            while (batch->vertex_count + total_vertices > new_capacity)
-                new_capacity *= 2;
-            EseVertex *new_buffer = memory_manager.realloc(
-                batch->vertex_buffer, sizeof(EseVertex) * new_capacity, MMTAG_RENDERLIST);
-            if (new_buffer) {
-                batch->vertex_buffer = new_buffer;
-                batch->vertex_capacity = new_capacity;
-            }
-        }
-
-        EseVertex *v = &batch->vertex_buffer[batch->vertex_count];
+        EseVertex *v = _render_list_reserve(render_list, total_vertices);
+        if (!v)
+            return;
         size_t vertex_offset = 0;
 
         // Add fill vertices if needed
         if (fill_vertices > 0) {
             _tessellate_polyline_fill(obj, &v[vertex_offset], &vertex_offset, view_w, view_h);
+            _render_vertices_set_color(v, vertex_offset, fill_r, fill_g, fill_b, fill_a);
         }
 
         // Add stroke vertices if needed
         if (stroke_vertices > 0) {
+            size_t stroke_start = vertex_offset;
             _tessellate_polyline_stroke(obj, &v[vertex_offset], &vertex_offset, view_w, view_h);
+            _render_vertices_set_color(&v[stroke_start], vertex_offset - stroke_start, stroke_r,
+                                       stroke_g, stroke_b, stroke_a);
         }
 
-        batch->vertex_count += vertex_offset;
-    } else if (draw_list_object_get_type(obj) == DL_MESH) {
-        // Handle mesh objects - use their custom vertices and indices
-        const EseDrawListVertex *mesh_verts;
-        size_t vert_count;
-        const uint32_t *mesh_indices;
-        size_t idx_count;
-
-        // Get mesh data from the draw list object using the proper getter
-        draw_list_object_get_mesh(obj, &mesh_verts, &vert_count, &mesh_indices, &idx_count, NULL);
-
-        // Ensure we have enough capacity for all mesh vertices
-        if (batch->vertex_count + vert_count > batch->vertex_capacity) {
-            size_t new_capacity = batch->vertex_capacity * 2;
-            while (batch->vertex_count + vert_count > new_capacity)
-                new_capacity *= 2;
-            EseVertex *new_buffer = memory_manager.realloc(
-                batch->vertex_buffer, sizeof(EseVertex) * new_capacity, MMTAG_RENDERLIST);
-            if (new_buffer) {
-                batch->vertex_buffer = new_buffer;
-                batch->vertex_capacity = new_capacity;
-            }
-        }
-
-        EseVertex *v = &batch->vertex_buffer[batch->vertex_count];
-
-        // Transform mesh vertices to NDC and copy UV coordinates
-        for (size_t i = 0; i < vert_count; ++i) {
-            float ndc_x = (2.0f * (mesh_verts[i].x / view_w)) - 1.0f;
-            float ndc_y = 1.0f - (2.0f * (mesh_verts[i].y / view_h));
-
-            v[i] = (EseVertex){
-                ndc_x, ndc_y, 0.0f, // Position (x, y, z)
-                mesh_verts[i].u,
-                mesh_verts[i].v // UV coordinates (already normalized)
-            };
-        }
-
-        batch->vertex_count += vert_count;
+        _render_list_commit(render_list, batch, vertex_offset);
     }
 }
 
@@ -680,6 +731,17 @@ EseRenderList *render_list_create(void) {
         sizeof(EseRenderBatch *) * RENDER_LIST_INITIAL_CAPACITY, MMTAG_RENDERLIST);
     render_list->batch_capacity = RENDER_LIST_INITIAL_CAPACITY;
     render_list->batch_count = 0;
+    render_list->batch_allocated = 0;
+
+    render_list->vertices = memory_manager.malloc(
+        sizeof(EseVertex) * RENDER_LIST_INITIAL_VERTICES, MMTAG_RENDERLIST);
+    render_list->vertex_capacity = RENDER_LIST_INITIAL_VERTICES;
+    render_list->vertex_count = 0;
+
+    render_list->textures = memory_manager.malloc(
+        sizeof(const char *) * RENDER_LIST_INITIAL_TEXTURES, MMTAG_RENDERLIST);
+    render_list->texture_capacity = RENDER_LIST_INITIAL_TEXTURES;
+    render_list->texture_count = 0;
 
     return render_list;
 }
@@ -687,11 +749,13 @@ EseRenderList *render_list_create(void) {
 void render_list_destroy(EseRenderList *render_list) {
     log_assert("RENDER_LIST", render_list, "render_list_destroy called with NULL render_list");
 
-    for (size_t i = 0; i < render_list->batch_count; ++i) {
-        _render_batch_destroy(render_list->batches[i]);
+    for (size_t i = 0; i < render_list->batch_allocated; ++i) {
+        memory_manager.free(render_list->batches[i]);
     }
 
     memory_manager.free(render_list->batches);
+    memory_manager.free(render_list->vertices);
+    memory_manager.free(render_list->textures);
     memory_manager.free(render_list);
 }
 
@@ -704,12 +768,10 @@ void render_list_set_size(EseRenderList *render_list, int width, int height) {
 void render_list_clear(EseRenderList *render_list) {
     log_assert("RENDER_LIST", render_list, "render_list_clear called with NULL render_list");
 
-    // Actually destroy and free all batches
-    for (size_t i = 0; i < render_list->batch_count; ++i) {
-        _render_batch_destroy(render_list->batches[i]);
-    }
-
+    // Keep the batch structs and buffers for the next frame
     render_list->batch_count = 0;
+    render_list->vertex_count = 0;
+    render_list->texture_count = 0;
 }
 
 void render_list_fill(EseRenderList *render_list, EseDrawList *draw_list) {
@@ -744,13 +806,8 @@ void render_list_fill(EseRenderList *render_list, EseDrawList *draw_list) {
             size_t fill_vertices = 0;
             size_t stroke_vertices = 0;
 
-            if (fill_a > 0 && point_count >= 3) {
-                size_t triangle_count =
-                    (point_count > 3 && points[0] == points[(point_count - 1) * 2] &&
-                     points[1] == points[(point_count - 1) * 2 + 1])
-                        ? point_count - 3  // Last point is duplicate of first
-                        : point_count - 2; // Normal case
-                fill_vertices = triangle_count * 3;
+            if (fill_a > 0) {
+                fill_vertices = _polyline_fill_triangle_count(points, point_count) * 3;
             }
 
             if (stroke_a > 0 && point_count >= 2) {
@@ -762,62 +819,26 @@ void render_list_fill(EseRenderList *render_list, EseDrawList *draw_list) {
                 stroke_vertices = line_count * 6;
             }
 
-            // Create fill batch if needed
-            if (fill_vertices > 0) {
-                bool new_fill_batch_needed = true;
-                if (current_batch && current_batch->type == RL_COLOR) {
-                    if (current_batch->shared_state.color.r == fill_r &&
-                        current_batch->shared_state.color.g == fill_g &&
-                        current_batch->shared_state.color.b == fill_b &&
-                        current_batch->shared_state.color.a == fill_a &&
-                        current_batch->shared_state.color.filled == true) {
-                        new_fill_batch_needed = false;
-                    }
-                }
+            if (fill_vertices == 0 && stroke_vertices == 0) {
+                continue; // Nothing to render
+            }
 
-                if (new_fill_batch_needed) {
-                    current_batch = _render_batch_create();
-                    current_batch->type = RL_COLOR;
-                    current_batch->shared_state.color.r = fill_r;
-                    current_batch->shared_state.color.g = fill_g;
-                    current_batch->shared_state.color.b = fill_b;
-                    current_batch->shared_state.color.a = fill_a;
-                    current_batch->shared_state.color.filled = true;
-                    _render_list_add_batch(render_list, current_batch);
-                }
+            // Fill and stroke colors travel per vertex, so any color batch
+            // under the same scissor can take both
+            if (!current_batch || current_batch->type != RL_COLOR ||
+                !_render_batch_scissor_matches(current_batch, obj)) {
+                current_batch = _render_list_push_batch(render_list, RL_COLOR);
+                _render_batch_set_scissor(current_batch, obj);
+            }
 
-                // Add fill vertices directly
-                _render_batch_add_polyline_fill_vertices(current_batch, obj, render_list->width,
-                                                         render_list->height);
+            // Add fill vertices directly
+            if (fill_vertices > 0) {
+                _render_batch_add_polyline_fill_vertices(render_list, current_batch, obj);
             }
 
-            // Create stroke batch if needed
+            // Add stroke vertices directly
             if (stroke_vertices > 0) {
-                bool new_stroke_batch_needed = true;
-                if (current_batch && current_batch->type == RL_COLOR) {
-                    if (current_batch->shared_state.color.r == stroke_r &&
-                        current_batch->shared_state.color.g == stroke_g &&
-                        current_batch->shared_state.color.b == stroke_b &&
-                        current_batch->shared_state.color.a == stroke_a &&
-                        current_batch->shared_state.color.filled == false) {
-                        new_stroke_batch_needed = false;
-                    }
-                }
-
-                if (new_stroke_batch_needed) {
-                    current_batch = _render_batch_create();
-                    current_batch->type = RL_COLOR;
-                    current_batch->shared_state.color.r = stroke_r;
-                    current_batch->shared_state.color.g = stroke_g;
-                    current_batch->shared_state.color.b = stroke_b;
-                    current_batch->shared_state.color.a = stroke_a;
-                    current_batch->shared_state.color.filled = false;
-                    _render_list_add_batch(render_list, current_batch);
-                }
-
-                // Add stroke vertices directly
-                _render_batch_add_polyline_stroke_vertices(current_batch, obj, render_list->width,
-                                                           render_list->height);
+                _render_batch_add_polyline_stroke_vertices(render_list, current_batch, obj);
             }
 
             continue; // Skip the normal batching logic below
@@ -826,59 +847,32 @@ void render_list_fill(EseRenderList *render_list, EseDrawList *draw_list) {
         // Check if a new batch is needed
         bool new_batch_needed = false;
         EseRenderListBatchType new_batch_type = RL_COLOR;
+        const char *obj_texture_id = NULL;
         if (draw_list_object_get_type(obj) == DL_TEXTURE) {
             new_batch_type = RL_TEXTURE;
+            draw_list_object_get_texture(obj, &obj_texture_id, NULL, NULL, NULL, NULL);
         } else if (draw_list_object_get_type(obj) == DL_RECT) {
             new_batch_type = RL_COLOR;
         } else if (draw_list_object_get_type(obj) == DL_MESH) {
             new_batch_type = RL_TEXTURE;
+            draw_list_object_get_mesh(obj, NULL, NULL, NULL, NULL, &obj_texture_id);
         }
 
+        // Draw list texture ids are interned, so the pointer test settles almost every object
         if (!current_batch) {
             new_batch_needed = true;
         } else if (current_batch->type != new_batch_type) {
             new_batch_needed = true;
-        } else if (new_batch_type == RL_TEXTURE) {
-            const char *current_texture_id;
-            draw_list_object_get_texture(obj, &current_texture_id, NULL, NULL, NULL, NULL);
-            if (strcmp(current_texture_id, current_batch->shared_state.texture_id) != 0) {
-                new_batch_needed = true;
-            }
-        } else if (new_batch_type == RL_COLOR) {
-            // Compare rect colors to see if we can batch them together
-            unsigned char r, g, b, a;
-            bool filled;
-            draw_list_object_get_rect_color(obj, &r, &g, &b, &a, &filled);
-
-            if (current_batch->shared_state.color.r != r ||
-                current_batch->shared_state.color.g != g ||
-                current_batch->shared_state.color.b != b ||
-                current_batch->shared_state.color.a != a ||
-                current_batch->shared_state.color.filled != filled) {
-                new_batch_needed = true;
-            }
+        } else if (new_batch_type == RL_TEXTURE &&
+                   obj_texture_id != current_batch->shared_state.texture_id &&
+                   strcmp(obj_texture_id, current_batch->shared_state.texture_id) != 0) {
+            new_batch_needed = true;
         }
 
-        // Check scissor rectangles - objects can only be batched if they have
-        // the same scissor state
-        if (!new_batch_needed) {
-            bool obj_scissor_active;
-            float obj_scissor_x, obj_scissor_y, obj_scissor_w, obj_scissor_h;
-
-            draw_list_object_get_scissor(obj, &obj_scissor_active, &obj_scissor_x, &obj_scissor_y,
-                                         &obj_scissor_w, &obj_scissor_h);
-
-            if (obj_scissor_active != current_batch->scissor_active) {
-                new_batch_needed = true;
-            } else if (obj_scissor_active) {
-                // Both have scissor - check if rectangles match
-                if (obj_scissor_x != current_batch->scissor_x ||
-                    obj_scissor_y != current_batch->scissor_y ||
-                    obj_scissor_w != current_batch->scissor_w ||
-                    obj_scissor_h != current_batch->scissor_h) {
-                    new_batch_needed = true;
-                }
-            }
+        // Colors travel per vertex, so only the scissor rectangle can still
+        // split consecutive objects of the same type and texture
+        if (!new_batch_needed && !_render_batch_scissor_matches(current_batch, obj)) {
+            new_batch_needed = true;
         }
 
         if (new_batch_needed) {
@@ -888,43 +882,31 @@ void render_list_fill(EseRenderList *render_list, EseDrawList *draw_list) {
             // }
 
             draw_calls = 0;
-            current_batch = _render_batch_create();
-            if (draw_list_object_get_type(obj) == DL_TEXTURE) {
-                current_batch->type = RL_TEXTURE;
-                draw_list_object_get_texture(obj, &current_batch->shared_state.texture_id, NULL,
-                                             NULL, NULL, NULL);
-            } else if (draw_list_object_get_type(obj) == DL_RECT) {
-                current_batch->type = RL_COLOR;
-                draw_list_object_get_rect_color(
-                    obj, &current_batch->shared_state.color.r, &current_batch->shared_state.color.g,
-                    &current_batch->shared_state.color.b, &current_batch->shared_state.color.a,
-                    &current_batch->shared_state.color.filled);
-            } else if (draw_list_object_get_type(obj) == DL_MESH) {
-                current_batch->type = RL_TEXTURE;
-                // Get the texture ID from the mesh data
-                draw_list_object_get_mesh(obj, NULL, NULL, NULL, NULL,
-                                          &current_batch->shared_state.texture_id);
+            current_batch = _render_list_push_batch(render_list, new_batch_type);
+            if (new_batch_type == RL_TEXTURE) {
+                current_batch->shared_state.texture_id = obj_texture_id;
+                current_batch->texture_index =
+                    _render_list_intern_texture(render_list, obj_texture_id);
             }
 
             // Set scissor state for the new batch
-            bool obj_scissor_active;
-            float obj_scissor_x, obj_scissor_y, obj_scissor_w, obj_scissor_h;
-            draw_list_object_get_scissor(obj, &obj_scissor_active, &obj_scissor_x, &obj_scissor_y,
-                                         &obj_scissor_w, &obj_scissor_h);
-            current_batch->scissor_active = obj_scissor_active;
-            current_batch->scissor_x = obj_scissor_x;
-            current_batch->scissor_y = obj_scissor_y;
-            current_batch->scissor_w = obj_scissor_w;
-            current_batch->scissor_h = obj_scissor_h;
-
-            _render_list_add_batch(render_list, current_batch);
+            _render_batch_set_scissor(current_batch, obj);
         }
 
         // Add the object's vertex data to the current batch
-        _render_batch_add_object_vertices(current_batch, obj, render_list->width,
-                                          render_list->height);
+        if (draw_list_object_get_type(obj) == DL_MESH) {
+            _render_batch_add_mesh_vertices(render_list, current_batch, obj);
+        } else {
+            _render_batch_add_object_vertices(render_list, current_batch, obj);
+        }
     }
     // log_debug("RENDER_LIST", "Batch has %d draw calls", draw_calls);
+
+    // The vertex buffer has stopped moving, so batches can point into it
+    for (size_t i = 0; i < render_list->batch_count; ++i) {
+        EseRenderBatch *batch = render_list->batches[i];
+        batch->vertex_buffer = &render_list->vertices[batch->vertex_first];
+    }
 }
 
 size_t render_list_get_batch_count(const EseRenderList *render_list) {
@@ -944,3 +926,29 @@ const EseRenderBatch *render_list_get_batch(const EseRenderList *render_list, si
 
     return render_list->batches[batch_number];
 }
+
+const EseVertex *render_list_get_vertices(const EseRenderList *render_list, size_t *vertex_count) {
+    log_assert("RENDER_LIST", render_list,
+               "render_list_get_vertices called with NULL render_list");
+
+    if (vertex_count) {
+        *vertex_count = render_list->vertex_count;
+    }
+    return render_list->vertices;
+}
+
+size_t render_list_get_texture_count(const EseRenderList *render_list) {
+    log_assert("RENDER_LIST", render_list,
+               "render_list_get_texture_count called with NULL render_list");
+
+    return render_list->texture_count;
+}
+
+const char *render_list_get_texture(const EseRenderList *render_list, size_t index) {
+    log_assert("RENDER_LIST", render_list, "render_list_get_texture called with NULL render_list");
+    log_assert("RENDER_LIST", index < render_list->texture_count,
+               "render_list_get_texture called with index %zu out of bounds (count %zu)", index,
+               render_list->texture_count);
+
+    return render_list->textures[index];
+}
@@ -9,15 +9,18 @@ typedef struct EseRenderList EseRenderList;
 typedef struct EseRenderBatchIterator EseRenderBatchIterator;
 
 /**
- * @brief Represents a vertex in 3D space with texture coordinates.
+ * @brief Represents a vertex in 3D space with texture coordinates and color.
  *
- * @details This structure stores the position (x, y, z) and texture
- *          coordinates (u, v) for a single vertex in the render pipeline.
- *          Used for building vertex buffers for GPU rendering.
+ * @details This structure stores the position (x, y, z), texture
+ *          coordinates (u, v) and RGBA8 color for a single vertex in the
+ *          render pipeline. Texture batches multiply the texel by the color,
+ *          color batches draw the color alone, so objects of different colors
+ *          share a batch. Used for building vertex buffers for GPU rendering.
  */
 typedef struct {
-    float x, y, z; /** 3D position coordinates */
-    float u, v;    /** Texture coordinates (normalized) */
+    float x, y, z;            /** 3D position coordinates */
+    float u, v;               /** Texture coordinates (normalized) */
+    unsigned char r, g, b, a; /** Vertex color (RGBA 0-255) */
 } EseVertex;
 
 typedef enum EseRenderListBatchType {
@@ -28,29 +31,22 @@ typedef enum EseRenderListBatchType {
 /**
  * @brief Represents a batch of renderable objects with shared state.
  *
- * @details This structure groups objects of the same type (texture or
- * rectangle) that share common properties. It stores the shared state, vertex
- * buffer, and manages memory allocation for efficient GPU rendering.
+ * @details This structure groups consecutive objects of the same type
+ * (texture or color) that share a texture and scissor rectangle. Colors
+ * travel per vertex, so they never split a batch. A batch owns no vertices:
+ * it is the range [vertex_first, vertex_first + vertex_count) of the list's
+ * shared vertex buffer (see render_list_get_vertices).
  */
 typedef struct EseRenderBatch {
     EseRenderListBatchType type; /** Type of objects in this batch */
     union {
         const char *texture_id; /** Texture ID for texture batches */
-        /**
-         * @brief Color and fill information for rectangle batches.
-         *
-         * @details This structure stores the RGBA color components and fill
-         *          style for batches of rectangular objects.
-         */
-        struct {
-            unsigned char r, g, b, a; /** RGBA color for rectangle batches */
-            bool filled;              /** Whether rectangles are filled or outlined */
-        } color;                      /** Color data for rectangle batches */
-    } shared_state;                   /** State shared by all objects in the batch */
+    } shared_state;             /** State shared by all objects in the batch */
+    size_t texture_index;       /** Texture batches: index for render_list_get_texture */
 
-    EseVertex *vertex_buffer; /** Buffer containing vertex data */
-    size_t vertex_count;      /** Number of vertices currently stored */
-    size_t vertex_capacity;   /** Allocated capacity for vertex buffer */
+    const EseVertex *vertex_buffer; /** This batch's vertices, valid until the next clear */
+    size_t vertex_first;            /** Index of the first vertex in the shared buffer */
+    size_t vertex_count;            /** Number of vertices in the batch */
 
     // Scissor/clipping state for this batch
     bool scissor_active; /** Whether scissor clipping is enabled for this batch
@@ -66,4 +62,28 @@ void render_list_fill(EseRenderList *render_list, EseDrawList *draw_list);
 size_t render_list_get_batch_count(const EseRenderList *render_list);
 const EseRenderBatch *render_list_get_batch(const EseRenderList *render_list, size_t batch_number);
 
+/**
+ * @brief Gets the vertices of every batch, laid out back to back in batch order.
+ *
+ * @details Renderers upload this buffer once per frame and draw each batch as
+ * its (vertex_first, vertex_count) range.
+ *
+ * @param render_list The filled render list.
+ * @param vertex_count Out: total number of vertices, may be NULL.
+ * @return The vertex buffer, valid until the next clear or fill.
+ */
+const EseVertex *render_list_get_vertices(const EseRenderList *render_list, size_t *vertex_count);
+
+/**
+ * @brief Gets the number of distinct textures used by the list's texture batches.
+ */
+size_t render_list_get_texture_count(const EseRenderList *render_list);
+
+/**
+ * @brief Gets a distinct texture ID by the index stored in EseRenderBatch::texture_index.
+ *
+ * @details Lets a renderer resolve each texture once per frame rather than once per batch.
+ */
+const char *render_list_get_texture(const EseRenderList *render_list, size_t index);
+
 #endif // ESE_RENDER_LIST_H
@@ -10,12 +10,15 @@ const char *DEFAULT_SHADER = "#version 450\n"
                              "#ifdef VERTEX_SHADER\n"
                              "layout(location = 0) in vec3 aPos;\n"
                              "layout(location = 1) in vec2 aTexCoord;\n"
+                             "layout(location = 2) in vec4 aColor;\n"
                              "\n"
                              "layout(location = 0) out vec2 TexCoord;\n"
+                             "layout(location = 1) out vec4 Color;\n"
                              "\n"
                              "void main() {\n"
                              "    gl_Position = vec4(aPos, 1.0);\n"
                              "    TexCoord = aTexCoord;\n"
+                             "    Color = aColor;\n"
                              "}\n"
                              "#endif\n"
                              "\n"
@@ -23,29 +26,25 @@ const char *DEFAULT_SHADER = "#version 450\n"
                              "precision mediump float;\n"
                              "\n"
                              "layout(location = 0) in vec2 TexCoord;\n"
+                             "layout(location = 1) in vec4 Color;\n"
                              "layout(location = 0) out vec4 FragColor;\n"
                              "\n"
                              "layout(binding = 0) uniform sampler2D ourTexture;\n"
                              "\n"
                              "layout(binding = 1) uniform UniformBufferObject {\n"
                              "    bool useTexture;\n"
-                             "    vec4 rectColor;\n"
                              "    vec4 tint;\n"
                              "    float opacity;\n"
                              "} ubo;\n"
                              "\n"
                              "void main() {\n"
+                             "    vec4 color = Color;\n"
                              "    if (ubo.useTexture) {\n"
-                             "        vec4 tex = texture(ourTexture, TexCoord);\n"
-                             "        tex *= ubo.tint;\n"
-                             "        tex.a *= ubo.opacity;\n"
-                             "        FragColor = tex;\n"
-                             "    } else {\n"
-                             "        vec4 solid = ubo.rectColor;\n"
-                             "        solid *= ubo.tint;\n"
-                             "        solid.a *= ubo.opacity;\n"
-                             "        FragColor = solid;\n"
+                             "        color *= texture(ourTexture, TexCoord);\n"
                              "    }\n"
+                             "    color *= ubo.tint;\n"
+                             "    color.a *= ubo.opacity;\n"
+                             "    FragColor = color;\n"
                              "}\n"
                              "#endif\n"
                              "\n"
@@ -13,6 +13,7 @@
 #include "utility/log.h"
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -66,6 +67,9 @@ EseRenderer *renderer_create(bool hiDPI) {
     internal->vao = 0;
     internal->vbo = 0;
     internal->vbo_capacity = 0;
+    internal->use_texture_location = -1;
+    internal->frame_textures = NULL;
+    internal->frame_texture_capacity = 0;
 
     _renderer_shader_compile_source(renderer, "default", DEFAULT_SHADER);
     renderer_create_pipeline_state(renderer, "default:vertexShader", "default:fragmentShader");
@@ -86,6 +90,9 @@ void renderer_destroy(EseRenderer *renderer) {
     if (internal->vbo != 0) {
         glDeleteBuffers(1, &internal->vbo);
     }
+    if (internal->frame_textures) {
+        memory_manager.free(internal->frame_textures);
+    }
     memory_manager.free(renderer->internal);
 
     // Hashmaps will automatically free their values using the free functions
@@ -284,23 +291,49 @@ bool renderer_create_pipeline_state(EseRenderer *renderer, const char *vertexFun
         return false;
     }
 
+    // Resolve uniforms once. The sampler, tint and opacity never change
+    // between batches, so they are set here rather than every frame.
+    internal->use_texture_location =
+        glGetUniformLocation(internal->shaderProgram, "ubo.useTexture");
+    GLint textureLocation = glGetUniformLocation(internal->shaderProgram, "ourTexture");
+    GLint tintLocation = glGetUniformLocation(internal->shaderProgram, "ubo.tint");
+    GLint opacityLocation = glGetUniformLocation(internal->shaderProgram, "ubo.opacity");
+    glUseProgram(internal->shaderProgram);
+    if (textureLocation != -1) {
+        glUniform1i(textureLocation, 0);
+    }
+    if (tintLocation != -1) {
+        glUniform4f(tintLocation, 1.0f, 1.0f, 1.0f, 1.0f);
+    }
+    if (opacityLocation != -1) {
+        glUniform1f(opacityLocation, 1.0f);
+    }
+    glUseProgram(0);
+
     // After creating pipeline state, add:
     glGenVertexArrays(1, &internal->vao);
     glGenBuffers(1, &internal->vbo);
 
     glBindVertexArray(internal->vao);
     glBindBuffer(GL_ARRAY_BUFFER, internal->vbo);
-    internal->vbo_capacity = MAX_BATCH_VERTICES * 5 * sizeof(float);
+    internal->vbo_capacity = MAX_BATCH_VERTICES * sizeof(EseVertex);
     glBufferData(GL_ARRAY_BUFFER, internal->vbo_capacity, NULL, GL_DYNAMIC_DRAW);
 
     // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(EseVertex),
+                          (void *)offsetof(EseVertex, x));
     glEnableVertexAttribArray(0);
 
     // Texture coordinate attribute
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)(3 * sizeof(float)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(EseVertex),
+                          (void *)offsetof(EseVertex, u));
     glEnableVertexAttribArray(1);
 
+    // Color attribute, RGBA8 normalized to 0..1
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(EseVertex),
+                          (void *)offsetof(EseVertex, r));
+    glEnableVertexAttribArray(2);
+
     glBindVertexArray(0);
 
     return true;
@@ -385,7 +418,8 @@ void renderer_draw(EseRenderer *renderer) {
     glClear(GL_COLOR_BUFFER_BIT);
 
     if (renderer->render_list && render_list_get_batch_count(renderer->render_list) > 0) {
-        size_t numBatches = render_list_get_batch_count(renderer->render_list);
+        EseRenderList *render_list = renderer->render_list;
+        size_t numBatches = render_list_get_batch_count(render_list);
 
         // --- GL State Setup (ONCE per frame) ---
         glUseProgram(internal->shaderProgram);
@@ -393,33 +427,69 @@ void renderer_draw(EseRenderer *renderer) {
         glBindBuffer(GL_ARRAY_BUFFER, internal->vbo);
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-        // Get uniform locations ONCE per frame
-        GLint useTextureLocation = glGetUniformLocation(internal->shaderProgram, "ubo.useTexture");
-        GLint rectColorLocation = glGetUniformLocation(internal->shaderProgram, "ubo.rectColor");
-        GLint tintLocation = glGetUniformLocation(internal->shaderProgram, "ubo.tint");
-        GLint opacityLocation = glGetUniformLocation(internal->shaderProgram, "ubo.opacity");
-        GLint textureLocation = glGetUniformLocation(internal->shaderProgram, "ourTexture");
-
-        // Set the texture sampler to use texture unit 0
-        if (textureLocation != -1) {
-            glUniform1i(textureLocation, 0);
+        glActiveTexture(GL_TEXTURE0);
+
+        // Upload every batch's vertices in one go; batches are ranges of it
+        size_t vertex_count;
+        const EseVertex *vertices = render_list_get_vertices(render_list, &vertex_count);
+        size_t data_size = vertex_count * sizeof(EseVertex);
+        if (data_size > internal->vbo_capacity) {
+            internal->vbo_capacity = max(internal->vbo_capacity * 2, data_size * 2);
+            glBufferData(GL_ARRAY_BUFFER, internal->vbo_capacity, NULL, GL_DYNAMIC_DRAW);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, data_size, vertices);
+
+        // Resolve each distinct texture once rather than once per batch
+        size_t texture_count = render_list_get_texture_count(render_list);
+        if (texture_count > internal->frame_texture_capacity) {
+            size_t new_capacity = max(internal->frame_texture_capacity * 2, texture_count);
+            GLuint *new_textures = memory_manager.realloc(
+                internal->frame_textures, sizeof(GLuint) * new_capacity, MMTAG_RENDERER);
+            if (!new_textures) {
+                texture_count = internal->frame_texture_capacity;
+            } else {
+                internal->frame_textures = new_textures;
+                internal->frame_texture_capacity = new_capacity;
+            }
+        }
+        for (size_t i = 0; i < texture_count; ++i) {
+            const char *texture_id = render_list_get_texture(render_list, i);
+            GLTexture *tex_data = (GLTexture *)hashmap_get(renderer->textures, texture_id);
+            if (!tex_data) {
+                log_debug("GL_RENDERER", "Unable to find texture %s", texture_id);
+            }
+            internal->frame_textures[i] = tex_data ? tex_data->id : 0;
         }
 
+        // Only touch GL state when a batch changes it
+        GLuint bound_texture = 0;
+        int use_texture = -1;
+        bool scissor_enabled = false;
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glDisable(GL_SCISSOR_TEST);
+
         // --- Batch Drawing Loop ---
         for (size_t i = 0; i < numBatches; ++i) {
-            const EseRenderBatch *batch = render_list_get_batch(renderer->render_list, i);
+            const EseRenderBatch *batch = render_list_get_batch(render_list, i);
 
             if (batch->vertex_count == 0)
                 continue;
 
-            // defaults for optional fields
-            float tint_r = 1.0f, tint_g = 1.0f, tint_b = 1.0f, tint_a = 1.0f;
-            float opacity = 1.0f;
+            GLuint texture = 0;
+            if (batch->type == RL_TEXTURE) {
+                if (batch->texture_index >= texture_count)
+                    continue;
+                texture = internal->frame_textures[batch->texture_index];
+                if (texture == 0)
+                    continue;
+            }
 
             // Handle scissor test for this batch
             if (batch->scissor_active) {
-                glEnable(GL_SCISSOR_TEST);
+                if (!scissor_enabled) {
+                    glEnable(GL_SCISSOR_TEST);
+                    scissor_enabled = true;
+                }
                 // Convert from screen coordinates to OpenGL viewport
                 // coordinates OpenGL scissor uses bottom-left origin, so we
                 // need to flip Y
@@ -428,88 +498,31 @@ void renderer_draw(EseRenderer *renderer) {
                 int scissor_w = (int)batch->scissor_w;
                 int scissor_h = (int)batch->scissor_h;
                 glScissor(scissor_x, scissor_y, scissor_w, scissor_h);
-            } else {
+            } else if (scissor_enabled) {
                 glDisable(GL_SCISSOR_TEST);
+                scissor_enabled = false;
             }
 
-            if (batch->type == RL_TEXTURE) {
-                // Handle texture batch
-                GLTexture *tex_data =
-                    (GLTexture *)hashmap_get(renderer->textures, batch->shared_state.texture_id);
-                if (!tex_data) {
-                    log_debug("GL_RENDERER", "Unable to find texture %s",
-                              batch->shared_state.texture_id);
-                    continue;
-                }
-
-                // Bind the texture
-                glActiveTexture(GL_TEXTURE0);
-                glBindTexture(GL_TEXTURE_2D, tex_data->id);
-
-                // Set uniforms for texture rendering
-                if (useTextureLocation != -1) {
-                    glUniform1ui(useTextureLocation, 1);
-                } else {
-                    log_debug("GL_RENDERER", "Invalid texture uniform location");
-                }
-                if (tintLocation != -1) {
-                    glUniform4f(tintLocation, tint_r, tint_g, tint_b, tint_a);
-                }
-                if (opacityLocation != -1) {
-                    glUniform1f(opacityLocation, opacity);
-                }
-
-                // Upload vertex data to VBO
-                size_t data_size = batch->vertex_count * sizeof(EseVertex);
-                if (data_size > internal->vbo_capacity) {
-                    internal->vbo_capacity = max(internal->vbo_capacity * 2, data_size * 2);
-                    glBufferData(GL_ARRAY_BUFFER, internal->vbo_capacity, batch->vertex_buffer,
-                                 GL_DYNAMIC_DRAW);
-                } else {
-                    glBufferSubData(GL_ARRAY_BUFFER, 0, data_size, batch->vertex_buffer);
-                }
-
-                // Draw the batch
-                glDrawArrays(GL_TRIANGLES, 0, batch->vertex_count);
-
-            } else if (batch->type == RL_COLOR) {
-                // Handle rectangle batch
-                // Unbind texture for solid color rendering
-                glBindTexture(GL_TEXTURE_2D, 0);
-
-                // Set uniforms for solid color rendering
-                if (useTextureLocation != -1) {
-                    glUniform1ui(useTextureLocation, 0);
-                }
-                if (tintLocation != -1) {
-                    glUniform4f(tintLocation, tint_r, tint_g, tint_b, tint_a);
-                }
-                if (opacityLocation != -1) {
-                    glUniform1f(opacityLocation, opacity);
-                }
-                if (rectColorLocation != -1) {
-                    glUniform4f(rectColorLocation, (float)batch->shared_state.color.r / 255.0f,
-                                (float)batch->shared_state.color.g / 255.0f,
-                                (float)batch->shared_state.color.b / 255.0f,
-                                (float)batch->shared_state.color.a / 255.0f);
-                }
+            // Color batches unbind the texture, colors come from the vertices
+            if (texture != bound_texture) {
+                glBindTexture(GL_TEXTURE_2D, texture);
+                bound_texture = texture;
+            }
 
-                // Upload vertex data to VBO
-                size_t data_size = batch->vertex_count * sizeof(EseVertex);
-                if (data_size > internal->vbo_capacity) {
-                    internal->vbo_capacity = max(internal->vbo_capacity * 2, data_size * 2);
-                    glBufferData(GL_ARRAY_BUFFER, internal->vbo_capacity, batch->vertex_buffer,
-                                 GL_DYNAMIC_DRAW);
-                } else {
-                    glBufferSubData(GL_ARRAY_BUFFER, 0, data_size, batch->vertex_buffer);
+            int batch_use_texture = batch->type == RL_TEXTURE ? 1 : 0;
+            if (batch_use_texture != use_texture) {
+                if (internal->use_texture_location != -1) {
+                    glUniform1ui(internal->use_texture_location, (GLuint)batch_use_texture);
                 }
-
-                // Draw the batch
-                glDrawArrays(GL_TRIANGLES, 0, batch->vertex_count);
+                use_texture = batch_use_texture;
             }
+
+            // Draw the batch's range of the frame's vertex buffer
+            glDrawArrays(GL_TRIANGLES, (GLint)batch->vertex_first, (GLsizei)batch->vertex_count);
         }
 
         // --- Cleanup ---
+        glDisable(GL_SCISSOR_TEST);
         glBindVertexArray(0);
         glBindTexture(GL_TEXTURE_2D, 0);
         glUseProgram(0);
@@ -23,6 +23,11 @@ typedef struct EseGLRenderer {
     GLuint vbo;           /** Vertex buffer object ID */
     size_t vbo_capacity;  /** Allocated capacity of vertex buffer */
     GLuint ubo;           /** Uniform buffer object ID */
+
+    GLint use_texture_location; /** ubo.useTexture, resolved when the pipeline is linked */
+
+    GLuint *frame_textures;        /** GL texture per render_list_get_texture index */
+    size_t frame_texture_capacity; /** Allocated capacity of frame_textures */
 } EseGLRenderer;
 
 /**
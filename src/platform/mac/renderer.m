@@ -380,9 +380,13 @@ bool renderer_create_pipeline_state(EseRenderer *renderer, const char *vertexFun
     vertexDescriptor.attributes[1].offset = sizeof(float) * 3; // Offset after the float3 position
     vertexDescriptor.attributes[1].bufferIndex = 0;
 
+    // Color attribute (aColor) at attribute index 2, RGBA8 normalized to 0..1
+    vertexDescriptor.attributes[2].format = MTLVertexFormatUChar4Normalized;
+    vertexDescriptor.attributes[2].offset = offsetof(EseVertex, r);
+    vertexDescriptor.attributes[2].bufferIndex = 0;
+
     // Layout for buffer 0
-    vertexDescriptor.layouts[0].stride =
-        sizeof(float) * 5; // Size of a single vertex: 3 floats (pos) + 2 floats (tex coords)
+    vertexDescriptor.layouts[0].stride = sizeof(EseVertex);
     vertexDescriptor.layouts[0].stepFunction = MTLVertexStepFunctionPerVertex;
     vertexDescriptor.layouts[0].stepRate = 1;
 
@@ -454,6 +458,36 @@ void renderer_draw(EseRenderer *renderer) {
     if (renderer->render_list && render_list_get_batch_count(renderer->render_list) > 0) {
         size_t numBatches = render_list_get_batch_count(renderer->render_list);
 
+        // Copy every batch's vertices into this frame's region in one go;
+        // batches are drawn as ranges of it
+        size_t vertexCount;
+        const EseVertex *vertices = render_list_get_vertices(renderer->render_list, &vertexCount);
+        size_t data_size = vertexCount * sizeof(EseVertex);
+
+        // ensure per-frame capacity can hold the frame
+        if (!internal->vertexBuffer || perFrameCap < data_size) {
+            _ensure_vertex_ring_buffer(internal, data_size);
+            perFrameCap = internal->perFrameVertexCapacity;
+            frameBase = (internal->inflightIndex % inflight) * perFrameCap;
+        }
+        if (!internal->vertexBuffer || perFrameCap < data_size) {
+            // allocation failed or still too small
+            numBatches = 0;
+        } else {
+            void *dest = (char *)[internal->vertexBuffer contents] + frameBase;
+            memcpy(dest, vertices, data_size);
+            [encoder setVertexBuffer:internal->vertexBuffer offset:frameBase atIndex:0];
+            internal->frameVertexCursor = data_size;
+        }
+
+        // prepare and set small UBO via setFragmentBytes (avoids MTLBuffer
+        // reuse races). Colors come from the vertices.
+        UniformBufferObject ubo;
+
+        // Just hard code defaults for now
+        ubo.tint = (EseVector4){1.0f, 1.0f, 1.0f, 1.0f};
+        ubo.opacity = 1.0f;
+
         for (size_t i = 0; i < numBatches; ++i) {
             const EseRenderBatch *batch = render_list_get_batch(renderer->render_list, i);
             if (!batch)
@@ -486,76 +520,15 @@ void renderer_draw(EseRenderer *renderer) {
                     continue;
             }
 
-            // compute data size depending on batch type
-            size_t data_size = 0;
-            if (batch->type == RL_TEXTURE) {
-                data_size = batch->vertex_count * sizeof(EseVertex);
-            } else if (batch->type == RL_COLOR) {
-                data_size = batch->vertex_count * 5 * sizeof(float);
-            }
-            if (data_size == 0)
-                continue;
-
-            // ensure per-frame capacity can hold this batch
-            if (!internal->vertexBuffer || perFrameCap < data_size) {
-                _ensure_vertex_ring_buffer(internal, data_size);
-                perFrameCap = internal->perFrameVertexCapacity;
-                frameBase = (internal->inflightIndex % inflight) * perFrameCap;
-            }
-            if (!internal->vertexBuffer || perFrameCap < data_size) {
-                // allocation failed or still too small
-                continue;
-            }
-
-            // align writes to 256 bytes to be safe for GPU
-            size_t align = 256;
-            size_t writeOffset = (internal->frameVertexCursor + (align - 1)) & ~(align - 1);
-            if (writeOffset + data_size > perFrameCap) {
-                // not enough room left in this frame region
-                continue;
-            }
-
-            // copy vertex data into the ring buffer region for this frame
-            void *dest = (char *)[internal->vertexBuffer contents] + frameBase + writeOffset;
-            memcpy(dest, batch->vertex_buffer, data_size);
-
-            // bind vertex buffer with global offset into ring buffer
-            [encoder setVertexBuffer:internal->vertexBuffer
-                              offset:(frameBase + writeOffset)
-                             atIndex:0];
+            ubo.useTexture.x = batch->type == RL_TEXTURE ? 1 : 0;
 
-            // prepare and set small UBO via setFragmentBytes (avoids MTLBuffer
-            // reuse races)
-            UniformBufferObject ubo;
-
-            // Just hard code defaults for now
-            ubo.tint = (EseVector4){1.0f, 1.0f, 1.0f, 1.0f};
-            ubo.opacity = 1.0f;
-
-            if (batch->type == RL_TEXTURE) {
-                ubo.useTexture.x = 1;
-                ubo.color.x = 0.0f;
-                ubo.color.y = 0.0f;
-                ubo.color.z = 0.0f;
-                ubo.color.w = 0.0f;
-            } else if (batch->type == RL_COLOR) {
-                ubo.useTexture.x = 0;
-                ubo.color.x = (float)batch->shared_state.color.r / 255.0f;
-                ubo.color.y = (float)batch->shared_state.color.g / 255.0f;
-                ubo.color.z = (float)batch->shared_state.color.b / 255.0f;
-                ubo.color.w = (float)batch->shared_state.color.a / 255.0f;
-            }
-
-            [encoder setFragmentTexture:(batch->type == RL_TEXTURE ? tex : nil) atIndex:0];
+            [encoder setFragmentTexture:tex atIndex:0];
             [encoder setFragmentBytes:&ubo length:sizeof(UniformBufferObject) atIndex:1];
 
             // draw
             [encoder drawPrimitives:MTLPrimitiveTypeTriangle
-                        vertexStart:0
+                        vertexStart:batch->vertex_first
                         vertexCount:batch->vertex_count];
-
-            // advance cursor for this frame
-            internal->frameVertexCursor = writeOffset + data_size;
         }
     }
 
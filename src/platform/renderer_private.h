@@ -26,15 +26,14 @@ typedef struct {
  * @brief Uniform buffer object for shader parameters.
  *
  * @details This structure defines the layout of uniform data passed to
- *          shaders, including texture usage flags and rectangle color
- *          information for rendering decisions.
+ *          shaders, including the texture usage flag and a tint applied on
+ *          top of the per-vertex color.
  */
 typedef struct {
     EseVector1i useTexture; /** Flag indicating whether to use texture (1) or
                                color (0) */
     uint32_t _pad0[3];      /** Padding for std140 alignment */
-    EseVector4 color;       /** RGBA color for rendering */
-    EseVector4 tint;        /** RGBA tint for texture rendering */
+    EseVector4 tint;        /** RGBA tint for rendering */
     float opacity;          /** Opacity for rendering */
     float _pad[3];          /** Padding for std140 alignment */
 } UniformBufferObject;
@@ -519,6 +519,13 @@ int lua_engine_instance_script(EseLuaEngine *engine, const char *name) {
     return instance_ref;
 }
 
+bool lua_engine_has_script(EseLuaEngine *engine, const char *filename) {
+    log_assert("LUA_ENGINE", engine, "lua_engine_has_script called with NULL engine");
+    log_assert("LUA_ENGINE", filename, "lua_engine_has_script called with NULL filename");
+
+    return hashmap_get(engine->internal->functions, filename) != NULL;
+}
+
 void lua_engine_instance_remove(EseLuaEngine *engine, int instance_ref) {
     log_assert("LUA_ENGINE", engine, "lua_eng_inst_remove called with NULL engine");
 
@@ -178,6 +178,15 @@ bool lua_engine_load_script_from_string(EseLuaEngine *engine, const char *script
  */
 int lua_engine_instance_script(EseLuaEngine *engine, const char *filename);
 
+/**
+ * @brief Checks whether a script has been loaded.
+ *
+ * @param engine Pointer to the EseLuaEngine.
+ * @param filename Name the script was loaded under.
+ * @return true if lua_engine_instance_script can instance it.
+ */
+bool lua_engine_has_script(EseLuaEngine *engine, const char *filename);
+
 /**
  * @brief Removes a Lua script instance from the registry.
  *
@@ -41,6 +41,21 @@ typedef enum EseCollisionState {
  */
 typedef struct EseCollisionHit EseCollisionHit; // Opaque
 
+/**
+ * @brief One collision as seen by one of its entities, plain data only.
+ *
+ * @details Used to hand a frame's hits to an entity in a single batch without
+ *          creating EseCollisionHit userdata. `cell_x` and `cell_y` are only
+ *          meaningful for COLLISION_KIND_MAP.
+ */
+typedef struct EseCollisionRecord {
+    EseEntity *other;        /**< The entity collided with */
+    EseCollisionKind kind;   /**< Collider or map hit */
+    EseCollisionState state; /**< Enter, stay or leave */
+    int cell_x;              /**< Map cell x for map hits */
+    int cell_y;              /**< Map cell y for map hits */
+} EseCollisionRecord;
+
 /* --- Lua API
  * ----------------------------------------------------------------------------------
  */
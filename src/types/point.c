@@ -32,6 +32,9 @@ typedef struct EsePoint {
     int lua_ref_count; /** Number of times this point has been referenced in C
                         */
 
+    const EsePointView *view; /** Storage read and written instead of x/y, or NULL */
+    void *view_data;          /** Passed to the view accessors */
+
     // Watcher system
     EsePointWatcherCallback *watchers; /** Array of watcher callbacks */
     void **watcher_userdata;           /** Array of userdata for each watcher */
@@ -72,6 +75,8 @@ EsePoint *_ese_point_make() {
     point->state = NULL;
     _ese_point_set_lua_ref(point, LUA_NOREF);
     _ese_point_set_lua_ref_count(point, 0);
+    point->view = NULL;
+    point->view_data = NULL;
     point->watchers = NULL;
     point->watcher_userdata = NULL;
     point->watcher_count = 0;
@@ -79,6 +84,30 @@ EsePoint *_ese_point_make() {
     return point;
 }
 
+/**
+ * @brief Reads the coordinates from the point or its view.
+ */
+static inline void _ese_point_read(const EsePoint *point, float *x, float *y) {
+    if (point->view) {
+        point->view->get(point->view_data, x, y);
+    } else {
+        *x = point->x;
+        *y = point->y;
+    }
+}
+
+/**
+ * @brief Writes the coordinates to the point or its view.
+ */
+static inline void _ese_point_write(EsePoint *point, float x, float y) {
+    if (point->view) {
+        point->view->set(point->view_data, x, y);
+    } else {
+        point->x = x;
+        point->y = y;
+    }
+}
+
 // Watcher system
 /**
  * @brief Notifies all registered watchers of a point change
@@ -130,11 +159,12 @@ EsePoint *ese_point_copy(const EsePoint *source) {
     log_assert("POINT", source, "ese_point_copy called with NULL source");
 
     EsePoint *copy = (EsePoint *)memory_manager.malloc(sizeof(EsePoint), MMTAG_POINT);
-    copy->x = source->x;
-    copy->y = source->y;
+    _ese_point_read(source, &copy->x, &copy->y);
     copy->state = source->state;
     _ese_point_set_lua_ref(copy, LUA_NOREF);
     _ese_point_set_lua_ref_count(copy, 0);
+    copy->view = NULL;
+    copy->view_data = NULL;
     copy->watchers = NULL;
     copy->watcher_userdata = NULL;
     copy->watcher_count = 0;
@@ -257,8 +287,11 @@ float ese_point_distance(const EsePoint *point1, const EsePoint *point2) {
     log_assert("POINT", point1, "ese_point_distance called with NULL first point");
     log_assert("POINT", point2, "ese_point_distance called with NULL second point");
 
-    float dx = point2->x - point1->x;
-    float dy = point2->y - point1->y;
+    float x1, y1, x2, y2;
+    _ese_point_read(point1, &x1, &y1);
+    _ese_point_read(point2, &x2, &y2);
+    float dx = x2 - x1;
+    float dy = y2 - y1;
     return sqrtf(dx * dx + dy * dy);
 }
 
@@ -266,31 +299,56 @@ float ese_point_distance_squared(const EsePoint *point1, const EsePoint *point2)
     log_assert("POINT", point1, "ese_point_distance_squared called with NULL first point");
     log_assert("POINT", point2, "ese_point_distance_squared called with NULL second point");
 
-    float dx = point2->x - point1->x;
-    float dy = point2->y - point1->y;
+    float x1, y1, x2, y2;
+    _ese_point_read(point1, &x1, &y1);
+    _ese_point_read(point2, &x2, &y2);
+    float dx = x2 - x1;
+    float dy = y2 - y1;
     return dx * dx + dy * dy;
 }
 
 // Property access
 void ese_point_set_x(EsePoint *point, float x) {
     log_assert("POINT", point, "ese_point_set_x called with NULL point");
-    point->x = x;
+    if (point->view) {
+        float old_x, y;
+        point->view->get(point->view_data, &old_x, &y);
+        point->view->set(point->view_data, x, y);
+    } else {
+        point->x = x;
+    }
     _ese_point_make_point_notify_watchers(point);
 }
 
 float ese_point_get_x(const EsePoint *point) {
     log_assert("POINT", point, "ese_point_get_x called with NULL point");
+    if (point->view) {
+        float x, y;
+        point->view->get(point->view_data, &x, &y);
+        return x;
+    }
     return point->x;
 }
 
 void ese_point_set_y(EsePoint *point, float y) {
     log_assert("POINT", point, "ese_point_set_y called with NULL point");
-    point->y = y;
+    if (point->view) {
+        float x, old_y;
+        point->view->get(point->view_data, &x, &old_y);
+        point->view->set(point->view_data, x, y);
+    } else {
+        point->y = y;
+    }
     _ese_point_make_point_notify_watchers(point);
 }
 
 float ese_point_get_y(const EsePoint *point) {
     log_assert("POINT", point, "ese_point_get_y called with NULL point");
+    if (point->view) {
+        float x, y;
+        point->view->get(point->view_data, &x, &y);
+        return y;
+    }
     return point->y;
 }
 
@@ -310,6 +368,17 @@ int ese_point_get_lua_ref_count(const EsePoint *point) {
     return point->lua_ref_count;
 }
 
+void ese_point_set_view(EsePoint *point, const EsePointView *view, void *data) {
+    log_assert("POINT", point, "ese_point_set_view called with NULL point");
+
+    // Keep the current coordinates when switching storage
+    float x, y;
+    _ese_point_read(point, &x, &y);
+    point->view = view;
+    point->view_data = data;
+    _ese_point_write(point, x, y);
+}
+
 // Watcher system
 bool ese_point_add_watcher(EsePoint *point, EsePointWatcherCallback callback, void *userdata) {
     log_assert("POINT", point, "ese_point_add_watcher called with NULL point");
@@ -398,7 +467,7 @@ cJSON *ese_point_serialize(const EsePoint *point) {
     }
 
     // Add x coordinate
-    cJSON *x = cJSON_CreateNumber((double)point->x);
+    cJSON *x = cJSON_CreateNumber((double)ese_point_get_x(point));
     if (!x || !cJSON_AddItemToObject(json, "x", x)) {
         log_error("POINT", "Failed to add x field to point serialization");
         cJSON_Delete(json);
@@ -406,7 +475,7 @@ cJSON *ese_point_serialize(const EsePoint *point) {
     }
 
     // Add y coordinate
-    cJSON *y = cJSON_CreateNumber((double)point->y);
+    cJSON *y = cJSON_CreateNumber((double)ese_point_get_y(point));
     if (!y || !cJSON_AddItemToObject(json, "y", y)) {
         log_error("POINT", "Failed to add y field to point serialization");
         cJSON_Delete(json);
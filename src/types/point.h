@@ -37,6 +37,17 @@ typedef struct EsePoint EsePoint;
  */
 typedef void (*EsePointWatcherCallback)(EsePoint *point, void *userdata);
 
+/**
+ * @brief Storage a point can read and write through instead of its own fields.
+ *
+ * @details Lets a point act as a view of coordinates owned elsewhere, such as
+ * an entity position kept in the engine's transform pool.
+ */
+typedef struct EsePointView {
+    void (*get)(const void *data, float *x, float *y); /** Reads the coordinates */
+    void (*set)(void *data, float x, float y);         /** Writes the coordinates */
+} EsePointView;
+
 // ========================================
 // FORWARD DECLARATIONS
 // ========================================
@@ -196,6 +207,19 @@ void _ese_point_make_point_notify_watchers(EsePoint *point);
  */
 bool ese_point_add_watcher(EsePoint *point, EsePointWatcherCallback callback, void *userdata);
 
+/**
+ * @brief Makes the point a view of coordinates stored elsewhere.
+ *
+ * @details Once set, the point's getters and setters go through @p view and
+ * its own fields are unused. Watchers are still notified on writes. Copies of
+ * a view are plain points holding the current coordinates.
+ *
+ * @param point Pointer to the EsePoint object
+ * @param view Accessors to use, or NULL to store coordinates in the point again
+ * @param data Passed to the accessors; must outlive the view
+ */
+void ese_point_set_view(EsePoint *point, const EsePointView *view, void *data);
+
 /**
  * @brief Removes a previously registered watcher callback.
  *
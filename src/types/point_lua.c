@@ -32,7 +32,6 @@ static int _ese_point_lua_to_json(lua_State *L);
 
 // Forward declarations for private functions
 extern EsePoint *_ese_point_make(void);
-extern void _ese_point_make_point_notify_watchers(EsePoint *point);
 
 // ========================================
 // PRIVATE FUNCTIONS
@@ -132,7 +131,6 @@ static int _ese_point_lua_newindex(lua_State *L) {
             return luaL_error(L, "point.x must be a number");
         }
         ese_point_set_x(point, (float)lua_tonumber(L, 3));
-        _ese_point_make_point_notify_watchers(point);
         profile_stop(PROFILE_LUA_POINT_NEWINDEX, "point_lua_newindex (setter)");
         return 0;
     } else if (strcmp(key, "y") == 0) {
@@ -141,7 +139,6 @@ static int _ese_point_lua_newindex(lua_State *L) {
             return luaL_error(L, "point.y must be a number");
         }
         ese_point_set_y(point, (float)lua_tonumber(L, 3));
-        _ese_point_make_point_notify_watchers(point);
         profile_stop(PROFILE_LUA_POINT_NEWINDEX, "point_lua_newindex (setter)");
         return 0;
     }
@@ -0,0 +1,210 @@
+#include "types/prefab.h"
+
+#include "core/engine.h"
+#include "core/engine_private.h"
+#include "core/memory_manager.h"
+#include "core/system_manager.h"
+#include "entity/components/entity_component.h"
+#include "entity/components/entity_component_lua.h"
+#include "entity/components/entity_component_private.h"
+#include "entity/components/entity_component_sprite.h"
+#include "entity/entity.h"
+#include "entity/entity_private.h"
+#include "scripting/lua_engine.h"
+#include "types/prefab_lua.h"
+#include "utility/log.h"
+
+#include <string.h>
+
+// ========================================
+// INTERNAL TYPES
+// ========================================
+
+struct EsePrefab {
+    EseLuaEngine *lua;
+
+    bool active;
+    bool visible;
+    uint64_t draw_order;
+    EseEntityUpdateMode update_mode;
+    uint32_t update_interval;
+    float update_distance;
+    float x;
+    float y;
+
+    EseTagId *tags;
+    size_t tag_count;
+
+    // Copies of the source components, attached to no entity and known to no
+    // system; every spawned entity gets a copy of each
+    EseEntityComponent **components;
+    size_t component_count;
+};
+
+// ========================================
+// STATIC HELPERS
+// ========================================
+
+/**
+ * @brief Checks what a template component refers to by name.
+ *
+ * @return false if the component can never work (its script is not loaded).
+ */
+static bool _ese_prefab_resolve_component(EseEngine *engine, EseEntityComponent *comp) {
+    if (comp->type == ENTITY_COMPONENT_LUA) {
+        EseEntityComponentLua *lua_comp = (EseEntityComponentLua *)comp->data;
+        if (lua_comp->script && !lua_engine_has_script(lua_comp->engine, lua_comp->script)) {
+            log_error("PREFAB", "Script '%s' is not loaded", lua_comp->script);
+            return false;
+        }
+    } else if (comp->type == ENTITY_COMPONENT_SPRITE) {
+        EseEntityComponentSprite *sprite = (EseEntityComponentSprite *)comp->data;
+        if (sprite->sprite_name && !engine_get_sprite(engine, sprite->sprite_name)) {
+            log_warn("PREFAB", "Sprite '%s' is not loaded yet", sprite->sprite_name);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Builds one entity from the prefab without notifying systems.
+ *
+ * @param batch Column-major array receiving the entity's components, one
+ *              column of @p count entries per template component.
+ */
+static EseEntity *_ese_prefab_build(EsePrefab *prefab, size_t index, size_t count,
+                                    EseEntityComponent **batch) {
+    EseEntity *entity = entity_create(prefab->lua);
+    entity->active = prefab->active;
+    entity->visible = prefab->visible;
+    entity->draw_order = prefab->draw_order;
+    entity->update_mode = prefab->update_mode;
+    entity->update_interval = prefab->update_interval;
+    entity->update_distance = prefab->update_distance;
+
+    // Exactly sized arrays; _entity_component_attach never has to grow them
+    if (prefab->component_count > 0) {
+        entity->components = memory_manager.malloc(
+            sizeof(EseEntityComponent *) * prefab->component_count, MMTAG_ENTITY);
+        entity->component_capacity = prefab->component_count;
+    }
+    for (size_t k = 0; k < prefab->component_count; k++) {
+        EseEntityComponent *comp = entity_component_copy(prefab->components[k]);
+        comp->active = prefab->components[k]->active;
+        _entity_component_attach(entity, comp);
+        batch[k * count + index] = comp;
+    }
+
+    // Tags are already interned; the entity joins the engine tag sets when added
+    if (prefab->tag_count > 0) {
+        entity->tags = memory_manager.malloc(sizeof(EseEntityTag) * prefab->tag_count, MMTAG_ENTITY);
+        entity->tag_capacity = prefab->tag_count;
+        entity->tag_count = prefab->tag_count;
+        for (size_t t = 0; t < prefab->tag_count; t++) {
+            entity->tags[t].id = prefab->tags[t];
+            entity->tags[t].set_index = ENTITY_TAG_NO_SET;
+        }
+    }
+
+    return entity;
+}
+
+// ========================================
+// PUBLIC API
+// ========================================
+
+EsePrefab *ese_prefab_create_from_entity(EseEngine *engine, EseEntity *entity) {
+    log_assert("PREFAB", engine, "ese_prefab_create_from_entity called with NULL engine");
+    log_assert("PREFAB", entity, "ese_prefab_create_from_entity called with NULL entity");
+
+    EsePrefab *prefab = memory_manager.calloc(1, sizeof(EsePrefab), MMTAG_ENTITY);
+    prefab->lua = entity->lua;
+    prefab->active = entity->active;
+    prefab->visible = entity->visible;
+    prefab->draw_order = entity->draw_order;
+    prefab->update_mode = entity->update_mode;
+    prefab->update_interval = entity->update_interval;
+    prefab->update_distance = entity->update_distance;
+    prefab->x = _entity_get_x(entity);
+    prefab->y = _entity_get_y(entity);
+
+    if (entity->tag_count > 0) {
+        prefab->tags = memory_manager.malloc(sizeof(EseTagId) * entity->tag_count, MMTAG_ENTITY);
+        for (size_t i = 0; i < entity->tag_count; i++) {
+            prefab->tags[i] = entity->tags[i].id;
+        }
+        prefab->tag_count = entity->tag_count;
+    }
+
+    if (entity->component_count > 0) {
+        prefab->components = memory_manager.malloc(
+            sizeof(EseEntityComponent *) * entity->component_count, MMTAG_ENTITY);
+        for (size_t i = 0; i < entity->component_count; i++) {
+            EseEntityComponent *comp = entity_component_copy(entity->components[i]);
+            comp->active = entity->components[i]->active;
+            prefab->components[prefab->component_count++] = comp;
+            if (!_ese_prefab_resolve_component(engine, comp)) {
+                ese_prefab_destroy(prefab);
+                return NULL;
+            }
+        }
+    }
+
+    return prefab;
+}
+
+void ese_prefab_destroy(EsePrefab *prefab) {
+    if (!prefab) {
+        return;
+    }
+
+    for (size_t i = 0; i < prefab->component_count; i++) {
+        entity_component_destroy(prefab->components[i]);
+    }
+    memory_manager.free(prefab->components);
+    memory_manager.free(prefab->tags);
+    memory_manager.free(prefab);
+}
+
+size_t ese_prefab_component_count(const EsePrefab *prefab) {
+    log_assert("PREFAB", prefab, "ese_prefab_component_count called with NULL prefab");
+    return prefab->component_count;
+}
+
+size_t ese_prefab_spawn(EsePrefab *prefab, EseEngine *engine, size_t count, const float *xs,
+                        const float *ys, EseEntity **out_entities) {
+    log_assert("PREFAB", prefab, "ese_prefab_spawn called with NULL prefab");
+    log_assert("PREFAB", engine, "ese_prefab_spawn called with NULL engine");
+
+    if (count == 0) {
+        return 0;
+    }
+
+    EseEntityComponent **batch = NULL;
+    if (prefab->component_count > 0) {
+        batch = memory_manager.malloc(
+            sizeof(EseEntityComponent *) * prefab->component_count * count, MMTAG_ENTITY);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        EseEntity *entity = _ese_prefab_build(prefab, i, count, batch);
+        engine_add_entity(engine, entity);
+        entity_set_position(entity, xs ? xs[i] : prefab->x, ys ? ys[i] : prefab->y);
+        if (out_entities) {
+            out_entities[i] = entity;
+        }
+    }
+
+    // One pass per component type instead of one lookup per component
+    for (size_t k = 0; k < prefab->component_count; k++) {
+        engine_notify_comp_add_batch(engine, &batch[k * count], count);
+    }
+    memory_manager.free(batch);
+
+    return count;
+}
+
+void ese_prefab_lua_init(EseLuaEngine *engine) {
+    log_assert("PREFAB", engine, "ese_prefab_lua_init called with NULL engine");
+    _ese_prefab_lua_init(engine);
+}
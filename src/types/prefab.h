@@ -0,0 +1,75 @@
+/**
+ * @file prefab.h
+ * @brief Prefab type for spawning many copies of one entity.
+ *
+ * @details A prefab snapshots an entity's flags, tags and components once.
+ *          Spawning builds entities from that template in a batch: component
+ *          copies come from ready-made template components, each system is
+ *          notified once per component type for the whole batch, and Lua
+ *          script instances are still created lazily by the Lua system on the
+ *          first update. Lua bindings expose a Prefab global with a create
+ *          class method and a spawn instance method.
+ */
+#ifndef ESE_PREFAB_H
+#define ESE_PREFAB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PREFAB_PROXY_META "PrefabProxyMeta"
+
+// Forward declarations
+typedef struct EseEngine EseEngine;
+typedef struct EseEntity EseEntity;
+typedef struct EseLuaEngine EseLuaEngine;
+typedef struct EsePrefab EsePrefab;
+
+/**
+ * @brief Creates a prefab from an entity.
+ *
+ * @details Copies the entity's active/visible flags, draw order, tags,
+ *          position and components. Scripts of Lua components must already be
+ *          loaded; sprite names that do not resolve yet only log a warning,
+ *          since atlases may be loaded after the prefab is made.
+ *
+ * @param engine Engine the prefab will spawn into (used to resolve sprites).
+ * @param entity Entity to copy; it is not modified.
+ * @return New prefab, or NULL if a script is not loaded.
+ */
+EsePrefab *ese_prefab_create_from_entity(EseEngine *engine, EseEntity *entity);
+
+/**
+ * @brief Frees a prefab and its template components. Spawned entities are not touched.
+ *
+ * @param prefab Prefab to free (may be NULL).
+ */
+void ese_prefab_destroy(EsePrefab *prefab);
+
+/**
+ * @brief Number of components each spawned entity gets.
+ */
+size_t ese_prefab_component_count(const EsePrefab *prefab);
+
+/**
+ * @brief Spawns entities from the prefab and adds them to the engine.
+ *
+ * @details All entities are built and added first; then every system
+ *          tracking a template component type is notified once with the
+ *          whole batch for that type.
+ *
+ * @param prefab Prefab to spawn.
+ * @param engine Engine to add the entities to.
+ * @param count Number of entities to spawn.
+ * @param xs X positions, one per entity, or NULL for the prefab's position.
+ * @param ys Y positions, one per entity, or NULL for the prefab's position.
+ * @param out_entities Receives the spawned entities (may be NULL).
+ * @return Number of entities spawned.
+ */
+size_t ese_prefab_spawn(EsePrefab *prefab, EseEngine *engine, size_t count, const float *xs,
+                        const float *ys, EseEntity **out_entities);
+
+// Lua integration entry point
+void ese_prefab_lua_init(EseLuaEngine *engine);
+
+#endif // ESE_PREFAB_H
@@ -0,0 +1,252 @@
+#include "types/prefab_lua.h"
+
+#include "core/engine.h"
+#include "core/engine_lua.h"
+#include "core/memory_manager.h"
+#include "entity/entity.h"
+#include "entity/entity_lua.h"
+#include "scripting/lua_engine.h"
+#include "types/point.h"
+#include "types/prefab.h"
+#include "utility/log.h"
+#include "vendor/lua/src/lauxlib.h"
+#include "vendor/lua/src/lua.h"
+#include "vendor/lua/src/lualib.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+// ========================================
+// FORWARD DECLARATIONS
+// ========================================
+
+static EsePrefab *ese_prefab_lua_get(lua_State *L, int idx);
+static void ese_prefab_lua_push(lua_State *L, EsePrefab *prefab);
+
+// Metamethods
+static int _ese_prefab_lua_gc(lua_State *L);
+static int _ese_prefab_lua_index(lua_State *L);
+static int _ese_prefab_lua_newindex(lua_State *L);
+static int _ese_prefab_lua_tostring(lua_State *L);
+
+// Class methods
+static int _ese_prefab_lua_create(lua_State *L);
+
+// Instance methods
+static int _ese_prefab_lua_spawn(lua_State *L);
+
+// ========================================
+// HELPERS
+// ========================================
+
+static EsePrefab *ese_prefab_lua_get(lua_State *L, int idx) {
+    EsePrefab **ud = (EsePrefab **)luaL_testudata(L, idx, PREFAB_PROXY_META);
+    if (!ud) {
+        return NULL;
+    }
+    return *ud;
+}
+
+static void ese_prefab_lua_push(lua_State *L, EsePrefab *prefab) {
+    log_assert("PREFAB", prefab, "ese_prefab_lua_push called with NULL prefab");
+
+    EsePrefab **ud = (EsePrefab **)lua_newuserdata(L, sizeof(EsePrefab *));
+    *ud = prefab;
+
+    luaL_getmetatable(L, PREFAB_PROXY_META);
+    lua_setmetatable(L, -2);
+}
+
+/**
+ * @brief Reads entry @p i of a positions array: a Point or a {x=, y=} table.
+ */
+static bool _ese_prefab_lua_position(lua_State *L, int table, size_t i, float *x, float *y) {
+    lua_rawgeti(L, table, (int)i + 1);
+
+    EsePoint *point = ese_point_lua_get(L, -1);
+    if (point) {
+        *x = ese_point_get_x(point);
+        *y = ese_point_get_y(point);
+        lua_pop(L, 1);
+        return true;
+    }
+
+    if (!lua_istable(L, -1)) {
+        lua_pop(L, 1);
+        return false;
+    }
+    lua_getfield(L, -1, "x");
+    lua_getfield(L, -2, "y");
+    bool ok = lua_isnumber(L, -2) && lua_isnumber(L, -1);
+    if (ok) {
+        *x = (float)lua_tonumber(L, -2);
+        *y = (float)lua_tonumber(L, -1);
+    }
+    lua_pop(L, 3);
+    return ok;
+}
+
+// ========================================
+// METAMETHODS
+// ========================================
+
+static int _ese_prefab_lua_gc(lua_State *L) {
+    EsePrefab **ud = (EsePrefab **)luaL_testudata(L, 1, PREFAB_PROXY_META);
+    if (!ud) {
+        return 0;
+    }
+
+    if (*ud) {
+        ese_prefab_destroy(*ud);
+        *ud = NULL;
+    }
+
+    return 0;
+}
+
+static int _ese_prefab_lua_index(lua_State *L) {
+    EsePrefab *prefab = ese_prefab_lua_get(L, 1);
+    const char *key = lua_tostring(L, 2);
+
+    if (!prefab || !key) {
+        return 0;
+    }
+
+    if (strcmp(key, "spawn") == 0) {
+        lua_pushcfunction(L, _ese_prefab_lua_spawn);
+        return 1;
+    } else if (strcmp(key, "component_count") == 0) {
+        lua_pushinteger(L, (lua_Integer)ese_prefab_component_count(prefab));
+        return 1;
+    }
+
+    return 0;
+}
+
+static int _ese_prefab_lua_newindex(lua_State *L) {
+    (void)L;
+    return luaL_error(L, "Prefab instances are read-only");
+}
+
+static int _ese_prefab_lua_tostring(lua_State *L) {
+    EsePrefab *prefab = ese_prefab_lua_get(L, 1);
+    if (!prefab) {
+        lua_pushstring(L, "Prefab(invalid)");
+        return 1;
+    }
+
+    char buf[64];
+    snprintf(buf, sizeof(buf), "Prefab(component_count=%zu)", ese_prefab_component_count(prefab));
+    lua_pushstring(L, buf);
+    return 1;
+}
+
+// ========================================
+// CLASS METHODS
+// ========================================
+
+static int _ese_prefab_lua_create(lua_State *L) {
+    if (lua_gettop(L) != 1) {
+        return luaL_error(L, "Prefab.create(entity:Entity) takes 1 argument");
+    }
+
+    EseEntity *entity = entity_lua_get(L, 1);
+    if (!entity) {
+        return luaL_error(L, "Prefab.create argument must be an Entity");
+    }
+
+    EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(L, ENGINE_KEY);
+    if (!engine) {
+        return luaL_error(L, "Prefab.create: no engine available");
+    }
+
+    EsePrefab *prefab = ese_prefab_create_from_entity(engine, entity);
+    if (!prefab) {
+        return luaL_error(L, "Prefab.create: entity has a script that is not loaded");
+    }
+
+    ese_prefab_lua_push(L, prefab);
+    return 1;
+}
+
+// ========================================
+// INSTANCE METHODS
+// ========================================
+
+static int _ese_prefab_lua_spawn(lua_State *L) {
+    int argc = lua_gettop(L);
+    if (argc < 2 || argc > 3) {
+        return luaL_error(L, "prefab:spawn(count:number[, positions:table]) takes 1 or 2 arguments");
+    }
+
+    EsePrefab *prefab = ese_prefab_lua_get(L, 1);
+    if (!prefab) {
+        return luaL_error(L, "prefab:spawn() called on invalid Prefab");
+    }
+    if (!lua_isnumber(L, 2) || lua_tonumber(L, 2) < 0) {
+        return luaL_error(L, "prefab:spawn() count must be a non-negative number");
+    }
+    size_t count = (size_t)lua_tonumber(L, 2);
+
+    bool has_positions = argc == 3 && !lua_isnil(L, 3);
+    if (has_positions && !lua_istable(L, 3)) {
+        return luaL_error(L, "prefab:spawn() positions must be a table");
+    }
+    if (has_positions && lua_objlen(L, 3) < count) {
+        return luaL_error(L, "prefab:spawn() needs %d positions", (int)count);
+    }
+
+    EseEngine *engine = (EseEngine *)lua_engine_get_registry_key(L, ENGINE_KEY);
+    if (!engine) {
+        return luaL_error(L, "prefab:spawn(): no engine available");
+    }
+
+    // Read every position before anything is created, so a bad entry spawns nothing
+    float *xs = NULL;
+    float *ys = NULL;
+    if (has_positions && count > 0) {
+        xs = memory_manager.malloc(sizeof(float) * count * 2, MMTAG_ENTITY);
+        ys = xs + count;
+        for (size_t i = 0; i < count; i++) {
+            if (!_ese_prefab_lua_position(L, 3, i, &xs[i], &ys[i])) {
+                memory_manager.free(xs);
+                return luaL_error(L, "prefab:spawn() position %d must be a Point or {x, y}",
+                                  (int)i + 1);
+            }
+        }
+    }
+
+    EseEntity **entities = NULL;
+    if (count > 0) {
+        entities = memory_manager.malloc(sizeof(EseEntity *) * count, MMTAG_ENTITY);
+    }
+    ese_prefab_spawn(prefab, engine, count, xs, ys, entities);
+    memory_manager.free(xs);
+
+    lua_createtable(L, (int)count, 0);
+    for (size_t i = 0; i < count; i++) {
+        entity_lua_push(entities[i]);
+        lua_rawseti(L, -2, (int)i + 1);
+    }
+    memory_manager.free(entities);
+    return 1;
+}
+
+// ========================================
+// PUBLIC INIT
+// ========================================
+
+void _ese_prefab_lua_init(EseLuaEngine *engine) {
+    log_assert("PREFAB", engine, "_ese_prefab_lua_init called with NULL engine");
+
+    // Create metatable for Prefab userdata
+    lua_engine_new_object_meta(engine, PREFAB_PROXY_META, _ese_prefab_lua_index,
+                               _ese_prefab_lua_newindex, _ese_prefab_lua_gc,
+                               _ese_prefab_lua_tostring);
+
+    // Create global Prefab table with class methods
+    const char *keys[] = {"create"};
+    lua_CFunction functions[] = {_ese_prefab_lua_create};
+    lua_engine_new_object(engine, "Prefab", 1, keys, functions);
+}
@@ -0,0 +1,9 @@
+#ifndef ESE_PREFAB_LUA_H
+#define ESE_PREFAB_LUA_H
+
+typedef struct EseLuaEngine EseLuaEngine;
+
+// Internal Lua initialization for Prefab; called by ese_prefab_lua_init.
+void _ese_prefab_lua_init(EseLuaEngine *engine);
+
+#endif // ESE_PREFAB_LUA_H
@@ -543,6 +543,38 @@ bool ese_rect_intersects(const EseRect *rect1, const EseRect *rect2) {
     return _ese_obb_overlap(&a, &b);
 }
 
+bool ese_rect_intersects_offset(const EseRect *rect1, float dx1, float dy1, const EseRect *rect2,
+                                float dx2, float dy2) {
+    log_assert("RECT", rect1, "ese_rect_intersects_offset called with NULL first rect");
+    log_assert("RECT", rect2, "ese_rect_intersects_offset called with NULL second rect");
+
+    /* only geometry is copied, the watcher and Lua fields are never touched */
+    EseRect a = {.x = rect1->x + dx1,
+                 .y = rect1->y + dy1,
+                 .width = rect1->width,
+                 .height = rect1->height,
+                 .rotation = rect1->rotation};
+    EseRect b = {.x = rect2->x + dx2,
+                 .y = rect2->y + dy2,
+                 .width = rect2->width,
+                 .height = rect2->height,
+                 .rotation = rect2->rotation};
+    return ese_rect_intersects(&a, &b);
+}
+
+bool ese_rect_intersects_area(const EseRect *rect, float dx, float dy, float x, float y,
+                              float width, float height) {
+    log_assert("RECT", rect, "ese_rect_intersects_area called with NULL rect");
+
+    EseRect a = {.x = rect->x + dx,
+                 .y = rect->y + dy,
+                 .width = rect->width,
+                 .height = rect->height,
+                 .rotation = rect->rotation};
+    EseRect b = {.x = x, .y = y, .width = width, .height = height, .rotation = 0.0f};
+    return ese_rect_intersects(&a, &b);
+}
+
 float ese_rect_area(const EseRect *rect) {
     log_assert("RECT", rect, "ese_rect_area called with NULL rect");
     return ese_rect_get_width(rect) * ese_rect_get_height(rect);
@@ -344,6 +344,44 @@ bool ese_rect_contains_point(const EseRect *rect, float x, float y);
  */
 bool ese_rect_intersects(const EseRect *rect1, const EseRect *rect2);
 
+/**
+ * @brief Checks if two translated rectangles intersect.
+ *
+ * @details Same test as ese_rect_intersects() with each rectangle moved by its
+ *          own offset first. Reads the rectangles only and never allocates, so
+ *          it is safe to call from worker threads while the rects are not
+ *          being modified.
+ *
+ * @param rect1 Pointer to the first EseRect object
+ * @param dx1 X offset applied to the first rectangle
+ * @param dy1 Y offset applied to the first rectangle
+ * @param rect2 Pointer to the second EseRect object
+ * @param dx2 X offset applied to the second rectangle
+ * @param dy2 Y offset applied to the second rectangle
+ * @return true if the translated rectangles intersect, false otherwise
+ */
+bool ese_rect_intersects_offset(const EseRect *rect1, float dx1, float dy1, const EseRect *rect2,
+                                float dx2, float dy2);
+
+/**
+ * @brief Checks if a translated rectangle intersects an axis-aligned area.
+ *
+ * @details Lets callers test against areas they never materialise as EseRect
+ *          objects (map cells, query regions) without allocating. Edges that
+ *          only touch count as intersecting, as in ese_rect_intersects().
+ *
+ * @param rect Pointer to the EseRect object
+ * @param dx X offset applied to the rectangle
+ * @param dy Y offset applied to the rectangle
+ * @param x Left edge of the area
+ * @param y Top edge of the area
+ * @param width Width of the area
+ * @param height Height of the area
+ * @return true if they intersect, false otherwise
+ */
+bool ese_rect_intersects_area(const EseRect *rect, float dx, float dy, float x, float y,
+                              float width, float height);
+
 /**
  * @brief Gets the area of the rectangle.
  *
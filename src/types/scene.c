@@ -8,7 +8,7 @@
 #include "scripting/lua_engine.h"
 #include "types/point.h"
 #include "types/scene_lua.h"
-#include "utility/double_linked_list.h"
+#include "utility/slot_map.h"
 #include "utility/log.h"
 #include "vendor/json/cJSON.h"
 
@@ -134,7 +134,7 @@ static void _ese_scene_clone_tags_from_entity(EseSceneEntityDesc *desc, const Es
     desc->tag_count = entity->tag_count;
 
     for (size_t i = 0; i < entity->tag_count; i++) {
-        desc->tags[i] = memory_manager.strdup(entity->tags[i], MMTAG_ENTITY);
+        desc->tags[i] = memory_manager.strdup(entity_tag_name(entity->tags[i].id), MMTAG_ENTITY);
         if (!desc->tags[i]) {
             log_error("SCENE", "Failed to duplicate tag for Scene entity descriptor");
         }
@@ -205,14 +205,10 @@ EseScene *ese_scene_create_from_engine(EseEngine *engine, bool include_persisten
         return NULL;
     }
 
-    EseDListIter *iter = dlist_iter_create(engine->entities);
-    void *value = NULL;
-    while (dlist_iter_next(iter, &value)) {
-        EseEntity *entity = (EseEntity *)value;
-        if (!entity) {
-            continue;
-        }
-
+    EseEntity **entities = (EseEntity **)slot_map_values(engine->entities);
+    size_t count = slot_map_size(engine->entities);
+    for (size_t i = 0; i < count; i++) {
+        EseEntity *entity = entities[i];
         if (entity->destroyed) {
             continue;
         }
@@ -223,7 +219,6 @@ EseScene *ese_scene_create_from_engine(EseEngine *engine, bool include_persisten
 
         if (!_ese_scene_ensure_entity_capacity(scene, scene->entity_count + 1)) {
             // Allocation failure: clean up and abort
-            dlist_iter_free(iter);
             ese_scene_destroy(scene);
             return NULL;
         }
@@ -237,8 +232,8 @@ EseScene *ese_scene_create_from_engine(EseEngine *engine, bool include_persisten
         desc->persistent = entity->persistent;
         desc->draw_order = entity->draw_order;
 
-        desc->x = ese_point_get_x(entity->position);
-        desc->y = ese_point_get_y(entity->position);
+        desc->x = _entity_get_x(entity);
+        desc->y = _entity_get_y(entity);
 
         _ese_scene_clone_tags_from_entity(desc, entity);
 
@@ -246,8 +241,6 @@ EseScene *ese_scene_create_from_engine(EseEngine *engine, bool include_persisten
         // per-component JSON helpers are available.
     }
 
-    dlist_iter_free(iter);
-
     return scene;
 }
 
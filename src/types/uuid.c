@@ -270,8 +270,15 @@ void ese_uuid_generate_new(EseUUID *uuid) {
 }
 
 uint64_t ese_uuid_hash(const EseUUID *uuid) {
+    log_assert("UUID", uuid, "ese_uuid_hash called with NULL uuid");
+    return ese_uuid_hash_string(uuid->value);
+}
+
+uint64_t ese_uuid_hash_string(const char *value) {
+    log_assert("UUID", value, "ese_uuid_hash_string called with NULL value");
+
     uint64_t hash = 5381;
-    const char *str = uuid->value;
+    const char *str = value;
     int c;
 
     while ((c = *str++)) {
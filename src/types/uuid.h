@@ -238,6 +238,17 @@ void ese_uuid_generate_new(EseUUID *uuid);
  */
 uint64_t ese_uuid_hash(const EseUUID *uuid);
 
+/**
+ * @brief Computes the ese_uuid_hash value of a UUID string.
+ *
+ * @details Lets callers holding only the string form (e.g. from Lua) look up
+ *          a table keyed by ese_uuid_hash without creating an EseUUID.
+ *
+ * @param value UUID string
+ * @return Hash value as uint64_t, equal to ese_uuid_hash of a UUID with @p value
+ */
+uint64_t ese_uuid_hash_string(const char *value);
+
 /**
  * @brief Serializes an EseUUID to a cJSON object.
  *
@@ -0,0 +1,341 @@
+/**
+ * COLLISION SHAPES
+ * ================
+ *
+ * Plain-float world-space shapes used by the collider narrow phase. A collider
+ * rebuilds its shapes only when its rects, offset or entity position change;
+ * the per-pair tests then never touch an EseRect.
+ *
+ * The batch kernel tests one shape against a whole set. AABBs live in
+ * separate arrays padded with empty boxes so a block of COLLISION_SHAPE_LANES
+ * lanes is compared at once with SSE2 or NEON, falling back to scalar code on
+ * other targets. Lanes whose boxes overlap are then resolved in index order:
+ * two unrotated shapes hit on the box test alone, anything rotated goes
+ * through the same separating axis test ese_rect_intersects uses, so results
+ * match the EseRect path exactly.
+ */
+
+#include "utility/collision_shape.h"
+#include "core/memory_manager.h"
+#include "types/rect.h"
+#include "utility/log.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLLISION_SHAPE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define COLLISION_SHAPE_NEON 1
+#endif
+
+#define COLLISION_SHAPE_ROTATION_EPSILON 1e-6f
+#define COLLISION_SHAPE_SAT_EPSILON 1e-6f
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+/**
+ * @brief Marks lanes [from, to) as empty boxes that never overlap anything.
+ */
+static void _collision_shape_set_pad(EseCollisionShapeSet *set, size_t from, size_t to) {
+    for (size_t i = from; i < to; i++) {
+        set->min_x[i] = INFINITY;
+        set->min_y[i] = INFINITY;
+        set->max_x[i] = -INFINITY;
+        set->max_y[i] = -INFINITY;
+    }
+}
+
+static void _collision_shape_set_grow(EseCollisionShapeSet *set) {
+    size_t capacity = set->capacity ? set->capacity * 2 : COLLISION_SHAPE_LANES;
+
+    float *boxes = memory_manager.malloc(sizeof(float) * capacity * 4, MMTAG_ENTITY);
+    EseCollisionShape *shapes =
+        memory_manager.malloc(sizeof(EseCollisionShape) * capacity, MMTAG_ENTITY);
+
+    if (set->count > 0) {
+        memcpy(boxes, set->min_x, sizeof(float) * set->count);
+        memcpy(boxes + capacity, set->min_y, sizeof(float) * set->count);
+        memcpy(boxes + capacity * 2, set->max_x, sizeof(float) * set->count);
+        memcpy(boxes + capacity * 3, set->max_y, sizeof(float) * set->count);
+        memcpy(shapes, set->shapes, sizeof(EseCollisionShape) * set->count);
+    }
+    if (set->min_x) {
+        memory_manager.free(set->min_x);
+        memory_manager.free(set->shapes);
+    }
+
+    // All four box arrays share one allocation owned through min_x
+    set->min_x = boxes;
+    set->min_y = boxes + capacity;
+    set->max_x = boxes + capacity * 2;
+    set->max_y = boxes + capacity * 3;
+    set->shapes = shapes;
+    set->capacity = capacity;
+    _collision_shape_set_pad(set, set->count, capacity);
+}
+
+/**
+ * @brief Separating axis test; mirrors the oriented path of ese_rect_intersects.
+ */
+static bool _collision_shape_sat(const EseCollisionShape *a, const EseCollisionShape *b) {
+    const float a_axis[2][2] = {{a->ux, a->uy}, {-a->uy, a->ux}};
+    const float b_axis[2][2] = {{b->ux, b->uy}, {-b->uy, b->ux}};
+    const float a_ext[2] = {a->hw, a->hh};
+    const float b_ext[2] = {b->hw, b->hh};
+    const float dx = b->cx - a->cx;
+    const float dy = b->cy - a->cy;
+
+    for (int i = 0; i < 2; ++i) {
+        const float *axis = a_axis[i];
+        float ra = a_ext[i];
+        float rb = b_ext[0] * fabsf(b_axis[0][0] * axis[0] + b_axis[0][1] * axis[1]) +
+                   b_ext[1] * fabsf(b_axis[1][0] * axis[0] + b_axis[1][1] * axis[1]);
+        float dist = fabsf(dx * axis[0] + dy * axis[1]);
+        if (dist > ra + rb + COLLISION_SHAPE_SAT_EPSILON) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        const float *axis = b_axis[i];
+        float ra = a_ext[0] * fabsf(a_axis[0][0] * axis[0] + a_axis[0][1] * axis[1]) +
+                   a_ext[1] * fabsf(a_axis[1][0] * axis[0] + a_axis[1][1] * axis[1]);
+        float rb = b_ext[i];
+        float dist = fabsf(dx * axis[0] + dy * axis[1]);
+        if (dist > ra + rb + COLLISION_SHAPE_SAT_EPSILON) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Resolves the lanes of one block whose boxes overlap, in index order.
+ */
+static bool _collision_shape_resolve_lanes(const EseCollisionShapeSet *set,
+                                           const EseCollisionShape *shape, size_t base,
+                                           unsigned mask, size_t *out_index) {
+    for (unsigned lane = 0; lane < COLLISION_SHAPE_LANES; lane++) {
+        if (!(mask & (1u << lane))) {
+            continue;
+        }
+        const EseCollisionShape *other = &set->shapes[base + lane];
+        if ((!shape->rotated && !other->rotated) || _collision_shape_sat(shape, other)) {
+            if (out_index) {
+                *out_index = base + lane;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+void collision_shape_from_rect(EseCollisionShape *out, const EseRect *rect, float dx, float dy) {
+    log_assert("COLLISION_SHAPE", out, "collision_shape_from_rect called with NULL out");
+    log_assert("COLLISION_SHAPE", rect, "collision_shape_from_rect called with NULL rect");
+
+    float x = ese_rect_get_x(rect) + dx;
+    float y = ese_rect_get_y(rect) + dy;
+    float w = ese_rect_get_width(rect);
+    float h = ese_rect_get_height(rect);
+    float rotation = ese_rect_get_rotation(rect);
+
+    out->cx = x + w * 0.5f;
+    out->cy = y + h * 0.5f;
+    out->ux = cosf(rotation);
+    out->uy = sinf(rotation);
+    out->hw = w * 0.5f;
+    out->hh = h * 0.5f;
+    out->rotated = fabsf(rotation) >= COLLISION_SHAPE_ROTATION_EPSILON;
+
+    if (!out->rotated) {
+        out->min_x = x;
+        out->min_y = y;
+        out->max_x = x + w;
+        out->max_y = y + h;
+        return;
+    }
+
+    // Enclosing box of the oriented box, grown so rounding and the SAT epsilon
+    // can never reject a pair the oriented test would accept
+    float ex = fabsf(out->ux) * out->hw + fabsf(out->uy) * out->hh;
+    float ey = fabsf(out->uy) * out->hw + fabsf(out->ux) * out->hh;
+    float margin = 1e-3f + 1e-5f * (fabsf(out->cx) + fabsf(out->cy) + out->hw + out->hh);
+    out->min_x = out->cx - ex - margin;
+    out->min_y = out->cy - ey - margin;
+    out->max_x = out->cx + ex + margin;
+    out->max_y = out->cy + ey + margin;
+}
+
+bool collision_shape_overlaps(const EseCollisionShape *a, const EseCollisionShape *b) {
+    log_assert("COLLISION_SHAPE", a, "collision_shape_overlaps called with NULL first shape");
+    log_assert("COLLISION_SHAPE", b, "collision_shape_overlaps called with NULL second shape");
+
+    if (a->min_x > b->max_x || b->min_x > a->max_x || a->min_y > b->max_y ||
+        b->min_y > a->max_y) {
+        return false;
+    }
+    if (!a->rotated && !b->rotated) {
+        return true;
+    }
+    return _collision_shape_sat(a, b);
+}
+
+bool collision_shape_overlaps_circle(const EseCollisionShape *shape, float x, float y,
+                                     float radius) {
+    log_assert("COLLISION_SHAPE", shape, "collision_shape_overlaps_circle called with NULL shape");
+
+    if (x + radius < shape->min_x || x - radius > shape->max_x || y + radius < shape->min_y ||
+        y - radius > shape->max_y) {
+        return false;
+    }
+
+    // Distance from the centre to the box, measured in the box frame
+    float rx = x - shape->cx;
+    float ry = y - shape->cy;
+    float qx = fmaxf(fabsf(rx * shape->ux + ry * shape->uy) - shape->hw, 0.0f);
+    float qy = fmaxf(fabsf(ry * shape->ux - rx * shape->uy) - shape->hh, 0.0f);
+    return qx * qx + qy * qy <= radius * radius;
+}
+
+bool collision_shape_raycast(const EseCollisionShape *shape, float x, float y, float dx, float dy,
+                             float max_distance, float *out_distance) {
+    log_assert("COLLISION_SHAPE", shape, "collision_shape_raycast called with NULL shape");
+    log_assert("COLLISION_SHAPE", out_distance,
+               "collision_shape_raycast called with NULL out_distance");
+
+    // Slab test in the box frame
+    float rx = x - shape->cx;
+    float ry = y - shape->cy;
+    const float origin[2] = {rx * shape->ux + ry * shape->uy, ry * shape->ux - rx * shape->uy};
+    const float dir[2] = {dx * shape->ux + dy * shape->uy, dy * shape->ux - dx * shape->uy};
+    const float ext[2] = {shape->hw, shape->hh};
+    float t_min = 0.0f;
+    float t_max = max_distance;
+
+    for (int i = 0; i < 2; i++) {
+        if (fabsf(dir[i]) < COLLISION_SHAPE_SAT_EPSILON) {
+            if (fabsf(origin[i]) > ext[i]) {
+                return false;
+            }
+            continue;
+        }
+        float t0 = (-ext[i] - origin[i]) / dir[i];
+        float t1 = (ext[i] - origin[i]) / dir[i];
+        if (t0 > t1) {
+            float swap = t0;
+            t0 = t1;
+            t1 = swap;
+        }
+        t_min = fmaxf(t_min, t0);
+        t_max = fminf(t_max, t1);
+        if (t_min > t_max) {
+            return false;
+        }
+    }
+
+    *out_distance = t_min;
+    return true;
+}
+
+void collision_shape_set_init(EseCollisionShapeSet *set) {
+    log_assert("COLLISION_SHAPE", set, "collision_shape_set_init called with NULL set");
+    memset(set, 0, sizeof(*set));
+}
+
+void collision_shape_set_free(EseCollisionShapeSet *set) {
+    log_assert("COLLISION_SHAPE", set, "collision_shape_set_free called with NULL set");
+    if (set->min_x) {
+        memory_manager.free(set->min_x);
+        memory_manager.free(set->shapes);
+    }
+    memset(set, 0, sizeof(*set));
+}
+
+void collision_shape_set_clear(EseCollisionShapeSet *set) {
+    log_assert("COLLISION_SHAPE", set, "collision_shape_set_clear called with NULL set");
+    _collision_shape_set_pad(set, 0, set->count);
+    set->count = 0;
+}
+
+void collision_shape_set_push(EseCollisionShapeSet *set, const EseCollisionShape *shape) {
+    log_assert("COLLISION_SHAPE", set, "collision_shape_set_push called with NULL set");
+    log_assert("COLLISION_SHAPE", shape, "collision_shape_set_push called with NULL shape");
+
+    if (set->count == set->capacity) {
+        _collision_shape_set_grow(set);
+    }
+
+    size_t i = set->count++;
+    set->min_x[i] = shape->min_x;
+    set->min_y[i] = shape->min_y;
+    set->max_x[i] = shape->max_x;
+    set->max_y[i] = shape->max_y;
+    set->shapes[i] = *shape;
+}
+
+bool collision_shape_set_first_overlap(const EseCollisionShapeSet *set,
+                                       const EseCollisionShape *shape, size_t *out_index) {
+    log_assert("COLLISION_SHAPE", set, "collision_shape_set_first_overlap called with NULL set");
+    log_assert("COLLISION_SHAPE", shape,
+               "collision_shape_set_first_overlap called with NULL shape");
+
+#if defined(COLLISION_SHAPE_SSE2)
+    const __m128 a_min_x = _mm_set1_ps(shape->min_x);
+    const __m128 a_min_y = _mm_set1_ps(shape->min_y);
+    const __m128 a_max_x = _mm_set1_ps(shape->max_x);
+    const __m128 a_max_y = _mm_set1_ps(shape->max_y);
+    for (size_t base = 0; base < set->count; base += COLLISION_SHAPE_LANES) {
+        __m128 m = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(set->min_x + base), a_max_x),
+                              _mm_cmple_ps(a_min_x, _mm_loadu_ps(set->max_x + base)));
+        m = _mm_and_ps(m, _mm_cmple_ps(_mm_loadu_ps(set->min_y + base), a_max_y));
+        m = _mm_and_ps(m, _mm_cmple_ps(a_min_y, _mm_loadu_ps(set->max_y + base)));
+        unsigned mask = (unsigned)_mm_movemask_ps(m);
+        if (mask && _collision_shape_resolve_lanes(set, shape, base, mask, out_index)) {
+            return true;
+        }
+    }
+#elif defined(COLLISION_SHAPE_NEON)
+    const float32x4_t a_min_x = vdupq_n_f32(shape->min_x);
+    const float32x4_t a_min_y = vdupq_n_f32(shape->min_y);
+    const float32x4_t a_max_x = vdupq_n_f32(shape->max_x);
+    const float32x4_t a_max_y = vdupq_n_f32(shape->max_y);
+    for (size_t base = 0; base < set->count; base += COLLISION_SHAPE_LANES) {
+        uint32x4_t m = vandq_u32(vcleq_f32(vld1q_f32(set->min_x + base), a_max_x),
+                                 vcleq_f32(a_min_x, vld1q_f32(set->max_x + base)));
+        m = vandq_u32(m, vcleq_f32(vld1q_f32(set->min_y + base), a_max_y));
+        m = vandq_u32(m, vcleq_f32(a_min_y, vld1q_f32(set->max_y + base)));
+        uint32_t lanes[COLLISION_SHAPE_LANES];
+        vst1q_u32(lanes, m);
+        unsigned mask = (lanes[0] & 1u) | (lanes[1] & 2u) | (lanes[2] & 4u) | (lanes[3] & 8u);
+        if (mask && _collision_shape_resolve_lanes(set, shape, base, mask, out_index)) {
+            return true;
+        }
+    }
+#else
+    for (size_t base = 0; base < set->count; base += COLLISION_SHAPE_LANES) {
+        unsigned mask = 0;
+        for (unsigned lane = 0; lane < COLLISION_SHAPE_LANES; lane++) {
+            size_t i = base + lane;
+            if (set->min_x[i] <= shape->max_x && shape->min_x <= set->max_x[i] &&
+                set->min_y[i] <= shape->max_y && shape->min_y <= set->max_y[i]) {
+                mask |= 1u << lane;
+            }
+        }
+        if (mask && _collision_shape_resolve_lanes(set, shape, base, mask, out_index)) {
+            return true;
+        }
+    }
+#endif
+
+    return false;
+}
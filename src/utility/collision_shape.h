@@ -0,0 +1,121 @@
+#ifndef ESE_COLLISION_SHAPE_H
+#define ESE_COLLISION_SHAPE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Forward declarations
+typedef struct EseRect EseRect;
+
+// Shapes are tested against sets in blocks of this many lanes
+#define COLLISION_SHAPE_LANES 4
+
+/**
+ * @brief World-space collision shape built from an EseRect, plain floats only.
+ *
+ * @details Holds both the axis-aligned box and the oriented box of a rect so
+ *          tests never go back to the Lua-aware EseRect. For unrotated shapes
+ *          the box is exact; for rotated ones it encloses the oriented box
+ *          with a small margin and only serves as a prefilter.
+ */
+typedef struct EseCollisionShape {
+    float min_x, min_y, max_x, max_y; /** World AABB */
+    float cx, cy;                     /** World centre */
+    float ux, uy;                     /** Unit x axis (cos, sin); the y axis is (-uy, ux) */
+    float hw, hh;                     /** Half extents along the axes */
+    bool rotated;                     /** Rotation is not effectively zero */
+} EseCollisionShape;
+
+/**
+ * @brief Contiguous set of collision shapes for batch tests.
+ *
+ * @details The AABBs are kept as separate float arrays padded to a multiple of
+ *          COLLISION_SHAPE_LANES with empty boxes, so the batch kernel can load
+ *          one block per step. The full shapes are kept alongside for the
+ *          oriented test.
+ */
+typedef struct EseCollisionShapeSet {
+    float *min_x;              /** Per-shape AABB, padded */
+    float *min_y;              /** Per-shape AABB, padded */
+    float *max_x;              /** Per-shape AABB, padded */
+    float *max_y;              /** Per-shape AABB, padded */
+    EseCollisionShape *shapes; /** Full shapes */
+    size_t count;              /** Number of shapes */
+    size_t capacity;           /** Allocated lanes, a multiple of COLLISION_SHAPE_LANES */
+} EseCollisionShapeSet;
+
+/**
+ * @brief Builds the world-space shape of @p rect translated by (dx, dy).
+ *
+ * @param out  Shape to fill.
+ * @param rect Local rect.
+ * @param dx   World x offset added to the rect.
+ * @param dy   World y offset added to the rect.
+ */
+void collision_shape_from_rect(EseCollisionShape *out, const EseRect *rect, float dx, float dy);
+
+/**
+ * @brief Tests two shapes; same result as ese_rect_intersects on the source rects.
+ */
+bool collision_shape_overlaps(const EseCollisionShape *a, const EseCollisionShape *b);
+
+/**
+ * @brief Tests a shape against a circle; exact for rotated shapes as well.
+ */
+bool collision_shape_overlaps_circle(const EseCollisionShape *shape, float x, float y,
+                                     float radius);
+
+/**
+ * @brief Casts a ray against a shape.
+ *
+ * @param shape        Shape to test.
+ * @param x            Ray origin x.
+ * @param y            Ray origin y.
+ * @param dx           Unit ray direction x.
+ * @param dy           Unit ray direction y.
+ * @param max_distance Length of the ray.
+ * @param out_distance Receives the distance to the entry point, 0 when the
+ *                     origin is inside the shape.
+ * @return true if the ray enters the shape within @p max_distance.
+ */
+bool collision_shape_raycast(const EseCollisionShape *shape, float x, float y, float dx, float dy,
+                             float max_distance, float *out_distance);
+
+/**
+ * @brief Initializes an empty set; no memory is allocated until shapes are added.
+ */
+void collision_shape_set_init(EseCollisionShapeSet *set);
+
+/**
+ * @brief Releases the memory held by a set and leaves it empty.
+ */
+void collision_shape_set_free(EseCollisionShapeSet *set);
+
+/**
+ * @brief Removes every shape while keeping the allocated storage.
+ */
+void collision_shape_set_clear(EseCollisionShapeSet *set);
+
+/**
+ * @brief Appends a shape, growing the set when needed.
+ */
+void collision_shape_set_push(EseCollisionShapeSet *set, const EseCollisionShape *shape);
+
+/**
+ * @brief Finds the first shape of @p set that overlaps @p shape.
+ *
+ * @details AABBs are compared a block of lanes at a time (SSE2 or NEON when
+ *          available, scalar otherwise); lanes that pass and involve a rotated
+ *          shape are confirmed with the oriented test. Does not allocate and
+ *          only reads, so it is safe on worker threads while the set is not
+ *          being modified.
+ *
+ * @param set       Shapes to test against.
+ * @param shape     Shape to test.
+ * @param out_index Optional, receives the index of the first overlapping shape.
+ * @return true if any shape of @p set overlaps @p shape.
+ */
+bool collision_shape_set_first_overlap(const EseCollisionShapeSet *set,
+                                       const EseCollisionShape *shape, size_t *out_index);
+
+#endif // ESE_COLLISION_SHAPE_H
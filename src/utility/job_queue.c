@@ -14,6 +14,12 @@
  * Cancellation marks jobs canceled but allows running jobs to finish without
  * invoking callbacks.
  *
+ * Data-parallel loops (ese_job_queue_parallel_for) bypass that pipeline. The
+ * calling thread publishes the loop, idle workers claim fixed-size chunks from
+ * a shared atomic cursor, and the caller claims chunks too. The caller only
+ * ever waits for chunks already running elsewhere, so a loop started from
+ * inside a job cannot deadlock on a busy pool.
+ *
  * Copyright (c) 2025-2026 Entity Sprite Engine
  * See LICENSE.md for details.
  */
@@ -77,13 +83,31 @@ typedef struct EseJob {
     volatile JobState state; /** Job state */
 } EseJob;
 
+/**
+ * @brief A data-parallel loop published by ese_job_queue_parallel_for.
+ *
+ * @details Lives on the caller's stack. Workers only touch it between a
+ *          helpers++ and helpers-- made under the queue's global mutex, and the
+ *          caller unpublishes it and waits for helpers to reach 0 before
+ *          returning.
+ */
+typedef struct ParallelFor {
+    parallel_for_function fn; /** Chunk body */
+    void *user_data;          /** Passed to fn */
+    size_t count;             /** Number of items */
+    size_t chunk;             /** Items per claimed chunk */
+    EseAtomicSizeT *next;     /** First item of the next unclaimed chunk */
+    uint32_t helpers;         /** Workers running chunks (global_mutex) */
+} ParallelFor;
+
 /**
  * @brief EseJobQueue structure representing a job queue.
  */
 typedef struct EseJobQueue {
-    EseMutex *global_mutex;            /** Mutex for global queue */
-    EseCond *global_cond;              /** Condition variable for global queue */
-    EseDoubleLinkedList *global_queue; /** List of EseJob* */
+    EseMutex *global_mutex;             /** Mutex for global queue */
+    EseCond *global_cond;               /** Condition variable for global queue */
+    EseDoubleLinkedList *global_queue;  /** List of EseJob* */
+    EseDoubleLinkedList *parallel_fors; /** List of ParallelFor* open for helpers */
 
     Worker *workers;      /** Array of worker threads */
     uint32_t num_workers; /** Number of worker threads */
@@ -150,6 +174,31 @@ static EseJob *_create_job(EseJobQueue *q, ese_worker_id_t worker_id, worker_thr
     return job;
 }
 
+/**
+ * @brief Runs chunks of a parallel loop until none are left to claim.
+ *
+ * @param pf Parallel loop
+ */
+static void _parallel_for_run(ParallelFor *pf) {
+    for (;;) {
+        size_t begin = ese_atomic_size_t_fetch_add(pf->next, pf->chunk);
+        if (begin >= pf->count) {
+            return;
+        }
+        size_t end = begin + pf->chunk < pf->count ? begin + pf->chunk : pf->count;
+        pf->fn(pf->user_data, begin, end);
+    }
+}
+
+/**
+ * @brief dlist_find predicate matching a parallel loop with unclaimed chunks.
+ */
+static int _parallel_for_has_work(void *value, void *user_data) {
+    (void)user_data;
+    ParallelFor *pf = (ParallelFor *)value;
+    return ese_atomic_size_t_load(pf->next) < pf->count;
+}
+
 /**
  * @brief Main worker thread function.
  *
@@ -180,6 +229,22 @@ static void *_worker_thread_main(void *ud) {
         ese_mutex_lock(q->global_mutex);
         shutdown_mode = q->shutting_down;
 
+        // Parallel loops come first: their callers are blocked until the
+        // chunks are done, and helping never leaves state for the main thread.
+        ParallelFor *pf = (ParallelFor *)dlist_find(q->parallel_fors, _parallel_for_has_work, NULL);
+        if (pf) {
+            pf->helpers++;
+            ese_mutex_unlock(q->global_mutex);
+
+            _parallel_for_run(pf);
+
+            ese_mutex_lock(q->global_mutex);
+            pf->helpers--;
+            ese_cond_broadcast(q->global_cond);
+            ese_mutex_unlock(q->global_mutex);
+            continue;
+        }
+
         EseDListIter *it = dlist_iter_create(q->global_queue);
         void *val = NULL;
 
@@ -351,6 +416,7 @@ EseJobQueue *ese_job_queue_create(uint32_t num_workers, worker_init_function ini
     q->global_mutex = ese_mutex_create();
     q->global_cond = ese_cond_create();
     q->global_queue = dlist_create(NULL);
+    q->parallel_fors = dlist_create(NULL);
     q->num_workers = num_workers;
     q->workers = memory_manager.calloc(num_workers, sizeof(Worker), MMTAG_THREAD);
     q->jobs_by_id = int_hashmap_create(NULL);
@@ -435,6 +501,63 @@ ese_job_id_t ese_job_queue_push_on_worker(EseJobQueue *q, ese_worker_id_t worker
     return job->id;
 }
 
+/**
+ * @brief Run a loop body over [0, count) in chunks spread across the workers.
+ *
+ * @param q Job queue whose workers help
+ * @param count Number of items
+ * @param min_chunk Smallest number of items handed out at once
+ * @param fn Chunk body
+ * @param user_data User data passed to fn
+ */
+void ese_job_queue_parallel_for(EseJobQueue *q, size_t count, size_t min_chunk,
+                                parallel_for_function fn, void *user_data) {
+    log_assert("JOBQ", q, "parallel_for null q");
+    log_assert("JOBQ", fn, "parallel_for null fn");
+
+    if (count == 0) {
+        return;
+    }
+
+    // Aim for a few chunks per thread so a slow chunk does not idle the rest
+    size_t chunk = count / (((size_t)q->num_workers + 1) * 4);
+    if (chunk < min_chunk) {
+        chunk = min_chunk;
+    }
+    if (chunk == 0) {
+        chunk = 1;
+    }
+    if (chunk >= count) {
+        fn(user_data, 0, count);
+        return;
+    }
+
+    ParallelFor pf = {
+        .fn = fn, .user_data = user_data, .count = count, .chunk = chunk, .helpers = 0};
+    pf.next = ese_atomic_size_t_create(0);
+
+    ese_mutex_lock(q->global_mutex);
+    bool published = !q->shutting_down;
+    if (published) {
+        dlist_append(q->parallel_fors, &pf);
+        ese_cond_broadcast(q->global_cond);
+    }
+    ese_mutex_unlock(q->global_mutex);
+
+    _parallel_for_run(&pf);
+
+    if (published) {
+        ese_mutex_lock(q->global_mutex);
+        dlist_remove_by_value(q->parallel_fors, &pf);
+        while (pf.helpers > 0) {
+            ese_cond_wait(q->global_cond, q->global_mutex);
+        }
+        ese_mutex_unlock(q->global_mutex);
+    }
+
+    ese_atomic_size_t_destroy(pf.next);
+}
+
 /**
  * @brief Query the status of a job.
  *
@@ -748,6 +871,7 @@ void ese_job_queue_destroy(EseJobQueue *q) {
     memory_manager.free(q->workers);
     int_hashmap_destroy(q->jobs_by_id);
     dlist_free(q->global_queue);
+    dlist_free(q->parallel_fors);
 
     ese_cond_destroy(q->global_cond);
     ese_mutex_destroy(q->global_mutex);
@@ -112,6 +112,13 @@ typedef void (*main_thread_job_callback)(ese_job_id_t job_id, void *user_data, v
  */
 typedef void (*main_thread_job_cleanup)(ese_job_id_t job_id, void *user_data, void *result);
 
+/**
+ * @typedef parallel_for_function
+ * @brief Type for the body of ese_job_queue_parallel_for, called once per
+ * chunk [begin, end) on whichever thread claimed it.
+ */
+typedef void (*parallel_for_function)(void *user_data, size_t begin, size_t end);
+
 // ========================================
 // PUBLIC FUNCTIONS
 // ========================================
@@ -188,6 +195,28 @@ ese_job_id_t ese_job_queue_push_on_worker(EseJobQueue *queue, ese_worker_id_t wo
                                           main_thread_job_callback callback,
                                           main_thread_job_cleanup cleanup, void *user_data);
 
+/**
+ * @brief Run a loop body over [0, count) in chunks spread across the workers.
+ *
+ * @details Blocks until every chunk has run. The calling thread runs chunks
+ *          itself alongside any idle workers, and never waits on a chunk that
+ *          nobody has started, so it is safe to call from inside a job (for
+ *          example a system update) even when every worker is busy. Chunks
+ *          are at least min_chunk items; loops that fit in one chunk run
+ *          inline. Chunks run concurrently and in no particular order, so fn
+ *          must only write state owned by its own items. Chunks do not go
+ *          through the job pipeline: there is no callback, cancellation or
+ *          result.
+ *
+ * @param queue Job queue whose workers help
+ * @param count Number of items
+ * @param min_chunk Smallest number of items handed out at once
+ * @param fn Chunk body
+ * @param user_data User data passed to fn
+ */
+void ese_job_queue_parallel_for(EseJobQueue *queue, size_t count, size_t min_chunk,
+                                parallel_for_function fn, void *user_data);
+
 /**
  * @brief Query the status of a job.
  *
@@ -0,0 +1,228 @@
+/**
+ * SLOT MAP IMPLEMENTATION
+ * =======================
+ *
+ * Dense value storage addressed by generational handles.
+ *
+ * - `values` holds the stored values contiguously; `dense_slots` holds the
+ *   slot owning each value so a removal can patch the value it moves.
+ * - `slots` is the sparse side: each slot keeps its current generation and,
+ *   while in use, the dense index of its value. Free slots reuse the index
+ *   field as the link of a FIFO free list, which spreads reuse over all free
+ *   slots and keeps generations from wrapping early.
+ * - Removing a value bumps its slot's generation, so every handle to it stops
+ *   resolving. A slot whose generation would wrap is retired instead of being
+ *   reused; this costs one slot per 4095 reuses and keeps stale handles from
+ *   ever aliasing a new value.
+ *
+ * Insert, remove and lookup are O(1); iteration is a plain loop over `values`.
+ */
+
+#include "utility/slot_map.h"
+#include "core/memory_manager.h"
+#include "utility/log.h"
+
+// ========================================
+// Defines and Structs
+// ========================================
+
+#define SLOT_MAP_INDEX_MASK (SLOT_MAP_MAX_SLOTS - 1u)
+#define SLOT_MAP_MAX_GENERATION ((1u << (32 - SLOT_MAP_INDEX_BITS)) - 1u)
+#define SLOT_MAP_NO_SLOT UINT32_MAX
+#define SLOT_MAP_DEFAULT_CAPACITY 64
+
+typedef struct SlotMapSlot {
+    uint32_t generation; /** Generation of the current (or next) value */
+    uint32_t index;      /** Dense index while used, next free slot while free */
+} SlotMapSlot;
+
+struct EseSlotMap {
+    void **values;         /** Dense values */
+    uint32_t *dense_slots; /** Slot of each dense value */
+    size_t count;          /** Number of stored values */
+    size_t dense_capacity; /** Allocated dense entries */
+
+    SlotMapSlot *slots;   /** Sparse slots */
+    size_t slot_count;    /** Slots handed out so far */
+    size_t slot_capacity; /** Allocated slots */
+    uint32_t free_head;   /** Oldest free slot, or SLOT_MAP_NO_SLOT */
+    uint32_t free_tail;   /** Newest free slot, or SLOT_MAP_NO_SLOT */
+};
+
+// ========================================
+// PRIVATE FUNCTIONS
+// ========================================
+
+static inline EseSlotHandle _make_handle(uint32_t slot, uint32_t generation) {
+    return (generation << SLOT_MAP_INDEX_BITS) | slot;
+}
+
+/**
+ * @brief Resolves a handle to its slot, or NULL if the handle is stale.
+ */
+static SlotMapSlot *_slot_for(const EseSlotMap *map, EseSlotHandle handle) {
+    uint32_t slot = handle & SLOT_MAP_INDEX_MASK;
+    uint32_t generation = handle >> SLOT_MAP_INDEX_BITS;
+    if (generation == 0 || slot >= map->slot_count) {
+        return NULL;
+    }
+    SlotMapSlot *entry = &map->slots[slot];
+    return entry->generation == generation ? entry : NULL;
+}
+
+static void _push_free(EseSlotMap *map, uint32_t slot) {
+    map->slots[slot].index = SLOT_MAP_NO_SLOT;
+    if (map->free_tail == SLOT_MAP_NO_SLOT) {
+        map->free_head = slot;
+    } else {
+        map->slots[map->free_tail].index = slot;
+    }
+    map->free_tail = slot;
+}
+
+static uint32_t _pop_free(EseSlotMap *map) {
+    uint32_t slot = map->free_head;
+    if (slot != SLOT_MAP_NO_SLOT) {
+        map->free_head = map->slots[slot].index;
+        if (map->free_head == SLOT_MAP_NO_SLOT) {
+            map->free_tail = SLOT_MAP_NO_SLOT;
+        }
+    }
+    return slot;
+}
+
+// ========================================
+// PUBLIC FUNCTIONS
+// ========================================
+
+EseSlotMap *slot_map_create(size_t initial_capacity) {
+    if (initial_capacity == 0) {
+        initial_capacity = SLOT_MAP_DEFAULT_CAPACITY;
+    }
+
+    EseSlotMap *map = memory_manager.calloc(1, sizeof(EseSlotMap), MMTAG_SLOT_MAP);
+    map->values = memory_manager.malloc(sizeof(void *) * initial_capacity, MMTAG_SLOT_MAP);
+    map->dense_slots = memory_manager.malloc(sizeof(uint32_t) * initial_capacity, MMTAG_SLOT_MAP);
+    map->dense_capacity = initial_capacity;
+    map->slots = memory_manager.malloc(sizeof(SlotMapSlot) * initial_capacity, MMTAG_SLOT_MAP);
+    map->slot_capacity = initial_capacity;
+    map->free_head = SLOT_MAP_NO_SLOT;
+    map->free_tail = SLOT_MAP_NO_SLOT;
+    return map;
+}
+
+void slot_map_destroy(EseSlotMap *map) {
+    if (!map)
+        return;
+    memory_manager.free(map->values);
+    memory_manager.free(map->dense_slots);
+    memory_manager.free(map->slots);
+    memory_manager.free(map);
+}
+
+void slot_map_clear(EseSlotMap *map) {
+    log_assert("SLOT_MAP", map, "slot_map_clear called with NULL map");
+
+    while (map->count > 0) {
+        uint32_t slot = map->dense_slots[map->count - 1];
+        slot_map_remove(map, _make_handle(slot, map->slots[slot].generation));
+    }
+}
+
+EseSlotHandle slot_map_insert(EseSlotMap *map, void *value) {
+    log_assert("SLOT_MAP", map, "slot_map_insert called with NULL map");
+
+    uint32_t slot = _pop_free(map);
+    if (slot == SLOT_MAP_NO_SLOT) {
+        if (map->slot_count == SLOT_MAP_MAX_SLOTS) {
+            log_error("SLOT_MAP", "slot_map_insert: all %u slots are in use", SLOT_MAP_MAX_SLOTS);
+            return SLOT_MAP_NULL_HANDLE;
+        }
+        if (map->slot_count == map->slot_capacity) {
+            size_t capacity = map->slot_capacity * 2;
+            if (capacity > SLOT_MAP_MAX_SLOTS) {
+                capacity = SLOT_MAP_MAX_SLOTS;
+            }
+            map->slots =
+                memory_manager.realloc(map->slots, sizeof(SlotMapSlot) * capacity, MMTAG_SLOT_MAP);
+            map->slot_capacity = capacity;
+        }
+        slot = (uint32_t)map->slot_count++;
+        map->slots[slot].generation = 1;
+    }
+
+    if (map->count == map->dense_capacity) {
+        size_t capacity = map->dense_capacity * 2;
+        map->values =
+            memory_manager.realloc(map->values, sizeof(void *) * capacity, MMTAG_SLOT_MAP);
+        map->dense_slots =
+            memory_manager.realloc(map->dense_slots, sizeof(uint32_t) * capacity, MMTAG_SLOT_MAP);
+        map->dense_capacity = capacity;
+    }
+
+    uint32_t index = (uint32_t)map->count++;
+    map->values[index] = value;
+    map->dense_slots[index] = slot;
+    map->slots[slot].index = index;
+    return _make_handle(slot, map->slots[slot].generation);
+}
+
+void *slot_map_remove(EseSlotMap *map, EseSlotHandle handle) {
+    log_assert("SLOT_MAP", map, "slot_map_remove called with NULL map");
+
+    SlotMapSlot *entry = _slot_for(map, handle);
+    if (!entry) {
+        return NULL;
+    }
+
+    uint32_t index = entry->index;
+    void *value = map->values[index];
+
+    // Move the last value into the hole
+    uint32_t last = (uint32_t)map->count - 1;
+    if (index != last) {
+        uint32_t moved_slot = map->dense_slots[last];
+        map->values[index] = map->values[last];
+        map->dense_slots[index] = moved_slot;
+        map->slots[moved_slot].index = index;
+    }
+    map->count--;
+
+    uint32_t slot = handle & SLOT_MAP_INDEX_MASK;
+    if (entry->generation == SLOT_MAP_MAX_GENERATION) {
+        // Retire the slot so an old handle can never match a new value
+        entry->generation = 0;
+        entry->index = SLOT_MAP_NO_SLOT;
+    } else {
+        entry->generation++;
+        _push_free(map, slot);
+    }
+    return value;
+}
+
+void *slot_map_get(const EseSlotMap *map, EseSlotHandle handle) {
+    log_assert("SLOT_MAP", map, "slot_map_get called with NULL map");
+
+    SlotMapSlot *entry = _slot_for(map, handle);
+    return entry ? map->values[entry->index] : NULL;
+}
+
+size_t slot_map_size(const EseSlotMap *map) {
+    log_assert("SLOT_MAP", map, "slot_map_size called with NULL map");
+    return map->count;
+}
+
+void **slot_map_values(const EseSlotMap *map) {
+    log_assert("SLOT_MAP", map, "slot_map_values called with NULL map");
+    return map->values;
+}
+
+EseSlotHandle slot_map_handle_at(const EseSlotMap *map, size_t index) {
+    log_assert("SLOT_MAP", map, "slot_map_handle_at called with NULL map");
+
+    if (index >= map->count) {
+        return SLOT_MAP_NULL_HANDLE;
+    }
+    uint32_t slot = map->dense_slots[index];
+    return _make_handle(slot, map->slots[slot].generation);
+}
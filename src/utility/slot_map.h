@@ -0,0 +1,106 @@
+#ifndef ESE_SLOT_MAP_H
+#define ESE_SLOT_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Handle bit layout: low SLOT_MAP_INDEX_BITS select the slot, the rest hold
+// the slot's generation. Generations start at 1, so 0 is never a live handle.
+#define SLOT_MAP_INDEX_BITS 20
+#define SLOT_MAP_MAX_SLOTS (1u << SLOT_MAP_INDEX_BITS)
+#define SLOT_MAP_NULL_HANDLE 0u
+
+// Forward declarations
+typedef struct EseSlotMap EseSlotMap;
+
+// Generational handle to a value stored in an EseSlotMap
+typedef uint32_t EseSlotHandle;
+
+/**
+ * @brief Create a new, empty slot map.
+ *
+ * @details Values are kept densely packed in insertion order until a removal
+ *          moves the last value into the freed place. Handles stay valid until
+ *          their value is removed; a removed handle never resolves again, even
+ *          after its slot is reused.
+ *
+ * @param initial_capacity Number of values to reserve room for (0 for a default).
+ * @return Pointer to a new EseSlotMap.
+ */
+EseSlotMap *slot_map_create(size_t initial_capacity);
+
+/**
+ * @brief Free the slot map. Stored values are not freed.
+ *
+ * @param map Pointer to the EseSlotMap to free (may be NULL).
+ */
+void slot_map_destroy(EseSlotMap *map);
+
+/**
+ * @brief Remove every value and invalidate every outstanding handle.
+ *
+ * @param map Pointer to the EseSlotMap.
+ */
+void slot_map_clear(EseSlotMap *map);
+
+/**
+ * @brief Store a value in O(1).
+ *
+ * @param map Pointer to the EseSlotMap.
+ * @param value Value to store.
+ * @return Handle of the value, or SLOT_MAP_NULL_HANDLE once SLOT_MAP_MAX_SLOTS
+ *         slots are in use.
+ */
+EseSlotHandle slot_map_insert(EseSlotMap *map, void *value);
+
+/**
+ * @brief Remove the value behind a handle in O(1).
+ *
+ * @details The last dense value moves into the removed value's place, so the
+ *          dense order changes.
+ *
+ * @param map Pointer to the EseSlotMap.
+ * @param handle Handle returned by slot_map_insert.
+ * @return The removed value, or NULL if the handle is stale or null.
+ */
+void *slot_map_remove(EseSlotMap *map, EseSlotHandle handle);
+
+/**
+ * @brief Resolve a handle in O(1).
+ *
+ * @param map Pointer to the EseSlotMap.
+ * @param handle Handle to resolve.
+ * @return The stored value, or NULL if the handle is stale or null.
+ */
+void *slot_map_get(const EseSlotMap *map, EseSlotHandle handle);
+
+/**
+ * @brief Get the number of stored values.
+ *
+ * @param map Pointer to the EseSlotMap.
+ * @return Number of values.
+ */
+size_t slot_map_size(const EseSlotMap *map);
+
+/**
+ * @brief Get the contiguous array of stored values.
+ *
+ * @details Valid for slot_map_size() entries until the next insert, remove or
+ *          clear. Iterate with a plain index loop; no iterator is needed.
+ *
+ * @param map Pointer to the EseSlotMap.
+ * @return Pointer to the first value (may be NULL when the map is empty).
+ */
+void **slot_map_values(const EseSlotMap *map);
+
+/**
+ * @brief Get the handle of the value at a dense index.
+ *
+ * @param map Pointer to the EseSlotMap.
+ * @param index Dense index, less than slot_map_size().
+ * @return Handle of the value, or SLOT_MAP_NULL_HANDLE if out of range.
+ */
+EseSlotHandle slot_map_handle_at(const EseSlotMap *map, size_t index);
+
+#endif // ESE_SLOT_MAP_H
@@ -2,174 +2,115 @@
  * SPATIAL INDEX IMPLEMENTATION
  * ============================
  *
- * This file implements a hybrid spatial indexing system that combines a uniform
- * grid with Dynamic Bounding Volume Hierarchies (DBVH) for efficient collision
- * detection. The system automatically adapts to entity density and distribution
- * patterns.
+ * This file implements a persistent, incrementally updated uniform grid used
+ * as the collision broadphase. Entities are registered once, when a collider
+ * or map component is added, and stay in the grid until the last such
+ * component is removed. Each frame only entities whose bounds actually moved
+ * out of their fat AABB are re-bucketed.
  *
  * ARCHITECTURE OVERVIEW
  * =====================
  *
- * The spatial index uses a two-tier approach:
- * 1. UNIFORM GRID: Fast insertion and basic spatial partitioning
- * 2. DBVH REGIONS: Hierarchical structures for dense entity clusters
- *
  * Key Components:
- * - SpatialIndex: Main container with grid cells and DBVH regions
- * - Grid Cells: Fixed-size spatial bins storing entity lists
- * - DBVH Nodes: Self-balancing binary trees for dense regions
+ * - SpatialIndex: Main container with the proxy pool and the grid cells
+ * - Proxies: One slot per registered entity holding its fat AABB and the
+ *   range of grid cells it currently occupies
+ * - Grid Cells: Fixed-size spatial bins storing compact arrays of proxy ids
  * - Auto-tuning: Dynamic cell size adjustment based on entity distribution
  *
  * HOW IT WORKS
  * ============
  *
- * 1. ENTITY INSERTION:
- *    - Calculate which grid cells the entity's bounding box overlaps
- *    - Add entity to all relevant cell lists
- *    - Trigger auto-tuning if average cell density exceeds threshold
- *
- * 2. COLLISION DETECTION:
- *    - Convert dense cells (>8 entities) to DBVH regions
- *    - Query DBVH regions for internal entity pairs
- *    - Query remaining grid cells for entity pairs
- *    - Check neighboring cells for cross-boundary collisions
- *    - Apply component-based filtering before expensive AABB tests
- *
- * 3. AUTO-TUNING:
- *    - Calculates average entity diagonal size
- *    - Adjusts cell size to 2x average diagonal
- *    - Prevents excessive entity clustering in single cells
- *
- * STEP-BY-STEP EXAMPLES
- * =====================
- *
- * Example 1: Simple Entity Insertion
- * ----------------------------------
- *
- * Given: Entity at position (100, 50) with size (64, 32)
- *        Cell size: 128x128
- *
- * Step 1: Calculate grid coordinates
- *   - min_cell_x = floor(100 / 128) = 0
- *   - min_cell_y = floor(50 / 128) = 0
- *   - max_cell_x = floor(164 / 128) = 1
- *   - max_cell_y = floor(82 / 128) = 0
+ * 1. REGISTRATION:
+ *    - spatial_index_register() allocates a proxy (or bumps its reference
+ *      count when the entity has both a collider and a map)
+ *    - The proxy id is stored on the entity so lookups are O(1)
+ *    - The proxy is bucketed lazily on the next update, once the entity has
+ *      world bounds
  *
- * Step 2: Insert into cells (0,0) and (1,0)
- *   - Cell (0,0): Add entity to list
- *   - Cell (1,0): Add entity to list
+ * 2. UPDATE (once per frame):
+ *    - Sync each entity's transform, refreshing its collider bounds if the
+ *      position was written since the last update
+ *    - Read each entity's collision_world_bounds (AABB of the rotated rect)
+ *    - Copy the entity's collision filter word (collider layer and mask)
+ *      into the proxy
+ *    - If the tight bounds are still inside the proxy's fat AABB, do nothing
+ *    - Otherwise enlarge the new bounds by SPATIAL_INDEX_FAT_MARGIN and, only
+ *      when the covered cell range changed, move the proxy between cells
+ *    - Inactive entities and entities without bounds are taken out of the
+ *      grid but keep their proxy
+ *    - A proxy whose bounds, filter and components did not change counts one
+ *      more still frame. Static colliders rest on their first still frame,
+ *      dynamic ones fall asleep after sleep_frames still frames; any change
+ *      wakes the proxy for that update. The flag is mirrored on the entity
+ *      so the resolver can tell which remembered contacts were not retested
  *
- * Example 2: Dense Region Conversion to DBVH
- * -----------------------------------------
+ * 3. COLLISION DETECTION:
+ *    - Every cell with 2+ proxies is checked pairwise, except that two
+ *      resting proxies are never paired: neither moved, so their last result
+ *      still holds and the resolver carries it forward
+ *    - Pairs whose layer/mask filters reject each other are dropped first,
+ *      with one AND on the cached words and before any bounds test
+ *    - Because a proxy is stored in every cell its fat AABB touches, any two
+ *      overlapping entities share at least one cell; no neighbor scan needed
+ *    - The cached tight AABBs prune candidates without touching the entity
+ *    - Pairs are deduplicated by a 64-bit key packing both proxy ids into an
+ *      open-addressing set that is reused across frames
+ *    - Component-based filtering and the exact rect test run once per pair
+ *    - Emitted pairs go into a contiguous SpatialPair array owned by the
+ *      index; steady-state pair generation does no heap allocation
  *
- * Given: Cell (5,3) contains 12 entities (exceeds threshold of 8)
+ * 4. QUERIES:
+ *    - Rect and circle queries visit the cells under the query's bounds,
+ *      clipped to the extent of everything in the grid; a range covering more
+ *      cells than there are proxies scans the proxies instead
+ *    - Ray casts walk the cells along the ray in order (DDA) and stop once no
+ *      unvisited cell can hold a closer hit than the ones already found
+ *    - Nearest queries visit rings of cells around the query point and stop
+ *      once the ring is further away than the k-th best distance
+ *    - A proxy stored in several cells is tested once per query thanks to a
+ *      per-proxy query stamp
+ *    - Candidates pass the layer mask and fat AABB before the exact test
+ *      against the collider's cached world shapes
  *
- * Step 1: Collect entities from 3x3 region centered at (5,3)
- *   - Gather entities from cells (4,2) through (6,4)
- *   - Total entities: 15 (from 9 cells)
+ * 5. AUTO-TUNING:
+ *    - When average cell occupancy exceeds a threshold (with cooldown),
+ *      the cell size is set to 2x the average entity diagonal and all
+ *      proxies are re-bucketed
  *
- * Step 2: Build DBVH tree
- *   - Create root node with bounds encompassing all entities
- *   - Insert entities one by one, maintaining AVL balance
- *   - Each leaf node stores one entity
- *   - Internal nodes store bounding boxes of children
+ * STEP-BY-STEP EXAMPLE
+ * ====================
  *
- * Step 3: Replace grid cells with DBVH region
- *   - Remove entity lists from 9 grid cells
- *   - Store DBVH root in dbvh_regions map
- *   - Mark region center as (5,3)
- *
- * Example 3: Collision Detection Process
- * -------------------------------------
- *
- * Given: Mixed grid/DBVH spatial index
- *
- * Step 1: Convert dense cells to DBVH
- *   - Scan all grid cells
- *   - Convert cells with >8 entities to DBVH regions
- *
- * Step 2: Query DBVH regions
- *   - For each DBVH region:
- *     - Collect all entities in region
- *     - Check all entity pairs within region
- *     - Check entities against neighboring grid cells
- *
- * Step 3: Query remaining grid cells
- *   - For each cell with 2+ entities:
- *     - Check all entity pairs within cell
- *     - Check against 8 neighboring cells
- *     - Skip already-processed neighbor pairs
- *
- * Step 4: Apply filtering
- *   - Component-based prefilter (collider vs map interactions)
- *   - AABB intersection test
- *   - Deduplicate pairs using entity ID combinations
+ * Given: Entity at position (100, 50) with size (64, 32)
+ *        Cell size: 128x128, fat margin: 8
  *
- * Example 4: Auto-tuning Process
- * -----------------------------
+ * Step 1: Fat AABB = (92, 42) - (172, 90)
  *
- * Given: Average cell density > 10 entities
+ * Step 2: Calculate grid coordinates
+ *   - min_cell = (floor(92 / 128), floor(42 / 128)) = (0, 0)
+ *   - max_cell = (floor(172 / 128), floor(90 / 128)) = (1, 0)
  *
- * Step 1: Sample entity sizes
- *   - Iterate through all non-empty cells
- *   - Calculate diagonal of first entity in each cell
- *   - Compute average diagonal size
+ * Step 3: Insert proxy id into cells (0,0) and (1,0)
  *
- * Step 2: Adjust cell size
- *   - new_size = max(32, average_diagonal * 2)
- *   - Update cell_size parameter
- *   - Log adjustment for debugging
+ * Step 4: Entity moves 4 pixels right -> tight AABB (104, 50) - (168, 82)
+ *   - Still inside the fat AABB, nothing to do
  *
- * Step 3: Cooldown period
- *   - Set last_auto_tune_time to current time
- *   - Prevent frequent adjustments (5-second cooldown)
+ * Step 5: Entity moves 20 more pixels -> tight AABB (124, 50) - (188, 82)
+ *   - Fat AABB refit to (116, 42) - (196, 90), cells (0,0)-(1,0)
+ *   - Cell range unchanged, no cell lists are touched
  *
  * PERFORMANCE CHARACTERISTICS
  * ===========================
  *
- * Time Complexity:
- * - Insertion: O(1) per entity (amortized)
- * - Collision detection: O(n + k) where n=entities, k=collision pairs
- * - DBVH operations: O(log n) for balanced trees
- *
- * Space Complexity:
- * - Grid cells: O(n) where n=entities
- * - DBVH regions: O(n) in worst case
- * - Total: O(n) linear with entity count
- *
- * Memory Layout:
- * - SpatialIndex: 40 bytes + hashmap overhead
- * - DBVHNode: 48 bytes per node
- * - Grid cells: Variable based on entity distribution
- *
- * OPTIMIZATION FEATURES
- * =====================
- *
- * 1. Component-based filtering: Skip incompatible entity pairs early
- * 2. AABB prechecking: Avoid expensive collision tests for non-overlapping
- * entities
- * 3. Pair deduplication: Prevent duplicate collision pairs using sorted entity
- * IDs
- * 4. Neighbor querying: Only check adjacent cells for cross-boundary collisions
- * 5. Auto-tuning: Adapt cell size to entity distribution patterns
- * 6. DBVH conversion: Use hierarchical structures for dense regions
- * 7. Profile counting: Track performance metrics for optimization
- *
- * USAGE PATTERNS
- * ==============
- *
- * Typical workflow:
- * 1. Create spatial index with spatial_index_create()
- * 2. Insert entities with spatial_index_insert() as they move
- * 3. Query collision pairs with spatial_index_get_pairs()
- * 4. Process collision pairs in collision resolver
- * 5. Clear index with spatial_index_clear() when needed
- * 6. Destroy index with spatial_index_destroy() when done
+ * - Update: O(n) bounds compares; O(cells) work only for moved entities
+ * - Collision detection: O(c + k) where c=occupied cells, k=candidate pairs
+ * - Queries: O(cells covered + candidates), never more than a proxy scan
+ * - No allocations for static entities after the first frame
+ * - Pair set and pair array only grow; they are never freed between frames
  *
  * Thread Safety:
  * - Not thread-safe by design
- * - Single-threaded collision detection
- * - External synchronization required for multi-threaded access
+ * - Registration happens from component add/remove on the main thread
  */
 
 #include "spatial_index.h"
@@ -179,10 +120,9 @@
 #include "entity/entity.h"
 #include "entity/entity_private.h"
 #include "platform/time.h"
+#include "types/point.h"
 #include "types/rect.h"
-#include "utility/array.h"
-#include "utility/double_linked_list.h"
-#include "utility/hashmap.h"
+#include "utility/collision_shape.h"
 #include "utility/int_hashmap.h"
 #include "utility/log.h"
 #include "utility/profile.h"
@@ -191,33 +131,86 @@
 #include <string.h>
 
 #define SPATIAL_INDEX_DEFAULT_CELL_SIZE 128.0f
+#define SPATIAL_INDEX_FAT_MARGIN 8.0f
 #define SPATIAL_INDEX_AUTO_TUNE_THRESHOLD 10
-#define SPATIAL_INDEX_DBVH_THRESHOLD 8
 #define SPATIAL_INDEX_AUTO_TUNE_COOLDOWN_SECONDS 5.0
+#define SPATIAL_INDEX_INITIAL_PROXIES 64
+#define SPATIAL_INDEX_INITIAL_CELL_CAPACITY 4
+#define SPATIAL_INDEX_INITIAL_PAIRS 128
+#define SPATIAL_INDEX_INITIAL_PAIR_SET_BITS 10
+#define SPATIAL_INDEX_DEFAULT_SLEEP_FRAMES 30
 
 typedef uint64_t SpatialIndexKey;
 
-typedef struct DBVHNode {
-    float bounds_x;
-    float bounds_y;
-    float bounds_width;
-    float bounds_height;
-    EseEntity *entity;
-    struct DBVHNode *left;
-    struct DBVHNode *right;
-    int height;
-    int region_center_x;
-    int region_center_y;
-} DBVHNode;
+typedef struct SpatialProxy {
+    EseEntity *entity; // NULL when the slot is free
+    uint32_t refs;     // Components that registered this entity
+    uint32_t next_free;
+    uint32_t filter;   // Entity collision_filter as of the last update
+    uint32_t query_stamp; // Last query that visited the proxy
+    uint32_t still_frames; // Updates in a row that found the proxy unchanged
+    bool in_grid;
+    bool is_static; // Entity collision_static as of the last update
+    bool resting;   // Static and unchanged, or asleep; see spatial_index_update
+    bool wake;      // The entity's components changed; count the next update as a change
+    float min_x, min_y, max_x, max_y; // Fat AABB
+    float x0, y0, x1, y1;             // Tight AABB as of the last update
+    int cell_min_x, cell_min_y, cell_max_x, cell_max_y;
+} SpatialProxy;
+
+typedef struct SpatialCell {
+    uint32_t *proxies;
+    uint32_t count;
+    uint32_t capacity;
+} SpatialCell;
+
+// Open-addressing set of packed pair keys. A slot is occupied for the current
+// frame only when its stamp matches, so clearing is a single increment.
+typedef struct SpatialPairSet {
+    uint64_t *keys;
+    uint32_t *stamps;
+    uint32_t bits; // capacity == 1 << bits
+    uint32_t count;
+    uint32_t stamp;
+} SpatialPairSet;
 
 struct SpatialIndex {
     float cell_size;
-    EseIntHashMap *bins;         // IntHashmap<SpatialIndexKey, EseDoubleLinkedList*>
-    EseIntHashMap *dbvh_regions; // IntHashmap<SpatialIndexKey, DBVHNode*>
-    EseArray *pairs;             // Array of SpatialPair*
+    EseIntHashMap *cells; // IntHashmap<SpatialIndexKey, SpatialCell*>
+    SpatialProxy *proxies;
+    uint32_t proxy_capacity;
+    uint32_t proxy_count; // Live proxies
+    uint32_t free_head;
+    SpatialPairSet pair_set;
+    SpatialPair *pairs; // Contiguous pair output, reused across frames
+    size_t pair_count;
+    size_t pair_capacity;
     double last_auto_tune_time;
+    uint32_t query_stamp;
+    bool has_extent;      // Anything was in the grid at the last update
+    float extent_min_x;   // Union of the fat AABBs in the grid
+    float extent_min_y;
+    float extent_max_x;
+    float extent_max_y;
+    float position_slack; // Largest distance from an entity position to its fat AABB
+    uint32_t sleep_frames; // Unchanged updates before a dynamic proxy rests, 0 never
 };
 
+// Candidate callback for the query walkers; returns false to stop the walk
+typedef bool (*SpatialVisitFn)(SpatialProxy *proxy, void *ctx);
+
+// State shared by the query walkers and their candidate callbacks
+typedef struct SpatialQuery {
+    uint16_t mask;
+    const EseCollisionShape *rect;
+    float x, y, radius;         // Circle centre, ray origin or nearest point
+    float dx, dy, max_distance; // Unit ray direction and length
+    EseEntity **entities;       // Rect and circle results
+    SpatialQueryHit *hits;      // Ray and nearest results, nearest first
+    size_t count;
+    size_t max_results;
+} SpatialQuery;
+
 static SpatialIndexKey _spatial_index_compute_key(int x, int y) {
     uint32_t ux = (uint32_t)(int32_t)x;
     uint32_t uy = (uint32_t)(int32_t)y;
@@ -225,150 +218,220 @@ static SpatialIndexKey _spatial_index_compute_key(int x, int y) {
     return (SpatialIndexKey)key;
 }
 
-static void _free_spatial_pair(void *ptr) {
-    if (ptr)
-        memory_manager.free(ptr);
-}
-
-static int _dbvh_get_height(DBVHNode *node) { return node ? node->height : 0; }
-static int _dbvh_get_balance(DBVHNode *node) {
-    return node ? _dbvh_get_height(node->left) - _dbvh_get_height(node->right) : 0;
-}
-
-static DBVHNode *_dbvh_node_create(EseEntity *entity) {
-    DBVHNode *node = memory_manager.malloc(sizeof(DBVHNode), MMTAG_COLLISION_INDEX);
-    if (!node)
-        return NULL;
-    node->entity = entity;
-    node->left = NULL;
-    node->right = NULL;
-    node->height = 1;
-    node->region_center_x = INT_MIN;
-    node->region_center_y = INT_MIN;
-    if (entity && entity->collision_world_bounds) {
-        EseRect *r = entity->collision_world_bounds;
-        node->bounds_x = ese_rect_get_x(r);
-        node->bounds_y = ese_rect_get_y(r);
-        node->bounds_width = ese_rect_get_width(r);
-        node->bounds_height = ese_rect_get_height(r);
-    } else {
-        node->bounds_x = node->bounds_y = node->bounds_width = node->bounds_height = 0;
+static uint64_t _spatial_pair_key(uint32_t a, uint32_t b) {
+    return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+}
+
+static void _pair_set_init(SpatialPairSet *set, uint32_t bits) {
+    size_t capacity = (size_t)1 << bits;
+    set->keys = memory_manager.malloc(sizeof(uint64_t) * capacity, MMTAG_COLLISION_INDEX);
+    set->stamps = memory_manager.calloc(capacity, sizeof(uint32_t), MMTAG_COLLISION_INDEX);
+    set->bits = bits;
+    set->count = 0;
+    set->stamp = 1;
+}
+
+static void _pair_set_free(SpatialPairSet *set) {
+    memory_manager.free(set->keys);
+    memory_manager.free(set->stamps);
+}
+
+static void _pair_set_clear(SpatialPairSet *set) {
+    set->count = 0;
+    if (++set->stamp == 0) {
+        memset(set->stamps, 0, sizeof(uint32_t) * ((size_t)1 << set->bits));
+        set->stamp = 1;
     }
-    return node;
 }
 
-static void _dbvh_node_destroy(DBVHNode *node) {
-    if (!node)
-        return;
-    _dbvh_node_destroy(node->left);
-    _dbvh_node_destroy(node->right);
-    memory_manager.free(node);
+static size_t _pair_set_slot(const SpatialPairSet *set, uint64_t key) {
+    // Fibonacci hashing spreads the packed ids over the table
+    return (size_t)((key * 0x9E3779B97F4A7C15ull) >> (64 - set->bits));
 }
 
-static void _dbvh_update_bounds(DBVHNode *node) {
-    if (!node)
+static void _pair_set_grow(SpatialPairSet *set) {
+    SpatialPairSet old = *set;
+    _pair_set_init(set, old.bits + 1);
+    size_t old_capacity = (size_t)1 << old.bits;
+    size_t mask = ((size_t)1 << set->bits) - 1;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old.stamps[i] != old.stamp)
+            continue;
+        size_t slot = _pair_set_slot(set, old.keys[i]);
+        while (set->stamps[slot] == set->stamp)
+            slot = (slot + 1) & mask;
+        set->keys[slot] = old.keys[i];
+        set->stamps[slot] = set->stamp;
+        set->count++;
+    }
+    _pair_set_free(&old);
+}
+
+/**
+ * Inserts the key, returning false if it was already present this frame.
+ */
+static bool _pair_set_insert(SpatialPairSet *set, uint64_t key) {
+    // Keep the load factor at or below 1/2
+    if ((set->count + 1) * 2 > ((uint32_t)1 << set->bits)) {
+        _pair_set_grow(set);
+    }
+    size_t mask = ((size_t)1 << set->bits) - 1;
+    size_t slot = _pair_set_slot(set, key);
+    while (set->stamps[slot] == set->stamp) {
+        if (set->keys[slot] == key)
+            return false;
+        slot = (slot + 1) & mask;
+    }
+    set->keys[slot] = key;
+    set->stamps[slot] = set->stamp;
+    set->count++;
+    return true;
+}
+
+static void _spatial_cell_free(void *ptr) {
+    SpatialCell *cell = (SpatialCell *)ptr;
+    if (!cell)
         return;
-    if (node->entity && node->entity->collision_world_bounds) {
-        EseRect *b = node->entity->collision_world_bounds;
-        node->bounds_x = ese_rect_get_x(b);
-        node->bounds_y = ese_rect_get_y(b);
-        node->bounds_width = ese_rect_get_width(b);
-        node->bounds_height = ese_rect_get_height(b);
+    memory_manager.free(cell->proxies);
+    memory_manager.free(cell);
+}
+
+static void _cell_add(SpatialIndex *index, SpatialIndexKey key, uint32_t proxy_id) {
+    SpatialCell *cell = (SpatialCell *)int_hashmap_get(index->cells, key);
+    if (!cell) {
+        cell = memory_manager.malloc(sizeof(SpatialCell), MMTAG_COLLISION_INDEX);
+        cell->capacity = SPATIAL_INDEX_INITIAL_CELL_CAPACITY;
+        cell->count = 0;
+        cell->proxies =
+            memory_manager.malloc(sizeof(uint32_t) * cell->capacity, MMTAG_COLLISION_INDEX);
+        int_hashmap_set(index->cells, key, cell);
+    }
+    if (cell->count == cell->capacity) {
+        cell->capacity *= 2;
+        cell->proxies = memory_manager.realloc(cell->proxies, sizeof(uint32_t) * cell->capacity,
+                                               MMTAG_COLLISION_INDEX);
+    }
+    cell->proxies[cell->count++] = proxy_id;
+    profile_count_add("spatial_index_entity_cell_insert");
+}
+
+static void _cell_remove(SpatialIndex *index, SpatialIndexKey key, uint32_t proxy_id) {
+    SpatialCell *cell = (SpatialCell *)int_hashmap_get(index->cells, key);
+    if (!cell)
         return;
+    for (uint32_t i = 0; i < cell->count; i++) {
+        if (cell->proxies[i] == proxy_id) {
+            cell->proxies[i] = cell->proxies[--cell->count];
+            break;
+        }
     }
-    if (node->left && node->right) {
-        float min_x = fminf(node->left->bounds_x, node->right->bounds_x);
-        float min_y = fminf(node->left->bounds_y, node->right->bounds_y);
-        float max_x = fmaxf(node->left->bounds_x + node->left->bounds_width,
-                            node->right->bounds_x + node->right->bounds_width);
-        float max_y = fmaxf(node->left->bounds_y + node->left->bounds_height,
-                            node->right->bounds_y + node->right->bounds_height);
-        node->bounds_x = min_x;
-        node->bounds_y = min_y;
-        node->bounds_width = max_x - min_x;
-        node->bounds_height = max_y - min_y;
-    } else if (node->left) {
-        node->bounds_x = node->left->bounds_x;
-        node->bounds_y = node->left->bounds_y;
-        node->bounds_width = node->left->bounds_width;
-        node->bounds_height = node->left->bounds_height;
-    } else if (node->right) {
-        node->bounds_x = node->right->bounds_x;
-        node->bounds_y = node->right->bounds_y;
-        node->bounds_width = node->right->bounds_width;
-        node->bounds_height = node->right->bounds_height;
-    }
-}
-
-static DBVHNode *_dbvh_rotate_right(DBVHNode *y) {
-    DBVHNode *x = y->left;
-    DBVHNode *T2 = x->right;
-    x->right = y;
-    y->left = T2;
-    y->height = 1 + fmax(_dbvh_get_height(y->left), _dbvh_get_height(y->right));
-    x->height = 1 + fmax(_dbvh_get_height(x->left), _dbvh_get_height(x->right));
-    _dbvh_update_bounds(y);
-    _dbvh_update_bounds(x);
-    return x;
-}
-
-static DBVHNode *_dbvh_rotate_left(DBVHNode *x) {
-    DBVHNode *y = x->right;
-    DBVHNode *T2 = y->left;
-    y->left = x;
-    x->right = T2;
-    x->height = 1 + fmax(_dbvh_get_height(x->left), _dbvh_get_height(x->right));
-    y->height = 1 + fmax(_dbvh_get_height(y->left), _dbvh_get_height(y->right));
-    _dbvh_update_bounds(x);
-    _dbvh_update_bounds(y);
-    return y;
-}
-
-static DBVHNode *_dbvh_insert(DBVHNode *root, EseEntity *entity) {
-    if (!entity || !entity->collision_world_bounds)
-        return root;
-    if (!root)
-        return _dbvh_node_create(entity);
-    DBVHNode *new_node = _dbvh_node_create(entity);
-    if (!new_node)
-        return root;
-    if (!root->right) {
-        root->right = new_node;
-    } else {
-        DBVHNode *internal = _dbvh_node_create(NULL);
-        if (!internal) {
-            _dbvh_node_destroy(new_node);
-            return root;
+    if (cell->count == 0) {
+        int_hashmap_remove(index->cells, key);
+        _spatial_cell_free(cell);
+    }
+}
+
+static void _proxy_insert_cells(SpatialIndex *index, uint32_t proxy_id) {
+    SpatialProxy *p = &index->proxies[proxy_id];
+    for (int cx = p->cell_min_x; cx <= p->cell_max_x; cx++) {
+        for (int cy = p->cell_min_y; cy <= p->cell_max_y; cy++) {
+            _cell_add(index, _spatial_index_compute_key(cx, cy), proxy_id);
         }
-        internal->left = root;
-        internal->right = new_node;
-        root = internal;
     }
-    root->height = 1 + fmax(_dbvh_get_height(root->left), _dbvh_get_height(root->right));
-    _dbvh_update_bounds(root);
-    int balance = _dbvh_get_balance(root);
-    if (balance > 1) {
-        if (_dbvh_get_balance(root->left) < 0)
-            root->left = _dbvh_rotate_left(root->left);
-        return _dbvh_rotate_right(root);
+    p->in_grid = true;
+}
+
+static void _proxy_remove_cells(SpatialIndex *index, uint32_t proxy_id) {
+    SpatialProxy *p = &index->proxies[proxy_id];
+    if (!p->in_grid)
+        return;
+    for (int cx = p->cell_min_x; cx <= p->cell_max_x; cx++) {
+        for (int cy = p->cell_min_y; cy <= p->cell_max_y; cy++) {
+            _cell_remove(index, _spatial_index_compute_key(cx, cy), proxy_id);
+        }
     }
-    if (balance < -1) {
-        if (_dbvh_get_balance(root->right) > 0)
-            root->right = _dbvh_rotate_right(root->right);
-        return _dbvh_rotate_left(root);
+    p->in_grid = false;
+}
+
+/**
+ * Reads the entity's world bounds as an axis-aligned box. Rotated rects are
+ * rotated around their center, so the box is expanded to cover all corners.
+ */
+static bool _entity_tight_bounds(const EseEntity *entity, float *x0, float *y0, float *x1,
+                                 float *y1) {
+    EseRect *r = entity->collision_world_bounds;
+    if (!r)
+        return false;
+    float x = ese_rect_get_x(r);
+    float y = ese_rect_get_y(r);
+    float w = ese_rect_get_width(r);
+    float h = ese_rect_get_height(r);
+    float rot = ese_rect_get_rotation(r);
+    if (fabsf(rot) < 1e-6f) {
+        *x0 = x;
+        *y0 = y;
+        *x1 = x + w;
+        *y1 = y + h;
+        return true;
     }
-    return root;
+    float cx = x + w * 0.5f;
+    float cy = y + h * 0.5f;
+    float c = fabsf(cosf(rot));
+    float s = fabsf(sinf(rot));
+    float hw = (w * c + h * s) * 0.5f;
+    float hh = (w * s + h * c) * 0.5f;
+    *x0 = cx - hw;
+    *y0 = cy - hh;
+    *x1 = cx + hw;
+    *y1 = cy + hh;
+    return true;
 }
 
-static void _dbvh_collect_entities(DBVHNode *root, EseArray *entities) {
-    if (!root)
+/**
+ * Refits the proxy's fat AABB around the given tight bounds and moves it
+ * between cells only if the covered cell range changed.
+ */
+static void _proxy_refit(SpatialIndex *index, uint32_t proxy_id, float x0, float y0, float x1,
+                         float y1) {
+    SpatialProxy *p = &index->proxies[proxy_id];
+    p->x0 = x0;
+    p->y0 = y0;
+    p->x1 = x1;
+    p->y1 = y1;
+    p->min_x = x0 - SPATIAL_INDEX_FAT_MARGIN;
+    p->min_y = y0 - SPATIAL_INDEX_FAT_MARGIN;
+    p->max_x = x1 + SPATIAL_INDEX_FAT_MARGIN;
+    p->max_y = y1 + SPATIAL_INDEX_FAT_MARGIN;
+
+    int min_cx = (int)floorf(p->min_x / index->cell_size);
+    int min_cy = (int)floorf(p->min_y / index->cell_size);
+    int max_cx = (int)floorf(p->max_x / index->cell_size);
+    int max_cy = (int)floorf(p->max_y / index->cell_size);
+
+    if (p->in_grid && min_cx == p->cell_min_x && min_cy == p->cell_min_y &&
+        max_cx == p->cell_max_x && max_cy == p->cell_max_y) {
         return;
-    if (root->entity) {
-        array_push(entities, root->entity);
-    } else {
-        _dbvh_collect_entities(root->left, entities);
-        _dbvh_collect_entities(root->right, entities);
     }
+
+    _proxy_remove_cells(index, proxy_id);
+    p->cell_min_x = min_cx;
+    p->cell_min_y = min_cy;
+    p->cell_max_x = max_cx;
+    p->cell_max_y = max_cy;
+    _proxy_insert_cells(index, proxy_id);
+    profile_count_add("spatial_index_proxy_moved");
+}
+
+static void _free_proxy_slot(SpatialIndex *index, uint32_t proxy_id) {
+    SpatialProxy *p = &index->proxies[proxy_id];
+    _proxy_remove_cells(index, proxy_id);
+    p->entity->spatial_proxy = SPATIAL_INDEX_NULL_PROXY;
+    p->entity->collision_resting = false;
+    p->entity = NULL;
+    p->refs = 0;
+    p->next_free = index->free_head;
+    index->free_head = proxy_id;
+    index->proxy_count--;
 }
 
 static bool _pair_is_potential_collision(EseEntity *a, EseEntity *b) {
@@ -417,14 +480,13 @@ static bool _pair_is_potential_collision(EseEntity *a, EseEntity *b) {
 static float _calculate_average_bin_count(SpatialIndex *index) {
     size_t total_entities = 0;
     size_t non_empty_bins = 0;
-    EseIntHashMapIter *iter = int_hashmap_iter_create(index->bins);
+    EseIntHashMapIter *iter = int_hashmap_iter_create(index->cells);
     uint64_t key;
     void *value;
     while (int_hashmap_iter_next(iter, &key, &value)) {
-        EseDoubleLinkedList *list = (EseDoubleLinkedList *)value;
-        size_t sz = dlist_size(list);
-        if (sz > 0) {
-            total_entities += sz;
+        SpatialCell *cell = (SpatialCell *)value;
+        if (cell->count > 0) {
+            total_entities += cell->count;
             non_empty_bins++;
         }
     }
@@ -432,359 +494,756 @@ static float _calculate_average_bin_count(SpatialIndex *index) {
     return non_empty_bins > 0 ? (float)total_entities / (float)non_empty_bins : 0.0f;
 }
 
-static void _emit_pair_if_new(SpatialIndex *index, EseHashMap *seen, EseArray *pairs, EseEntity *a,
-                              EseEntity *b) {
-    if (!a || !b || !seen || !pairs)
-        return;
-    if (a == b)
-        return;
-    if (a->id && b->id && strcmp(ese_uuid_get_value(a->id), ese_uuid_get_value(b->id)) == 0)
-        return;
+static void _emit_pair(SpatialIndex *index, uint64_t key) {
+    if (index->pair_count == index->pair_capacity) {
+        index->pair_capacity *= 2;
+        index->pairs = memory_manager.realloc(
+            index->pairs, sizeof(SpatialPair) * index->pair_capacity, MMTAG_COLLISION_INDEX);
+    }
+
+    // Canonical order: lower proxy id first
+    SpatialPair *pair = &index->pairs[index->pair_count++];
+    pair->a = index->proxies[(uint32_t)(key >> 32)].entity;
+    pair->b = index->proxies[(uint32_t)key].entity;
+    pair->key = key;
+}
 
-    const char *ida = ese_uuid_get_value(a->id);
-    const char *idb = ese_uuid_get_value(b->id);
-    const char *first = ida;
-    const char *second = idb;
+static void _extent_reset(SpatialIndex *index) {
+    index->has_extent = false;
+    index->position_slack = 0.0f;
+}
 
-    if (strcmp(ida, idb) > 0) {
-        first = idb;
-        second = ida;
+/**
+ * Grows the grid extent by a proxy's fat AABB and records how far the
+ * entity's position lies outside it (collider offsets), which bounds the
+ * nearest query's ring search.
+ */
+static void _extent_add(SpatialIndex *index, const SpatialProxy *p) {
+    if (!index->has_extent) {
+        index->extent_min_x = p->min_x;
+        index->extent_min_y = p->min_y;
+        index->extent_max_x = p->max_x;
+        index->extent_max_y = p->max_y;
+        index->has_extent = true;
+    } else {
+        index->extent_min_x = fminf(index->extent_min_x, p->min_x);
+        index->extent_min_y = fminf(index->extent_min_y, p->min_y);
+        index->extent_max_x = fmaxf(index->extent_max_x, p->max_x);
+        index->extent_max_y = fmaxf(index->extent_max_y, p->max_y);
     }
 
-    size_t keylen = strlen(first) + 1 + strlen(second) + 1;
-    char *key = memory_manager.malloc(keylen, MMTAG_COLLISION_INDEX);
-    snprintf(key, keylen, "%s|%s", first, second);
+    float px = _entity_get_x(p->entity);
+    float py = _entity_get_y(p->entity);
+    float sx = fmaxf(fmaxf(p->min_x - px, px - p->max_x), 0.0f);
+    float sy = fmaxf(fmaxf(p->min_y - py, py - p->max_y), 0.0f);
+    index->position_slack = fmaxf(index->position_slack, sqrtf(sx * sx + sy * sy));
+}
 
-    if (hashmap_get(seen, key) != NULL) {
-        memory_manager.free(key);
-        return;
+static uint32_t _next_query_stamp(SpatialIndex *index) {
+    if (++index->query_stamp == 0) {
+        for (uint32_t i = 0; i < index->proxy_capacity; i++) {
+            index->proxies[i].query_stamp = 0;
+        }
+        index->query_stamp = 1;
+    }
+    return index->query_stamp;
+}
+
+/**
+ * Checks a candidate against the query mask and brings its collider shapes up
+ * to date with moves made since the last update.
+ */
+static bool _proxy_queryable(const SpatialProxy *p, uint16_t mask) {
+    if (!p->entity->active || (p->entity->collision_filter & mask) == 0) {
+        return false;
+    }
+    _entity_sync_transform(p->entity);
+    return true;
+}
+
+/**
+ * Returns the cached world shapes of the entity's next active collider, or
+ * NULL once all components have been visited.
+ */
+static const EseCollisionShapeSet *_next_shape_set(const EseEntity *entity, size_t *cursor) {
+    while (*cursor < entity->component_count) {
+        EseEntityComponent *comp = entity->components[(*cursor)++];
+        if (comp && comp->active && comp->type == ENTITY_COMPONENT_COLLIDER) {
+            return &((EseEntityComponentCollider *)comp->data)->shapes;
+        }
     }
+    return NULL;
+}
 
-    hashmap_set(seen, key, (void *)1);
-    memory_manager.free(key);
+static bool _entity_has_shapes(const EseEntity *entity) {
+    size_t cursor = 0;
+    const EseCollisionShapeSet *set;
+    while ((set = _next_shape_set(entity, &cursor))) {
+        if (set->count > 0)
+            return true;
+    }
+    return false;
+}
 
-    SpatialPair *pair =
-        (SpatialPair *)memory_manager.malloc(sizeof(SpatialPair), MMTAG_COLLISION_INDEX);
-    pair->a = a;
-    pair->b = b;
+/**
+ * Clips the query ray against a box; returns the entry and exit distances.
+ */
+static bool _ray_box(const SpatialQuery *q, float min_x, float min_y, float max_x, float max_y,
+                     float *t_enter, float *t_exit) {
+    const float origin[2] = {q->x, q->y};
+    const float dir[2] = {q->dx, q->dy};
+    const float lo[2] = {min_x, min_y};
+    const float hi[2] = {max_x, max_y};
+    float t0 = 0.0f;
+    float t1 = q->max_distance;
+    for (int i = 0; i < 2; i++) {
+        if (dir[i] == 0.0f) {
+            if (origin[i] < lo[i] || origin[i] > hi[i])
+                return false;
+            continue;
+        }
+        float a = (lo[i] - origin[i]) / dir[i];
+        float b = (hi[i] - origin[i]) / dir[i];
+        t0 = fmaxf(t0, fminf(a, b));
+        t1 = fminf(t1, fmaxf(a, b));
+        if (t0 > t1)
+            return false;
+    }
+    *t_enter = t0;
+    *t_exit = t1;
+    return true;
+}
 
-    if (!array_push(pairs, pair)) {
-        log_warn("SPATIAL_INDEX", "Failed to add pair to array");
-        memory_manager.free(pair);
+/**
+ * Adds a hit to the sorted result list, keeping the nearest max_results.
+ */
+static void _query_insert_hit(SpatialQuery *q, EseEntity *entity, float distance) {
+    if (q->count == q->max_results) {
+        if (distance >= q->hits[q->count - 1].distance)
+            return;
+        q->count--;
+    }
+    size_t i = q->count++;
+    while (i > 0 && q->hits[i - 1].distance > distance) {
+        q->hits[i] = q->hits[i - 1];
+        i--;
     }
+    q->hits[i].entity = entity;
+    q->hits[i].distance = distance;
 }
 
-static void _dbvh_query_pairs(DBVHNode *root, EseArray *pairs, SpatialIndex *index,
-                              EseHashMap *seen) {
-    if (!root || !index || !pairs)
-        return;
-    EseArray *entities = array_create(64, NULL);
-    _dbvh_collect_entities(root, entities);
-    for (size_t i = 0; i < array_size(entities); i++) {
-        EseEntity *a = (EseEntity *)array_get(entities, i);
-        for (size_t j = i + 1; j < array_size(entities); j++) {
-            EseEntity *b = (EseEntity *)array_get(entities, j);
-            // Component-kind prefilter and AABB precheck to prune early
-            if (_pair_is_potential_collision(a, b) && a->collision_world_bounds &&
-                b->collision_world_bounds &&
-                ese_rect_intersects(a->collision_world_bounds, b->collision_world_bounds)) {
-                _emit_pair_if_new(index, seen, pairs, a, b);
+// Distance a new hit must beat to change the result
+static float _query_worst(const SpatialQuery *q) {
+    return q->count == q->max_results ? q->hits[q->count - 1].distance : INFINITY;
+}
+
+static bool _visit_rect(SpatialProxy *p, void *ctx) {
+    SpatialQuery *q = (SpatialQuery *)ctx;
+    const EseCollisionShape *rect = q->rect;
+    if (!_proxy_queryable(p, q->mask) || p->max_x < rect->min_x || p->min_x > rect->max_x ||
+        p->max_y < rect->min_y || p->min_y > rect->max_y) {
+        return true;
+    }
+
+    size_t cursor = 0;
+    const EseCollisionShapeSet *set;
+    while ((set = _next_shape_set(p->entity, &cursor))) {
+        if (collision_shape_set_first_overlap(set, rect, NULL)) {
+            q->entities[q->count++] = p->entity;
+            return q->count < q->max_results;
+        }
+    }
+    return true;
+}
+
+static bool _visit_circle(SpatialProxy *p, void *ctx) {
+    SpatialQuery *q = (SpatialQuery *)ctx;
+    if (!_proxy_queryable(p, q->mask))
+        return true;
+    float ex = fmaxf(fmaxf(p->min_x - q->x, q->x - p->max_x), 0.0f);
+    float ey = fmaxf(fmaxf(p->min_y - q->y, q->y - p->max_y), 0.0f);
+    if (ex * ex + ey * ey > q->radius * q->radius)
+        return true;
+
+    size_t cursor = 0;
+    const EseCollisionShapeSet *set;
+    while ((set = _next_shape_set(p->entity, &cursor))) {
+        for (size_t i = 0; i < set->count; i++) {
+            if (collision_shape_overlaps_circle(&set->shapes[i], q->x, q->y, q->radius)) {
+                q->entities[q->count++] = p->entity;
+                return q->count < q->max_results;
             }
         }
     }
-    int cx = root->region_center_x;
-    int cy = root->region_center_y;
-    if (cx != INT_MIN && cy != INT_MIN) {
-        for (int nx = cx - 2; nx <= cx + 2; nx++) {
-            for (int ny = cy - 2; ny <= cy + 2; ny++) {
-                if (nx >= cx - 1 && nx <= cx + 1 && ny >= cy - 1 && ny <= cy + 1)
-                    continue;
-                SpatialIndexKey nkey = _spatial_index_compute_key(nx, ny);
-                if (int_hashmap_get(index->dbvh_regions, nkey))
-                    continue;
-                EseDoubleLinkedList *neighbor_list =
-                    (EseDoubleLinkedList *)int_hashmap_get(index->bins, nkey);
-                if (!neighbor_list || dlist_size(neighbor_list) == 0)
-                    continue;
-                for (size_t i = 0; i < array_size(entities); i++) {
-                    EseEntity *a = (EseEntity *)array_get(entities, i);
-                    EseDListIter *it = dlist_iter_create(neighbor_list);
-                    void *val;
-                    while (dlist_iter_next(it, &val)) {
-                        EseEntity *b = (EseEntity *)val;
-                        // Component-kind prefilter and AABB precheck
-                        if (_pair_is_potential_collision(a, b) && a->collision_world_bounds &&
-                            b->collision_world_bounds &&
-                            ese_rect_intersects(a->collision_world_bounds,
-                                                b->collision_world_bounds)) {
-                            _emit_pair_if_new(index, seen, pairs, a, b);
-                        }
-                    }
-                    dlist_iter_free(it);
-                }
+    return true;
+}
+
+static bool _visit_ray(SpatialProxy *p, void *ctx) {
+    SpatialQuery *q = (SpatialQuery *)ctx;
+    float t_enter, t_exit;
+    if (!_proxy_queryable(p, q->mask) ||
+        !_ray_box(q, p->min_x, p->min_y, p->max_x, p->max_y, &t_enter, &t_exit) ||
+        t_enter >= _query_worst(q)) {
+        return true;
+    }
+
+    bool hit = false;
+    float best = INFINITY;
+    size_t cursor = 0;
+    const EseCollisionShapeSet *set;
+    while ((set = _next_shape_set(p->entity, &cursor))) {
+        for (size_t i = 0; i < set->count; i++) {
+            float t;
+            if (collision_shape_raycast(&set->shapes[i], q->x, q->y, q->dx, q->dy,
+                                        q->max_distance, &t) &&
+                t < best) {
+                best = t;
+                hit = true;
             }
         }
     }
-    array_destroy(entities);
+    if (hit)
+        _query_insert_hit(q, p->entity, best);
+    return true;
+}
+
+static bool _visit_nearest(SpatialProxy *p, void *ctx) {
+    SpatialQuery *q = (SpatialQuery *)ctx;
+    if (!_proxy_queryable(p, q->mask) || !_entity_has_shapes(p->entity))
+        return true;
+    float dx = _entity_get_x(p->entity) - q->x;
+    float dy = _entity_get_y(p->entity) - q->y;
+    _query_insert_hit(q, p->entity, sqrtf(dx * dx + dy * dy));
+    return true;
+}
+
+static bool _visit_cell(SpatialIndex *index, int cx, int cy, uint32_t stamp, SpatialVisitFn fn,
+                        void *ctx) {
+    SpatialCell *cell =
+        (SpatialCell *)int_hashmap_get(index->cells, _spatial_index_compute_key(cx, cy));
+    if (!cell)
+        return true;
+    for (uint32_t i = 0; i < cell->count; i++) {
+        SpatialProxy *p = &index->proxies[cell->proxies[i]];
+        if (p->query_stamp == stamp)
+            continue;
+        p->query_stamp = stamp;
+        if (!fn(p, ctx))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Fallback for queries that would visit more cells than there are proxies:
+ * hands every proxy in the grid whose fat AABB touches the range to @p fn.
+ */
+static void _visit_all(SpatialIndex *index, float x0, float y0, float x1, float y1,
+                       SpatialVisitFn fn, void *ctx) {
+    profile_count_add("spatial_index_query_scan");
+    for (uint32_t i = 0; i < index->proxy_capacity; i++) {
+        SpatialProxy *p = &index->proxies[i];
+        if (!p->entity || !p->in_grid || p->max_x < x0 || p->min_x > x1 || p->max_y < y0 ||
+            p->min_y > y1) {
+            continue;
+        }
+        if (!fn(p, ctx))
+            return;
+    }
 }
 
-static void _convert_cell_to_dbvh(SpatialIndex *index, int center_x, int center_y) {
-    SpatialIndexKey center_key = _spatial_index_compute_key(center_x, center_y);
-    if (int_hashmap_get(index->dbvh_regions, center_key))
+/**
+ * Hands each proxy stored in the cells covering [x0, x1] x [y0, y1] to @p fn
+ * once, until it returns false.
+ */
+static void _visit_range(SpatialIndex *index, float x0, float y0, float x1, float y1,
+                         SpatialVisitFn fn, void *ctx) {
+    if (!index->has_extent)
+        return;
+    x0 = fmaxf(x0, index->extent_min_x);
+    y0 = fmaxf(y0, index->extent_min_y);
+    x1 = fminf(x1, index->extent_max_x);
+    y1 = fminf(y1, index->extent_max_y);
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    int min_cx = (int)floorf(x0 / index->cell_size);
+    int min_cy = (int)floorf(y0 / index->cell_size);
+    int max_cx = (int)floorf(x1 / index->cell_size);
+    int max_cy = (int)floorf(y1 / index->cell_size);
+    uint64_t cells = (uint64_t)(max_cx - min_cx + 1) * (uint64_t)(max_cy - min_cy + 1);
+    if (cells > index->proxy_count) {
+        _visit_all(index, x0, y0, x1, y1, fn, ctx);
         return;
-    for (int dx = -1; dx <= 1; dx++) {
-        for (int dy = -1; dy <= 1; dy++) {
-            SpatialIndexKey k = _spatial_index_compute_key(center_x + dx, center_y + dy);
-            if (!int_hashmap_get(index->bins, k))
+    }
+
+    uint32_t stamp = _next_query_stamp(index);
+    for (int cx = min_cx; cx <= max_cx; cx++) {
+        for (int cy = min_cy; cy <= max_cy; cy++) {
+            if (!_visit_cell(index, cx, cy, stamp, fn, ctx))
                 return;
         }
     }
-    EseArray *entities = array_create(64, NULL);
-    for (int dx = -1; dx <= 1; dx++) {
-        for (int dy = -1; dy <= 1; dy++) {
-            int cell_x = center_x + dx;
-            int cell_y = center_y + dy;
-            SpatialIndexKey key = _spatial_index_compute_key(cell_x, cell_y);
-            EseDoubleLinkedList *list = (EseDoubleLinkedList *)int_hashmap_get(index->bins, key);
-            if (!list)
-                continue;
-            EseDListIter *it = dlist_iter_create(list);
-            void *val;
-            while (dlist_iter_next(it, &val))
-                array_push(entities, val);
-            dlist_iter_free(it);
+}
+
+/**
+ * Walks the cells along the query ray in order. Every cell after the current
+ * one is entered further along the ray, so the walk stops as soon as the
+ * results can no longer improve.
+ */
+static void _raycast(SpatialIndex *index, SpatialQuery *q) {
+    float t_enter, t_exit;
+    if (!index->has_extent ||
+        !_ray_box(q, index->extent_min_x, index->extent_min_y, index->extent_max_x,
+                  index->extent_max_y, &t_enter, &t_exit)) {
+        return;
+    }
+
+    const float cell_size = index->cell_size;
+    float span = (t_exit - t_enter) * (fabsf(q->dx) + fabsf(q->dy)) / cell_size + 2.0f;
+    if (span > (float)index->proxy_count) {
+        _visit_all(index, index->extent_min_x, index->extent_min_y, index->extent_max_x,
+                   index->extent_max_y, _visit_ray, q);
+        return;
+    }
+
+    int cx = (int)floorf((q->x + q->dx * t_enter) / cell_size);
+    int cy = (int)floorf((q->y + q->dy * t_enter) / cell_size);
+    int step_x = q->dx > 0.0f ? 1 : -1;
+    int step_y = q->dy > 0.0f ? 1 : -1;
+    float t_next_x = INFINITY, t_delta_x = INFINITY;
+    float t_next_y = INFINITY, t_delta_y = INFINITY;
+    if (q->dx != 0.0f) {
+        t_next_x = ((float)(cx + (step_x > 0)) * cell_size - q->x) / q->dx;
+        t_delta_x = cell_size / fabsf(q->dx);
+    }
+    if (q->dy != 0.0f) {
+        t_next_y = ((float)(cy + (step_y > 0)) * cell_size - q->y) / q->dy;
+        t_delta_y = cell_size / fabsf(q->dy);
+    }
+
+    uint32_t stamp = _next_query_stamp(index);
+    for (;;) {
+        _visit_cell(index, cx, cy, stamp, _visit_ray, q);
+        float t_cell_exit = fminf(t_next_x, t_next_y);
+        if (t_cell_exit > t_exit || _query_worst(q) <= t_cell_exit)
+            return;
+        if (t_next_x < t_next_y) {
+            cx += step_x;
+            t_next_x += t_delta_x;
+        } else {
+            cy += step_y;
+            t_next_y += t_delta_y;
         }
     }
-    if (array_size(entities) == 0) {
-        array_destroy(entities);
+}
+
+/**
+ * Visits rings of cells around the query point. Proxies not seen after ring
+ * r - 1 have fat AABBs outside that square, so their positions are at least
+ * its distance minus the position slack away.
+ */
+static void _query_nearest(SpatialIndex *index, SpatialQuery *q) {
+    if (!index->has_extent)
+        return;
+
+    const float cell_size = index->cell_size;
+    int ex0 = (int)floorf(index->extent_min_x / cell_size);
+    int ey0 = (int)floorf(index->extent_min_y / cell_size);
+    int ex1 = (int)floorf(index->extent_max_x / cell_size);
+    int ey1 = (int)floorf(index->extent_max_y / cell_size);
+    uint64_t cells = (uint64_t)(ex1 - ex0 + 1) * (uint64_t)(ey1 - ey0 + 1);
+    if (cells > index->proxy_count) {
+        _visit_all(index, index->extent_min_x, index->extent_min_y, index->extent_max_x,
+                   index->extent_max_y, _visit_nearest, q);
         return;
     }
-    DBVHNode *root = NULL;
-    for (size_t i = 0; i < array_size(entities); i++) {
-        EseEntity *e = (EseEntity *)array_get(entities, i);
-        root = _dbvh_insert(root, e);
-    }
-    if (root) {
-        root->region_center_x = center_x;
-        root->region_center_y = center_y;
-        for (int dx = -1; dx <= 1; dx++) {
-            for (int dy = -1; dy <= 1; dy++) {
-                SpatialIndexKey k = _spatial_index_compute_key(center_x + dx, center_y + dy);
-                EseDoubleLinkedList *removed =
-                    (EseDoubleLinkedList *)int_hashmap_remove(index->bins, k);
-                if (removed) {
-                    dlist_free(removed);
+
+    int qcx = (int)floorf(q->x / cell_size);
+    int qcy = (int)floorf(q->y / cell_size);
+    // Rings that do not reach the extent are empty
+    int first = qcx < ex0 ? ex0 - qcx : (qcx > ex1 ? qcx - ex1 : 0);
+    int first_y = qcy < ey0 ? ey0 - qcy : (qcy > ey1 ? qcy - ey1 : 0);
+    first = first > first_y ? first : first_y;
+    int rings = qcx - ex0;
+    rings = rings > ex1 - qcx ? rings : ex1 - qcx;
+    rings = rings > qcy - ey0 ? rings : qcy - ey0;
+    rings = rings > ey1 - qcy ? rings : ey1 - qcy;
+
+    uint32_t stamp = _next_query_stamp(index);
+    for (int r = first; r <= rings; r++) {
+        if (r > 0) {
+            float reach = fminf(fminf(q->x - (float)(qcx - r + 1) * cell_size,
+                                      (float)(qcx + r) * cell_size - q->x),
+                                fminf(q->y - (float)(qcy - r + 1) * cell_size,
+                                      (float)(qcy + r) * cell_size - q->y));
+            if (_query_worst(q) <= reach - index->position_slack)
+                return;
+        }
+
+        int x_lo = qcx - r > ex0 ? qcx - r : ex0;
+        int x_hi = qcx + r < ex1 ? qcx + r : ex1;
+        int y_lo = qcy - r > ey0 ? qcy - r : ey0;
+        int y_hi = qcy + r < ey1 ? qcy + r : ey1;
+        for (int cy = y_lo; cy <= y_hi; cy++) {
+            if (cy == qcy - r || cy == qcy + r) {
+                for (int cx = x_lo; cx <= x_hi; cx++) {
+                    _visit_cell(index, cx, cy, stamp, _visit_nearest, q);
                 }
+                continue;
             }
+            if (qcx - r >= ex0)
+                _visit_cell(index, qcx - r, cy, stamp, _visit_nearest, q);
+            if (qcx + r <= ex1)
+                _visit_cell(index, qcx + r, cy, stamp, _visit_nearest, q);
         }
-        int_hashmap_set(index->dbvh_regions, center_key, root);
-        log_debug("SPATIAL_INDEX", "Converted 3x3 centered (%d,%d) to DBVH with %zu entities",
-                  center_x, center_y, array_size(entities));
     }
-    array_destroy(entities);
+}
+
+/**
+ * Normalizes the query ray; returns false for rays that cannot hit anything.
+ */
+static bool _query_set_ray(SpatialQuery *q, float dx, float dy, float max_distance) {
+    float length = sqrtf(dx * dx + dy * dy);
+    if (length <= 0.0f || !(max_distance > 0.0f))
+        return false;
+    q->dx = dx / length;
+    q->dy = dy / length;
+    q->max_distance = max_distance;
+    return true;
 }
 
 SpatialIndex *spatial_index_create(void) {
     SpatialIndex *index = memory_manager.malloc(sizeof(SpatialIndex), MMTAG_COLLISION_INDEX);
     index->cell_size = SPATIAL_INDEX_DEFAULT_CELL_SIZE;
-    index->bins = int_hashmap_create((EseIntHashMapFreeFn)dlist_free);
-    index->dbvh_regions = int_hashmap_create((EseIntHashMapFreeFn)_dbvh_node_destroy);
-    index->pairs = array_create(128, _free_spatial_pair);
+    index->cells = int_hashmap_create(_spatial_cell_free);
+    index->proxy_capacity = SPATIAL_INDEX_INITIAL_PROXIES;
+    index->proxies = memory_manager.calloc(index->proxy_capacity, sizeof(SpatialProxy),
+                                           MMTAG_COLLISION_INDEX);
+    index->proxy_count = 0;
+    index->free_head = SPATIAL_INDEX_NULL_PROXY;
+    for (uint32_t i = index->proxy_capacity; i-- > 0;) {
+        index->proxies[i].next_free = index->free_head;
+        index->free_head = i;
+    }
+    _pair_set_init(&index->pair_set, SPATIAL_INDEX_INITIAL_PAIR_SET_BITS);
+    index->pair_capacity = SPATIAL_INDEX_INITIAL_PAIRS;
+    index->pair_count = 0;
+    index->pairs =
+        memory_manager.malloc(sizeof(SpatialPair) * index->pair_capacity, MMTAG_COLLISION_INDEX);
     index->last_auto_tune_time = 0.0;
+    index->query_stamp = 0;
+    index->sleep_frames = SPATIAL_INDEX_DEFAULT_SLEEP_FRAMES;
+    _extent_reset(index);
     return index;
 }
 
 void spatial_index_destroy(SpatialIndex *index) {
     log_assert("SPATIAL_INDEX", index, "destroy called with NULL index");
-    int_hashmap_destroy(index->bins);
-    int_hashmap_destroy(index->dbvh_regions);
-    array_destroy(index->pairs);
+    spatial_index_clear(index);
+    int_hashmap_destroy(index->cells);
+    memory_manager.free(index->proxies);
+    _pair_set_free(&index->pair_set);
+    memory_manager.free(index->pairs);
     memory_manager.free(index);
 }
 
 void spatial_index_clear(SpatialIndex *index) {
     log_assert("SPATIAL_INDEX", index, "clear called with NULL index");
-    int_hashmap_clear(index->bins);
-    int_hashmap_clear(index->dbvh_regions);
-    array_clear(index->pairs);
+    for (uint32_t i = 0; i < index->proxy_capacity; i++) {
+        if (index->proxies[i].entity) {
+            _free_proxy_slot(index, i);
+        }
+    }
+    int_hashmap_clear(index->cells);
+    _pair_set_clear(&index->pair_set);
+    index->pair_count = 0;
+    _extent_reset(index);
 }
 
-void spatial_index_insert(SpatialIndex *index, EseEntity *entity) {
-    log_assert("SPATIAL_INDEX", index, "insert called with NULL index");
-    log_assert("SPATIAL_INDEX", entity, "insert called with NULL entity");
-    if (!entity->active)
+void spatial_index_register(SpatialIndex *index, EseEntity *entity) {
+    log_assert("SPATIAL_INDEX", index, "register called with NULL index");
+    log_assert("SPATIAL_INDEX", entity, "register called with NULL entity");
+
+    if (entity->spatial_proxy != SPATIAL_INDEX_NULL_PROXY) {
+        index->proxies[entity->spatial_proxy].refs++;
+        index->proxies[entity->spatial_proxy].wake = true;
         return;
-    if (!entity->collision_world_bounds)
+    }
+
+    if (index->free_head == SPATIAL_INDEX_NULL_PROXY) {
+        uint32_t old_capacity = index->proxy_capacity;
+        index->proxy_capacity *= 2;
+        index->proxies = memory_manager.realloc(
+            index->proxies, sizeof(SpatialProxy) * index->proxy_capacity, MMTAG_COLLISION_INDEX);
+        memset(&index->proxies[old_capacity], 0,
+               sizeof(SpatialProxy) * (index->proxy_capacity - old_capacity));
+        for (uint32_t i = index->proxy_capacity; i-- > old_capacity;) {
+            index->proxies[i].next_free = index->free_head;
+            index->free_head = i;
+        }
+    }
+
+    uint32_t proxy_id = index->free_head;
+    SpatialProxy *p = &index->proxies[proxy_id];
+    index->free_head = p->next_free;
+    index->proxy_count++;
+
+    p->entity = entity;
+    p->refs = 1;
+    p->filter = COLLISION_FILTER_ALL;
+    p->query_stamp = 0;
+    p->still_frames = 0;
+    p->in_grid = false;
+    p->is_static = false;
+    p->resting = false;
+    p->wake = false;
+    p->next_free = SPATIAL_INDEX_NULL_PROXY;
+    entity->spatial_proxy = proxy_id;
+}
+
+void spatial_index_unregister(SpatialIndex *index, EseEntity *entity) {
+    log_assert("SPATIAL_INDEX", index, "unregister called with NULL index");
+    log_assert("SPATIAL_INDEX", entity, "unregister called with NULL entity");
+
+    uint32_t proxy_id = entity->spatial_proxy;
+    if (proxy_id == SPATIAL_INDEX_NULL_PROXY)
         return;
-    EseRect *bounds = entity->collision_world_bounds;
-    float x0 = ese_rect_get_x(bounds);
-    float y0 = ese_rect_get_y(bounds);
-    float x1 = x0 + ese_rect_get_width(bounds);
-    float y1 = y0 + ese_rect_get_height(bounds);
-    int min_cell_x = (int)floorf(x0 / index->cell_size);
-    int min_cell_y = (int)floorf(y0 / index->cell_size);
-    int max_cell_x = (int)floorf((x1) / index->cell_size);
-    int max_cell_y = (int)floorf((y1) / index->cell_size);
-    for (int cx = min_cell_x; cx <= max_cell_x; cx++) {
-        for (int cy = min_cell_y; cy <= max_cell_y; cy++) {
-            SpatialIndexKey key = _spatial_index_compute_key(cx, cy);
-            if (int_hashmap_get(index->dbvh_regions, key))
-                continue;
-            EseDoubleLinkedList *list = (EseDoubleLinkedList *)int_hashmap_get(index->bins, key);
-            if (!list) {
-                list = dlist_create(NULL);
-                int_hashmap_set(index->bins, key, list);
-            }
-            dlist_append(list, entity);
-            profile_count_add("spatial_index_entity_cell_insert");
+    if (--index->proxies[proxy_id].refs == 0) {
+        _free_proxy_slot(index, proxy_id);
+    } else {
+        // Contacts remembered for the entity may point at the removed component
+        index->proxies[proxy_id].wake = true;
+    }
+}
+
+void spatial_index_update(SpatialIndex *index) {
+    log_assert("SPATIAL_INDEX", index, "update called with NULL index");
+    profile_start(PROFILE_SPATIAL_INDEX_SECTION);
+
+    _extent_reset(index);
+    for (uint32_t i = 0; i < index->proxy_capacity; i++) {
+        SpatialProxy *p = &index->proxies[i];
+        if (!p->entity)
+            continue;
+
+        // Positions written since the last update only marked the transform dirty
+        _entity_sync_transform(p->entity);
+
+        float x0, y0, x1, y1;
+        if (!p->entity->active || !_entity_tight_bounds(p->entity, &x0, &y0, &x1, &y1)) {
+            _proxy_remove_cells(index, i);
+            p->still_frames = 0;
+            p->resting = false;
+            p->entity->collision_resting = false;
+            continue;
+        }
+
+        bool changed = !p->in_grid || p->wake || x0 != p->x0 || y0 != p->y0 || x1 != p->x1 ||
+                       y1 != p->y1 || p->filter != p->entity->collision_filter ||
+                       p->is_static != p->entity->collision_static;
+        p->wake = false;
+        p->still_frames = changed ? 0 : p->still_frames + (p->still_frames < UINT32_MAX);
+        p->is_static = p->entity->collision_static;
+        p->resting = p->is_static ? !changed
+                                  : index->sleep_frames > 0 && p->still_frames >= index->sleep_frames;
+        p->entity->collision_resting = p->resting;
+        if (p->resting) {
+            _extent_add(index, p);
+            continue;
         }
+
+        p->x0 = x0;
+        p->y0 = y0;
+        p->x1 = x1;
+        p->y1 = y1;
+        p->filter = p->entity->collision_filter;
+        if (!p->in_grid || x0 < p->min_x || y0 < p->min_y || x1 > p->max_x || y1 > p->max_y) {
+            _proxy_refit(index, i, x0, y0, x1, y1);
+        }
+        _extent_add(index, p);
     }
+
     double now = time_now_seconds();
     if (now - index->last_auto_tune_time >= SPATIAL_INDEX_AUTO_TUNE_COOLDOWN_SECONDS) {
         float avg = _calculate_average_bin_count(index);
         if (avg > SPATIAL_INDEX_AUTO_TUNE_THRESHOLD) {
             spatial_index_auto_tune(index);
-            index->last_auto_tune_time = now;
         }
+        index->last_auto_tune_time = now;
     }
+
+    profile_stop(PROFILE_SPATIAL_INDEX_SECTION, "spatial_index_update");
+}
+
+void spatial_index_set_sleep_frames(SpatialIndex *index, uint32_t frames) {
+    log_assert("SPATIAL_INDEX", index, "set_sleep_frames called with NULL index");
+    index->sleep_frames = frames;
+}
+
+size_t spatial_index_get_count(const SpatialIndex *index) {
+    log_assert("SPATIAL_INDEX", index, "get_count called with NULL index");
+    return index->proxy_count;
 }
 
 void spatial_index_auto_tune(SpatialIndex *index) {
     log_assert("SPATIAL_INDEX", index, "auto_tune called with NULL index");
     float total = 0.0f;
     size_t samples = 0;
-    EseIntHashMapIter *iter = int_hashmap_iter_create(index->bins);
-    uint64_t key;
-    void *value;
-    while (int_hashmap_iter_next(iter, &key, &value)) {
-        EseDoubleLinkedList *list = (EseDoubleLinkedList *)value;
-        if (dlist_size(list) > 0) {
-            EseDListIter *it = dlist_iter_create(list);
-            void *val;
-            if (dlist_iter_next(it, &val)) {
-                EseEntity *e = (EseEntity *)val;
-                if (e->collision_world_bounds) {
-                    EseRect *r = e->collision_world_bounds;
-                    float diag = sqrtf(ese_rect_get_width(r) * ese_rect_get_width(r) +
-                                       ese_rect_get_height(r) * ese_rect_get_height(r));
-                    total += diag;
-                    samples++;
-                }
-            }
-            dlist_iter_free(it);
-        }
+    for (uint32_t i = 0; i < index->proxy_capacity; i++) {
+        SpatialProxy *p = &index->proxies[i];
+        if (!p->entity || !p->in_grid)
+            continue;
+        float w = p->max_x - p->min_x - 2.0f * SPATIAL_INDEX_FAT_MARGIN;
+        float h = p->max_y - p->min_y - 2.0f * SPATIAL_INDEX_FAT_MARGIN;
+        total += sqrtf(w * w + h * h);
+        samples++;
     }
-    int_hashmap_iter_free(iter);
-    if (samples == 0) {
-        index->cell_size = SPATIAL_INDEX_DEFAULT_CELL_SIZE;
+
+    float new_size = SPATIAL_INDEX_DEFAULT_CELL_SIZE;
+    float avg = 0.0f;
+    if (samples > 0) {
+        avg = total / (float)samples;
+        new_size = fmaxf(32.0f, avg * 2.0f);
+    }
+    if (new_size == index->cell_size)
         return;
+
+    // Cell coordinates depend on the cell size, so every proxy is re-bucketed
+    for (uint32_t i = 0; i < index->proxy_capacity; i++) {
+        _proxy_remove_cells(index, i);
     }
-    float avg = total / (float)samples;
-    float new_size = fmaxf(32.0f, avg * 2.0f);
     index->cell_size = new_size;
+    _extent_reset(index);
+    for (uint32_t i = 0; i < index->proxy_capacity; i++) {
+        SpatialProxy *p = &index->proxies[i];
+        float x0, y0, x1, y1;
+        if (p->entity && p->entity->active &&
+            _entity_tight_bounds(p->entity, &x0, &y0, &x1, &y1)) {
+            _proxy_refit(index, i, x0, y0, x1, y1);
+            _extent_add(index, p);
+        }
+    }
     log_debug("SPATIAL_INDEX", "Auto-tuned cell_size to %f based on %zu samples (avg diag: %f)",
               new_size, samples, avg);
 }
 
-EseArray *spatial_index_get_pairs(SpatialIndex *index) {
+size_t spatial_index_get_pairs(SpatialIndex *index, const SpatialPair **out_pairs) {
     log_assert("SPATIAL_INDEX", index, "get_pairs called with NULL index");
+    log_assert("SPATIAL_INDEX", out_pairs, "get_pairs called with NULL out_pairs");
     profile_start(PROFILE_SPATIAL_INDEX_SECTION);
-    array_clear(index->pairs);
-
-    EseIntHashMapIter *bin_iter = int_hashmap_iter_create(index->bins);
-    uint64_t bin_key;
-    void *bin_value;
-    while (int_hashmap_iter_next(bin_iter, &bin_key, &bin_value)) {
-        EseDoubleLinkedList *cell_list = (EseDoubleLinkedList *)bin_value;
-        size_t sz = dlist_size(cell_list);
-        if (sz > SPATIAL_INDEX_DBVH_THRESHOLD) {
-            uint32_t ux = (uint32_t)(bin_key >> 32);
-            uint32_t uy = (uint32_t)(bin_key & 0xFFFFFFFFu);
-            int cell_x = (int)(int32_t)ux;
-            int cell_y = (int)(int32_t)uy;
-            _convert_cell_to_dbvh(index, cell_x, cell_y);
-        }
-    }
-    int_hashmap_iter_free(bin_iter);
-
-    EseHashMap *seen = hashmap_create(NULL);
-    EseIntHashMapIter *dbvh_iter = int_hashmap_iter_create(index->dbvh_regions);
-    uint64_t dbvh_key;
-    void *dbvh_value;
-    while (int_hashmap_iter_next(dbvh_iter, &dbvh_key, &dbvh_value)) {
-        DBVHNode *root = (DBVHNode *)dbvh_value;
-        _dbvh_query_pairs(root, index->pairs, index, seen);
-    }
-    int_hashmap_iter_free(dbvh_iter);
+    index->pair_count = 0;
+    _pair_set_clear(&index->pair_set);
 
-    bin_iter = int_hashmap_iter_create(index->bins);
-    while (int_hashmap_iter_next(bin_iter, &bin_key, &bin_value)) {
-        EseDoubleLinkedList *cell_list = (EseDoubleLinkedList *)bin_value;
-        if (!cell_list || dlist_size(cell_list) == 0)
+    EseIntHashMapIter *cell_iter = int_hashmap_iter_create(index->cells);
+    uint64_t cell_key;
+    void *cell_value;
+    while (int_hashmap_iter_next(cell_iter, &cell_key, &cell_value)) {
+        SpatialCell *cell = (SpatialCell *)cell_value;
+        if (cell->count < 2)
             continue;
-        uint32_t ux = (uint32_t)(bin_key >> 32);
-        uint32_t uy = (uint32_t)(bin_key & 0xFFFFFFFFu);
-        int cell_x = (int)(int32_t)ux;
-        int cell_y = (int)(int32_t)uy;
-        if (dlist_size(cell_list) >= 2) {
-            void *a_val;
-            EseDListIter *outer = dlist_iter_create(cell_list);
-            while (dlist_iter_next(outer, &a_val)) {
-                EseEntity *a = (EseEntity *)a_val;
-                EseDListIter *inner = dlist_iter_create_from(outer);
-                void *b_val;
-                while (dlist_iter_next(inner, &b_val)) {
-                    EseEntity *b = (EseEntity *)b_val;
-                    // AABB precheck to prune non-overlapping pairs early
-                    if (a->collision_world_bounds && b->collision_world_bounds &&
-                        ese_rect_intersects(a->collision_world_bounds, b->collision_world_bounds)) {
-                        _emit_pair_if_new(index, seen, index->pairs, a, b);
-                    }
-                }
-                dlist_iter_free(inner);
-            }
-            dlist_iter_free(outer);
-        }
-        for (int dx = -1; dx <= 1; dx++) {
-            for (int dy = -1; dy <= 1; dy++) {
-                if (dx == 0 && dy == 0)
+        // Each awake proxy is paired with every other proxy in the cell, so
+        // resting/resting pairs are never formed and a cell of resting
+        // proxies costs one pass
+        for (uint32_t i = 0; i < cell->count; i++) {
+            const SpatialProxy *pa = &index->proxies[cell->proxies[i]];
+            if (pa->resting)
+                continue;
+            for (uint32_t j = 0; j < cell->count; j++) {
+                const SpatialProxy *pb = &index->proxies[cell->proxies[j]];
+                // An awake/awake pair is formed from its lower index only
+                if (j == i || (j < i && !pb->resting))
                     continue;
-                int nx = cell_x + dx;
-                int ny = cell_y + dy;
-                SpatialIndexKey nkey = _spatial_index_compute_key(nx, ny);
-                if (nkey <= bin_key)
+                // Layer/mask filter, cached AABB precheck, then skip pairs
+                // already tested in another shared cell
+                if (!collision_filter_accepts(pa->filter, pb->filter))
                     continue;
-                if (int_hashmap_get(index->dbvh_regions, nkey))
+                if (pa->x1 < pb->x0 || pb->x1 < pa->x0 || pa->y1 < pb->y0 || pb->y1 < pa->y0)
                     continue;
-                EseDoubleLinkedList *neighbor_list =
-                    (EseDoubleLinkedList *)int_hashmap_get(index->bins, nkey);
-                if (!neighbor_list || dlist_size(neighbor_list) == 0)
+                uint64_t key = _spatial_pair_key(cell->proxies[i], cell->proxies[j]);
+                if (!_pair_set_insert(&index->pair_set, key))
                     continue;
-                EseDListIter *cell_it = dlist_iter_create(cell_list);
-                void *c_val;
-                while (dlist_iter_next(cell_it, &c_val)) {
-                    EseEntity *c = (EseEntity *)c_val;
-                    EseDListIter *neigh_it = dlist_iter_create(neighbor_list);
-                    void *n_val;
-                    while (dlist_iter_next(neigh_it, &n_val)) {
-                        EseEntity *n = (EseEntity *)n_val;
-                        // Component-kind prefilter and AABB precheck
-                        if (_pair_is_potential_collision(c, n) && c->collision_world_bounds &&
-                            n->collision_world_bounds &&
-                            ese_rect_intersects(c->collision_world_bounds,
-                                                n->collision_world_bounds)) {
-                            _emit_pair_if_new(index, seen, index->pairs, c, n);
-                            profile_count_add("spatial_index_pair_emitted");
-                        }
-                    }
-                    dlist_iter_free(neigh_it);
+
+                // Component-kind prefilter and exact (rotated) rect test
+                EseEntity *a = pa->entity;
+                EseEntity *b = pb->entity;
+                if (_pair_is_potential_collision(a, b) && a->collision_world_bounds &&
+                    b->collision_world_bounds &&
+                    ese_rect_intersects(a->collision_world_bounds, b->collision_world_bounds)) {
+                    _emit_pair(index, key);
+                    profile_count_add("spatial_index_pair_emitted");
                 }
-                dlist_iter_free(cell_it);
             }
         }
     }
-    int_hashmap_iter_free(bin_iter);
-    hashmap_destroy(seen);
+    int_hashmap_iter_free(cell_iter);
     profile_stop(PROFILE_SPATIAL_INDEX_SECTION, "spatial_index_get_pairs");
-    return index->pairs;
+    *out_pairs = index->pairs;
+    return index->pair_count;
+}
+
+size_t spatial_index_query_rect(SpatialIndex *index, const EseCollisionShape *rect, uint16_t mask,
+                                EseEntity **out, size_t max_results) {
+    log_assert("SPATIAL_INDEX", index, "query_rect called with NULL index");
+    log_assert("SPATIAL_INDEX", rect, "query_rect called with NULL rect");
+    log_assert("SPATIAL_INDEX", out || max_results == 0, "query_rect called with NULL out");
+    if (max_results == 0)
+        return 0;
+
+    profile_start(PROFILE_SPATIAL_INDEX_SECTION);
+    SpatialQuery q = {.mask = mask, .rect = rect, .entities = out, .max_results = max_results};
+    _visit_range(index, rect->min_x, rect->min_y, rect->max_x, rect->max_y, _visit_rect, &q);
+    profile_stop(PROFILE_SPATIAL_INDEX_SECTION, "spatial_index_query_rect");
+    return q.count;
+}
+
+size_t spatial_index_query_circle(SpatialIndex *index, float x, float y, float radius,
+                                  uint16_t mask, EseEntity **out, size_t max_results) {
+    log_assert("SPATIAL_INDEX", index, "query_circle called with NULL index");
+    log_assert("SPATIAL_INDEX", out || max_results == 0, "query_circle called with NULL out");
+    if (max_results == 0 || !(radius >= 0.0f))
+        return 0;
+
+    profile_start(PROFILE_SPATIAL_INDEX_SECTION);
+    SpatialQuery q = {
+        .mask = mask, .x = x, .y = y, .radius = radius, .entities = out, .max_results = max_results};
+    _visit_range(index, x - radius, y - radius, x + radius, y + radius, _visit_circle, &q);
+    profile_stop(PROFILE_SPATIAL_INDEX_SECTION, "spatial_index_query_circle");
+    return q.count;
+}
+
+bool spatial_index_raycast(SpatialIndex *index, float x, float y, float dx, float dy,
+                           float max_distance, uint16_t mask, SpatialQueryHit *out_hit) {
+    log_assert("SPATIAL_INDEX", index, "raycast called with NULL index");
+    log_assert("SPATIAL_INDEX", out_hit, "raycast called with NULL out_hit");
+    return spatial_index_raycast_all(index, x, y, dx, dy, max_distance, mask, out_hit, 1) > 0;
+}
+
+size_t spatial_index_raycast_all(SpatialIndex *index, float x, float y, float dx, float dy,
+                                 float max_distance, uint16_t mask, SpatialQueryHit *out,
+                                 size_t max_results) {
+    log_assert("SPATIAL_INDEX", index, "raycast_all called with NULL index");
+    log_assert("SPATIAL_INDEX", out || max_results == 0, "raycast_all called with NULL out");
+    SpatialQuery q = {.mask = mask, .x = x, .y = y, .hits = out, .max_results = max_results};
+    if (max_results == 0 || !_query_set_ray(&q, dx, dy, max_distance))
+        return 0;
+
+    profile_start(PROFILE_SPATIAL_INDEX_SECTION);
+    _raycast(index, &q);
+    profile_stop(PROFILE_SPATIAL_INDEX_SECTION, "spatial_index_raycast");
+    return q.count;
+}
+
+size_t spatial_index_query_nearest(SpatialIndex *index, float x, float y, uint16_t mask,
+                                   SpatialQueryHit *out, size_t k) {
+    log_assert("SPATIAL_INDEX", index, "query_nearest called with NULL index");
+    log_assert("SPATIAL_INDEX", out || k == 0, "query_nearest called with NULL out");
+    if (k == 0)
+        return 0;
+
+    profile_start(PROFILE_SPATIAL_INDEX_SECTION);
+    SpatialQuery q = {.mask = mask, .x = x, .y = y, .hits = out, .max_results = k};
+    _query_nearest(index, &q);
+    profile_stop(PROFILE_SPATIAL_INDEX_SECTION, "spatial_index_query_nearest");
+    return q.count;
 }
@@ -1,35 +1,99 @@
 #ifndef ESE_SPATIAL_INDEX_H
 #define ESE_SPATIAL_INDEX_H
 
-#include "utility/array.h"
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 // Forward declarations to avoid pulling heavy headers into the public API
 typedef struct EseEntity EseEntity;
+typedef struct EseCollisionShape EseCollisionShape;
 
 // Opaque spatial index type
 typedef struct SpatialIndex SpatialIndex;
 
-// Canonical, unordered pair of entities produced by the spatial phase
+// Proxy id stored on an entity that is not registered with any index
+#define SPATIAL_INDEX_NULL_PROXY UINT32_MAX
+
+// Canonical, unordered pair of entities produced by the spatial phase.
+// `a` belongs to the lower proxy id; `key` packs (lower << 32) | higher.
 typedef struct SpatialPair {
     EseEntity *a;
     EseEntity *b;
+    uint64_t key;
 } SpatialPair;
 
+// Entity found by a ray or nearest query with its distance from the query
+// origin. Ray hits measure to the entry point (0 when the origin is inside);
+// nearest hits measure to the entity position.
+typedef struct SpatialQueryHit {
+    EseEntity *entity;
+    float distance;
+} SpatialQueryHit;
+
 // Lifecycle
 SpatialIndex *spatial_index_create(void);
 void spatial_index_destroy(SpatialIndex *index);
+
+// Drop every registered entity
 void spatial_index_clear(SpatialIndex *index);
 
-// Insert entities before pair generation
-void spatial_index_insert(SpatialIndex *index, EseEntity *entity);
+// Persistent registration. An entity is registered once per owning component
+// (collider or map) and stays in the index until the last one unregisters.
+void spatial_index_register(SpatialIndex *index, EseEntity *entity);
+void spatial_index_unregister(SpatialIndex *index, EseEntity *entity);
+
+// Re-sync registered entities with their collision_world_bounds. Only entities
+// whose bounds left their fat AABB are moved between grid cells. Also decides
+// which entities rest (entity collision_resting): static colliders that did
+// not change since the last update, and others unchanged for the sleep delay.
+void spatial_index_update(SpatialIndex *index);
+
+// Unchanged updates after which a dynamic entity falls asleep (default 30);
+// 0 keeps dynamic entities awake. Pairs of resting entities are not generated.
+void spatial_index_set_sleep_frames(SpatialIndex *index, uint32_t frames);
+
+// Number of registered entities
+size_t spatial_index_get_count(const SpatialIndex *index);
 
 // Optional tuning hook
 void spatial_index_auto_tune(SpatialIndex *index);
 
-// Generate canonical, deduplicated unordered pairs (SpatialPair*)
-// The returned EseArray is owned by the index and must not be freed by the
-// caller.
-EseArray *spatial_index_get_pairs(SpatialIndex *index);
+// Generate canonical, deduplicated unordered pairs, leaving out pairs whose
+// entities both rest. `*out_pairs` points at a contiguous array owned by the
+// index that stays valid until the next call. Returns the number of pairs.
+size_t spatial_index_get_pairs(SpatialIndex *index, const SpatialPair **out_pairs);
+
+// Queries. Candidates come from the grid cells as of the last
+// spatial_index_update and are then tested against their colliders' current
+// world shapes, so only active entities with a collider are returned. An
+// entity that moved past its fat margin since the last update can be missed
+// until the next one. `mask` selects collider layers (COLLIDER_MASK_ALL for
+// any). Results are written to the caller's buffer and the number written is
+// returned; none of the queries allocate.
+
+// Entities overlapping `rect`, a world-space shape (see collision_shape_from_rect),
+// in no particular order.
+size_t spatial_index_query_rect(SpatialIndex *index, const EseCollisionShape *rect, uint16_t mask,
+                                EseEntity **out, size_t max_results);
+
+// Entities overlapping the circle at (x, y), in no particular order.
+size_t spatial_index_query_circle(SpatialIndex *index, float x, float y, float radius,
+                                  uint16_t mask, EseEntity **out, size_t max_results);
+
+// Closest entity hit by the ray from (x, y) along (dx, dy), which need not be
+// normalized, within max_distance. Returns false when nothing is hit.
+bool spatial_index_raycast(SpatialIndex *index, float x, float y, float dx, float dy,
+                           float max_distance, uint16_t mask, SpatialQueryHit *out_hit);
+
+// Every entity hit by the ray, nearest first. When more than max_results are
+// hit the nearest ones are kept.
+size_t spatial_index_raycast_all(SpatialIndex *index, float x, float y, float dx, float dy,
+                                 float max_distance, uint16_t mask, SpatialQueryHit *out,
+                                 size_t max_results);
+
+// The k entities whose positions are nearest to (x, y), nearest first.
+size_t spatial_index_query_nearest(SpatialIndex *index, float x, float y, uint16_t mask,
+                                   SpatialQueryHit *out, size_t k);
 
 #endif // ESE_SPATIAL_INDEX_H
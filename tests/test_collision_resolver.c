@@ -0,0 +1,161 @@
+/*
+ * test_collision_resolver.c - Unity-based tests for core/collision_resolver
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "testing.h"
+
+#include "../src/core/collision_resolver.h"
+#include "../src/core/engine.h"
+#include "../src/core/engine_private.h"
+#include "../src/core/memory_manager.h"
+#include "../src/entity/components/collider.h"
+#include "../src/entity/components/entity_component.h"
+#include "../src/entity/entity.h"
+#include "../src/entity/entity_private.h"
+#include "../src/types/collision_hit.h"
+#include "../src/types/rect.h"
+#include "../src/utility/array.h"
+#include "../src/utility/job_queue.h"
+#include "../src/utility/log.h"
+#include "../src/utility/spatial_index.h"
+
+/**
+ * Test Functions Declarations
+ */
+static void test_collision_resolver_parallel_matches_serial(void);
+static void test_collision_resolver_hits_follow_pair_key_order(void);
+
+/**
+ * Test suite setup and teardown
+ */
+static EseEngine *g_engine = NULL;
+
+void setUp(void) { g_engine = engine_create(NULL); }
+
+void tearDown(void) {
+    if (g_engine) {
+        engine_destroy(g_engine);
+        g_engine = NULL;
+    }
+}
+
+/**
+ * Helpers
+ */
+static EseEntity *make_collider(float x, float y, float size) {
+    EseLuaEngine *lua = g_engine->lua_engine;
+    EseEntity *entity = entity_create(lua);
+    EseEntityComponent *collider = entity_component_collider_create(lua);
+    entity_component_add(entity, collider);
+
+    EseRect *rect = ese_rect_create(lua);
+    ese_rect_set_width(rect, size);
+    ese_rect_set_height(rect, size);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+
+    entity_set_position(entity, x, y);
+    engine_add_entity(g_engine, entity);
+    return entity;
+}
+
+// Anchor/partner pairs laid out on a grid; every fourth partner is placed clear
+// of its anchor on odd steps so both hits and misses occur
+static void place_pairs(EseEntity **partners, int count, int step) {
+    for (int i = 0; i < count; i++) {
+        float x = (float)(i % 40) * 64.0f;
+        float y = (float)(i / 40) * 64.0f;
+        float offset = (i % 4 == 0 && (step & 1)) ? 32.0f : 8.0f;
+        entity_set_position(partners[i], x + offset, y);
+    }
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    log_init();
+
+    printf("\nCollisionResolver Tests\n");
+    printf("-----------------------\n");
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_collision_resolver_parallel_matches_serial);
+    RUN_TEST(test_collision_resolver_hits_follow_pair_key_order);
+
+    return UNITY_END();
+}
+
+/**
+ * Test Functions
+ */
+
+static void test_collision_resolver_parallel_matches_serial(void) {
+    enum { COUNT = 1200 };
+    EseEntity **partners = memory_manager.malloc(sizeof(EseEntity *) * COUNT, MMTAG_TEMP);
+    for (int i = 0; i < COUNT; i++) {
+        make_collider((float)(i % 40) * 64.0f, (float)(i / 40) * 64.0f, 16);
+        partners[i] = make_collider(0, 0, 16);
+    }
+
+    TEST_ASSERT_NOT_NULL(g_engine->job_queue);
+    CollisionResolver *serial = collision_resolver_create(NULL);
+
+    for (int step = 0; step < 4; step++) {
+        place_pairs(partners, COUNT, step);
+        spatial_index_update(g_engine->spatial_index);
+        const SpatialPair *pairs = NULL;
+        size_t pair_count = spatial_index_get_pairs(g_engine->spatial_index, &pairs);
+        TEST_ASSERT_TRUE(pair_count >= 600);
+
+        EseArray *parallel_hits = collision_resolver_solve(g_engine->collision_resolver, pairs,
+                                                           pair_count, g_engine->lua_engine);
+        EseArray *serial_hits =
+            collision_resolver_solve(serial, pairs, pair_count, g_engine->lua_engine);
+
+        TEST_ASSERT_EQUAL_size_t(array_size(serial_hits), array_size(parallel_hits));
+        for (size_t h = 0; h < array_size(serial_hits); h++) {
+            EseCollisionHit *p = array_get(parallel_hits, h);
+            EseCollisionHit *s = array_get(serial_hits, h);
+            TEST_ASSERT_EQUAL_PTR(ese_collision_hit_get_entity(s), ese_collision_hit_get_entity(p));
+            TEST_ASSERT_EQUAL_PTR(ese_collision_hit_get_target(s), ese_collision_hit_get_target(p));
+            TEST_ASSERT_EQUAL_INT(ese_collision_hit_get_state(s), ese_collision_hit_get_state(p));
+        }
+    }
+
+    collision_resolver_destroy(serial);
+    ese_job_queue_process(g_engine->job_queue);
+    memory_manager.free(partners);
+}
+
+static void test_collision_resolver_hits_follow_pair_key_order(void) {
+    enum { COUNT = 16 };
+    for (int i = 0; i < COUNT; i++) {
+        make_collider((float)(i * 4), 0, 40);
+    }
+
+    spatial_index_update(g_engine->spatial_index);
+    const SpatialPair *pairs = NULL;
+    size_t pair_count = spatial_index_get_pairs(g_engine->spatial_index, &pairs);
+    EseArray *hits = collision_resolver_solve(g_engine->collision_resolver, pairs, pair_count,
+                                              g_engine->lua_engine);
+    TEST_ASSERT_EQUAL_size_t(pair_count, array_size(hits));
+
+    uint64_t last_key = 0;
+    for (size_t h = 0; h < array_size(hits); h++) {
+        EseCollisionHit *hit = array_get(hits, h);
+        TEST_ASSERT_EQUAL_INT(COLLISION_STATE_ENTER, ese_collision_hit_get_state(hit));
+        uint32_t lo = ese_collision_hit_get_entity(hit)->spatial_proxy;
+        uint32_t hi = ese_collision_hit_get_target(hit)->spatial_proxy;
+        uint64_t key = ((uint64_t)lo << 32) | hi;
+        TEST_ASSERT_TRUE(h == 0 || key > last_key);
+        last_key = key;
+    }
+}
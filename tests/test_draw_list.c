@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "testing.h"
+
+#include "../src/core/memory_manager.h"
+#include "../src/graphics/draw_list.h"
+#include "../src/utility/log.h"
+
+static EseDrawList *g_draw_list = NULL;
+
+void setUp(void) { g_draw_list = draw_list_create(); }
+
+void tearDown(void) {
+    draw_list_destroy(g_draw_list);
+    g_draw_list = NULL;
+}
+
+// Fills a polyline with points whose values encode (tag, index) so overlaps are detectable
+static void _fill_points(float *points, size_t point_count, float tag) {
+    for (size_t i = 0; i < point_count; i++) {
+        points[i * 2] = tag;
+        points[i * 2 + 1] = (float)i;
+    }
+}
+
+static void _assert_points(const EseDrawListObject *obj, size_t point_count, float tag) {
+    const float *points = NULL;
+    size_t count = 0;
+    draw_list_object_get_polyline(obj, &points, &count, NULL);
+    TEST_ASSERT_EQUAL_size_t(point_count, count);
+    for (size_t i = 0; i < point_count; i++) {
+        TEST_ASSERT_EQUAL_FLOAT(tag, points[i * 2]);
+        TEST_ASSERT_EQUAL_FLOAT((float)i, points[i * 2 + 1]);
+    }
+}
+
+static void test_draw_list_arena_grows_across_blocks(void) {
+    // 16 KB of points per object; 20 objects need five 64 KB blocks
+    enum { OBJECTS = 20, POINTS = 2048 };
+    static float points[POINTS * 2];
+    EseDrawListObject *objs[OBJECTS];
+
+    for (size_t i = 0; i < OBJECTS; i++) {
+        objs[i] = draw_list_request_object(g_draw_list);
+        _fill_points(points, POINTS, (float)i);
+        draw_list_object_set_polyline(objs[i], points, POINTS, 1.0f);
+    }
+
+    // Later blocks never move or overwrite earlier payloads
+    for (size_t i = 0; i < OBJECTS; i++) {
+        _assert_points(objs[i], POINTS, (float)i);
+    }
+}
+
+static void test_draw_list_arena_payload_larger_than_block(void) {
+    // About 100 KB of vertices, like a cached map chunk mesh
+    enum { VERTS = 5000 };
+    static EseDrawListVertex verts[VERTS];
+    static uint32_t indices[VERTS];
+    for (size_t i = 0; i < VERTS; i++) {
+        verts[i] = (EseDrawListVertex){(float)i, 1.0f, 0.0f, 0.0f, 255, 255, 255, 255};
+        indices[i] = (uint32_t)i;
+    }
+
+    // A small payload first, so the large one cannot start at the head of a block
+    EseDrawListObject *small = draw_list_request_object(g_draw_list);
+    float line[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+    draw_list_object_set_polyline(small, line, 2, 1.0f);
+
+    EseDrawListObject *mesh = draw_list_request_object(g_draw_list);
+    draw_list_object_set_mesh(mesh, verts, VERTS, indices, VERTS, "chunk");
+
+    EseDrawListObject *after = draw_list_request_object(g_draw_list);
+    draw_list_object_set_polyline(after, line, 2, 1.0f);
+
+    const EseDrawListVertex *out_verts = NULL;
+    const uint32_t *out_indices = NULL;
+    size_t vert_count = 0, idx_count = 0;
+    draw_list_object_get_mesh(mesh, &out_verts, &vert_count, &out_indices, &idx_count, NULL);
+    TEST_ASSERT_EQUAL_size_t(VERTS, vert_count);
+    TEST_ASSERT_EQUAL_size_t(VERTS, idx_count);
+    TEST_ASSERT_TRUE(memcmp(verts, out_verts, sizeof(verts)) == 0);
+    TEST_ASSERT_TRUE(memcmp(indices, out_indices, sizeof(indices)) == 0);
+
+    const float *out_line = NULL;
+    draw_list_object_get_polyline(small, &out_line, NULL, NULL);
+    TEST_ASSERT_TRUE(memcmp(line, out_line, sizeof(line)) == 0);
+    draw_list_object_get_polyline(after, &out_line, NULL, NULL);
+    TEST_ASSERT_TRUE(memcmp(line, out_line, sizeof(line)) == 0);
+}
+
+static void test_draw_list_clear_reuses_headers_and_arena(void) {
+    // More objects than the initial pool, so headers come from more than one block
+    enum { OBJECTS = 600, POINTS = 64 };
+    static EseDrawListObject *first_frame[OBJECTS];
+    static const float *first_points[OBJECTS];
+    float points[POINTS * 2];
+
+    for (size_t i = 0; i < OBJECTS; i++) {
+        first_frame[i] = draw_list_request_object(g_draw_list);
+        _fill_points(points, POINTS, (float)i);
+        draw_list_object_set_polyline(first_frame[i], points, POINTS, 1.0f);
+        draw_list_object_get_polyline(first_frame[i], &first_points[i], NULL, NULL);
+    }
+    TEST_ASSERT_EQUAL_size_t(OBJECTS, draw_list_get_object_count(g_draw_list));
+
+    // Growing the pool left the first headers (and their payloads) in place
+    _assert_points(first_frame[0], POINTS, 0.0f);
+
+    draw_list_clear(g_draw_list);
+    TEST_ASSERT_EQUAL_size_t(0, draw_list_get_object_count(g_draw_list));
+
+    // The next frame gets the same headers back and rewinds the arena onto the same memory
+    for (size_t i = 0; i < OBJECTS; i++) {
+        EseDrawListObject *obj = draw_list_request_object(g_draw_list);
+        TEST_ASSERT_EQUAL_PTR(first_frame[i], obj);
+        TEST_ASSERT_EQUAL_INT(DL_RECT, draw_list_object_get_type(obj));
+
+        _fill_points(points, POINTS, (float)(OBJECTS - i));
+        draw_list_object_set_polyline(obj, points, POINTS, 1.0f);
+        const float *reused = NULL;
+        draw_list_object_get_polyline(obj, &reused, NULL, NULL);
+        TEST_ASSERT_EQUAL_PTR(first_points[i], reused);
+    }
+    for (size_t i = 0; i < OBJECTS; i++) {
+        _assert_points(first_frame[i], POINTS, (float)(OBJECTS - i));
+    }
+}
+
+static void test_draw_list_texture_ids_are_interned(void) {
+    char id[32];
+    strcpy(id, "sprites:hero_01");
+
+    EseDrawListObject *a = draw_list_request_object(g_draw_list);
+    draw_list_object_set_texture(a, id, 0.0f, 0.0f, 1.0f, 1.0f);
+    EseDrawListObject *mesh = draw_list_request_object(g_draw_list);
+    EseDrawListVertex vert = {0};
+    uint32_t index = 0;
+    draw_list_object_set_mesh(mesh, &vert, 1, &index, 1, "sprites:hero_01");
+
+    // The caller's buffer is not referenced after the call
+    strcpy(id, "sprites:hero_02");
+    EseDrawListObject *b = draw_list_request_object(g_draw_list);
+    draw_list_object_set_texture(b, id, 0.0f, 0.0f, 1.0f, 1.0f);
+
+    const char *a_id = NULL, *mesh_id = NULL, *b_id = NULL;
+    draw_list_object_get_texture(a, &a_id, NULL, NULL, NULL, NULL);
+    draw_list_object_get_mesh(mesh, NULL, NULL, NULL, NULL, &mesh_id);
+    draw_list_object_get_texture(b, &b_id, NULL, NULL, NULL, NULL);
+
+    TEST_ASSERT_EQUAL_STRING("sprites:hero_01", a_id);
+    TEST_ASSERT_EQUAL_STRING("sprites:hero_02", b_id);
+    TEST_ASSERT_EQUAL_PTR(a_id, mesh_id);
+    TEST_ASSERT_EQUAL_PTR(a_id, draw_list_texture_intern(g_draw_list, "sprites:hero_01"));
+    TEST_ASSERT_EQUAL_PTR(a_id, draw_list_texture_intern(g_draw_list, a_id));
+    TEST_ASSERT_NOT_EQUAL(a_id, b_id);
+
+    // Interned ids outlive a clear
+    draw_list_clear(g_draw_list);
+    TEST_ASSERT_EQUAL_STRING("sprites:hero_01", a_id);
+}
+
+static void test_draw_list_texture_table_grows(void) {
+    // Far more ids than the initial table holds; earlier ids keep their pointers
+    enum { IDS = 1000 };
+    static const char *interned[IDS];
+    char id[32];
+
+    for (int i = 0; i < IDS; i++) {
+        snprintf(id, sizeof(id), "atlas:tile_%04d", i);
+        interned[i] = draw_list_texture_intern(g_draw_list, id);
+        TEST_ASSERT_EQUAL_STRING(id, interned[i]);
+    }
+    draw_list_clear(g_draw_list);
+
+    for (int i = 0; i < IDS; i++) {
+        snprintf(id, sizeof(id), "atlas:tile_%04d", i);
+        TEST_ASSERT_EQUAL_PTR(interned[i], draw_list_texture_intern(g_draw_list, id));
+    }
+}
+
+int main(void) {
+    log_init();
+
+    printf("\nDraw List Tests\n");
+    printf("---------------\n");
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_draw_list_arena_grows_across_blocks);
+    RUN_TEST(test_draw_list_arena_payload_larger_than_block);
+    RUN_TEST(test_draw_list_clear_reuses_headers_and_arena);
+    RUN_TEST(test_draw_list_texture_ids_are_interned);
+    RUN_TEST(test_draw_list_texture_table_grows);
+
+    memory_manager.destroy(true);
+
+    return UNITY_END();
+}
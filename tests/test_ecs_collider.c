@@ -266,6 +266,35 @@ void test_entity_component_collider_update_bounds(void) {
     
 }
 
+void test_entity_component_collider_shapes_follow_changes(void) {
+    EseEntityComponent *component = entity_component_collider_create(test_engine);
+    EseEntityComponentCollider *collider = (EseEntityComponentCollider *)component->data;
+    entity_component_add(test_entity, component);
+
+    EseRect *rect = ese_rect_create(test_engine);
+    ese_rect_set_x(rect, 10.0f);
+    ese_rect_set_y(rect, 20.0f);
+    ese_rect_set_width(rect, 30.0f);
+    ese_rect_set_height(rect, 40.0f);
+    entity_component_collider_rects_add(collider, rect);
+    TEST_ASSERT_EQUAL_size_t(1, collider->shapes.count);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 10.0f, collider->shapes.shapes[0].min_x);
+
+    // Entity position, collider offset and rect edits all refresh the cache
+    entity_set_position(test_entity, 100.0f, 200.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 110.0f, collider->shapes.shapes[0].min_x);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 220.0f, collider->shapes.shapes[0].min_y);
+
+    ese_point_set_x(collider->offset, 5.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 115.0f, collider->shapes.shapes[0].min_x);
+
+    ese_rect_set_width(rect, 50.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 165.0f, collider->shapes.shapes[0].max_x);
+
+    entity_component_collider_update_bounds(collider);
+    TEST_ASSERT_EQUAL_size_t(1, collider->shapes.count);
+}
+
 void test_entity_component_collider_update_bounds_no_entity(void) {
     EseEntityComponent *component = entity_component_collider_create(test_engine);
     EseEntityComponentCollider *collider = (EseEntityComponentCollider *)component->data;
@@ -416,6 +445,92 @@ void test_entity_component_collider_lua_property_setters(void) {
     lua_pop(L, 1);
 }
 
+void test_entity_component_collider_lua_layer_mask(void) {
+    lua_State *L = test_engine->runtime;
+
+    entity_component_collider_init(test_engine);
+
+    const char *test_code =
+        "local c = EntityComponentCollider.new()\n"
+        "local defaults = c.layer == 1 and c.mask == 65535\n"
+        "c.layer = 4\n"
+        "c.mask = 3\n"
+        "return defaults and c.layer == 4 and c.mask == 3";
+    TEST_ASSERT_EQUAL_INT_MESSAGE(LUA_OK, luaL_dostring(L, test_code), "Layer and mask should be settable");
+    TEST_ASSERT_TRUE(lua_toboolean(L, -1));
+    lua_pop(L, 1);
+
+    TEST_ASSERT_NOT_EQUAL(LUA_OK, luaL_dostring(L, "EntityComponentCollider.new().layer = 65536"));
+    lua_pop(L, 1);
+    TEST_ASSERT_NOT_EQUAL(LUA_OK, luaL_dostring(L, "EntityComponentCollider.new().mask = -1"));
+    lua_pop(L, 1);
+
+    // The attached entity caches both in its filter word
+    EseEntityComponent *component = entity_component_collider_create(test_engine);
+    entity_component_add(test_entity, component);
+    EseEntityComponentCollider *collider = (EseEntityComponentCollider *)component->data;
+    TEST_ASSERT_EQUAL_UINT32(COLLISION_FILTER_PACK(COLLIDER_LAYER_DEFAULT, COLLIDER_MASK_ALL),
+                             test_entity->collision_filter);
+    entity_component_collider_set_layer(collider, 0x0004);
+    entity_component_collider_set_mask(collider, 0x0003);
+    TEST_ASSERT_EQUAL_UINT32(0x00030004u, test_entity->collision_filter);
+}
+
+void test_entity_component_collider_lua_static(void) {
+    lua_State *L = test_engine->runtime;
+
+    entity_component_collider_init(test_engine);
+
+    const char *test_code = "local c = EntityComponentCollider.new()\n"
+                            "local default = c.static == false\n"
+                            "c.static = true\n"
+                            "return default and c.static == true";
+    TEST_ASSERT_EQUAL_INT_MESSAGE(LUA_OK, luaL_dostring(L, test_code),
+                                  "Static should be settable");
+    TEST_ASSERT_TRUE(lua_toboolean(L, -1));
+    lua_pop(L, 1);
+
+    TEST_ASSERT_NOT_EQUAL(LUA_OK, luaL_dostring(L, "EntityComponentCollider.new().static = 1"));
+    lua_pop(L, 1);
+
+    // The attached entity mirrors the flag for the spatial index
+    EseEntityComponent *component = entity_component_collider_create(test_engine);
+    entity_component_add(test_entity, component);
+    EseEntityComponentCollider *collider = (EseEntityComponentCollider *)component->data;
+    TEST_ASSERT_FALSE(test_entity->collision_static);
+    entity_component_collider_set_static(collider, true);
+    TEST_ASSERT_TRUE(test_entity->collision_static);
+    TEST_ASSERT_TRUE(entity_component_collider_get_static(collider));
+}
+
+void test_entity_component_collider_entity_filter_combines_colliders(void) {
+    EseEntityComponent *first = entity_component_collider_create(test_engine);
+    EseEntityComponent *second = entity_component_collider_create(test_engine);
+    entity_component_add(test_entity, first);
+    entity_component_add(test_entity, second);
+    EseEntityComponentCollider *a = (EseEntityComponentCollider *)first->data;
+    EseEntityComponentCollider *b = (EseEntityComponentCollider *)second->data;
+
+    entity_component_collider_set_layer(a, 0x0002);
+    entity_component_collider_set_mask(a, 0x0001);
+    entity_component_collider_set_static(a, true);
+    entity_component_collider_set_layer(b, 0x0004);
+    entity_component_collider_set_mask(b, 0x0008);
+
+    // Layers and masks are unioned; static needs every collider
+    TEST_ASSERT_EQUAL_UINT32(0x00090006u, test_entity->collision_filter);
+    TEST_ASSERT_FALSE(test_entity->collision_static);
+
+    // Removing one collider leaves the other's settings in place
+    entity_component_collider_sync_entity(test_entity, b);
+    TEST_ASSERT_EQUAL_UINT32(0x00010002u, test_entity->collision_filter);
+    TEST_ASSERT_TRUE(test_entity->collision_static);
+
+    entity_component_collider_sync_entity(test_entity, a);
+    TEST_ASSERT_EQUAL_UINT32(0x00080004u, test_entity->collision_filter);
+    TEST_ASSERT_FALSE(test_entity->collision_static);
+}
+
 void test_entity_component_collider_lua_rects_operations(void) {
     lua_State *L = test_engine->runtime;
     
@@ -578,6 +693,7 @@ int main(void) {
     RUN_TEST(testentity_component_collider_destroy);
     RUN_TEST(testentity_component_collider_destroy_null_collider);
     RUN_TEST(test_entity_component_collider_update_bounds);
+    RUN_TEST(test_entity_component_collider_shapes_follow_changes);
     RUN_TEST(test_entity_component_collider_update_bounds_no_entity);
     RUN_TEST(test_entity_component_collider_update_bounds_no_rects);
     RUN_TEST(test_entity_component_collider_update_bounds_null_collider);
@@ -594,6 +710,9 @@ int main(void) {
     RUN_TEST(test_entity_component_collider_lua_new_invalid_args);
     RUN_TEST(test_entity_component_collider_lua_properties);
     RUN_TEST(test_entity_component_collider_lua_property_setters);
+    RUN_TEST(test_entity_component_collider_lua_layer_mask);
+    RUN_TEST(test_entity_component_collider_lua_static);
+    RUN_TEST(test_entity_component_collider_entity_filter_combines_colliders);
     RUN_TEST(test_entity_component_collider_lua_rects_operations);
     RUN_TEST(test_entity_component_collider_lua_rects_add);
     RUN_TEST(test_entity_component_collider_lua_rects_remove);
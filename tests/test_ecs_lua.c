@@ -13,7 +13,7 @@
 #include "../src/scripting/lua_value.h"
 #include "../src/core/memory_manager.h"
 #include "../src/utility/log.h"
-#include "../src/utility/double_linked_list.h"
+#include "../src/utility/slot_map.h"
 
 // Test data
 static EseLuaEngine *test_engine = NULL;
@@ -53,7 +53,7 @@ void setUp(void) {
     
     // Create a mock engine structure for _entity_lua_new
     mock_engine.lua_engine = test_engine;
-    mock_engine.entities = dlist_create(NULL); // Simple entity list
+    mock_engine.entities = slot_map_create(0); // Simple entity list
     
     // Add the mock engine to the registry so _entity_lua_new can find it
     lua_engine_add_registry_key(test_engine->runtime, ENGINE_KEY, &mock_engine);
@@ -70,7 +70,7 @@ void tearDown(void) {
     test_engine = NULL;
 
     // Clean up the mock engine's linked list
-    dlist_free(mock_engine.entities);
+    slot_map_destroy(mock_engine.entities);
     mock_engine.entities = NULL;
 }
 
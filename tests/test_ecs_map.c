@@ -3,9 +3,15 @@
 #include "core/memory_manager.h"
 #include "entity/components/entity_component_map.h"
 #include "entity/components/entity_component.h"
+#include "entity/components/collider.h"
 #include "entity/entity.h"
+#include "entity/entity_private.h"
+#include "types/collision_hit.h"
 #include "types/map.h"
+#include "types/map_cell.h"
 #include "types/point.h"
+#include "types/rect.h"
+#include "utility/array.h"
 #include "core/engine.h"
 #include "scripting/lua_engine.h"
 
@@ -72,6 +78,97 @@ void test_entity_component_map_ref_unref(void) {
     entity_component_destroy(component);
 }
 
+void test_entity_component_map_collides_matches_full_scan(void) {
+    const EseMapType types[] = {MAP_TYPE_GRID, MAP_TYPE_HEX_POINT_UP, MAP_TYPE_HEX_FLAT_UP,
+                                MAP_TYPE_ISO};
+    const float rotations[] = {0.0f, 0.6f};
+    const int mw = 24, mh = 20;
+
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        EseEntityComponent *component = entity_component_map_create(test_engine);
+        entity_component_add(test_entity, component);
+        EseEntityComponentMap *map_comp = (EseEntityComponentMap *)component->data;
+        map_comp->size = 16;
+        ese_point_set_x(map_comp->position, 3.0f);
+        ese_point_set_y(map_comp->position, 2.0f);
+        entity_set_position(test_entity, 10.0f, -20.0f);
+
+        EseMap *map = ese_map_create(test_engine, mw, mh, types[t], true);
+        map_comp->map = map;
+        for (int y = 0; y < mh; y++) {
+            for (int x = 0; x < mw; x++) {
+                EseMapCell *cell = ese_map_get_cell(map, x, y);
+                if ((x * 7 + y * 3) % 4 != 0) {
+                    ese_map_cell_set_flag(cell, MAP_CELL_FLAG_SOLID);
+                } else if ((x + y) % 3 == 0) {
+                    ese_map_cell_set_flag(cell, 1u << 1);
+                }
+            }
+        }
+
+        // The broadphase is skipped here, so the map bounds just need to cover everything
+        test_entity->collision_world_bounds = ese_rect_create(test_engine);
+        ese_rect_set_x(test_entity->collision_world_bounds, -10000.0f);
+        ese_rect_set_y(test_entity->collision_world_bounds, -10000.0f);
+        ese_rect_set_width(test_entity->collision_world_bounds, 20000.0f);
+        ese_rect_set_height(test_entity->collision_world_bounds, 20000.0f);
+
+        for (size_t r = 0; r < sizeof(rotations) / sizeof(rotations[0]); r++) {
+            EseEntity *mover = entity_create(test_engine);
+            EseEntityComponent *collider = entity_component_collider_create(test_engine);
+            entity_component_add(mover, collider);
+            EseRect *rect = ese_rect_create(test_engine);
+            ese_rect_set_x(rect, 4.0f);
+            ese_rect_set_width(rect, 21.0f);
+            ese_rect_set_height(rect, 13.0f);
+            ese_rect_set_rotation(rect, rotations[r]);
+            entity_component_collider_rects_add(
+                (EseEntityComponentCollider *)collider->data, rect);
+
+            for (uint32_t flags = 1; flags <= 3; flags++) {
+                map_comp->collision_flags = flags;
+                for (int step = 0; step < 40; step++) {
+                    float px = (float)((step * 37) % 300) - 120.0f;
+                    float py = (float)((step * 53) % 260) - 110.0f;
+                    entity_set_position(mover, px, py);
+
+                    EseArray *hits = array_create(16, (ArrayFreeFn)ese_collision_hit_destroy);
+                    component->vtable->collides(component, collider, hits);
+
+                    size_t expected = 0;
+                    for (int y = 0; y < mh; y++) {
+                        for (int x = 0; x < mw; x++) {
+                            if (!(ese_map_cell_get_flags(ese_map_get_cell(map, x, y)) & flags)) {
+                                continue;
+                            }
+                            float cx, cy, cw, ch;
+                            entity_component_map_get_cell_area(map_comp, x, y, &cx, &cy, &cw,
+                                                               &ch);
+                            if (!ese_rect_intersects_area(rect, px, py, cx, cy, cw, ch)) {
+                                continue;
+                            }
+                            TEST_ASSERT_TRUE(expected < array_size(hits));
+                            EseCollisionHit *hit = array_get(hits, expected);
+                            TEST_ASSERT_EQUAL_INT(x, ese_collision_hit_get_cell_x(hit));
+                            TEST_ASSERT_EQUAL_INT(y, ese_collision_hit_get_cell_y(hit));
+                            expected++;
+                        }
+                    }
+                    TEST_ASSERT_EQUAL_size_t(expected, array_size(hits));
+                    array_destroy(hits);
+                }
+            }
+            entity_destroy(mover);
+        }
+
+        map_comp->map = NULL;
+        entity_component_remove(test_entity, ese_uuid_get_value(component->id));
+        ese_rect_destroy(test_entity->collision_world_bounds);
+        test_entity->collision_world_bounds = NULL;
+        ese_map_destroy(map);
+    }
+}
+
 // Lua API Tests
 void test_entity_component_map_lua_init(void) {
     lua_State *L = test_engine->runtime;
@@ -136,6 +233,36 @@ void test_entity_component_map_lua_property_setters(void) {
     lua_pop(L, 1);
 }
 
+void test_entity_component_map_revision_follows_cells(void) {
+    lua_State *L = test_engine->runtime;
+
+    _entity_component_map_init(test_engine);
+    ese_point_lua_init(test_engine);
+    ese_map_lua_init(test_engine);
+
+    const char *test_code = "c = EntityComponentMap.new()\n"
+                            "m = Map.new(4, 4)\n"
+                            "c.map = m\n"
+                            "return c, m";
+    TEST_ASSERT_EQUAL_INT(LUA_OK, luaL_dostring(L, test_code));
+    EseEntityComponentMap *map_comp = _entity_component_map_get(L, -2);
+    EseMap *map = ese_map_lua_get(L, -1);
+    lua_pop(L, 2);
+    TEST_ASSERT_NOT_NULL(map_comp);
+    TEST_ASSERT_NOT_NULL(map);
+
+    // Cached chunk meshes are rebuilt when the revision moves
+    uint32_t revision = map_comp->revision;
+    ese_map_cell_add_layer(ese_map_get_cell(map, 1, 2), 3);
+    TEST_ASSERT_NOT_EQUAL(revision, map_comp->revision);
+
+    revision = map_comp->revision;
+    ese_map_cell_set_layer(ese_map_get_cell(map, 1, 2), 0, 5);
+    TEST_ASSERT_NOT_EQUAL(revision, map_comp->revision);
+
+    TEST_ASSERT_EQUAL_INT(LUA_OK, luaL_dostring(L, "c = nil; m = nil; collectgarbage()"));
+}
+
 // Test runner
 int main(void) {
     log_init();
@@ -145,12 +272,14 @@ int main(void) {
     RUN_TEST(test_entity_component_map_create);
     RUN_TEST(test_entity_component_map_create_null_engine);
     RUN_TEST(test_entity_component_map_ref_unref);
+    RUN_TEST(test_entity_component_map_collides_matches_full_scan);
 
     // Lua API Tests
     RUN_TEST(test_entity_component_map_lua_init);
     RUN_TEST(test_entity_component_map_lua_new_basic);
     RUN_TEST(test_entity_component_map_lua_properties);
     RUN_TEST(test_entity_component_map_lua_property_setters);
+    RUN_TEST(test_entity_component_map_revision_follows_cells);
 
     memory_manager.destroy(true);
 
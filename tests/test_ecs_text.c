@@ -9,7 +9,7 @@
 #include "scripting/lua_engine.h"
 #include "core/engine.h"
 #include "core/engine_private.h"
-#include "utility/double_linked_list.h"
+#include "utility/slot_map.h"
 
 // Test data
 static EseLuaEngine *test_engine = NULL;
@@ -23,7 +23,7 @@ void setUp(void) {
 
     // Create a minimal mock engine and expose it to Lua (mirrors other tests)
     mock_engine.lua_engine = test_engine;
-    mock_engine.entities = dlist_create(NULL);
+    mock_engine.entities = slot_map_create(0);
     lua_engine_add_registry_key(test_engine->runtime, ENGINE_KEY, &mock_engine);
 }
 
@@ -40,7 +40,7 @@ void tearDown(void) {
     test_engine = NULL;
 
     // Clean up mock engine list
-    dlist_free(mock_engine.entities);
+    slot_map_destroy(mock_engine.entities);
     mock_engine.entities = NULL;
 }
 
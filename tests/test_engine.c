@@ -25,12 +25,14 @@
 #include "../src/core/memory_manager.h"
 #include "../src/core/engine.h"
 #include "../src/core/engine_private.h"
+#include "../src/utility/int_hashmap.h"
 #include "../src/utility/log.h"
 #include "../src/types/rect.h"
 #include "../src/types/point.h"
 #include "../src/types/input_state.h"
 #include "../src/types/input_state_private.h"
 #include "../src/types/uuid.h"
+#include "../src/types/display.h"
 #include "../src/core/console.h"
 #include "../src/platform/renderer.h"
 
@@ -42,11 +44,15 @@ static void test_engine_destroy(void);
 static void test_engine_add_entity(void);
 static void test_engine_remove_entity(void);
 static void test_engine_clear_entities(void);
+static void test_engine_entity_handles(void);
 static void test_engine_start(void);
 static void test_engine_update(void);
+static void test_engine_view_rect(void);
 static void test_engine_detect_collision_rect(void);
+static void test_engine_detect_collision_lua(void);
 static void test_engine_get_sprite(void);
 static void test_engine_find_by_tag(void);
+static void test_engine_find_by_tag_sets(void);
 static void test_engine_find_by_id(void);
 static void test_engine_get_entity_count(void);
 static void test_engine_console_functions(void);
@@ -85,11 +91,15 @@ int main(void) {
     RUN_TEST(test_engine_add_entity);
     RUN_TEST(test_engine_remove_entity);
     RUN_TEST(test_engine_clear_entities);
+    RUN_TEST(test_engine_entity_handles);
     RUN_TEST(test_engine_start);
     RUN_TEST(test_engine_update);
+    RUN_TEST(test_engine_view_rect);
     RUN_TEST(test_engine_detect_collision_rect);
+    RUN_TEST(test_engine_detect_collision_lua);
     RUN_TEST(test_engine_get_sprite);
     RUN_TEST(test_engine_find_by_tag);
+    RUN_TEST(test_engine_find_by_tag_sets);
     RUN_TEST(test_engine_find_by_id);
     RUN_TEST(test_engine_get_entity_count);
     RUN_TEST(test_engine_console_functions);
@@ -190,7 +200,7 @@ static void test_engine_remove_entity(void) {
     TEST_ASSERT_EQUAL_INT_MESSAGE(2, engine_get_entity_count(g_engine), "Entity count should remain 2 until update");
     
     // The entity should be in the deletion list
-    TEST_ASSERT_EQUAL_INT_MESSAGE(1, dlist_size(g_engine->del_entities), "Deletion list should have 1 entity");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, (int)array_size(g_engine->del_entities), "Deletion list should have 1 entity");
 }
 
 static void test_engine_clear_entities(void) {
@@ -216,7 +226,7 @@ static void test_engine_clear_entities(void) {
     engine_add_entity(g_engine, entity2);
     TEST_ASSERT_EQUAL_INT_MESSAGE(2, engine_get_entity_count(g_engine), "Engine should have 2 entities");
     engine_clear_entities(g_engine, false);
-    TEST_ASSERT_EQUAL_INT_MESSAGE(2, dlist_size(g_engine->del_entities), "Deletion list should have 2 entities");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, (int)array_size(g_engine->del_entities), "Deletion list should have 2 entities");
     engine_update(g_engine, 0.0f, test_input);
     TEST_ASSERT_EQUAL_INT_MESSAGE(0, engine_get_entity_count(g_engine), "Engine should have 0 entities after clearing non-persistent");
     // Don't manually clear - let the engine handle it
@@ -234,11 +244,11 @@ static void test_engine_clear_entities(void) {
     engine_clear_entities(g_engine, false);
     engine_update(g_engine, 0.0f, test_input);
     TEST_ASSERT_EQUAL_INT_MESSAGE(2, engine_get_entity_count(g_engine), "Engine should still have 2 entities after clearing non-persistent (persistent preserved)");
-    TEST_ASSERT_EQUAL_INT_MESSAGE(0, dlist_size(g_engine->del_entities), "Deletion list should have 0 entities");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(0, (int)array_size(g_engine->del_entities), "Deletion list should have 0 entities");
     
     // Test 4: Clear all entities (include_persistent=true)
     engine_clear_entities(g_engine, true);
-    TEST_ASSERT_EQUAL_INT_MESSAGE(2, dlist_size(g_engine->del_entities), "Deletion list should have 2 entities");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, (int)array_size(g_engine->del_entities), "Deletion list should have 2 entities");
     engine_update(g_engine, 0.0f, test_input);
     TEST_ASSERT_EQUAL_INT_MESSAGE(0, engine_get_entity_count(g_engine), "Engine should have 0 entities after clearing all");
     // Don't manually clear - let the engine handle it
@@ -255,20 +265,71 @@ static void test_engine_clear_entities(void) {
     TEST_ASSERT_EQUAL_INT_MESSAGE(3, engine_get_entity_count(g_engine), "Engine should have 3 entities");
     
     engine_clear_entities(g_engine, false); // Should clear 2 non-persistent, preserve 1 persistent
-    TEST_ASSERT_EQUAL_INT_MESSAGE(2, dlist_size(g_engine->del_entities), "Deletion list should have 2 non-persistent entities");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, (int)array_size(g_engine->del_entities), "Deletion list should have 2 non-persistent entities");
     engine_update(g_engine, 0.0f, test_input);
     TEST_ASSERT_EQUAL_INT_MESSAGE(1, engine_get_entity_count(g_engine), "Engine should have 1 persistent entity remaining");
-    dlist_clear(g_engine->del_entities);
+    array_clear(g_engine->del_entities);
     
     engine_clear_entities(g_engine, true); // Should clear the remaining 1 persistent entity
-    TEST_ASSERT_EQUAL_INT_MESSAGE(1, dlist_size(g_engine->del_entities), "Deletion list should have 1 persistent entity");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, (int)array_size(g_engine->del_entities), "Deletion list should have 1 persistent entity");
     engine_update(g_engine, 0.0f, test_input);
     TEST_ASSERT_EQUAL_INT_MESSAGE(0, engine_get_entity_count(g_engine), "Engine should have 0 entities after clearing all");
-    dlist_clear(g_engine->del_entities);
+    array_clear(g_engine->del_entities);
     
     ese_input_state_destroy(test_input);
 }
 
+static void test_engine_entity_handles(void) {
+    g_engine = engine_create(NULL);
+    EseLuaEngine *lua_engine = g_engine->lua_engine;
+
+    EseEntity *kept = entity_create(lua_engine);
+    EseEntity *removed = entity_create(lua_engine);
+    TEST_ASSERT_EQUAL_UINT32(SLOT_MAP_NULL_HANDLE, entity_get_handle(kept));
+    engine_add_entity(g_engine, kept);
+    engine_add_entity(g_engine, removed);
+    engine_add_entity(g_engine, kept);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, engine_get_entity_count(g_engine), "Adding twice should not duplicate");
+
+    EseSlotHandle kept_handle = entity_get_handle(kept);
+    EseSlotHandle removed_handle = entity_get_handle(removed);
+    TEST_ASSERT_NOT_EQUAL(SLOT_MAP_NULL_HANDLE, kept_handle);
+    TEST_ASSERT_EQUAL_PTR(kept, engine_get_entity(g_engine, kept_handle));
+    TEST_ASSERT_EQUAL_PTR(removed, engine_get_entity(g_engine, removed_handle));
+    TEST_ASSERT_NULL(engine_get_entity(g_engine, SLOT_MAP_NULL_HANDLE));
+
+    engine_remove_entity(g_engine, removed);
+    engine_remove_entity(g_engine, removed);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, (int)array_size(g_engine->del_entities), "Removing twice should queue once");
+    engine_update(g_engine, 0.0f, g_engine->input_state);
+    TEST_ASSERT_EQUAL_INT(1, engine_get_entity_count(g_engine));
+    TEST_ASSERT_NULL_MESSAGE(engine_get_entity(g_engine, removed_handle), "Removed handle should not resolve");
+    TEST_ASSERT_EQUAL_PTR(kept, engine_get_entity(g_engine, kept_handle));
+
+    // The freed slot is reused with a new generation
+    EseEntity *spawned = entity_create(lua_engine);
+    engine_add_entity(g_engine, spawned);
+    TEST_ASSERT_NOT_EQUAL(removed_handle, entity_get_handle(spawned));
+    TEST_ASSERT_NULL(engine_get_entity(g_engine, removed_handle));
+
+    // A Lua variable outliving its entity reads as a dead proxy, not freed memory
+    lua_State *L = lua_engine->runtime;
+    int status = luaL_dostring(L, "held = Entity.new()\n"
+                                  "held:destroy()\n");
+    if (status != LUA_OK) {
+        TEST_FAIL_MESSAGE(lua_tostring(L, -1));
+    }
+    engine_update(g_engine, 0.0f, g_engine->input_state);
+    status = luaL_dostring(L, "assert(held.active == nil and held.position == nil)\n"
+                              "assert(tostring(held) == 'Entity: (invalid)')\n"
+                              "held = nil\n"
+                              "collectgarbage()\n");
+    if (status != LUA_OK) {
+        TEST_FAIL_MESSAGE(lua_tostring(L, -1));
+    }
+    TEST_ASSERT_EQUAL_INT(2, engine_get_entity_count(g_engine));
+}
+
 static void test_engine_start(void) {
     g_engine = engine_create(NULL);
     TEST_ASSERT_NOT_NULL_MESSAGE(g_engine, "Engine should be created");
@@ -305,6 +366,32 @@ static void test_engine_update(void) {
     TEST_ASSERT_TRUE_MESSAGE(g_engine->input_state->keys_pressed[InputKey_B], "Key pressed state should be updated");
 }
 
+static void test_engine_view_rect(void) {
+    g_engine = engine_create(NULL);
+    ese_display_set_viewport(engine_get_display(g_engine), 100, 80);
+    ese_point_set_x(engine_get_camera(g_engine)->position, 200.0f);
+    ese_point_set_y(engine_get_camera(g_engine)->position, 10.0f);
+
+    EseViewRect view;
+    engine_get_view_rect(g_engine, &view);
+    TEST_ASSERT_EQUAL_FLOAT(150.0f, view.left);
+    TEST_ASSERT_EQUAL_FLOAT(-30.0f, view.top);
+    TEST_ASSERT_EQUAL_FLOAT(250.0f, view.right);
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, view.bottom);
+
+    // Boxes that reach into the view from any side are kept
+    TEST_ASSERT_TRUE(engine_view_rect_overlaps(&view, 200.0f, 0.0f, 1.0f, 1.0f));
+    TEST_ASSERT_TRUE(engine_view_rect_overlaps(&view, 140.0f, 0.0f, 11.0f, 1.0f));
+    TEST_ASSERT_TRUE(engine_view_rect_overlaps(&view, 200.0f, 49.0f, 1.0f, 100.0f));
+    TEST_ASSERT_TRUE(engine_view_rect_overlaps(&view, 100.0f, -100.0f, 300.0f, 300.0f));
+
+    // Boxes entirely past an edge are culled
+    TEST_ASSERT_FALSE(engine_view_rect_overlaps(&view, 130.0f, 0.0f, 10.0f, 10.0f));
+    TEST_ASSERT_FALSE(engine_view_rect_overlaps(&view, 251.0f, 0.0f, 10.0f, 10.0f));
+    TEST_ASSERT_FALSE(engine_view_rect_overlaps(&view, 200.0f, -50.0f, 10.0f, 10.0f));
+    TEST_ASSERT_FALSE(engine_view_rect_overlaps(&view, 200.0f, 51.0f, 10.0f, 10.0f));
+}
+
 static void test_engine_detect_collision_rect(void) {
     g_engine = engine_create(NULL);
     TEST_ASSERT_NOT_NULL_MESSAGE(g_engine, "Engine should be created");
@@ -338,6 +425,49 @@ static void test_engine_detect_collision_rect(void) {
     ese_rect_destroy(test_rect);
 }
 
+static EseEntity *add_collider(EseEngine *engine, float x, float y) {
+    EseLuaEngine *lua_engine = engine->lua_engine;
+    EseEntity *entity = entity_create(lua_engine);
+    EseEntityComponent *collider = entity_component_collider_create(lua_engine);
+    entity_component_add(entity, collider);
+    EseRect *rect = ese_rect_create(lua_engine);
+    ese_rect_set_width(rect, 20);
+    ese_rect_set_height(rect, 20);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+    entity_set_position(entity, x, y);
+    engine_add_entity(engine, entity);
+    return entity;
+}
+
+static void test_engine_detect_collision_lua(void) {
+    g_engine = engine_create(NULL);
+    TEST_ASSERT_NOT_NULL_MESSAGE(g_engine, "Engine should be created");
+
+    add_collider(g_engine, 100, 0);
+    add_collider(g_engine, 200, 0);
+    engine_update(g_engine, 0.016f, g_engine->input_state);
+
+    lua_State *L = g_engine->lua_engine->runtime;
+    const char *script =
+        "assert(#detect_collision(Rect.new(90, -10, 40, 40), 10) == 1)\n"
+        "assert(#detect_collision(Rect.new(90, -10, 200, 40), 10, 0x0002) == 0)\n"
+        "assert(#detect_collision_circle(Point.new(160, 10), 35, 10) == 0)\n"
+        "assert(#detect_collision_circle(Point.new(160, 10), 45, 10) == 2)\n"
+        "local ray = Ray.new(0, 10, 1, 0)\n"
+        "local first, distance = detect_collision_ray(ray, 1000)\n"
+        "assert(first and first.position.x == 100 and distance == 100)\n"
+        "assert(detect_collision_ray(ray, 50) == nil)\n"
+        "local hits, distances = detect_collision_ray_all(ray, 1000, 10)\n"
+        "assert(#hits == 2 and hits[2].position.x == 200 and distances[2] == 200)\n"
+        "local near, near_distances = detect_collision_nearest(Point.new(190, 0), 1)\n"
+        "assert(#near == 1 and near[1].position.x == 200 and near_distances[1] == 10)\n";
+    int status = luaL_dostring(L, script);
+    if (status != LUA_OK) {
+        TEST_FAIL_MESSAGE(lua_tostring(L, -1));
+    }
+}
+
 static void test_engine_get_sprite(void) {
     g_engine = engine_create(NULL);
     TEST_ASSERT_NOT_NULL_MESSAGE(g_engine, "Engine should be created");
@@ -381,6 +511,73 @@ static void test_engine_find_by_tag(void) {
     memory_manager.free(results);
 }
 
+static int _count_results(EseEntity **results) {
+    int count = 0;
+    while (results && results[count]) {
+        count++;
+    }
+    return count;
+}
+
+static void test_engine_find_by_tag_sets(void) {
+    g_engine = engine_create(NULL);
+    TEST_ASSERT_NOT_NULL_MESSAGE(g_engine, "Engine should be created");
+
+    EseLuaEngine *lua_engine = g_engine->lua_engine;
+    EseInputState test_input;
+    memset(&test_input, 0, sizeof(EseInputState));
+
+    EseEntity *entities[4];
+    for (int i = 0; i < 4; i++) {
+        entities[i] = entity_create(lua_engine);
+        engine_add_entity(g_engine, entities[i]);
+        entity_add_tag(entities[i], "enemy");
+    }
+    TEST_ASSERT_NULL_MESSAGE(engine_find_first_by_tag(g_engine, "boss"), "Unknown tag should find nothing");
+
+    // A tag added while the entity is in the engine is found
+    EseEntity **results = engine_find_by_tag(g_engine, "enemy", 10);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(4, _count_results(results), "Should find all tagged entities");
+    memory_manager.free(results);
+    results = engine_find_by_tag(g_engine, "enemy", 2);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, _count_results(results), "Should respect max_count");
+    memory_manager.free(results);
+
+    // Removing a tag from the middle of the set keeps the others
+    entity_remove_tag(entities[1], "ENEMY");
+    results = engine_find_by_tag(g_engine, "enemy", 10);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(3, _count_results(results), "Removed tag should leave the set");
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE_MESSAGE(results[i] != entities[1], "Untagged entity should not be found");
+    }
+    memory_manager.free(results);
+
+    // Inactive entities stay in the set but are skipped
+    entities[0]->active = false;
+    entities[2]->active = false;
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(entities[3], engine_find_first_by_tag(g_engine, "enemy"), "Should skip inactive entities");
+    entities[0]->active = true;
+    entities[2]->active = true;
+
+    // Entities queued for removal are not found, even before the update frees them
+    engine_remove_entity(g_engine, entities[3]);
+    results = engine_find_by_tag(g_engine, "enemy", 10);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(2, _count_results(results), "Queued entity should leave the set");
+    memory_manager.free(results);
+    engine_update(g_engine, 0.0f, &test_input);
+
+    // Destroying an added entity directly removes it from the set
+    entity_destroy(entities[2]);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(entities[0], engine_find_first_by_tag(g_engine, "enemy"), "Destroyed entity should leave the set");
+
+    // Tags added before the entity joins the engine are picked up on add
+    EseEntity *late = entity_create(lua_engine);
+    entity_add_tag(late, "boss");
+    TEST_ASSERT_NULL_MESSAGE(engine_find_first_by_tag(g_engine, "boss"), "Entity not in the engine should not be found");
+    engine_add_entity(g_engine, late);
+    TEST_ASSERT_EQUAL_PTR_MESSAGE(late, engine_find_first_by_tag(g_engine, "boss"), "Added entity should be found by its tag");
+}
+
 static void test_engine_find_by_id(void) {
     g_engine = engine_create(NULL);
     TEST_ASSERT_NOT_NULL_MESSAGE(g_engine, "Engine should be created");
@@ -406,6 +603,32 @@ static void test_engine_find_by_id(void) {
     // Test with wrong ID
     result = engine_find_by_id(g_engine, "wrong-id");
     TEST_ASSERT_NULL_MESSAGE(result, "Should return NULL for wrong ID");
+
+    // Inactive entities are not returned
+    entity->active = false;
+    TEST_ASSERT_NULL(engine_find_by_id(g_engine, entity_id));
+    entity->active = true;
+
+    // An entity whose id hash clashes with an indexed one is still found
+    EseEntity *clashing = entity_create(lua_engine);
+    const char *clashing_id = ese_uuid_get_value(clashing->id);
+    int_hashmap_set(g_engine->entity_ids, ese_uuid_hash(clashing->id),
+                    (void *)(uintptr_t)entity_get_handle(entity));
+    engine_add_entity(g_engine, clashing);
+    TEST_ASSERT_EQUAL_size_t(1, g_engine->unindexed_ids);
+    TEST_ASSERT_EQUAL_PTR(clashing, engine_find_by_id(g_engine, clashing_id));
+    TEST_ASSERT_EQUAL_PTR(entity, engine_find_by_id(g_engine, entity_id));
+    engine_remove_entity(g_engine, clashing);
+    TEST_ASSERT_EQUAL_size_t(0, g_engine->unindexed_ids);
+    TEST_ASSERT_NULL(engine_find_by_id(g_engine, clashing_id));
+
+    // Removed entities leave the index when they are queued
+    char saved_id[37];
+    snprintf(saved_id, sizeof(saved_id), "%s", entity_id);
+    engine_remove_entity(g_engine, entity);
+    TEST_ASSERT_NULL_MESSAGE(engine_find_by_id(g_engine, saved_id), "Removed entity should not be found");
+    engine_update(g_engine, 0.0f, g_engine->input_state);
+    TEST_ASSERT_NULL(engine_find_by_id(g_engine, saved_id));
 }
 
 static void test_engine_get_entity_count(void) {
@@ -27,6 +27,7 @@
 #include "../src/core/engine.h"
 #include "../src/core/engine_private.h"
 #include "../src/utility/log.h"
+#include "../src/utility/spatial_index.h"
 #include "../src/types/rect.h"
 #include "../src/types/point.h"
 #include "../src/types/input_state.h"
@@ -47,6 +48,8 @@ static void test_entity_rotated_collision(void);
 static void test_entity_offset_collision(void);
 static void test_entity_mixed_collision(void);
 static void test_entity_corner_cases(void);
+static void test_collision_batched_callbacks(void);
+static void test_collision_resting_bodies_stay(void);
 
 /**
  * Test suite setup and teardown
@@ -85,6 +88,8 @@ int main(void) {
     RUN_TEST(test_entity_offset_collision);
     RUN_TEST(test_entity_mixed_collision);
     RUN_TEST(test_entity_corner_cases);
+    RUN_TEST(test_collision_batched_callbacks);
+    RUN_TEST(test_collision_resting_bodies_stay);
 
     return UNITY_END();
 }
@@ -1086,4 +1091,119 @@ static void test_entity_corner_cases(void) {
     TEST_ASSERT_FALSE_MESSAGE(entity_has_tag(entity2, "enter"), "Entities should not collide when separated");
 
     ese_input_state_destroy(input_state);
-}
\ No newline at end of file
+}
+
+static EseEntity *_batch_test_entity(EseLuaEngine *lua_engine, const char *script, float x) {
+    EseEntity *entity = entity_create(lua_engine);
+    entity_component_add(entity, entity_component_lua_create(lua_engine, script));
+    EseEntityComponent *collider = entity_component_collider_create(lua_engine);
+    entity_component_add(entity, collider);
+    EseRect *rect = ese_rect_create(lua_engine);
+    ese_rect_set_width(rect, 30);
+    ese_rect_set_height(rect, 30);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+    entity_set_position(entity, x, 0);
+    engine_add_entity(g_engine, entity);
+    return entity;
+}
+
+static void test_collision_batched_callbacks(void) {
+    g_engine = engine_create(NULL);
+    TEST_ASSERT_NOT_NULL_MESSAGE(g_engine, "Engine should be created");
+
+    EseLuaEngine *lua_engine = g_engine->lua_engine;
+
+    // Defining entity_collisions replaces the per-hit callbacks for that entity
+    const char *batched =
+        "function ENTITY:entity_collisions(hits)\n"
+        "    if self:has_tag('called') then self:add_tag('called_twice') end\n"
+        "    self:add_tag('called')\n"
+        "    if #hits == 2 then self:add_tag('two_hits') end\n"
+        "    for _, hit in ipairs(hits) do\n"
+        "        if hit.kind == EseCollisionHit.TYPE.COLLIDER and hit.other:has_tag('peer') then\n"
+        "            if hit.state == EseCollisionHit.STATE.ENTER then self:add_tag('enter') end\n"
+        "            if hit.state == EseCollisionHit.STATE.STAY then self:add_tag('stay') end\n"
+        "            if hit.state == EseCollisionHit.STATE.LEAVE then self:add_tag('exit') end\n"
+        "        end\n"
+        "        if hit.cell_x ~= nil then self:add_tag('has_cell') end\n"
+        "    end\n"
+        "end\n"
+        "function ENTITY:entity_collision_enter(other) self:add_tag('per_hit') end\n";
+    const char *per_hit = "function ENTITY:entity_collision_enter(other)\n"
+                          "    self:add_tag('peer')\n"
+                          "    self:add_tag('enter')\n"
+                          "end\n";
+    TEST_ASSERT_TRUE(
+        lua_engine_load_script_from_string(lua_engine, batched, "batched_script", "ENTITY"));
+    TEST_ASSERT_TRUE(
+        lua_engine_load_script_from_string(lua_engine, per_hit, "per_hit_script", "ENTITY"));
+
+    // The batched entity overlaps both peers; the peers do not overlap each other
+    EseEntity *hub = _batch_test_entity(lua_engine, "batched_script", 20);
+    EseEntity *left = _batch_test_entity(lua_engine, "per_hit_script", 0);
+    EseEntity *right = _batch_test_entity(lua_engine, "per_hit_script", 40);
+    entity_add_tag(left, "peer");
+    entity_add_tag(right, "peer");
+
+    EseInputState *input_state = ese_input_state_create(lua_engine);
+
+    engine_update(g_engine, 0.016f, input_state);
+    TEST_ASSERT_TRUE_MESSAGE(entity_has_tag(hub, "called"), "Batch callback should run");
+    TEST_ASSERT_FALSE_MESSAGE(entity_has_tag(hub, "called_twice"),
+                              "Batch callback should run once per frame");
+    TEST_ASSERT_TRUE_MESSAGE(entity_has_tag(hub, "two_hits"), "Batch should hold both hits");
+    TEST_ASSERT_TRUE_MESSAGE(entity_has_tag(hub, "enter"), "Batch should report ENTER");
+    TEST_ASSERT_FALSE_MESSAGE(entity_has_tag(hub, "per_hit"),
+                              "Per-hit callbacks should not run for a batched entity");
+    TEST_ASSERT_FALSE_MESSAGE(entity_has_tag(hub, "has_cell"),
+                              "Collider records should not carry map cells");
+    TEST_ASSERT_TRUE_MESSAGE(entity_has_tag(left, "enter"), "Per-hit peers keep their callbacks");
+    TEST_ASSERT_TRUE_MESSAGE(entity_has_tag(right, "enter"), "Per-hit peers keep their callbacks");
+
+    engine_update(g_engine, 0.016f, input_state);
+    TEST_ASSERT_TRUE_MESSAGE(entity_has_tag(hub, "stay"), "Batch should report STAY");
+
+    entity_set_position(hub, 200, 0);
+    engine_update(g_engine, 0.016f, input_state);
+    TEST_ASSERT_TRUE_MESSAGE(entity_has_tag(hub, "exit"), "Batch should report LEAVE");
+
+    ese_input_state_destroy(input_state);
+}
+
+static void test_collision_resting_bodies_stay(void) {
+    g_engine = engine_create(NULL);
+    TEST_ASSERT_NOT_NULL_MESSAGE(g_engine, "Engine should be created");
+
+    EseLuaEngine *lua_engine = g_engine->lua_engine;
+    const char *script = "function ENTITY:entity_collision_stay(other) self:add_tag('stay') end\n"
+                         "function ENTITY:entity_collision_exit(other) self:add_tag('exit') end\n";
+    TEST_ASSERT_TRUE(
+        lua_engine_load_script_from_string(lua_engine, script, "resting_script", "ENTITY"));
+
+    // A static wall and a body that overlaps it and then stops moving
+    spatial_index_set_sleep_frames(g_engine->spatial_index, 2);
+    EseEntity *wall = _batch_test_entity(lua_engine, "resting_script", 0);
+    EseEntity *body = _batch_test_entity(lua_engine, "resting_script", 20);
+    entity_component_collider_set_static(
+        (EseEntityComponentCollider *)entity_component_get_data(wall->components[1]), true);
+
+    EseInputState *input_state = ese_input_state_create(lua_engine);
+
+    engine_update(g_engine, 0.016f, input_state);
+    for (int frame = 0; frame < 5; frame++) {
+        entity_remove_tag(body, "stay");
+        engine_update(g_engine, 0.016f, input_state);
+        TEST_ASSERT_TRUE_MESSAGE(entity_has_tag(body, "stay"), "Resting contact should stay");
+    }
+    TEST_ASSERT_TRUE_MESSAGE(wall->collision_resting, "Static wall should rest");
+    TEST_ASSERT_TRUE_MESSAGE(body->collision_resting, "Still body should fall asleep");
+    TEST_ASSERT_FALSE_MESSAGE(entity_has_tag(body, "exit"), "Resting contact should not exit");
+
+    entity_set_position(body, 200, 0);
+    engine_update(g_engine, 0.016f, input_state);
+    TEST_ASSERT_TRUE_MESSAGE(entity_has_tag(body, "exit"), "Moving away should wake and exit");
+    TEST_ASSERT_FALSE(body->collision_resting);
+
+    ese_input_state_destroy(input_state);
+}
@@ -21,6 +21,7 @@
 #include "testing.h"
 #include "../src/entity/entity.h"
 #include "../src/entity/entity_lua.h"
+#include "../src/entity/entity_private.h"
 #include "../src/entity/components/entity_component.h"
 #include "../src/entity/components/entity_component_lua.h"
 #include "../src/entity/components/collider.h"
@@ -54,7 +55,9 @@ static void test_entity_run_function();
 static void test_entity_collision_callbacks();
 // Rename to match Unity test implementation name
 static void test_entity_component_management();
+static void test_entity_component_mask();
 static void test_entity_tags();
+static void test_entity_tag_ids();
 static void test_entity_lua_integration();
 static void test_entity_null_pointer_aborts();
 static void test_entity_dispatch();
@@ -353,6 +356,32 @@ static void test_entity_component_management() {
     
 }
 
+// Test the per-entity component type mask
+static void test_entity_component_mask() {
+    const uint32_t lua_bit = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_LUA);
+    const uint32_t collider_bit = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_COLLIDER);
+
+    EseEntity *entity = entity_create(test_engine);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, entity->component_mask, "New entity should have an empty mask");
+
+    const char *lua_a = entity_component_add(entity, entity_component_lua_create(test_engine, NULL));
+    const char *lua_b = entity_component_add(entity, entity_component_lua_create(test_engine, NULL));
+    entity_component_add(entity, entity_component_collider_create(test_engine));
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(lua_bit | collider_bit, entity->component_mask, "Mask should hold every attached type");
+
+    EseEntity *copy = entity_copy(entity);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(entity->component_mask, copy->component_mask, "Copy should keep the mask");
+    entity_destroy(copy);
+
+    // The bit stays while another component of the type is attached
+    entity_component_remove(entity, lua_a);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(lua_bit | collider_bit, entity->component_mask, "One Lua component is still attached");
+    entity_component_remove(entity, lua_b);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(collider_bit, entity->component_mask, "Last Lua component should clear the bit");
+
+    entity_destroy(entity);
+}
+
 // Test entity tags
 static void test_entity_tags() {
     
@@ -389,6 +418,36 @@ static void test_entity_tags() {
     
 }
 
+// Test tag interning and id lookups
+static void test_entity_tag_ids() {
+    EseTagId id = entity_tag_intern("player");
+    TEST_ASSERT_NOT_EQUAL_MESSAGE(ENTITY_TAG_NONE, id, "Tag should be interned");
+    TEST_ASSERT_EQUAL_MESSAGE(id, entity_tag_intern("PLAYER"), "Normalized tags should share an id");
+    TEST_ASSERT_EQUAL_MESSAGE(id, entity_tag_find("Player"), "Find should return the interned id");
+    TEST_ASSERT_EQUAL_STRING_MESSAGE("PLAYER", entity_tag_name(id), "Name should be normalized");
+    TEST_ASSERT_TRUE_MESSAGE(id < entity_tag_count(), "Ids should be dense");
+
+    // Long tags are truncated before interning
+    EseTagId long_id = entity_tag_intern("a_very_long_tag_name_indeed");
+    TEST_ASSERT_EQUAL_MESSAGE(long_id, entity_tag_find("A_VERY_LONG_TAG_NAME"), "Truncated tags should match");
+    TEST_ASSERT_EQUAL_size_t_MESSAGE(MAX_TAG_LENGTH - 1, strlen(entity_tag_name(long_id)), "Name should be truncated");
+
+    // Finding does not intern
+    size_t count = entity_tag_count();
+    TEST_ASSERT_EQUAL_MESSAGE(ENTITY_TAG_NONE, entity_tag_find("never_added"), "Unknown tag should not be found");
+    TEST_ASSERT_EQUAL_size_t_MESSAGE(count, entity_tag_count(), "Find should not intern");
+    TEST_ASSERT_NULL_MESSAGE(entity_tag_name(ENTITY_TAG_NONE), "Unknown id has no name");
+
+    EseEntity *entity = entity_create(test_engine);
+    entity_add_tag(entity, "player");
+    TEST_ASSERT_TRUE_MESSAGE(entity_has_tag_id(entity, id), "Entity should have the tag id");
+    TEST_ASSERT_FALSE_MESSAGE(entity_has_tag_id(entity, long_id), "Entity should not have other tag ids");
+    TEST_ASSERT_FALSE_MESSAGE(entity_has_tag(entity, "never_added"), "Unknown tag should not match");
+    entity_remove_tag(entity, "PLAYER");
+    TEST_ASSERT_FALSE_MESSAGE(entity_has_tag_id(entity, id), "Removed tag id should be gone");
+    entity_destroy(entity);
+}
+
 // Test entity Lua integration
 static void test_entity_lua_integration() {
     
@@ -702,7 +761,9 @@ int main(void) {
     RUN_TEST(test_entity_run_function);
     RUN_TEST(test_entity_collision_callbacks);
     RUN_TEST(test_entity_component_management);
+    RUN_TEST(test_entity_component_mask);
     RUN_TEST(test_entity_tags);
+    RUN_TEST(test_entity_tag_ids);
     RUN_TEST(test_entity_lua_integration);
     RUN_TEST(test_entity_null_pointer_aborts);
     RUN_TEST(test_entity_dispatch);
@@ -0,0 +1,273 @@
+/*
+ * test_entity_transforms.c - Unity-based tests for entity transform storage
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "testing.h"
+
+#include "../src/core/engine.h"
+#include "../src/core/engine_private.h"
+#include "../src/core/memory_manager.h"
+#include "../src/entity/components/collider.h"
+#include "../src/entity/components/entity_component.h"
+#include "../src/entity/entity.h"
+#include "../src/entity/entity_lua.h"
+#include "../src/entity/entity_private.h"
+#include "../src/entity/transform_pool.h"
+#include "../src/scripting/lua_engine.h"
+#include "../src/types/point.h"
+#include "../src/types/rect.h"
+#include "../src/utility/log.h"
+#include "../src/utility/slot_map.h"
+
+/**
+ * Test Functions Declarations
+ */
+static void test_transform_pool_attach_set_detach(void);
+static void test_transform_pool_grows_on_attach(void);
+static void test_transform_pool_next_dirty(void);
+static void test_entity_transform_follows_engine_membership(void);
+static void test_entity_transform_collider_bounds_sync(void);
+static void test_entity_transform_position_view(void);
+
+/**
+ * Test suite setup and teardown
+ */
+static EseEngine *g_engine = NULL;
+static EseEntity g_owners[600];
+
+void setUp(void) { g_engine = engine_create(NULL); }
+
+void tearDown(void) {
+    if (g_engine) {
+        engine_destroy(g_engine);
+        g_engine = NULL;
+    }
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    log_init();
+
+    printf("\nEntity Transform Tests\n");
+    printf("----------------------\n");
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_transform_pool_attach_set_detach);
+    RUN_TEST(test_transform_pool_grows_on_attach);
+    RUN_TEST(test_transform_pool_next_dirty);
+    RUN_TEST(test_entity_transform_follows_engine_membership);
+    RUN_TEST(test_entity_transform_collider_bounds_sync);
+    RUN_TEST(test_entity_transform_position_view);
+
+    memory_manager.destroy(true);
+
+    return UNITY_END();
+}
+
+/**
+ * Helpers
+ */
+static EseEntity *make_collider(float x, float y, float size) {
+    EseLuaEngine *lua = g_engine->lua_engine;
+    EseEntity *entity = entity_create(lua);
+    EseEntityComponent *collider = entity_component_collider_create(lua);
+    entity_component_add(entity, collider);
+
+    EseRect *rect = ese_rect_create(lua);
+    ese_rect_set_width(rect, size);
+    ese_rect_set_height(rect, size);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+
+    entity_set_position(entity, x, y);
+    engine_add_entity(g_engine, entity);
+    return entity;
+}
+
+static void test_transform_pool_attach_set_detach(void) {
+    EseTransformPool *pool = transform_pool_create(0);
+
+    TEST_ASSERT_TRUE(transform_pool_attach(pool, 3, &g_owners[0], 1.0f, 2.0f));
+    TEST_ASSERT_EQUAL_PTR(&g_owners[0], pool->entities[3]);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, pool->x[3]);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, pool->y[3]);
+
+    /* Attaching marks the slot dirty; clearing reports it once */
+    TEST_ASSERT_TRUE(transform_pool_clear_dirty(pool, 3));
+    TEST_ASSERT_FALSE(transform_pool_clear_dirty(pool, 3));
+
+    transform_pool_set(pool, 3, 5.0f, -6.0f);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, pool->x[3]);
+    TEST_ASSERT_EQUAL_FLOAT(-6.0f, pool->y[3]);
+    TEST_ASSERT_TRUE(transform_pool_clear_dirty(pool, 3));
+
+    /* Detaching frees the slot and drops its dirty bit */
+    transform_pool_set(pool, 3, 7.0f, 8.0f);
+    transform_pool_detach(pool, 3);
+    TEST_ASSERT_NULL(pool->entities[3]);
+    TEST_ASSERT_EQUAL_UINT32(TRANSFORM_POOL_NO_SLOT, transform_pool_next_dirty(pool, 0));
+
+    transform_pool_destroy(pool);
+    transform_pool_destroy(NULL);
+}
+
+static void test_transform_pool_grows_on_attach(void) {
+    EseTransformPool *pool = transform_pool_create(0);
+    uint32_t initial = pool->capacity;
+
+    TEST_ASSERT_TRUE(transform_pool_attach(pool, 0, &g_owners[0], 10.0f, 20.0f));
+    TEST_ASSERT_TRUE(transform_pool_attach(pool, initial + 5, &g_owners[1], 30.0f, 40.0f));
+    TEST_ASSERT_TRUE(pool->capacity > initial + 5);
+    TEST_ASSERT_EQUAL_INT(0, pool->capacity % 64);
+
+    /* Existing slots keep their values; new slots start free */
+    TEST_ASSERT_EQUAL_PTR(&g_owners[0], pool->entities[0]);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, pool->x[0]);
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, pool->y[initial + 5]);
+    TEST_ASSERT_NULL(pool->entities[initial + 4]);
+
+    transform_pool_destroy(pool);
+}
+
+static void test_transform_pool_next_dirty(void) {
+    EseTransformPool *pool = transform_pool_create(512);
+    const uint32_t slots[] = {1, 63, 64, 200, 511};
+    for (size_t i = 0; i < sizeof(slots) / sizeof(slots[0]); i++) {
+        transform_pool_attach(pool, slots[i], &g_owners[slots[i]], 0.0f, 0.0f);
+    }
+
+    /* Dirty slots come back in order, across word boundaries */
+    uint32_t found = 0;
+    for (uint32_t i = transform_pool_next_dirty(pool, 0); i != TRANSFORM_POOL_NO_SLOT;
+         i = transform_pool_next_dirty(pool, i + 1)) {
+        TEST_ASSERT_EQUAL_UINT32(slots[found], i);
+        found++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, found);
+
+    TEST_ASSERT_EQUAL_UINT32(64, transform_pool_next_dirty(pool, 64));
+    TEST_ASSERT_EQUAL_UINT32(200, transform_pool_next_dirty(pool, 65));
+    TEST_ASSERT_EQUAL_UINT32(TRANSFORM_POOL_NO_SLOT, transform_pool_next_dirty(pool, 512));
+
+    for (size_t i = 0; i < sizeof(slots) / sizeof(slots[0]); i++) {
+        transform_pool_clear_dirty(pool, slots[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(TRANSFORM_POOL_NO_SLOT, transform_pool_next_dirty(pool, 0));
+
+    transform_pool_destroy(pool);
+}
+
+static void test_entity_transform_follows_engine_membership(void) {
+    EseEntity *entity = entity_create(g_engine->lua_engine);
+    entity_set_position(entity, 12.0f, 34.0f);
+    TEST_ASSERT_NULL(entity->transforms);
+
+    /* Adding moves the position into the engine pool at the handle's slot */
+    engine_add_entity(g_engine, entity);
+    uint32_t slot = entity_get_handle(entity) & (SLOT_MAP_MAX_SLOTS - 1u);
+    TEST_ASSERT_EQUAL_PTR(g_engine->transforms, entity->transforms);
+    TEST_ASSERT_EQUAL_PTR(entity, g_engine->transforms->entities[slot]);
+    TEST_ASSERT_EQUAL_FLOAT(12.0f, g_engine->transforms->x[slot]);
+
+    entity_set_position(entity, 56.0f, 78.0f);
+    TEST_ASSERT_EQUAL_FLOAT(56.0f, g_engine->transforms->x[slot]);
+    TEST_ASSERT_EQUAL_FLOAT(78.0f, g_engine->transforms->y[slot]);
+    TEST_ASSERT_EQUAL_FLOAT(56.0f, entity_get_x(entity));
+    TEST_ASSERT_EQUAL_FLOAT(78.0f, entity_get_y(entity));
+
+    /* Copies start detached with the same position */
+    EseEntity *copy = entity_copy(entity);
+    TEST_ASSERT_NULL(copy->transforms);
+    TEST_ASSERT_EQUAL_FLOAT(56.0f, entity_get_x(copy));
+    entity_destroy(copy);
+
+    /* Destroying an added entity directly frees its slot */
+    slot_map_remove(g_engine->entities, entity_get_handle(entity));
+    entity_destroy(entity);
+    TEST_ASSERT_NULL(g_engine->transforms->entities[slot]);
+}
+
+static void test_entity_transform_collider_bounds_sync(void) {
+    EseEntity *entity = make_collider(0.0f, 0.0f, 10.0f);
+    engine_sync_transforms(g_engine);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, ese_rect_get_x(entity->collision_world_bounds));
+
+    /* A write only marks the transform dirty */
+    entity_set_position(entity, 100.0f, 50.0f);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, ese_rect_get_x(entity->collision_world_bounds));
+    TEST_ASSERT_NOT_EQUAL(TRANSFORM_POOL_NO_SLOT,
+                          transform_pool_next_dirty(g_engine->transforms, 0));
+
+    /* Several writes before a sync cost one refresh */
+    entity_set_position(entity, 200.0f, 60.0f);
+    engine_sync_transforms(g_engine);
+    TEST_ASSERT_EQUAL_FLOAT(200.0f, ese_rect_get_x(entity->collision_world_bounds));
+    TEST_ASSERT_EQUAL_FLOAT(60.0f, ese_rect_get_y(entity->collision_world_bounds));
+    TEST_ASSERT_EQUAL_UINT32(TRANSFORM_POOL_NO_SLOT,
+                             transform_pool_next_dirty(g_engine->transforms, 0));
+
+    /* Reading the bounds syncs the entity first */
+    entity_set_position(entity, -5.0f, -6.0f);
+    EseRect *bounds = entity_get_collision_bounds(entity, true);
+    TEST_ASSERT_EQUAL_FLOAT(-5.0f, ese_rect_get_x(bounds));
+    TEST_ASSERT_EQUAL_FLOAT(-6.0f, ese_rect_get_y(bounds));
+    ese_rect_destroy(bounds);
+
+    /* Detached entities still refresh on every write */
+    EseEntity *loose = entity_create(g_engine->lua_engine);
+    EseEntityComponent *collider = entity_component_collider_create(g_engine->lua_engine);
+    entity_component_add(loose, collider);
+    EseRect *rect = ese_rect_create(g_engine->lua_engine);
+    ese_rect_set_width(rect, 4.0f);
+    ese_rect_set_height(rect, 4.0f);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+    entity_set_position(loose, 9.0f, 9.0f);
+    TEST_ASSERT_EQUAL_FLOAT(9.0f, ese_rect_get_x(loose->collision_world_bounds));
+    entity_destroy(loose);
+}
+
+static void test_entity_transform_position_view(void) {
+    EseEntity *entity = entity_create(g_engine->lua_engine);
+    engine_add_entity(g_engine, entity);
+    uint32_t slot = entity_get_handle(entity) & (SLOT_MAP_MAX_SLOTS - 1u);
+
+    /* The position point reads and writes the pool */
+    ese_point_set_x(entity->position, 3.0f);
+    ese_point_set_y(entity->position, 4.0f);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, g_engine->transforms->x[slot]);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, g_engine->transforms->y[slot]);
+
+    entity_set_position(entity, 7.0f, 8.0f);
+    TEST_ASSERT_EQUAL_FLOAT(7.0f, ese_point_get_x(entity->position));
+    TEST_ASSERT_EQUAL_FLOAT(8.0f, ese_point_get_y(entity->position));
+
+    /* A copy of the view is a plain point */
+    EsePoint *copy = ese_point_copy(entity->position);
+    entity_set_position(entity, 1.0f, 1.0f);
+    TEST_ASSERT_EQUAL_FLOAT(7.0f, ese_point_get_x(copy));
+    ese_point_destroy(copy);
+
+    /* Lua writes go through the view as well */
+    lua_State *L = g_engine->lua_engine->runtime;
+    entity_lua_push(entity);
+    lua_setglobal(L, "moved");
+    int status = luaL_dostring(L, "moved.position.x = 25\n"
+                                  "moved.position = Point.new(moved.position.x, 30)\n");
+    if (status != LUA_OK) {
+        TEST_FAIL_MESSAGE(lua_tostring(L, -1));
+    }
+    TEST_ASSERT_EQUAL_FLOAT(25.0f, g_engine->transforms->x[slot]);
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, g_engine->transforms->y[slot]);
+    lua_pushnil(L);
+    lua_setglobal(L, "moved");
+}
@@ -129,6 +129,41 @@ static void cleanup_jobblocker(ese_job_id_t job_id, void *user_data, void *resul
     g_cleanup_count++;
 }
 
+/* Parallel loop over a counter array: each item is bumped once per visit */
+#define PF_ITEMS 10000
+
+typedef struct ParallelForData {
+    EseJobQueue *q;
+    int hits[PF_ITEMS];
+    EseAtomicSizeT *chunks;
+} ParallelForData;
+
+static void pf_body(void *user_data, size_t begin, size_t end) {
+    ParallelForData *d = (ParallelForData *)user_data;
+    for (size_t i = begin; i < end; i++) {
+        d->hits[i]++;
+    }
+    ese_atomic_size_t_fetch_add(d->chunks, 1);
+}
+
+/* Job that runs a parallel loop on its own queue */
+static JobResult job_parallel_for(void *thread_data, const void *user_data,
+                                  volatile bool *canceled) {
+    (void)thread_data;
+    (void)canceled;
+    ParallelForData *d = (ParallelForData *)user_data;
+    ese_job_queue_parallel_for(d->q, PF_ITEMS, 16, pf_body, d);
+    JobResult res = {0};
+    return res;
+}
+
+static void cleanup_noop(ese_job_id_t job_id, void *user_data, void *result) {
+    (void)job_id;
+    (void)user_data;
+    (void)result;
+    g_cleanup_count++;
+}
+
 /* =====================
  * Test Declarations
  * ===================== */
@@ -145,6 +180,8 @@ static void test_cancel_after_completion_and_double_cancel(void);
 static void test_poll_when_empty_returns_zero(void);
 static void test_cancel_lock_order_no_deadlock(void);
 static void test_thread_detach_no_use_after_free(void);
+static void test_parallel_for_covers_every_item(void);
+static void test_parallel_for_from_job_no_deadlock(void);
 
 /* =====================
  * Unity setUp/tearDown
@@ -177,6 +214,8 @@ int main(void) {
     RUN_TEST(test_poll_when_empty_returns_zero);
     RUN_TEST(test_cancel_lock_order_no_deadlock);
     RUN_TEST(test_thread_detach_no_use_after_free);
+    RUN_TEST(test_parallel_for_covers_every_item);
+    RUN_TEST(test_parallel_for_from_job_no_deadlock);
 
     memory_manager.destroy(true);
 
@@ -520,4 +559,55 @@ static void test_wait_timeout_then_complete(void) {
     ese_job_queue_destroy(q);
 }
 
+static void test_parallel_for_covers_every_item(void) {
+    reset_globals();
+    EseJobQueue *q = ese_job_queue_create(3, worker_init, worker_deinit);
+    ParallelForData *d = (ParallelForData *)memory_manager.calloc(1, sizeof(ParallelForData), MMTAG_TEMP);
+    d->q = q;
+    d->chunks = ese_atomic_size_t_create(0);
+
+    ese_job_queue_parallel_for(q, PF_ITEMS, 16, pf_body, d);
+    for (size_t i = 0; i < PF_ITEMS; i++) {
+        TEST_ASSERT_EQUAL_INT_MESSAGE(1, d->hits[i], "item visited other than once");
+    }
+    TEST_ASSERT_TRUE(ese_atomic_size_t_load(d->chunks) > 1);
+
+    /* A loop that fits in one chunk runs inline as a single call */
+    memset(d->hits, 0, sizeof(d->hits));
+    ese_atomic_size_t_store(d->chunks, 0);
+    ese_job_queue_parallel_for(q, PF_ITEMS, PF_ITEMS, pf_body, d);
+    TEST_ASSERT_EQUAL_UINT64(1, ese_atomic_size_t_load(d->chunks));
+    TEST_ASSERT_EQUAL_INT(1, d->hits[PF_ITEMS - 1]);
+
+    /* Empty loops never call the body */
+    ese_atomic_size_t_store(d->chunks, 0);
+    ese_job_queue_parallel_for(q, 0, 1, pf_body, d);
+    TEST_ASSERT_EQUAL_UINT64(0, ese_atomic_size_t_load(d->chunks));
+
+    ese_atomic_size_t_destroy(d->chunks);
+    memory_manager.free(d);
+    ese_job_queue_destroy(q);
+}
+
+static void test_parallel_for_from_job_no_deadlock(void) {
+    reset_globals();
+    /* The only worker runs the job, so nobody else can help with the loop */
+    EseJobQueue *q = ese_job_queue_create(1, worker_init, worker_deinit);
+    ParallelForData *d = (ParallelForData *)memory_manager.calloc(1, sizeof(ParallelForData), MMTAG_TEMP);
+    d->q = q;
+    d->chunks = ese_atomic_size_t_create(0);
 
+    ese_job_id_t id = ese_job_queue_push(q, job_parallel_for, NULL, cleanup_noop, d);
+    TEST_ASSERT_TRUE(id > 0);
+    int rc = ese_job_queue_wait_for_completion(q, id, 2000);
+    TEST_ASSERT_EQUAL_INT(ESE_JOB_COMPLETED, rc);
+    for (size_t i = 0; i < PF_ITEMS; i++) {
+        TEST_ASSERT_EQUAL_INT(1, d->hits[i]);
+    }
+
+    drain_callbacks(q);
+    TEST_ASSERT_EQUAL_INT(1, g_cleanup_count);
+    ese_job_queue_destroy(q);
+    ese_atomic_size_t_destroy(d->chunks);
+    memory_manager.free(d);
+}
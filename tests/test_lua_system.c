@@ -0,0 +1,215 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "testing.h"
+
+#include "../src/core/engine.h"
+#include "../src/core/engine_private.h"
+#include "../src/core/memory_manager.h"
+#include "../src/entity/components/entity_component.h"
+#include "../src/entity/components/entity_component_lua.h"
+#include "../src/entity/entity.h"
+#include "../src/entity/entity_lua.h"
+#include "../src/entity/entity_private.h"
+#include "../src/scripting/lua_engine.h"
+#include "../src/scripting/lua_engine_private.h"
+#include "../src/types/camera.h"
+#include "../src/types/display.h"
+#include "../src/types/input_state.h"
+#include "../src/types/point.h"
+#include "../src/utility/log.h"
+#include "../src/vendor/lua/src/lauxlib.h"
+#include "../src/vendor/lua/src/lua.h"
+
+#define MAX_TRACKED 8
+#define FRAME_DT 0.1f
+
+static EseEngine *g_engine = NULL;
+static EseInputState *g_input = NULL;
+
+// What entity_update delivered to each tracked entity, filled by record()
+static EseEntity *g_tracked[MAX_TRACKED];
+static int g_updates[MAX_TRACKED];
+static float g_dt[MAX_TRACKED];
+
+static int record(lua_State *L) {
+    EseEntity *entity = entity_lua_get(L, 1);
+    for (int i = 0; i < MAX_TRACKED; i++) {
+        if (g_tracked[i] == entity) {
+            g_updates[i]++;
+            g_dt[i] += (float)lua_tonumber(L, 2);
+        }
+    }
+    return 0;
+}
+
+void setUp(void) {
+    g_engine = engine_create(NULL);
+    g_input = ese_input_state_create(NULL);
+    memset(g_tracked, 0, sizeof(g_tracked));
+    memset(g_updates, 0, sizeof(g_updates));
+    memset(g_dt, 0, sizeof(g_dt));
+
+    lua_engine_add_function(g_engine->lua_engine, "record", record);
+    const char *script = "ENTITY = {}\n"
+                         "function ENTITY:entity_update(dt) record(self, dt) end\n";
+    TEST_ASSERT_TRUE(
+        lua_engine_load_script_from_string(g_engine->lua_engine, script, "recorder", "ENTITY"));
+}
+
+void tearDown(void) {
+    engine_destroy(g_engine);
+    ese_input_state_destroy(g_input);
+    g_engine = NULL;
+    g_input = NULL;
+}
+
+static EseEntity *make_tracked(int slot, float x, float y) {
+    EseEntity *entity = entity_create(g_engine->lua_engine);
+    entity_component_add(entity, entity_component_lua_create(g_engine->lua_engine, "recorder"));
+    engine_add_entity(g_engine, entity);
+    entity_set_position(entity, x, y);
+    g_tracked[slot] = entity;
+    return entity;
+}
+
+static float pending_dt(EseEntity *entity) {
+    return ((EseEntityComponentLua *)entity->components[0]->data)->pending_dt;
+}
+
+static void run_frames(int frames) {
+    for (int i = 0; i < frames; i++) {
+        engine_update(g_engine, FRAME_DT, g_input);
+    }
+}
+
+static void test_lua_system_interval_accumulates_dt(void) {
+    EseEntity *every = make_tracked(0, 0.0f, 0.0f);
+    EseEntity *throttled = make_tracked(1, 0.0f, 0.0f);
+    entity_set_update_mode(throttled, ENTITY_UPDATE_INTERVAL);
+    entity_set_update_interval(throttled, 3);
+
+    run_frames(6);
+
+    TEST_ASSERT_EQUAL_INT(6, g_updates[0]);
+    TEST_ASSERT_EQUAL_INT(2, g_updates[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, pending_dt(every));
+    // Every frame's dt is either delivered or still waiting for the next update
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 6 * FRAME_DT, g_dt[1] + pending_dt(throttled));
+}
+
+static void test_lua_system_budget_spreads_updates(void) {
+    for (int i = 0; i < 6; i++) {
+        EseEntity *entity = make_tracked(i, 0.0f, 0.0f);
+        entity_set_update_mode(entity, ENTITY_UPDATE_INTERVAL);
+    }
+    engine_set_lua_update_budget(g_engine, 2);
+
+    run_frames(3);
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_INT(1, g_updates[i]);
+    }
+
+    engine_set_lua_update_budget(g_engine, 0);
+    run_frames(1);
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_INT(2, g_updates[i]);
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, 4 * FRAME_DT, g_dt[i]);
+    }
+}
+
+static void test_lua_system_near_camera(void) {
+    ese_display_set_viewport(engine_get_display(g_engine), 100, 100);
+    ese_point_set_x(engine_get_camera(g_engine)->position, 0.0f);
+    ese_point_set_y(engine_get_camera(g_engine)->position, 0.0f);
+
+    EseEntity *inside = make_tracked(0, 10.0f, 10.0f);
+    EseEntity *far = make_tracked(1, 500.0f, 0.0f);
+    EseEntity *margin = make_tracked(2, 500.0f, 0.0f);
+    entity_set_update_mode(inside, ENTITY_UPDATE_NEAR_CAMERA);
+    entity_set_update_mode(far, ENTITY_UPDATE_NEAR_CAMERA);
+    entity_set_update_mode(margin, ENTITY_UPDATE_NEAR_CAMERA);
+    entity_set_update_distance(margin, 500.0f);
+
+    run_frames(2);
+    TEST_ASSERT_EQUAL_INT(2, g_updates[0]);
+    TEST_ASSERT_EQUAL_INT(0, g_updates[1]);
+    TEST_ASSERT_EQUAL_INT(2, g_updates[2]);
+
+    entity_set_position(far, 0.0f, 0.0f);
+    run_frames(1);
+    TEST_ASSERT_EQUAL_INT(1, g_updates[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 3 * FRAME_DT, g_dt[1]);
+}
+
+static void test_lua_system_pending_dt_is_capped(void) {
+    ese_display_set_viewport(engine_get_display(g_engine), 100, 100);
+    ese_point_set_x(engine_get_camera(g_engine)->position, 0.0f);
+    ese_point_set_y(engine_get_camera(g_engine)->position, 0.0f);
+
+    EseEntity *far = make_tracked(0, 500.0f, 0.0f);
+    entity_set_update_mode(far, ENTITY_UPDATE_NEAR_CAMERA);
+
+    // 3 seconds off camera only carries one second into the next update
+    run_frames(30);
+    TEST_ASSERT_EQUAL_INT(0, g_updates[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, pending_dt(far));
+
+    entity_set_position(far, 0.0f, 0.0f);
+    run_frames(1);
+    TEST_ASSERT_EQUAL_INT(1, g_updates[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f + FRAME_DT, g_dt[0]);
+}
+
+static void test_lua_system_entity_properties(void) {
+    EseEntity *entity = entity_create(g_engine->lua_engine);
+    lua_State *L = g_engine->lua_engine->runtime;
+    entity_lua_push(entity);
+    lua_setglobal(L, "e");
+
+    const char *code = "e.update_mode = 'interval'\n"
+                       "e.update_interval = 4\n"
+                       "e.update_distance = 64\n"
+                       "mode = e.update_mode\n";
+    if (luaL_dostring(L, code) != LUA_OK) {
+        TEST_FAIL_MESSAGE(lua_tostring(L, -1));
+    }
+    TEST_ASSERT_EQUAL_INT(ENTITY_UPDATE_INTERVAL, entity_get_update_mode(entity));
+    TEST_ASSERT_EQUAL_UINT32(4, entity_get_update_interval(entity));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 64.0f, entity_get_update_distance(entity));
+    lua_getglobal(L, "mode");
+    TEST_ASSERT_EQUAL_STRING("interval", lua_tostring(L, -1));
+    lua_pop(L, 1);
+
+    TEST_ASSERT_NOT_EQUAL(LUA_OK, luaL_dostring(L, "e.update_mode = 'sometimes'"));
+    lua_pop(L, 1);
+    TEST_ASSERT_NOT_EQUAL(LUA_OK, luaL_dostring(L, "e.update_interval = 0"));
+    lua_pop(L, 1);
+
+    EseEntity *copy = entity_copy(entity);
+    TEST_ASSERT_EQUAL_INT(ENTITY_UPDATE_INTERVAL, entity_get_update_mode(copy));
+    TEST_ASSERT_EQUAL_UINT32(4, entity_get_update_interval(copy));
+
+    entity_destroy(copy);
+    entity_destroy(entity);
+}
+
+int main(void) {
+    log_init();
+
+    printf("\nLua System Tests\n");
+    printf("----------------\n");
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_lua_system_interval_accumulates_dt);
+    RUN_TEST(test_lua_system_budget_spreads_updates);
+    RUN_TEST(test_lua_system_near_camera);
+    RUN_TEST(test_lua_system_pending_dt_is_capped);
+    RUN_TEST(test_lua_system_entity_properties);
+
+    memory_manager.destroy(true);
+
+    return UNITY_END();
+}
@@ -35,6 +35,9 @@ static void test_memory_manager_thread_isolation(void);
 static void test_memory_manager_concurrent_threads(void);
 static void test_memory_manager_report(void);
 static void test_memory_manager_destroy(void);
+static void test_memory_manager_frame_alloc_reset(void);
+static void test_memory_manager_frame_alloc_grows(void);
+static void test_memory_manager_frame_alloc_per_thread(void);
 
 /**
 * Thread worker for testing
@@ -91,6 +94,17 @@ static void *thread_worker_mixed(void *arg) {
     return NULL;
 }
 
+static void *thread_worker_frame(void *arg) {
+    ThreadTestData *data = (ThreadTestData *)arg;
+    data->pointers = memory_manager.frame_alloc(sizeof(void *) * data->num_allocs);
+    for (int i = 0; i < data->num_allocs; i++) {
+        data->pointers[i] = memory_manager.frame_alloc(data->alloc_size);
+        memset(data->pointers[i], 0xAB, data->alloc_size);
+    }
+    *data->finished = true;
+    return NULL;
+}
+
 /**
 * Test suite setup and teardown
 */
@@ -126,6 +140,9 @@ int main(void) {
     RUN_TEST(test_memory_manager_concurrent_threads);
     RUN_TEST(test_memory_manager_report);
     RUN_TEST(test_memory_manager_destroy);
+    RUN_TEST(test_memory_manager_frame_alloc_reset);
+    RUN_TEST(test_memory_manager_frame_alloc_grows);
+    RUN_TEST(test_memory_manager_frame_alloc_per_thread);
 
     memory_manager.destroy(true);
 
@@ -354,3 +371,80 @@ static void test_memory_manager_destroy(void) {
     TEST_ASSERT_TRUE_MESSAGE(true, "Destroy test setup complete");
 }
 
+/**
+* Frame arena: aligned bump allocation, recycled by frame_reset
+*/
+static void test_memory_manager_frame_alloc_reset(void) {
+    memory_manager.frame_reset();
+
+    char *a = memory_manager.frame_alloc(3);
+    char *b = memory_manager.frame_alloc(40);
+    int *c = memory_manager.frame_calloc(16, sizeof(int));
+
+    TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)a % 16);
+    TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)b % 16);
+    TEST_ASSERT_EQUAL_UINT(0, (uintptr_t)c % 16);
+    TEST_ASSERT_TRUE(b >= a + 3);
+    TEST_ASSERT_TRUE((char *)c >= b + 40);
+    for (int i = 0; i < 16; i++) {
+        TEST_ASSERT_EQUAL_INT(0, c[i]);
+    }
+
+    // The next frame starts over at the same memory
+    memory_manager.frame_reset();
+    TEST_ASSERT_EQUAL_PTR(a, memory_manager.frame_alloc(8));
+}
+
+/**
+* Frame arena: a frame larger than one block fits one block after the reset
+*/
+static void test_memory_manager_frame_alloc_grows(void) {
+    const size_t chunk = 48 * 1024;
+    char *first[4];
+
+    memory_manager.frame_reset();
+    for (int i = 0; i < 4; i++) {
+        first[i] = memory_manager.frame_alloc(chunk);
+        memset(first[i], i, chunk);
+    }
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(i, first[i][chunk - 1]);
+    }
+
+    memory_manager.frame_reset();
+    char *base = memory_manager.frame_alloc(chunk);
+    for (int i = 1; i < 4; i++) {
+        TEST_ASSERT_EQUAL_PTR(base + chunk * i, memory_manager.frame_alloc(chunk));
+    }
+    memory_manager.frame_reset();
+}
+
+/**
+* Frame arena: every thread bumps through its own arena
+*/
+static void test_memory_manager_frame_alloc_per_thread(void) {
+    bool finished = false;
+    ThreadTestData data = {
+        .thread_id = 1,
+        .num_allocs = 64,
+        .alloc_size = 256,
+        .pointers = NULL,
+        .finished = &finished
+    };
+
+    memory_manager.frame_reset();
+    char *main_ptr = memory_manager.frame_alloc(256);
+    memset(main_ptr, 0x11, 256);
+
+    EseThread thread = ese_thread_create(thread_worker_frame, &data);
+    TEST_ASSERT_NOT_NULL_MESSAGE(thread, "Thread creation should succeed");
+    ese_thread_join(thread);
+    TEST_ASSERT_TRUE(finished);
+
+    for (int i = 0; i < data.num_allocs; i++) {
+        TEST_ASSERT_TRUE((char *)data.pointers[i] + 256 <= main_ptr ||
+                         (char *)data.pointers[i] >= main_ptr + 256);
+    }
+    TEST_ASSERT_EQUAL_INT(0x11, main_ptr[255]);
+    memory_manager.frame_reset();
+}
@@ -275,7 +275,7 @@ int main(void) {
 */
 
 static void test_ese_point_sizeof(void) {
-    TEST_ASSERT_EQUAL_INT_MESSAGE(56, ese_point_sizeof(), "Point should be 56 bytes");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(72, ese_point_sizeof(), "Point should be 72 bytes");
 }
 
 static void test_ese_point_create_requires_engine(void) {
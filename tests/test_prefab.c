@@ -0,0 +1,169 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "testing.h"
+
+#include "../src/core/engine.h"
+#include "../src/core/engine_private.h"
+#include "../src/core/memory_manager.h"
+#include "../src/core/system_manager.h"
+#include "../src/entity/components/entity_component.h"
+#include "../src/entity/components/entity_component_lua.h"
+#include "../src/entity/components/entity_component_private.h"
+#include "../src/entity/components/entity_component_sprite.h"
+#include "../src/entity/entity.h"
+#include "../src/entity/entity_lua.h"
+#include "../src/entity/entity_private.h"
+#include "../src/scripting/lua_engine.h"
+#include "../src/scripting/lua_engine_private.h"
+#include "../src/types/prefab.h"
+#include "../src/utility/log.h"
+#include "../src/utility/slot_map.h"
+#include "../src/vendor/lua/src/lauxlib.h"
+#include "../src/vendor/lua/src/lua.h"
+
+static EseEngine *g_engine = NULL;
+static int g_sprites_added = 0;
+
+static void count_sprite_added(EseSystemManager *self, EseEngine *eng, EseEntityComponent *comp) {
+    (void)self;
+    (void)eng;
+    TEST_ASSERT_NOT_NULL(comp->entity);
+    g_sprites_added++;
+}
+
+static const EseSystemManagerVTable g_counting_vt = {
+    .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SPRITE),
+    .on_component_added = count_sprite_added,
+};
+
+void setUp(void) {
+    g_engine = engine_create(NULL);
+    g_sprites_added = 0;
+}
+
+void tearDown(void) {
+    engine_destroy(g_engine);
+    g_engine = NULL;
+}
+
+static EseEntity *make_source(void) {
+    EseEntity *source = entity_create(g_engine->lua_engine);
+    entity_set_position(source, 3.0f, 4.0f);
+    entity_set_visible(source, false);
+    TEST_ASSERT_TRUE(entity_add_tag(source, "ENEMY"));
+    entity_component_add(source, entity_component_sprite_create(g_engine->lua_engine, "x:y"));
+    return source;
+}
+
+static void test_prefab_spawn_copies_template(void) {
+    engine_add_system(g_engine, system_manager_create(&g_counting_vt, SYS_PHASE_EARLY, NULL));
+
+    EseEntity *source = make_source();
+    EsePrefab *prefab = ese_prefab_create_from_entity(g_engine, source);
+    TEST_ASSERT_NOT_NULL(prefab);
+    TEST_ASSERT_EQUAL_size_t(1, ese_prefab_component_count(prefab));
+    size_t before = slot_map_size(g_engine->entities);
+    g_sprites_added = 0;
+
+    float xs[3] = {10.0f, 20.0f, 30.0f};
+    float ys[3] = {-1.0f, -2.0f, -3.0f};
+    EseEntity *spawned[3];
+    TEST_ASSERT_EQUAL_size_t(3, ese_prefab_spawn(prefab, g_engine, 3, xs, ys, spawned));
+    TEST_ASSERT_EQUAL_size_t(before + 3, slot_map_size(g_engine->entities));
+    TEST_ASSERT_EQUAL_INT(3, g_sprites_added);
+
+    for (size_t i = 0; i < 3; i++) {
+        EseEntity *e = spawned[i];
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, xs[i], entity_get_x(e));
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, ys[i], entity_get_y(e));
+        TEST_ASSERT_FALSE(entity_get_visible(e));
+        TEST_ASSERT_TRUE(entity_has_tag(e, "ENEMY"));
+        TEST_ASSERT_EQUAL_size_t(1, entity_component_count(e));
+        TEST_ASSERT_EQUAL_PTR(e, e->components[0]->entity);
+        TEST_ASSERT_TRUE(e->components[0] != source->components[0]);
+    }
+    TEST_ASSERT_TRUE(spawned[0]->components[0] != spawned[1]->components[0]);
+    EseEntity **enemies = engine_find_by_tag(g_engine, "ENEMY", 10);
+    size_t enemy_count = 0;
+    while (enemies && enemies[enemy_count]) {
+        enemy_count++;
+    }
+    TEST_ASSERT_EQUAL_size_t(3, enemy_count);
+    memory_manager.free(enemies);
+
+    // Without positions every entity lands on the source position
+    EseEntity *at_source;
+    ese_prefab_spawn(prefab, g_engine, 1, NULL, NULL, &at_source);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.0f, entity_get_x(at_source));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 4.0f, entity_get_y(at_source));
+
+    ese_prefab_destroy(prefab);
+    entity_destroy(source);
+}
+
+static void test_prefab_rejects_unloaded_script(void) {
+    EseEntity *source = entity_create(g_engine->lua_engine);
+    entity_component_add(source, entity_component_lua_create(g_engine->lua_engine, "missing"));
+
+    TEST_ASSERT_NULL(ese_prefab_create_from_entity(g_engine, source));
+
+    const char *script = "ENTITY = {}\nfunction ENTITY:entity_update(dt) end\n";
+    TEST_ASSERT_TRUE(
+        lua_engine_load_script_from_string(g_engine->lua_engine, script, "missing", "ENTITY"));
+    EsePrefab *prefab = ese_prefab_create_from_entity(g_engine, source);
+    TEST_ASSERT_NOT_NULL(prefab);
+
+    ese_prefab_destroy(prefab);
+    entity_destroy(source);
+}
+
+static void test_prefab_lua_spawn(void) {
+    EseEntity *source = make_source();
+    engine_add_entity(g_engine, source);
+
+    lua_State *L = g_engine->lua_engine->runtime;
+    entity_lua_push(source);
+    lua_setglobal(L, "source");
+
+    const char *code = "local p = Prefab.create(source)\n"
+                       "spawned = p:spawn(2, { Point.new(5, 6), { x = 7, y = 8 } })\n"
+                       "component_count = p.component_count\n";
+    if (luaL_dostring(L, code) != LUA_OK) {
+        TEST_FAIL_MESSAGE(lua_tostring(L, -1));
+    }
+
+    lua_getglobal(L, "component_count");
+    TEST_ASSERT_EQUAL_INT(1, (int)lua_tointeger(L, -1));
+    lua_pop(L, 1);
+
+    lua_getglobal(L, "spawned");
+    TEST_ASSERT_EQUAL_INT(2, (int)lua_objlen(L, -1));
+    lua_rawgeti(L, -1, 2);
+    EseEntity *second = entity_lua_get(L, -1);
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 7.0f, entity_get_x(second));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 8.0f, entity_get_y(second));
+    lua_pop(L, 2);
+
+    TEST_ASSERT_NOT_EQUAL(LUA_OK, luaL_dostring(L, "Prefab.create(source):spawn(2, { {x = 1} })"));
+    lua_pop(L, 1);
+}
+
+int main(void) {
+    log_init();
+
+    printf("\nEsePrefab Tests\n");
+    printf("---------------\n");
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_prefab_spawn_copies_template);
+    RUN_TEST(test_prefab_rejects_unloaded_script);
+    RUN_TEST(test_prefab_lua_spawn);
+
+    memory_manager.destroy(true);
+
+    return UNITY_END();
+}
@@ -0,0 +1,230 @@
+#include <stdio.h>
+
+#include "testing.h"
+
+#include "../src/core/memory_manager.h"
+#include "../src/graphics/draw_list.h"
+#include "../src/graphics/render_list.h"
+#include "../src/utility/log.h"
+
+static EseDrawList *g_draw_list = NULL;
+static EseRenderList *g_render_list = NULL;
+
+void setUp(void) {
+    g_draw_list = draw_list_create();
+    g_render_list = render_list_create();
+    render_list_set_size(g_render_list, 100, 100);
+}
+
+void tearDown(void) {
+    render_list_destroy(g_render_list);
+    draw_list_destroy(g_draw_list);
+    g_render_list = NULL;
+    g_draw_list = NULL;
+}
+
+// One 10x10 quad at the mesh origin, as two indexed triangles
+static EseDrawListVertex g_quad_verts[4] = {
+    {0.0f, 0.0f, 0.0f, 0.0f, 255, 255, 255, 255},
+    {0.0f, 10.0f, 0.0f, 1.0f, 255, 255, 255, 255},
+    {10.0f, 10.0f, 1.0f, 1.0f, 255, 255, 255, 255},
+    {10.0f, 0.0f, 1.0f, 0.0f, 255, 255, 255, 255},
+};
+static uint32_t g_quad_indices[6] = {0, 1, 2, 0, 2, 3};
+
+static void test_render_list_mesh_expands_indices(void) {
+    EseDrawListObject *obj = draw_list_request_object(g_draw_list);
+    draw_list_object_set_mesh(obj, g_quad_verts, 4, g_quad_indices, 6, "tiles");
+    draw_list_object_set_bounds(obj, 50.0f, 25.0f, 10, 10);
+
+    render_list_fill(g_render_list, g_draw_list);
+
+    TEST_ASSERT_EQUAL_size_t(1, render_list_get_batch_count(g_render_list));
+    const EseRenderBatch *batch = render_list_get_batch(g_render_list, 0);
+    TEST_ASSERT_EQUAL_INT(RL_TEXTURE, batch->type);
+    TEST_ASSERT_EQUAL_STRING("tiles", batch->shared_state.texture_id);
+    TEST_ASSERT_EQUAL_size_t(6, batch->vertex_count);
+
+    // Vertices are offset by the object's position: (50, 25) is NDC (0, 0.5)
+    for (size_t i = 0; i < 6; i++) {
+        const EseDrawListVertex *src = &g_quad_verts[g_quad_indices[i]];
+        const EseVertex *v = &batch->vertex_buffer[i];
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, (50.0f + src->x) / 50.0f - 1.0f, v->x);
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, 1.0f - (25.0f + src->y) / 50.0f, v->y);
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, src->u, v->u);
+        TEST_ASSERT_FLOAT_WITHIN(0.0001f, src->v, v->v);
+        TEST_ASSERT_EQUAL_UINT(src->a, v->a);
+    }
+}
+
+static void test_render_list_mesh_batches_by_texture(void) {
+    EseDrawListObject *sprite = draw_list_request_object(g_draw_list);
+    draw_list_object_set_texture(sprite, "tiles", 0.0f, 0.0f, 1.0f, 1.0f);
+    draw_list_object_set_bounds(sprite, 0.0f, 0.0f, 10, 10);
+    draw_list_object_set_z_index(sprite, 1);
+
+    EseDrawListObject *same = draw_list_request_object(g_draw_list);
+    draw_list_object_set_mesh(same, g_quad_verts, 4, g_quad_indices, 6, "tiles");
+    draw_list_object_set_z_index(same, 2);
+
+    EseDrawListObject *other = draw_list_request_object(g_draw_list);
+    draw_list_object_set_mesh(other, g_quad_verts, 4, g_quad_indices, 6, "trees");
+    draw_list_object_set_z_index(other, 3);
+
+    render_list_fill(g_render_list, g_draw_list);
+
+    TEST_ASSERT_EQUAL_size_t(2, render_list_get_batch_count(g_render_list));
+    const EseRenderBatch *first = render_list_get_batch(g_render_list, 0);
+    const EseRenderBatch *second = render_list_get_batch(g_render_list, 1);
+    TEST_ASSERT_EQUAL_STRING("tiles", first->shared_state.texture_id);
+    TEST_ASSERT_EQUAL_size_t(12, first->vertex_count);
+    TEST_ASSERT_EQUAL_STRING("trees", second->shared_state.texture_id);
+    TEST_ASSERT_EQUAL_size_t(6, second->vertex_count);
+}
+
+static void test_render_list_colors_share_batch(void) {
+    EseDrawListObject *red = draw_list_request_object(g_draw_list);
+    draw_list_object_set_rect_color(red, 255, 0, 0, 255, true);
+    draw_list_object_set_bounds(red, 0.0f, 0.0f, 10, 10);
+    draw_list_object_set_z_index(red, 1);
+
+    EseDrawListObject *outline = draw_list_request_object(g_draw_list);
+    draw_list_object_set_rect_color(outline, 0, 0, 255, 128, false);
+    draw_list_object_set_bounds(outline, 20.0f, 0.0f, 10, 10);
+    draw_list_object_set_z_index(outline, 2);
+
+    static const float triangle[] = {0.0f, 0.0f, 10.0f, 0.0f, 5.0f, 10.0f};
+    EseDrawListObject *poly = draw_list_request_object(g_draw_list);
+    draw_list_object_set_polyline(poly, triangle, 3, 1.0f);
+    draw_list_object_set_polyline_color(poly, 0, 255, 0, 255);
+    draw_list_object_set_polyline_stroke_color(poly, 1, 2, 3, 4);
+    draw_list_object_set_bounds(poly, 40.0f, 0.0f, 10, 10);
+    draw_list_object_set_z_index(poly, 3);
+
+    render_list_fill(g_render_list, g_draw_list);
+
+    // Filled rect (6), hollow rect (24), centroid fan (3 * 3) and stroke (2 * 6)
+    TEST_ASSERT_EQUAL_size_t(1, render_list_get_batch_count(g_render_list));
+    const EseRenderBatch *batch = render_list_get_batch(g_render_list, 0);
+    TEST_ASSERT_EQUAL_INT(RL_COLOR, batch->type);
+    TEST_ASSERT_EQUAL_size_t(6 + 24 + 9 + 12, batch->vertex_count);
+
+    const EseVertex *v = batch->vertex_buffer;
+    TEST_ASSERT_EQUAL_UINT(255, v[5].r);
+    TEST_ASSERT_EQUAL_UINT(0, v[5].b);
+    TEST_ASSERT_EQUAL_UINT(255, v[6].b);
+    TEST_ASSERT_EQUAL_UINT(128, v[29].a);
+    TEST_ASSERT_EQUAL_UINT(255, v[30].g);
+    TEST_ASSERT_EQUAL_UINT(255, v[38].a);
+    TEST_ASSERT_EQUAL_UINT(1, v[39].r);
+    TEST_ASSERT_EQUAL_UINT(4, v[50].a);
+}
+
+static void test_render_list_scissor_splits_color_batch(void) {
+    EseDrawListObject *first = draw_list_request_object(g_draw_list);
+    draw_list_object_set_rect_color(first, 255, 0, 0, 255, true);
+    draw_list_object_set_bounds(first, 0.0f, 0.0f, 10, 10);
+    draw_list_object_set_z_index(first, 1);
+
+    EseDrawListObject *clipped = draw_list_request_object(g_draw_list);
+    draw_list_object_set_rect_color(clipped, 255, 0, 0, 255, true);
+    draw_list_object_set_bounds(clipped, 0.0f, 0.0f, 10, 10);
+    draw_list_object_set_scissor(clipped, 0.0f, 0.0f, 5.0f, 5.0f);
+    draw_list_object_set_z_index(clipped, 2);
+
+    render_list_fill(g_render_list, g_draw_list);
+
+    TEST_ASSERT_EQUAL_size_t(2, render_list_get_batch_count(g_render_list));
+    TEST_ASSERT_FALSE(render_list_get_batch(g_render_list, 0)->scissor_active);
+    TEST_ASSERT_TRUE(render_list_get_batch(g_render_list, 1)->scissor_active);
+}
+
+static void test_render_list_tinted_sprites_share_batch(void) {
+    EseDrawListObject *plain = draw_list_request_object(g_draw_list);
+    draw_list_object_set_texture(plain, "tiles", 0.0f, 0.0f, 1.0f, 1.0f);
+    draw_list_object_set_bounds(plain, 0.0f, 0.0f, 10, 10);
+    draw_list_object_set_z_index(plain, 1);
+
+    EseDrawListObject *tinted = draw_list_request_object(g_draw_list);
+    draw_list_object_set_texture(tinted, "tiles", 0.0f, 0.0f, 1.0f, 1.0f);
+    draw_list_object_set_texture_tint(tinted, 255, 64, 32, 200);
+    draw_list_object_set_bounds(tinted, 10.0f, 0.0f, 10, 10);
+    draw_list_object_set_z_index(tinted, 2);
+
+    render_list_fill(g_render_list, g_draw_list);
+
+    TEST_ASSERT_EQUAL_size_t(1, render_list_get_batch_count(g_render_list));
+    const EseRenderBatch *batch = render_list_get_batch(g_render_list, 0);
+    TEST_ASSERT_EQUAL_size_t(12, batch->vertex_count);
+    for (size_t i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL_UINT(255, batch->vertex_buffer[i].g);
+        TEST_ASSERT_EQUAL_UINT(255, batch->vertex_buffer[i].a);
+    }
+    for (size_t i = 6; i < 12; i++) {
+        TEST_ASSERT_EQUAL_UINT(64, batch->vertex_buffer[i].g);
+        TEST_ASSERT_EQUAL_UINT(200, batch->vertex_buffer[i].a);
+    }
+}
+
+static void test_render_list_batches_share_one_vertex_buffer(void) {
+    const char *textures[] = {"tiles", "trees", "tiles"};
+    for (int frame = 0; frame < 2; frame++) {
+        draw_list_clear(g_draw_list);
+        render_list_clear(g_render_list);
+
+        for (int i = 0; i < 3; i++) {
+            EseDrawListObject *sprite = draw_list_request_object(g_draw_list);
+            draw_list_object_set_texture(sprite, textures[i], 0.0f, 0.0f, 1.0f, 1.0f);
+            draw_list_object_set_bounds(sprite, 0.0f, 0.0f, 10, 10);
+            draw_list_object_set_z_index(sprite, i * 2);
+
+            EseDrawListObject *rect = draw_list_request_object(g_draw_list);
+            draw_list_object_set_rect_color(rect, 255, 0, 0, 255, true);
+            draw_list_object_set_bounds(rect, 0.0f, 0.0f, 10, 10);
+            draw_list_object_set_z_index(rect, i * 2 + 1);
+        }
+
+        render_list_fill(g_render_list, g_draw_list);
+
+        // Batches are back-to-back ranges of the list's vertex buffer
+        size_t vertex_count;
+        const EseVertex *vertices = render_list_get_vertices(g_render_list, &vertex_count);
+        TEST_ASSERT_EQUAL_size_t(36, vertex_count);
+        TEST_ASSERT_EQUAL_size_t(6, render_list_get_batch_count(g_render_list));
+        size_t next = 0;
+        for (size_t i = 0; i < 6; i++) {
+            const EseRenderBatch *batch = render_list_get_batch(g_render_list, i);
+            TEST_ASSERT_EQUAL_size_t(next, batch->vertex_first);
+            TEST_ASSERT_EQUAL_PTR(&vertices[next], batch->vertex_buffer);
+            next += batch->vertex_count;
+        }
+
+        // Each texture is listed once, and batches refer to it by index
+        TEST_ASSERT_EQUAL_size_t(2, render_list_get_texture_count(g_render_list));
+        TEST_ASSERT_EQUAL_STRING("tiles", render_list_get_texture(g_render_list, 0));
+        TEST_ASSERT_EQUAL_STRING("trees", render_list_get_texture(g_render_list, 1));
+        TEST_ASSERT_EQUAL_size_t(0, render_list_get_batch(g_render_list, 0)->texture_index);
+        TEST_ASSERT_EQUAL_size_t(1, render_list_get_batch(g_render_list, 2)->texture_index);
+        TEST_ASSERT_EQUAL_size_t(0, render_list_get_batch(g_render_list, 4)->texture_index);
+    }
+}
+
+int main(void) {
+    log_init();
+
+    printf("\nRender List Tests\n");
+    printf("-----------------\n");
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_render_list_mesh_expands_indices);
+    RUN_TEST(test_render_list_mesh_batches_by_texture);
+    RUN_TEST(test_render_list_colors_share_batch);
+    RUN_TEST(test_render_list_scissor_splits_color_batch);
+    RUN_TEST(test_render_list_tinted_sprites_share_batch);
+    RUN_TEST(test_render_list_batches_share_one_vertex_buffer);
+
+    memory_manager.destroy(true);
+
+    return UNITY_END();
+}
@@ -10,8 +10,8 @@
 #include "../src/entity/entity.h"
 #include "../src/entity/entity_private.h"
 #include "../src/types/scene.h"
-#include "../src/utility/double_linked_list.h"
 #include "../src/utility/log.h"
+#include "../src/utility/slot_map.h"
 
 static EseEngine *g_engine = NULL;
 
@@ -55,10 +55,9 @@ static void test_scene_snapshot_and_run_core_fields(void) {
     // After clear/update, only the persistent entity should remain
     size_t persistent_count = 0;
     size_t temp_count = 0;
-    EseDListIter *iter = dlist_iter_create(g_engine->entities);
-    void *value = NULL;
-    while (dlist_iter_next(iter, &value)) {
-        EseEntity *e = (EseEntity *)value;
+    EseEntity **entities = (EseEntity **)slot_map_values(g_engine->entities);
+    for (size_t i = 0; i < slot_map_size(g_engine->entities); i++) {
+        EseEntity *e = entities[i];
         if (entity_get_persistent(e)) {
             persistent_count++;
         }
@@ -66,7 +65,6 @@ static void test_scene_snapshot_and_run_core_fields(void) {
             temp_count++;
         }
     }
-    dlist_iter_free(iter);
 
     TEST_ASSERT_EQUAL_size_t(1, persistent_count);
     TEST_ASSERT_EQUAL_size_t(0, temp_count);
@@ -76,10 +74,9 @@ static void test_scene_snapshot_and_run_core_fields(void) {
 
     persistent_count = 0;
     temp_count = 0;
-    iter = dlist_iter_create(g_engine->entities);
-    value = NULL;
-    while (dlist_iter_next(iter, &value)) {
-        EseEntity *e = (EseEntity *)value;
+    entities = (EseEntity **)slot_map_values(g_engine->entities);
+    for (size_t i = 0; i < slot_map_size(g_engine->entities); i++) {
+        EseEntity *e = entities[i];
         if (entity_get_persistent(e)) {
             persistent_count++;
         }
@@ -87,7 +84,6 @@ static void test_scene_snapshot_and_run_core_fields(void) {
             temp_count++;
         }
     }
-    dlist_iter_free(iter);
 
     TEST_ASSERT_EQUAL_size_t(1, persistent_count);
     TEST_ASSERT_EQUAL_size_t(1, temp_count);
@@ -10,6 +10,7 @@
 #include "testing.h"
 
 #include "../src/core/system_manager.h"
+#include "../src/core/system_manager_private.h"
 #include "../src/core/engine.h"
 #include "../src/core/engine_private.h"
 #include "../src/core/memory_manager.h"
@@ -17,6 +18,7 @@
 #include "../src/entity/components/entity_component_private.h"
 #include "../src/entity/entity.h"
 #include "../src/utility/log.h"
+#include "../src/utility/thread.h"
 
 /**
  * Test function declarations
@@ -34,9 +36,16 @@ static void test_engine_run_phase_lua(void);
 static void test_engine_run_phase_late(void);
 static void test_engine_run_phase_skips_inactive(void);
 static void test_engine_run_phase_parallel(void);
+static void test_engine_run_phases_orders_conflicts(void);
+static void test_engine_run_phases_independent_across_phases(void);
+static void test_engine_run_phases_undeclared_keeps_barrier(void);
+static void test_engine_run_phases_lua_on_main_thread(void);
+static void test_engine_schedule_dump_critical_path(void);
 static void test_engine_notify_comp_add(void);
 static void test_engine_notify_comp_rem(void);
 static void test_system_accepts_filter(void);
+static void test_system_component_mask_routing(void);
+static void test_system_track_swap_remove(void);
 static void test_system_user_data(void);
 
 /**
@@ -51,6 +60,12 @@ static int g_accepts_called = 0;
 static float g_last_dt = 0.0f;
 static EseEngine *g_last_engine = NULL;
 static EseEntityComponent *g_last_component = NULL;
+static EseEntityComponent *g_tracked[8];
+static size_t g_tracked_count = 0;
+static EseMutex *g_order_mutex = NULL;
+static const char *g_order[8];
+static size_t g_order_count = 0;
+static bool g_lua_on_main = false;
 
 /**
  * Reset global test state
@@ -65,6 +80,9 @@ static void reset_test_state(void) {
     g_last_dt = 0.0f;
     g_last_engine = NULL;
     g_last_component = NULL;
+    g_tracked_count = 0;
+    g_order_count = 0;
+    g_lua_on_main = false;
 }
 
 /**
@@ -72,13 +90,15 @@ static void reset_test_state(void) {
  */
 void setUp(void) {
     reset_test_state();
+    g_order_mutex = ese_mutex_create();
 }
 
 /**
  * Unity tearDown - called after each test
  */
 void tearDown(void) {
-    // Nothing to do
+    ese_mutex_destroy(g_order_mutex);
+    g_order_mutex = NULL;
 }
 
 /**
@@ -100,6 +120,38 @@ static EseSystemJobResult test_sys_update(EseSystemManager *self, EseEngine *eng
     return res;
 }
 
+static EseSystemJobResult test_sys_update_ordered(EseSystemManager *self, EseEngine *eng,
+                                                  float dt) {
+    (void)eng;
+    (void)dt;
+    ese_mutex_lock(g_order_mutex);
+    g_order[g_order_count++] = self->vt->name;
+    ese_mutex_unlock(g_order_mutex);
+
+    EseSystemJobResult res = {0};
+    return res;
+}
+
+static EseSystemJobResult test_sys_update_lua(EseSystemManager *self, EseEngine *eng, float dt) {
+    g_lua_on_main = ese_thread_id_equal(ese_thread_current_id(), *(EseThreadId *)self->data);
+    return test_sys_update_ordered(self, eng, dt);
+}
+
+static void deactivate_builtin_systems(EseEngine *engine) {
+    for (size_t i = 0; i < engine->sys_count; i++) {
+        engine->systems[i]->active = false;
+    }
+}
+
+static size_t order_of(const char *name) {
+    for (size_t i = 0; i < g_order_count; i++) {
+        if (strcmp(g_order[i], name) == 0) {
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
 static bool test_sys_accepts(EseSystemManager *self, const EseEntityComponent *comp) {
     (void)self;
     (void)comp;
@@ -128,6 +180,24 @@ static void test_sys_on_comp_rem(EseSystemManager *self, EseEngine *eng, EseEnti
     g_last_component = comp;
 }
 
+static void test_sys_track_add(EseSystemManager *self, EseEngine *eng, EseEntityComponent *comp) {
+    (void)eng;
+    system_manager_track(self, comp, g_tracked_count);
+    g_tracked[g_tracked_count++] = comp;
+}
+
+static void test_sys_track_rem(EseSystemManager *self, EseEngine *eng, EseEntityComponent *comp) {
+    (void)eng;
+    size_t i = system_manager_tracked_index(self, comp);
+    if (i >= g_tracked_count || g_tracked[i] != comp) {
+        return;
+    }
+    g_tracked[i] = g_tracked[--g_tracked_count];
+    if (i < g_tracked_count) {
+        system_manager_track(self, g_tracked[i], i);
+    }
+}
+
 static void test_sys_shutdown(EseSystemManager *self, EseEngine *eng) {
     (void)self;
     g_shutdown_called++;
@@ -407,6 +477,158 @@ static void test_engine_run_phase_parallel(void) {
     engine_destroy(engine);
 }
 
+/**
+ * Test: A system that reads what an earlier one writes runs after it
+ */
+static void test_engine_run_phases_orders_conflicts(void) {
+    EseEngine *engine = engine_create(NULL);
+    deactivate_builtin_systems(engine);
+    EseSystemManagerVTable writer = {
+        .name = "writer",
+        .update = test_sys_update_ordered,
+        .writes = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SPRITE)},
+    };
+    EseSystemManagerVTable reader = {
+        .name = "reader",
+        .update = test_sys_update_ordered,
+        .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SPRITE)},
+    };
+    engine_add_system(engine, system_manager_create(&writer, SYS_PHASE_EARLY, NULL));
+    engine_add_system(engine, system_manager_create(&reader, SYS_PHASE_EARLY, NULL));
+
+    for (int frame = 0; frame < 20; frame++) {
+        g_order_count = 0;
+        engine_run_phases(engine, SYS_PHASE_EARLY, SYS_PHASE_LATE, 0.016f);
+        TEST_ASSERT_EQUAL_size_t(2, g_order_count);
+        TEST_ASSERT_TRUE(order_of("writer") < order_of("reader"));
+    }
+
+    engine_destroy(engine);
+}
+
+/**
+ * Test: Declared systems with disjoint access do not wait for each other across phases
+ */
+static void test_engine_run_phases_independent_across_phases(void) {
+    EseEngine *engine = engine_create(NULL);
+    deactivate_builtin_systems(engine);
+    EseSystemManagerVTable early = {
+        .name = "early",
+        .update = test_sys_update_ordered,
+        .writes = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SPRITE)},
+    };
+    EseSystemManagerVTable script = {
+        .name = "script",
+        .update = test_sys_update_ordered,
+        .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_MAP)},
+    };
+    engine_add_system(engine, system_manager_create(&early, SYS_PHASE_EARLY, NULL));
+    engine_add_system(engine, system_manager_create(&script, SYS_PHASE_LUA, NULL));
+
+    engine_run_phases(engine, SYS_PHASE_EARLY, SYS_PHASE_LUA, 0.016f);
+    TEST_ASSERT_EQUAL_size_t(2, g_order_count);
+
+    char dump[1024];
+    engine_schedule_dump(engine, dump, sizeof(dump));
+    TEST_ASSERT_NOT_NULL(strstr(dump, "script           main"));
+    TEST_ASSERT_NOT_NULL(strstr(dump, "early            worker"));
+    TEST_ASSERT_NULL(strstr(dump, "after: early"));
+
+    engine_destroy(engine);
+}
+
+/**
+ * Test: Systems without declarations still wait for every earlier phase
+ */
+static void test_engine_run_phases_undeclared_keeps_barrier(void) {
+    EseEngine *engine = engine_create(NULL);
+    deactivate_builtin_systems(engine);
+    EseSystemManagerVTable early_a = {.name = "early_a", .update = test_sys_update_ordered};
+    EseSystemManagerVTable early_b = {.name = "early_b", .update = test_sys_update_ordered};
+    EseSystemManagerVTable script = {
+        .name = "script",
+        .update = test_sys_update_ordered,
+        .reads = {.components = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_MAP)},
+    };
+    engine_add_system(engine, system_manager_create(&script, SYS_PHASE_LUA, NULL));
+    engine_add_system(engine, system_manager_create(&early_a, SYS_PHASE_EARLY, NULL));
+    engine_add_system(engine, system_manager_create(&early_b, SYS_PHASE_EARLY, NULL));
+
+    engine_run_phases(engine, SYS_PHASE_EARLY, SYS_PHASE_LUA, 0.016f);
+    TEST_ASSERT_EQUAL_size_t(3, g_order_count);
+    TEST_ASSERT_EQUAL_size_t(2, order_of("script"));
+
+    char dump[1024];
+    engine_schedule_dump(engine, dump, sizeof(dump));
+    TEST_ASSERT_NOT_NULL(strstr(dump, "after: early_a early_b"));
+
+    engine_destroy(engine);
+}
+
+/**
+ * Test: LUA phase systems run on the thread that drives the schedule
+ */
+static void test_engine_run_phases_lua_on_main_thread(void) {
+    EseEngine *engine = engine_create(NULL);
+    deactivate_builtin_systems(engine);
+    EseThreadId main_id = ese_thread_current_id();
+    EseSystemManagerVTable script = {
+        .name = "script",
+        .update = test_sys_update_lua,
+        .reads = {.resources = SYS_RES_LUA},
+        .writes = {.resources = SYS_RES_LUA},
+    };
+    engine_add_system(engine, system_manager_create(&script, SYS_PHASE_LUA, &main_id));
+
+    engine_run_phases(engine, SYS_PHASE_EARLY, SYS_PHASE_LUA, 0.016f);
+    TEST_ASSERT_EQUAL_size_t(1, g_order_count);
+    TEST_ASSERT_TRUE(g_lua_on_main);
+
+    engine_destroy(engine);
+}
+
+/**
+ * Test: The schedule dump ends each range with its critical path
+ */
+static void test_engine_schedule_dump_critical_path(void) {
+    EseEngine *engine = engine_create(NULL);
+    deactivate_builtin_systems(engine);
+    EseSystemManagerVTable first = {
+        .name = "first",
+        .update = test_sys_update_ordered,
+        .writes = {.resources = SYS_RES_TRANSFORMS},
+    };
+    EseSystemManagerVTable second = {
+        .name = "second",
+        .update = test_sys_update_ordered,
+        .reads = {.resources = SYS_RES_TRANSFORMS},
+        .writes = {.resources = SYS_RES_CAMERA},
+    };
+    EseSystemManagerVTable third = {
+        .name = "third",
+        .update = test_sys_update_ordered,
+        .reads = {.resources = SYS_RES_CAMERA},
+    };
+    engine_add_system(engine, system_manager_create(&first, SYS_PHASE_EARLY, NULL));
+    engine_add_system(engine, system_manager_create(&second, SYS_PHASE_EARLY, NULL));
+    engine_add_system(engine, system_manager_create(&third, SYS_PHASE_LATE, NULL));
+
+    engine_run_phases(engine, SYS_PHASE_EARLY, SYS_PHASE_LATE, 0.016f);
+
+    char dump[2048];
+    size_t len = engine_schedule_dump(engine, dump, sizeof(dump));
+    TEST_ASSERT_EQUAL_size_t(strlen(dump), len);
+    TEST_ASSERT_NOT_NULL(strstr(dump, "EARLY..LATE: 3 systems"));
+    TEST_ASSERT_NOT_NULL(strstr(dump, "critical path: first -> second -> third"));
+
+    // A short buffer is truncated but still reports the full length
+    char small[16];
+    TEST_ASSERT_EQUAL_size_t(len, engine_schedule_dump(engine, small, sizeof(small)));
+    TEST_ASSERT_EQUAL_size_t(sizeof(small) - 1, strlen(small));
+
+    engine_destroy(engine);
+}
+
 /**
  * Test: Component added notification
  */
@@ -493,6 +715,100 @@ static void test_system_accepts_filter(void) {
     engine_destroy(engine);
 }
 
+/**
+ * Test: Systems with a component mask only hear about those types
+ */
+static void test_system_component_mask_routing(void) {
+    reset_test_state();
+
+    EseEngine *engine = engine_create(NULL);
+    EseSystemManagerVTable vt = {
+        .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_SPRITE),
+        .accepts = test_sys_accepts,
+        .on_component_added = test_sys_on_comp_add,
+        .on_component_removed = test_sys_on_comp_rem
+    };
+
+    EseSystemManager *sys = system_manager_create(&vt, SYS_PHASE_EARLY, NULL);
+    engine_add_system(engine, sys);
+
+    EseEntityComponent *lua_comp =
+        memory_manager.calloc(1, sizeof(EseEntityComponent), MMTAG_ENTITY);
+    lua_comp->type = ENTITY_COMPONENT_LUA;
+    EseEntityComponent *sprite_comp =
+        memory_manager.calloc(1, sizeof(EseEntityComponent), MMTAG_ENTITY);
+    sprite_comp->type = ENTITY_COMPONENT_SPRITE;
+    sprite_comp->data = sprite_comp; // Built-in systems reach the base through data
+
+    engine_notify_comp_add(engine, lua_comp);
+    TEST_ASSERT_EQUAL_INT(0, g_comp_added_called);
+
+    engine_notify_comp_add(engine, sprite_comp);
+    engine_notify_comp_rem(engine, sprite_comp);
+    TEST_ASSERT_EQUAL_INT(1, g_comp_added_called);
+    TEST_ASSERT_EQUAL_INT(1, g_comp_removed_called);
+    TEST_ASSERT_EQUAL_PTR(sprite_comp, g_last_component);
+
+    // The mask replaces accepts
+    TEST_ASSERT_EQUAL_INT(0, g_accepts_called);
+
+    memory_manager.free(lua_comp);
+    memory_manager.free(sprite_comp);
+    engine_destroy(engine);
+}
+
+/**
+ * Test: Tracked indexes follow components through swap-removal
+ */
+static void test_system_track_swap_remove(void) {
+    reset_test_state();
+
+    EseEngine *engine = engine_create(NULL);
+    EseSystemManagerVTable vt = {
+        .component_mask = ENTITY_COMPONENT_BIT(ENTITY_COMPONENT_TEXT),
+        .on_component_added = test_sys_track_add,
+        .on_component_removed = test_sys_track_rem
+    };
+
+    EseSystemManager *sys = system_manager_create(&vt, SYS_PHASE_EARLY, NULL);
+    engine_add_system(engine, sys);
+
+    EseEntityComponent *comps[4];
+    for (int i = 0; i < 4; i++) {
+        comps[i] = memory_manager.calloc(1, sizeof(EseEntityComponent), MMTAG_ENTITY);
+        comps[i]->type = ENTITY_COMPONENT_TEXT;
+        comps[i]->data = comps[i]; // Built-in systems reach the base through data
+    }
+
+    // Never added: no index
+    TEST_ASSERT_EQUAL_size_t(SYSTEM_MANAGER_UNTRACKED,
+                             system_manager_tracked_index(sys, comps[3]));
+
+    for (int i = 0; i < 3; i++) {
+        engine_notify_comp_add(engine, comps[i]);
+        TEST_ASSERT_EQUAL_size_t((size_t)i, system_manager_tracked_index(sys, comps[i]));
+    }
+
+    // Removing the first moves the last into its place
+    engine_notify_comp_rem(engine, comps[0]);
+    TEST_ASSERT_EQUAL_size_t(2, g_tracked_count);
+    TEST_ASSERT_EQUAL_PTR(comps[2], g_tracked[0]);
+    TEST_ASSERT_EQUAL_size_t(0, system_manager_tracked_index(sys, comps[2]));
+
+    // Removing a component that was never tracked leaves the array alone
+    engine_notify_comp_rem(engine, comps[3]);
+    TEST_ASSERT_EQUAL_size_t(2, g_tracked_count);
+
+    engine_notify_comp_rem(engine, comps[2]);
+    engine_notify_comp_rem(engine, comps[1]);
+    TEST_ASSERT_EQUAL_size_t(0, g_tracked_count);
+
+    for (int i = 0; i < 4; i++) {
+        memory_manager.free(comps[i]);
+    }
+    engine_destroy(engine);
+}
+
 /**
  * Test: System user data is passed to callbacks
  */
@@ -532,9 +848,16 @@ int main(void) {
     RUN_TEST(test_engine_run_phase_late);
     RUN_TEST(test_engine_run_phase_skips_inactive);
     RUN_TEST(test_engine_run_phase_parallel);
+    RUN_TEST(test_engine_run_phases_orders_conflicts);
+    RUN_TEST(test_engine_run_phases_independent_across_phases);
+    RUN_TEST(test_engine_run_phases_undeclared_keeps_barrier);
+    RUN_TEST(test_engine_run_phases_lua_on_main_thread);
+    RUN_TEST(test_engine_schedule_dump_critical_path);
     RUN_TEST(test_engine_notify_comp_add);
     RUN_TEST(test_engine_notify_comp_rem);
     RUN_TEST(test_system_accepts_filter);
+    RUN_TEST(test_system_component_mask_routing);
+    RUN_TEST(test_system_track_swap_remove);
     RUN_TEST(test_system_user_data);
 
     return UNITY_END();
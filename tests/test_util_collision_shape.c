@@ -0,0 +1,180 @@
+/*
+ * test_util_collision_shape.c - Unity-based tests for utility/collision_shape
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "testing.h"
+
+#include "../src/core/memory_manager.h"
+#include "../src/scripting/lua_engine.h"
+#include "../src/types/rect.h"
+#include "../src/utility/collision_shape.h"
+#include "../src/utility/log.h"
+
+/**
+ * Test Functions Declarations
+ */
+static void test_collision_shape_matches_rect_intersects(void);
+static void test_collision_shape_set_first_overlap_matches_pairwise(void);
+static void test_collision_shape_set_clear_resets_lanes(void);
+
+/**
+ * Test suite setup and teardown
+ */
+static EseLuaEngine *g_engine = NULL;
+
+void setUp(void) { g_engine = create_test_engine(); }
+
+void tearDown(void) {
+    lua_engine_destroy(g_engine);
+    g_engine = NULL;
+}
+
+/**
+ * Helpers
+ */
+static uint32_t g_seed = 12345u;
+
+static float rand_range(float lo, float hi) {
+    g_seed = g_seed * 1664525u + 1013904223u;
+    return lo + (hi - lo) * (float)(g_seed >> 8) / (float)(1u << 24);
+}
+
+// Random rect near the origin; roughly a third are rotated
+static void randomize_rect(EseRect *rect) {
+    ese_rect_set_x(rect, rand_range(-40.0f, 40.0f));
+    ese_rect_set_y(rect, rand_range(-40.0f, 40.0f));
+    ese_rect_set_width(rect, rand_range(1.0f, 30.0f));
+    ese_rect_set_height(rect, rand_range(1.0f, 30.0f));
+    ese_rect_set_rotation(rect, rand_range(0.0f, 3.0f) < 1.0f ? rand_range(-3.0f, 3.0f) : 0.0f);
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    log_init();
+
+    printf("\nCollisionShape Tests\n");
+    printf("--------------------\n");
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_collision_shape_matches_rect_intersects);
+    RUN_TEST(test_collision_shape_set_first_overlap_matches_pairwise);
+    RUN_TEST(test_collision_shape_set_clear_resets_lanes);
+
+    memory_manager.destroy(true);
+
+    return UNITY_END();
+}
+
+/**
+ * Test Functions
+ */
+
+static void test_collision_shape_matches_rect_intersects(void) {
+    EseRect *a = ese_rect_create(g_engine);
+    EseRect *b = ese_rect_create(g_engine);
+
+    for (int i = 0; i < 5000; i++) {
+        randomize_rect(a);
+        randomize_rect(b);
+        float dx = rand_range(-10.0f, 10.0f), dy = rand_range(-10.0f, 10.0f);
+
+        EseCollisionShape sa, sb;
+        collision_shape_from_rect(&sa, a, dx, dy);
+        collision_shape_from_rect(&sb, b, 0.0f, 0.0f);
+        TEST_ASSERT_EQUAL(ese_rect_intersects_offset(a, dx, dy, b, 0.0f, 0.0f),
+                          collision_shape_overlaps(&sa, &sb));
+    }
+
+    // Touching edges count as overlap, as in ese_rect_intersects
+    ese_rect_set_x(a, 0.0f);
+    ese_rect_set_y(a, 0.0f);
+    ese_rect_set_width(a, 10.0f);
+    ese_rect_set_height(a, 10.0f);
+    ese_rect_set_rotation(a, 0.0f);
+    EseCollisionShape sa, sb;
+    collision_shape_from_rect(&sa, a, 0.0f, 0.0f);
+    collision_shape_from_rect(&sb, a, 10.0f, 0.0f);
+    TEST_ASSERT_TRUE(collision_shape_overlaps(&sa, &sb));
+
+    ese_rect_destroy(a);
+    ese_rect_destroy(b);
+}
+
+static void test_collision_shape_set_first_overlap_matches_pairwise(void) {
+    enum { COUNT = 23 };
+    EseRect *rect = ese_rect_create(g_engine);
+    EseCollisionShapeSet set;
+    collision_shape_set_init(&set);
+
+    for (int round = 0; round < 200; round++) {
+        collision_shape_set_clear(&set);
+        int count = 1 + round % COUNT;
+        for (int i = 0; i < count; i++) {
+            randomize_rect(rect);
+            EseCollisionShape shape;
+            collision_shape_from_rect(&shape, rect, 60.0f, 0.0f);
+            collision_shape_set_push(&set, &shape);
+        }
+        TEST_ASSERT_EQUAL_size_t(count, set.count);
+        TEST_ASSERT_EQUAL_size_t(0, set.capacity % COLLISION_SHAPE_LANES);
+
+        for (int probe = 0; probe < 20; probe++) {
+            randomize_rect(rect);
+            EseCollisionShape shape;
+            collision_shape_from_rect(&shape, rect, rand_range(20.0f, 100.0f), 0.0f);
+
+            size_t expected = set.count;
+            for (size_t j = 0; j < set.count; j++) {
+                if (collision_shape_overlaps(&shape, &set.shapes[j])) {
+                    expected = j;
+                    break;
+                }
+            }
+
+            size_t index = set.count;
+            bool hit = collision_shape_set_first_overlap(&set, &shape, &index);
+            TEST_ASSERT_EQUAL(expected < set.count, hit);
+            TEST_ASSERT_EQUAL_size_t(expected, index);
+        }
+    }
+
+    collision_shape_set_free(&set);
+    ese_rect_destroy(rect);
+}
+
+static void test_collision_shape_set_clear_resets_lanes(void) {
+    EseRect *rect = ese_rect_create(g_engine);
+    ese_rect_set_width(rect, 10.0f);
+    ese_rect_set_height(rect, 10.0f);
+
+    EseCollisionShapeSet set;
+    collision_shape_set_init(&set);
+    EseCollisionShape shape;
+    for (int i = 0; i < 6; i++) {
+        collision_shape_from_rect(&shape, rect, (float)(i * 100), 0.0f);
+        collision_shape_set_push(&set, &shape);
+    }
+
+    // Stale lanes left from before the clear must not be reported
+    collision_shape_set_clear(&set);
+    collision_shape_from_rect(&shape, rect, 0.0f, 0.0f);
+    collision_shape_set_push(&set, &shape);
+
+    EseCollisionShape probe;
+    collision_shape_from_rect(&probe, rect, 500.0f, 0.0f);
+    TEST_ASSERT_FALSE(collision_shape_set_first_overlap(&set, &probe, NULL));
+    collision_shape_from_rect(&probe, rect, 5.0f, 5.0f);
+    TEST_ASSERT_TRUE(collision_shape_set_first_overlap(&set, &probe, NULL));
+
+    collision_shape_set_free(&set);
+    ese_rect_destroy(rect);
+}
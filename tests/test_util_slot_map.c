@@ -0,0 +1,230 @@
+/*
+* test_util_slot_map.c - Unity-based tests for utility/slot_map
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "testing.h"
+
+#include "../src/core/memory_manager.h"
+#include "../src/utility/log.h"
+#include "../src/utility/slot_map.h"
+
+/**
+* Test Functions Declarations
+*/
+static void test_slot_map_create_and_destroy(void);
+static void test_slot_map_insert_get(void);
+static void test_slot_map_remove_invalidates_handle(void);
+static void test_slot_map_remove_keeps_values_dense(void);
+static void test_slot_map_reused_slot_gets_new_generation(void);
+static void test_slot_map_clear_invalidates_all_handles(void);
+static void test_slot_map_generation_wrap_retires_slot(void);
+static void test_slot_map_many_values_integrity(void);
+
+/**
+* Unity setUp/tearDown (required symbols)
+*/
+void setUp(void) {}
+void tearDown(void) {}
+
+static int g_values[1024];
+
+/**
+* Main test runner
+*/
+int main(void) {
+    log_init();
+
+    printf("\nSlotMap Tests\n");
+    printf("-------------\n");
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_slot_map_create_and_destroy);
+    RUN_TEST(test_slot_map_insert_get);
+    RUN_TEST(test_slot_map_remove_invalidates_handle);
+    RUN_TEST(test_slot_map_remove_keeps_values_dense);
+    RUN_TEST(test_slot_map_reused_slot_gets_new_generation);
+    RUN_TEST(test_slot_map_clear_invalidates_all_handles);
+    RUN_TEST(test_slot_map_generation_wrap_retires_slot);
+    RUN_TEST(test_slot_map_many_values_integrity);
+
+    memory_manager.destroy(true);
+
+    return UNITY_END();
+}
+
+static void test_slot_map_create_and_destroy(void) {
+    EseSlotMap *map = slot_map_create(0);
+    TEST_ASSERT_NOT_NULL(map);
+    TEST_ASSERT_EQUAL_size_t(0, slot_map_size(map));
+    TEST_ASSERT_NULL(slot_map_get(map, SLOT_MAP_NULL_HANDLE));
+    TEST_ASSERT_EQUAL_UINT32(SLOT_MAP_NULL_HANDLE, slot_map_handle_at(map, 0));
+    slot_map_destroy(map);
+
+    /* Destroying NULL is a no-op */
+    slot_map_destroy(NULL);
+}
+
+static void test_slot_map_insert_get(void) {
+    EseSlotMap *map = slot_map_create(2);
+    EseSlotHandle a = slot_map_insert(map, &g_values[0]);
+    EseSlotHandle b = slot_map_insert(map, &g_values[1]);
+    EseSlotHandle c = slot_map_insert(map, &g_values[2]);
+
+    TEST_ASSERT_NOT_EQUAL(SLOT_MAP_NULL_HANDLE, a);
+    TEST_ASSERT_NOT_EQUAL(a, b);
+    TEST_ASSERT_NOT_EQUAL(b, c);
+    TEST_ASSERT_EQUAL_size_t(3, slot_map_size(map));
+    TEST_ASSERT_EQUAL_PTR(&g_values[0], slot_map_get(map, a));
+    TEST_ASSERT_EQUAL_PTR(&g_values[1], slot_map_get(map, b));
+    TEST_ASSERT_EQUAL_PTR(&g_values[2], slot_map_get(map, c));
+
+    /* Values are dense in insertion order while nothing was removed */
+    void **values = slot_map_values(map);
+    TEST_ASSERT_EQUAL_PTR(&g_values[0], values[0]);
+    TEST_ASSERT_EQUAL_PTR(&g_values[2], values[2]);
+    TEST_ASSERT_EQUAL_UINT32(b, slot_map_handle_at(map, 1));
+
+    slot_map_destroy(map);
+}
+
+static void test_slot_map_remove_invalidates_handle(void) {
+    EseSlotMap *map = slot_map_create(0);
+    EseSlotHandle a = slot_map_insert(map, &g_values[0]);
+
+    TEST_ASSERT_EQUAL_PTR(&g_values[0], slot_map_remove(map, a));
+    TEST_ASSERT_EQUAL_size_t(0, slot_map_size(map));
+    TEST_ASSERT_NULL(slot_map_get(map, a));
+    TEST_ASSERT_NULL(slot_map_remove(map, a));
+    TEST_ASSERT_NULL(slot_map_remove(map, SLOT_MAP_NULL_HANDLE));
+
+    /* A handle to a slot that was never handed out */
+    TEST_ASSERT_NULL(slot_map_get(map, a + 7));
+
+    slot_map_destroy(map);
+}
+
+static void test_slot_map_remove_keeps_values_dense(void) {
+    EseSlotMap *map = slot_map_create(0);
+    EseSlotHandle handles[5];
+    for (int i = 0; i < 5; i++) {
+        handles[i] = slot_map_insert(map, &g_values[i]);
+    }
+
+    /* The last value moves into the hole */
+    slot_map_remove(map, handles[1]);
+    TEST_ASSERT_EQUAL_size_t(4, slot_map_size(map));
+    void **values = slot_map_values(map);
+    TEST_ASSERT_EQUAL_PTR(&g_values[0], values[0]);
+    TEST_ASSERT_EQUAL_PTR(&g_values[4], values[1]);
+    TEST_ASSERT_EQUAL_UINT32(handles[4], slot_map_handle_at(map, 1));
+
+    /* Handles of moved values still resolve */
+    for (int i = 0; i < 5; i++) {
+        if (i == 1) {
+            continue;
+        }
+        TEST_ASSERT_EQUAL_PTR(&g_values[i], slot_map_get(map, handles[i]));
+    }
+
+    /* Removing the last dense value moves nothing */
+    slot_map_remove(map, handles[3]);
+    TEST_ASSERT_EQUAL_size_t(3, slot_map_size(map));
+    TEST_ASSERT_EQUAL_PTR(&g_values[2], slot_map_get(map, handles[2]));
+
+    slot_map_destroy(map);
+}
+
+static void test_slot_map_reused_slot_gets_new_generation(void) {
+    EseSlotMap *map = slot_map_create(0);
+    EseSlotHandle old = slot_map_insert(map, &g_values[0]);
+    slot_map_remove(map, old);
+
+    EseSlotHandle fresh = slot_map_insert(map, &g_values[1]);
+    TEST_ASSERT_NOT_EQUAL(old, fresh);
+    TEST_ASSERT_EQUAL_UINT32(old & (SLOT_MAP_MAX_SLOTS - 1u), fresh & (SLOT_MAP_MAX_SLOTS - 1u));
+    TEST_ASSERT_NULL(slot_map_get(map, old));
+    TEST_ASSERT_EQUAL_PTR(&g_values[1], slot_map_get(map, fresh));
+
+    slot_map_destroy(map);
+}
+
+static void test_slot_map_clear_invalidates_all_handles(void) {
+    EseSlotMap *map = slot_map_create(0);
+    EseSlotHandle handles[8];
+    for (int i = 0; i < 8; i++) {
+        handles[i] = slot_map_insert(map, &g_values[i]);
+    }
+
+    slot_map_clear(map);
+    TEST_ASSERT_EQUAL_size_t(0, slot_map_size(map));
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_NULL(slot_map_get(map, handles[i]));
+    }
+
+    /* Slots are reused afterwards */
+    EseSlotHandle h = slot_map_insert(map, &g_values[9]);
+    TEST_ASSERT_EQUAL_PTR(&g_values[9], slot_map_get(map, h));
+
+    slot_map_destroy(map);
+}
+
+static void test_slot_map_generation_wrap_retires_slot(void) {
+    EseSlotMap *map = slot_map_create(0);
+    uint32_t generations = 1u << (32 - SLOT_MAP_INDEX_BITS);
+
+    /* With a single free slot every insert reuses slot 0 until it is retired */
+    EseSlotHandle first = slot_map_insert(map, &g_values[0]);
+    EseSlotHandle h = first;
+    for (uint32_t i = 1; i < generations - 1; i++) {
+        slot_map_remove(map, h);
+        h = slot_map_insert(map, &g_values[0]);
+        TEST_ASSERT_EQUAL_UINT32(0, h & (SLOT_MAP_MAX_SLOTS - 1u));
+    }
+    slot_map_remove(map, h);
+
+    /* Slot 0 used its last generation; a new slot is handed out */
+    EseSlotHandle next = slot_map_insert(map, &g_values[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, next & (SLOT_MAP_MAX_SLOTS - 1u));
+    TEST_ASSERT_NULL(slot_map_get(map, first));
+    TEST_ASSERT_NULL(slot_map_get(map, h));
+    TEST_ASSERT_EQUAL_PTR(&g_values[1], slot_map_get(map, next));
+
+    slot_map_destroy(map);
+}
+
+static void test_slot_map_many_values_integrity(void) {
+    EseSlotMap *map = slot_map_create(4);
+    EseSlotHandle handles[1024];
+    for (int i = 0; i < 1024; i++) {
+        handles[i] = slot_map_insert(map, &g_values[i]);
+    }
+
+    /* Remove every odd value, then check the rest and the dense array */
+    for (int i = 1; i < 1024; i += 2) {
+        TEST_ASSERT_EQUAL_PTR(&g_values[i], slot_map_remove(map, handles[i]));
+    }
+    TEST_ASSERT_EQUAL_size_t(512, slot_map_size(map));
+    for (int i = 0; i < 1024; i++) {
+        if (i % 2) {
+            TEST_ASSERT_NULL(slot_map_get(map, handles[i]));
+        } else {
+            TEST_ASSERT_EQUAL_PTR(&g_values[i], slot_map_get(map, handles[i]));
+        }
+    }
+
+    void **values = slot_map_values(map);
+    for (size_t i = 0; i < slot_map_size(map); i++) {
+        int index = (int)((int *)values[i] - g_values);
+        TEST_ASSERT_EQUAL_INT(0, index % 2);
+        TEST_ASSERT_EQUAL_PTR(values[i], slot_map_get(map, slot_map_handle_at(map, i)));
+    }
+
+    slot_map_destroy(map);
+}
@@ -0,0 +1,477 @@
+/*
+ * test_util_spatial_index.c - Unity-based tests for utility/spatial_index
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+
+#include "testing.h"
+
+#include "../src/core/engine.h"
+#include "../src/core/engine_private.h"
+#include "../src/core/memory_manager.h"
+#include "../src/entity/components/collider.h"
+#include "../src/entity/components/entity_component.h"
+#include "../src/entity/entity.h"
+#include "../src/entity/entity_private.h"
+#include "../src/types/point.h"
+#include "../src/types/rect.h"
+#include "../src/utility/collision_shape.h"
+#include "../src/utility/log.h"
+#include "../src/utility/slot_map.h"
+#include "../src/utility/spatial_index.h"
+
+/**
+ * Test Functions Declarations
+ */
+static void test_spatial_index_registers_on_collider_add(void);
+static void test_spatial_index_unregisters_on_entity_destroy(void);
+static void test_spatial_index_pairs_follow_movement(void);
+static void test_spatial_index_small_moves_stay_in_fat_bounds(void);
+static void test_spatial_index_inactive_entities_are_skipped(void);
+static void test_spatial_index_pairs_match_brute_force(void);
+static void test_spatial_index_pairs_are_canonical(void);
+static void test_spatial_index_layers_filter_pairs(void);
+static void test_spatial_index_resting_pairs_are_skipped(void);
+static void test_spatial_index_query_rect_matches_brute_force(void);
+static void test_spatial_index_query_circle_is_exact(void);
+static void test_spatial_index_raycast_orders_hits(void);
+static void test_spatial_index_query_nearest_matches_brute_force(void);
+
+/**
+ * Test suite setup and teardown
+ */
+static EseEngine *g_engine = NULL;
+
+void setUp(void) { g_engine = engine_create(NULL); }
+
+void tearDown(void) {
+    if (g_engine) {
+        engine_destroy(g_engine);
+        g_engine = NULL;
+    }
+}
+
+/**
+ * Helpers
+ */
+static EseEntity *make_collider(float x, float y, float size) {
+    EseLuaEngine *lua = g_engine->lua_engine;
+    EseEntity *entity = entity_create(lua);
+    EseEntityComponent *collider = entity_component_collider_create(lua);
+    entity_component_add(entity, collider);
+
+    EseRect *rect = ese_rect_create(lua);
+    ese_rect_set_width(rect, size);
+    ese_rect_set_height(rect, size);
+    entity_component_collider_rects_add(
+        (EseEntityComponentCollider *)entity_component_get_data(collider), rect);
+
+    entity_set_position(entity, x, y);
+    engine_add_entity(g_engine, entity);
+    return entity;
+}
+
+static size_t sync_and_count_pairs(void) {
+    spatial_index_update(g_engine->spatial_index);
+    const SpatialPair *pairs = NULL;
+    return spatial_index_get_pairs(g_engine->spatial_index, &pairs);
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    log_init();
+
+    printf("\nSpatialIndex Tests\n");
+    printf("------------------\n");
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_spatial_index_registers_on_collider_add);
+    RUN_TEST(test_spatial_index_unregisters_on_entity_destroy);
+    RUN_TEST(test_spatial_index_pairs_follow_movement);
+    RUN_TEST(test_spatial_index_small_moves_stay_in_fat_bounds);
+    RUN_TEST(test_spatial_index_inactive_entities_are_skipped);
+    RUN_TEST(test_spatial_index_pairs_match_brute_force);
+    RUN_TEST(test_spatial_index_pairs_are_canonical);
+    RUN_TEST(test_spatial_index_layers_filter_pairs);
+    RUN_TEST(test_spatial_index_resting_pairs_are_skipped);
+    RUN_TEST(test_spatial_index_query_rect_matches_brute_force);
+    RUN_TEST(test_spatial_index_query_circle_is_exact);
+    RUN_TEST(test_spatial_index_raycast_orders_hits);
+    RUN_TEST(test_spatial_index_query_nearest_matches_brute_force);
+
+    return UNITY_END();
+}
+
+/**
+ * Test Functions
+ */
+
+static void test_spatial_index_registers_on_collider_add(void) {
+    TEST_ASSERT_EQUAL_size_t(0, spatial_index_get_count(g_engine->spatial_index));
+
+    EseEntity *entity = make_collider(0, 0, 10);
+    TEST_ASSERT_EQUAL_size_t(1, spatial_index_get_count(g_engine->spatial_index));
+    TEST_ASSERT_NOT_EQUAL(SPATIAL_INDEX_NULL_PROXY, entity->spatial_proxy);
+
+    // Entities without a collider or map never enter the index
+    EseEntity *plain = entity_create(g_engine->lua_engine);
+    engine_add_entity(g_engine, plain);
+    TEST_ASSERT_EQUAL_size_t(1, spatial_index_get_count(g_engine->spatial_index));
+    TEST_ASSERT_EQUAL_UINT32(SPATIAL_INDEX_NULL_PROXY, plain->spatial_proxy);
+}
+
+static void test_spatial_index_unregisters_on_entity_destroy(void) {
+    EseEntity *a = make_collider(0, 0, 10);
+    EseEntity *b = make_collider(5, 5, 10);
+    TEST_ASSERT_EQUAL_size_t(2, spatial_index_get_count(g_engine->spatial_index));
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+
+    slot_map_remove(g_engine->entities, entity_get_handle(b));
+    entity_destroy(b);
+    TEST_ASSERT_EQUAL_size_t(1, spatial_index_get_count(g_engine->spatial_index));
+    TEST_ASSERT_EQUAL_size_t(0, sync_and_count_pairs());
+
+    // The freed slot is reused
+    EseEntity *c = make_collider(5, 5, 10);
+    TEST_ASSERT_EQUAL_size_t(2, spatial_index_get_count(g_engine->spatial_index));
+    TEST_ASSERT_NOT_EQUAL(a->spatial_proxy, c->spatial_proxy);
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+}
+
+static void test_spatial_index_pairs_follow_movement(void) {
+    EseEntity *a = make_collider(0, 0, 20);
+    EseEntity *b = make_collider(500, 500, 20);
+    TEST_ASSERT_EQUAL_size_t(0, sync_and_count_pairs());
+
+    entity_set_position(b, 10, 10);
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+
+    // Crossing several cells
+    entity_set_position(a, 1000, -1000);
+    TEST_ASSERT_EQUAL_size_t(0, sync_and_count_pairs());
+    entity_set_position(b, 1005, -995);
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+}
+
+static void test_spatial_index_small_moves_stay_in_fat_bounds(void) {
+    EseEntity *a = make_collider(0, 0, 20);
+    EseEntity *b = make_collider(21, 0, 20);
+    TEST_ASSERT_EQUAL_size_t(0, sync_and_count_pairs());
+
+    // Moves inside the fat margin are not re-bucketed but must still be
+    // tested against the current bounds
+    entity_set_position(b, 19, 0);
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+    entity_set_position(b, 23, 0);
+    TEST_ASSERT_EQUAL_size_t(0, sync_and_count_pairs());
+    (void)a;
+}
+
+static void test_spatial_index_inactive_entities_are_skipped(void) {
+    make_collider(0, 0, 20);
+    EseEntity *b = make_collider(10, 10, 20);
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+
+    b->active = false;
+    TEST_ASSERT_EQUAL_size_t(0, sync_and_count_pairs());
+
+    b->active = true;
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+}
+
+static void test_spatial_index_pairs_match_brute_force(void) {
+    enum { COUNT = 200 };
+    EseEntity *entities[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        entities[i] = make_collider((float)((i * 37) % 400), (float)((i * 91) % 300), 24);
+    }
+
+    for (int step = 0; step < 4; step++) {
+        for (int i = step; i < COUNT; i += 7) {
+            entity_set_position(entities[i], (float)((i * 53 + step * 29) % 400),
+                                (float)((i * 17 + step * 61) % 300));
+        }
+
+        // World bounds follow the moves once the index has synced
+        size_t actual = sync_and_count_pairs();
+        size_t expected = 0;
+        for (int i = 0; i < COUNT; i++) {
+            for (int j = i + 1; j < COUNT; j++) {
+                if (ese_rect_intersects(entities[i]->collision_world_bounds,
+                                        entities[j]->collision_world_bounds)) {
+                    expected++;
+                }
+            }
+        }
+        TEST_ASSERT_EQUAL_size_t(expected, actual);
+    }
+}
+
+static void test_spatial_index_pairs_are_canonical(void) {
+    // Overlapping cluster spanning several cells so each pair is seen more than once
+    enum { COUNT = 12 };
+    for (int i = 0; i < COUNT; i++) {
+        make_collider((float)(i * 6), (float)(i * 4), 90);
+    }
+
+    spatial_index_update(g_engine->spatial_index);
+    const SpatialPair *pairs = NULL;
+    size_t count = spatial_index_get_pairs(g_engine->spatial_index, &pairs);
+    TEST_ASSERT_EQUAL_size_t(COUNT * (COUNT - 1) / 2, count);
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t lo = pairs[i].a->spatial_proxy;
+        uint32_t hi = pairs[i].b->spatial_proxy;
+        TEST_ASSERT_TRUE(lo < hi);
+        TEST_ASSERT_EQUAL_UINT64(((uint64_t)lo << 32) | hi, pairs[i].key);
+        for (size_t j = i + 1; j < count; j++) {
+            TEST_ASSERT_NOT_EQUAL(pairs[i].key, pairs[j].key);
+        }
+    }
+}
+
+static EseEntityComponentCollider *collider_of(EseEntity *entity) {
+    return (EseEntityComponentCollider *)entity_component_get_data(entity->components[0]);
+}
+
+static void test_spatial_index_layers_filter_pairs(void) {
+    EseEntity *bullet_a = make_collider(0, 0, 20);
+    EseEntity *bullet_b = make_collider(5, 5, 20);
+    EseEntity *wall = make_collider(10, 10, 20);
+    TEST_ASSERT_EQUAL_size_t(3, sync_and_count_pairs());
+
+    // Bullets on layer 2 only collide with walls on layer 1
+    entity_component_collider_set_layer(collider_of(bullet_a), 0x0002);
+    entity_component_collider_set_mask(collider_of(bullet_a), 0x0001);
+    entity_component_collider_set_layer(collider_of(bullet_b), 0x0002);
+    entity_component_collider_set_mask(collider_of(bullet_b), 0x0001);
+    TEST_ASSERT_EQUAL_size_t(2, sync_and_count_pairs());
+
+    // Both sides must accept: a wall that ignores layer 2 sees no bullets
+    entity_component_collider_set_mask(collider_of(wall), 0x0001);
+    TEST_ASSERT_EQUAL_size_t(0, sync_and_count_pairs());
+
+    TEST_ASSERT_TRUE(collision_filter_accepts(COLLISION_FILTER_ALL, wall->collision_filter));
+    TEST_ASSERT_FALSE(collision_filter_accepts(COLLISION_FILTER_PACK(0x0001, 0x0000),
+                                               COLLISION_FILTER_ALL));
+}
+
+static void test_spatial_index_resting_pairs_are_skipped(void) {
+    // Static bodies rest from the first update that does not move them
+    EseEntity *wall_a = make_collider(0, 0, 20);
+    EseEntity *wall_b = make_collider(10, 10, 20);
+    entity_component_collider_set_static(collider_of(wall_a), true);
+    entity_component_collider_set_static(collider_of(wall_b), true);
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+    TEST_ASSERT_FALSE(wall_a->collision_resting);
+    TEST_ASSERT_EQUAL_size_t(0, sync_and_count_pairs());
+    TEST_ASSERT_TRUE(wall_a->collision_resting);
+
+    // Dynamic bodies fall asleep after sleep_frames unchanged updates
+    spatial_index_set_sleep_frames(g_engine->spatial_index, 2);
+    EseEntity *body_a = make_collider(200, 200, 20);
+    EseEntity *body_b = make_collider(210, 210, 20);
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+    TEST_ASSERT_EQUAL_size_t(0, sync_and_count_pairs());
+    TEST_ASSERT_TRUE(body_a->collision_resting);
+
+    // A moving body wakes up and pairs with the sleeping one again
+    entity_set_position(body_b, 205, 205);
+    TEST_ASSERT_EQUAL_size_t(1, sync_and_count_pairs());
+    TEST_ASSERT_FALSE(body_b->collision_resting);
+
+    // So does a body that moves next to a resting wall
+    entity_set_position(body_b, 5, 5);
+    TEST_ASSERT_EQUAL_size_t(2, sync_and_count_pairs());
+}
+
+static bool contains_entity(EseEntity **entities, size_t count, EseEntity *entity) {
+    for (size_t i = 0; i < count; i++) {
+        if (entities[i] == entity)
+            return true;
+    }
+    return false;
+}
+
+static void test_spatial_index_query_rect_matches_brute_force(void) {
+    enum { COUNT = 200 };
+    EseEntity *entities[COUNT];
+    EseEntity *found[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        entities[i] = make_collider((float)((i * 37) % 800), (float)((i * 91) % 600), 24);
+    }
+
+    // Not in the grid until the next update
+    EseRect *rect = ese_rect_create(g_engine->lua_engine);
+    ese_rect_set_width(rect, 100);
+    ese_rect_set_height(rect, 100);
+    EseCollisionShape area;
+    collision_shape_from_rect(&area, rect, 0, 0);
+    TEST_ASSERT_EQUAL_size_t(0, spatial_index_query_rect(g_engine->spatial_index, &area,
+                                                         COLLIDER_MASK_ALL, found, COUNT));
+    spatial_index_update(g_engine->spatial_index);
+
+    // Small, rotated, and world-sized queries (the last one scans the proxies)
+    const float queries[][5] = {
+        {0, 0, 100, 100, 0}, {250, 120, 180, 60, 0.4f}, {-500, -500, 3000, 3000, 0}};
+    for (size_t q = 0; q < sizeof(queries) / sizeof(queries[0]); q++) {
+        ese_rect_set_x(rect, queries[q][0]);
+        ese_rect_set_y(rect, queries[q][1]);
+        ese_rect_set_width(rect, queries[q][2]);
+        ese_rect_set_height(rect, queries[q][3]);
+        ese_rect_set_rotation(rect, queries[q][4]);
+        collision_shape_from_rect(&area, rect, 0, 0);
+
+        size_t count = spatial_index_query_rect(g_engine->spatial_index, &area, COLLIDER_MASK_ALL,
+                                                found, COUNT);
+        size_t expected = 0;
+        for (int i = 0; i < COUNT; i++) {
+            if (entity_detect_collision_rect(entities[i], rect)) {
+                expected++;
+                TEST_ASSERT_TRUE(contains_entity(found, count, entities[i]));
+            }
+        }
+        TEST_ASSERT_EQUAL_size_t(expected, count);
+        TEST_ASSERT_TRUE(count > 0);
+
+        // The result buffer bounds the count
+        TEST_ASSERT_EQUAL_size_t(1, spatial_index_query_rect(g_engine->spatial_index, &area,
+                                                             COLLIDER_MASK_ALL, found, 1));
+    }
+
+    // Layer mask
+    entity_component_collider_set_layer(collider_of(entities[0]), 0x0004);
+    TEST_ASSERT_EQUAL_size_t(
+        1, spatial_index_query_rect(g_engine->spatial_index, &area, 0x0004, found, COUNT));
+    TEST_ASSERT_EQUAL_PTR(entities[0], found[0]);
+
+    ese_rect_destroy(rect);
+}
+
+static void test_spatial_index_query_circle_is_exact(void) {
+    EseEntity *box = make_collider(100, 100, 20);
+    EseEntity *far = make_collider(400, 400, 20);
+    EseEntity *found[4];
+    spatial_index_update(g_engine->spatial_index);
+
+    // The corner (100, 100) is sqrt(50) away: inside the circle's box, outside the circle
+    TEST_ASSERT_EQUAL_size_t(
+        0, spatial_index_query_circle(g_engine->spatial_index, 95, 95, 6, COLLIDER_MASK_ALL,
+                                      found, 4));
+    TEST_ASSERT_EQUAL_size_t(
+        1, spatial_index_query_circle(g_engine->spatial_index, 95, 95, 8, COLLIDER_MASK_ALL,
+                                      found, 4));
+    TEST_ASSERT_EQUAL_PTR(box, found[0]);
+
+    // Centre inside the box
+    TEST_ASSERT_EQUAL_size_t(
+        1, spatial_index_query_circle(g_engine->spatial_index, 110, 110, 1, COLLIDER_MASK_ALL,
+                                      found, 4));
+
+    TEST_ASSERT_EQUAL_size_t(
+        2, spatial_index_query_circle(g_engine->spatial_index, 250, 250, 250, COLLIDER_MASK_ALL,
+                                      found, 4));
+    TEST_ASSERT_TRUE(contains_entity(found, 2, far));
+}
+
+static void test_spatial_index_raycast_orders_hits(void) {
+    EseEntity *row[3];
+    for (int i = 0; i < 3; i++) {
+        row[i] = make_collider((float)(300 - i * 100), 0, 20);
+    }
+    EseEntity *diagonal = make_collider(1000, 1000, 20);
+    spatial_index_update(g_engine->spatial_index);
+
+    SpatialQueryHit hit;
+    TEST_ASSERT_TRUE(spatial_index_raycast(g_engine->spatial_index, 0, 10, 1, 0, 1000,
+                                           COLLIDER_MASK_ALL, &hit));
+    TEST_ASSERT_EQUAL_PTR(row[2], hit.entity);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 100.0f, hit.distance);
+
+    // The direction does not need to be normalized
+    SpatialQueryHit hits[4];
+    size_t count = spatial_index_raycast_all(g_engine->spatial_index, 0, 10, 5, 0, 1000,
+                                             COLLIDER_MASK_ALL, hits, 4);
+    TEST_ASSERT_EQUAL_size_t(3, count);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_PTR(row[2 - i], hits[i].entity);
+        TEST_ASSERT_FLOAT_WITHIN(0.001f, 100.0f * (float)(i + 1), hits[i].distance);
+    }
+
+    // Length, result count and mask limit the hits
+    TEST_ASSERT_EQUAL_size_t(2, spatial_index_raycast_all(g_engine->spatial_index, 0, 10, 1, 0,
+                                                          250, COLLIDER_MASK_ALL, hits, 4));
+    TEST_ASSERT_EQUAL_size_t(1, spatial_index_raycast_all(g_engine->spatial_index, 0, 10, 1, 0,
+                                                          1000, COLLIDER_MASK_ALL, hits, 1));
+    TEST_ASSERT_EQUAL_PTR(row[2], hits[0].entity);
+    entity_component_collider_set_layer(collider_of(row[1]), 0x0002);
+    TEST_ASSERT_TRUE(
+        spatial_index_raycast(g_engine->spatial_index, 0, 10, 1, 0, 1000, 0x0002, &hit));
+    TEST_ASSERT_EQUAL_PTR(row[1], hit.entity);
+
+    // Starting inside an entity hits it at distance 0; misses report nothing
+    TEST_ASSERT_TRUE(spatial_index_raycast(g_engine->spatial_index, 305, 5, -1, 0, 1000,
+                                           COLLIDER_MASK_ALL, &hit));
+    TEST_ASSERT_EQUAL_PTR(row[0], hit.entity);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, hit.distance);
+    TEST_ASSERT_FALSE(spatial_index_raycast(g_engine->spatial_index, 0, 10, 0, -1, 1000,
+                                            COLLIDER_MASK_ALL, &hit));
+
+    // A long diagonal crossing many empty cells
+    TEST_ASSERT_TRUE(spatial_index_raycast(g_engine->spatial_index, -500, -500, 1, 1, 5000,
+                                           COLLIDER_MASK_ALL, &hit));
+    TEST_ASSERT_EQUAL_PTR(diagonal, hit.entity);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1500.0f * sqrtf(2.0f), hit.distance);
+}
+
+static int compare_float(const void *a, const void *b) {
+    float fa = *(const float *)a;
+    float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static void test_spatial_index_query_nearest_matches_brute_force(void) {
+    enum { COUNT = 200, K = 6 };
+    EseEntity *entities[COUNT];
+    float distances[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        entities[i] = make_collider((float)((i * 37) % 1600), (float)((i * 91) % 1200), 16);
+    }
+    spatial_index_update(g_engine->spatial_index);
+
+    // Points inside, at the edge of and far outside the populated area
+    const float points[][2] = {{400, 300}, {1590, 10}, {-3000, 5000}, {800, 600}};
+    SpatialQueryHit hits[K];
+    for (size_t q = 0; q < sizeof(points) / sizeof(points[0]); q++) {
+        float x = points[q][0];
+        float y = points[q][1];
+        for (int i = 0; i < COUNT; i++) {
+            float dx = ese_point_get_x(entities[i]->position) - x;
+            float dy = ese_point_get_y(entities[i]->position) - y;
+            distances[i] = sqrtf(dx * dx + dy * dy);
+        }
+        qsort(distances, COUNT, sizeof(float), compare_float);
+
+        size_t count =
+            spatial_index_query_nearest(g_engine->spatial_index, x, y, COLLIDER_MASK_ALL, hits, K);
+        TEST_ASSERT_EQUAL_size_t(K, count);
+        for (int i = 0; i < K; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(0.01f, distances[i], hits[i].distance);
+        }
+    }
+
+    // Asking for more than exist returns them all
+    SpatialQueryHit all[COUNT + 1];
+    TEST_ASSERT_EQUAL_size_t(COUNT, spatial_index_query_nearest(g_engine->spatial_index, 0, 0,
+                                                                COLLIDER_MASK_ALL, all,
+                                                                COUNT + 1));
+}
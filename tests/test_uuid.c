@@ -218,6 +218,8 @@ static void test_ese_uuid_hash(void) {
     EseUUID *copy = ese_uuid_copy(uuid1);
     uint64_t hash_copy = ese_uuid_hash(copy);
     TEST_ASSERT_EQUAL_UINT64_MESSAGE(hash1, hash_copy, "Same UUID should have same hash");
+    TEST_ASSERT_EQUAL_UINT64_MESSAGE(hash1, ese_uuid_hash_string(ese_uuid_get_value(uuid1)),
+                                     "String hash should match the UUID hash");
 
     ese_uuid_destroy(uuid1);
     ese_uuid_destroy(uuid2);